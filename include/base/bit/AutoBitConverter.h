@@ -1,9 +1,13 @@
 #pragma once
 #include "base/bit/bit_converte.h"
+#include "base/container/ArraySpan.h"
+#include "base/container/ReadOnlyArraySpan.h"
 #include "base/stream/ReadOnlySpan.h"
 #include "base/stream/Stream.h"
 #include <bit>
 #include <cstdint>
+#include <stdexcept>
+#include <type_traits>
 
 namespace base
 {
@@ -149,6 +153,84 @@ namespace base
 		}
 
 		/* #endregion */
+
+		/* #region 批量转换 */
+
+		///
+		/// @brief 从字节序列中反序列化出一组数值，写入 values.
+		///
+		/// @note 需要翻转时整段交给 bit_converte::ReverseEachElement, 不需要翻转时直接复制。
+		///
+		/// @param span 大小必须是 values.Count() * sizeof(ValueType).
+		/// @param values
+		///
+		template <typename ValueType>
+		void FromBytes(base::ReadOnlySpan const &span, base::ArraySpan<ValueType> const &values) const
+		{
+			static_assert(std::is_arithmetic_v<ValueType>, "只支持整型和浮点数组。");
+
+			base::Span destination{
+				reinterpret_cast<uint8_t *>(values.Buffer()),
+				values.Count() * static_cast<int64_t>(sizeof(ValueType)),
+			};
+
+			if (span.Size() != destination.Size())
+			{
+				throw std::invalid_argument{CODE_POS_STR + "传入的 span 大小与数组不符。"};
+			}
+
+			if (!ShouldReverse())
+			{
+				destination.CopyFrom(span);
+				return;
+			}
+
+			base::bit_converte::ReverseEachElement(span, destination, sizeof(ValueType));
+		}
+
+		///
+		/// @brief 将一组数值序列化到 span 中。
+		///
+		/// @param values
+		/// @param span 大小必须是 values.Count() * sizeof(ValueType).
+		///
+		template <typename ValueType>
+		void GetBytes(base::ReadOnlyArraySpan<ValueType> const &values, base::Span const &span) const
+		{
+			static_assert(std::is_arithmetic_v<ValueType>, "只支持整型和浮点数组。");
+
+			base::ReadOnlySpan source{
+				reinterpret_cast<uint8_t const *>(values.Buffer()),
+				values.Count() * static_cast<int64_t>(sizeof(ValueType)),
+			};
+
+			if (span.Size() != source.Size())
+			{
+				throw std::invalid_argument{CODE_POS_STR + "传入的 span 大小与数组不符。"};
+			}
+
+			if (!ShouldReverse())
+			{
+				span.CopyFrom(source);
+				return;
+			}
+
+			base::bit_converte::ReverseEachElement(source, span, sizeof(ValueType));
+		}
+
+		///
+		/// @brief 将一组数值序列化到 span 中。
+		///
+		/// @param values
+		/// @param span 大小必须是 values.Count() * sizeof(ValueType).
+		///
+		template <typename ValueType>
+		void GetBytes(base::ArraySpan<ValueType> const &values, base::Span const &span) const
+		{
+			GetBytes(base::ReadOnlyArraySpan<ValueType>{values.Buffer(), values.Count()}, span);
+		}
+
+		/* #endregion */
 	};
 
 	///
@@ -545,4 +545,54 @@ namespace base::bit
 
 	/* #endregion */
 
+	/* #region 字节序翻转 */
+
+	///
+	/// @brief 翻转字节顺序。
+	///
+	/// @note GCC, clang 上编译为 1 条 bswap 指令。
+	///
+	/// @param value
+	/// @return
+	///
+	template <typename T>
+		requires(std::is_integral_v<T>)
+	constexpr T ByteSwap(T value) noexcept
+	{
+		using unsigned_type = std::make_unsigned_t<T>;
+		unsigned_type u = static_cast<unsigned_type>(value);
+
+		if constexpr (sizeof(T) == 1)
+		{
+			return value;
+		}
+#if defined(__GNUC__) || defined(__clang__)
+		else if constexpr (sizeof(T) == 2)
+		{
+			return static_cast<T>(__builtin_bswap16(u));
+		}
+		else if constexpr (sizeof(T) == 4)
+		{
+			return static_cast<T>(__builtin_bswap32(u));
+		}
+		else if constexpr (sizeof(T) == 8)
+		{
+			return static_cast<T>(__builtin_bswap64(u));
+		}
+#endif
+		else
+		{
+			unsigned_type result = 0;
+			for (size_t i = 0; i < sizeof(T); i++)
+			{
+				result = static_cast<unsigned_type>((result << 8) | (u & 0xff));
+				u = static_cast<unsigned_type>(u >> 8);
+			}
+
+			return static_cast<T>(result);
+		}
+	}
+
+	/* #endregion */
+
 } // namespace base::bit
@@ -1 +1,213 @@
 #include "bit_converte.h" // IWYU pragma: keep
+#include "base/bit/bit.h"
+#include "base/string/define.h"
+#include <array>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__)
+	#if (defined(__GNUC__) || defined(__clang__)) && !defined(_MSC_VER)
+		#define BASE_BIT_CONVERTE_SIMD 1
+		#include <immintrin.h>
+	#else
+		#define BASE_BIT_CONVERTE_SIMD 0
+	#endif
+#else
+	#define BASE_BIT_CONVERTE_SIMD 0
+#endif
+
+namespace
+{
+	///
+	/// @brief 翻转 size 个字节中每个元素的字节序。size 是元素大小的整数倍。
+	///
+	using ReverseFunction = void (*)(uint8_t const *source, uint8_t *destination, int64_t size);
+
+	template <int ElementSize>
+	struct unsigned_element;
+
+	template <>
+	struct unsigned_element<2>
+	{
+		using type = uint16_t;
+	};
+
+	template <>
+	struct unsigned_element<4>
+	{
+		using type = uint32_t;
+	};
+
+	template <>
+	struct unsigned_element<8>
+	{
+		using type = uint64_t;
+	};
+
+	template <int ElementSize>
+	void ReverseScalar(uint8_t const *source, uint8_t *destination, int64_t size)
+	{
+		using element_type = typename unsigned_element<ElementSize>::type;
+
+		// 用 memcpy 读写，不要求对齐。先读后写，所以可以原地翻转。
+		for (int64_t i = 0; i < size; i += ElementSize)
+		{
+			element_type value;
+			std::memcpy(&value, source + i, ElementSize);
+			value = base::bit::ByteSwap(value);
+			std::memcpy(destination + i, &value, ElementSize);
+		}
+	}
+
+#if BASE_BIT_CONVERTE_SIMD
+	///
+	/// @brief pshufb 的索引。第 j 个字节取自所在元素中的对称位置。
+	///
+	template <int ElementSize>
+	constexpr std::array<uint8_t, 16> _shuffle_index = []()
+	{
+		std::array<uint8_t, 16> index{};
+		for (int j = 0; j < 16; j++)
+		{
+			index[j] = static_cast<uint8_t>(j / ElementSize * ElementSize + (ElementSize - 1 - j % ElementSize));
+		}
+
+		return index;
+	}();
+
+	template <int ElementSize>
+	__attribute__((target("ssse3"))) void ReverseSsse3(uint8_t const *source, uint8_t *destination, int64_t size)
+	{
+		__m128i index = _mm_loadu_si128(reinterpret_cast<__m128i const *>(_shuffle_index<ElementSize>.data()));
+		int64_t i = 0;
+		for (; i + 16 <= size; i += 16)
+		{
+			__m128i bytes = _mm_loadu_si128(reinterpret_cast<__m128i const *>(source + i));
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(destination + i), _mm_shuffle_epi8(bytes, index));
+		}
+
+		ReverseScalar<ElementSize>(source + i, destination + i, size - i);
+	}
+
+	template <int ElementSize>
+	__attribute__((target("avx2"))) void ReverseAvx2(uint8_t const *source, uint8_t *destination, int64_t size)
+	{
+		// 元素不跨越 128 位通道，两个通道使用相同的索引。
+		__m256i index = _mm256_broadcastsi128_si256(
+			_mm_loadu_si128(reinterpret_cast<__m128i const *>(_shuffle_index<ElementSize>.data())));
+
+		int64_t i = 0;
+		for (; i + 64 <= size; i += 64)
+		{
+			__m256i first = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(source + i));
+			__m256i second = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(source + i + 32));
+			_mm256_storeu_si256(reinterpret_cast<__m256i *>(destination + i), _mm256_shuffle_epi8(first, index));
+			_mm256_storeu_si256(reinterpret_cast<__m256i *>(destination + i + 32), _mm256_shuffle_epi8(second, index));
+		}
+
+		for (; i + 32 <= size; i += 32)
+		{
+			__m256i bytes = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(source + i));
+			_mm256_storeu_si256(reinterpret_cast<__m256i *>(destination + i), _mm256_shuffle_epi8(bytes, index));
+		}
+
+		// 不调用 ReverseSsse3 处理剩余部分。它使用非 VEX 编码的 SSE 指令，在 AVX 寄存器的高半部分
+		// 未清零时调用会有很大的状态切换开销。
+		if (i + 16 <= size)
+		{
+			__m128i bytes = _mm_loadu_si128(reinterpret_cast<__m128i const *>(source + i));
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(destination + i),
+							 _mm_shuffle_epi8(bytes, _mm256_castsi256_si128(index)));
+
+			i += 16;
+		}
+
+		_mm256_zeroupper();
+		ReverseScalar<ElementSize>(source + i, destination + i, size - i);
+	}
+#endif // BASE_BIT_CONVERTE_SIMD
+
+	///
+	/// @brief 各种元素大小的翻转函数。
+	///
+	struct ReverseFunctions
+	{
+		ReverseFunction _reverse_2 = nullptr;
+		ReverseFunction _reverse_4 = nullptr;
+		ReverseFunction _reverse_8 = nullptr;
+	};
+
+	ReverseFunctions SelectReverseFunctions()
+	{
+#if BASE_BIT_CONVERTE_SIMD
+		if (__builtin_cpu_supports("avx2"))
+		{
+			return ReverseFunctions{ReverseAvx2<2>, ReverseAvx2<4>, ReverseAvx2<8>};
+		}
+
+		if (__builtin_cpu_supports("ssse3"))
+		{
+			return ReverseFunctions{ReverseSsse3<2>, ReverseSsse3<4>, ReverseSsse3<8>};
+		}
+#endif
+
+		return ReverseFunctions{ReverseScalar<2>, ReverseScalar<4>, ReverseScalar<8>};
+	}
+
+} // namespace
+
+void base::bit_converte::ReverseEachElement(base::ReadOnlySpan const &source,
+											base::Span const &destination,
+											int element_size)
+{
+	if (source.Size() != destination.Size())
+	{
+		throw std::invalid_argument{CODE_POS_STR + "source 和 destination 的大小不同。"};
+	}
+
+	if (element_size != 1 && element_size != 2 && element_size != 4 && element_size != 8)
+	{
+		throw std::invalid_argument{CODE_POS_STR + "不支持的元素大小：" + std::to_string(element_size) + "."};
+	}
+
+	if (source.Size() % element_size != 0)
+	{
+		throw std::invalid_argument{CODE_POS_STR + "span 的大小不是元素大小的整数倍。"};
+	}
+
+	if (source.Size() == 0)
+	{
+		return;
+	}
+
+	static ReverseFunctions const functions = SelectReverseFunctions();
+
+	switch (element_size)
+	{
+	case 2:
+		{
+			functions._reverse_2(source.Buffer(), destination.Buffer(), source.Size());
+			break;
+		}
+	case 4:
+		{
+			functions._reverse_4(source.Buffer(), destination.Buffer(), source.Size());
+			break;
+		}
+	case 8:
+		{
+			functions._reverse_8(source.Buffer(), destination.Buffer(), source.Size());
+			break;
+		}
+	default:
+		{
+			if (source.Buffer() != destination.Buffer())
+			{
+				std::memmove(destination.Buffer(), source.Buffer(), source.Size());
+			}
+
+			break;
+		}
+	}
+}
@@ -157,4 +157,24 @@ namespace base::bit_converte
 
 	/* #endregion */
 
+	/* #region 批量翻转 */
+
+	///
+	/// @brief 把 source 看作一组大小为 element_size 的元素，翻转每个元素的字节序后写入 destination.
+	///
+	/// @note 用来批量转换 16, 32, 64 位整型和浮点数组的字节序。CPU 支持时使用 SSSE3 或 AVX2
+	/// 的字节重排指令一次处理 16 或 32 个字节。
+	///
+	/// @note source 和 destination 可以是同一段内存，此时原地翻转。不能部分重叠。
+	///
+	/// @param source
+	/// @param destination 大小必须与 source 相同。
+	/// @param element_size 元素大小。只能是 1, 2, 4, 8. 为 1 时只是复制。
+	///
+	void ReverseEachElement(base::ReadOnlySpan const &source,
+							base::Span const &destination,
+							int element_size);
+
+	/* #endregion */
+
 } // namespace base::bit_converte
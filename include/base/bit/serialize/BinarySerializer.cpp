@@ -0,0 +1 @@
+#include "BinarySerializer.h" // IWYU pragma: keep
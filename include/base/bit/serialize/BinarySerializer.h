@@ -0,0 +1,884 @@
+#pragma once
+#include "base/bit/bit.h"
+#include "base/bit/bit_converte.h"
+#include "base/bit/serialize/IStreamSerializable.h"
+#include "base/stream/ReadOnlySpan.h"
+#include "base/stream/Span.h"
+#include "base/stream/Stream.h"
+#include "base/string/define.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace base
+{
+	///
+	/// @brief 字段列表。按顺序列出参与二进制序列化的成员指针。
+	///
+	/// @note 结构体通过静态成员函数声明字段列表：
+	/// 	@code
+	/// 	static constexpr auto BinaryFields()
+	/// 	{
+	/// 		return base::BinaryFieldList<&Header::_id, &Header::_value>{};
+	/// 	}
+	/// 	@endcode
+	///
+	template <auto... MemberPointers>
+	struct BinaryFieldList
+	{
+	};
+
+	///
+	/// @brief T 用 BinaryFields 声明了字段列表。
+	///
+	template <typename T>
+	concept has_binary_fields = requires() {
+		T::BinaryFields();
+	};
+
+	namespace binary_serializer
+	{
+		template <typename T>
+		struct is_std_array : std::false_type
+		{
+		};
+
+		template <typename T, size_t N>
+		struct is_std_array<std::array<T, N>> : std::true_type
+		{
+		};
+
+		template <typename T>
+		struct is_std_vector : std::false_type
+		{
+		};
+
+		template <typename T, typename Allocator>
+		struct is_std_vector<std::vector<T, Allocator>> : std::true_type
+		{
+		};
+
+		template <typename T>
+		struct member_pointer_traits;
+
+		template <typename Class, typename Member>
+		struct member_pointer_traits<Member Class::*>
+		{
+			using member_type = Member;
+		};
+
+		template <auto MemberPointer>
+		using member_type = typename member_pointer_traits<decltype(MemberPointer)>::member_type;
+
+		///
+		/// @brief 整型、浮点、枚举，按字节序写入。
+		///
+		template <typename T>
+		constexpr bool is_scalar_v = std::is_arithmetic_v<T> || std::is_enum_v<T>;
+
+		///
+		/// @brief 可以整块拷贝，必要时整块翻转字节序的类型。bool 读取时要检查取值，不在其中。
+		///
+		template <typename T>
+		constexpr bool is_bulk_v = is_scalar_v<T> && !std::is_same_v<T, bool>;
+
+		///
+		/// @brief 字节序不同时，元素个数达到此值才交给 bit_converte::ReverseEachElement 整段翻转。
+		/// 元素少时函数调用的开销比逐个翻转还大。
+		///
+		constexpr size_t _bulk_reverse_threshold = 16;
+
+		///
+		/// @brief 引用输入缓冲区的视图类型。只能从 ReadOnlySpan 反序列化。
+		///
+		template <typename T>
+		constexpr bool is_view_v = std::is_same_v<T, std::string_view> || std::is_same_v<T, base::ReadOnlySpan>;
+
+		template <size_t Size>
+		using unsigned_of_size = std::conditional_t<
+			Size == 1,
+			uint8_t,
+			std::conditional_t<Size == 2,
+							   uint16_t,
+							   std::conditional_t<Size == 4, uint32_t, uint64_t>>>;
+
+		template <typename T>
+		consteval int64_t FixedSize();
+
+		template <auto... MemberPointers>
+		consteval int64_t FixedSizeOfFields(base::BinaryFieldList<MemberPointers...>)
+		{
+			int64_t sizes[] = {FixedSize<member_type<MemberPointers>>()..., 0};
+			int64_t sum = 0;
+			for (int64_t size : sizes)
+			{
+				if (size < 0)
+				{
+					return -1;
+				}
+
+				sum += size;
+			}
+
+			return sum;
+		}
+
+		///
+		/// @brief T 序列化后的字节数。变长类型返回 -1.
+		///
+		/// @return
+		///
+		template <typename T>
+		consteval int64_t FixedSize()
+		{
+			if constexpr (std::is_same_v<T, bool>)
+			{
+				return 1;
+			}
+			else if constexpr (std::is_enum_v<T>)
+			{
+				return sizeof(std::underlying_type_t<T>);
+			}
+			else if constexpr (std::is_arithmetic_v<T>)
+			{
+				static_assert(sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8,
+							  "只支持 1, 2, 4, 8 字节的标量。");
+
+				return sizeof(T);
+			}
+			else if constexpr (is_std_array<T>::value)
+			{
+				constexpr int64_t element_size = FixedSize<typename T::value_type>();
+				return element_size < 0 ? -1 : element_size * static_cast<int64_t>(std::tuple_size_v<T>);
+			}
+			else if constexpr (base::has_binary_fields<T>)
+			{
+				return FixedSizeOfFields(T::BinaryFields());
+			}
+			else if constexpr (std::is_same_v<T, std::string> || is_view_v<T>)
+			{
+				return -1;
+			}
+			else if constexpr (is_std_vector<T>::value)
+			{
+				static_assert(!std::is_same_v<typename T::value_type, bool>, "不支持 std::vector<bool>.");
+				FixedSize<typename T::value_type>();
+				return -1;
+			}
+			else
+			{
+				static_assert(std::is_same_v<T, void>, "不支持的字段类型。");
+				return -1;
+			}
+		}
+
+		template <typename T>
+		consteval int64_t MinSize();
+
+		template <auto... MemberPointers>
+		consteval int64_t MinSizeOfFields(base::BinaryFieldList<MemberPointers...>)
+		{
+			return (int64_t{0} + ... + MinSize<member_type<MemberPointers>>());
+		}
+
+		///
+		/// @brief T 序列化后至少有多少字节。用来在分配内存前检查输入中的元素个数。
+		///
+		/// @return
+		///
+		template <typename T>
+		consteval int64_t MinSize()
+		{
+			constexpr int64_t fixed_size = FixedSize<T>();
+			if constexpr (fixed_size >= 0)
+			{
+				return fixed_size;
+			}
+			else if constexpr (is_std_array<T>::value)
+			{
+				return MinSize<typename T::value_type>() * static_cast<int64_t>(std::tuple_size_v<T>);
+			}
+			else if constexpr (base::has_binary_fields<T>)
+			{
+				return MinSizeOfFields(T::BinaryFields());
+			}
+			else
+			{
+				// 长度前缀。
+				return 8;
+			}
+		}
+
+		/* #region 写入 */
+
+		template <std::endian Endian, typename T>
+		inline void WriteScalar(uint8_t *&p, T value)
+		{
+			if constexpr (std::is_same_v<T, bool>)
+			{
+				*p++ = value ? 1 : 0;
+			}
+			else if constexpr (std::is_enum_v<T>)
+			{
+				WriteScalar<Endian>(p, static_cast<std::underlying_type_t<T>>(value));
+			}
+			else
+			{
+				using bits_type = unsigned_of_size<sizeof(T)>;
+				bits_type bits = std::bit_cast<bits_type>(value);
+				if constexpr (Endian != std::endian::native)
+				{
+					bits = base::bit::ByteSwap(bits);
+				}
+
+				std::memcpy(p, &bits, sizeof(T));
+				p += sizeof(T);
+			}
+		}
+
+		///
+		/// @brief 连续写入 count 个标量。字节序相同时是 1 次 memcpy, 否则整段或逐个翻转。
+		///
+		template <std::endian Endian, typename T>
+		inline void WriteScalars(uint8_t *&p, T const *values, size_t count)
+		{
+			if constexpr (is_bulk_v<T> && (Endian == std::endian::native || sizeof(T) == 1))
+			{
+				std::memcpy(p, values, count * sizeof(T));
+				p += count * sizeof(T);
+			}
+			else
+			{
+				if constexpr (is_bulk_v<T> && sizeof(T) <= 8)
+				{
+					if (count >= _bulk_reverse_threshold)
+					{
+						int64_t size = static_cast<int64_t>(count * sizeof(T));
+						base::bit_converte::ReverseEachElement(base::ReadOnlySpan{reinterpret_cast<uint8_t const *>(values), size},
+															   base::Span{p, size},
+															   sizeof(T));
+
+						p += size;
+						return;
+					}
+				}
+
+				for (size_t i = 0; i < count; i++)
+				{
+					WriteScalar<Endian>(p, values[i]);
+				}
+			}
+		}
+
+		template <std::endian Endian, typename T>
+		void Write(uint8_t *&p, T const &value);
+
+		template <std::endian Endian, typename T, auto... MemberPointers>
+		inline void WriteFields(uint8_t *&p, T const &value, base::BinaryFieldList<MemberPointers...>)
+		{
+			(Write<Endian>(p, value.*MemberPointers), ...);
+		}
+
+		template <std::endian Endian, typename ElementType>
+		inline void WriteElements(uint8_t *&p, ElementType const *elements, size_t count)
+		{
+			if constexpr (is_scalar_v<ElementType>)
+			{
+				WriteScalars<Endian>(p, elements, count);
+			}
+			else
+			{
+				for (size_t i = 0; i < count; i++)
+				{
+					Write<Endian>(p, elements[i]);
+				}
+			}
+		}
+
+		template <std::endian Endian>
+		inline void WriteBytes(uint8_t *&p, void const *data, size_t size)
+		{
+			WriteScalar<Endian>(p, static_cast<int64_t>(size));
+			if (size > 0)
+			{
+				std::memcpy(p, data, size);
+				p += size;
+			}
+		}
+
+		template <std::endian Endian, typename T>
+		void Write(uint8_t *&p, T const &value)
+		{
+			if constexpr (is_scalar_v<T>)
+			{
+				WriteScalar<Endian>(p, value);
+			}
+			else if constexpr (is_std_array<T>::value)
+			{
+				WriteElements<Endian>(p, value.data(), value.size());
+			}
+			else if constexpr (is_std_vector<T>::value)
+			{
+				WriteScalar<Endian>(p, static_cast<int64_t>(value.size()));
+				WriteElements<Endian>(p, value.data(), value.size());
+			}
+			else if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>)
+			{
+				WriteBytes<Endian>(p, value.data(), value.size());
+			}
+			else if constexpr (std::is_same_v<T, base::ReadOnlySpan>)
+			{
+				WriteBytes<Endian>(p, value.Buffer(), static_cast<size_t>(value.Size()));
+			}
+			else
+			{
+				WriteFields<Endian>(p, value, T::BinaryFields());
+			}
+		}
+
+		template <typename T>
+		int64_t Size(T const &value);
+
+		template <typename T, auto... MemberPointers>
+		inline int64_t SizeOfFields(T const &value, base::BinaryFieldList<MemberPointers...>)
+		{
+			return (int64_t{0} + ... + Size(value.*MemberPointers));
+		}
+
+		///
+		/// @brief value 序列化后的字节数。
+		///
+		template <typename T>
+		int64_t Size(T const &value)
+		{
+			constexpr int64_t fixed_size = FixedSize<T>();
+			if constexpr (fixed_size >= 0)
+			{
+				return fixed_size;
+			}
+			else if constexpr (is_std_vector<T>::value)
+			{
+				using element_type = typename T::value_type;
+				constexpr int64_t element_size = FixedSize<element_type>();
+				if constexpr (element_size >= 0)
+				{
+					return 8 + element_size * static_cast<int64_t>(value.size());
+				}
+				else
+				{
+					int64_t sum = 8;
+					for (element_type const &element : value)
+					{
+						sum += Size(element);
+					}
+
+					return sum;
+				}
+			}
+			else if constexpr (std::is_same_v<T, base::ReadOnlySpan>)
+			{
+				return 8 + value.Size();
+			}
+			else if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>)
+			{
+				return 8 + static_cast<int64_t>(value.size());
+			}
+			else if constexpr (is_std_array<T>::value)
+			{
+				int64_t sum = 0;
+				for (auto const &element : value)
+				{
+					sum += Size(element);
+				}
+
+				return sum;
+			}
+			else
+			{
+				return SizeOfFields(value, T::BinaryFields());
+			}
+		}
+
+		/* #endregion */
+
+		/* #region 从 ReadOnlySpan 读取 */
+
+		[[noreturn]] inline void ThrowNotEnoughBytes()
+		{
+			throw base::StreamDeserializeException{CODE_POS_STR + "输入的字节数不够。"};
+		}
+
+		template <std::endian Endian, typename T>
+		inline void ReadScalar(uint8_t const *&p, T &value)
+		{
+			if constexpr (std::is_same_v<T, bool>)
+			{
+				value = *p++ != 0;
+			}
+			else if constexpr (std::is_enum_v<T>)
+			{
+				std::underlying_type_t<T> underlying{};
+				ReadScalar<Endian>(p, underlying);
+				value = static_cast<T>(underlying);
+			}
+			else
+			{
+				using bits_type = unsigned_of_size<sizeof(T)>;
+				bits_type bits;
+				std::memcpy(&bits, p, sizeof(T));
+				if constexpr (Endian != std::endian::native)
+				{
+					bits = base::bit::ByteSwap(bits);
+				}
+
+				value = std::bit_cast<T>(bits);
+				p += sizeof(T);
+			}
+		}
+
+		template <std::endian Endian, typename T>
+		inline void ReadScalars(uint8_t const *&p, T *values, size_t count)
+		{
+			if constexpr (is_bulk_v<T> && (Endian == std::endian::native || sizeof(T) == 1))
+			{
+				std::memcpy(values, p, count * sizeof(T));
+				p += count * sizeof(T);
+			}
+			else
+			{
+				if constexpr (is_bulk_v<T> && sizeof(T) <= 8)
+				{
+					if (count >= _bulk_reverse_threshold)
+					{
+						int64_t size = static_cast<int64_t>(count * sizeof(T));
+						base::bit_converte::ReverseEachElement(base::ReadOnlySpan{p, size},
+															   base::Span{reinterpret_cast<uint8_t *>(values), size},
+															   sizeof(T));
+
+						p += size;
+						return;
+					}
+				}
+
+				for (size_t i = 0; i < count; i++)
+				{
+					ReadScalar<Endian>(p, values[i]);
+				}
+			}
+		}
+
+		template <std::endian Endian, typename T>
+		void Read(uint8_t const *&p, uint8_t const *end, T &value);
+
+		///
+		/// @brief 读取定长类型。调用者已经检查过剩余字节数。
+		///
+		template <std::endian Endian, typename T>
+		void ReadFixed(uint8_t const *&p, T &value);
+
+		template <std::endian Endian, typename T, auto... MemberPointers>
+		inline void ReadFixedFields(uint8_t const *&p, T &value, base::BinaryFieldList<MemberPointers...>)
+		{
+			(ReadFixed<Endian>(p, value.*MemberPointers), ...);
+		}
+
+		template <std::endian Endian, typename T>
+		void ReadFixed(uint8_t const *&p, T &value)
+		{
+			if constexpr (is_scalar_v<T>)
+			{
+				ReadScalar<Endian>(p, value);
+			}
+			else if constexpr (is_std_array<T>::value)
+			{
+				if constexpr (is_scalar_v<typename T::value_type>)
+				{
+					ReadScalars<Endian>(p, value.data(), value.size());
+				}
+				else
+				{
+					for (auto &element : value)
+					{
+						ReadFixed<Endian>(p, element);
+					}
+				}
+			}
+			else
+			{
+				ReadFixedFields<Endian>(p, value, T::BinaryFields());
+			}
+		}
+
+		template <std::endian Endian, typename T, auto... MemberPointers>
+		inline void ReadFields(uint8_t const *&p, uint8_t const *end, T &value, base::BinaryFieldList<MemberPointers...>)
+		{
+			(Read<Endian>(p, end, value.*MemberPointers), ...);
+		}
+
+		template <std::endian Endian>
+		inline int64_t ReadLength(uint8_t const *&p, uint8_t const *end, int64_t element_size)
+		{
+			if (end - p < 8)
+			{
+				ThrowNotEnoughBytes();
+			}
+
+			int64_t length = 0;
+			ReadScalar<Endian>(p, length);
+			if (length < 0)
+			{
+				throw base::StreamDeserializeException{CODE_POS_STR + "长度不能是负数。"};
+			}
+
+			// 用除法比较，避免乘法溢出。
+			if (element_size > 0 && length > (end - p) / element_size)
+			{
+				ThrowNotEnoughBytes();
+			}
+
+			return length;
+		}
+
+		///
+		/// @brief 读取任意类型，检查剩余字节数。
+		///
+		/// @note 视图类型引用 [p, end) 中的字节，不拷贝。
+		///
+		template <std::endian Endian, typename T>
+		void Read(uint8_t const *&p, uint8_t const *end, T &value)
+		{
+			constexpr int64_t fixed_size = FixedSize<T>();
+			if constexpr (fixed_size >= 0)
+			{
+				if (end - p < fixed_size)
+				{
+					ThrowNotEnoughBytes();
+				}
+
+				ReadFixed<Endian>(p, value);
+			}
+			else if constexpr (is_std_vector<T>::value)
+			{
+				using element_type = typename T::value_type;
+				constexpr int64_t element_size = FixedSize<element_type>();
+				int64_t length = ReadLength<Endian>(p, end, MinSize<element_type>());
+				value.resize(static_cast<size_t>(length));
+
+				if constexpr (is_scalar_v<element_type>)
+				{
+					ReadScalars<Endian>(p, value.data(), value.size());
+				}
+				else if constexpr (element_size >= 0)
+				{
+					for (element_type &element : value)
+					{
+						ReadFixed<Endian>(p, element);
+					}
+				}
+				else
+				{
+					for (element_type &element : value)
+					{
+						Read<Endian>(p, end, element);
+					}
+				}
+			}
+			else if constexpr (std::is_same_v<T, std::string>)
+			{
+				int64_t length = ReadLength<Endian>(p, end, 1);
+				value.assign(reinterpret_cast<char const *>(p), static_cast<size_t>(length));
+				p += length;
+			}
+			else if constexpr (std::is_same_v<T, std::string_view>)
+			{
+				int64_t length = ReadLength<Endian>(p, end, 1);
+				value = std::string_view{reinterpret_cast<char const *>(p), static_cast<size_t>(length)};
+				p += length;
+			}
+			else if constexpr (std::is_same_v<T, base::ReadOnlySpan>)
+			{
+				int64_t length = ReadLength<Endian>(p, end, 1);
+				value = base::ReadOnlySpan{p, length};
+				p += length;
+			}
+			else if constexpr (is_std_array<T>::value)
+			{
+				for (auto &element : value)
+				{
+					Read<Endian>(p, end, element);
+				}
+			}
+			else
+			{
+				ReadFields<Endian>(p, end, value, T::BinaryFields());
+			}
+		}
+
+		/* #endregion */
+
+		/* #region 从流读取 */
+
+		///
+		/// @brief 从流中读取变长字段时每次增长的元素个数。
+		///
+		constexpr int64_t _stream_chunk_size = 64 * 1024;
+
+		inline void ReadExactly(base::Stream &stream, void *buffer, int64_t size)
+		{
+			if (size <= 0)
+			{
+				return;
+			}
+
+			int64_t have_read = stream.ReadExactly(base::Span{static_cast<uint8_t *>(buffer), size});
+			if (have_read < size)
+			{
+				throw base::StreamDeserializeException{CODE_POS_STR + "还没反序列化完成流就结束了。"};
+			}
+		}
+
+		template <std::endian Endian, typename T>
+		void ReadFromStream(base::Stream &stream, T &value);
+
+		template <std::endian Endian, typename T, auto... MemberPointers>
+		inline void ReadFieldsFromStream(base::Stream &stream, T &value, base::BinaryFieldList<MemberPointers...>)
+		{
+			(ReadFromStream<Endian>(stream, value.*MemberPointers), ...);
+		}
+
+		template <std::endian Endian>
+		inline int64_t ReadLengthFromStream(base::Stream &stream)
+		{
+			uint8_t buffer[8];
+			ReadExactly(stream, buffer, sizeof(buffer));
+			uint8_t const *p = buffer;
+			int64_t length = 0;
+			ReadScalar<Endian>(p, length);
+			if (length < 0)
+			{
+				throw base::StreamDeserializeException{CODE_POS_STR + "长度不能是负数。"};
+			}
+
+			return length;
+		}
+
+		///
+		/// @brief 从流中读取。定长部分 1 次读入，标量数组直接读入目标内存后就地翻转字节序。
+		///
+		template <std::endian Endian, typename T>
+		void ReadFromStream(base::Stream &stream, T &value)
+		{
+			constexpr int64_t fixed_size = FixedSize<T>();
+			if constexpr (fixed_size >= 0)
+			{
+				if constexpr (fixed_size <= 4096)
+				{
+					uint8_t buffer[fixed_size > 0 ? fixed_size : 1];
+					ReadExactly(stream, buffer, fixed_size);
+					uint8_t const *p = buffer;
+					ReadFixed<Endian>(p, value);
+				}
+				else
+				{
+					std::vector<uint8_t> buffer(static_cast<size_t>(fixed_size));
+					ReadExactly(stream, buffer.data(), fixed_size);
+					uint8_t const *p = buffer.data();
+					ReadFixed<Endian>(p, value);
+				}
+			}
+			else if constexpr (is_std_vector<T>::value)
+			{
+				using element_type = typename T::value_type;
+				int64_t length = ReadLengthFromStream<Endian>(stream);
+
+				if constexpr (is_bulk_v<element_type>)
+				{
+					// 长度来自不可信的输入，分块增长，流提前结束时不会先分配巨大的内存。
+					value.clear();
+					while (static_cast<int64_t>(value.size()) < length)
+					{
+						size_t offset = value.size();
+						size_t chunk = static_cast<size_t>(std::min<int64_t>(length - static_cast<int64_t>(offset), _stream_chunk_size));
+						value.resize(offset + chunk);
+						ReadExactly(stream, value.data() + offset, static_cast<int64_t>(chunk * sizeof(element_type)));
+						if constexpr (Endian != std::endian::native && sizeof(element_type) > 1)
+						{
+							uint8_t const *p = reinterpret_cast<uint8_t const *>(value.data() + offset);
+							ReadScalars<Endian>(p, value.data() + offset, chunk);
+						}
+					}
+				}
+				else
+				{
+					value.clear();
+					for (int64_t i = 0; i < length; i++)
+					{
+						ReadFromStream<Endian>(stream, value.emplace_back());
+					}
+				}
+			}
+			else if constexpr (std::is_same_v<T, std::string>)
+			{
+				int64_t length = ReadLengthFromStream<Endian>(stream);
+				value.clear();
+				while (static_cast<int64_t>(value.size()) < length)
+				{
+					size_t offset = value.size();
+					size_t chunk = static_cast<size_t>(std::min<int64_t>(length - static_cast<int64_t>(offset), _stream_chunk_size));
+					value.resize(offset + chunk);
+					ReadExactly(stream, value.data() + offset, static_cast<int64_t>(chunk));
+				}
+			}
+			else if constexpr (is_view_v<T>)
+			{
+				throw base::StreamDeserializeException{CODE_POS_STR + "视图字段只能从 ReadOnlySpan 反序列化。"};
+			}
+			else if constexpr (is_std_array<T>::value)
+			{
+				for (auto &element : value)
+				{
+					ReadFromStream<Endian>(stream, element);
+				}
+			}
+			else
+			{
+				ReadFieldsFromStream<Endian>(stream, value, T::BinaryFields());
+			}
+		}
+
+		/* #endregion */
+
+	} // namespace binary_serializer
+
+	///
+	/// @brief 按照 T::BinaryFields 声明的字段列表进行二进制序列化。
+	///
+	/// @note 格式：字段按声明顺序紧密排列，没有填充。
+	/// 	@li 整型、浮点、枚举按 Endian 字节序写入，bool 占 1 个字节。
+	/// 	@li std::array 依次写入每个元素。
+	/// 	@li std::vector, std::string, std::string_view, base::ReadOnlySpan 先写入 8 字节的 int64_t 元素个数，
+	/// 	再依次写入元素。与 StdStringStreamSerializer 的格式相同。
+	/// 	@li 声明了 BinaryFields 的嵌套结构体依次写入它的字段。
+	///
+	/// @note 布局在编译期计算。所有字段都定长时 FixedSize 是编译期常量，读取时只检查 1 次长度。
+	/// 每个标量是 1 次固定大小的 memcpy, 内联后成为 1 条存取指令。标量数组和 vector 是 1 次 memcpy,
+	/// 字节序不同时是 1 个翻转循环。写入流时先在缓冲区中拼接，只调用 1 次 Stream::Write.
+	///
+	/// @note 零拷贝读取：字段类型为 std::string_view 或 base::ReadOnlySpan 时，从 ReadOnlySpan
+	/// 反序列化得到的是指向输入缓冲区的视图，与 std::string, std::vector<uint8_t> 的格式相同。
+	///
+	template <typename T, std::endian Endian = std::endian::little>
+		requires(base::has_binary_fields<T>)
+	class BinarySerializer
+	{
+	private:
+		static constexpr int64_t _fixed_size = base::binary_serializer::FixedSize<T>();
+
+	public:
+		///
+		/// @brief 所有字段都是定长的。
+		///
+		static constexpr bool IsFixedSize = _fixed_size >= 0;
+
+		///
+		/// @brief 定长时序列化后的字节数。
+		///
+		static constexpr int64_t FixedSize = _fixed_size;
+
+		///
+		/// @brief value 序列化后的字节数。
+		///
+		/// @param value
+		/// @return
+		///
+		static int64_t SerializedSize(T const &value)
+		{
+			return base::binary_serializer::Size(value);
+		}
+
+		///
+		/// @brief 序列化到 span 中。
+		///
+		/// @param value
+		/// @param span
+		/// @return 写入的字节数。
+		///
+		static int64_t Serialize(T const &value, base::Span const &span)
+		{
+			int64_t size = SerializedSize(value);
+			if (span.Size() < size)
+			{
+				throw base::StreamSerializeException{CODE_POS_STR + "span 容纳不下序列化的结果。"};
+			}
+
+			uint8_t *p = span.Buffer();
+			base::binary_serializer::Write<Endian>(p, value);
+			return size;
+		}
+
+		///
+		/// @brief 序列化到流中。只调用 1 次 Stream::Write.
+		///
+		/// @param value
+		/// @param stream
+		///
+		static void Serialize(T const &value, base::Stream &stream)
+		{
+			if constexpr (IsFixedSize && FixedSize <= 4096)
+			{
+				uint8_t buffer[FixedSize > 0 ? FixedSize : 1];
+				uint8_t *p = buffer;
+				base::binary_serializer::Write<Endian>(p, value);
+				stream.Write(base::ReadOnlySpan{buffer, FixedSize});
+			}
+			else
+			{
+				int64_t size = SerializedSize(value);
+				std::vector<uint8_t> buffer(static_cast<size_t>(size));
+				uint8_t *p = buffer.data();
+				base::binary_serializer::Write<Endian>(p, value);
+				stream.Write(base::ReadOnlySpan{buffer.data(), size});
+			}
+		}
+
+		///
+		/// @brief 从 span 中反序列化。
+		///
+		/// @note 视图类型的字段引用 span 中的字节，span 的生命周期必须覆盖它们的使用。
+		///
+		/// @param span
+		/// @param value
+		/// @return 消耗的字节数。
+		///
+		/// @exception base::StreamDeserializeException 字节数不够。
+		///
+		static int64_t Deserialize(base::ReadOnlySpan const &span, T &value)
+		{
+			uint8_t const *p = span.Buffer();
+			base::binary_serializer::Read<Endian>(p, span.Buffer() + span.Size(), value);
+			return p - span.Buffer();
+		}
+
+		///
+		/// @brief 从流中反序列化。
+		///
+		/// @note 不支持视图类型的字段。
+		///
+		/// @param stream
+		/// @param value
+		///
+		/// @exception base::StreamDeserializeException 流提前结束。
+		///
+		static void Deserialize(base::Stream &stream, T &value)
+		{
+			base::binary_serializer::ReadFromStream<Endian>(stream, value);
+		}
+	};
+
+} // namespace base
@@ -0,0 +1 @@
+#include "BinaryStreamSerializable.h" // IWYU pragma: keep
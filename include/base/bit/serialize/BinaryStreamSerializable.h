@@ -0,0 +1,56 @@
+#pragma once
+#include "base/bit/serialize/BinarySerializer.h"
+#include "base/bit/serialize/IStreamSerializable.h"
+#include "base/stream/Stream.h"
+#include <bit>
+
+namespace base
+{
+	///
+	/// @brief 用 BinarySerializer 实现 IStreamSerializable.
+	///
+	/// @note 派生类把自己作为 Derived 传进来，并且声明 BinaryFields:
+	/// 	@code
+	/// 	class Header :
+	/// 		public base::BinaryStreamSerializable<Header>
+	/// 	{
+	/// 	public:
+	/// 		uint16_t _id = 0;
+	/// 		int32_t _value = 0;
+	///
+	/// 		static constexpr auto BinaryFields()
+	/// 		{
+	/// 			return base::BinaryFieldList<&Header::_id, &Header::_value>{};
+	/// 		}
+	/// 	};
+	/// 	@endcode
+	///
+	/// @note 有视图类型字段的结构体不能从流中反序列化，不要继承本类。
+	///
+	template <typename Derived, std::endian Endian = std::endian::little>
+	class BinaryStreamSerializable :
+		public base::IStreamSerializable
+	{
+	public:
+		///
+		/// @brief 将对象序列化写入流中。
+		///
+		/// @param stream
+		///
+		virtual void SerializeIntoStream(base::Stream &stream) const override
+		{
+			base::BinarySerializer<Derived, Endian>::Serialize(static_cast<Derived const &>(*this), stream);
+		}
+
+		///
+		/// @brief 从流中反序列化得到对象。
+		///
+		/// @param stream
+		///
+		virtual void DeserializeFromStream(base::Stream &stream) override
+		{
+			base::BinarySerializer<Derived, Endian>::Deserialize(stream, static_cast<Derived &>(*this));
+		}
+	};
+
+} // namespace base
@@ -133,6 +133,18 @@ namespace base
 				return base::ethernet::receive(*_handle);
 			}
 
+			///
+			/// @brief 描述符环。
+			///
+			/// @note 需要批量收发，或者想要避免复制帧时使用。与 Send, Receive 不要混用。
+			///
+			/// @return
+			///
+			base::ethernet::IEthernetDescriptorRing &DescriptorRing() const
+			{
+				return base::ethernet::descriptor_ring(*_handle);
+			}
+
 			/* #endregion */
 
 			///
@@ -0,0 +1 @@
+#include "EthernetFrameBuffer.h" // IWYU pragma: keep
@@ -0,0 +1,44 @@
+#pragma once
+#include "base/stream/ReadOnlySpan.h"
+#include "base/stream/Span.h"
+#include <cstdint>
+
+namespace base::ethernet
+{
+	///
+	/// @brief 驱动借给应用程序的一个帧缓冲区。
+	///
+	/// @note 对应 DMA 描述符环中的一个描述符。借出期间驱动不会访问缓冲区，
+	/// 应用程序用完后必须归还，否则描述符环会耗尽。
+	///
+	struct EthernetFrameBuffer
+	{
+		///
+		/// @brief 描述符的编号。归还时驱动用它找到描述符，应用程序不要修改。
+		///
+		int64_t _index = -1;
+
+		///
+		/// @brief 整个缓冲区。
+		///
+		base::Span _buffer{};
+
+		///
+		/// @brief 缓冲区中有效的帧长度。
+		///
+		/// @note 接收时由驱动设置。发送前由应用程序设置。
+		///
+		int64_t _length = 0;
+
+		///
+		/// @brief 缓冲区中的帧。
+		///
+		/// @return
+		///
+		base::ReadOnlySpan Frame() const
+		{
+			return base::ReadOnlySpan{_buffer.Buffer(), _length};
+		}
+	};
+
+} // namespace base::ethernet
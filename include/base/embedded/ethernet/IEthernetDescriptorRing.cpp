@@ -0,0 +1 @@
+#include "IEthernetDescriptorRing.h" // IWYU pragma: keep
@@ -0,0 +1,66 @@
+#pragma once
+#include "base/container/ArraySpan.h"
+#include "base/container/ReadOnlyArraySpan.h"
+#include "base/embedded/ethernet/EthernetFrameBuffer.h"
+#include <cstdint>
+
+namespace base::ethernet
+{
+	///
+	/// @brief 以太网描述符环。驱动把帧缓冲区借给应用程序，应用程序处理完后归还。
+	///
+	/// @note 与 EthernetController::Send, Receive 不同，收发都不需要复制帧：
+	/// 	@li 接收：Receive 借出装有收到的帧的缓冲区，处理完后用 ReleaseReceived 归还。
+	/// 	应用程序可以持有缓冲区一段时间，例如排队等待其他线程处理。
+	/// 	@li 发送：AcquireTransmitBuffers 借出空的缓冲区，应用程序直接在里面构造帧，
+	/// 	设置好长度后用 Send 交给驱动。交给驱动后缓冲区就归驱动了，不需要再归还。
+	///
+	/// @note 所有方法都是批量的，一次调用处理多个帧，均摊每次调用的开销。
+	/// 借出时只借出现有的缓冲区，不会等待。
+	///
+	class IEthernetDescriptorRing
+	{
+	public:
+		virtual ~IEthernetDescriptorRing() = default;
+
+		///
+		/// @brief 每个帧缓冲区的大小。
+		///
+		/// @return
+		///
+		virtual int64_t BufferSize() const = 0;
+
+		///
+		/// @brief 借出收到的帧。
+		///
+		/// @param frames 借出的缓冲区写入这里。
+		///
+		/// @return 借出的个数。没有收到帧时返回 0.
+		///
+		virtual int64_t Receive(base::ArraySpan<base::ethernet::EthernetFrameBuffer> const &frames) = 0;
+
+		///
+		/// @brief 归还 Receive 借出的缓冲区。
+		///
+		/// @param frames
+		///
+		virtual void ReleaseReceived(base::ReadOnlyArraySpan<base::ethernet::EthernetFrameBuffer> const &frames) = 0;
+
+		///
+		/// @brief 借出空的发送缓冲区。
+		///
+		/// @param frames 借出的缓冲区写入这里。
+		///
+		/// @return 借出的个数。发送描述符都在使用中时返回 0.
+		///
+		virtual int64_t AcquireTransmitBuffers(base::ArraySpan<base::ethernet::EthernetFrameBuffer> const &frames) = 0;
+
+		///
+		/// @brief 发送 AcquireTransmitBuffers 借出的缓冲区中的帧。
+		///
+		/// @param frames 每个缓冲区的 _length 要设置为帧的长度。
+		///
+		virtual void Send(base::ReadOnlyArraySpan<base::ethernet::EthernetFrameBuffer> const &frames) = 0;
+	};
+
+} // namespace base::ethernet
@@ -0,0 +1,133 @@
+#include "LoopbackEthernetDescriptorRing.h"
+#include "base/string/define.h"
+#include <stdexcept>
+#include <string>
+
+base::ethernet::LoopbackEthernetDescriptorRing::LoopbackEthernetDescriptorRing(int64_t buffer_count, int64_t buffer_size)
+	: _buffer_size(buffer_size),
+	  _free_queue(buffer_count > 0 ? buffer_count : 1),
+	  _received_queue(buffer_count > 0 ? buffer_count : 1)
+{
+	if (buffer_count <= 0)
+	{
+		throw std::invalid_argument{CODE_POS_STR + "缓冲区个数必须大于 0."};
+	}
+
+	if (buffer_size < 60)
+	{
+		throw std::invalid_argument{CODE_POS_STR + "缓冲区至少要能装下 60 字节的最小以太网帧。"};
+	}
+
+	_memory.resize(buffer_count * buffer_size);
+	_states.resize(buffer_count, BufferState::Free);
+	_lengths.resize(buffer_count);
+	for (int64_t i = 0; i < buffer_count; i++)
+	{
+		_free_queue.Push(i);
+	}
+}
+
+void base::ethernet::LoopbackEthernetDescriptorRing::CheckState(base::ethernet::EthernetFrameBuffer const &frame,
+																BufferState expected_state) const
+{
+	if (frame._index < 0 || frame._index >= static_cast<int64_t>(_states.size()))
+	{
+		throw std::invalid_argument{CODE_POS_STR + "缓冲区编号 " + std::to_string(frame._index) + " 超出范围。"};
+	}
+
+	if (_states[frame._index] != expected_state)
+	{
+		throw std::invalid_argument{CODE_POS_STR + "缓冲区 " + std::to_string(frame._index) + " 不是由对应的方法借出的。"};
+	}
+}
+
+void base::ethernet::LoopbackEthernetDescriptorRing::Claim(base::ReadOnlyArraySpan<base::ethernet::EthernetFrameBuffer> const &frames,
+														   BufferState expected_state)
+{
+	for (int64_t i = 0; i < frames.Count(); i++)
+	{
+		try
+		{
+			CheckState(frames[i], expected_state);
+		}
+		catch (...)
+		{
+			for (int64_t j = 0; j < i; j++)
+			{
+				_states[frames[j]._index] = expected_state;
+			}
+
+			throw;
+		}
+
+		_states[frames[i]._index] = BufferState::Claimed;
+	}
+}
+
+int64_t base::ethernet::LoopbackEthernetDescriptorRing::Receive(base::ArraySpan<base::ethernet::EthernetFrameBuffer> const &frames)
+{
+	base::task::MutexGuard g{_lock};
+	int64_t count = 0;
+	while (count < frames.Count() && _received_queue.Count() > 0)
+	{
+		int64_t index = _received_queue.Pop();
+		_states[index] = BufferState::LentReceived;
+		frames[count] = base::ethernet::EthernetFrameBuffer{index, BufferAt(index), _lengths[index]};
+		count++;
+	}
+
+	return count;
+}
+
+void base::ethernet::LoopbackEthernetDescriptorRing::ReleaseReceived(base::ReadOnlyArraySpan<base::ethernet::EthernetFrameBuffer> const &frames)
+{
+	base::task::MutexGuard g{_lock};
+
+	// 先全部检查，出错时不改变任何状态。
+	Claim(frames, BufferState::LentReceived);
+
+	for (int64_t i = 0; i < frames.Count(); i++)
+	{
+		_states[frames[i]._index] = BufferState::Free;
+		_free_queue.Push(frames[i]._index);
+	}
+}
+
+int64_t base::ethernet::LoopbackEthernetDescriptorRing::AcquireTransmitBuffers(base::ArraySpan<base::ethernet::EthernetFrameBuffer> const &frames)
+{
+	base::task::MutexGuard g{_lock};
+	int64_t count = 0;
+	while (count < frames.Count() && _free_queue.Count() > 0)
+	{
+		int64_t index = _free_queue.Pop();
+		_states[index] = BufferState::LentForTransmit;
+		frames[count] = base::ethernet::EthernetFrameBuffer{index, BufferAt(index), 0};
+		count++;
+	}
+
+	return count;
+}
+
+void base::ethernet::LoopbackEthernetDescriptorRing::Send(base::ReadOnlyArraySpan<base::ethernet::EthernetFrameBuffer> const &frames)
+{
+	base::task::MutexGuard g{_lock};
+
+	for (int64_t i = 0; i < frames.Count(); i++)
+	{
+		if (frames[i]._length < 0 || frames[i]._length > _buffer_size)
+		{
+			throw std::invalid_argument{CODE_POS_STR + "帧长度 " + std::to_string(frames[i]._length) + " 超出缓冲区。"};
+		}
+	}
+
+	Claim(frames, BufferState::LentForTransmit);
+
+	// 环回：发送的缓冲区直接成为收到的帧。
+	for (int64_t i = 0; i < frames.Count(); i++)
+	{
+		int64_t index = frames[i]._index;
+		_states[index] = BufferState::Received;
+		_lengths[index] = frames[i]._length;
+		_received_queue.Push(index);
+	}
+}
@@ -0,0 +1,145 @@
+#pragma once
+#include "base/embedded/ethernet/IEthernetDescriptorRing.h"
+#include "base/string/define.h"
+#include "base/task/Mutex.h"
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace base::ethernet
+{
+	///
+	/// @brief 环回的描述符环。发送的帧原样变成收到的帧。
+	///
+	/// @note 不需要 PHY, 用来在主机上测试和测量使用描述符环的代码。
+	///
+	/// @note 所有缓冲区属于一个池。发送的缓冲区直接移入接收队列，归还的接收缓冲区回到池中，
+	/// 所以环回也不复制帧。
+	///
+	/// @note 线程安全。一个线程发送，另一个线程接收也可以。
+	///
+	class LoopbackEthernetDescriptorRing final :
+		public base::ethernet::IEthernetDescriptorRing
+	{
+	private:
+		enum class BufferState : uint8_t
+		{
+			Free,
+			LentForTransmit,
+			Received,
+			LentReceived,
+
+			///
+			/// @brief 归还或发送的一批缓冲区正在检查中。
+			///
+			Claimed,
+		};
+
+		///
+		/// @brief 固定容量的编号队列。容量等于缓冲区个数，同一个编号只会入队一次，所以不会满。
+		/// 满了说明状态被破坏了，放入时抛出异常。
+		///
+		class IndexQueue
+		{
+		private:
+			std::vector<int64_t> _items;
+			int64_t _head = 0;
+			int64_t _count = 0;
+
+		public:
+			IndexQueue(int64_t capacity)
+				: _items(capacity)
+			{
+			}
+
+			int64_t Count() const
+			{
+				return _count;
+			}
+
+			void Push(int64_t index)
+			{
+				if (_count >= static_cast<int64_t>(_items.size()))
+				{
+					throw std::runtime_error{CODE_POS_STR + "队列已满。"};
+				}
+
+				int64_t position = _head + _count;
+				if (position >= static_cast<int64_t>(_items.size()))
+				{
+					position -= static_cast<int64_t>(_items.size());
+				}
+
+				_items[position] = index;
+				_count++;
+			}
+
+			int64_t Pop()
+			{
+				int64_t index = _items[_head];
+				_head++;
+				if (_head == static_cast<int64_t>(_items.size()))
+				{
+					_head = 0;
+				}
+
+				_count--;
+				return index;
+			}
+		};
+
+		base::task::Mutex _lock{};
+		int64_t _buffer_size = 0;
+		std::vector<uint8_t> _memory;
+		std::vector<BufferState> _states;
+
+		///
+		/// @brief 每个缓冲区收到的帧的长度。
+		///
+		std::vector<int64_t> _lengths;
+
+		IndexQueue _free_queue;
+		IndexQueue _received_queue;
+
+		base::Span BufferAt(int64_t index)
+		{
+			return base::Span{_memory.data() + index * _buffer_size, _buffer_size};
+		}
+
+		void CheckState(base::ethernet::EthernetFrameBuffer const &frame, BufferState expected_state) const;
+
+		///
+		/// @brief 检查一批缓冲区都处于 expected_state, 然后全部改为 Claimed.
+		///
+		/// @note 边检查边改状态，同一个缓冲区出现两次时第二次检查会失败。出错时恢复已经改过的
+		/// 状态再抛出异常。
+		///
+		/// @param frames
+		/// @param expected_state
+		///
+		void Claim(base::ReadOnlyArraySpan<base::ethernet::EthernetFrameBuffer> const &frames, BufferState expected_state);
+
+	public:
+		///
+		/// @brief 构造函数。
+		///
+		/// @param buffer_count 缓冲区个数。
+		/// @param buffer_size 每个缓冲区的大小。
+		///
+		LoopbackEthernetDescriptorRing(int64_t buffer_count, int64_t buffer_size = 1536);
+
+		virtual int64_t BufferSize() const override
+		{
+			return _buffer_size;
+		}
+
+		virtual int64_t Receive(base::ArraySpan<base::ethernet::EthernetFrameBuffer> const &frames) override;
+
+		virtual void ReleaseReceived(base::ReadOnlyArraySpan<base::ethernet::EthernetFrameBuffer> const &frames) override;
+
+		virtual int64_t AcquireTransmitBuffers(base::ArraySpan<base::ethernet::EthernetFrameBuffer> const &frames) override;
+
+		virtual void Send(base::ReadOnlyArraySpan<base::ethernet::EthernetFrameBuffer> const &frames) override;
+	};
+
+} // namespace base::ethernet
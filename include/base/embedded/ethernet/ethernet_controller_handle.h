@@ -1,4 +1,5 @@
 #pragma once
+#include "base/embedded/ethernet/IEthernetDescriptorRing.h"
 #include "base/net/Mac.h"
 #include "base/stream/ReadOnlySpan.h"
 #include "base/unit/Mbps.h"
@@ -118,6 +119,16 @@ namespace base
 		///
 		base::ReadOnlySpan receive(base::ethernet::ethernet_controller_handle &h);
 
+		///
+		/// @brief 获取以太网控制器的描述符环。
+		///
+		/// @note 通过描述符环收发不需要复制帧。BSP 层基于 DMA 描述符实现。
+		///
+		/// @param h
+		/// @return
+		///
+		base::ethernet::IEthernetDescriptorRing &descriptor_ring(base::ethernet::ethernet_controller_handle &h);
+
 		/* #endregion */
 
 		///
@@ -4,14 +4,19 @@
 #include "base/container/iterator/IEnumerator.h"
 #include "base/container/StdPairWrapper.h"
 #include "base/filesystem/file.h"
+#include "base/filesystem/FileStreamCache.h"
 #include "base/filesystem/filesystem.h"
+#include "base/filesystem/LazyFileStream.h"
+#include "base/filesystem/ParallelDirectoryScanner.h"
 #include "base/filesystem/Path.h"
+#include "base/filesystem/ReadOnlyMemoryMapFileStream.h"
 #include "base/stream/Stream.h"
 #include "base/string/define.h"
 #include <cstdint>
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 namespace base
 {
@@ -26,6 +31,9 @@ namespace base
 		/// 这里封装一个通用的二进制文件字典，以字符串作为 key, 用来打开文件，然后返回此文件
 		/// 的流，作为 value.
 		///
+		/// @note 作为 value 的流是 LazyFileStream, 第一次读写时才打开文件。打开的文件放在
+		/// LRU 缓存中，同时打开的文件数不超过构造时指定的上限。只需要键的话用 Keys.
+		///
 		class FileDictionary final :
 			public base::IDictionary<std::string, std::shared_ptr<base::Stream> const>
 		{
@@ -35,13 +43,15 @@ namespace base
 			{
 			private:
 				std::shared_ptr<base::IEnumerator<base::filesystem::DirectoryEntry const>> _enumerator;
+				std::shared_ptr<base::filesystem::FileStreamCache> _stream_cache;
 				base::StdPairWrapper<std::string const, std::shared_ptr<base::Stream> const> _current_value;
 				base::IEnumerator<std::pair<std::string const, std::shared_ptr<base::Stream> const>>::Context_t _context{};
 
 			public:
-				Enumerator(base::Path const &workspace)
+				Enumerator(base::Path const &workspace, std::shared_ptr<base::filesystem::FileStreamCache> const &stream_cache)
 				{
 					_enumerator = base::filesystem::CreateDirectoryEntryEnumerator(workspace);
+					_stream_cache = stream_cache;
 				}
 
 				///
@@ -65,7 +75,9 @@ namespace base
 				{
 					base::filesystem::DirectoryEntry entry = _enumerator->CurrentValue();
 					std::string key = entry.Path().LastName().ToString();
-					std::shared_ptr<base::Stream> file_stream = base::file::OpenExisting(entry.Path());
+
+					// 不打开文件，读写流时才打开。
+					std::shared_ptr<base::Stream> file_stream{new base::filesystem::LazyFileStream{entry.Path(), _stream_cache}};
 
 					_current_value = std::pair<std::string const, std::shared_ptr<base::Stream> const>{
 						key,
@@ -115,6 +127,11 @@ namespace base
 			///
 			mutable int64_t _count = 0;
 
+			///
+			/// @brief 作为 value 的 LazyFileStream 通过本缓存打开文件。
+			///
+			std::shared_ptr<base::filesystem::FileStreamCache> _stream_cache;
+
 			///
 			/// @brief 当前的查找结果，找到了就打开文件，把文件流储存到本字段。
 			///
@@ -127,9 +144,88 @@ namespace base
 			base::Path _current_file_path;
 
 		public:
-			FileDictionary(base::Path const &workspace)
+			///
+			/// @brief 构造函数。
+			///
+			/// @param workspace 工作目录。
+			/// @param max_open_file_count 最多同时打开多少个文件。
+			///
+			FileDictionary(base::Path const &workspace, int64_t max_open_file_count = 64)
 			{
 				_workspace = workspace;
+				_stream_cache = std::shared_ptr<base::filesystem::FileStreamCache>{new base::filesystem::FileStreamCache{max_open_file_count}};
+			}
+
+			///
+			/// @brief 所有的键。只读取目录中的名称，不打开文件，也不查询每个文件的类型。
+			///
+			/// @return
+			///
+			std::vector<std::string> Keys() const
+			{
+				std::vector<std::string> ret;
+				base::filesystem::ReadDirectoryNames(_workspace, ret);
+				return ret;
+			}
+
+			///
+			/// @brief 以只读方式打开一个元素。
+			///
+			/// @note 根据文件大小分三种情况，前两种返回 ReadOnlyMemoryMapFileStream, 读取不需要
+			/// 系统调用，也不占用文件描述符：
+			/// 	@li 小于 16 KiB 时直接读进内存，因为映射的开销比直接读还大。
+			/// 	@li 从 16 KiB 到 memory_map_size_limit 时用 mmap 映射。只有 linux 上会映射，
+			/// 	其他平台也是读进内存。
+			/// 	@li 大于 memory_map_size_limit 时返回 LazyFileStream, 读取时才通过 StreamCache
+			/// 	打开文件。
+			///
+			/// @param key
+			/// @param memory_map_size_limit
+			///
+			/// @return 元素不存在返回空指针。
+			///
+			std::shared_ptr<base::Stream> OpenReadOnly(std::string const &key, int64_t memory_map_size_limit = 64 * 1024)
+			{
+				if (key.size() == 0)
+				{
+					throw std::invalid_argument{CODE_POS_STR + "键不能是空字符串。"};
+				}
+
+				base::Path file_path = _workspace + key;
+				if (!base::filesystem::Exists(file_path))
+				{
+					return nullptr;
+				}
+
+				// 先冲洗写过这个文件的流，映射才能看到写入的内容。
+				std::shared_ptr<base::Stream> cached_stream = _stream_cache->TryGet(file_path);
+				if (cached_stream != nullptr)
+				{
+					cached_stream->Flush();
+				}
+
+				if (_current_file_path == file_path && _current_file_stream != nullptr)
+				{
+					_current_file_stream->Flush();
+				}
+
+				std::shared_ptr<base::Stream> ret = base::filesystem::ReadOnlyMemoryMapFileStream::TryOpen(file_path, memory_map_size_limit);
+				if (ret != nullptr)
+				{
+					return ret;
+				}
+
+				return std::shared_ptr<base::Stream>{new base::filesystem::LazyFileStream{file_path, _stream_cache}};
+			}
+
+			///
+			/// @brief 同时打开的文件的缓存。
+			///
+			/// @return
+			///
+			base::filesystem::FileStreamCache const &StreamCache() const
+			{
+				return *_stream_cache;
 			}
 
 			///
@@ -183,24 +279,10 @@ namespace base
 					return nullptr;
 				}
 
-				try
-				{
-					_current_file_stream = base::file::OpenExisting(file_path);
-					_current_file_path = file_path;
-					return &_current_file_stream;
-				}
-				catch (std::exception const &e)
-				{
-					base::console().WriteError(CODE_POS_STR + e.what());
-					return nullptr;
-				}
-				catch (...)
-				{
-					base::console().WriteError(CODE_POS_STR + "未知异常。");
-					return nullptr;
-				}
-
-				return nullptr;
+				// 不打开文件，读写流时才打开。
+				_current_file_stream = std::shared_ptr<base::Stream>{new base::filesystem::LazyFileStream{file_path, _stream_cache}};
+				_current_file_path = file_path;
+				return &_current_file_stream;
 			}
 
 			///
@@ -227,6 +309,7 @@ namespace base
 						_current_file_stream = nullptr;
 					}
 
+					_stream_cache->Remove(file_path);
 					base::filesystem::Remove(file_path);
 					_count--;
 					return true;
@@ -243,6 +326,7 @@ namespace base
 			{
 				_current_file_path = "";
 				_current_file_stream = nullptr;
+				_stream_cache->Clear();
 
 				// 先删除工作目录，以达到清空字典的目的。
 				base::filesystem::Remove(_workspace);
@@ -253,6 +337,9 @@ namespace base
 			///
 			/// @brief 设置一个元素。本来不存在，会添加；本来就存在了，会覆盖。
 			///
+			/// @note 新文件的流放在 StreamCache 中，之后通过 Find 得到的是 LazyFileStream,
+			/// 与其他元素一样受 max_open_file_count 的限制。
+			///
 			/// @param key
 			///
 			/// @param item
@@ -273,7 +360,9 @@ namespace base
 					should_add_count = true;
 				}
 
-				_current_file_stream = base::file::CreateNewAnyway(file_path);
+				// 缓存中的流指向旧的文件，由 Create 替换为新文件的流。
+				_stream_cache->Create(file_path);
+				_current_file_stream = std::shared_ptr<base::Stream>{new base::filesystem::LazyFileStream{file_path, _stream_cache}};
 				_current_file_path = file_path;
 
 				if (should_add_count)
@@ -299,7 +388,7 @@ namespace base
 			///
 			virtual std::shared_ptr<IEnumerator<std::pair<std::string const, std::shared_ptr<base::Stream> const>>> GetEnumerator() override
 			{
-				return std::shared_ptr<Enumerator>{new Enumerator{_workspace}};
+				return std::shared_ptr<Enumerator>{new Enumerator{_workspace, _stream_cache}};
 			}
 		};
 
@@ -0,0 +1,88 @@
+#include "FileStreamCache.h" // IWYU pragma: keep
+#include "base/filesystem/file.h"
+#include "base/string/define.h"
+#include <stdexcept>
+
+base::filesystem::FileStreamCache::FileStreamCache(int64_t capacity)
+{
+	if (capacity < 1)
+	{
+		throw std::invalid_argument{CODE_POS_STR + "缓存容量不能小于 1."};
+	}
+
+	_capacity = capacity;
+}
+
+std::shared_ptr<base::Stream> base::filesystem::FileStreamCache::Get(base::Path const &path)
+{
+	std::shared_ptr<base::Stream> stream = TryGet(path);
+	if (stream != nullptr)
+	{
+		return stream;
+	}
+
+	stream = base::file::OpenExisting(path);
+	Insert(path.ToString(), stream);
+	return stream;
+}
+
+std::shared_ptr<base::Stream> base::filesystem::FileStreamCache::Create(base::Path const &path)
+{
+	Remove(path);
+	std::shared_ptr<base::Stream> stream = base::file::CreateNewAnyway(path);
+	Insert(path.ToString(), stream);
+	return stream;
+}
+
+void base::filesystem::FileStreamCache::Insert(std::string const &key, std::shared_ptr<base::Stream> const &stream)
+{
+	_open_count++;
+
+	if (static_cast<int64_t>(_streams.size()) >= _capacity)
+	{
+		// 丢弃前冲洗，使用者不用关心自己的流还在不在缓存中。
+		_streams.back().second->Flush();
+		_map.erase(_streams.back().first);
+		_streams.pop_back();
+	}
+
+	_streams.emplace_front(key, stream);
+	_map[key] = _streams.begin();
+}
+
+std::shared_ptr<base::Stream> base::filesystem::FileStreamCache::TryGet(base::Path const &path)
+{
+	auto it = _map.find(path.ToString());
+	if (it == _map.end())
+	{
+		return nullptr;
+	}
+
+	// 移到最前面。
+	_streams.splice(_streams.begin(), _streams, it->second);
+	return it->second->second;
+}
+
+void base::filesystem::FileStreamCache::Remove(base::Path const &path)
+{
+	auto it = _map.find(path.ToString());
+	if (it == _map.end())
+	{
+		return;
+	}
+
+	it->second->second->Flush();
+	_streams.erase(it->second);
+	_map.erase(it);
+}
+
+void base::filesystem::FileStreamCache::Clear()
+{
+	for (auto &pair : _streams)
+	{
+		pair.second->Flush();
+	}
+
+	_streams.clear();
+	_map.clear();
+}
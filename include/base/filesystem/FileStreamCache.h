@@ -0,0 +1,127 @@
+#pragma once
+#include "base/filesystem/Path.h"
+#include "base/stream/Stream.h"
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace base::filesystem
+{
+	///
+	/// @brief 打开的文件流的 LRU 缓存。
+	///
+	/// @note 缓存中的流数量达到上限时，再打开新文件会丢弃最久没有用过的流，从而限制同时打开的
+	/// 文件描述符数量。丢弃只是释放缓存对流的引用，别处还持有引用的话文件不会被关闭。
+	///
+	/// @note 同一个文件的多个使用者共享同一个流，所以使用者要自己记住位置，每次使用前设置位置。
+	/// 见 LazyFileStream.
+	///
+	/// @note 非线程安全。
+	///
+	class FileStreamCache
+	{
+	private:
+		int64_t _capacity = 0;
+
+		///
+		/// @brief 最近用过的在前面。
+		///
+		std::list<std::pair<std::string, std::shared_ptr<base::Stream>>> _streams;
+
+		std::unordered_map<std::string, std::list<std::pair<std::string, std::shared_ptr<base::Stream>>>::iterator> _map;
+
+		int64_t _open_count = 0;
+
+		///
+		/// @brief 把刚打开的流放到最前面。缓存满了就先丢弃最久没有用过的流。
+		///
+		/// @param key
+		/// @param stream
+		///
+		void Insert(std::string const &key, std::shared_ptr<base::Stream> const &stream);
+
+	public:
+		///
+		/// @brief 构造函数。
+		///
+		/// @param capacity 最多缓存多少个打开的流。
+		///
+		/// @exception std::invalid_argument capacity 小于 1 时抛出。
+		///
+		FileStreamCache(int64_t capacity);
+
+		///
+		/// @brief 获取文件的流。不在缓存中就用 base::file::OpenExisting 打开并放入缓存。
+		///
+		/// @param path
+		///
+		/// @return 不会返回空指针。
+		///
+		std::shared_ptr<base::Stream> Get(base::Path const &path);
+
+		///
+		/// @brief 获取已经在缓存中的文件的流。不会打开文件。
+		///
+		/// @param path
+		///
+		/// @return 不在缓存中返回空指针。
+		///
+		std::shared_ptr<base::Stream> TryGet(base::Path const &path);
+
+		///
+		/// @brief 用 base::file::CreateNewAnyway 创建新的空白文件，会覆盖旧的，并把流放入缓存。
+		/// 缓存中原来的流会先被冲洗并移除。
+		///
+		/// @param path
+		///
+		/// @return 不会返回空指针。
+		///
+		std::shared_ptr<base::Stream> Create(base::Path const &path);
+
+		///
+		/// @brief 冲洗并从缓存中移除文件的流。文件要被删除或重新创建前应该调用。
+		///
+		/// @param path
+		///
+		void Remove(base::Path const &path);
+
+		///
+		/// @brief 冲洗并清空缓存。
+		///
+		void Clear();
+
+		///
+		/// @brief 缓存中的流数量。
+		///
+		/// @return
+		///
+		int64_t Count() const
+		{
+			return static_cast<int64_t>(_streams.size());
+		}
+
+		///
+		/// @brief 最多缓存多少个打开的流。
+		///
+		/// @return
+		///
+		int64_t Capacity() const
+		{
+			return _capacity;
+		}
+
+		///
+		/// @brief 总共打开过多少次文件。
+		///
+		/// @return
+		///
+		int64_t OpenCount() const
+		{
+			return _open_count;
+		}
+	};
+
+} // namespace base::filesystem
@@ -0,0 +1,100 @@
+#include "LazyFileStream.h" // IWYU pragma: keep
+#include "base/IDisposable.h"
+#include "base/string/define.h"
+#include <stdexcept>
+
+std::shared_ptr<base::Stream> base::filesystem::LazyFileStream::Stream() const
+{
+	if (_closed)
+	{
+		throw base::ObjectDisposedException{};
+	}
+
+	std::shared_ptr<base::Stream> stream = _cache->Get(_path);
+	if (stream->Position() != _position)
+	{
+		stream->SetPosition(_position);
+	}
+
+	return stream;
+}
+
+base::filesystem::LazyFileStream::LazyFileStream(base::Path const &path, std::shared_ptr<base::filesystem::FileStreamCache> const &cache)
+{
+	if (cache == nullptr)
+	{
+		throw std::invalid_argument{CODE_POS_STR + "cache 不能是空指针。"};
+	}
+
+	_path = path;
+	_cache = cache;
+}
+
+int64_t base::filesystem::LazyFileStream::Length() const
+{
+	return Stream()->Length();
+}
+
+void base::filesystem::LazyFileStream::SetLength(int64_t value)
+{
+	std::shared_ptr<base::Stream> stream = Stream();
+	stream->SetLength(value);
+	_position = stream->Position();
+}
+
+void base::filesystem::LazyFileStream::SetPosition(int64_t value)
+{
+	if (_closed)
+	{
+		throw base::ObjectDisposedException{};
+	}
+
+	if (value < 0)
+	{
+		throw std::invalid_argument{CODE_POS_STR + "位置不能小于 0."};
+	}
+
+	// 只是记下来，下次读写时才设置到底层的流。
+	_position = value;
+}
+
+int64_t base::filesystem::LazyFileStream::Read(base::Span const &span)
+{
+	std::shared_ptr<base::Stream> stream = Stream();
+	int64_t have_read = stream->Read(span);
+	_position += have_read;
+	return have_read;
+}
+
+void base::filesystem::LazyFileStream::Write(base::ReadOnlySpan const &span)
+{
+	std::shared_ptr<base::Stream> stream = Stream();
+	stream->Write(span);
+	_position += span.Size();
+}
+
+void base::filesystem::LazyFileStream::Flush()
+{
+	if (_closed)
+	{
+		throw base::ObjectDisposedException{};
+	}
+
+	// 不在缓存中说明没有打开过，或者已经被缓存丢弃，丢弃时冲洗过了。
+	std::shared_ptr<base::Stream> stream = _cache->TryGet(_path);
+	if (stream != nullptr)
+	{
+		stream->Flush();
+	}
+}
+
+void base::filesystem::LazyFileStream::Close()
+{
+	if (_closed)
+	{
+		return;
+	}
+
+	_closed = true;
+	_cache->Remove(_path);
+}
@@ -0,0 +1,95 @@
+#pragma once
+#include "base/filesystem/FileStreamCache.h"
+#include "base/filesystem/Path.h"
+#include "base/stream/Stream.h"
+#include <cstdint>
+#include <memory>
+
+namespace base::filesystem
+{
+	///
+	/// @brief 延迟打开的文件流。
+	///
+	/// @note 构造时不打开文件，第一次读写时才通过 FileStreamCache 打开。缓存满了以后文件可能
+	/// 被关闭，下次读写时再打开，所以本对象自己记录位置，每次读写前设置到底层的流。
+	///
+	/// @note 非线程安全。
+	///
+	class LazyFileStream final :
+		public base::Stream
+	{
+	private:
+		base::Path _path;
+		std::shared_ptr<base::filesystem::FileStreamCache> _cache;
+		int64_t _position = 0;
+		bool _closed = false;
+
+		///
+		/// @brief 获取底层的流，并设置到本对象的位置。
+		///
+		/// @return
+		///
+		std::shared_ptr<base::Stream> Stream() const;
+
+	public:
+		///
+		/// @brief 构造函数。
+		///
+		/// @param path 文件必须存在。
+		/// @param cache 用来打开文件。
+		///
+		LazyFileStream(base::Path const &path, std::shared_ptr<base::filesystem::FileStreamCache> const &cache);
+
+		///
+		/// @brief 文件路径。
+		///
+		/// @return
+		///
+		base::Path const &Path() const
+		{
+			return _path;
+		}
+
+		/* #region 流属性 */
+
+		virtual bool CanRead() const override
+		{
+			return true;
+		}
+
+		virtual bool CanWrite() const override
+		{
+			return true;
+		}
+
+		virtual bool CanSeek() const override
+		{
+			return true;
+		}
+
+		virtual int64_t Length() const override;
+
+		virtual void SetLength(int64_t value) override;
+
+		virtual int64_t Position() const override
+		{
+			return _position;
+		}
+
+		virtual void SetPosition(int64_t value) override;
+
+		/* #endregion */
+
+		virtual int64_t Read(base::Span const &span) override;
+
+		virtual void Write(base::ReadOnlySpan const &span) override;
+
+		virtual void Flush() override;
+
+		///
+		/// @brief 关闭流。同时把文件从缓存中移除。
+		///
+		virtual void Close() override;
+	};
+
+} // namespace base::filesystem
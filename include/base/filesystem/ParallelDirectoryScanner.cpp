@@ -0,0 +1,454 @@
+#include "ParallelDirectoryScanner.h" // IWYU pragma: keep
+#include "base/string/define.h"
+#include "base/task/Mutex.h"
+#include "base/task/Semaphore.h"
+#include <stdexcept>
+#include <utility>
+
+#if defined(__linux__)
+	#include <cerrno>
+	#include <cstring>
+	#include <dirent.h>
+	#include <fcntl.h>
+	#include <sys/stat.h>
+	#include <sys/syscall.h>
+	#include <unistd.h>
+#else
+	#include "base/filesystem/filesystem.h"
+#endif
+
+namespace
+{
+	///
+	/// @brief 每个线程读取目录项用的缓冲区大小。getdents64 一次最多填满缓冲区。
+	///
+	constexpr size_t _read_buffer_size = 256 * 1024;
+
+#if defined(__linux__)
+
+	std::string JoinPath(std::string const &directory_path, char const *name, size_t name_length)
+	{
+		std::string ret;
+		ret.reserve(directory_path.size() + 1 + name_length);
+		ret += directory_path;
+		if (ret.empty() || ret.back() != '/')
+		{
+			ret += '/';
+		}
+
+		ret.append(name, name_length);
+		return ret;
+	}
+
+	///
+	/// @brief 析构时关闭文件描述符。
+	///
+	class FileDescriptorGuard
+	{
+	private:
+		int _fd = -1;
+
+	public:
+		FileDescriptorGuard(int fd)
+			: _fd(fd)
+		{
+		}
+
+		~FileDescriptorGuard()
+		{
+			if (_fd >= 0)
+			{
+				close(_fd);
+			}
+		}
+
+		FileDescriptorGuard(FileDescriptorGuard const &) = delete;
+		FileDescriptorGuard &operator=(FileDescriptorGuard const &) = delete;
+	};
+
+	base::filesystem::ScannedEntryType ToScannedEntryType(mode_t mode)
+	{
+		if (S_ISREG(mode))
+		{
+			return base::filesystem::ScannedEntryType::RegularFile;
+		}
+
+		if (S_ISDIR(mode))
+		{
+			return base::filesystem::ScannedEntryType::Directory;
+		}
+
+		if (S_ISLNK(mode))
+		{
+			return base::filesystem::ScannedEntryType::SymbolicLink;
+		}
+
+		return base::filesystem::ScannedEntryType::Other;
+	}
+
+	///
+	/// @brief 用 getdents64 读取目录，对 . 和 .. 以外的每个目录项调用 callback.
+	///
+	/// @param path
+	/// @param buffer
+	/// @param callback 参数是目录的文件描述符、名称、名称长度和 d_type.
+	///
+	template <typename CallbackType>
+	void ForEachDirectoryRecord(std::string const &path,
+								std::vector<uint8_t> &buffer,
+								CallbackType const &callback)
+	{
+		int fd = open(path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+		if (fd < 0)
+		{
+			throw std::runtime_error{CODE_POS_STR + "打开目录 " + path + " 失败：" + std::strerror(errno)};
+		}
+
+		FileDescriptorGuard g{fd};
+		buffer.resize(_read_buffer_size);
+
+		while (true)
+		{
+			long have_read = syscall(SYS_getdents64, fd, buffer.data(), buffer.size());
+			if (have_read < 0)
+			{
+				throw std::runtime_error{CODE_POS_STR + "读取目录 " + path + " 失败：" + std::strerror(errno)};
+			}
+
+			if (have_read == 0)
+			{
+				return;
+			}
+
+			// linux_dirent64 的布局：d_ino 8 字节，d_off 8 字节，d_reclen 2 字节，d_type 1 字节，
+			// 然后是以 0 结尾的 d_name. glibc 不导出这个结构体，所以按偏移量读取。
+			for (long offset = 0; offset < have_read;)
+			{
+				uint8_t const *record = buffer.data() + offset;
+				uint16_t record_length = 0;
+				std::memcpy(&record_length, record + 16, sizeof(record_length));
+				uint8_t type = record[18];
+				char const *name = reinterpret_cast<char const *>(record + 19);
+				offset += record_length;
+
+				size_t name_length = std::strlen(name);
+				if ((name_length == 1 && name[0] == '.') ||
+					(name_length == 2 && name[0] == '.' && name[1] == '.'))
+				{
+					continue;
+				}
+
+				callback(fd, name, name_length, type);
+			}
+		}
+	}
+
+	void ReadDirectory(std::string const &path,
+					   std::vector<uint8_t> &buffer,
+					   std::vector<base::filesystem::ScannedEntry> &entries)
+	{
+		ForEachDirectoryRecord(
+			path,
+			buffer,
+			[&](int fd, char const *name, size_t name_length, uint8_t type)
+			{
+				base::filesystem::ScannedEntry entry{};
+				entry._path = JoinPath(path, name, name_length);
+				switch (type)
+				{
+				case DT_REG:
+					{
+						entry._type = base::filesystem::ScannedEntryType::RegularFile;
+						break;
+					}
+				case DT_DIR:
+					{
+						entry._type = base::filesystem::ScannedEntryType::Directory;
+						break;
+					}
+				case DT_LNK:
+					{
+						entry._type = base::filesystem::ScannedEntryType::SymbolicLink;
+						break;
+					}
+				case DT_UNKNOWN:
+					{
+						// 有的文件系统不提供类型，只能 stat.
+						struct stat status{};
+						if (fstatat(fd, name, &status, AT_SYMLINK_NOFOLLOW) == 0)
+						{
+							entry._type = ToScannedEntryType(status.st_mode);
+						}
+
+						break;
+					}
+				default:
+					{
+						entry._type = base::filesystem::ScannedEntryType::Other;
+						break;
+					}
+				}
+
+				entries.push_back(std::move(entry));
+			});
+	}
+
+	void ReadDirectoryNames(std::string const &path,
+							std::vector<uint8_t> &buffer,
+							std::vector<std::string> &names)
+	{
+		ForEachDirectoryRecord(
+			path,
+			buffer,
+			[&](int /* fd */, char const *name, size_t name_length, uint8_t /* type */)
+			{
+				names.emplace_back(name, name_length);
+			});
+	}
+
+#else
+
+	void ReadDirectory(std::string const &path,
+					   std::vector<uint8_t> & /* buffer */,
+					   std::vector<base::filesystem::ScannedEntry> &entries)
+	{
+		// 通过平台提供的 CreateDirectoryEntryEnumerator 遍历。每个条目的类型要单独查询。
+		for (base::filesystem::DirectoryEntry const &directory_entry : base::filesystem::DirectoryEntryEnumerable{base::Path{path}})
+		{
+			base::filesystem::ScannedEntry entry{};
+			entry._path = directory_entry.Path().ToString();
+
+			// 先判断符号链接，指向目录的符号链接不能当作目录。
+			if (directory_entry.IsSymbolicLink())
+			{
+				entry._type = base::filesystem::ScannedEntryType::SymbolicLink;
+			}
+			else if (directory_entry.IsDirectory())
+			{
+				entry._type = base::filesystem::ScannedEntryType::Directory;
+			}
+			else if (directory_entry.IsRegularFile())
+			{
+				entry._type = base::filesystem::ScannedEntryType::RegularFile;
+			}
+			else
+			{
+				entry._type = base::filesystem::ScannedEntryType::Other;
+			}
+
+			entries.push_back(std::move(entry));
+		}
+	}
+
+	void ReadDirectoryNames(std::string const &path,
+							std::vector<uint8_t> & /* buffer */,
+							std::vector<std::string> &names)
+	{
+		// 只要名称，不查询类型。
+		for (base::filesystem::DirectoryEntry const &directory_entry : base::filesystem::DirectoryEntryEnumerable{base::Path{path}})
+		{
+			names.push_back(directory_entry.Path().LastName().ToString());
+		}
+	}
+
+#endif
+
+#if HAS_THREAD
+
+	///
+	/// @brief 一次 Scan 中各线程共享的状态。
+	///
+	class ScanContext
+	{
+	public:
+		ScanContext(int32_t thread_count, std::shared_ptr<base::CancellationToken> const &cancellation_token)
+			: _results(thread_count),
+			  _skipped_directory_counts(thread_count),
+			  _cancellation_token(cancellation_token)
+		{
+		}
+
+		base::task::Mutex _lock{};
+
+		///
+		/// @brief 每有一个待扫描的目录就释放一次。扫描结束时释放一次，每个退出的线程再释放一次，
+		/// 把所有线程依次唤醒。
+		///
+		base::Semaphore _pending_signal{0};
+
+		///
+		/// @brief 待扫描的目录。用作栈，深度优先，待扫描的目录不会堆积太多。
+		///
+		std::vector<std::string> _pending_directories;
+
+		///
+		/// @brief 还在栈中的和正在扫描的目录数。减到 0 时扫描结束。
+		///
+		int64_t _unfinished_count = 0;
+
+		bool _done = false;
+
+		///
+		/// @brief 每个线程的结果分开放，最后再合并，扫描过程中不用为了添加条目而加锁。
+		///
+		std::vector<std::vector<base::filesystem::ScannedEntry>> _results;
+
+		std::vector<int64_t> _skipped_directory_counts;
+
+		std::shared_ptr<base::CancellationToken> _cancellation_token;
+	};
+
+	void Work(ScanContext &context, int32_t thread_index)
+	{
+		std::vector<uint8_t> buffer;
+		std::vector<base::filesystem::ScannedEntry> &results = context._results[thread_index];
+		std::vector<std::string> sub_directories;
+
+		while (true)
+		{
+			context._pending_signal.Acquire();
+
+			std::string directory_path;
+			{
+				base::task::MutexGuard g{context._lock};
+				if (context._done)
+				{
+					context._pending_signal.Release();
+					return;
+				}
+
+				directory_path = std::move(context._pending_directories.back());
+				context._pending_directories.pop_back();
+			}
+
+			sub_directories.clear();
+			bool cancelled = base::is_cancellation_requested(context._cancellation_token);
+			if (!cancelled)
+			{
+				size_t first = results.size();
+				try
+				{
+					ReadDirectory(directory_path, buffer, results);
+				}
+				catch (std::exception const &)
+				{
+					context._skipped_directory_counts[thread_index]++;
+				}
+
+				for (size_t i = first; i < results.size(); i++)
+				{
+					if (results[i]._type == base::filesystem::ScannedEntryType::Directory)
+					{
+						sub_directories.push_back(results[i]._path);
+					}
+				}
+			}
+
+			base::task::MutexGuard g{context._lock};
+			context._unfinished_count += static_cast<int64_t>(sub_directories.size()) - 1;
+			if (cancelled || context._unfinished_count == 0)
+			{
+				context._done = true;
+				context._pending_signal.Release();
+				continue;
+			}
+
+			for (std::string &sub_directory : sub_directories)
+			{
+				context._pending_directories.push_back(std::move(sub_directory));
+			}
+
+			if (!sub_directories.empty())
+			{
+				context._pending_signal.Release(static_cast<int32_t>(sub_directories.size()));
+			}
+		}
+	}
+
+#endif // HAS_THREAD
+
+} // namespace
+
+void base::filesystem::ReadDirectory(base::Path const &path, std::vector<base::filesystem::ScannedEntry> &entries)
+{
+	std::vector<uint8_t> buffer;
+	::ReadDirectory(path.ToString(), buffer, entries);
+}
+
+void base::filesystem::ReadDirectoryNames(base::Path const &path, std::vector<std::string> &names)
+{
+	std::vector<uint8_t> buffer;
+	::ReadDirectoryNames(path.ToString(), buffer, names);
+}
+
+#if HAS_THREAD
+
+base::filesystem::ParallelDirectoryScanner::ParallelDirectoryScanner(int32_t thread_count)
+	: _thread_pool(thread_count)
+{
+	_thread_count = thread_count;
+}
+
+std::vector<base::filesystem::ScannedEntry> base::filesystem::ParallelDirectoryScanner::Scan(base::Path const &path,
+																								  std::shared_ptr<base::CancellationToken> const &cancellation_token)
+{
+	_skipped_directory_count = 0;
+
+	// 在本线程读取 path, 打不开就直接抛出异常。
+	std::vector<base::filesystem::ScannedEntry> ret;
+	std::vector<uint8_t> buffer;
+	::ReadDirectory(path.ToString(), buffer, ret);
+
+	std::shared_ptr<ScanContext> context{new ScanContext{_thread_count, cancellation_token}};
+	for (base::filesystem::ScannedEntry const &entry : ret)
+	{
+		if (entry._type == base::filesystem::ScannedEntryType::Directory)
+		{
+			context->_pending_directories.push_back(entry._path);
+		}
+	}
+
+	if (context->_pending_directories.empty())
+	{
+		return ret;
+	}
+
+	context->_unfinished_count = static_cast<int64_t>(context->_pending_directories.size());
+	context->_pending_signal.Release(static_cast<int32_t>(context->_pending_directories.size()));
+
+	std::vector<std::shared_ptr<base::task::ITask>> tasks;
+	for (int32_t i = 0; i < _thread_count; i++)
+	{
+		tasks.push_back(_thread_pool.Run(
+			[context, i]()
+			{
+				Work(*context, i);
+			}));
+	}
+
+	for (std::shared_ptr<base::task::ITask> const &task : tasks)
+	{
+		task->Wait();
+	}
+
+	size_t total_count = ret.size();
+	for (std::vector<base::filesystem::ScannedEntry> const &results : context->_results)
+	{
+		total_count += results.size();
+	}
+
+	ret.reserve(total_count);
+	for (int32_t i = 0; i < _thread_count; i++)
+	{
+		for (base::filesystem::ScannedEntry &entry : context->_results[i])
+		{
+			ret.push_back(std::move(entry));
+		}
+
+		_skipped_directory_count += context->_skipped_directory_counts[i];
+	}
+
+	return ret;
+}
+
+#endif // HAS_THREAD
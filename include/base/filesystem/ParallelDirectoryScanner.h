@@ -0,0 +1,123 @@
+#pragma once
+#include "base/filesystem/Path.h"
+#include "base/task/CancellationToken.h"
+#include "base/task/ThreadPool.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace base::filesystem
+{
+	///
+	/// @brief 扫描目录得到的条目类型。
+	///
+	/// @note 不跟随符号链接，符号链接就是 SymbolicLink, 不管它指向什么。
+	///
+	enum class ScannedEntryType : uint8_t
+	{
+		RegularFile,
+		Directory,
+		SymbolicLink,
+
+		///
+		/// @brief 设备文件、管道、套接字等。
+		///
+		Other,
+	};
+
+	///
+	/// @brief 扫描目录得到的条目。
+	///
+	/// @note 只有路径和类型，类型来自目录项本身，不需要对每个条目 stat.
+	///
+	struct ScannedEntry
+	{
+		///
+		/// @brief 被扫描的路径拼接上条目名称。
+		///
+		std::string _path;
+
+		base::filesystem::ScannedEntryType _type = base::filesystem::ScannedEntryType::Other;
+	};
+
+	///
+	/// @brief 读取一个目录中的条目，不递归。
+	///
+	/// @note linux 上用 getdents64 一次读取一大批目录项，类型取自目录项的 d_type, 只有文件系统
+	/// 不提供 d_type 时才 stat. 其他平台通过 CreateDirectoryEntryEnumerator 遍历，类型逐个查询。
+	///
+	/// @param path
+	/// @param entries 条目追加到这里。不包括 . 和 ..
+	///
+	/// @exception std::runtime_error 打开或读取目录失败时抛出。
+	///
+	void ReadDirectory(base::Path const &path, std::vector<base::filesystem::ScannedEntry> &entries);
+
+	///
+	/// @brief 只读取一个目录中的条目名称，不递归，也不查询类型。
+	///
+	/// @note 与 ReadDirectory 相同，linux 上用 getdents64, 但是文件系统不提供 d_type 时也不 stat.
+	/// 其他平台通过 CreateDirectoryEntryEnumerator 遍历，不逐个查询类型。
+	///
+	/// @param path
+	/// @param names 名称追加到这里，不包括路径。不包括 . 和 ..
+	///
+	/// @exception std::runtime_error 打开或读取目录失败时抛出。
+	///
+	void ReadDirectoryNames(base::Path const &path, std::vector<std::string> &names);
+
+#if HAS_THREAD
+
+	///
+	/// @brief 并行递归扫描目录。
+	///
+	/// @note 待扫描的子目录放在共享的栈中，线程池中的每个线程不断取出一个目录读取，
+	/// 把其中的子目录放回栈中，所以目录树不平衡时各线程的负载也是均衡的。
+	///
+	/// @note 不进入符号链接指向的目录。无法打开的子目录被跳过，计入 SkippedDirectoryCount.
+	///
+	class ParallelDirectoryScanner
+	{
+	private:
+		int32_t _thread_count = 1;
+		base::task::ThreadPool _thread_pool;
+		int64_t _skipped_directory_count = 0;
+
+	public:
+		///
+		/// @brief 构造函数。
+		///
+		/// @param thread_count 线程池中的线程数。
+		///
+		ParallelDirectoryScanner(int32_t thread_count);
+
+		///
+		/// @brief 递归扫描 path 下的所有条目。
+		///
+		/// @note 同一个对象不要在多个线程中同时调用本方法。
+		///
+		/// @param path
+		/// @param cancellation_token 取消后尽快返回，返回的条目不完整。
+		///
+		/// @return 所有条目，不包括 path 本身。顺序不确定。
+		///
+		/// @exception std::runtime_error 无法打开 path 时抛出。
+		///
+		std::vector<base::filesystem::ScannedEntry> Scan(base::Path const &path,
+														 std::shared_ptr<base::CancellationToken> const &cancellation_token = nullptr);
+
+		///
+		/// @brief 上一次 Scan 因为无法打开而跳过的子目录数。
+		///
+		/// @return
+		///
+		int64_t SkippedDirectoryCount() const
+		{
+			return _skipped_directory_count;
+		}
+	};
+
+#endif // HAS_THREAD
+
+} // namespace base::filesystem
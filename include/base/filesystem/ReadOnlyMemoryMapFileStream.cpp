@@ -0,0 +1,169 @@
+#include "ReadOnlyMemoryMapFileStream.h" // IWYU pragma: keep
+#include "base/IDisposable.h"
+#include "base/string/define.h"
+#include <algorithm>
+#include <stdexcept>
+
+#if defined(__linux__)
+	#include <cerrno>
+	#include <cstring>
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+
+namespace
+{
+	///
+	/// @brief 不小于这个大小的文件才映射。
+	///
+	constexpr int64_t MemoryMapThreshold = 16 * 1024;
+
+} // namespace
+#else
+	#include "base/filesystem/file.h"
+#endif
+
+std::shared_ptr<base::filesystem::ReadOnlyMemoryMapFileStream> base::filesystem::ReadOnlyMemoryMapFileStream::TryOpen(base::Path const &path,
+																														 int64_t max_size)
+{
+	std::shared_ptr<base::filesystem::ReadOnlyMemoryMapFileStream> ret{new base::filesystem::ReadOnlyMemoryMapFileStream{}};
+
+#if defined(__linux__)
+	int fd = open(path.ToString().c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
+	{
+		throw std::runtime_error{CODE_POS_STR + "打开文件 " + path.ToString() + " 失败：" + std::strerror(errno)};
+	}
+
+	struct stat status{};
+	if (fstat(fd, &status) != 0)
+	{
+		int error = errno;
+		close(fd);
+		throw std::runtime_error{CODE_POS_STR + "获取文件 " + path.ToString() + " 的大小失败：" + std::strerror(error)};
+	}
+
+	if (status.st_size > max_size)
+	{
+		close(fd);
+		return nullptr;
+	}
+
+	if (status.st_size < MemoryMapThreshold)
+	{
+		// 小文件映射和取消映射的开销比直接读还大。
+		ret->_content.resize(static_cast<size_t>(status.st_size));
+		int64_t have_read = 0;
+		while (have_read < status.st_size)
+		{
+			ssize_t result = read(fd, ret->_content.data() + have_read, static_cast<size_t>(status.st_size - have_read));
+			if (result < 0 && errno == EINTR)
+			{
+				continue;
+			}
+
+			if (result < 0)
+			{
+				int error = errno;
+				close(fd);
+				throw std::runtime_error{CODE_POS_STR + "读取文件 " + path.ToString() + " 失败：" + std::strerror(error)};
+			}
+
+			if (result == 0)
+			{
+				break;
+			}
+
+			have_read += result;
+		}
+
+		ret->_buffer = ret->_content.data();
+		ret->_length = have_read;
+	}
+	else
+	{
+		void *address = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+		if (address == MAP_FAILED)
+		{
+			int error = errno;
+			close(fd);
+			throw std::runtime_error{CODE_POS_STR + "映射文件 " + path.ToString() + " 失败：" + std::strerror(error)};
+		}
+
+		ret->_buffer = static_cast<uint8_t const *>(address);
+		ret->_length = status.st_size;
+	}
+
+	// 映射不依赖文件描述符。
+	close(fd);
+#else
+	std::shared_ptr<base::Stream> stream = base::file::OpenReadOnly(path);
+	if (stream->Length() > max_size)
+	{
+		return nullptr;
+	}
+
+	ret->_content.resize(static_cast<size_t>(stream->Length()));
+	ret->_length = stream->ReadExactly(base::Span{ret->_content.data(), static_cast<int64_t>(ret->_content.size())});
+	ret->_buffer = ret->_content.data();
+#endif
+
+	return ret;
+}
+
+base::filesystem::ReadOnlyMemoryMapFileStream::~ReadOnlyMemoryMapFileStream()
+{
+	Close();
+}
+
+void base::filesystem::ReadOnlyMemoryMapFileStream::SetPosition(int64_t value)
+{
+	if (value < 0 || value > _length)
+	{
+		throw std::invalid_argument{CODE_POS_STR + "位置超出范围。"};
+	}
+
+	_position = value;
+}
+
+int64_t base::filesystem::ReadOnlyMemoryMapFileStream::Read(base::Span const &span)
+{
+	if (_closed)
+	{
+		throw base::ObjectDisposedException{};
+	}
+
+	int64_t have_read = std::min<int64_t>(_length - _position, span.Size());
+	if (have_read <= 0)
+	{
+		return 0;
+	}
+
+	std::copy(_buffer + _position, _buffer + _position + have_read, span.Buffer());
+	_position += have_read;
+	return have_read;
+}
+
+void base::filesystem::ReadOnlyMemoryMapFileStream::Close()
+{
+	if (_closed)
+	{
+		return;
+	}
+
+	_closed = true;
+
+#if defined(__linux__)
+	if (_buffer != nullptr && _buffer != _content.data())
+	{
+		munmap(const_cast<uint8_t *>(_buffer), static_cast<size_t>(_length));
+	}
+#endif
+
+	_content = std::vector<uint8_t>{};
+
+	_buffer = nullptr;
+	_length = 0;
+	_position = 0;
+}
@@ -0,0 +1,135 @@
+#pragma once
+#include "base/exception/NotSupportedException.h"
+#include "base/filesystem/Path.h"
+#include "base/stream/ReadOnlySpan.h"
+#include "base/stream/Stream.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace base::filesystem
+{
+	///
+	/// @brief 把整个文件只读地映射到内存的流。
+	///
+	/// @note 映射后立即关闭文件，不占用文件描述符。读取就是从内存复制，不需要系统调用，
+	/// 还可以用 Span 直接访问文件内容。整个文件都要放进内存或地址空间，所以调用者应该用
+	/// TryOpen 的 max_size 限制文件大小。
+	///
+	/// @note linux 上不小于 16 KiB 的文件用 mmap 映射，更小的文件映射的开销比直接读还大，
+	/// 就直接读进内存。其他平台都读进内存。
+	///
+	/// @note 文件在映射后被其他进程修改，读到的内容是未定义的。
+	///
+	class ReadOnlyMemoryMapFileStream final :
+		public base::Stream
+	{
+	private:
+		uint8_t const *_buffer = nullptr;
+		int64_t _length = 0;
+		int64_t _position = 0;
+		bool _closed = false;
+
+		///
+		/// @brief 不能映射时用来储存文件内容。
+		///
+		std::vector<uint8_t> _content;
+
+		ReadOnlyMemoryMapFileStream() = default;
+
+	public:
+		///
+		/// @brief 打开并映射文件。
+		///
+		/// @param path
+		/// @param max_size 文件大于这个大小就不映射，返回空指针。
+		///
+		/// @return 成功返回流，文件太大返回空指针。
+		///
+		/// @exception std::runtime_error 打开或映射文件失败时抛出。
+		///
+		static std::shared_ptr<base::filesystem::ReadOnlyMemoryMapFileStream> TryOpen(base::Path const &path, int64_t max_size);
+
+		///
+		/// @brief 打开并映射文件。
+		///
+		/// @param path
+		///
+		/// @return
+		///
+		/// @exception std::runtime_error 打开或映射文件失败时抛出。
+		///
+		static std::shared_ptr<base::filesystem::ReadOnlyMemoryMapFileStream> Open(base::Path const &path)
+		{
+			return TryOpen(path, INT64_MAX);
+		}
+
+		~ReadOnlyMemoryMapFileStream();
+
+		ReadOnlyMemoryMapFileStream(ReadOnlyMemoryMapFileStream const &) = delete;
+		ReadOnlyMemoryMapFileStream &operator=(ReadOnlyMemoryMapFileStream const &) = delete;
+
+		///
+		/// @brief 整个文件的内容。在流关闭前有效。
+		///
+		/// @return
+		///
+		base::ReadOnlySpan Span() const
+		{
+			return base::ReadOnlySpan{_buffer, _length};
+		}
+
+		/* #region 流属性 */
+
+		virtual bool CanRead() const override
+		{
+			return true;
+		}
+
+		virtual bool CanWrite() const override
+		{
+			return false;
+		}
+
+		virtual bool CanSeek() const override
+		{
+			return true;
+		}
+
+		virtual int64_t Length() const override
+		{
+			return _length;
+		}
+
+		virtual void SetLength(int64_t) override
+		{
+			throw base::NotSupportedException{};
+		}
+
+		virtual int64_t Position() const override
+		{
+			return _position;
+		}
+
+		virtual void SetPosition(int64_t value) override;
+
+		/* #endregion */
+
+		virtual int64_t Read(base::Span const &span) override;
+
+		virtual void Write(base::ReadOnlySpan const &) override
+		{
+			throw base::NotSupportedException{};
+		}
+
+		virtual void Flush() override
+		{
+		}
+
+		///
+		/// @brief 取消映射。之后 Span 返回空的内存段。
+		///
+		virtual void Close() override;
+	};
+
+} // namespace base::filesystem
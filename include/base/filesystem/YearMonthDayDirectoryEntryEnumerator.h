@@ -2,13 +2,19 @@
 #include "base/filesystem/DayDirectoryEnumerator.h"
 #include "base/filesystem/MonthDirectoryEnumerator.h"
 #include "base/filesystem/YearDirectoryEnumerator.h"
+#include "base/filesystem/YearMonthDayDirectoryIndex.h"
 #include "base/math/interval/Interval.h"
 #include "base/string/define.h"
 #include "base/task/CancellationToken.h"
 #include "base/time/DateTime.h"
+#include "base/time/DateTimeInterval.h"
 #include "filesystem.h"
+#include <algorithm>
+#include <cstdint>
 #include <memory>
 #include <stdexcept>
+#include <string>
+#include <vector>
 
 namespace base
 {
@@ -40,6 +46,304 @@ namespace base
 
 			std::shared_ptr<base::CancellationToken> _cancellation_token;
 
+			/* #region 精确探测 */
+
+			///
+			/// @brief 精确探测模式下的一个候选日目录。
+			///
+			struct DayDirectory
+			{
+				int64_t _year = 0;
+				int64_t _month = 0;
+				int64_t _day = 0;
+
+				///
+				/// @brief 日目录的路径。使用索引时从索引中得到，否则探测到之后才赋值。
+				///
+				base::Path _path;
+			};
+
+			///
+			/// @brief 根据时间范围算出候选日目录，而不是遍历年、月、日目录。
+			///
+			bool _is_exact_mode = false;
+
+			///
+			/// @brief 候选日目录来自索引，已经确定存在，不需要探测。
+			///
+			bool _is_indexed = false;
+
+			///
+			/// @brief 按日期排序的候选日目录。
+			///
+			std::vector<DayDirectory> _day_directories;
+
+			///
+			/// @brief 当前日目录在 _day_directories 中的下标。
+			///
+			int64_t _day_directory_index = -1;
+
+			///
+			/// @brief 上一次探测的年目录和月目录。相邻的候选日目录大多在同一个月，
+			/// 月目录不存在时整个月的日目录都不用探测了。
+			///
+			int64_t _probed_year = -1;
+			bool _probed_year_exists = false;
+			base::Path _probed_year_path;
+			int64_t _probed_month = -1;
+			bool _probed_month_exists = false;
+			base::Path _probed_month_path;
+
+			///
+			/// @brief 探测 parent_path 下名为 value 的目录。目录名可能补 0 到 width 位，也可能不补。
+			///
+			/// @param parent_path
+			/// @param value
+			/// @param width
+			/// @param result 探测到时接收目录的路径。
+			///
+			/// @return 目录存在返回 true, 否则返回 false.
+			///
+			static bool ProbeDirectory(base::Path const &parent_path, int64_t value, size_t width, base::Path &result)
+			{
+				std::string name = std::to_string(value);
+				if (name.size() < width)
+				{
+					base::Path padded_path = parent_path + base::Path{std::string(width - name.size(), '0') + name};
+					if (base::filesystem::IsDirectory(padded_path))
+					{
+						result = padded_path;
+						return true;
+					}
+				}
+
+				base::Path path = parent_path + base::Path{name};
+				if (base::filesystem::IsDirectory(path))
+				{
+					result = path;
+					return true;
+				}
+
+				return false;
+			}
+
+			///
+			/// @brief 探测候选日目录是否存在。
+			///
+			/// @param day_directory 存在时为其 _path 赋值。
+			///
+			/// @return
+			///
+			bool ProbeDayDirectory(DayDirectory &day_directory)
+			{
+				if (day_directory._year != _probed_year)
+				{
+					_probed_year = day_directory._year;
+					_probed_year_exists = ProbeDirectory(_base_path, _probed_year, 4, _probed_year_path);
+					_probed_month = -1;
+				}
+
+				if (!_probed_year_exists)
+				{
+					return false;
+				}
+
+				if (day_directory._month != _probed_month)
+				{
+					_probed_month = day_directory._month;
+					_probed_month_exists = ProbeDirectory(_probed_year_path, _probed_month, 2, _probed_month_path);
+				}
+
+				if (!_probed_month_exists)
+				{
+					return false;
+				}
+
+				return ProbeDirectory(_probed_month_path, day_directory._day, 2, day_directory._path);
+			}
+
+			///
+			/// @brief 本地时间的这一天是否与时间范围有交集。
+			///
+			/// @note 与 DayDirectoryEnumerator 的检查相同，所以两种模式得到的日目录相同。
+			///
+			/// @param interval 已经用 base::GetYearMonthDayDateTimeInterval 调整到整日的时间范围。
+			/// @param year
+			/// @param month
+			/// @param day
+			///
+			/// @return
+			///
+			bool IsDayInRange(base::Interval<base::DateTime> const &interval, int64_t year, int64_t month, int64_t day) const
+			{
+				base::ClosedInterval<base::DateTime> day_interval{
+					base::DateTime{
+						_utc_hour_offset,
+						year,
+						month,
+						day,
+						0,
+						0,
+						0,
+						0,
+					},
+					base::DateTime{
+						_utc_hour_offset,
+						year,
+						month,
+						day,
+						23,
+						59,
+						59,
+						static_cast<int64_t>(1e9) - 1,
+					},
+				};
+
+				return interval.HasIntersection(day_interval);
+			}
+
+			///
+			/// @brief 把 UTC 时间转换为本地时间所在的日期。
+			///
+			/// @param value
+			///
+			/// @return 时分秒都为 0 的日期。
+			///
+			base::DateTime ToLocalDate(base::DateTime value) const
+			{
+				value.AddHours(_utc_hour_offset.Value());
+				return base::DateTime{value.Year(), value.Month(), value.Day(), 0, 0, 0, 0};
+			}
+
+			///
+			/// @brief 根据时间范围算出候选日目录。
+			///
+			/// @note 时间范围的一端是无穷时，用基路径下最小或最大的年目录代替。
+			///
+			/// @param index 为空时候选日目录需要探测。不为空时只从索引中挑选，不访问文件系统。
+			///
+			void CollectDayDirectories(base::filesystem::YearMonthDayDirectoryIndex const *index)
+			{
+				base::Interval<base::DateTime> interval = base::GetYearMonthDayDateTimeInterval(_date_time_range);
+
+				// 调整到整日后再转换为本地日期，两端各多取一天，多出的会被 IsDayInRange 排除。
+				base::DateTime first{};
+				base::DateTime last{};
+				if (!interval.LeftIsInfinite())
+				{
+					first = ToLocalDate(interval.Left());
+					first.AddDays(-1);
+				}
+
+				if (!interval.RightIsInfinite())
+				{
+					last = ToLocalDate(interval.Right());
+					last.AddDays(1);
+				}
+
+				if (index != nullptr)
+				{
+					auto it = index->Items().begin();
+					auto end = index->Items().end();
+					if (!interval.LeftIsInfinite())
+					{
+						it = index->Items().lower_bound(base::filesystem::YearMonthDayDirectoryIndex::Key(first.Year(), first.Month(), first.Day()));
+					}
+
+					if (!interval.RightIsInfinite())
+					{
+						end = index->Items().upper_bound(base::filesystem::YearMonthDayDirectoryIndex::Key(last.Year(), last.Month(), last.Day()));
+					}
+
+					for (; it != end; ++it)
+					{
+						base::filesystem::YearMonthDayDirectoryIndex::Item const &item = it->second;
+						if (item._file_count <= 0 || !IsDayInRange(interval, item._year, item._month, item._day))
+						{
+							continue;
+						}
+
+						_day_directories.push_back(DayDirectory{
+							item._year,
+							item._month,
+							item._day,
+							_base_path + base::Path{item._relative_path},
+						});
+					}
+
+					return;
+				}
+
+				if (interval.LeftIsInfinite() || interval.RightIsInfinite())
+				{
+					int64_t min_year = INT64_MAX;
+					int64_t max_year = INT64_MIN;
+					base::filesystem::YearDirectoryEnumerator year_enumerator{_base_path, _cancellation_token};
+					for (; !year_enumerator.IsEnd(); year_enumerator.Add())
+					{
+						min_year = std::min(min_year, year_enumerator.Year());
+						max_year = std::max(max_year, year_enumerator.Year());
+					}
+
+					if (min_year > max_year)
+					{
+						return;
+					}
+
+					if (interval.LeftIsInfinite())
+					{
+						first = base::DateTime{min_year, 1, 1, 0, 0, 0, 0};
+					}
+
+					if (interval.RightIsInfinite())
+					{
+						last = base::DateTime{max_year, 12, 31, 0, 0, 0, 0};
+					}
+				}
+
+				for (base::DateTime date = first; date <= last; date.AddDays(1))
+				{
+					if (base::is_cancellation_requested(_cancellation_token))
+					{
+						return;
+					}
+
+					if (IsDayInRange(interval, date.Year(), date.Month(), date.Day()))
+					{
+						_day_directories.push_back(DayDirectory{date.Year(), date.Month(), date.Day(), base::Path{}});
+					}
+				}
+			}
+
+			bool MoveToNextExactDay()
+			{
+				while (true)
+				{
+					if (base::is_cancellation_requested(_cancellation_token))
+					{
+						return false;
+					}
+
+					_day_directory_index++;
+					if (_day_directory_index >= static_cast<int64_t>(_day_directories.size()))
+					{
+						return false;
+					}
+
+					if (_is_indexed)
+					{
+						return true;
+					}
+
+					if (ProbeDayDirectory(_day_directories[_day_directory_index]))
+					{
+						return true;
+					}
+				}
+			}
+
+			/* #endregion */
+
 			/* #region 递增迭代器 */
 
 			bool MoveToNextMonth()
@@ -130,13 +434,27 @@ namespace base
 
 					if (_file_iterator == nullptr || _file_iterator->IsEnd())
 					{
-						if (!MoveToNextDay())
+						base::Path day_dir_path;
+						if (_is_exact_mode)
 						{
-							return false;
+							if (!MoveToNextExactDay())
+							{
+								return false;
+							}
+
+							day_dir_path = _day_directories[_day_directory_index]._path;
+						}
+						else
+						{
+							if (!MoveToNextDay())
+							{
+								return false;
+							}
+
+							base::filesystem::DirectoryEntry entry = _day_dir_iterator->CurrentValue();
+							day_dir_path = entry.Path();
 						}
 
-						base::filesystem::DirectoryEntry entry = _day_dir_iterator->CurrentValue();
-						base::Path day_dir_path = entry.Path();
 						_file_iterator = base::filesystem::CreateDirectoryEntryEnumerator(day_dir_path);
 					}
 
@@ -184,6 +502,63 @@ namespace base
 				MoveToNextFile();
 			}
 
+			///
+			/// @brief 精确探测模式。
+			///
+			/// @note 根据时间范围算出有哪些日目录，只探测这些日目录是否存在，不遍历年目录和月目录。
+			/// 时间范围越窄，探测的目录越少。按日期从早到晚迭代。
+			///
+			/// @param base_path
+			/// @param date_time_range
+			/// @param utc_hour_offset
+			/// @param cancellation_token 可以在另一个线程中取消，让迭代的线程尽快结束迭代。
+			///
+			YearMonthDayDirectoryEntryEnumerator(base::Path const &base_path,
+												 base::Interval<base::DateTime> const &date_time_range,
+												 base::UtcHourOffset const &utc_hour_offset,
+												 std::shared_ptr<base::CancellationToken> cancellation_token)
+			{
+				_base_path = base_path;
+				_should_check_time_range = true;
+				_date_time_range = date_time_range;
+				_utc_hour_offset = utc_hour_offset;
+				_cancellation_token = cancellation_token;
+				_is_exact_mode = true;
+
+				CollectDayDirectories(nullptr);
+				MoveToNextFile();
+			}
+
+			///
+			/// @brief 索引模式。
+			///
+			/// @note 从索引中挑出时间范围内的日目录，不访问文件系统来探测。没有文件的日目录会被跳过。
+			/// 按日期从早到晚迭代。
+			///
+			/// @param base_path
+			/// @param index 构造时就复制出需要的条目，之后不再访问。
+			/// @param date_time_range
+			/// @param utc_hour_offset
+			/// @param cancellation_token 可以在另一个线程中取消，让迭代的线程尽快结束迭代。
+			///
+			YearMonthDayDirectoryEntryEnumerator(base::Path const &base_path,
+												 base::filesystem::YearMonthDayDirectoryIndex const &index,
+												 base::Interval<base::DateTime> const &date_time_range,
+												 base::UtcHourOffset const &utc_hour_offset,
+												 std::shared_ptr<base::CancellationToken> cancellation_token)
+			{
+				_base_path = base_path;
+				_should_check_time_range = true;
+				_date_time_range = date_time_range;
+				_utc_hour_offset = utc_hour_offset;
+				_cancellation_token = cancellation_token;
+				_is_exact_mode = true;
+				_is_indexed = true;
+
+				CollectDayDirectories(&index);
+				MoveToNextFile();
+			}
+
 			///
 			/// @brief 迭代器当前是否指向尾后元素。
 			///
@@ -238,6 +613,21 @@ namespace base
 			///
 			base::DateTime YearMonthDayDateTime() const
 			{
+				if (_is_exact_mode)
+				{
+					DayDirectory const &day_directory = _day_directories[_day_directory_index];
+					return base::DateTime{
+						base::UtcHourOffset{0},
+						day_directory._year,
+						day_directory._month,
+						day_directory._day,
+						0,
+						0,
+						0,
+						0,
+					};
+				}
+
 				base::DateTime ret{
 					base::UtcHourOffset{0},
 					_year_dir_iterator->Year(),
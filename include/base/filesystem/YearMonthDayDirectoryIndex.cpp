@@ -0,0 +1,198 @@
+#include "YearMonthDayDirectoryIndex.h" // IWYU pragma: keep
+#include "base/filesystem/DayDirectoryEnumerator.h"
+#include "base/filesystem/file.h"
+#include "base/filesystem/filesystem.h"
+#include "base/filesystem/MonthDirectoryEnumerator.h"
+#include "base/filesystem/YearDirectoryEnumerator.h"
+#include "base/string/define.h"
+#include "base/string/Parse.h"
+#include <stdexcept>
+#include <string_view>
+
+namespace
+{
+	constexpr std::string_view _header = "YearMonthDayDirectoryIndex 1";
+
+	///
+	/// @brief 从 line 中取出下一个以空格结尾的字段，解析为整数。
+	///
+	/// @param line 取出字段后，line 变成剩下的部分。
+	/// @param value
+	///
+	/// @return
+	///
+	bool TryTakeInteger(std::string_view &line, int64_t &value)
+	{
+		size_t space = line.find(' ');
+		if (space == std::string_view::npos)
+		{
+			return false;
+		}
+
+		base::ReadOnlySpan span{reinterpret_cast<uint8_t const *>(line.data()), static_cast<int64_t>(space)};
+		if (!base::TryParse(span, value))
+		{
+			return false;
+		}
+
+		line.remove_prefix(space + 1);
+		return true;
+	}
+
+} // namespace
+
+base::filesystem::YearMonthDayDirectoryIndex base::filesystem::YearMonthDayDirectoryIndex::Build(base::Path const &base_path,
+																								 std::shared_ptr<base::CancellationToken> const &cancellation_token)
+{
+	base::filesystem::YearMonthDayDirectoryIndex ret{};
+
+	base::filesystem::YearDirectoryEnumerator year_enumerator{base_path, cancellation_token};
+	for (; !year_enumerator.IsEnd(); year_enumerator.Add())
+	{
+		base::Path year_path = year_enumerator.CurrentValue().Path();
+		base::filesystem::MonthDirectoryEnumerator month_enumerator{year_path, cancellation_token};
+		for (; !month_enumerator.IsEnd(); month_enumerator.Add())
+		{
+			base::Path month_path = month_enumerator.CurrentValue().Path();
+			base::filesystem::DayDirectoryEnumerator day_enumerator{month_path, cancellation_token};
+			for (; !day_enumerator.IsEnd(); day_enumerator.Add())
+			{
+				base::Path day_path = day_enumerator.CurrentValue().Path();
+
+				Item item{};
+				item._year = year_enumerator.Year();
+				item._month = month_enumerator.Month();
+				item._day = day_enumerator.Day();
+				item._relative_path = year_path.LastName().ToString() + '/' +
+									  month_path.LastName().ToString() + '/' +
+									  day_path.LastName().ToString();
+
+				std::shared_ptr<base::IEnumerator<base::filesystem::DirectoryEntry const>> file_enumerator = base::filesystem::CreateDirectoryEntryEnumerator(day_path);
+				while (file_enumerator->MoveToNext())
+				{
+					item._file_count++;
+				}
+
+				ret.Set(item);
+			}
+		}
+	}
+
+	base::throw_if_cancellation_is_requested(cancellation_token);
+	return ret;
+}
+
+base::filesystem::YearMonthDayDirectoryIndex base::filesystem::YearMonthDayDirectoryIndex::Load(base::Path const &index_file_path)
+{
+	std::shared_ptr<base::Stream> stream = base::file::OpenReadOnly(index_file_path);
+	std::string text(static_cast<size_t>(stream->Length()), '\0');
+	stream->ReadExactly(base::Span{reinterpret_cast<uint8_t *>(text.data()), static_cast<int64_t>(text.size())});
+
+	base::filesystem::YearMonthDayDirectoryIndex ret{};
+	std::string_view remain = text;
+	int64_t line_number = 0;
+	while (!remain.empty())
+	{
+		size_t line_end = remain.find('\n');
+		std::string_view line = remain.substr(0, line_end);
+		remain.remove_prefix(line_end == std::string_view::npos ? remain.size() : line_end + 1);
+		if (!line.empty() && line.back() == '\r')
+		{
+			line.remove_suffix(1);
+		}
+
+		line_number++;
+		if (line_number == 1)
+		{
+			if (line != _header)
+			{
+				throw std::runtime_error{CODE_POS_STR + index_file_path.ToString() + " 不是年月日目录索引文件。"};
+			}
+
+			continue;
+		}
+
+		if (line.empty())
+		{
+			continue;
+		}
+
+		Item item{};
+		if (!TryTakeInteger(line, item._year) ||
+			!TryTakeInteger(line, item._month) ||
+			!TryTakeInteger(line, item._day) ||
+			!TryTakeInteger(line, item._file_count) ||
+			line.empty())
+		{
+			throw std::runtime_error{CODE_POS_STR + index_file_path.ToString() + " 第 " +
+									 std::to_string(line_number) + " 行格式错误。"};
+		}
+
+		item._relative_path = std::string{line};
+		ret.Set(item);
+	}
+
+	if (line_number == 0)
+	{
+		throw std::runtime_error{CODE_POS_STR + index_file_path.ToString() + " 不是年月日目录索引文件。"};
+	}
+
+	return ret;
+}
+
+void base::filesystem::YearMonthDayDirectoryIndex::Save(base::Path const &index_file_path) const
+{
+	std::string text{_header};
+	text += '\n';
+	for (auto const &pair : _items)
+	{
+		Item const &item = pair.second;
+		text += std::to_string(item._year) + ' ' +
+				std::to_string(item._month) + ' ' +
+				std::to_string(item._day) + ' ' +
+				std::to_string(item._file_count) + ' ' +
+				item._relative_path + '\n';
+	}
+
+	base::Path temp_path{index_file_path.ToString() + ".tmp"};
+	{
+		std::shared_ptr<base::Stream> stream = base::file::CreateNewAnyway(temp_path);
+		stream->Write(base::ReadOnlySpan{reinterpret_cast<uint8_t const *>(text.data()), static_cast<int64_t>(text.size())});
+		stream->Flush();
+		stream->Close();
+	}
+
+	base::filesystem::Move(temp_path, index_file_path, base::filesystem::OverwriteOption::Overwrite);
+}
+
+void base::filesystem::YearMonthDayDirectoryIndex::Set(Item const &item)
+{
+	_items[Key(item._year, item._month, item._day)] = item;
+}
+
+bool base::filesystem::YearMonthDayDirectoryIndex::Remove(int64_t year, int64_t month, int64_t day)
+{
+	return _items.erase(Key(year, month, day)) > 0;
+}
+
+base::filesystem::YearMonthDayDirectoryIndex::Item const *base::filesystem::YearMonthDayDirectoryIndex::Find(int64_t year, int64_t month, int64_t day) const
+{
+	auto it = _items.find(Key(year, month, day));
+	if (it == _items.end())
+	{
+		return nullptr;
+	}
+
+	return &it->second;
+}
+
+int64_t base::filesystem::YearMonthDayDirectoryIndex::FileCount() const
+{
+	int64_t count = 0;
+	for (auto const &pair : _items)
+	{
+		count += pair.second._file_count;
+	}
+
+	return count;
+}
@@ -0,0 +1,156 @@
+#pragma once
+#include "base/filesystem/Path.h"
+#include "base/task/CancellationToken.h"
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+
+namespace base::filesystem
+{
+	///
+	/// @brief “基路径/年/月/日/文件” 目录结构的索引。记录有哪些日目录，以及每个日目录中的文件数。
+	///
+	/// @note 按时间范围查询时，有了索引就不需要到文件系统中探测日目录是否存在，
+	/// 见 YearMonthDayDirectoryEntryEnumerator.
+	///
+	/// @note 索引只是某一时刻的快照。向目录结构中写入文件的一方应该同时调用 Set 更新索引再 Save,
+	/// 或者定期重新 Build.
+	///
+	/// @note 索引文件是文本文件，每行一个日目录：“年 月 日 文件数 相对于基路径的日目录路径”。
+	///
+	class YearMonthDayDirectoryIndex
+	{
+	public:
+		///
+		/// @brief 一个日目录。
+		///
+		struct Item
+		{
+			int64_t _year = 0;
+			int64_t _month = 0;
+			int64_t _day = 0;
+
+			///
+			/// @brief 日目录中的条目数。
+			///
+			int64_t _file_count = 0;
+
+			///
+			/// @brief 相对于基路径的日目录路径，例如 2024/01/05.
+			///
+			/// @note 目录名可能补 0 也可能不补，所以记下实际的名称。
+			///
+			std::string _relative_path;
+		};
+
+	private:
+		///
+		/// @brief 键是 年 * 10000 + 月 * 100 + 日，所以按键排序就是按日期排序。
+		///
+		std::map<int64_t, Item> _items;
+
+	public:
+		///
+		/// @brief 遍历基路径下的 年/月/日 目录，统计每个日目录中的条目数，构造索引。
+		///
+		/// @param base_path “基路径/年/月/日/文件” 中的 “基路径”。
+		/// @param cancellation_token
+		///
+		/// @return
+		///
+		static base::filesystem::YearMonthDayDirectoryIndex Build(base::Path const &base_path,
+																	std::shared_ptr<base::CancellationToken> const &cancellation_token = nullptr);
+
+		///
+		/// @brief 从索引文件加载。
+		///
+		/// @param index_file_path
+		///
+		/// @return
+		///
+		/// @exception std::runtime_error 索引文件格式错误时抛出。
+		///
+		static base::filesystem::YearMonthDayDirectoryIndex Load(base::Path const &index_file_path);
+
+		///
+		/// @brief 保存到索引文件。
+		///
+		/// @note 先写到临时文件再替换，其他进程不会读到写了一半的索引文件。
+		///
+		/// @param index_file_path
+		///
+		void Save(base::Path const &index_file_path) const;
+
+		///
+		/// @brief 日期对应的键。
+		///
+		/// @param year
+		/// @param month
+		/// @param day
+		///
+		/// @return
+		///
+		static constexpr int64_t Key(int64_t year, int64_t month, int64_t day)
+		{
+			return year * 10000 + month * 100 + day;
+		}
+
+		///
+		/// @brief 添加或替换一个日目录。
+		///
+		/// @param item
+		///
+		void Set(Item const &item);
+
+		///
+		/// @brief 移除一个日目录。
+		///
+		/// @param year
+		/// @param month
+		/// @param day
+		///
+		/// @return 索引中有这个日目录返回 true, 没有返回 false.
+		///
+		bool Remove(int64_t year, int64_t month, int64_t day);
+
+		///
+		/// @brief 查找一个日目录。
+		///
+		/// @param year
+		/// @param month
+		/// @param day
+		///
+		/// @return 找到了返回指向条目的指针，没找到返回空指针。指针在下一次修改索引之前有效。
+		///
+		Item const *Find(int64_t year, int64_t month, int64_t day) const;
+
+		///
+		/// @brief 所有日目录。键见 Key 函数，按日期排序。
+		///
+		/// @return
+		///
+		std::map<int64_t, Item> const &Items() const
+		{
+			return _items;
+		}
+
+		///
+		/// @brief 日目录的个数。
+		///
+		/// @return
+		///
+		int64_t Count() const
+		{
+			return static_cast<int64_t>(_items.size());
+		}
+
+		///
+		/// @brief 所有日目录中的条目总数。
+		///
+		/// @return
+		///
+		int64_t FileCount() const;
+	};
+
+} // namespace base::filesystem
@@ -0,0 +1,690 @@
+#include "AesCipher.h" // IWYU pragma: keep
+#include "base/string/define.h"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+	#define BASE_AES_NI 1
+	#include <immintrin.h>
+
+	#if defined(_MSC_VER) && !defined(__clang__)
+		#include <intrin.h>
+		#define BASE_AES_NI_TARGET
+	#else
+		#include <cpuid.h>
+		#define BASE_AES_NI_TARGET __attribute__((target("aes,sse2")))
+	#endif
+
+	// 展开各分组的循环，让 8 个分组都留在寄存器中。-O2 下编译器不会自动展开。
+	#if defined(__clang__)
+		#define BASE_AES_NI_UNROLL _Pragma("unroll")
+	#elif defined(__GNUC__)
+		#define BASE_AES_NI_UNROLL _Pragma("GCC unroll 8")
+	#else
+		#define BASE_AES_NI_UNROLL
+	#endif
+#else
+	#define BASE_AES_NI 0
+#endif
+
+namespace
+{
+	/* #region 表 */
+
+	///
+	/// @brief GF(2^8) 上的乘法，模多项式为 x^8 + x^4 + x^3 + x + 1.
+	///
+	/// @param a
+	/// @param b
+	/// @return
+	///
+	constexpr uint8_t GfMultiply(uint8_t a, uint8_t b)
+	{
+		uint8_t product = 0;
+		for (int i = 0; i < 8; i++)
+		{
+			if (b & 1)
+			{
+				product ^= a;
+			}
+
+			bool high_bit = a & 0x80;
+			a = static_cast<uint8_t>(a << 1);
+			if (high_bit)
+			{
+				a ^= 0x1b;
+			}
+
+			b >>= 1;
+		}
+
+		return product;
+	}
+
+	constexpr uint8_t RotateLeft8(uint8_t value, int shift)
+	{
+		return static_cast<uint8_t>((value << shift) | (value >> (8 - shift)));
+	}
+
+	///
+	/// @brief S 盒和 T 表。编译期由 GF(2^8) 运算生成，不用手抄常量。
+	///
+	struct Tables
+	{
+		std::array<uint8_t, 256> sbox{};
+		std::array<uint8_t, 256> inv_sbox{};
+
+		// te[0][x] 是 S[x] 乘以 MixColumns 矩阵的一列 (02, 01, 01, 03), 按大端排成一个字。
+		// te[1], te[2], te[3] 依次循环右移 8 位。
+		std::array<std::array<uint32_t, 256>, 4> te{};
+
+		// td[0][x] 是 InvS[x] 乘以 InvMixColumns 矩阵的一列 (0e, 09, 0d, 0b).
+		std::array<std::array<uint32_t, 256>, 4> td{};
+	};
+
+	constexpr Tables CreateTables()
+	{
+		Tables tables{};
+		for (int x = 0; x < 256; x++)
+		{
+			// x 的乘法逆元是 x^254. 0 的逆元规定为 0, x^254 恰好也是 0.
+			uint8_t inverse = 1;
+			uint8_t power = static_cast<uint8_t>(x);
+			for (int exponent = 254; exponent != 0; exponent >>= 1)
+			{
+				if (exponent & 1)
+				{
+					inverse = GfMultiply(inverse, power);
+				}
+
+				power = GfMultiply(power, power);
+			}
+
+			uint8_t s = inverse ^
+						RotateLeft8(inverse, 1) ^
+						RotateLeft8(inverse, 2) ^
+						RotateLeft8(inverse, 3) ^
+						RotateLeft8(inverse, 4) ^
+						0x63;
+
+			tables.sbox[x] = s;
+			tables.inv_sbox[s] = static_cast<uint8_t>(x);
+		}
+
+		for (int x = 0; x < 256; x++)
+		{
+			uint8_t s = tables.sbox[x];
+			uint32_t te0 = (static_cast<uint32_t>(GfMultiply(s, 2)) << 24) |
+						   (static_cast<uint32_t>(s) << 16) |
+						   (static_cast<uint32_t>(s) << 8) |
+						   static_cast<uint32_t>(GfMultiply(s, 3));
+
+			uint8_t is = tables.inv_sbox[x];
+			uint32_t td0 = (static_cast<uint32_t>(GfMultiply(is, 0x0e)) << 24) |
+						   (static_cast<uint32_t>(GfMultiply(is, 0x09)) << 16) |
+						   (static_cast<uint32_t>(GfMultiply(is, 0x0d)) << 8) |
+						   static_cast<uint32_t>(GfMultiply(is, 0x0b));
+
+			for (int i = 0; i < 4; i++)
+			{
+				tables.te[i][x] = std::rotr(te0, 8 * i);
+				tables.td[i][x] = std::rotr(td0, 8 * i);
+			}
+		}
+
+		return tables;
+	}
+
+	constexpr Tables _tables = CreateTables();
+
+	// 以 FIPS-197 的 S 盒开头几项验证生成结果。
+	static_assert(_tables.sbox[0x00] == 0x63 && _tables.sbox[0x01] == 0x7c && _tables.sbox[0x53] == 0xed);
+	static_assert(_tables.inv_sbox[0x63] == 0x00);
+
+	/* #endregion */
+
+	uint32_t LoadBigEndian(uint8_t const *bytes)
+	{
+		return (static_cast<uint32_t>(bytes[0]) << 24) |
+			   (static_cast<uint32_t>(bytes[1]) << 16) |
+			   (static_cast<uint32_t>(bytes[2]) << 8) |
+			   static_cast<uint32_t>(bytes[3]);
+	}
+
+	void StoreBigEndian(uint32_t value, uint8_t *bytes)
+	{
+		bytes[0] = static_cast<uint8_t>(value >> 24);
+		bytes[1] = static_cast<uint8_t>(value >> 16);
+		bytes[2] = static_cast<uint8_t>(value >> 8);
+		bytes[3] = static_cast<uint8_t>(value);
+	}
+
+	uint64_t ByteSwap64(uint64_t value)
+	{
+		return ((value & 0x00000000000000ffULL) << 56) |
+			   ((value & 0x000000000000ff00ULL) << 40) |
+			   ((value & 0x0000000000ff0000ULL) << 24) |
+			   ((value & 0x00000000ff000000ULL) << 8) |
+			   ((value & 0x000000ff00000000ULL) >> 8) |
+			   ((value & 0x0000ff0000000000ULL) >> 24) |
+			   ((value & 0x00ff000000000000ULL) >> 40) |
+			   ((value & 0xff00000000000000ULL) >> 56);
+	}
+
+	uint32_t SubWord(uint32_t word)
+	{
+		return (static_cast<uint32_t>(_tables.sbox[word >> 24]) << 24) |
+			   (static_cast<uint32_t>(_tables.sbox[(word >> 16) & 0xff]) << 16) |
+			   (static_cast<uint32_t>(_tables.sbox[(word >> 8) & 0xff]) << 8) |
+			   static_cast<uint32_t>(_tables.sbox[word & 0xff]);
+	}
+
+	///
+	/// @brief 对一个字做 InvMixColumns.
+	///
+	/// @note td 表中已经含有逆 S 盒，先查 S 盒抵消掉。
+	///
+	/// @param word
+	/// @return
+	///
+	uint32_t InvMixColumn(uint32_t word)
+	{
+		return _tables.td[0][_tables.sbox[word >> 24]] ^
+			   _tables.td[1][_tables.sbox[(word >> 16) & 0xff]] ^
+			   _tables.td[2][_tables.sbox[(word >> 8) & 0xff]] ^
+			   _tables.td[3][_tables.sbox[word & 0xff]];
+	}
+
+	/* #region T 表实现 */
+
+	void EncryptBlockTable(uint32_t const *rk, int round_count, uint8_t const *input, uint8_t *output)
+	{
+		auto const &te = _tables.te;
+		auto const &sbox = _tables.sbox;
+
+		uint32_t s0 = LoadBigEndian(input) ^ rk[0];
+		uint32_t s1 = LoadBigEndian(input + 4) ^ rk[1];
+		uint32_t s2 = LoadBigEndian(input + 8) ^ rk[2];
+		uint32_t s3 = LoadBigEndian(input + 12) ^ rk[3];
+
+		for (int round = 1; round < round_count; round++)
+		{
+			rk += 4;
+			uint32_t t0 = te[0][s0 >> 24] ^ te[1][(s1 >> 16) & 0xff] ^ te[2][(s2 >> 8) & 0xff] ^ te[3][s3 & 0xff] ^ rk[0];
+			uint32_t t1 = te[0][s1 >> 24] ^ te[1][(s2 >> 16) & 0xff] ^ te[2][(s3 >> 8) & 0xff] ^ te[3][s0 & 0xff] ^ rk[1];
+			uint32_t t2 = te[0][s2 >> 24] ^ te[1][(s3 >> 16) & 0xff] ^ te[2][(s0 >> 8) & 0xff] ^ te[3][s1 & 0xff] ^ rk[2];
+			uint32_t t3 = te[0][s3 >> 24] ^ te[1][(s0 >> 16) & 0xff] ^ te[2][(s1 >> 8) & 0xff] ^ te[3][s2 & 0xff] ^ rk[3];
+			s0 = t0;
+			s1 = t1;
+			s2 = t2;
+			s3 = t3;
+		}
+
+		// 最后一轮没有 MixColumns, 只查 S 盒。
+		rk += 4;
+		auto last = [&](uint32_t a, uint32_t b, uint32_t c, uint32_t d, uint32_t k)
+		{
+			return ((static_cast<uint32_t>(sbox[a >> 24]) << 24) |
+					(static_cast<uint32_t>(sbox[(b >> 16) & 0xff]) << 16) |
+					(static_cast<uint32_t>(sbox[(c >> 8) & 0xff]) << 8) |
+					static_cast<uint32_t>(sbox[d & 0xff])) ^
+				   k;
+		};
+
+		StoreBigEndian(last(s0, s1, s2, s3, rk[0]), output);
+		StoreBigEndian(last(s1, s2, s3, s0, rk[1]), output + 4);
+		StoreBigEndian(last(s2, s3, s0, s1, rk[2]), output + 8);
+		StoreBigEndian(last(s3, s0, s1, s2, rk[3]), output + 12);
+	}
+
+	void DecryptBlockTable(uint32_t const *rk, int round_count, uint8_t const *input, uint8_t *output)
+	{
+		auto const &td = _tables.td;
+		auto const &inv_sbox = _tables.inv_sbox;
+
+		uint32_t s0 = LoadBigEndian(input) ^ rk[0];
+		uint32_t s1 = LoadBigEndian(input + 4) ^ rk[1];
+		uint32_t s2 = LoadBigEndian(input + 8) ^ rk[2];
+		uint32_t s3 = LoadBigEndian(input + 12) ^ rk[3];
+
+		for (int round = 1; round < round_count; round++)
+		{
+			rk += 4;
+			uint32_t t0 = td[0][s0 >> 24] ^ td[1][(s3 >> 16) & 0xff] ^ td[2][(s2 >> 8) & 0xff] ^ td[3][s1 & 0xff] ^ rk[0];
+			uint32_t t1 = td[0][s1 >> 24] ^ td[1][(s0 >> 16) & 0xff] ^ td[2][(s3 >> 8) & 0xff] ^ td[3][s2 & 0xff] ^ rk[1];
+			uint32_t t2 = td[0][s2 >> 24] ^ td[1][(s1 >> 16) & 0xff] ^ td[2][(s0 >> 8) & 0xff] ^ td[3][s3 & 0xff] ^ rk[2];
+			uint32_t t3 = td[0][s3 >> 24] ^ td[1][(s2 >> 16) & 0xff] ^ td[2][(s1 >> 8) & 0xff] ^ td[3][s0 & 0xff] ^ rk[3];
+			s0 = t0;
+			s1 = t1;
+			s2 = t2;
+			s3 = t3;
+		}
+
+		rk += 4;
+		auto last = [&](uint32_t a, uint32_t b, uint32_t c, uint32_t d, uint32_t k)
+		{
+			return ((static_cast<uint32_t>(inv_sbox[a >> 24]) << 24) |
+					(static_cast<uint32_t>(inv_sbox[(b >> 16) & 0xff]) << 16) |
+					(static_cast<uint32_t>(inv_sbox[(c >> 8) & 0xff]) << 8) |
+					static_cast<uint32_t>(inv_sbox[d & 0xff])) ^
+				   k;
+		};
+
+		StoreBigEndian(last(s0, s3, s2, s1, rk[0]), output);
+		StoreBigEndian(last(s1, s0, s3, s2, rk[1]), output + 4);
+		StoreBigEndian(last(s2, s1, s0, s3, rk[2]), output + 8);
+		StoreBigEndian(last(s3, s2, s1, s0, rk[3]), output + 12);
+	}
+
+	/* #endregion */
+
+#if BASE_AES_NI
+
+	/* #region AES-NI 实现 */
+
+	// 同时在流水线中的分组数。aesenc 延迟约 4 个周期，每周期可发射 1 到 2 条，
+	// 8 个分组足以填满流水线。
+	constexpr int64_t _aes_ni_lanes = 8;
+
+	BASE_AES_NI_TARGET
+	void EncryptBlocksAesNi(uint8_t const *round_keys, int round_count,
+							uint8_t const *input, uint8_t *output, int64_t block_count)
+	{
+		__m128i keys[15];
+		for (int i = 0; i <= round_count; i++)
+		{
+			keys[i] = _mm_load_si128(reinterpret_cast<__m128i const *>(round_keys + 16 * i));
+		}
+
+		while (block_count >= _aes_ni_lanes)
+		{
+			__m128i b[_aes_ni_lanes];
+			BASE_AES_NI_UNROLL
+			for (int64_t j = 0; j < _aes_ni_lanes; j++)
+			{
+				b[j] = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<__m128i const *>(input + 16 * j)), keys[0]);
+			}
+
+			for (int round = 1; round < round_count; round++)
+			{
+				BASE_AES_NI_UNROLL
+				for (int64_t j = 0; j < _aes_ni_lanes; j++)
+				{
+					b[j] = _mm_aesenc_si128(b[j], keys[round]);
+				}
+			}
+
+			BASE_AES_NI_UNROLL
+			for (int64_t j = 0; j < _aes_ni_lanes; j++)
+			{
+				b[j] = _mm_aesenclast_si128(b[j], keys[round_count]);
+				_mm_storeu_si128(reinterpret_cast<__m128i *>(output + 16 * j), b[j]);
+			}
+
+			input += 16 * _aes_ni_lanes;
+			output += 16 * _aes_ni_lanes;
+			block_count -= _aes_ni_lanes;
+		}
+
+		for (; block_count > 0; block_count--)
+		{
+			__m128i b = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<__m128i const *>(input)), keys[0]);
+			for (int round = 1; round < round_count; round++)
+			{
+				b = _mm_aesenc_si128(b, keys[round]);
+			}
+
+			b = _mm_aesenclast_si128(b, keys[round_count]);
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(output), b);
+			input += 16;
+			output += 16;
+		}
+	}
+
+	///
+	/// @brief AES-NI 解密。
+	///
+	/// @note aesdec 实现的是等价逆密码，需要的轮密钥与 T 表解密相同，即倒序并经过 InvMixColumns.
+	///
+	BASE_AES_NI_TARGET
+	void DecryptBlocksAesNi(uint8_t const *round_keys, int round_count,
+							uint8_t const *input, uint8_t *output, int64_t block_count)
+	{
+		__m128i keys[15];
+		for (int i = 0; i <= round_count; i++)
+		{
+			keys[i] = _mm_load_si128(reinterpret_cast<__m128i const *>(round_keys + 16 * i));
+		}
+
+		while (block_count >= _aes_ni_lanes)
+		{
+			__m128i b[_aes_ni_lanes];
+			BASE_AES_NI_UNROLL
+			for (int64_t j = 0; j < _aes_ni_lanes; j++)
+			{
+				b[j] = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<__m128i const *>(input + 16 * j)), keys[0]);
+			}
+
+			for (int round = 1; round < round_count; round++)
+			{
+				BASE_AES_NI_UNROLL
+				for (int64_t j = 0; j < _aes_ni_lanes; j++)
+				{
+					b[j] = _mm_aesdec_si128(b[j], keys[round]);
+				}
+			}
+
+			BASE_AES_NI_UNROLL
+			for (int64_t j = 0; j < _aes_ni_lanes; j++)
+			{
+				b[j] = _mm_aesdeclast_si128(b[j], keys[round_count]);
+				_mm_storeu_si128(reinterpret_cast<__m128i *>(output + 16 * j), b[j]);
+			}
+
+			input += 16 * _aes_ni_lanes;
+			output += 16 * _aes_ni_lanes;
+			block_count -= _aes_ni_lanes;
+		}
+
+		for (; block_count > 0; block_count--)
+		{
+			__m128i b = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<__m128i const *>(input)), keys[0]);
+			for (int round = 1; round < round_count; round++)
+			{
+				b = _mm_aesdec_si128(b, keys[round]);
+			}
+
+			b = _mm_aesdeclast_si128(b, keys[round_count]);
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(output), b);
+			input += 16;
+			output += 16;
+		}
+	}
+
+	///
+	/// @brief AES-NI CTR. 只处理整批的 _aes_ni_lanes 个分组，计数器在寄存器中生成，
+	/// 密钥流直接与数据异或，不经过内存。
+	///
+	/// @return 处理的分组数。
+	///
+	BASE_AES_NI_TARGET
+	int64_t XcryptCtrAesNi(uint8_t const *round_keys, int round_count,
+						   uint8_t *data, int64_t block_count, uint64_t &high, uint64_t &low)
+	{
+		__m128i keys[15];
+		for (int i = 0; i <= round_count; i++)
+		{
+			keys[i] = _mm_load_si128(reinterpret_cast<__m128i const *>(round_keys + 16 * i));
+		}
+
+		int64_t done = 0;
+		while (block_count - done >= _aes_ni_lanes)
+		{
+			__m128i b[_aes_ni_lanes];
+			BASE_AES_NI_UNROLL
+			for (int64_t j = 0; j < _aes_ni_lanes; j++)
+			{
+				// 分组的前 8 字节是大端的 high, 后 8 字节是大端的 low.
+				// _mm_set_epi64x 的第二个参数放在低地址。
+				uint64_t l = low + static_cast<uint64_t>(j);
+				uint64_t h = high + (l < low ? 1 : 0);
+				__m128i counter = _mm_set_epi64x(static_cast<int64_t>(ByteSwap64(l)),
+												 static_cast<int64_t>(ByteSwap64(h)));
+
+				b[j] = _mm_xor_si128(counter, keys[0]);
+			}
+
+			for (int round = 1; round < round_count; round++)
+			{
+				BASE_AES_NI_UNROLL
+				for (int64_t j = 0; j < _aes_ni_lanes; j++)
+				{
+					b[j] = _mm_aesenc_si128(b[j], keys[round]);
+				}
+			}
+
+			BASE_AES_NI_UNROLL
+			for (int64_t j = 0; j < _aes_ni_lanes; j++)
+			{
+				__m128i *p = reinterpret_cast<__m128i *>(data + 16 * j);
+				b[j] = _mm_aesenclast_si128(b[j], keys[round_count]);
+				_mm_storeu_si128(p, _mm_xor_si128(_mm_loadu_si128(p), b[j]));
+			}
+
+			uint64_t new_low = low + _aes_ni_lanes;
+			high += new_low < low ? 1 : 0;
+			low = new_low;
+			data += 16 * _aes_ni_lanes;
+			done += _aes_ni_lanes;
+		}
+
+		return done;
+	}
+
+	/* #endregion */
+
+#endif // BASE_AES_NI
+
+} // namespace
+
+base::AesCipher::AesCipher(base::ReadOnlySpan const &key, bool allow_hardware)
+{
+	if (key.Size() != 16 && key.Size() != 24 && key.Size() != 32)
+	{
+		throw std::invalid_argument{CODE_POS_STR + "key 的大小必须是 16, 24 或 32 字节。"};
+	}
+
+	int key_word_count = static_cast<int>(key.Size() / 4);
+	_round_count = key_word_count + 6;
+	int total_word_count = 4 * (_round_count + 1);
+
+	/* #region 密钥扩展 */
+
+	for (int i = 0; i < key_word_count; i++)
+	{
+		_encrypt_words[i] = LoadBigEndian(key.Buffer() + 4 * i);
+	}
+
+	uint8_t rcon = 0x01;
+	for (int i = key_word_count; i < total_word_count; i++)
+	{
+		uint32_t temp = _encrypt_words[i - 1];
+		if (i % key_word_count == 0)
+		{
+			temp = SubWord((temp << 8) | (temp >> 24)) ^ (static_cast<uint32_t>(rcon) << 24);
+			rcon = GfMultiply(rcon, 2);
+		}
+		else if (key_word_count > 6 && i % key_word_count == 4)
+		{
+			temp = SubWord(temp);
+		}
+
+		_encrypt_words[i] = _encrypt_words[i - key_word_count] ^ temp;
+	}
+
+	for (int round = 0; round <= _round_count; round++)
+	{
+		for (int j = 0; j < 4; j++)
+		{
+			uint32_t word = _encrypt_words[4 * (_round_count - round) + j];
+			if (round != 0 && round != _round_count)
+			{
+				word = InvMixColumn(word);
+			}
+
+			_decrypt_words[4 * round + j] = word;
+		}
+	}
+
+	for (int i = 0; i < total_word_count; i++)
+	{
+		StoreBigEndian(_encrypt_words[i], _encrypt_bytes.data() + 4 * i);
+		StoreBigEndian(_decrypt_words[i], _decrypt_bytes.data() + 4 * i);
+	}
+
+	/* #endregion */
+
+	_use_aes_ni = allow_hardware && IsAesNiSupported();
+}
+
+bool base::AesCipher::IsAesNiSupported()
+{
+#if BASE_AES_NI
+	static bool const supported = []()
+	{
+	#if defined(_MSC_VER) && !defined(__clang__)
+		int info[4]{};
+		__cpuid(info, 1);
+		return (info[2] & (1 << 25)) != 0;
+	#else
+		unsigned int eax = 0;
+		unsigned int ebx = 0;
+		unsigned int ecx = 0;
+		unsigned int edx = 0;
+		if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+		{
+			return false;
+		}
+
+		return (ecx & bit_AES) != 0;
+	#endif
+	}();
+
+	return supported;
+#else
+	return false;
+#endif
+}
+
+void base::AesCipher::EncryptBlocks(uint8_t const *input, uint8_t *output, int64_t block_count) const
+{
+#if BASE_AES_NI
+	if (_use_aes_ni)
+	{
+		EncryptBlocksAesNi(_encrypt_bytes.data(), _round_count, input, output, block_count);
+		return;
+	}
+#endif
+
+	for (int64_t i = 0; i < block_count; i++)
+	{
+		EncryptBlockTable(_encrypt_words.data(), _round_count, input + 16 * i, output + 16 * i);
+	}
+}
+
+void base::AesCipher::DecryptBlocks(uint8_t const *input, uint8_t *output, int64_t block_count) const
+{
+#if BASE_AES_NI
+	if (_use_aes_ni)
+	{
+		DecryptBlocksAesNi(_decrypt_bytes.data(), _round_count, input, output, block_count);
+		return;
+	}
+#endif
+
+	for (int64_t i = 0; i < block_count; i++)
+	{
+		DecryptBlockTable(_decrypt_words.data(), _round_count, input + 16 * i, output + 16 * i);
+	}
+}
+
+void base::AesCipher::EncryptEcb(base::Span const &span) const
+{
+	if (span.Size() % BlockSize != 0)
+	{
+		throw std::invalid_argument{CODE_POS_STR + "span 的大小必须是 16 的整数倍。"};
+	}
+
+	EncryptBlocks(span.Buffer(), span.Buffer(), span.Size() / BlockSize);
+}
+
+void base::AesCipher::DecryptEcb(base::Span const &span) const
+{
+	if (span.Size() % BlockSize != 0)
+	{
+		throw std::invalid_argument{CODE_POS_STR + "span 的大小必须是 16 的整数倍。"};
+	}
+
+	DecryptBlocks(span.Buffer(), span.Buffer(), span.Size() / BlockSize);
+}
+
+void base::AesCipher::XcryptCtr(base::Span const &span, base::Span const &counter) const
+{
+	if (counter.Size() != BlockSize)
+	{
+		throw std::invalid_argument{CODE_POS_STR + "counter 的大小必须是 16 字节。"};
+	}
+
+	// 计数器是 128 位大端整数，拆成高低两个 64 位整数递增。
+	uint64_t high = (static_cast<uint64_t>(LoadBigEndian(counter.Buffer())) << 32) | LoadBigEndian(counter.Buffer() + 4);
+	uint64_t low = (static_cast<uint64_t>(LoadBigEndian(counter.Buffer() + 8)) << 32) | LoadBigEndian(counter.Buffer() + 12);
+
+	// 一次生成多个分组的密钥流，让 EncryptBlocks 可以流水线处理。
+	constexpr int64_t batch_block_count = 32;
+	alignas(16) uint8_t keystream[batch_block_count * BlockSize];
+
+	uint8_t *data = span.Buffer();
+	int64_t remain = span.Size();
+
+#if BASE_AES_NI
+	if (_use_aes_ni)
+	{
+		int64_t done = XcryptCtrAesNi(_encrypt_bytes.data(), _round_count,
+									  data, remain / BlockSize, high, low);
+
+		data += done * BlockSize;
+		remain -= done * BlockSize;
+	}
+#endif
+
+	// 剩下的数据，或者不使用 AES-NI 时的全部数据。
+	while (remain > 0)
+	{
+		int64_t block_count = std::min(batch_block_count, (remain + BlockSize - 1) / BlockSize);
+		for (int64_t i = 0; i < block_count; i++)
+		{
+			uint8_t *block = keystream + i * BlockSize;
+			StoreBigEndian(static_cast<uint32_t>(high >> 32), block);
+			StoreBigEndian(static_cast<uint32_t>(high), block + 4);
+			StoreBigEndian(static_cast<uint32_t>(low >> 32), block + 8);
+			StoreBigEndian(static_cast<uint32_t>(low), block + 12);
+
+			low++;
+			if (low == 0)
+			{
+				high++;
+			}
+		}
+
+		EncryptBlocks(keystream, keystream, block_count);
+
+		int64_t byte_count = std::min(remain, block_count * BlockSize);
+		int64_t i = 0;
+
+		// 按 8 字节异或。用 memcpy 读写，不要求 data 对齐。
+		for (; i + 8 <= byte_count; i += 8)
+		{
+			uint64_t d;
+			uint64_t k;
+			std::memcpy(&d, data + i, 8);
+			std::memcpy(&k, keystream + i, 8);
+			d ^= k;
+			std::memcpy(data + i, &d, 8);
+		}
+
+		for (; i < byte_count; i++)
+		{
+			data[i] ^= keystream[i];
+		}
+
+		data += byte_count;
+		remain -= byte_count;
+	}
+
+	StoreBigEndian(static_cast<uint32_t>(high >> 32), counter.Buffer());
+	StoreBigEndian(static_cast<uint32_t>(high), counter.Buffer() + 4);
+	StoreBigEndian(static_cast<uint32_t>(low >> 32), counter.Buffer() + 8);
+	StoreBigEndian(static_cast<uint32_t>(low), counter.Buffer() + 12);
+}
@@ -0,0 +1,107 @@
+#pragma once
+#include "base/stream/ReadOnlySpan.h"
+#include "base/stream/Span.h"
+#include <array>
+#include <cstdint>
+
+namespace base
+{
+	///
+	/// @brief AES 分组密码。支持 128, 192, 256 位密钥，提供 ECB 和 CTR 模式。
+	///
+	/// @note CPU 支持 AES-NI 时使用 AES-NI 指令，一次处理 8 个分组，让多个分组的轮运算
+	/// 在流水线中重叠。否则使用 T 表实现，每轮用 4 次查表代替逐字节的
+	/// SubBytes, ShiftRows, MixColumns.
+	///
+	/// @note 结果与 aes.c 相同。CTR 模式的计数器按 128 位大端整数递增，每个分组（包括
+	/// 最后不满 16 字节的分组）递增一次，与 AES_CTR_xcrypt_buffer 相同。
+	///
+	class AesCipher
+	{
+	private:
+		// 最多 15 轮密钥，每轮 4 个字。
+		static constexpr int _max_round_key_word_count = 60;
+
+		int _round_count = 0;
+		bool _use_aes_ni = false;
+
+		// 加密轮密钥，每个字按大端从密钥字节得到。
+		std::array<uint32_t, _max_round_key_word_count> _encrypt_words{};
+
+		// 等价逆密码的解密轮密钥：轮密钥倒序，中间各轮经过 InvMixColumns.
+		std::array<uint32_t, _max_round_key_word_count> _decrypt_words{};
+
+		// 按字节顺序排列的轮密钥，给 AES-NI 用。
+		alignas(16) std::array<uint8_t, _max_round_key_word_count * 4> _encrypt_bytes{};
+		alignas(16) std::array<uint8_t, _max_round_key_word_count * 4> _decrypt_bytes{};
+
+		void EncryptBlocks(uint8_t const *input, uint8_t *output, int64_t block_count) const;
+		void DecryptBlocks(uint8_t const *input, uint8_t *output, int64_t block_count) const;
+
+	public:
+		///
+		/// @brief 分组大小，单位：字节。
+		///
+		static constexpr int64_t BlockSize = 16;
+
+		///
+		/// @brief 构造 AES 密码。
+		///
+		/// @param key 密钥。大小必须是 16, 24 或 32 字节，分别对应 AES-128, AES-192, AES-256.
+		/// @param allow_hardware 是否允许使用 AES-NI. 传入 false 时总是使用 T 表实现，
+		/// 用于测试和比较。
+		///
+		AesCipher(base::ReadOnlySpan const &key, bool allow_hardware = true);
+
+		///
+		/// @brief 当前 CPU 是否支持 AES-NI.
+		///
+		/// @return
+		///
+		static bool IsAesNiSupported();
+
+		///
+		/// @brief 本对象是否使用 AES-NI.
+		///
+		/// @return
+		///
+		bool UsesAesNi() const
+		{
+			return _use_aes_ni;
+		}
+
+		///
+		/// @brief 轮数。AES-128 为 10, AES-192 为 12, AES-256 为 14.
+		///
+		/// @return
+		///
+		int RoundCount() const
+		{
+			return _round_count;
+		}
+
+		///
+		/// @brief 以 ECB 模式原地加密。
+		///
+		/// @param span 要加密的数据。大小必须是 16 的整数倍。
+		///
+		void EncryptEcb(base::Span const &span) const;
+
+		///
+		/// @brief 以 ECB 模式原地解密。
+		///
+		/// @param span 要解密的数据。大小必须是 16 的整数倍。
+		///
+		void DecryptEcb(base::Span const &span) const;
+
+		///
+		/// @brief 以 CTR 模式原地加密或解密。加密和解密是同一个操作。
+		///
+		/// @param span 要加密或解密的数据。大小任意。
+		/// @param counter 16 字节的计数器。处理完成后计数器递增了 span 占用的分组数，
+		/// 可以接着用来处理后续数据。
+		///
+		void XcryptCtr(base::Span const &span, base::Span const &counter) const;
+	};
+
+} // namespace base
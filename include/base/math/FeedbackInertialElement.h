@@ -1,4 +1,9 @@
 #pragma once
+#include "base/container/ArraySpan.h"
+#include "base/container/ReadOnlyArraySpan.h"
+#include "base/string/define.h"
+#include <cstdint>
+#include <stdexcept>
 
 namespace base
 {
@@ -61,6 +66,42 @@ namespace base
 			return Feedback();
 		}
 
+		///
+		/// @brief 依次输入 x 中的每个值，并将每个值产生的反馈输出写入 y.
+		///
+		/// @note 与逐个调用 Input(T) 的结果相同。
+		/// @note x 和 y 可以是同一段内存。
+		///
+		/// @param x 输入。
+		/// @param y 反馈输出。元素个数必须等于 x 的元素个数。
+		///
+		void Input(base::ReadOnlyArraySpan<T> const &x, base::ArraySpan<T> const &y)
+		{
+			if (x.Count() != y.Count())
+			{
+				throw std::invalid_argument{CODE_POS_STR + "x 和 y 的元素个数必须相等。"};
+			}
+
+			T const *input = x.Buffer();
+			T *output = y.Buffer();
+
+			// 状态放到局部变量中，循环中不需要反复读写成员。
+			//
+			// 上一个样本的反馈输出就是 current_output / _feedback_div, 直接用它计算误差，
+			// 每个样本只需要一次除法，结果与重新计算完全相同。
+			T current_output = _current_output;
+			T feedback = Feedback();
+			for (int64_t i = 0; i < x.Count(); i++)
+			{
+				T error = input[i] - feedback;
+				current_output += error * _k_error;
+				feedback = current_output / _feedback_div;
+				output[i] = feedback;
+			}
+
+			_current_output = current_output;
+		}
+
 		///
 		/// @brief 反馈输出。
 		///
@@ -0,0 +1 @@
+#include "FeedbackInertialElementBank.h" // IWYU pragma: keep
@@ -0,0 +1,198 @@
+#pragma once
+#include "base/container/ArraySpan.h"
+#include "base/container/ReadOnlyArraySpan.h"
+#include "base/math/FeedbackInertialElement.h"
+#include "base/string/define.h"
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace base
+{
+	///
+	/// @brief 多通道的 base::FeedbackInertialElement.
+	///
+	/// @note 各通道的参数和状态分别储存在连续的数组中，一次输入对所有通道迭代一遍，
+	/// 编译器可以向量化。
+	///
+	/// @note 每个通道的运算与 base::FeedbackInertialElement<T> 完全相同，结果也完全相同。
+	///
+	template <typename T>
+	class FeedbackInertialElementBank
+	{
+	private:
+		int64_t _channel_count = 0;
+		std::vector<T> _k_error;
+		std::vector<T> _feedback_div;
+		std::vector<T> _current_output;
+		std::vector<T> _feedback;
+
+		void CheckIndex(int64_t index) const
+		{
+			if (index < 0 || index >= _channel_count)
+			{
+				throw std::out_of_range{CODE_POS_STR + "index 超出范围。"};
+			}
+		}
+
+		///
+		/// @brief 向所有通道各输入一个值。
+		///
+		/// @note 上一次的反馈输出 _feedback 就是 _current_output / _feedback_div,
+		/// 直接使用它计算误差，每个样本只需要一次除法，结果与重新计算完全相同。
+		///
+		/// @note 循环中只写 _current_output 和 _feedback, 需要的输出在循环外复制，
+		/// 这样编译器检查指针是否重叠的代价小，能够向量化。
+		///
+		/// @param input
+		///
+		void InputFrame(T const *input)
+		{
+			T const *k_error = _k_error.data();
+			T const *feedback_div = _feedback_div.data();
+			T *current_output = _current_output.data();
+			T *feedback = _feedback.data();
+			for (int64_t i = 0; i < _channel_count; i++)
+			{
+				T error = input[i] - feedback[i];
+				T new_output = current_output[i] + error * k_error[i];
+				current_output[i] = new_output;
+				feedback[i] = new_output / feedback_div[i];
+			}
+		}
+
+	public:
+		FeedbackInertialElementBank() = default;
+
+		///
+		/// @brief 构造多通道惯性环节，所有通道使用相同的参数。
+		///
+		/// @param channel_count 通道数。
+		/// @param k_error
+		/// @param feedback_div
+		///
+		FeedbackInertialElementBank(int64_t channel_count, T const &k_error, T const &feedback_div)
+		{
+			if (channel_count < 0)
+			{
+				throw std::invalid_argument{CODE_POS_STR + "channel_count 不能 < 0."};
+			}
+
+			_channel_count = channel_count;
+			_k_error.resize(channel_count, k_error);
+			_feedback_div.resize(channel_count, feedback_div);
+			_current_output.resize(channel_count, 0);
+			_feedback.resize(channel_count, 0);
+		}
+
+		///
+		/// @brief 通道数。
+		///
+		/// @return
+		///
+		int64_t ChannelCount() const
+		{
+			return _channel_count;
+		}
+
+		///
+		/// @brief 更改一个通道的参数。
+		///
+		/// @param index
+		/// @param k_error
+		/// @param feedback_div
+		///
+		void SetChannel(int64_t index, T const &k_error, T const &feedback_div)
+		{
+			CheckIndex(index);
+			_k_error[index] = k_error;
+			_feedback_div[index] = feedback_div;
+			_feedback[index] = _current_output[index] / _feedback_div[index];
+		}
+
+		///
+		/// @brief 设置一个通道当前的反馈值。
+		///
+		/// @param index
+		/// @param value
+		///
+		void SetFeedback(int64_t index, T value)
+		{
+			CheckIndex(index);
+			_current_output[index] = value * _feedback_div[index];
+			_feedback[index] = _current_output[index] / _feedback_div[index];
+		}
+
+		///
+		/// @brief 向所有通道各输入一个值。
+		///
+		/// @param x 每个通道的输入。元素个数必须等于通道数。
+		///
+		void Input(base::ReadOnlyArraySpan<T> const &x)
+		{
+			if (x.Count() != _channel_count)
+			{
+				throw std::invalid_argument{CODE_POS_STR + "x 的元素个数必须等于通道数。"};
+			}
+
+			InputFrame(x.Buffer());
+		}
+
+		///
+		/// @brief 输入多个采样帧。
+		///
+		/// @note 每帧包含每个通道各一个值，即 frames 是按帧交错排列的多通道数据。
+		/// @note frames 和 outputs 可以是同一段内存。
+		///
+		/// @param frames 输入。元素个数必须是通道数的整数倍。
+		/// @param outputs 每帧输入后所有通道的反馈输出，排列方式与 frames 相同。
+		///
+		void Input(base::ReadOnlyArraySpan<T> const &frames, base::ArraySpan<T> const &outputs)
+		{
+			if (frames.Count() != outputs.Count())
+			{
+				throw std::invalid_argument{CODE_POS_STR + "frames 和 outputs 的元素个数必须相等。"};
+			}
+
+			if (_channel_count == 0)
+			{
+				return;
+			}
+
+			if (frames.Count() % _channel_count != 0)
+			{
+				throw std::invalid_argument{CODE_POS_STR + "frames 的元素个数必须是通道数的整数倍。"};
+			}
+
+			for (int64_t offset = 0; offset < frames.Count(); offset += _channel_count)
+			{
+				InputFrame(frames.Buffer() + offset);
+				std::copy(_feedback.begin(), _feedback.end(), outputs.Buffer() + offset);
+			}
+		}
+
+		///
+		/// @brief 所有通道的反馈输出。
+		///
+		/// @return
+		///
+		base::ReadOnlyArraySpan<T> Feedback() const
+		{
+			return base::ReadOnlyArraySpan<T>{_feedback.data(), _channel_count};
+		}
+
+		///
+		/// @brief 一个通道的反馈输出。
+		///
+		/// @param index
+		/// @return
+		///
+		T Feedback(int64_t index) const
+		{
+			CheckIndex(index);
+			return _feedback[index];
+		}
+	};
+
+} // namespace base
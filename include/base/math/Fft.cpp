@@ -0,0 +1,504 @@
+#include "Fft.h" // IWYU pragma: keep
+#include "base/string/define.h"
+#include <algorithm>
+#include <numbers>
+#include <stdexcept>
+
+namespace
+{
+	///
+	/// @brief 按基数的优先顺序排列的可以直接分解的质因数和 4.
+	///
+	/// @note 基数 4 的蝶形运算只需要加减和交换实部虚部，放在最前面尽量多地使用。
+	///
+	constexpr int64_t _radices[] = {4, 2, 3, 5, 7, 11, 13};
+
+	///
+	/// @brief exp(-2 * pi * i * numerator / denominator).
+	///
+	/// @note 先把分子对分母取余，再用 long double 计算角度，大长度下旋转因子也足够准确。
+	///
+	/// @param numerator
+	/// @param denominator
+	/// @return
+	///
+	std::complex<double> UnitRoot(int64_t numerator, int64_t denominator)
+	{
+		numerator %= denominator;
+		long double angle = -2 * std::numbers::pi_v<long double> * numerator / denominator;
+		return std::complex<double>{static_cast<double>(std::cos(angle)),
+									static_cast<double>(std::sin(angle))};
+	}
+
+	///
+	/// @brief 去掉 4 以外的可直接分解的因数后剩下的部分。为 1 说明不需要 Bluestein 算法。
+	///
+	/// @param size
+	/// @return
+	///
+	int64_t RemainingFactor(int64_t size)
+	{
+		for (int64_t radix : _radices)
+		{
+			while (size % radix == 0)
+			{
+				size /= radix;
+			}
+		}
+
+		return size;
+	}
+
+} // namespace
+
+base::Fft::Fft(int64_t size)
+{
+	if (size < 1)
+	{
+		throw std::invalid_argument{CODE_POS_STR + "size 不能 < 1."};
+	}
+
+	_size = size;
+	if (RemainingFactor(size) == 1)
+	{
+		InitializeStages();
+	}
+	else
+	{
+		InitializeBluestein();
+	}
+}
+
+void base::Fft::InitializeStages()
+{
+	int64_t n = _size;
+	for (int64_t radix : _radices)
+	{
+		while (n % radix == 0)
+		{
+			Stage stage{};
+			stage._radix = radix;
+			stage._m = n / radix;
+
+			stage._twiddles.resize(stage._m * (radix - 1));
+			for (int64_t p = 0; p < stage._m; p++)
+			{
+				for (int64_t j = 1; j < radix; j++)
+				{
+					stage._twiddles[p * (radix - 1) + j - 1] = UnitRoot(j * p, n);
+				}
+			}
+
+			if (radix > 5)
+			{
+				stage._roots.resize(radix);
+				for (int64_t k = 0; k < radix; k++)
+				{
+					stage._roots[k] = UnitRoot(k, radix);
+				}
+			}
+
+			_stages.push_back(std::move(stage));
+			n /= radix;
+		}
+	}
+
+	_work.resize(_size);
+	_work2.resize(_size);
+}
+
+void base::Fft::InitializeBluestein()
+{
+	// 卷积长度 >= 2n - 1 且是 2 的整数次幂，循环卷积才等于线性卷积。
+	int64_t convolution_size = 1;
+	while (convolution_size < 2 * _size - 1)
+	{
+		convolution_size *= 2;
+	}
+
+	_bluestein_fft = std::unique_ptr<base::Fft>{new base::Fft{convolution_size}};
+
+	// jk = (j^2 + k^2 - (k - j)^2) / 2, 所以 exp(-2 * pi * i * jk / n) 可以拆成
+	// chirp[j] * chirp[k] * conj(chirp[k - j]). k^2 对 2n 取余后再算角度，避免大数丢失精度。
+	_chirp.resize(_size);
+	for (int64_t k = 0; k < _size; k++)
+	{
+		int64_t k2 = (k * k) % (2 * _size);
+		_chirp[k] = UnitRoot(k2, 2 * _size);
+	}
+
+	_chirp_filter_spectrum.assign(convolution_size, std::complex<double>{});
+	_chirp_filter_spectrum[0] = std::conj(_chirp[0]);
+	for (int64_t k = 1; k < _size; k++)
+	{
+		_chirp_filter_spectrum[k] = std::conj(_chirp[k]);
+		_chirp_filter_spectrum[convolution_size - k] = std::conj(_chirp[k]);
+	}
+
+	base::ArraySpan<std::complex<double>> filter_span{_chirp_filter_spectrum.data(), convolution_size};
+	_bluestein_fft->Forward(filter_span, filter_span);
+	_work.resize(convolution_size);
+	_work2.resize(_size);
+}
+
+void base::Fft::RunStage(Stage const &stage, int64_t stride,
+						 std::complex<double> const *x, std::complex<double> *y) const
+{
+	// 第 p 组第 q 个蝶形运算：
+	// 		输入 x[q + s * (p + k * m)], k = 0, 1, ..., radix - 1
+	// 		输出 y[q + s * (radix * p + j)], j = 0, 1, ..., radix - 1
+	// 输出乘以旋转因子 W_n^(j * p). 同一组内 q 连续，最内层循环按连续地址访问。
+	//
+	// std::complex<double> 的内存布局保证是 double[2], 按 double 数组访问。
+	double const *xd = reinterpret_cast<double const *>(x);
+	double *yd = reinterpret_cast<double *>(y);
+	int64_t const m = stage._m;
+	double const *twiddles = reinterpret_cast<double const *>(stage._twiddles.data());
+
+	switch (stage._radix)
+	{
+	case 2:
+		{
+			for (int64_t p = 0; p < m; p++)
+			{
+				double const w1r = twiddles[2 * p];
+				double const w1i = twiddles[2 * p + 1];
+				double const *x0 = xd + 2 * stride * p;
+				double const *x1 = xd + 2 * stride * (p + m);
+				double *y0 = yd + 2 * stride * (stage._radix * p);
+				double *y1 = y0 + 2 * stride;
+
+				for (int64_t q = 0; q < 2 * stride; q += 2)
+				{
+					double ar = x0[q];
+					double ai = x0[q + 1];
+					double br = x1[q];
+					double bi = x1[q + 1];
+					double dr = ar - br;
+					double di = ai - bi;
+					y0[q] = ar + br;
+					y0[q + 1] = ai + bi;
+					y1[q] = dr * w1r - di * w1i;
+					y1[q + 1] = dr * w1i + di * w1r;
+				}
+			}
+
+			break;
+		}
+	case 3:
+		{
+			// sin(2 * pi / 3)
+			double const sin60 = 0.86602540378443864676;
+			for (int64_t p = 0; p < m; p++)
+			{
+				double const *w = twiddles + 4 * p;
+				double const w1r = w[0];
+				double const w1i = w[1];
+				double const w2r = w[2];
+				double const w2i = w[3];
+				double const *x0 = xd + 2 * stride * p;
+				double const *x1 = xd + 2 * stride * (p + m);
+				double const *x2 = xd + 2 * stride * (p + 2 * m);
+				double *y0 = yd + 2 * stride * (stage._radix * p);
+				double *y1 = y0 + 2 * stride;
+				double *y2 = y1 + 2 * stride;
+
+				for (int64_t q = 0; q < 2 * stride; q += 2)
+				{
+					double t1r = x1[q] + x2[q];
+					double t1i = x1[q + 1] + x2[q + 1];
+					double t2r = x0[q] - 0.5 * t1r;
+					double t2i = x0[q + 1] - 0.5 * t1i;
+
+					// (x1 - x2) * (-i * sin60)
+					double t3r = sin60 * (x1[q + 1] - x2[q + 1]);
+					double t3i = -sin60 * (x1[q] - x2[q]);
+
+					double b1r = t2r + t3r;
+					double b1i = t2i + t3i;
+					double b2r = t2r - t3r;
+					double b2i = t2i - t3i;
+
+					y0[q] = x0[q] + t1r;
+					y0[q + 1] = x0[q + 1] + t1i;
+					y1[q] = b1r * w1r - b1i * w1i;
+					y1[q + 1] = b1r * w1i + b1i * w1r;
+					y2[q] = b2r * w2r - b2i * w2i;
+					y2[q + 1] = b2r * w2i + b2i * w2r;
+				}
+			}
+
+			break;
+		}
+	case 4:
+		{
+			for (int64_t p = 0; p < m; p++)
+			{
+				double const *w = twiddles + 6 * p;
+				double const w1r = w[0];
+				double const w1i = w[1];
+				double const w2r = w[2];
+				double const w2i = w[3];
+				double const w3r = w[4];
+				double const w3i = w[5];
+				double const *x0 = xd + 2 * stride * p;
+				double const *x1 = xd + 2 * stride * (p + m);
+				double const *x2 = xd + 2 * stride * (p + 2 * m);
+				double const *x3 = xd + 2 * stride * (p + 3 * m);
+				double *y0 = yd + 2 * stride * (stage._radix * p);
+				double *y1 = y0 + 2 * stride;
+				double *y2 = y1 + 2 * stride;
+				double *y3 = y2 + 2 * stride;
+
+				for (int64_t q = 0; q < 2 * stride; q += 2)
+				{
+					double t0r = x0[q] + x2[q];
+					double t0i = x0[q + 1] + x2[q + 1];
+					double t1r = x0[q] - x2[q];
+					double t1i = x0[q + 1] - x2[q + 1];
+					double t2r = x1[q] + x3[q];
+					double t2i = x1[q + 1] + x3[q + 1];
+
+					// (x1 - x3) * (-i)
+					double t3r = x1[q + 1] - x3[q + 1];
+					double t3i = x3[q] - x1[q];
+
+					double b1r = t1r + t3r;
+					double b1i = t1i + t3i;
+					double b2r = t0r - t2r;
+					double b2i = t0i - t2i;
+					double b3r = t1r - t3r;
+					double b3i = t1i - t3i;
+
+					y0[q] = t0r + t2r;
+					y0[q + 1] = t0i + t2i;
+					y1[q] = b1r * w1r - b1i * w1i;
+					y1[q + 1] = b1r * w1i + b1i * w1r;
+					y2[q] = b2r * w2r - b2i * w2i;
+					y2[q + 1] = b2r * w2i + b2i * w2r;
+					y3[q] = b3r * w3r - b3i * w3i;
+					y3[q + 1] = b3r * w3i + b3i * w3r;
+				}
+			}
+
+			break;
+		}
+	case 5:
+		{
+			// cos(2 * pi / 5), cos(4 * pi / 5), sin(2 * pi / 5), sin(4 * pi / 5)
+			double const c1 = 0.30901699437494742410;
+			double const c2 = -0.80901699437494742410;
+			double const s1 = 0.95105651629515357212;
+			double const s2 = 0.58778525229247312917;
+			for (int64_t p = 0; p < m; p++)
+			{
+				double const *w = twiddles + 8 * p;
+				double const *x0 = xd + 2 * stride * p;
+				double const *x1 = xd + 2 * stride * (p + m);
+				double const *x2 = xd + 2 * stride * (p + 2 * m);
+				double const *x3 = xd + 2 * stride * (p + 3 * m);
+				double const *x4 = xd + 2 * stride * (p + 4 * m);
+				double *y0 = yd + 2 * stride * (stage._radix * p);
+				double *y1 = y0 + 2 * stride;
+				double *y2 = y1 + 2 * stride;
+				double *y3 = y2 + 2 * stride;
+				double *y4 = y3 + 2 * stride;
+
+				for (int64_t q = 0; q < 2 * stride; q += 2)
+				{
+					double t1r = x1[q] + x4[q];
+					double t1i = x1[q + 1] + x4[q + 1];
+					double t2r = x2[q] + x3[q];
+					double t2i = x2[q + 1] + x3[q + 1];
+					double t3r = x1[q] - x4[q];
+					double t3i = x1[q + 1] - x4[q + 1];
+					double t4r = x2[q] - x3[q];
+					double t4i = x2[q + 1] - x3[q + 1];
+
+					double m1r = x0[q] + c1 * t1r + c2 * t2r;
+					double m1i = x0[q + 1] + c1 * t1i + c2 * t2i;
+					double m2r = x0[q] + c2 * t1r + c1 * t2r;
+					double m2i = x0[q + 1] + c2 * t1i + c1 * t2i;
+					double n1r = s1 * t3r + s2 * t4r;
+					double n1i = s1 * t3i + s2 * t4i;
+					double n2r = s2 * t3r - s1 * t4r;
+					double n2i = s2 * t3i - s1 * t4i;
+
+					// b1 = m1 - i * n1, b4 = m1 + i * n1, b2 = m2 - i * n2, b3 = m2 + i * n2
+					double b1r = m1r + n1i;
+					double b1i = m1i - n1r;
+					double b4r = m1r - n1i;
+					double b4i = m1i + n1r;
+					double b2r = m2r + n2i;
+					double b2i = m2i - n2r;
+					double b3r = m2r - n2i;
+					double b3i = m2i + n2r;
+
+					y0[q] = x0[q] + t1r + t2r;
+					y0[q + 1] = x0[q + 1] + t1i + t2i;
+					y1[q] = b1r * w[0] - b1i * w[1];
+					y1[q + 1] = b1r * w[1] + b1i * w[0];
+					y2[q] = b2r * w[2] - b2i * w[3];
+					y2[q + 1] = b2r * w[3] + b2i * w[2];
+					y3[q] = b3r * w[4] - b3i * w[5];
+					y3[q + 1] = b3r * w[5] + b3i * w[4];
+					y4[q] = b4r * w[6] - b4i * w[7];
+					y4[q + 1] = b4r * w[7] + b4i * w[6];
+				}
+			}
+
+			break;
+		}
+	default:
+		{
+			// 7, 11, 13 出现得少，直接按定义计算 radix 点的 DFT.
+			int64_t const radix = stage._radix;
+			std::complex<double> const *roots = stage._roots.data();
+			std::complex<double> a[13];
+			for (int64_t p = 0; p < m; p++)
+			{
+				std::complex<double> const *w = stage._twiddles.data() + (radix - 1) * p;
+				for (int64_t q = 0; q < stride; q++)
+				{
+					for (int64_t k = 0; k < radix; k++)
+					{
+						a[k] = x[q + stride * (p + k * m)];
+					}
+
+					for (int64_t j = 0; j < radix; j++)
+					{
+						double br = 0;
+						double bi = 0;
+						for (int64_t k = 0; k < radix; k++)
+						{
+							std::complex<double> root = roots[(j * k) % radix];
+							br += a[k].real() * root.real() - a[k].imag() * root.imag();
+							bi += a[k].real() * root.imag() + a[k].imag() * root.real();
+						}
+
+						if (j > 0)
+						{
+							std::complex<double> twiddle = w[j - 1];
+							double r = br * twiddle.real() - bi * twiddle.imag();
+							bi = br * twiddle.imag() + bi * twiddle.real();
+							br = r;
+						}
+
+						y[q + stride * (radix * p + j)] = std::complex<double>{br, bi};
+					}
+				}
+			}
+
+			break;
+		}
+	}
+}
+
+void base::Fft::ForwardStockham(std::complex<double> const *input, std::complex<double> *output)
+{
+	int64_t stage_count = static_cast<int64_t>(_stages.size());
+	if (stage_count == 0)
+	{
+		output[0] = input[0];
+		return;
+	}
+
+	// 最后一级必须写到 output. 倒数第奇数级写 output, 倒数第偶数级写 _work.
+	// 原地变换时第一级如果也要写 output 就会覆盖还没读的输入，先把输入复制出来。
+	if (input == output && stage_count % 2 == 1)
+	{
+		std::copy(input, input + _size, _work2.data());
+		input = _work2.data();
+	}
+
+	std::complex<double> const *x = input;
+	int64_t stride = 1;
+	for (int64_t i = 0; i < stage_count; i++)
+	{
+		std::complex<double> *y = (stage_count - 1 - i) % 2 == 0 ? output : _work.data();
+		RunStage(_stages[i], stride, x, y);
+		stride *= _stages[i]._radix;
+		x = y;
+	}
+}
+
+void base::Fft::ForwardBluestein(std::complex<double> const *input, std::complex<double> *output)
+{
+	int64_t convolution_size = _bluestein_fft->Size();
+	std::complex<double> *a = _work.data();
+	for (int64_t k = 0; k < _size; k++)
+	{
+		a[k] = input[k] * _chirp[k];
+	}
+
+	std::fill(a + _size, a + convolution_size, std::complex<double>{});
+
+	base::ArraySpan<std::complex<double>> span{a, convolution_size};
+	_bluestein_fft->Forward(span, span);
+	for (int64_t k = 0; k < convolution_size; k++)
+	{
+		a[k] *= _chirp_filter_spectrum[k];
+	}
+
+	_bluestein_fft->Inverse(span, span);
+	for (int64_t k = 0; k < _size; k++)
+	{
+		output[k] = a[k] * _chirp[k];
+	}
+}
+
+void base::Fft::CheckSpans(int64_t input_count, int64_t output_count) const
+{
+	if (input_count != _size)
+	{
+		throw std::invalid_argument{CODE_POS_STR + "input 的元素个数必须等于变换长度。"};
+	}
+
+	if (output_count != _size)
+	{
+		throw std::invalid_argument{CODE_POS_STR + "output 的元素个数必须等于变换长度。"};
+	}
+}
+
+void base::Fft::Forward(base::ReadOnlyArraySpan<std::complex<double>> const &input,
+						base::ArraySpan<std::complex<double>> const &output)
+{
+	CheckSpans(input.Count(), output.Count());
+	if (_bluestein_fft != nullptr)
+	{
+		ForwardBluestein(input.Buffer(), output.Buffer());
+	}
+	else
+	{
+		ForwardStockham(input.Buffer(), output.Buffer());
+	}
+}
+
+void base::Fft::Inverse(base::ReadOnlyArraySpan<std::complex<double>> const &input,
+						base::ArraySpan<std::complex<double>> const &output)
+{
+	CheckSpans(input.Count(), output.Count());
+
+	// ifft(x) = conj(fft(conj(x))) / n
+	std::complex<double> *conjugate = _work2.data();
+	for (int64_t i = 0; i < _size; i++)
+	{
+		conjugate[i] = std::conj(input[i]);
+	}
+
+	if (_bluestein_fft != nullptr)
+	{
+		ForwardBluestein(conjugate, output.Buffer());
+	}
+	else
+	{
+		ForwardStockham(conjugate, output.Buffer());
+	}
+
+	double scale = 1.0 / static_cast<double>(_size);
+	std::complex<double> *out = output.Buffer();
+	for (int64_t i = 0; i < _size; i++)
+	{
+		out[i] = std::complex<double>{out[i].real() * scale, -out[i].imag() * scale};
+	}
+}
@@ -0,0 +1,114 @@
+#pragma once
+#include "base/container/ArraySpan.h"
+#include "base/container/ReadOnlyArraySpan.h"
+#include <complex>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace base
+{
+	///
+	/// @brief 复数快速傅里叶变换。
+	///
+	/// @note 构造时把长度分解为 4, 2, 3, 5, 7, 11, 13 的乘积，为每一级预先计算旋转因子。
+	/// 含有更大质因数的长度用 Bluestein 算法转换为 2 的整数次幂长度的卷积。任意长度都可以变换。
+	///
+	/// @note 使用 Stockham 自动排序算法，每一级在两个缓冲区之间来回写，不需要位反转重排。
+	/// 每一级最内层循环按连续地址访问，蝶形运算直接写成实部虚部的加法和乘法，
+	/// 不经过 std::complex 的乘法（它要处理无穷大和 NaN, 会调用库函数），编译器可以向量化。
+	///
+	/// @warning 对象内部有工作缓冲区，不能在多个线程中同时使用同一个对象。
+	///
+	class Fft
+	{
+	private:
+		///
+		/// @brief 一级蝶形运算。
+		///
+		class Stage
+		{
+		public:
+			// 基数。
+			int64_t _radix = 0;
+
+			// 本级输入序列长度除以基数。
+			int64_t _m = 0;
+
+			// 第 p 组的旋转因子 W_n^(j * p), j = 1, 2, ..., radix - 1, 按 [p][j - 1] 排列。
+			std::vector<std::complex<double>> _twiddles;
+
+			// 通用基数的蝶形运算用到的 W_radix^k, k = 0, 1, ..., radix - 1.
+			std::vector<std::complex<double>> _roots;
+		};
+
+		int64_t _size = 0;
+		std::vector<Stage> _stages;
+		std::vector<std::complex<double>> _work;
+		std::vector<std::complex<double>> _work2;
+
+		/* #region Bluestein */
+
+		// 长度含有大质因数时不为空。
+		std::unique_ptr<base::Fft> _bluestein_fft;
+
+		// exp(-i * pi * k^2 / n), k = 0, 1, ..., n - 1.
+		std::vector<std::complex<double>> _chirp;
+
+		// 卷积核的频谱。
+		std::vector<std::complex<double>> _chirp_filter_spectrum;
+
+		/* #endregion */
+
+		void InitializeStages();
+		void InitializeBluestein();
+
+		void RunStage(Stage const &stage, int64_t stride,
+					  std::complex<double> const *x, std::complex<double> *y) const;
+
+		void ForwardStockham(std::complex<double> const *input, std::complex<double> *output);
+		void ForwardBluestein(std::complex<double> const *input, std::complex<double> *output);
+
+		void CheckSpans(int64_t input_count, int64_t output_count) const;
+
+	public:
+		///
+		/// @brief 构造一个变换计划。
+		///
+		/// @param size 变换长度。不能 < 1.
+		///
+		Fft(int64_t size);
+
+		Fft(Fft const &o) = delete;
+		Fft &operator=(Fft const &o) = delete;
+
+		///
+		/// @brief 变换长度。
+		///
+		/// @return
+		///
+		int64_t Size() const
+		{
+			return _size;
+		}
+
+		///
+		/// @brief 正变换。X[k] = sum(x[j] * exp(-2 * pi * i * j * k / n)).
+		///
+		/// @param input 元素个数必须等于 Size().
+		/// @param output 元素个数必须等于 Size(). 可以与 input 是同一段内存。
+		///
+		void Forward(base::ReadOnlyArraySpan<std::complex<double>> const &input,
+					 base::ArraySpan<std::complex<double>> const &output);
+
+		///
+		/// @brief 逆变换。结果除以了 n, 所以 Inverse(Forward(x)) == x.
+		///
+		/// @param input 元素个数必须等于 Size().
+		/// @param output 元素个数必须等于 Size(). 可以与 input 是同一段内存。
+		///
+		void Inverse(base::ReadOnlyArraySpan<std::complex<double>> const &input,
+					 base::ArraySpan<std::complex<double>> const &output);
+	};
+
+} // namespace base
@@ -15,12 +15,229 @@ namespace base
 	///
 	/// @brief 分数类
 	///
+	/// @note 分子分母都能用 int64_t 表示时，使用 int64_t 储存和运算，运算带溢出检查，
+	/// 化简使用二进制 gcd 算法。只有运算溢出时才提升为 base::BigInteger 储存和运算。
+	/// 常见的单位换算中分子分母都很小，这样就不需要付出大整型运算的代价。
+	///
 	class Fraction final :
 		public base::ICanToString
 	{
 	private:
-		base::BigInteger _num = 0;
-		base::BigInteger _den = 1;
+		/* 使用 int64_t 表示时：
+		 * 		- _is_big 为 false.
+		 * 		- 分数总是最简的，且分母为正。
+		 * 		- 分子分母都不会等于 int64_t 的最小值，这样取相反数时不会溢出。
+		 *
+		 * 只有无法用 int64_t 表示时 _is_big 才为 true, 此时 _big_num, _big_den 才有意义。
+		 */
+
+		int64_t _small_num = 0;
+		int64_t _small_den = 1;
+		bool _is_big = false;
+		base::BigInteger _big_num = 0;
+		base::BigInteger _big_den = 1;
+
+		///
+		/// @brief 能否用 int64_t 表示法储存。
+		///
+		/// @param value
+		/// @return
+		///
+		template <typename T>
+			requires(std::is_integral_v<T>)
+		static constexpr bool CanBeSmall(T value)
+		{
+			if constexpr (std::is_signed_v<T>)
+			{
+				return value > std::numeric_limits<int64_t>::min();
+			}
+			else
+			{
+				return value <= static_cast<uint64_t>(std::numeric_limits<int64_t>::max());
+			}
+		}
+
+		///
+		/// @brief 能否用 int64_t 表示法储存。
+		///
+		/// @param value
+		/// @return
+		///
+		static bool CanBeSmall(base::BigInteger const &value)
+		{
+			return value <= std::numeric_limits<int64_t>::max() &&
+				   value >= -std::numeric_limits<int64_t>::max();
+		}
+
+		///
+		/// @brief 设置为 int64_t 表示法。
+		///
+		/// @param num 分子。调用者需要保证已经是最简分数。
+		/// @param den 分母。调用者需要保证为正数。
+		///
+		void SetSmall(int64_t num, int64_t den)
+		{
+			_small_num = num;
+			_small_den = den;
+			_is_big = false;
+		}
+
+		///
+		/// @brief 设置为 int64_t 表示法，会进行化简。
+		///
+		/// @param num 分子。不能是 int64_t 的最小值。
+		/// @param den 分母。不能是 int64_t 的最小值。
+		///
+		void SetSmallAndSimplify(int64_t num, int64_t den)
+		{
+			if (num == 0)
+			{
+				SetSmall(0, 1);
+				return;
+			}
+
+			if (den == 0)
+			{
+				throw std::invalid_argument{CODE_POS_STR + "分母不能为 0."};
+			}
+
+			int64_t gcd_value = base::binary_gcd(num, den);
+			num /= gcd_value;
+			den /= gcd_value;
+
+			if (den < 0)
+			{
+				num = -num;
+				den = -den;
+			}
+
+			SetSmall(num, den);
+		}
+
+		///
+		/// @brief 设置为大整型表示法，会进行化简。化简后如果能用 int64_t 表示，会降级为
+		/// int64_t 表示法。
+		///
+		/// @param num
+		/// @param den
+		///
+		void SetBigAndSimplify(base::BigInteger const &num, base::BigInteger const &den)
+		{
+			if (num == 0)
+			{
+				SetSmall(0, 1);
+				return;
+			}
+
+			if (den == 0)
+			{
+				throw std::invalid_argument{CODE_POS_STR + "分母不能为 0."};
+			}
+
+			_big_num = num;
+			_big_den = den;
+			_is_big = true;
+			Simplify();
+		}
+
+		///
+		/// @brief 尝试用 int64_t 计算 num1 / den1 + num2 / den2 并储存到本对象。
+		///
+		/// @note 分数都是最简的，先用分母的 gcd 约掉公共部分再通分，结果只需要再与这个 gcd
+		/// 求一次 gcd 就能化简，并且中间结果尽可能小，不容易溢出。
+		///
+		/// @return 成功返回 true. 溢出返回 false, 此时本对象不会被修改。
+		///
+		bool TrySetSmallSum(int64_t num1, int64_t den1, int64_t num2, int64_t den2)
+		{
+			int64_t gcd_value = base::binary_gcd(den1, den2);
+			int64_t scaled_num1 = 0;
+			int64_t scaled_num2 = 0;
+			int64_t sum = 0;
+			if (base::mul_overflow(num1, den2 / gcd_value, scaled_num1) ||
+				base::mul_overflow(num2, den1 / gcd_value, scaled_num2) ||
+				base::add_overflow(scaled_num1, scaled_num2, sum) ||
+				sum == std::numeric_limits<int64_t>::min())
+			{
+				return false;
+			}
+
+			if (sum == 0)
+			{
+				SetSmall(0, 1);
+				return true;
+			}
+
+			int64_t gcd_value2 = base::binary_gcd(sum, gcd_value);
+			int64_t den = 0;
+			if (base::mul_overflow(den1 / gcd_value, den2 / gcd_value2, den))
+			{
+				return false;
+			}
+
+			SetSmall(sum / gcd_value2, den);
+			return true;
+		}
+
+		///
+		/// @brief 尝试用 int64_t 计算 (num1 / den1) * (num2 / den2) 并储存到本对象。
+		///
+		/// @note 分数都是最简的，交叉约分后相乘，结果就是最简的。
+		///
+		/// @return 成功返回 true. 溢出返回 false, 此时本对象不会被修改。
+		///
+		bool TrySetSmallProduct(int64_t num1, int64_t den1, int64_t num2, int64_t den2)
+		{
+			if (num1 == 0 || num2 == 0)
+			{
+				SetSmall(0, 1);
+				return true;
+			}
+
+			int64_t gcd1 = base::binary_gcd(num1, den2);
+			int64_t gcd2 = base::binary_gcd(num2, den1);
+			int64_t num = 0;
+			int64_t den = 0;
+			if (base::mul_overflow(num1 / gcd1, num2 / gcd2, num) ||
+				base::mul_overflow(den1 / gcd2, den2 / gcd1, den) ||
+				num == std::numeric_limits<int64_t>::min())
+			{
+				return false;
+			}
+
+			SetSmall(num, den);
+			return true;
+		}
+
+		///
+		/// @brief 与 other 比较。
+		///
+		/// @param other
+		///
+		/// @return 本对象小于 other 返回负数，等于返回 0, 大于返回正数。
+		///
+		int Compare(Fraction const &other) const
+		{
+			if (!_is_big && !other._is_big)
+			{
+				if (_small_den == other._small_den)
+				{
+					return (_small_num > other._small_num) - (_small_num < other._small_num);
+				}
+
+				int64_t left = 0;
+				int64_t right = 0;
+				if (!base::mul_overflow(_small_num, other._small_den, left) &&
+					!base::mul_overflow(other._small_num, _small_den, right))
+				{
+					return (left > right) - (left < right);
+				}
+			}
+
+			base::BigInteger left = Num() * other.Den();
+			base::BigInteger right = other.Num() * Den();
+			return (left > right) - (left < right);
+		}
 
 	public:
 		class Constant;
@@ -41,8 +258,13 @@ namespace base
 			requires(std::is_integral_v<T>)
 		Fraction(T int_num)
 		{
-			_num = int_num;
-			_den = 1;
+			if (CanBeSmall(int_num))
+			{
+				SetSmall(static_cast<int64_t>(int_num), 1);
+				return;
+			}
+
+			SetBigAndSimplify(base::BigInteger{int_num}, 1);
 		}
 
 		///
@@ -56,8 +278,7 @@ namespace base
 		{
 			if (double_value == 0)
 			{
-				_num = 0;
-				_den = 1;
+				// 默认构造就是 0 / 1.
 				return;
 			}
 
@@ -143,8 +364,7 @@ namespace base
 		{
 			if (float_value == 0)
 			{
-				_num = 0;
-				_den = 1;
+				// 默认构造就是 0 / 1.
 				return;
 			}
 
@@ -219,6 +439,27 @@ namespace base
 			}
 		}
 
+		///
+		/// @brief 通过整型分子，分母进行构造。
+		///
+		/// @note 分子分母都能用 int64_t 表示时不需要构造大整型。
+		///
+		/// @param num 分子
+		/// @param den 分母
+		///
+		template <typename TNum, typename TDen>
+			requires(std::is_integral_v<TNum> && std::is_integral_v<TDen>)
+		Fraction(TNum num, TDen den)
+		{
+			if (CanBeSmall(num) && CanBeSmall(den))
+			{
+				SetSmallAndSimplify(static_cast<int64_t>(num), static_cast<int64_t>(den));
+				return;
+			}
+
+			SetBigAndSimplify(base::BigInteger{num}, base::BigInteger{den});
+		}
+
 		///
 		/// @brief 从大整型构造，则分子为 big_int_num, 分母为 1.
 		///
@@ -228,8 +469,7 @@ namespace base
 			requires(std::is_same_v<T, base::BigInteger>)
 		Fraction(T const &big_int_num)
 		{
-			_num = big_int_num;
-			_den = 1;
+			SetBigAndSimplify(big_int_num, 1);
 		}
 
 		///
@@ -240,10 +480,8 @@ namespace base
 		template <typename T>
 			requires(std::is_same_v<T, base::FastInt64Fraction>)
 		Fraction(T const &fast_int64_frac)
+			: Fraction(fast_int64_frac.Num(), fast_int64_frac.Den())
 		{
-			_num = fast_int64_frac.Num();
-			_den = fast_int64_frac.Den();
-			Simplify();
 		}
 
 		///
@@ -253,20 +491,7 @@ namespace base
 		///
 		Fraction(base::BigInteger const &num, base::BigInteger const &den)
 		{
-			_num = num;
-			if (num == 0)
-			{
-				_den = 1;
-				return;
-			}
-
-			if (den == 0)
-			{
-				throw std::invalid_argument{CODE_POS_STR + "分母不能为 0."};
-			}
-
-			_den = den;
-			Simplify();
+			SetBigAndSimplify(num, den);
 		}
 
 		/* #endregion */
@@ -280,7 +505,12 @@ namespace base
 		///
 		base::BigInteger Num() const
 		{
-			return _num;
+			if (!_is_big)
+			{
+				return base::BigInteger{_small_num};
+			}
+
+			return _big_num;
 		}
 
 		///
@@ -290,7 +520,12 @@ namespace base
 		///
 		base::BigInteger Den() const
 		{
-			return _den;
+			if (!_is_big)
+			{
+				return base::BigInteger{_small_den};
+			}
+
+			return _big_den;
 		}
 
 		/* #endregion */
@@ -300,27 +535,50 @@ namespace base
 		///
 		/// @brief 化简。
 		///
+		/// @note 使用 int64_t 表示法时分数总是最简的。大整型表示法化简后如果能用 int64_t
+		/// 表示，会降级为 int64_t 表示法。
+		///
 		void Simplify()
 		{
-			if (_num == 0)
+			if (!_is_big)
+			{
+				return;
+			}
+
+			if (_big_num == 0)
 			{
-				_den = 1;
+				SetSmall(0, 1);
 				return;
 			}
 
 			// 分子分母同时除以最大公约数
-			base::BigInteger gcd_value = base::gcd(_num, _den);
-			_num /= gcd_value;
-			_den /= gcd_value;
+			base::BigInteger gcd_value = base::gcd(_big_num, _big_den);
+			_big_num /= gcd_value;
+			_big_den /= gcd_value;
 
-			if (_den < 0)
+			if (_big_den < 0)
 			{
 				// 如果分母小于 0，分子分母同时取相反数，保证分母为正。
-				_num = -_num;
-				_den = -_den;
+				_big_num = -_big_num;
+				_big_den = -_big_den;
+			}
+
+			if (CanBeSmall(_big_num) && CanBeSmall(_big_den))
+			{
+				SetSmall(static_cast<int64_t>(_big_num), static_cast<int64_t>(_big_den));
 			}
 		}
 
+		///
+		/// @brief 当前是否使用大整型表示法。
+		///
+		/// @return
+		///
+		bool IsBig() const
+		{
+			return _is_big;
+		}
+
 		///
 		/// @brief 倒数
 		///
@@ -328,7 +586,27 @@ namespace base
 		///
 		Fraction Reciprocal() const
 		{
-			base::Fraction ret{_den, _num};
+			if (!_is_big)
+			{
+				if (_small_num == 0)
+				{
+					throw std::invalid_argument{CODE_POS_STR + "分母不能为 0."};
+				}
+
+				base::Fraction ret;
+				if (_small_num < 0)
+				{
+					ret.SetSmall(-_small_den, -_small_num);
+				}
+				else
+				{
+					ret.SetSmall(_small_den, _small_num);
+				}
+
+				return ret;
+			}
+
+			base::Fraction ret{_big_den, _big_num};
 			return ret;
 		}
 
@@ -400,7 +678,12 @@ namespace base
 		///
 		base::BigInteger Div() const
 		{
-			return _num / _den;
+			if (!_is_big)
+			{
+				return base::BigInteger{_small_num / _small_den};
+			}
+
+			return _big_num / _big_den;
 		}
 
 		///
@@ -410,7 +693,12 @@ namespace base
 		///
 		base::BigInteger Mod() const
 		{
-			return _num % _den;
+			if (!_is_big)
+			{
+				return base::BigInteger{_small_num % _small_den};
+			}
+
+			return _big_num % _big_den;
 		}
 
 		///
@@ -425,64 +713,62 @@ namespace base
 				throw std::invalid_argument{CODE_POS_STR + "分辨率不能 <= 0."};
 			}
 
-			// 分辨率调整算法默认分母为正数，所以需要先规范化，如果分数是负数的话，
-			// 需要将负号转移到分子上。
-			if (_den < 0)
-			{
-				_num = -_num;
-				_den = -_den;
-			}
+			// 分辨率调整算法默认分母为正数。分数在储存时已经规范化，分母总是正数。
+			base::BigInteger num = Num();
+			base::BigInteger den = Den();
+			base::BigInteger resolution_num = resolution.Num();
+			base::BigInteger resolution_den = resolution.Den();
 
-			base::Fraction resolution_copy = resolution;
-			if (resolution_copy._den < 0)
+			if (den >= resolution_den)
 			{
-				resolution_copy._num = -resolution_copy._num;
-				resolution_copy._den = -resolution_copy._den;
-			}
-
-			if (_den >= resolution_copy._den)
-			{
-				// 本分数的分母比 resolution_copy 的分母大，说明本分数的分辨率大于
-				// resolution_copy.
+				// 本分数的分母比 resolution 的分母大，说明本分数的分辨率大于
+				// resolution.
 				//
 				// 首先需要减小本分数的分母，将分辨率降下来。分子分母同时除以一个系数进行截断，
 				// 从而降低分辨率。
-				base::BigInteger multiple = _den / resolution_copy._den;
+				base::BigInteger multiple = den / resolution_den;
 
-				// 首先将分辨率降低到 1 / resolution_copy._den.
-				_num /= multiple;
-				_den /= multiple;
+				// 首先将分辨率降低到 1 / resolution_den.
+				num /= multiple;
+				den /= multiple;
 
-				// 如果 resolution_copy._num > 1, 则还不够，刚才的分辨率降低到
-				// 1 / resolution_copy._den 了，还要继续降低。
-				_num = _num / resolution_copy._num * resolution_copy._num;
+				// 如果 resolution_num > 1, 则还不够，刚才的分辨率降低到
+				// 1 / resolution_den 了，还要继续降低。
+				num = num / resolution_num * resolution_num;
 			}
 			else
 			{
-				// 本分数的分母比 resolution_copy 的分母小。但这不能说明本分数的分辨率小于
-				// resolution_copy, 因为 resolution_copy 的分子可能较大。
+				// 本分数的分母比 resolution 的分母小。但这不能说明本分数的分辨率小于
+				// resolution, 因为 resolution 的分子可能较大。
 				//
-				// 将 resolution_copy 的分子分母同时除以一个系数，将 resolution_copy
-				// 的分母调整到与本分数的分母相等，然后看一下调整后的 resolution_copy
+				// 将 resolution 的分子分母同时除以一个系数，将 resolution
+				// 的分母调整到与本分数的分母相等，然后看一下调整后的 resolution
 				// 的分子，如果不等于 0, 即没有被截断成 0, 说明原本的分子确实较大，
-				// 大到足以放大 resolution_copy 的大分母所导致的小步长，导致步长很大，分辨率低。
-				// 这种情况下本分数的分辨率才是高于 resolution_copy, 才需要降低分辨率。
-				base::BigInteger multiple = resolution_copy._den / _den;
-				base::BigInteger div = resolution_copy._num / multiple;
+				// 大到足以放大 resolution 的大分母所导致的小步长，导致步长很大，分辨率低。
+				// 这种情况下本分数的分辨率才是高于 resolution, 才需要降低分辨率。
+				base::BigInteger multiple = resolution_den / den;
+				base::BigInteger div = resolution_num / multiple;
 				if (div != 0)
 				{
-					_num = _num / div * div;
+					num = num / div * div;
 				}
 			}
 
-			Simplify();
+			SetBigAndSimplify(num, den);
 		}
 
 		/* #endregion */
 
 		Fraction operator-() const
 		{
-			Fraction ret{-_num, _den};
+			if (!_is_big)
+			{
+				base::Fraction ret;
+				ret.SetSmall(-_small_num, _small_den);
+				return ret;
+			}
+
+			Fraction ret{-_big_num, _big_den};
 			return ret;
 		}
 
@@ -490,12 +776,24 @@ namespace base
 
 		Fraction operator+(Fraction const &value) const
 		{
+			if (!_is_big && !value._is_big)
+			{
+				base::Fraction ret;
+				if (ret.TrySetSmallSum(_small_num, _small_den, value._small_num, value._small_den))
+				{
+					return ret;
+				}
+			}
+
+			base::BigInteger den1 = Den();
+			base::BigInteger den2 = value.Den();
+
 			// 通分后的分母为本对象的分母和 value 的分母的最小公倍数
-			base::BigInteger scaled_den = base::lcm(_den, value.Den());
+			base::BigInteger scaled_den = base::lcm(den1, den2);
 
 			// 通分后的分子为本对象的分子乘上分母所乘的倍数
-			base::BigInteger scaled_num1 = _num * (scaled_den / _den);
-			base::BigInteger scaled_num2 = value.Num() * (scaled_den / value.Den());
+			base::BigInteger scaled_num1 = Num() * (scaled_den / den1);
+			base::BigInteger scaled_num2 = value.Num() * (scaled_den / den2);
 
 			Fraction ret{
 				scaled_num1 + scaled_num2,
@@ -513,9 +811,18 @@ namespace base
 
 		Fraction operator*(Fraction const &value) const
 		{
+			if (!_is_big && !value._is_big)
+			{
+				base::Fraction ret;
+				if (ret.TrySetSmallProduct(_small_num, _small_den, value._small_num, value._small_den))
+				{
+					return ret;
+				}
+			}
+
 			base::Fraction ret{
-				_num * value.Num(),
-				_den * value.Den(),
+				Num() * value.Num(),
+				Den() * value.Den(),
 			};
 
 			return ret;
@@ -564,7 +871,12 @@ namespace base
 		///
 		virtual std::string ToString() const override
 		{
-			return base::to_string(_num) + " / " + base::to_string(_den);
+			if (!_is_big)
+			{
+				return std::to_string(_small_num) + " / " + std::to_string(_small_den);
+			}
+
+			return base::to_string(_big_num) + " / " + base::to_string(_big_den);
 		}
 
 		/* #region 强制转换运算符 */
@@ -576,6 +888,11 @@ namespace base
 
 		explicit operator int64_t() const
 		{
+			if (!_is_big)
+			{
+				return _small_num / _small_den;
+			}
+
 			return static_cast<int64_t>(Div());
 		}
 
@@ -616,6 +933,17 @@ namespace base
 
 		explicit operator double() const
 		{
+			if (!_is_big)
+			{
+				// 分别取出整数部分和小数部分再转换，避免分子分母很大时转为 double 后相除
+				// 丢失精度。
+				double int_part = static_cast<double>(_small_num / _small_den);
+				double fraction_part = static_cast<double>(_small_num % _small_den) /
+									   static_cast<double>(_small_den);
+
+				return int_part + fraction_part;
+			}
+
 			base::Fraction copy{*this};
 			base::BigInteger div = copy.Div();
 
@@ -632,6 +960,15 @@ namespace base
 
 		explicit operator float() const
 		{
+			if (!_is_big)
+			{
+				float int_part = static_cast<float>(_small_num / _small_den);
+				float fraction_part = static_cast<float>(_small_num % _small_den) /
+									  static_cast<float>(_small_den);
+
+				return int_part + fraction_part;
+			}
+
 			base::Fraction copy{*this};
 			base::BigInteger div = copy.Div();
 
@@ -648,6 +985,11 @@ namespace base
 
 		explicit operator base::FastInt64Fraction() const
 		{
+			if (!_is_big)
+			{
+				return base::FastInt64Fraction{_small_num, _small_den};
+			}
+
 			base::Fraction copy{*this};
 
 			base::Fraction resolution{
@@ -658,8 +1000,8 @@ namespace base
 			copy.ReduceResolution(resolution);
 
 			return base::FastInt64Fraction{
-				static_cast<int64_t>(_num),
-				static_cast<int64_t>(_den),
+				static_cast<int64_t>(copy.Num()),
+				static_cast<int64_t>(copy.Den()),
 			};
 		}
 
@@ -676,7 +1018,13 @@ namespace base
 		///
 		bool operator==(Fraction const &other) const
 		{
-			return Num() * other.Den() == other.Num() * Den();
+			if (!_is_big && !other._is_big)
+			{
+				// 都是最简分数且分母为正，分子分母分别相等才相等。
+				return _small_num == other._small_num && _small_den == other._small_den;
+			}
+
+			return Compare(other) == 0;
 		}
 
 		///
@@ -688,7 +1036,7 @@ namespace base
 		///
 		bool operator>(Fraction const &other) const
 		{
-			return Num() * other.Den() > other.Num() * Den();
+			return Compare(other) > 0;
 		}
 
 		///
@@ -700,7 +1048,7 @@ namespace base
 		///
 		bool operator<(Fraction const &other) const
 		{
-			return Num() * other.Den() < other.Num() * Den();
+			return Compare(other) < 0;
 		}
 
 		///
@@ -712,7 +1060,7 @@ namespace base
 		///
 		bool operator>=(Fraction const &other) const
 		{
-			return Num() * other.Den() >= other.Num() * Den();
+			return Compare(other) >= 0;
 		}
 
 		///
@@ -724,7 +1072,7 @@ namespace base
 		///
 		bool operator<=(Fraction const &other) const
 		{
-			return Num() * other.Den() <= other.Num() * Den();
+			return Compare(other) <= 0;
 		}
 
 		/* #endregion */
@@ -1,4 +1,7 @@
 #include "HysteresisElement.h"
+#include "base/string/define.h"
+#include <cstdint>
+#include <stdexcept>
 
 base::HysteresisElement::HysteresisElement(HysteresisElement_RisingThreshold const &rising_threshold,
 										   HysteresisElement_FallenThreshold const &fallen_threshold)
@@ -31,6 +34,42 @@ bool base::HysteresisElement::Input(double x)
 	return _current_output;
 }
 
+void base::HysteresisElement::Input(base::ReadOnlyArraySpan<double> const &x, base::ArraySpan<bool> const &y)
+{
+	if (x.Count() != y.Count())
+	{
+		throw std::invalid_argument{CODE_POS_STR + "x 和 y 的元素个数必须相等。"};
+	}
+
+	if (x.Count() == 0)
+	{
+		return;
+	}
+
+	double const *input = x.Buffer();
+	bool *output = y.Buffer();
+	bool current_output = _current_output;
+	bool last_output = _current_output;
+	for (int64_t i = 0; i < x.Count(); i++)
+	{
+		last_output = current_output;
+		if (input[i] >= _rising_threshold)
+		{
+			current_output = true;
+		}
+		else if (input[i] <= _fallen_threshold)
+		{
+			current_output = false;
+		}
+
+		output[i] = current_output;
+	}
+
+	_x = input[x.Count() - 1];
+	_last_output = last_output;
+	_current_output = current_output;
+}
+
 base::HysteresisElement_OutputChange base::HysteresisElement::OutputChange() const
 {
 	if (!_last_output && _current_output)
@@ -1,4 +1,6 @@
 #pragma once
+#include "base/container/ArraySpan.h"
+#include "base/container/ReadOnlyArraySpan.h"
 
 namespace base
 {
@@ -118,6 +120,12 @@ namespace base
 		/// @return
 		bool Input(double x);
 
+		/// @brief 依次输入 x 中的每个值，并将每个值引起的输出写入 y.
+		/// @note 与逐个调用 Input(double) 的结果相同。
+		/// @param x 输入。
+		/// @param y 输出。元素个数必须等于 x 的元素个数。
+		void Input(base::ReadOnlyArraySpan<double> const &x, base::ArraySpan<bool> const &y);
+
 		/// @brief 当前的输入值。
 		/// @return
 		double CurrentInput()
@@ -0,0 +1,110 @@
+#include "HysteresisElementBank.h"
+#include "base/string/define.h"
+#include <stdexcept>
+
+void base::HysteresisElementBank::CheckIndex(int64_t index) const
+{
+	if (index < 0 || index >= _channel_count)
+	{
+		throw std::out_of_range{CODE_POS_STR + "index 超出范围。"};
+	}
+}
+
+base::HysteresisElementBank::HysteresisElementBank(int64_t channel_count,
+												   base::HysteresisElement_RisingThreshold const &rising_threshold,
+												   base::HysteresisElement_FallenThreshold const &fallen_threshold)
+{
+	if (channel_count < 0)
+	{
+		throw std::invalid_argument{CODE_POS_STR + "channel_count 不能 < 0."};
+	}
+
+	_channel_count = channel_count;
+	_rising_threshold.resize(channel_count, rising_threshold.Value());
+	_fallen_threshold.resize(channel_count, fallen_threshold.Value());
+	_current_output.resize(channel_count, 0);
+	_last_output.resize(channel_count, 0);
+}
+
+void base::HysteresisElementBank::SetChannel(int64_t index,
+											 base::HysteresisElement_RisingThreshold const &rising_threshold,
+											 base::HysteresisElement_FallenThreshold const &fallen_threshold)
+{
+	CheckIndex(index);
+	_rising_threshold[index] = rising_threshold.Value();
+	_fallen_threshold[index] = fallen_threshold.Value();
+}
+
+void base::HysteresisElementBank::Input(base::ReadOnlyArraySpan<double> const &x)
+{
+	if (x.Count() != _channel_count)
+	{
+		throw std::invalid_argument{CODE_POS_STR + "x 的元素个数必须等于通道数。"};
+	}
+
+	double const *input = x.Buffer();
+	double const *rising_threshold = _rising_threshold.data();
+	double const *fallen_threshold = _fallen_threshold.data();
+	uint8_t *current_output = _current_output.data();
+	uint8_t *last_output = _last_output.data();
+	for (int64_t i = 0; i < _channel_count; i++)
+	{
+		// 与 base::HysteresisElement::Input 的判断顺序相同：先判断上升阈值。
+		uint8_t output = current_output[i];
+		last_output[i] = output;
+		output = input[i] <= fallen_threshold[i] ? 0 : output;
+		output = input[i] >= rising_threshold[i] ? 1 : output;
+		current_output[i] = output;
+	}
+}
+
+void base::HysteresisElementBank::Input(base::ReadOnlyArraySpan<double> const &frames, base::ArraySpan<bool> const &outputs)
+{
+	if (frames.Count() != outputs.Count())
+	{
+		throw std::invalid_argument{CODE_POS_STR + "frames 和 outputs 的元素个数必须相等。"};
+	}
+
+	if (_channel_count == 0)
+	{
+		return;
+	}
+
+	if (frames.Count() % _channel_count != 0)
+	{
+		throw std::invalid_argument{CODE_POS_STR + "frames 的元素个数必须是通道数的整数倍。"};
+	}
+
+	for (int64_t offset = 0; offset < frames.Count(); offset += _channel_count)
+	{
+		Input(base::ReadOnlyArraySpan<double>{frames.Buffer() + offset, _channel_count});
+
+		bool *output = outputs.Buffer() + offset;
+		for (int64_t i = 0; i < _channel_count; i++)
+		{
+			output[i] = _current_output[i] != 0;
+		}
+	}
+}
+
+bool base::HysteresisElementBank::CurrentOutput(int64_t index) const
+{
+	CheckIndex(index);
+	return _current_output[index] != 0;
+}
+
+base::HysteresisElement_OutputChange base::HysteresisElementBank::OutputChange(int64_t index) const
+{
+	CheckIndex(index);
+	if (!_last_output[index] && _current_output[index])
+	{
+		return base::HysteresisElement_OutputChange::Rise;
+	}
+
+	if (_last_output[index] && !_current_output[index])
+	{
+		return base::HysteresisElement_OutputChange::Fall;
+	}
+
+	return base::HysteresisElement_OutputChange::None;
+}
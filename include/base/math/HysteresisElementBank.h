@@ -0,0 +1,102 @@
+#pragma once
+#include "base/container/ArraySpan.h"
+#include "base/container/ReadOnlyArraySpan.h"
+#include "base/math/HysteresisElement.h"
+#include <cstdint>
+#include <vector>
+
+namespace base
+{
+	///
+	/// @brief 多通道迟滞特性环节。
+	///
+	/// @note 各通道的阈值和状态分别储存在连续的数组中，一次输入对所有通道迭代一遍。
+	/// 输出用条件选择而不是分支计算，编译器可以向量化。
+	///
+	/// @note 每个通道的输出与 base::HysteresisElement 完全相同。
+	///
+	class HysteresisElementBank
+	{
+	private:
+		int64_t _channel_count = 0;
+		std::vector<double> _rising_threshold;
+		std::vector<double> _fallen_threshold;
+
+		// 用 uint8_t 而不是 bool 储存，避免 std::vector<bool> 的位压缩。
+		std::vector<uint8_t> _current_output;
+		std::vector<uint8_t> _last_output;
+
+		void CheckIndex(int64_t index) const;
+
+	public:
+		HysteresisElementBank() = default;
+
+		///
+		/// @brief 构造多通道迟滞特性环节，所有通道使用相同的阈值。
+		///
+		/// @param channel_count 通道数。
+		/// @param rising_threshold 上升阈值。
+		/// @param fallen_threshold 下降阈值。
+		///
+		HysteresisElementBank(int64_t channel_count,
+							  base::HysteresisElement_RisingThreshold const &rising_threshold,
+							  base::HysteresisElement_FallenThreshold const &fallen_threshold);
+
+		///
+		/// @brief 通道数。
+		///
+		/// @return
+		///
+		int64_t ChannelCount() const
+		{
+			return _channel_count;
+		}
+
+		///
+		/// @brief 更改一个通道的阈值。
+		///
+		/// @note 不会立刻改变输出，下一次输入时生效。
+		///
+		/// @param index
+		/// @param rising_threshold
+		/// @param fallen_threshold
+		///
+		void SetChannel(int64_t index,
+						base::HysteresisElement_RisingThreshold const &rising_threshold,
+						base::HysteresisElement_FallenThreshold const &fallen_threshold);
+
+		///
+		/// @brief 向所有通道各输入一个值。
+		///
+		/// @param x 每个通道的输入。元素个数必须等于通道数。
+		///
+		void Input(base::ReadOnlyArraySpan<double> const &x);
+
+		///
+		/// @brief 输入多个采样帧。
+		///
+		/// @note 每帧包含每个通道各一个值，即 frames 是按帧交错排列的多通道数据。
+		///
+		/// @param frames 输入。元素个数必须是通道数的整数倍。
+		/// @param outputs 每帧输入后所有通道的输出，排列方式与 frames 相同。
+		///
+		void Input(base::ReadOnlyArraySpan<double> const &frames, base::ArraySpan<bool> const &outputs);
+
+		///
+		/// @brief 一个通道当前的输出。
+		///
+		/// @param index
+		/// @return
+		///
+		bool CurrentOutput(int64_t index) const;
+
+		///
+		/// @brief 一个通道最近一次输入后输出的变化情况。
+		///
+		/// @param index
+		/// @return
+		///
+		base::HysteresisElement_OutputChange OutputChange(int64_t index) const;
+	};
+
+} // namespace base
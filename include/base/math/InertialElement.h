@@ -1,7 +1,12 @@
 #pragma once
+#include "base/container/ArraySpan.h"
+#include "base/container/ReadOnlyArraySpan.h"
 #include "base/math/FastInt64Fraction.h"
 #include "base/math/Fraction.h"
+#include "base/string/define.h"
 #include "Fraction.h"
+#include <cstdint>
+#include <stdexcept>
 
 namespace base
 {
@@ -46,6 +51,36 @@ namespace base
 			return _current_output;
 		}
 
+		///
+		/// @brief 向惯性环节依次输入 x 中的每个值，并将每个值产生的输出写入 y.
+		///
+		/// @note 与逐个调用 Input(base::FastInt64Fraction) 的结果相同。
+		/// @note x 和 y 可以是同一段内存。
+		///
+		/// @param x 输入。
+		/// @param y 输出。元素个数必须等于 x 的元素个数。
+		///
+		void Input(base::ReadOnlyArraySpan<base::FastInt64Fraction> const &x,
+				   base::ArraySpan<base::FastInt64Fraction> const &y)
+		{
+			if (x.Count() != y.Count())
+			{
+				throw std::invalid_argument{CODE_POS_STR + "x 和 y 的元素个数必须相等。"};
+			}
+
+			base::FastInt64Fraction const *input = x.Buffer();
+			base::FastInt64Fraction *output = y.Buffer();
+			base::FastInt64Fraction current_output = _current_output;
+			for (int64_t i = 0; i < x.Count(); i++)
+			{
+				current_output *= _ky;
+				current_output += _kx * input[i];
+				output[i] = current_output;
+			}
+
+			_current_output = current_output;
+		}
+
 		///
 		/// @brief 当前的输出。
 		///
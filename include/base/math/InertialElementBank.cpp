@@ -0,0 +1 @@
+#include "InertialElementBank.h" // IWYU pragma: keep
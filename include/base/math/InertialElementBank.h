@@ -0,0 +1,195 @@
+#pragma once
+#include "base/container/ArraySpan.h"
+#include "base/container/ReadOnlyArraySpan.h"
+#include "base/math/FastInt64Fraction.h"
+#include "base/math/InertialElement.h"
+#include "base/string/define.h"
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace base
+{
+	///
+	/// @brief 多通道一阶惯性环节。
+	///
+	/// @note 各通道的系数和输出分别储存在连续的数组中，一次输入对所有通道迭代一遍，
+	/// 编译器可以向量化。
+	///
+	/// @note 迭代公式与 base::InertialElement 相同，系数也由 base::InertialElement
+	/// 计算，只是用浮点数代替 base::FastInt64Fraction 进行迭代，所以结果与
+	/// base::InertialElement 之间只有浮点舍入误差。
+	///
+	template <typename T>
+		requires(std::is_floating_point_v<T>)
+	class InertialElementBank
+	{
+	private:
+		int64_t _channel_count = 0;
+		std::vector<T> _kx;
+		std::vector<T> _ky;
+		std::vector<T> _current_output;
+
+		void CheckIndex(int64_t index) const
+		{
+			if (index < 0 || index >= _channel_count)
+			{
+				throw std::out_of_range{CODE_POS_STR + "index 超出范围。"};
+			}
+		}
+
+	public:
+		InertialElementBank() = default;
+
+		///
+		/// @brief 多通道一阶惯性环节。
+		///
+		/// @note 所有通道的系数都为 0, 需要通过 SetChannel 设置。
+		///
+		/// @param channel_count 通道数。
+		///
+		InertialElementBank(int64_t channel_count)
+		{
+			if (channel_count < 0)
+			{
+				throw std::invalid_argument{CODE_POS_STR + "channel_count 不能 < 0."};
+			}
+
+			_channel_count = channel_count;
+			_kx.resize(channel_count);
+			_ky.resize(channel_count);
+			_current_output.resize(channel_count);
+		}
+
+		///
+		/// @brief 通道数。
+		///
+		/// @return
+		///
+		int64_t ChannelCount() const
+		{
+			return _channel_count;
+		}
+
+		///
+		/// @brief 设置一个通道的参数。
+		///
+		/// @param index 通道索引。
+		/// @param inertial_time_constant 惯性时间常数。
+		/// @param sample_interval 采样周期。
+		///
+		void SetChannel(int64_t index,
+						base::FastInt64Fraction inertial_time_constant,
+						base::FastInt64Fraction sample_interval)
+		{
+			SetChannel(index, base::InertialElement{inertial_time_constant, sample_interval});
+		}
+
+		///
+		/// @brief 使用 element 的系数和当前输出设置一个通道。
+		///
+		/// @param index 通道索引。
+		/// @param element
+		///
+		void SetChannel(int64_t index, base::InertialElement const &element)
+		{
+			CheckIndex(index);
+			_kx[index] = static_cast<T>(static_cast<double>(element.Kx()));
+			_ky[index] = static_cast<T>(static_cast<double>(element.Ky()));
+			_current_output[index] = static_cast<T>(static_cast<double>(element.CurrentOutput()));
+		}
+
+		///
+		/// @brief 直接更改一个通道的当前输出值。
+		///
+		/// @param index
+		/// @param value
+		///
+		void SetCurrentOutput(int64_t index, T value)
+		{
+			CheckIndex(index);
+			_current_output[index] = value;
+		}
+
+		///
+		/// @brief 向所有通道各输入一个值。
+		///
+		/// @param x 每个通道的输入。元素个数必须等于通道数。
+		///
+		void Input(base::ReadOnlyArraySpan<T> const &x)
+		{
+			if (x.Count() != _channel_count)
+			{
+				throw std::invalid_argument{CODE_POS_STR + "x 的元素个数必须等于通道数。"};
+			}
+
+			T const *input = x.Buffer();
+			T const *kx = _kx.data();
+			T const *ky = _ky.data();
+			T *current_output = _current_output.data();
+			for (int64_t i = 0; i < _channel_count; i++)
+			{
+				current_output[i] = current_output[i] * ky[i] + kx[i] * input[i];
+			}
+		}
+
+		///
+		/// @brief 输入多个采样帧。
+		///
+		/// @note 每帧包含每个通道各一个值，即 frames 是按帧交错排列的多通道数据，
+		/// 与多通道 ADC 的扫描顺序相同。
+		/// @note frames 和 outputs 可以是同一段内存。
+		///
+		/// @param frames 输入。元素个数必须是通道数的整数倍。
+		/// @param outputs 每帧输入后所有通道的输出，排列方式与 frames 相同。
+		///
+		void Input(base::ReadOnlyArraySpan<T> const &frames, base::ArraySpan<T> const &outputs)
+		{
+			if (frames.Count() != outputs.Count())
+			{
+				throw std::invalid_argument{CODE_POS_STR + "frames 和 outputs 的元素个数必须相等。"};
+			}
+
+			if (_channel_count == 0)
+			{
+				return;
+			}
+
+			if (frames.Count() % _channel_count != 0)
+			{
+				throw std::invalid_argument{CODE_POS_STR + "frames 的元素个数必须是通道数的整数倍。"};
+			}
+
+			for (int64_t offset = 0; offset < frames.Count(); offset += _channel_count)
+			{
+				Input(base::ReadOnlyArraySpan<T>{frames.Buffer() + offset, _channel_count});
+				std::copy(_current_output.begin(), _current_output.end(), outputs.Buffer() + offset);
+			}
+		}
+
+		///
+		/// @brief 所有通道当前的输出。
+		///
+		/// @return
+		///
+		base::ReadOnlyArraySpan<T> CurrentOutput() const
+		{
+			return base::ReadOnlyArraySpan<T>{_current_output.data(), _channel_count};
+		}
+
+		///
+		/// @brief 一个通道当前的输出。
+		///
+		/// @param index
+		/// @return
+		///
+		T CurrentOutput(int64_t index) const
+		{
+			CheckIndex(index);
+			return _current_output[index];
+		}
+	};
+
+} // namespace base
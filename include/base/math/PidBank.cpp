@@ -0,0 +1 @@
+#include "PidBank.h" // IWYU pragma: keep
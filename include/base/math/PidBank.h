@@ -0,0 +1,242 @@
+#pragma once
+#include "base/container/ArraySpan.h"
+#include "base/container/ReadOnlyArraySpan.h"
+#include "base/math/PID.h"
+#include "base/string/define.h"
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace base
+{
+	///
+	/// @brief PID 控制器组。
+	///
+	/// @note 同时运行多个通道的 PID 控制器。各通道的系数、历史输入、输出限制分别储存在
+	/// 连续的数组中（结构体数组转为数组结构体），一次 Input 对所有通道迭代一遍，
+	/// 循环体内没有分支和依赖，编译器可以向量化。
+	///
+	/// @note 迭代公式与 base::PID 相同，只是用浮点数代替 base::FastInt64Fraction.
+	///
+	template <typename T>
+		requires(std::is_floating_point_v<T>)
+	class PidBank
+	{
+	private:
+		int64_t _channel_count = 0;
+		std::vector<T> _output;
+		std::vector<T> _kp;
+		std::vector<T> _ki;
+		std::vector<T> _kd;
+
+		// 历史输入。_x0 是最新一次输入，_x1 是上一次，_x2 是上上次。对应 base::PID 的 _x[3].
+		std::vector<T> _x0;
+		std::vector<T> _x1;
+		std::vector<T> _x2;
+
+		std::vector<T> _max_output;
+		std::vector<T> _min_output;
+
+		void CheckIndex(int64_t index) const
+		{
+			if (index < 0 || index >= _channel_count)
+			{
+				throw std::out_of_range{CODE_POS_STR + "index 超出范围。"};
+			}
+		}
+
+	public:
+		///
+		/// @brief 无参构造。构造出来的控制器组没有通道。
+		///
+		PidBank() = default;
+
+		///
+		/// @brief 构造控制器组。
+		///
+		/// @note 所有通道的系数和输出限制都为 0, 需要通过 SetChannel 设置。
+		///
+		/// @param channel_count 通道数。
+		///
+		PidBank(int64_t channel_count)
+		{
+			if (channel_count < 0)
+			{
+				throw std::invalid_argument{CODE_POS_STR + "channel_count 不能 < 0."};
+			}
+
+			_channel_count = channel_count;
+			_output.resize(channel_count);
+			_kp.resize(channel_count);
+			_ki.resize(channel_count);
+			_kd.resize(channel_count);
+			_x0.resize(channel_count);
+			_x1.resize(channel_count);
+			_x2.resize(channel_count);
+			_max_output.resize(channel_count);
+			_min_output.resize(channel_count);
+		}
+
+		///
+		/// @brief 通道数。
+		///
+		/// @return
+		///
+		int64_t ChannelCount() const
+		{
+			return _channel_count;
+		}
+
+		///
+		/// @brief 设置一个通道的参数，并清除该通道的历史输入和输出。
+		///
+		/// @param index 通道索引。
+		/// @param kp 比例系数。
+		/// @param ki 积分系数。
+		/// @param kd 微分系数。
+		/// @param max_output 允许的最大输出。
+		/// @param min_output 允许的最小输出。
+		///
+		void SetChannel(int64_t index, T kp, T ki, T kd, T max_output, T min_output)
+		{
+			CheckIndex(index);
+
+			if (max_output < min_output)
+			{
+				// 允许 max_output == min_output, 因为有些时候需要将输出钳制在某一个值上。
+				throw std::invalid_argument{CODE_POS_STR + "max_output 不能 < min_output."};
+			}
+
+			_kp[index] = kp;
+			_ki[index] = ki;
+			_kd[index] = kd;
+			_max_output[index] = max_output;
+			_min_output[index] = min_output;
+			ResetChannel(index);
+		}
+
+		///
+		/// @brief 用 base::PID 的系数和输出限制设置一个通道，并清除该通道的历史输入和输出。
+		///
+		/// @param index 通道索引。
+		/// @param pid
+		///
+		void SetChannel(int64_t index, base::PID const &pid)
+		{
+			SetChannel(index,
+					   static_cast<T>(static_cast<double>(pid.Kp())),
+					   static_cast<T>(static_cast<double>(pid.Ki())),
+					   static_cast<T>(static_cast<double>(pid.Kd())),
+					   static_cast<T>(static_cast<double>(pid.MaxOutput())),
+					   static_cast<T>(static_cast<double>(pid.MinOutput())));
+		}
+
+		///
+		/// @brief 清除一个通道的历史输入和输出。
+		///
+		/// @param index
+		///
+		void ResetChannel(int64_t index)
+		{
+			CheckIndex(index);
+			_output[index] = 0;
+			_x0[index] = 0;
+			_x1[index] = 0;
+			_x2[index] = 0;
+		}
+
+		///
+		/// @brief 设置一个通道的输出限制。
+		///
+		/// @note 下一次输入数据进行迭代时生效。
+		/// @note 本方法不会立刻对当前输出进行限制。
+		///
+		/// @param index
+		/// @param max_output
+		/// @param min_output
+		///
+		void SetOutputLimit(int64_t index, T max_output, T min_output)
+		{
+			CheckIndex(index);
+
+			if (max_output < min_output)
+			{
+				throw std::invalid_argument{CODE_POS_STR + "max_output 不能 < min_output."};
+			}
+
+			_max_output[index] = max_output;
+			_min_output[index] = min_output;
+		}
+
+		///
+		/// @brief 向所有通道各输入一个数，迭代计算后更新输出。
+		///
+		/// @param x 每个通道的输入。元素个数必须等于通道数。
+		///
+		void Input(base::ReadOnlyArraySpan<T> const &x)
+		{
+			if (x.Count() != _channel_count)
+			{
+				throw std::invalid_argument{CODE_POS_STR + "x 的元素个数必须等于通道数。"};
+			}
+
+			// 取出裸指针，让编译器知道循环中没有函数调用和越界检查。
+			T const *input = x.Buffer();
+			T *output = _output.data();
+			T const *kp = _kp.data();
+			T const *ki = _ki.data();
+			T const *kd = _kd.data();
+			T *x0 = _x0.data();
+			T *x1 = _x1.data();
+			T *x2 = _x2.data();
+			T const *max_output = _max_output.data();
+			T const *min_output = _min_output.data();
+
+			for (int64_t i = 0; i < _channel_count; i++)
+			{
+				T new_x0 = input[i];
+				T new_x1 = x0[i];
+				T new_x2 = x1[i];
+
+				x2[i] = new_x2;
+				x1[i] = new_x1;
+				x0[i] = new_x0;
+
+				// 累加顺序与 base::PID 相同。
+				T value = output[i];
+				value += kp[i] * (new_x0 - new_x1);
+				value += ki[i] * new_x0;
+				value += kd[i] * (new_x0 - 2 * new_x1 + new_x2);
+
+				// 用条件表达式限幅，编译器可以生成 min, max 指令而不是分支。
+				value = value < min_output[i] ? min_output[i] : value;
+				value = value > max_output[i] ? max_output[i] : value;
+				output[i] = value;
+			}
+		}
+
+		///
+		/// @brief 所有通道当前的输出。
+		///
+		/// @return
+		///
+		base::ReadOnlyArraySpan<T> Output() const
+		{
+			return base::ReadOnlyArraySpan<T>{_output.data(), _channel_count};
+		}
+
+		///
+		/// @brief 一个通道当前的输出。
+		///
+		/// @param index
+		/// @return
+		///
+		T Output(int64_t index) const
+		{
+			CheckIndex(index);
+			return _output[index];
+		}
+	};
+
+} // namespace base
@@ -0,0 +1,132 @@
+#include "RealFft.h" // IWYU pragma: keep
+#include "base/string/define.h"
+#include <algorithm>
+#include <numbers>
+#include <stdexcept>
+
+namespace
+{
+	int64_t CheckSize(int64_t size)
+	{
+		if (size < 2 || size % 2 != 0)
+		{
+			throw std::invalid_argument{CODE_POS_STR + "size 必须是 >= 2 的偶数。"};
+		}
+
+		return size;
+	}
+
+} // namespace
+
+base::RealFft::RealFft(int64_t size)
+	: _size(CheckSize(size)),
+	  _half_fft(size / 2)
+{
+	int64_t half = _size / 2;
+	_twiddles.resize(half + 1);
+	for (int64_t k = 0; k <= half; k++)
+	{
+		long double angle = -2 * std::numbers::pi_v<long double> * k / _size;
+		_twiddles[k] = std::complex<double>{static_cast<double>(std::cos(angle)),
+											static_cast<double>(std::sin(angle))};
+	}
+
+	_work.resize(half);
+}
+
+void base::RealFft::Forward(base::ReadOnlyArraySpan<double> const &input,
+							base::ArraySpan<std::complex<double>> const &output)
+{
+	if (input.Count() != _size)
+	{
+		throw std::invalid_argument{CODE_POS_STR + "input 的元素个数必须等于变换长度。"};
+	}
+
+	if (output.Count() != SpectrumSize())
+	{
+		throw std::invalid_argument{CODE_POS_STR + "output 的元素个数必须等于 n / 2 + 1."};
+	}
+
+	int64_t half = _size / 2;
+
+	// z[k] = x[2k] + i * x[2k + 1], 内存布局与 double 数组相同，直接复制。
+	std::copy(input.Buffer(), input.Buffer() + _size, reinterpret_cast<double *>(_work.data()));
+
+	base::ArraySpan<std::complex<double>> work{_work.data(), half};
+	_half_fft.Forward(work, work);
+
+	// Z = E + i * O, E 和 O 分别是偶数点和奇数点的频谱。
+	// 		E[k] = (Z[k] + conj(Z[h - k])) / 2
+	// 		O[k] = (Z[k] - conj(Z[h - k])) / (2i)
+	// 		X[k] = E[k] + W_n^k * O[k]
+	std::complex<double> const *z = _work.data();
+	std::complex<double> *x = output.Buffer();
+	for (int64_t k = 0; k <= half; k++)
+	{
+		std::complex<double> a = z[k == half ? 0 : k];
+		std::complex<double> b = std::conj(z[k == 0 ? 0 : half - k]);
+		double er = 0.5 * (a.real() + b.real());
+		double ei = 0.5 * (a.imag() + b.imag());
+
+		// (a - b) / (2i) = (a - b) * (-i / 2)
+		double or_ = 0.5 * (a.imag() - b.imag());
+		double oi = -0.5 * (a.real() - b.real());
+
+		double wr = _twiddles[k].real();
+		double wi = _twiddles[k].imag();
+		x[k] = std::complex<double>{er + or_ * wr - oi * wi, ei + or_ * wi + oi * wr};
+	}
+}
+
+void base::RealFft::Inverse(base::ReadOnlyArraySpan<std::complex<double>> const &input,
+							base::ArraySpan<double> const &output)
+{
+	if (input.Count() != SpectrumSize())
+	{
+		throw std::invalid_argument{CODE_POS_STR + "input 的元素个数必须等于 n / 2 + 1."};
+	}
+
+	if (output.Count() != _size)
+	{
+		throw std::invalid_argument{CODE_POS_STR + "output 的元素个数必须等于变换长度。"};
+	}
+
+	int64_t half = _size / 2;
+
+	// X[k] = E + W^k * O, X[k + h] = conj(X[h - k]) = E - W^k * O, 所以
+	// 		E = (X[k] + conj(X[h - k])) / 2
+	// 		O = (X[k] - conj(X[h - k])) / 2 * W^(-k)
+	// 		Z[k] = E + i * O
+	std::complex<double> const *x = input.Buffer();
+	std::complex<double> *z = _work.data();
+	for (int64_t k = 0; k < half; k++)
+	{
+		std::complex<double> a = x[k];
+		std::complex<double> b = std::conj(x[half - k]);
+		if (k == 0)
+		{
+			// 实数序列的直流分量没有虚部。
+			a = std::complex<double>{a.real(), 0};
+			b = std::complex<double>{b.real(), 0};
+		}
+
+		double er = 0.5 * (a.real() + b.real());
+		double ei = 0.5 * (a.imag() + b.imag());
+		double dr = 0.5 * (a.real() - b.real());
+		double di = 0.5 * (a.imag() - b.imag());
+
+		// 乘以 conj(W^k).
+		double wr = _twiddles[k].real();
+		double wi = -_twiddles[k].imag();
+		double or_ = dr * wr - di * wi;
+		double oi = dr * wi + di * wr;
+
+		z[k] = std::complex<double>{er - oi, ei + or_};
+	}
+
+	base::ArraySpan<std::complex<double>> work{_work.data(), half};
+	_half_fft.Inverse(work, work);
+	std::copy(reinterpret_cast<double const *>(_work.data()),
+			  reinterpret_cast<double const *>(_work.data()) + _size,
+			  output.Buffer());
+}
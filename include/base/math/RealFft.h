@@ -0,0 +1,84 @@
+#pragma once
+#include "base/container/ArraySpan.h"
+#include "base/container/ReadOnlyArraySpan.h"
+#include "base/math/Fft.h"
+#include <complex>
+#include <cstdint>
+#include <vector>
+
+namespace base
+{
+	///
+	/// @brief 实数序列的快速傅里叶变换。
+	///
+	/// @note 实数序列的频谱共轭对称，只需要计算前 n / 2 + 1 个点。把偶数下标的点作为实部，
+	/// 奇数下标的点作为虚部，拼成 n / 2 点的复数序列做复数变换，再用一次 O(n) 的后处理
+	/// 分离出结果。计算量约为同样长度复数变换的一半。
+	///
+	/// @warning 对象内部有工作缓冲区，不能在多个线程中同时使用同一个对象。
+	///
+	class RealFft
+	{
+	private:
+		int64_t _size = 0;
+		base::Fft _half_fft;
+
+		// exp(-2 * pi * i * k / n), k = 0, 1, ..., n / 2.
+		std::vector<std::complex<double>> _twiddles;
+
+		std::vector<std::complex<double>> _work;
+
+	public:
+		///
+		/// @brief 构造一个变换计划。
+		///
+		/// @param size 变换长度。必须是 >= 2 的偶数。
+		///
+		RealFft(int64_t size);
+
+		RealFft(RealFft const &o) = delete;
+		RealFft &operator=(RealFft const &o) = delete;
+
+		///
+		/// @brief 变换长度。
+		///
+		/// @return
+		///
+		int64_t Size() const
+		{
+			return _size;
+		}
+
+		///
+		/// @brief 频谱的点数，即 Size() / 2 + 1.
+		///
+		/// @return
+		///
+		int64_t SpectrumSize() const
+		{
+			return _size / 2 + 1;
+		}
+
+		///
+		/// @brief 正变换。
+		///
+		/// @param input 元素个数必须等于 Size().
+		/// @param output 频谱的第 0 到第 n / 2 个点。元素个数必须等于 SpectrumSize().
+		/// 其余的点是这些点的共轭：X[n - k] == conj(X[k]).
+		///
+		void Forward(base::ReadOnlyArraySpan<double> const &input,
+					 base::ArraySpan<std::complex<double>> const &output);
+
+		///
+		/// @brief 逆变换。结果除以了 n, 所以 Inverse(Forward(x)) == x.
+		///
+		/// @note 第 0 个点和第 n / 2 个点的虚部被忽略。
+		///
+		/// @param input 频谱的第 0 到第 n / 2 个点。元素个数必须等于 SpectrumSize().
+		/// @param output 元素个数必须等于 Size().
+		///
+		void Inverse(base::ReadOnlyArraySpan<std::complex<double>> const &input,
+					 base::ArraySpan<double> const &output);
+	};
+
+} // namespace base
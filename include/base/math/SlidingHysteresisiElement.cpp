@@ -1,4 +1,7 @@
 #include "SlidingHysteresisiElement.h"
+#include "base/string/define.h"
+#include <cstdint>
+#include <stdexcept>
 
 base::SlidingHysteresisiElement::SlidingHysteresisiElement(HysteresisElement_RisingThreshold const &rising_threshold,
 														   HysteresisElement_FallenThreshold const &fallen_threshold)
@@ -30,3 +33,17 @@ bool base::SlidingHysteresisiElement::Input(double x)
 
 	return ret;
 }
+
+void base::SlidingHysteresisiElement::Input(base::ReadOnlyArraySpan<double> const &x, base::ArraySpan<bool> const &y)
+{
+	if (x.Count() != y.Count())
+	{
+		throw std::invalid_argument{CODE_POS_STR + "x 和 y 的元素个数必须相等。"};
+	}
+
+	// 窗口随输入滑动，每个样本都依赖上一个样本移动后的窗口，只能逐个处理。
+	for (int64_t i = 0; i < x.Count(); i++)
+	{
+		y[i] = Input(x[i]);
+	}
+}
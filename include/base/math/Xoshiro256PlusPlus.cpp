@@ -0,0 +1 @@
+#include "Xoshiro256PlusPlus.h" // IWYU pragma: keep
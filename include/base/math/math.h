@@ -2,7 +2,10 @@
 #include "base/math/math.h"
 #include "base/string/define.h"
 #include "boost/multiprecision/cpp_int.hpp" // IWYU pragma: keep
+#include <bit>
+#include <cmath>
 #include <cstdint>
+#include <limits>
 #include <stdexcept>
 #include <type_traits>
 
@@ -224,6 +227,163 @@ namespace base
 		return boost::multiprecision::gcd(a, b);
 	}
 
+	///
+	/// @brief 使用二进制 gcd 算法 (Stein 算法) 求最大公约数。
+	///
+	/// @note 只用到移位和减法，不需要除法。整型除法指令很慢，所以比辗转相除法快。
+	///
+	/// @note 结果为非负数。a, b 都为 0 时返回 0.
+	///
+	template <typename T>
+		requires(std::is_integral_v<T> && !std::is_same_v<T, bool>)
+	constexpr T binary_gcd(T a, T b) noexcept
+	{
+		using unsigned_type = std::make_unsigned_t<T>;
+
+		// 先转为无符号数的绝对值。用无符号数取相反数，避免有符号数最小值取相反数溢出。
+		unsigned_type ua = static_cast<unsigned_type>(a);
+		unsigned_type ub = static_cast<unsigned_type>(b);
+		if (a < 0)
+		{
+			ua = static_cast<unsigned_type>(0) - ua;
+		}
+
+		if (b < 0)
+		{
+			ub = static_cast<unsigned_type>(0) - ub;
+		}
+
+		if (ua == 0)
+		{
+			return static_cast<T>(ub);
+		}
+
+		if (ub == 0)
+		{
+			return static_cast<T>(ua);
+		}
+
+		// 两个数共同拥有的因子 2 的个数。
+		int shift = std::countr_zero(static_cast<unsigned_type>(ua | ub));
+
+		ua >>= std::countr_zero(ua);
+		while (true)
+		{
+			// 此时 ua 是奇数。去掉 ub 中的因子 2 后，两个奇数相减得到偶数，
+			// 继续去掉因子 2, 直到相减得到 0.
+			//
+			// 用 min 和差的绝对值代替交换，编译器能生成条件传送指令，没有分支预测失败。
+			ub >>= std::countr_zero(ub);
+			unsigned_type min = ua < ub ? ua : ub;
+			unsigned_type diff = ua < ub ? ub - ua : ua - ub;
+			ua = min;
+			ub = diff;
+			if (ub == 0)
+			{
+				break;
+			}
+		}
+
+		return static_cast<T>(ua << shift);
+	}
+
+	///
+	/// @brief 带溢出检查的加法。
+	///
+	/// @param a
+	/// @param b
+	/// @param result 输出结果。溢出时结果无意义。
+	///
+	/// @return 溢出返回 true, 没有溢出返回 false.
+	///
+	template <typename T>
+		requires(std::is_integral_v<T>)
+	constexpr bool add_overflow(T a, T b, T &result) noexcept
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		return __builtin_add_overflow(a, b, &result);
+#else
+		if constexpr (std::is_signed_v<T>)
+		{
+			if ((b > 0 && a > std::numeric_limits<T>::max() - b) ||
+				(b < 0 && a < std::numeric_limits<T>::min() - b))
+			{
+				return true;
+			}
+		}
+		else
+		{
+			if (a > std::numeric_limits<T>::max() - b)
+			{
+				return true;
+			}
+		}
+
+		result = static_cast<T>(a + b);
+		return false;
+#endif
+	}
+
+	///
+	/// @brief 带溢出检查的乘法。
+	///
+	/// @param a
+	/// @param b
+	/// @param result 输出结果。溢出时结果无意义。
+	///
+	/// @return 溢出返回 true, 没有溢出返回 false.
+	///
+	template <typename T>
+		requires(std::is_integral_v<T>)
+	constexpr bool mul_overflow(T a, T b, T &result) noexcept
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		return __builtin_mul_overflow(a, b, &result);
+#else
+		if (a == 0 || b == 0)
+		{
+			result = 0;
+			return false;
+		}
+
+		if constexpr (std::is_signed_v<T>)
+		{
+			if ((a == -1 && b == std::numeric_limits<T>::min()) ||
+				(b == -1 && a == std::numeric_limits<T>::min()))
+			{
+				return true;
+			}
+
+			if (a > 0)
+			{
+				if ((b > 0 && a > std::numeric_limits<T>::max() / b) ||
+					(b < 0 && b < std::numeric_limits<T>::min() / a))
+				{
+					return true;
+				}
+			}
+			else
+			{
+				if ((b > 0 && a < std::numeric_limits<T>::min() / b) ||
+					(b < 0 && a < std::numeric_limits<T>::max() / b))
+				{
+					return true;
+				}
+			}
+		}
+		else
+		{
+			if (a > std::numeric_limits<T>::max() / b)
+			{
+				return true;
+			}
+		}
+
+		result = static_cast<T>(a * b);
+		return false;
+#endif
+	}
+
 	///
 	/// @brief 求最小公倍数。
 	///
@@ -517,4 +677,44 @@ namespace base
 		return result;
 	}
 
+	///
+	/// @brief 计算 sin(2 * pi * cycles).
+	///
+	/// @note 用于按周期数表示相位的信号发生器。先把相位归约到 [0, 0.25] 个周期，
+	/// 再用 19 阶泰勒多项式计算，误差在 1e-15 量级。
+	///
+	/// @note 没有分支和函数调用，在循环中调用时编译器可以向量化。归约用整型转换和绝对值
+	/// 而不用条件表达式，因为浮点比较可能触发异常，编译器不会把它们转换为无分支的选择。
+	///
+	/// @param cycles 周期数。绝对值必须小于 2^31.
+	/// @return
+	///
+	inline double sin_2pi(double cycles) noexcept
+	{
+		// 减去整数部分，得到 (-1, 1). 转为 int32_t 而不是 int64_t,
+		// 因为只有 32 位的转换有 SSE2 向量指令。
+		double t = cycles - static_cast<double>(static_cast<int32_t>(cycles));
+
+		// 归约到 [-0.5, 0.5]. |t| > 0.5 时 2t 截断为 1 或 -1.
+		t -= static_cast<double>(static_cast<int32_t>(2 * t));
+
+		// sin 是奇函数，先算 |t|, 最后恢复符号。
+		// sin(2pi * a) = sin(2pi * (0.5 - a)), 把 a 归约到 [0, 0.25].
+		double a = std::abs(t);
+		a = 0.25 - std::abs(a - 0.25);
+
+		double x = 6.283185307179586476925 * a;
+		double x2 = x * x;
+		double p = -1.0 / 121645100408832000.0;
+		p = p * x2 + 1.0 / 355687428096000.0;
+		p = p * x2 - 1.0 / 1307674368000.0;
+		p = p * x2 + 1.0 / 6227020800.0;
+		p = p * x2 - 1.0 / 39916800.0;
+		p = p * x2 + 1.0 / 362880.0;
+		p = p * x2 - 1.0 / 5040.0;
+		p = p * x2 + 1.0 / 120.0;
+		p = p * x2 - 1.0 / 6.0;
+		return std::copysign(x + x * x2 * p, t);
+	}
+
 } // namespace base
@@ -1,20 +1,80 @@
 #include "random.h"
+#include "base/container/ArraySpan.h"
+#include "base/math/Xoshiro256PlusPlus.h"
+#include "base/stream/Span.h"
+#include "base/string/define.h"
 #include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <memory>
-#include <random>
 #include <stdexcept>
 
+#if HAS_THREAD
+	#include <atomic>
+	#include <random>
+#endif
+
+void base::IRandomGenerator::Fill(base::Span const &span) const
+{
+	uint8_t *buffer = span.Buffer();
+	int64_t i = 0;
+	for (; i + 8 <= span.Size(); i += 8)
+	{
+		uint64_t value = GenerateUInt64Random();
+		std::memcpy(buffer + i, &value, 8);
+	}
+
+	if (i < span.Size())
+	{
+		uint64_t value = GenerateUInt64Random();
+		std::memcpy(buffer + i, &value, span.Size() - i);
+	}
+}
+
+void base::IRandomGenerator::Generate(base::ArraySpan<int64_t> const &span, int64_t min, int64_t max) const
+{
+	for (int64_t i = 0; i < span.Count(); i++)
+	{
+		span[i] = GenerateInt64Random(min, max);
+	}
+}
+
 #if HAS_THREAD
 
 namespace
 {
+	///
+	/// @brief 本线程的生成器。
+	///
+	/// @note 每个线程第一次使用时用 std::random_device 和一个全局计数器构造种子，
+	/// 即使 std::random_device 是确定性的实现，各线程的序列也不同。
+	///
+	/// @return
+	///
+	base::Xoshiro256PlusPlus &ThreadGenerator()
+	{
+		static std::atomic_uint64_t thread_index = 0;
+
+		thread_local base::Xoshiro256PlusPlus generator{
+			[]()
+			{
+				std::random_device rd{};
+				uint64_t seed = (static_cast<uint64_t>(rd()) << 32) | rd();
+				return seed ^ (thread_index.fetch_add(1) * 0x9e3779b97f4a7c15ULL);
+			}(),
+		};
+
+		return generator;
+	}
+
+	///
+	/// @brief 随机数生成器。
+	///
+	/// @note 本类没有状态，状态在 ThreadGenerator 中，每个线程一份，所以不存在数据竞争。
+	///
 	class RandomGenerator :
 		public base::IRandomGenerator
 	{
-	private:
-		inline static std::mt19937_64 _generator{std::random_device{}()};
-
 	public:
 		virtual int64_t GenerateInt64Random(int64_t min = std::numeric_limits<int64_t>::min(),
 											int64_t max = std::numeric_limits<int64_t>::max()) const override
@@ -22,14 +82,10 @@ namespace
 			// 检查范围合法性
 			if (min > max)
 			{
-				throw std::invalid_argument("最小值不能大于最大值！");
+				throw std::invalid_argument{CODE_POS_STR + "最小值不能大于最大值！"};
 			}
 
-			// 定义随机数分布范围
-			std::uniform_int_distribution<int64_t> distribution(min, max);
-
-			// 返回随机数
-			return distribution(_generator);
+			return ThreadGenerator().Next(min, max);
 		}
 
 		virtual uint64_t GenerateUInt64Random(uint64_t min = std::numeric_limits<uint64_t>::min(),
@@ -38,14 +94,51 @@ namespace
 			// 检查范围合法性
 			if (min > max)
 			{
-				throw std::invalid_argument("最小值不能大于最大值！");
+				throw std::invalid_argument{CODE_POS_STR + "最小值不能大于最大值！"};
+			}
+
+			if (max - min == std::numeric_limits<uint64_t>::max())
+			{
+				return ThreadGenerator().Next();
+			}
+
+			return min + ThreadGenerator().Next(max - min + 1);
+		}
+
+		virtual void Fill(base::Span const &span) const override
+		{
+			// 整个过程只取一次线程局部变量。
+			base::Xoshiro256PlusPlus &generator = ThreadGenerator();
+			uint8_t *buffer = span.Buffer();
+			int64_t i = 0;
+			for (; i + 8 <= span.Size(); i += 8)
+			{
+				uint64_t value = generator.Next();
+				std::memcpy(buffer + i, &value, 8);
+			}
+
+			if (i < span.Size())
+			{
+				uint64_t value = generator.Next();
+				std::memcpy(buffer + i, &value, span.Size() - i);
 			}
+		}
 
-			// 定义随机数分布范围
-			std::uniform_int_distribution<int64_t> distribution(min, max);
+		virtual void Generate(base::ArraySpan<int64_t> const &span,
+							  int64_t min = std::numeric_limits<int64_t>::min(),
+							  int64_t max = std::numeric_limits<int64_t>::max()) const override
+		{
+			if (min > max)
+			{
+				throw std::invalid_argument{CODE_POS_STR + "最小值不能大于最大值！"};
+			}
 
-			// 返回随机数
-			return distribution(_generator);
+			base::Xoshiro256PlusPlus &generator = ThreadGenerator();
+			int64_t *buffer = span.Buffer();
+			for (int64_t i = 0; i < span.Count(); i++)
+			{
+				buffer[i] = generator.Next(min, max);
+			}
 		}
 	};
 
@@ -64,12 +157,14 @@ std::vector<int64_t> base::ShuffleIndex(int64_t count)
 		ret.push_back(i);
 	}
 
-	// 生成随机数引擎
-	std::random_device rd;
-	std::mt19937 g(rd());
+	// Fisher-Yates 洗牌。
+	base::Xoshiro256PlusPlus &generator = ThreadGenerator();
+	for (int64_t i = count - 1; i > 0; i--)
+	{
+		int64_t j = static_cast<int64_t>(generator.Next(static_cast<uint64_t>(i) + 1));
+		std::swap(ret[i], ret[j]);
+	}
 
-	// 打乱顺序
-	std::shuffle(ret.begin(), ret.end(), g);
 	return ret;
 }
 
@@ -6,6 +6,11 @@
 
 namespace base
 {
+	class Span;
+
+	template <typename ItemType>
+	class ArraySpan;
+
 	///
 	/// @brief 随机数生成器接口。
 	///
@@ -118,11 +123,36 @@ namespace base
 			int64_t ret = GenerateInt64Random(static_cast<int64_t>(min), static_cast<int64_t>(max));
 			return ret;
 		}
+
+		///
+		/// @brief 用随机字节填满 span.
+		///
+		/// @note 默认实现逐个调用 GenerateUInt64Random. 派生类可以重写为批量生成。
+		///
+		/// @param span
+		///
+		virtual void Fill(base::Span const &span) const;
+
+		///
+		/// @brief 用指定范围内的 int64_t 随机数填满 span.
+		///
+		/// @note 默认实现逐个调用 GenerateInt64Random. 派生类可以重写为批量生成。
+		///
+		/// @param span
+		/// @param min
+		/// @param max
+		///
+		virtual void Generate(base::ArraySpan<int64_t> const &span,
+							  int64_t min = std::numeric_limits<int64_t>::min(),
+							  int64_t max = std::numeric_limits<int64_t>::max()) const;
 	};
 
 	///
 	/// @brief 构造一个随机数生成器。
 	///
+	/// @note 每个线程使用各自的 xoshiro256++ 状态，多个线程可以同时使用同一个生成器对象，
+	/// 不需要加锁。
+	///
 	/// @return std::shared_ptr<base::IRandomGenerator>
 	///
 	std::shared_ptr<base::IRandomGenerator> CreateRandomGenerator();
@@ -1077,3 +1077,566 @@ void te_print(te_expr const *n)
 {
 	pn(n, 0);
 }
+
+/* BYTECODE */
+
+/* Number of samples processed by one pass over the instructions. */
+#define TE_BLOCK_SIZE 256
+
+/* Operands are encoded as kind * TE_SLOT_KIND + index while compiling, */
+/* and remapped to flat slot indices when compiling finishes. */
+#define TE_SLOT_KIND (1 << 24)
+#define TE_SLOT_REGISTER 0
+#define TE_SLOT_CONSTANT 1
+#define TE_SLOT_INPUT 2
+
+enum
+{
+	TE_OP_ADD,
+	TE_OP_SUB,
+	TE_OP_MUL,
+	TE_OP_DIV,
+	TE_OP_NEGATE,
+	TE_OP_ABS,
+	TE_OP_SQRT,
+	TE_OP_CALL,
+	TE_OP_CLOSURE
+};
+
+typedef struct te_instruction
+{
+	int op;
+	int arity;
+	int dst;
+	int src[7];
+	void const *function;
+	void *context;
+} te_instruction;
+
+struct te_bytecode
+{
+	te_instruction *code;
+	int code_len;
+	int code_cap;
+
+	/* Number of scratch registers needed by the instructions. */
+	int register_count;
+
+	double *constants;
+	int constant_count;
+	int constant_cap;
+
+	/* Distinct bound addresses of the variables in the expression. */
+	double const **inputs;
+	/* Index into the variables passed to te_bytecode_compile, or -1 if not found there. */
+	int *input_columns;
+	int input_count;
+	int input_cap;
+
+	/* Slot of the result. */
+	int result;
+
+	/* One pointer per slot: registers, then constants, then inputs. */
+	double const **slots;
+	/* TE_BLOCK_SIZE doubles per slot. */
+	double *scratch;
+};
+
+static int grow(void **buffer, int *cap, int len, int element_size)
+{
+	if (len < *cap)
+	{
+		return 1;
+	}
+
+	int const new_cap = *cap ? *cap * 2 : 8;
+	void *new_buffer = realloc(*buffer, (size_t)new_cap * element_size);
+	if (!new_buffer)
+	{
+		return 0;
+	}
+
+	*buffer = new_buffer;
+	*cap = new_cap;
+	return 1;
+}
+
+static int emit_constant(te_bytecode *b, double value)
+{
+	int i;
+	for (i = 0; i < b->constant_count; ++i)
+	{
+		/* memcmp so that NaN constants and -0.0 are kept distinct. */
+		if (memcmp(&b->constants[i], &value, sizeof(double)) == 0)
+		{
+			return TE_SLOT_CONSTANT * TE_SLOT_KIND + i;
+		}
+	}
+
+	if (!grow((void **)&b->constants, &b->constant_cap, b->constant_count, sizeof(double)))
+	{
+		return -1;
+	}
+
+	b->constants[b->constant_count] = value;
+	return TE_SLOT_CONSTANT * TE_SLOT_KIND + b->constant_count++;
+}
+
+static int emit_input(te_bytecode *b, double const *bound, te_variable const *variables, int var_count)
+{
+	int i;
+	for (i = 0; i < b->input_count; ++i)
+	{
+		if (b->inputs[i] == bound)
+		{
+			return TE_SLOT_INPUT * TE_SLOT_KIND + i;
+		}
+	}
+
+	if (!grow((void **)&b->inputs, &b->input_cap, b->input_count, sizeof(double const *)))
+	{
+		return -1;
+	}
+
+	/* input_columns grows with inputs, keep the same capacity. */
+	int *new_columns = realloc(b->input_columns, (size_t)b->input_cap * sizeof(int));
+	if (!new_columns)
+	{
+		return -1;
+	}
+
+	b->input_columns = new_columns;
+
+	int column = -1;
+	for (i = 0; i < var_count; ++i)
+	{
+		if (variables[i].address == bound && TYPE_MASK(variables[i].type) == TE_VARIABLE)
+		{
+			column = i;
+			break;
+		}
+	}
+
+	b->inputs[b->input_count] = bound;
+	b->input_columns[b->input_count] = column;
+	return TE_SLOT_INPUT * TE_SLOT_KIND + b->input_count++;
+}
+
+/* Emits code that leaves the value of n in register r, or in a constant or input slot. */
+/* Registers below r are not touched. Returns the encoded slot, or -1 on error. */
+static int emit(te_bytecode *b, te_expr const *n, int r, te_variable const *variables, int var_count)
+{
+	switch (TYPE_MASK(n->type))
+	{
+	case TE_CONSTANT:
+		{
+			return emit_constant(b, n->value);
+		}
+	case TE_VARIABLE:
+		{
+			return emit_input(b, n->bound, variables, var_count);
+		}
+	case TE_FUNCTION0:
+	case TE_FUNCTION1:
+	case TE_FUNCTION2:
+	case TE_FUNCTION3:
+	case TE_FUNCTION4:
+	case TE_FUNCTION5:
+	case TE_FUNCTION6:
+	case TE_FUNCTION7:
+	case TE_CLOSURE0:
+	case TE_CLOSURE1:
+	case TE_CLOSURE2:
+	case TE_CLOSURE3:
+	case TE_CLOSURE4:
+	case TE_CLOSURE5:
+	case TE_CLOSURE6:
+	case TE_CLOSURE7:
+		{
+			int const arity = ARITY(n->type);
+			te_instruction ins;
+			int i;
+			memset(&ins, 0, sizeof(ins));
+
+			if (IS_FUNCTION(n->type) && n->function == comma)
+			{
+				/* The left hand side only runs for its side effects, the value is the right hand side. */
+				/* Both go to register r, so the parent may use r + 1 for its next operand. */
+				if (emit(b, n->parameters[0], r, variables, var_count) < 0)
+				{
+					return -1;
+				}
+
+				return emit(b, n->parameters[1], r, variables, var_count);
+			}
+
+			/* Argument i is computed in register r + i, so earlier arguments are not overwritten. */
+			for (i = 0; i < arity; ++i)
+			{
+				ins.src[i] = emit(b, n->parameters[i], r + i, variables, var_count);
+				if (ins.src[i] < 0)
+				{
+					return -1;
+				}
+			}
+
+			ins.arity = arity;
+			ins.dst = r;
+			ins.function = n->function;
+			if (IS_CLOSURE(n->type))
+			{
+				ins.op = TE_OP_CLOSURE;
+				ins.context = n->parameters[arity];
+			}
+			else if (n->function == add)
+			{
+				ins.op = TE_OP_ADD;
+			}
+			else if (n->function == sub)
+			{
+				ins.op = TE_OP_SUB;
+			}
+			else if (n->function == mul)
+			{
+				ins.op = TE_OP_MUL;
+			}
+			else if (n->function == divide)
+			{
+				ins.op = TE_OP_DIV;
+			}
+			else if (n->function == negate)
+			{
+				ins.op = TE_OP_NEGATE;
+			}
+			else if (n->function == (void const *)fabs)
+			{
+				ins.op = TE_OP_ABS;
+			}
+			else if (n->function == (void const *)sqrt)
+			{
+				ins.op = TE_OP_SQRT;
+			}
+			else
+			{
+				ins.op = TE_OP_CALL;
+			}
+
+			if (r + 1 > b->register_count)
+			{
+				b->register_count = r + 1;
+			}
+
+			if (!grow((void **)&b->code, &b->code_cap, b->code_len, sizeof(te_instruction)))
+			{
+				return -1;
+			}
+
+			b->code[b->code_len++] = ins;
+			return TE_SLOT_REGISTER * TE_SLOT_KIND + r;
+		}
+	default:
+		{
+			return -1;
+		}
+	}
+}
+
+static int remap_slot(te_bytecode const *b, int slot)
+{
+	int const kind = slot / TE_SLOT_KIND;
+	int const index = slot % TE_SLOT_KIND;
+	switch (kind)
+	{
+	case TE_SLOT_REGISTER:
+		return index;
+	case TE_SLOT_CONSTANT:
+		return b->register_count + index;
+	default:
+		return b->register_count + b->constant_count + index;
+	}
+}
+
+te_bytecode *te_bytecode_compile(te_expr const *n, te_variable const *variables, int var_count)
+{
+	if (!n)
+	{
+		return NULL;
+	}
+
+	te_bytecode *b = malloc(sizeof(te_bytecode));
+	CHECK_NULL(b);
+	memset(b, 0, sizeof(te_bytecode));
+
+	b->result = emit(b, n, 0, variables, var_count);
+	if (b->result < 0)
+	{
+		te_bytecode_free(b);
+		return NULL;
+	}
+
+	int i, j;
+	b->result = remap_slot(b, b->result);
+	for (i = 0; i < b->code_len; ++i)
+	{
+		for (j = 0; j < b->code[i].arity; ++j)
+		{
+			b->code[i].src[j] = remap_slot(b, b->code[i].src[j]);
+		}
+	}
+
+	int const slot_count = b->register_count + b->constant_count + b->input_count;
+	b->slots = malloc(sizeof(double const *) * (slot_count ? slot_count : 1));
+	b->scratch = malloc(sizeof(double) * TE_BLOCK_SIZE * (slot_count ? slot_count : 1));
+	if (!b->slots || !b->scratch)
+	{
+		te_bytecode_free(b);
+		return NULL;
+	}
+
+	for (i = 0; i < slot_count; ++i)
+	{
+		b->slots[i] = b->scratch + (size_t)i * TE_BLOCK_SIZE;
+	}
+
+	/* Constants never change, broadcast them once. */
+	for (i = 0; i < b->constant_count; ++i)
+	{
+		double *block = b->scratch + (size_t)(b->register_count + i) * TE_BLOCK_SIZE;
+		for (j = 0; j < TE_BLOCK_SIZE; ++j)
+		{
+			block[j] = b->constants[i];
+		}
+	}
+
+	return b;
+}
+
+#define TE_FUN(...) ((double (*)(__VA_ARGS__))ins->function)
+#define A(e) s[e][k]
+
+static void run_call(te_instruction const *ins, double *d, double const *const *s, int count)
+{
+	int k;
+	switch (ins->arity)
+	{
+	case 0:
+		for (k = 0; k < count; ++k)
+			d[k] = TE_FUN(void)();
+		break;
+	case 1:
+		for (k = 0; k < count; ++k)
+			d[k] = TE_FUN(double)(A(0));
+		break;
+	case 2:
+		for (k = 0; k < count; ++k)
+			d[k] = TE_FUN(double, double)(A(0), A(1));
+		break;
+	case 3:
+		for (k = 0; k < count; ++k)
+			d[k] = TE_FUN(double, double, double)(A(0), A(1), A(2));
+		break;
+	case 4:
+		for (k = 0; k < count; ++k)
+			d[k] = TE_FUN(double, double, double, double)(A(0), A(1), A(2), A(3));
+		break;
+	case 5:
+		for (k = 0; k < count; ++k)
+			d[k] = TE_FUN(double, double, double, double, double)(A(0), A(1), A(2), A(3), A(4));
+		break;
+	case 6:
+		for (k = 0; k < count; ++k)
+			d[k] = TE_FUN(double, double, double, double, double, double)(A(0), A(1), A(2), A(3), A(4), A(5));
+		break;
+	case 7:
+		for (k = 0; k < count; ++k)
+			d[k] = TE_FUN(double, double, double, double, double, double, double)(A(0), A(1), A(2), A(3), A(4), A(5), A(6));
+		break;
+	}
+}
+
+static void run_closure(te_instruction const *ins, double *d, double const *const *s, int count)
+{
+	void *c = ins->context;
+	int k;
+	switch (ins->arity)
+	{
+	case 0:
+		for (k = 0; k < count; ++k)
+			d[k] = TE_FUN(void *)(c);
+		break;
+	case 1:
+		for (k = 0; k < count; ++k)
+			d[k] = TE_FUN(void *, double)(c, A(0));
+		break;
+	case 2:
+		for (k = 0; k < count; ++k)
+			d[k] = TE_FUN(void *, double, double)(c, A(0), A(1));
+		break;
+	case 3:
+		for (k = 0; k < count; ++k)
+			d[k] = TE_FUN(void *, double, double, double)(c, A(0), A(1), A(2));
+		break;
+	case 4:
+		for (k = 0; k < count; ++k)
+			d[k] = TE_FUN(void *, double, double, double, double)(c, A(0), A(1), A(2), A(3));
+		break;
+	case 5:
+		for (k = 0; k < count; ++k)
+			d[k] = TE_FUN(void *, double, double, double, double, double)(c, A(0), A(1), A(2), A(3), A(4));
+		break;
+	case 6:
+		for (k = 0; k < count; ++k)
+			d[k] = TE_FUN(void *, double, double, double, double, double, double)(c, A(0), A(1), A(2), A(3), A(4), A(5));
+		break;
+	case 7:
+		for (k = 0; k < count; ++k)
+			d[k] = TE_FUN(void *, double, double, double, double, double, double, double)(c, A(0), A(1), A(2), A(3), A(4), A(5), A(6));
+		break;
+	}
+}
+
+#undef TE_FUN
+#undef A
+
+static void run_block(te_bytecode const *b, int count)
+{
+	double const *const *slots = b->slots;
+	int i, k;
+	for (i = 0; i < b->code_len; ++i)
+	{
+		te_instruction const *ins = &b->code[i];
+
+		/* Registers live in scratch, the cast only drops the const added for inputs. */
+		double *d = (double *)slots[ins->dst];
+		double const *x = slots[ins->src[0]];
+		double const *y = slots[ins->src[1]];
+
+		/* Each lane reads its operands before writing, so d may be the same block as x. */
+		switch (ins->op)
+		{
+		case TE_OP_ADD:
+			for (k = 0; k < count; ++k)
+				d[k] = x[k] + y[k];
+			break;
+		case TE_OP_SUB:
+			for (k = 0; k < count; ++k)
+				d[k] = x[k] - y[k];
+			break;
+		case TE_OP_MUL:
+			for (k = 0; k < count; ++k)
+				d[k] = x[k] * y[k];
+			break;
+		case TE_OP_DIV:
+			for (k = 0; k < count; ++k)
+				d[k] = x[k] / y[k];
+			break;
+		case TE_OP_NEGATE:
+			for (k = 0; k < count; ++k)
+				d[k] = -x[k];
+			break;
+		case TE_OP_ABS:
+			for (k = 0; k < count; ++k)
+				d[k] = fabs(x[k]);
+			break;
+		case TE_OP_SQRT:
+			for (k = 0; k < count; ++k)
+				d[k] = sqrt(x[k]);
+			break;
+		case TE_OP_CALL:
+			{
+				double const *s[7];
+				int j;
+				for (j = 0; j < ins->arity; ++j)
+					s[j] = slots[ins->src[j]];
+				run_call(ins, d, s, count);
+				break;
+			}
+		case TE_OP_CLOSURE:
+			{
+				double const *s[7];
+				int j;
+				for (j = 0; j < ins->arity; ++j)
+					s[j] = slots[ins->src[j]];
+				run_closure(ins, d, s, count);
+				break;
+			}
+		}
+	}
+}
+
+void te_bytecode_eval_block(te_bytecode *b, double const *const *columns, double *out, int count)
+{
+	if (!b || count <= 0)
+	{
+		return;
+	}
+
+	int const input_base = b->register_count + b->constant_count;
+	int const first_block = count < TE_BLOCK_SIZE ? count : TE_BLOCK_SIZE;
+	int i, k, offset;
+
+	/* Variables without a column are read once and broadcast. */
+	for (i = 0; i < b->input_count; ++i)
+	{
+		int const column = b->input_columns[i];
+		if (columns && column >= 0 && columns[column])
+		{
+			continue;
+		}
+
+		double *block = b->scratch + (size_t)(input_base + i) * TE_BLOCK_SIZE;
+		double const value = *b->inputs[i];
+		for (k = 0; k < first_block; ++k)
+		{
+			block[k] = value;
+		}
+
+		b->slots[input_base + i] = block;
+	}
+
+	for (offset = 0; offset < count; offset += TE_BLOCK_SIZE)
+	{
+		int const block_count = count - offset < TE_BLOCK_SIZE ? count - offset : TE_BLOCK_SIZE;
+
+		/* Variables with a column are read in place. */
+		for (i = 0; i < b->input_count; ++i)
+		{
+			int const column = b->input_columns[i];
+			if (columns && column >= 0 && columns[column])
+			{
+				b->slots[input_base + i] = columns[column] + offset;
+			}
+		}
+
+		run_block(b, block_count);
+		memcpy(out + offset, b->slots[b->result], sizeof(double) * block_count);
+	}
+}
+
+double te_bytecode_eval(te_bytecode *b)
+{
+	if (!b)
+	{
+		return NAN;
+	}
+
+	double ret;
+	te_bytecode_eval_block(b, NULL, &ret, 1);
+	return ret;
+}
+
+void te_bytecode_free(te_bytecode *b)
+{
+	if (!b)
+	{
+		return;
+	}
+
+	free(b->code);
+	free(b->constants);
+	free(b->inputs);
+	free(b->input_columns);
+	free(b->slots);
+	free(b->scratch);
+	free(b);
+}
@@ -96,6 +96,30 @@ extern "C"
 	/* This is safe to call on NULL pointers. */
 	void te_free(te_expr *n);
 
+	/* Linear register-based bytecode flattened from a te_expr tree. */
+	/* Evaluates over blocks of samples instead of walking the tree once per sample. */
+	typedef struct te_bytecode te_bytecode;
+
+	/* Flattens the compiled expression into bytecode. */
+	/* variables should be the same array passed to te_compile, it decides the column order of te_bytecode_eval_block. */
+	/* The expression tree is not referenced after this call, it can be freed. */
+	/* Returns NULL on error. */
+	te_bytecode *te_bytecode_compile(te_expr const *n, te_variable const *variables, int var_count);
+
+	/* Evaluates the bytecode once, reading variables from their bound addresses. */
+	double te_bytecode_eval(te_bytecode *b);
+
+	/* Evaluates the bytecode for count samples. */
+	/* columns[i] is the array of values of variables[i], each holding count values. */
+	/* A NULL columns, or a NULL columns[i], reads the variable from its bound address once per call. */
+	/* out receives count results. */
+	/* The bytecode holds scratch registers, do not evaluate the same te_bytecode from multiple threads at once. */
+	void te_bytecode_eval_block(te_bytecode *b, double const *const *columns, double *out, int count);
+
+	/* Frees the bytecode. */
+	/* This is safe to call on NULL pointers. */
+	void te_bytecode_free(te_bytecode *b);
+
 #ifdef __cplusplus
 }
 #endif
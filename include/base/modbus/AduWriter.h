@@ -6,7 +6,7 @@
 #include "base/stream/ReadOnlySpan.h"
 #include "base/stream/Span.h"
 #include "base/string/define.h"
-#include "base/string/ToHexString.h"
+#include "base/string/encoding/hex.h"
 #include <bit>
 #include <cstdint>
 #include <stdexcept>
@@ -110,28 +110,9 @@ namespace base::modbus
 		///
 		std::string SpanForSendingString() const
 		{
-			std::string ret;
-			base::ToHexStringOptions option{};
-			option.with_0x_prefix = false;
-			option.width = 2;
-
-			bool is_first_loop = true;
-
-			for (uint8_t b : SpanForSending())
-			{
-				if (is_first_loop)
-				{
-					is_first_loop = false;
-				}
-				else
-				{
-					ret += " ";
-				}
-
-				ret += base::ToHexString(b, option);
-			}
-
-			return ret;
+			base::string::encoding::hex_encode_options options{};
+			options.separator = ' ';
+			return base::string::encoding::hex_encode(SpanForSending(), options);
 		}
 	};
 
@@ -1,4 +1,5 @@
 #pragma once
+#include "base/container/ArraySpan.h"
 #include "base/modbus/AduReader.h"
 #include "base/modbus/FunctionCode.h"
 #include "base/stream/ReadOnlySpan.h"
@@ -71,6 +72,20 @@ namespace base::modbus
 			return _adu_reader.ReadData<ReturnType>(remote_endian);
 		}
 
+		///
+		/// @brief 读取一组数值，填满 values.
+		///
+		/// @note 例如一次读出全部寄存器，整段转换字节序。
+		///
+		/// @param values
+		/// @param remote_endian
+		///
+		template <typename ValueType>
+		void ReadData(base::ArraySpan<ValueType> const &values, std::endian remote_endian)
+		{
+			_adu_reader.ReadData(values, remote_endian);
+		}
+
 		///
 		/// @brief 进行 CRC 校验。
 		///
@@ -1 +1,447 @@
 #include "IPAddress.h" // IWYU pragma: keep
+#include "base/bit/AutoBitConverter.h"
+#include <algorithm>
+
+namespace
+{
+	bool IsDigit(char c)
+	{
+		return c >= '0' && c <= '9';
+	}
+
+	int32_t HexDigitValue(char c)
+	{
+		if (c >= '0' && c <= '9')
+		{
+			return c - '0';
+		}
+
+		if (c >= 'a' && c <= 'f')
+		{
+			return c - 'a' + 10;
+		}
+
+		if (c >= 'A' && c <= 'F')
+		{
+			return c - 'A' + 10;
+		}
+
+		return -1;
+	}
+
+	///
+	/// @brief 解析点分 10 进制的 IPV4 地址。
+	///
+	/// @param text
+	/// @param length
+	/// @param big_endian_bytes 按大端序写入 4 个字节。
+	///
+	/// @return
+	///
+	bool TryParseIPV4(char const *text, int64_t length, uint8_t *big_endian_bytes)
+	{
+		int64_t position = 0;
+		for (int32_t i = 0; i < 4; i++)
+		{
+			if (i > 0)
+			{
+				if (position >= length || text[position] != '.')
+				{
+					return false;
+				}
+
+				position++;
+			}
+
+			int32_t value = 0;
+			int32_t digit_count = 0;
+			int64_t start = position;
+			while (position < length && IsDigit(text[position]) && digit_count < 3)
+			{
+				value = value * 10 + (text[position] - '0');
+				position++;
+				digit_count++;
+			}
+
+			if (digit_count == 0 || value > 255)
+			{
+				return false;
+			}
+
+			// 与 inet_pton 相同，拒绝有前导 0 的多位数，否则会与 8 进制混淆。
+			if (digit_count > 1 && text[start] == '0')
+			{
+				return false;
+			}
+
+			big_endian_bytes[i] = static_cast<uint8_t>(value);
+		}
+
+		return position == length;
+	}
+
+	///
+	/// @brief 解析冒号分 16 进制的 IPV6 地址。
+	///
+	/// @param text
+	/// @param length
+	/// @param big_endian_bytes 按大端序写入 16 个字节。
+	///
+	/// @return
+	///
+	bool TryParseIPV6(char const *text, int64_t length, uint8_t *big_endian_bytes)
+	{
+		uint16_t groups[8]{};
+		int32_t group_count = 0;
+
+		// :: 所在的位置，即 :: 之前有几组。没有 :: 时为 -1.
+		int32_t gap = -1;
+
+		int64_t position = 0;
+		if (length >= 2 && text[0] == ':' && text[1] == ':')
+		{
+			gap = 0;
+			position = 2;
+		}
+
+		while (position < length)
+		{
+			// 本组一直到下一个冒号。本组中有点号的话是嵌入的 IPV4 地址，必须是最后一组。
+			int64_t group_end = position;
+			bool has_dot = false;
+			while (group_end < length && text[group_end] != ':')
+			{
+				has_dot = has_dot || text[group_end] == '.';
+				group_end++;
+			}
+
+			if (has_dot)
+			{
+				if (group_end != length || group_count > 6)
+				{
+					return false;
+				}
+
+				uint8_t ipv4[4];
+				if (!TryParseIPV4(text + position, length - position, ipv4))
+				{
+					return false;
+				}
+
+				groups[group_count++] = static_cast<uint16_t>((ipv4[0] << 8) | ipv4[1]);
+				groups[group_count++] = static_cast<uint16_t>((ipv4[2] << 8) | ipv4[3]);
+				position = length;
+				break;
+			}
+
+			int64_t digit_count = group_end - position;
+			if (digit_count == 0 || digit_count > 4 || group_count == 8)
+			{
+				return false;
+			}
+
+			uint32_t value = 0;
+			for (int64_t i = position; i < group_end; i++)
+			{
+				int32_t digit = HexDigitValue(text[i]);
+				if (digit < 0)
+				{
+					return false;
+				}
+
+				value = (value << 4) | static_cast<uint32_t>(digit);
+			}
+
+			groups[group_count++] = static_cast<uint16_t>(value);
+			position = group_end;
+			if (position == length)
+			{
+				break;
+			}
+
+			// 跳过冒号。后面紧跟着另一个冒号就是 ::.
+			position++;
+			if (position < length && text[position] == ':')
+			{
+				if (gap >= 0)
+				{
+					return false;
+				}
+
+				gap = group_count;
+				position++;
+			}
+			else if (position == length)
+			{
+				// 以单个冒号结尾。
+				return false;
+			}
+		}
+
+		if (gap < 0)
+		{
+			if (group_count != 8)
+			{
+				return false;
+			}
+		}
+		else
+		{
+			// :: 至少代表一组 0.
+			if (group_count > 7)
+			{
+				return false;
+			}
+
+			int32_t zero_count = 8 - group_count;
+			std::copy_backward(groups + gap, groups + group_count, groups + 8);
+			std::fill(groups + gap, groups + gap + zero_count, 0);
+		}
+
+		for (int32_t i = 0; i < 8; i++)
+		{
+			big_endian_bytes[i * 2] = static_cast<uint8_t>(groups[i] >> 8);
+			big_endian_bytes[i * 2 + 1] = static_cast<uint8_t>(groups[i]);
+		}
+
+		return true;
+	}
+
+	int64_t WriteDecimal(uint8_t value, char *buffer)
+	{
+		if (value >= 100)
+		{
+			buffer[0] = static_cast<char>('0' + value / 100);
+			buffer[1] = static_cast<char>('0' + value / 10 % 10);
+			buffer[2] = static_cast<char>('0' + value % 10);
+			return 3;
+		}
+
+		if (value >= 10)
+		{
+			buffer[0] = static_cast<char>('0' + value / 10);
+			buffer[1] = static_cast<char>('0' + value % 10);
+			return 2;
+		}
+
+		buffer[0] = static_cast<char>('0' + value);
+		return 1;
+	}
+
+	///
+	/// @brief 写入点分 10 进制的 IPV4 地址。
+	///
+	/// @param little_endian_bytes 按小端序储存的 4 个字节。
+	/// @param buffer
+	///
+	/// @return 写入的字符数。
+	///
+	int64_t WriteIPV4(uint8_t const *little_endian_bytes, char *buffer)
+	{
+		int64_t length = 0;
+
+		// 从最高字节开始写。
+		for (int32_t i = 3; i >= 0; i--)
+		{
+			length += WriteDecimal(little_endian_bytes[i], buffer + length);
+			if (i > 0)
+			{
+				buffer[length++] = '.';
+			}
+		}
+
+		return length;
+	}
+
+	int64_t WriteHex(uint16_t value, char *buffer)
+	{
+		constexpr char digits[] = "0123456789abcdef";
+
+		int64_t length = 0;
+		bool started = false;
+		for (int32_t shift = 12; shift >= 0; shift -= 4)
+		{
+			uint32_t digit = (value >> shift) & 0xf;
+			if (digit != 0 || started || shift == 0)
+			{
+				buffer[length++] = digits[digit];
+				started = true;
+			}
+		}
+
+		return length;
+	}
+
+	///
+	/// @brief 按 RFC 5952 写入 8 组 16 进制数：小写，省略前导 0, 最长的连续 0 组缩写为 ::.
+	///
+	/// @param groups
+	/// @param buffer
+	///
+	/// @return 写入的字符数。
+	///
+	int64_t WriteIPV6Groups(uint16_t const *groups, char *buffer)
+	{
+		int64_t length = 0;
+
+		// 找最长的连续 0 组。长度相同时取第一个，只有一组 0 时不缩写。
+		int32_t best_start = -1;
+		int32_t best_length = 1;
+		for (int32_t i = 0; i < 8;)
+		{
+			if (groups[i] != 0)
+			{
+				i++;
+				continue;
+			}
+
+			int32_t run_start = i;
+			while (i < 8 && groups[i] == 0)
+			{
+				i++;
+			}
+
+			if (i - run_start > best_length)
+			{
+				best_start = run_start;
+				best_length = i - run_start;
+			}
+		}
+
+		for (int32_t i = 0; i < 8; i++)
+		{
+			if (i == best_start)
+			{
+				buffer[length++] = ':';
+				buffer[length++] = ':';
+				i += best_length - 1;
+				continue;
+			}
+
+			if (i > 0 && i != best_start + best_length)
+			{
+				buffer[length++] = ':';
+			}
+
+			length += WriteHex(groups[i], buffer + length);
+		}
+
+		return length;
+	}
+
+	uint64_t Mix(uint64_t value)
+	{
+		// murmur3 的 64 位终结函数。让每个输入位都影响每个输出位。
+		value ^= value >> 33;
+		value *= 0xff51afd7ed558ccd;
+		value ^= value >> 33;
+		value *= 0xc4ceb9fe1a85ec53;
+		value ^= value >> 33;
+		return value;
+	}
+
+} // namespace
+
+bool base::IPAddress::TryParse(base::StringView const &text, base::IPAddress &result)
+{
+	char const *buffer = text.Buffer();
+	int64_t length = text.Length();
+	if (length == 0 || length > 45)
+	{
+		return false;
+	}
+
+	bool is_ipv6 = std::find(buffer, buffer + length, ':') != buffer + length;
+	if (!is_ipv6)
+	{
+		uint8_t bytes[4];
+		if (!TryParseIPV4(buffer, length, bytes))
+		{
+			return false;
+		}
+
+		result = base::IPAddress{std::endian::big, base::ReadOnlySpan{bytes, 4}};
+		return true;
+	}
+
+	uint8_t bytes[16];
+	if (!TryParseIPV6(buffer, length, bytes))
+	{
+		return false;
+	}
+
+	result = base::IPAddress{std::endian::big, base::ReadOnlySpan{bytes, 16}};
+	return true;
+}
+
+base::IPAddress base::IPAddress::Parse(base::StringView const &text)
+{
+	base::IPAddress result{};
+	if (!TryParse(text, result))
+	{
+		throw std::invalid_argument{CODE_POS_STR + "非法的 IP 地址字符串：" + std::string{text.StdStringView()}};
+	}
+
+	return result;
+}
+
+int64_t base::IPAddress::Format(base::Span const &buffer) const
+{
+	// 先写到足够大的临时缓冲区，再复制，这样只需要检查一次大小。
+	char text[MaxStringLength];
+	int64_t length = 0;
+	base::ReadOnlySpan bytes = _context.Span();
+
+	if (_context.IPAddressType() == base::IPAddressType::IPV4)
+	{
+		length = WriteIPV4(bytes.Buffer(), text);
+	}
+	else
+	{
+		uint16_t groups[8];
+		for (int32_t i = 0; i < 8; i++)
+		{
+			groups[i] = static_cast<uint16_t>((bytes[15 - i * 2] << 8) | bytes[14 - i * 2]);
+		}
+
+		// IPV4 映射地址 ::ffff:0:0/96 按 RFC 5952 第 5 节把最后 32 位写成点分 10 进制，
+		// 与 inet_ntop 等工具的输出相同。内部是小端序，最后 32 位就是最低的 4 个字节。
+		if (std::all_of(groups, groups + 5,
+						[](uint16_t group)
+						{
+							return group == 0;
+						}) &&
+			groups[5] == 0xffff)
+		{
+			constexpr char prefix[] = "::ffff:";
+			length = static_cast<int64_t>(sizeof(prefix) - 1);
+			std::copy(prefix, prefix + length, text);
+			length += WriteIPV4(bytes.Buffer(), text + length);
+		}
+		else
+		{
+			length = WriteIPV6Groups(groups, text);
+		}
+	}
+
+	if (buffer.Size() < length)
+	{
+		throw std::invalid_argument{CODE_POS_STR + "缓冲区太小，装不下格式化后的 IP 地址。"};
+	}
+
+	std::copy(text, text + length, buffer.Buffer());
+	return length;
+}
+
+size_t std::hash<base::IPAddress>::operator()(base::IPAddress const &value) const noexcept
+{
+	base::ReadOnlySpan bytes = value.Span();
+	if (value.Type() == base::IPAddressType::IPV4)
+	{
+		return static_cast<size_t>(Mix(base::little_endian_remote_converter.FromBytes<uint32_t>(bytes)));
+	}
+
+	uint64_t low = base::little_endian_remote_converter.FromBytes<uint64_t>(bytes.Slice(0, 8));
+	uint64_t high = base::little_endian_remote_converter.FromBytes<uint64_t>(bytes.Slice(8, 8));
+	return static_cast<size_t>(Mix(low ^ Mix(high)));
+}
@@ -5,10 +5,13 @@
 #include "base/string/define.h"
 #include "base/string/ICanToString.h"
 #include "base/string/String.h"
-#include "base/string/ToHexString.h"
+#include "base/string/StringView.h"
 #include <array>
 #include <bit>
+#include <cstdint>
+#include <functional>
 #include <stdexcept>
+#include <string>
 
 namespace base
 {
@@ -213,75 +216,70 @@ namespace base
 		/// @brief 用标准的表示 IP 地址的字符串构造。
 		///
 		/// @note 会根据字符串格式来识别是 IPV4 地址还是 IPV6 地址。
-		/// @note IPV6 地址字符串暂不支持缩写。
+		/// @note 支持 IPV6 的 :: 缩写和末尾嵌入的 IPV4 地址，例如 ::ffff:192.168.1.1.
+		/// @note 忽略首尾的空白字符。
 		///
 		/// @param ip_str
 		///
 		IPAddress(base::String const &ip_str)
 		{
-			base::StringSplitOptions split_options;
-			split_options.trim_each_substring = true;
-			split_options.remove_empty_substring = false;
-
-			if (ip_str.Contains('.'))
+			if (!TryParse(base::StringView{ip_str.StdString()}.Trim(), *this))
 			{
-				// 是 IPV4 地址
-				base::List<base::String> sub_string_list = ip_str.Split('.', split_options);
-				if (sub_string_list.Count() != 4)
-				{
-					throw std::invalid_argument{"非法的 IPV4 地址字符串。"};
-				}
+				throw std::invalid_argument{CODE_POS_STR + "必须是点分 10 进制的 IPV4 地址或冒号分 16 进制的 IPV6 地址，实际是：" +
+											ip_str.StdString()};
+			}
+		}
 
-				_context = Context{base::IPAddressType::IPV4};
-				for (int32_t i = 0; i < 4; i++)
-				{
-					std::string str_to_be_converted = sub_string_list[i].StdString();
-					_context.Span()[i] = std::stoi(str_to_be_converted);
-				}
+		/* #endregion */
 
-				// 字符串是大端序表示的，所以要翻转。
-				_context.Span().Reverse();
-			}
-			else if (ip_str.Contains(':'))
-			{
-				// 是 IPV6 地址
-				base::List<base::String> sub_string_list = ip_str.Split(':', split_options);
-				if (sub_string_list.Count() != 8)
-				{
-					throw std::invalid_argument{"非法的 IPV6 地址字符串。"};
-				}
+		/* #region 解析和格式化 */
 
-				_context = Context{base::IPAddressType::IPV6};
+		///
+		/// @brief 格式化后的字符串的最大长度。
+		///
+		/// @note IPV6 的 8 组 4 位 16 进制数加上 7 个冒号。
+		///
+		static constexpr int64_t MaxStringLength = 39;
 
-				/**
-				 * IPV6 地址类似：2001:0db8:85a3:0000:0000:8a2e:0370:7334
-				 * 是是用冒号分隔的 8 个 16 进制数。每个 16 进制数都是 uint16_t 可以装下的。
-				 */
-				uint16_t *ipv6_element_buffer = reinterpret_cast<uint16_t *>(_context.Span().Buffer());
+		///
+		/// @brief 解析 IP 地址字符串。不分配内存，不抛出异常。
+		///
+		/// @note 会根据字符串格式来识别是 IPV4 地址还是 IPV6 地址。
+		/// @note 支持 IPV6 的 :: 缩写和末尾嵌入的 IPV4 地址，例如 ::ffff:1.2.3.4.
+		/// @note 与 inet_pton 相同，IPV4 地址中有前导 0 的多位数，例如 01.2.3.4, 是非法的，
+		/// 因为会与 8 进制混淆。
+		///
+		/// @param text 不能有首尾空白字符。
+		/// @param result 解析成功时写入此对象，失败时不修改。
+		///
+		/// @return 成功返回 true, 格式错误返回 false.
+		///
+		static bool TryParse(base::StringView const &text, base::IPAddress &result);
 
-				for (int32_t i = 0; i < 8; i++)
-				{
-					std::string str_to_be_converted = sub_string_list[i].StdString();
-					ipv6_element_buffer[i] = std::stoi(str_to_be_converted, nullptr, 16);
-					if (std::endian::native == std::endian::little)
-					{
-						/**
-						 * 如果本机是小端序，字符串转换成的数字是小端序的。
-						 * 局部翻转成大端序，这样最后整个 _span 内的每个字节都是大端序。然后一起翻转一次，整个
-						 * _span 就是小端序的了。
-						 */
-						std::reverse(&_context.Span()[i * 2], &_context.Span()[i * 2] + sizeof(uint16_t));
-					}
-				}
+		///
+		/// @brief 解析 IP 地址字符串。
+		///
+		/// @param text
+		///
+		/// @return
+		///
+		/// @exception std::invalid_argument 格式错误时抛出。
+		///
+		static base::IPAddress Parse(base::StringView const &text);
 
-				// 字符串是大端序表示的，所以要翻转。
-				_context.Span().Reverse();
-			}
-			else
-			{
-				throw std::invalid_argument{"必须是点分 10 进制的 IPV4 地址或冒号分 16 进制的 IPV6 地址"};
-			}
-		}
+		///
+		/// @brief 格式化到 buffer 中。不分配内存。
+		///
+		/// @note IPV6 地址按照 RFC 5952 格式化：小写，省略前导 0, 最长的连续 0 组缩写为 ::.
+		/// IPV4 映射地址的最后 32 位写成点分 10 进制，例如 ::ffff:1.2.3.4, 与 inet_ntop 相同。
+		///
+		/// @param buffer 大小至少为 MaxStringLength 时一定装得下。
+		///
+		/// @return 写入的字符数。不写入结尾的空字符。
+		///
+		/// @exception std::invalid_argument buffer 装不下时抛出。
+		///
+		int64_t Format(base::Span const &buffer) const;
 
 		/* #endregion */
 
@@ -322,45 +320,22 @@ namespace base
 		///
 		std::string ToString() const override
 		{
-			std::string ret;
-
-			base::ToHexStringOptions option;
-			option.width = 2;
-			option.with_0x_prefix = false;
-
-			if (_context.IPAddressType() == base::IPAddressType::IPV4)
-			{
-				bool first_loop = true;
-				for (uint8_t num : _context.Span())
-				{
-					if (first_loop)
-					{
-						first_loop = false;
-					}
-					else
-					{
-						ret = '.' + ret;
-					}
-
-					ret = std::to_string(num) + ret;
-				}
-			}
-			else
-			{
-				int loop_times = 0;
-				for (uint8_t num : _context.Span())
-				{
-					if (loop_times > 0 && loop_times % 2 == 0)
-					{
-						ret = ':' + ret;
-					}
-
-					ret = base::ToHexString(num, option) + ret;
-					loop_times++;
-				}
-			}
+			char buffer[MaxStringLength];
+			int64_t length = Format(base::Span{reinterpret_cast<uint8_t *>(buffer), MaxStringLength});
+			return std::string{buffer, static_cast<size_t>(length)};
+		}
 
-			return ret;
+		///
+		/// @brief 类型和每个字节都相同则相等。
+		///
+		/// @param another
+		///
+		/// @return
+		///
+		bool operator==(base::IPAddress const &another) const
+		{
+			return _context.IPAddressType() == another._context.IPAddressType() &&
+				   _context.Span() == another._context.Span();
 		}
 
 		///
@@ -385,3 +360,12 @@ namespace base
 	};
 
 } // namespace base
+
+///
+/// @brief 让 base::IPAddress 可以作为 std::unordered_map 等容器的键。
+///
+template <>
+struct std::hash<base::IPAddress>
+{
+	size_t operator()(base::IPAddress const &value) const noexcept;
+};
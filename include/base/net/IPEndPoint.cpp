@@ -1 +1,9 @@
 #include "IPEndPoint.h" // IWYU pragma: keep
+
+size_t std::hash<base::IPEndPoint>::operator()(base::IPEndPoint const &value) const noexcept
+{
+	size_t ip_hash = std::hash<base::IPAddress>{}(value.IPAddress());
+
+	// IP 地址的哈希值已经充分混合，再按 boost::hash_combine 的方式合入端口号。
+	return ip_hash ^ (static_cast<size_t>(value.Port()) + static_cast<size_t>(0x9e3779b97f4a7c15) + (ip_hash << 6) + (ip_hash >> 2));
+}
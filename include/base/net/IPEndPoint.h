@@ -1,6 +1,8 @@
 #pragma once
 #include "base/net/IEndPoint.h"
 #include "base/net/IPAddress.h"
+#include <cstdint>
+#include <functional>
 
 namespace base
 {
@@ -82,6 +84,27 @@ namespace base
 				{"port", _port},
 			};
 		}
+
+		///
+		/// @brief IP 地址和端口号都相同则相等。
+		///
+		/// @param another
+		///
+		/// @return
+		///
+		bool operator==(base::IPEndPoint const &another) const
+		{
+			return _port == another._port && _ip_address == another._ip_address;
+		}
 	};
 
 } // namespace base
+
+///
+/// @brief 让 base::IPEndPoint 可以作为 std::unordered_map 等容器的键。
+///
+template <>
+struct std::hash<base::IPEndPoint>
+{
+	size_t operator()(base::IPEndPoint const &value) const noexcept;
+};
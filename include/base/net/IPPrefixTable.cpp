@@ -0,0 +1 @@
+#include "IPPrefixTable.h" // IWYU pragma: keep
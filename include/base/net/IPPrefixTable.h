@@ -0,0 +1,337 @@
+#pragma once
+#include "base/bit/AutoBitConverter.h"
+#include "base/net/IPAddress.h"
+#include "base/string/define.h"
+#include "base/string/StringView.h"
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace base
+{
+	///
+	/// @brief IP 前缀表。按最长前缀匹配查找 IP 地址所属的网段，例如路由表、访问控制列表。
+	///
+	/// @note 内部是路径压缩的二叉前缀树。只有分叉处才有节点，所以查找的步数是路径上
+	/// 分叉的个数，而不是前缀的位数。节点存放在一个 std::vector 中，用下标互相引用。
+	///
+	/// @note IPV4 和 IPV6 各有一棵树，互不匹配。
+	///
+	/// @note 查找不分配内存，不抛出异常。
+	///
+	template <typename ValueType>
+	class IPPrefixTable
+	{
+	private:
+		///
+		/// @brief 128 位的键。最高位是地址的第一位。IPV4 地址放在 _high 的高 32 位。
+		///
+		struct Key
+		{
+			uint64_t _high = 0;
+			uint64_t _low = 0;
+		};
+
+		struct Node
+		{
+			///
+			/// @brief 本节点的前缀。_length 之后的位都是 0.
+			///
+			Key _key{};
+
+			int32_t _length = 0;
+
+			int32_t _children[2] = {-1, -1};
+
+			///
+			/// @brief 在 _values 中的下标。本节点只是分叉点，没有对应的网段时为 -1.
+			///
+			int32_t _value_index = -1;
+		};
+
+		std::vector<Node> _nodes;
+		std::vector<ValueType> _values;
+
+		static constexpr int32_t _ipv4_root = 0;
+		static constexpr int32_t _ipv6_root = 1;
+
+		static Key ToKey(base::IPAddress const &address)
+		{
+			// IPAddress 内部按小端序存放。
+			base::ReadOnlySpan bytes = address.Span();
+			if (address.Type() == base::IPAddressType::IPV4)
+			{
+				uint64_t value = base::little_endian_remote_converter.FromBytes<uint32_t>(bytes);
+				return Key{value << 32, 0};
+			}
+
+			return Key{
+				base::little_endian_remote_converter.FromBytes<uint64_t>(bytes.Slice(8, 8)),
+				base::little_endian_remote_converter.FromBytes<uint64_t>(bytes.Slice(0, 8)),
+			};
+		}
+
+		///
+		/// @brief 只保留前 length 位。
+		///
+		static Key Mask(Key const &key, int32_t length)
+		{
+			if (length == 0)
+			{
+				return Key{};
+			}
+
+			if (length <= 64)
+			{
+				return Key{key._high & (~uint64_t{0} << (64 - length)), 0};
+			}
+
+			if (length == 128)
+			{
+				return key;
+			}
+
+			return Key{key._high, key._low & (~uint64_t{0} << (128 - length))};
+		}
+
+		///
+		/// @brief 第 index 位。第 0 位是最高位。
+		///
+		static int32_t Bit(Key const &key, int32_t index)
+		{
+			if (index < 64)
+			{
+				return static_cast<int32_t>((key._high >> (63 - index)) & 1);
+			}
+
+			return static_cast<int32_t>((key._low >> (127 - index)) & 1);
+		}
+
+		///
+		/// @brief 两个键从最高位开始相同的位数。
+		///
+		static int32_t CommonLength(Key const &a, Key const &b)
+		{
+			uint64_t high = a._high ^ b._high;
+			if (high != 0)
+			{
+				return std::countl_zero(high);
+			}
+
+			uint64_t low = a._low ^ b._low;
+			if (low != 0)
+			{
+				return 64 + std::countl_zero(low);
+			}
+
+			return 128;
+		}
+
+		static bool Equals(Key const &a, Key const &b)
+		{
+			return a._high == b._high && a._low == b._low;
+		}
+
+		int32_t NewNode(Key const &key, int32_t length)
+		{
+			Node node{};
+			node._key = key;
+			node._length = length;
+			_nodes.push_back(node);
+			return static_cast<int32_t>(_nodes.size() - 1);
+		}
+
+		///
+		/// @brief 新建一个带值的节点。
+		///
+		int32_t NewNode(Key const &key, int32_t length, ValueType const &value)
+		{
+			int32_t index = NewNode(key, length);
+			_values.push_back(value);
+			_nodes[index]._value_index = static_cast<int32_t>(_values.size() - 1);
+			return index;
+		}
+
+	public:
+		IPPrefixTable()
+		{
+			NewNode(Key{}, 0);
+			NewNode(Key{}, 0);
+		}
+
+		///
+		/// @brief 网段的个数。
+		///
+		/// @return
+		///
+		int64_t Count() const
+		{
+			return static_cast<int64_t>(_values.size());
+		}
+
+		///
+		/// @brief 添加一个网段。
+		///
+		/// @param prefix 网段的地址。前缀长度之后的位会被忽略。
+		/// @param prefix_length 前缀长度。IPV4 不能超过 32, IPV6 不能超过 128.
+		/// @param value
+		///
+		/// @exception std::invalid_argument 前缀长度超出范围或网段已经存在时抛出。
+		///
+		void Add(base::IPAddress const &prefix, int32_t prefix_length, ValueType const &value)
+		{
+			int32_t max_length = prefix.Type() == base::IPAddressType::IPV4 ? 32 : 128;
+			if (prefix_length < 0 || prefix_length > max_length)
+			{
+				throw std::invalid_argument{CODE_POS_STR + "前缀长度 " + std::to_string(prefix_length) + " 超出范围。"};
+			}
+
+			Key key = Mask(ToKey(prefix), prefix_length);
+			int32_t node_index = prefix.Type() == base::IPAddressType::IPV4 ? _ipv4_root : _ipv6_root;
+
+			// 循环不变量：node_index 的前缀是 key 的前缀，并且不长于 prefix_length.
+			while (true)
+			{
+				if (_nodes[node_index]._length == prefix_length)
+				{
+					if (_nodes[node_index]._value_index >= 0)
+					{
+						throw std::invalid_argument{CODE_POS_STR + "网段 " + prefix.ToString() + "/" +
+													std::to_string(prefix_length) + " 已经存在。"};
+					}
+
+					_values.push_back(value);
+					_nodes[node_index]._value_index = static_cast<int32_t>(_values.size() - 1);
+					return;
+				}
+
+				int32_t bit = Bit(key, _nodes[node_index]._length);
+				int32_t child_index = _nodes[node_index]._children[bit];
+				if (child_index < 0)
+				{
+					int32_t leaf_index = NewNode(key, prefix_length, value);
+					_nodes[node_index]._children[bit] = leaf_index;
+					return;
+				}
+
+				Node const &child = _nodes[child_index];
+				int32_t common_length = std::min(CommonLength(child._key, key), std::min(child._length, prefix_length));
+				if (common_length == child._length)
+				{
+					node_index = child_index;
+					continue;
+				}
+
+				// 在 child 之前分叉，插入一个前缀长度为 common_length 的节点。
+				Key child_key = child._key;
+				int32_t fork_index = -1;
+				if (common_length == prefix_length)
+				{
+					fork_index = NewNode(key, prefix_length, value);
+				}
+				else
+				{
+					fork_index = NewNode(Mask(key, common_length), common_length);
+					int32_t leaf_index = NewNode(key, prefix_length, value);
+					_nodes[fork_index]._children[Bit(key, common_length)] = leaf_index;
+				}
+
+				_nodes[fork_index]._children[Bit(child_key, common_length)] = child_index;
+				_nodes[node_index]._children[bit] = fork_index;
+				return;
+			}
+		}
+
+		///
+		/// @brief 添加一个 CIDR 表示的网段，例如 192.168.0.0/16, fe80::/10.
+		///
+		/// @param cidr
+		/// @param value
+		///
+		/// @exception std::invalid_argument 格式错误或网段已经存在时抛出。
+		///
+		void Add(base::StringView const &cidr, ValueType const &value)
+		{
+			std::string_view text = cidr.StdStringView();
+			size_t slash = text.find('/');
+			if (slash == std::string_view::npos || slash + 1 == text.size() || text.size() - slash > 4)
+			{
+				throw std::invalid_argument{CODE_POS_STR + "非法的 CIDR 字符串：" + std::string{text}};
+			}
+
+			int32_t prefix_length = 0;
+			for (size_t i = slash + 1; i < text.size(); i++)
+			{
+				if (text[i] < '0' || text[i] > '9')
+				{
+					throw std::invalid_argument{CODE_POS_STR + "非法的 CIDR 字符串：" + std::string{text}};
+				}
+
+				prefix_length = prefix_length * 10 + (text[i] - '0');
+			}
+
+			base::IPAddress prefix = base::IPAddress::Parse(base::StringView{text.data(), static_cast<int64_t>(slash)});
+			Add(prefix, prefix_length, value);
+		}
+
+		///
+		/// @brief 查找包含 address 的最长的网段。
+		///
+		/// @param address
+		///
+		/// @return 找到了返回指向网段对应的值的指针，没找到返回空指针。
+		/// 指针在下一次 Add 之前有效。
+		///
+		ValueType const *Match(base::IPAddress const &address) const
+		{
+			Key key = ToKey(address);
+			int32_t max_length = address.Type() == base::IPAddressType::IPV4 ? 32 : 128;
+			int32_t node_index = address.Type() == base::IPAddressType::IPV4 ? _ipv4_root : _ipv6_root;
+			int32_t best_value_index = -1;
+
+			while (node_index >= 0)
+			{
+				Node const &node = _nodes[node_index];
+				if (!Equals(Mask(key, node._length), node._key))
+				{
+					break;
+				}
+
+				if (node._value_index >= 0)
+				{
+					best_value_index = node._value_index;
+				}
+
+				if (node._length == max_length)
+				{
+					break;
+				}
+
+				node_index = node._children[Bit(key, node._length)];
+			}
+
+			if (best_value_index < 0)
+			{
+				return nullptr;
+			}
+
+			return &_values[best_value_index];
+		}
+
+		///
+		/// @brief 删除所有网段。
+		///
+		void Clear()
+		{
+			_nodes.resize(2);
+			_nodes[_ipv4_root] = Node{};
+			_nodes[_ipv6_root] = Node{};
+			_values.clear();
+		}
+	};
+
+} // namespace base
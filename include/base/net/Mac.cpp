@@ -1 +1,18 @@
 #include "Mac.h" // IWYU pragma: keep
+
+size_t std::hash<base::Mac>::operator()(base::Mac const &value) const noexcept
+{
+	uint64_t key = 0;
+	for (int i = 5; i >= 0; i--)
+	{
+		key = (key << 8) | value[i];
+	}
+
+	// murmur3 的 64 位终结函数。同一厂商的 MAC 高 3 字节相同，要让低位的差异扩散到所有位。
+	key ^= key >> 33;
+	key *= 0xff51afd7ed558ccd;
+	key ^= key >> 33;
+	key *= 0xc4ceb9fe1a85ec53;
+	key ^= key >> 33;
+	return static_cast<size_t>(key);
+}
@@ -5,9 +5,10 @@
 #include "base/stream/Span.h"
 #include "base/string/define.h"
 #include "base/string/ICanToString.h"
-#include "base/string/ToHexString.h"
+#include "base/string/encoding/hex.h"
 #include <bit>
 #include <cstdint>
+#include <functional>
 
 namespace base
 {
@@ -131,27 +132,16 @@ namespace base
 		///
 		std::string ToString() const override
 		{
-			std::string ret{};
-			bool first_loop = true;
-
-			base::ToHexStringOptions option{};
-			option.with_0x_prefix = false;
-			option.width = 2;
-
-			for (uint8_t value : _mac_buffer)
+			// 缓冲区中的字节顺序与书写顺序相反。
+			uint8_t bytes[6]{};
+			for (int i = 0; i < 6; i++)
 			{
-				if (first_loop)
-				{
-					first_loop = false;
-					ret = base::ToHexString(value, option);
-				}
-				else
-				{
-					ret = base::ToHexString(value, option) + '-' + ret;
-				}
+				bytes[i] = _mac_buffer[5 - i];
 			}
 
-			return ret;
+			base::string::encoding::hex_encode_options options{};
+			options.separator = '-';
+			return base::string::encoding::hex_encode(base::ReadOnlySpan{bytes, 6}, options);
 		}
 
 		///
@@ -228,6 +218,27 @@ namespace base
 			// 最高字节的最低位为 1 则是多播地址，为 0 则是单播地址。
 			return _mac_buffer[5] & 0x01;
 		}
+
+		///
+		/// @brief 每个字节都相同则相等。
+		///
+		/// @param another
+		///
+		/// @return
+		///
+		bool operator==(base::Mac const &another) const
+		{
+			return Span() == another.Span();
+		}
 	};
 
 } // namespace base
+
+///
+/// @brief 让 base::Mac 可以作为 std::unordered_map 等容器的键。
+///
+template <>
+struct std::hash<base::Mac>
+{
+	size_t operator()(base::Mac const &value) const noexcept;
+};
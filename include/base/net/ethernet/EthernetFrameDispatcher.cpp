@@ -0,0 +1,144 @@
+#include "EthernetFrameDispatcher.h"
+#include "base/string/define.h"
+#include "base/string/ToHexString.h"
+#include <stdexcept>
+#include <string>
+
+void base::ethernet::EthernetFrameDispatcher::AddTypeHandler(base::ethernet::LengthOrTypeEnum type_or_length,
+															 Handler const &handler)
+{
+	for (TypeRoute const &route : _type_routes)
+	{
+		if (route._type_or_length == static_cast<uint16_t>(type_or_length))
+		{
+			throw std::invalid_argument{CODE_POS_STR + "类型 " + base::to_string(type_or_length) + " 已经有处理函数。"};
+		}
+	}
+
+	_type_routes.push_back(TypeRoute{static_cast<uint16_t>(type_or_length), handler});
+}
+
+void base::ethernet::EthernetFrameDispatcher::AddVlanHandler(uint16_t vlan_id, Handler const &handler)
+{
+	if (vlan_id > 0x0fff)
+	{
+		throw std::invalid_argument{CODE_POS_STR + "VLAN ID 只有 12 位。"};
+	}
+
+	for (VlanRoute const &route : _vlan_routes)
+	{
+		if (route._vlan_id == vlan_id)
+		{
+			throw std::invalid_argument{CODE_POS_STR + "VLAN ID " + std::to_string(vlan_id) + " 已经有处理函数。"};
+		}
+	}
+
+	_vlan_routes.push_back(VlanRoute{vlan_id, handler});
+}
+
+void base::ethernet::EthernetFrameDispatcher::AddProfinetHandler(uint16_t first, uint16_t last, Handler const &handler)
+{
+	if (first > last)
+	{
+		throw std::invalid_argument{CODE_POS_STR + "帧 ID 的范围为空。"};
+	}
+
+	for (FrameIdRoute const &route : _frame_id_routes)
+	{
+		if (first <= route._last && route._first <= last)
+		{
+			throw std::invalid_argument{CODE_POS_STR + "帧 ID 的范围与已有的 [" + base::ToHexString(route._first) +
+										", " + base::ToHexString(route._last) + "] 重叠。"};
+		}
+	}
+
+	_frame_id_routes.push_back(FrameIdRoute{first, last, handler});
+}
+
+void base::ethernet::EthernetFrameDispatcher::SetDefaultHandler(Handler const &handler)
+{
+	_default_handler = handler;
+}
+
+base::ethernet::EthernetFrameDispatcher::Handler const *base::ethernet::EthernetFrameDispatcher::Route(base::ethernet::EthernetFrameInfo const &info) const
+{
+	// 路由一般只有几条，顺序查找就够了。
+	if (info.HasProfinetFrameId())
+	{
+		uint16_t frame_id = info.ProfinetFrameId();
+		for (FrameIdRoute const &route : _frame_id_routes)
+		{
+			if (frame_id >= route._first && frame_id <= route._last)
+			{
+				return &route._handler;
+			}
+		}
+	}
+
+	if (info.HasVlanTag())
+	{
+		uint16_t vlan_id = info.VlanId();
+		for (VlanRoute const &route : _vlan_routes)
+		{
+			if (route._vlan_id == vlan_id)
+			{
+				return &route._handler;
+			}
+		}
+	}
+
+	uint16_t type_or_length = static_cast<uint16_t>(info.TypeOrLength());
+	for (TypeRoute const &route : _type_routes)
+	{
+		if (route._type_or_length == type_or_length)
+		{
+			return &route._handler;
+		}
+	}
+
+	if (_default_handler)
+	{
+		return &_default_handler;
+	}
+
+	return nullptr;
+}
+
+void base::ethernet::EthernetFrameDispatcher::DispatchClassified(base::ethernet::EthernetFrameInfo const &info)
+{
+	if (!info.IsValid())
+	{
+		_malformed_count++;
+		return;
+	}
+
+	Handler const *handler = Route(info);
+	if (handler == nullptr)
+	{
+		_unhandled_count++;
+		return;
+	}
+
+	_dispatched_count++;
+	(*handler)(info);
+}
+
+void base::ethernet::EthernetFrameDispatcher::Dispatch(base::ReadOnlySpan const &frame)
+{
+	DispatchClassified(base::ethernet::EthernetFrameInfo::Classify(frame));
+}
+
+void base::ethernet::EthernetFrameDispatcher::Dispatch(std::vector<base::ReadOnlySpan> const &frames)
+{
+	// 容量只增不减，稳定后不再分配内存。
+	_batch.clear();
+	for (base::ReadOnlySpan const &frame : frames)
+	{
+		_batch.push_back(base::ethernet::EthernetFrameInfo::Classify(frame));
+	}
+
+	for (base::ethernet::EthernetFrameInfo const &info : _batch)
+	{
+		DispatchClassified(info);
+	}
+}
@@ -0,0 +1,148 @@
+#pragma once
+#include "base/net/ethernet/EthernetFrameInfo.h"
+#include "base/net/ethernet/LengthOrTypeEnum.h"
+#include "base/stream/ReadOnlySpan.h"
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace base::ethernet
+{
+	///
+	/// @brief 以太网帧分发器。把收到的帧按类型、VLAN 和 PROFINET 帧 ID 分发给注册的处理函数。
+	///
+	/// @note 按以下顺序匹配，使用第一个匹配上的处理函数：
+	/// 	@li PROFINET 帧 ID 所在的范围。
+	/// 	@li VLAN ID.
+	/// 	@li 类型。
+	/// 	@li 默认处理函数。
+	///
+	/// @note 处理函数在开始接收之前注册。分发时不分配内存，不抛出异常（处理函数自己抛出的除外）。
+	/// 过短的帧和没有处理函数的帧只计数，然后丢弃。
+	///
+	class EthernetFrameDispatcher
+	{
+	public:
+		using Handler = std::function<void(base::ethernet::EthernetFrameInfo const &info)>;
+
+	private:
+		struct TypeRoute
+		{
+			uint16_t _type_or_length = 0;
+			Handler _handler;
+		};
+
+		struct VlanRoute
+		{
+			uint16_t _vlan_id = 0;
+			Handler _handler;
+		};
+
+		struct FrameIdRoute
+		{
+			uint16_t _first = 0;
+			uint16_t _last = 0;
+			Handler _handler;
+		};
+
+		std::vector<TypeRoute> _type_routes;
+		std::vector<VlanRoute> _vlan_routes;
+		std::vector<FrameIdRoute> _frame_id_routes;
+		Handler _default_handler;
+
+		///
+		/// @brief 批量分发时复用的分类结果。
+		///
+		std::vector<base::ethernet::EthernetFrameInfo> _batch;
+
+		int64_t _dispatched_count = 0;
+		int64_t _unhandled_count = 0;
+		int64_t _malformed_count = 0;
+
+		Handler const *Route(base::ethernet::EthernetFrameInfo const &info) const;
+
+		void DispatchClassified(base::ethernet::EthernetFrameInfo const &info);
+
+	public:
+		///
+		/// @brief 注册某个类型的帧的处理函数。
+		///
+		/// @param type_or_length
+		/// @param handler
+		///
+		void AddTypeHandler(base::ethernet::LengthOrTypeEnum type_or_length, Handler const &handler);
+
+		///
+		/// @brief 注册带有某个 VLAN ID 的帧的处理函数。
+		///
+		/// @param vlan_id
+		/// @param handler
+		///
+		void AddVlanHandler(uint16_t vlan_id, Handler const &handler);
+
+		///
+		/// @brief 注册 PROFINET 帧 ID 在 [first, last] 范围内的帧的处理函数。
+		///
+		/// @note 例如 RT_CLASS_1 的循环帧是 [0x8000, 0xbfff], DCP 是 [0xfefc, 0xfeff].
+		///
+		/// @param first
+		/// @param last
+		/// @param handler
+		///
+		void AddProfinetHandler(uint16_t first, uint16_t last, Handler const &handler);
+
+		///
+		/// @brief 设置没有其他处理函数匹配时使用的处理函数。
+		///
+		/// @param handler
+		///
+		void SetDefaultHandler(Handler const &handler);
+
+		///
+		/// @brief 分发一个帧。
+		///
+		/// @param frame 整个以太网帧。
+		///
+		void Dispatch(base::ReadOnlySpan const &frame);
+
+		///
+		/// @brief 批量分发。
+		///
+		/// @note 先在一趟循环中分类所有的帧，再逐个交给处理函数。适合网卡驱动一次收到多个帧的情况。
+		///
+		/// @param frames
+		///
+		void Dispatch(std::vector<base::ReadOnlySpan> const &frames);
+
+		///
+		/// @brief 交给了处理函数的帧数。
+		///
+		/// @return
+		///
+		int64_t DispatchedCount() const
+		{
+			return _dispatched_count;
+		}
+
+		///
+		/// @brief 没有处理函数而丢弃的帧数。
+		///
+		/// @return
+		///
+		int64_t UnhandledCount() const
+		{
+			return _unhandled_count;
+		}
+
+		///
+		/// @brief 过短而丢弃的帧数。
+		///
+		/// @return
+		///
+		int64_t MalformedCount() const
+		{
+			return _malformed_count;
+		}
+	};
+
+} // namespace base::ethernet
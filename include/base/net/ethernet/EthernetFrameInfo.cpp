@@ -0,0 +1,51 @@
+#include "EthernetFrameInfo.h"
+
+namespace
+{
+	uint16_t ReadUInt16(uint8_t const *p)
+	{
+		return static_cast<uint16_t>((p[0] << 8) | p[1]);
+	}
+
+} // namespace
+
+base::ethernet::EthernetFrameInfo base::ethernet::EthernetFrameInfo::Classify(base::ReadOnlySpan const &frame) noexcept
+{
+	base::ethernet::EthernetFrameInfo info{};
+	info._frame = frame;
+
+	if (frame.Size() < 14)
+	{
+		return info;
+	}
+
+	uint8_t const *buffer = frame.Buffer();
+	uint16_t type_or_length = ReadUInt16(buffer + 12);
+	int32_t payload_offset = 14;
+
+	if (type_or_length == static_cast<uint16_t>(base::ethernet::LengthOrTypeEnum::VlanTag))
+	{
+		if (frame.Size() < 18)
+		{
+			return info;
+		}
+
+		info._has_vlan_tag = true;
+		info._vlan_tci = ReadUInt16(buffer + 14);
+		type_or_length = ReadUInt16(buffer + 16);
+		payload_offset = 18;
+	}
+
+	info._is_valid = true;
+	info._type_or_length = type_or_length;
+	info._payload_offset = payload_offset;
+
+	if (type_or_length == static_cast<uint16_t>(base::ethernet::LengthOrTypeEnum::Profinet) &&
+		frame.Size() >= payload_offset + 2)
+	{
+		info._has_profinet_frame_id = true;
+		info._profinet_frame_id = ReadUInt16(buffer + payload_offset);
+	}
+
+	return info;
+}
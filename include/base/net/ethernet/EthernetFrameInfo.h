@@ -0,0 +1,159 @@
+#pragma once
+#include "base/net/ethernet/LengthOrTypeEnum.h"
+#include "base/stream/ReadOnlySpan.h"
+#include <cstdint>
+
+namespace base::ethernet
+{
+	///
+	/// @brief 以太网帧的分类结果。
+	///
+	/// @note 由 Classify 一次解析出类型、VLAN 标签和 PROFINET 帧 ID 的位置，之后的访问器只是
+	/// 读取字段，不再检查，不抛出异常。MAC 地址以视图的形式提供，不复制。
+	///
+	/// @note 与 EthernetFrameReader 不同，不要求帧至少有 60 字节，能容纳以太网头就是合法的。
+	///
+	class EthernetFrameInfo
+	{
+	private:
+		base::ReadOnlySpan _frame{};
+		bool _is_valid = false;
+		bool _has_vlan_tag = false;
+		bool _has_profinet_frame_id = false;
+		uint16_t _vlan_tci = 0;
+		uint16_t _type_or_length = 0;
+		uint16_t _profinet_frame_id = 0;
+		int32_t _payload_offset = 0;
+
+	public:
+		///
+		/// @brief 解析以太网头。
+		///
+		/// @param frame 整个以太网帧。
+		///
+		/// @return 帧过短，装不下以太网头时 IsValid 为 false.
+		///
+		static base::ethernet::EthernetFrameInfo Classify(base::ReadOnlySpan const &frame) noexcept;
+
+		///
+		/// @brief 整个以太网帧。
+		///
+		/// @return
+		///
+		base::ReadOnlySpan const &Frame() const
+		{
+			return _frame;
+		}
+
+		///
+		/// @brief 是否装得下以太网头。为 false 时除了 Frame 以外的访问器都没有意义。
+		///
+		/// @return
+		///
+		bool IsValid() const
+		{
+			return _is_valid;
+		}
+
+		///
+		/// @brief 目的 MAC 地址。大端序的 6 个字节。
+		///
+		/// @return
+		///
+		base::ReadOnlySpan DestinationMac() const
+		{
+			return base::ReadOnlySpan{_frame.Buffer(), 6};
+		}
+
+		///
+		/// @brief 源 MAC 地址。大端序的 6 个字节。
+		///
+		/// @return
+		///
+		base::ReadOnlySpan SourceMac() const
+		{
+			return base::ReadOnlySpan{_frame.Buffer() + 6, 6};
+		}
+
+		///
+		/// @brief 是否具有 802.1Q 标签。
+		///
+		/// @return
+		///
+		bool HasVlanTag() const
+		{
+			return _has_vlan_tag;
+		}
+
+		///
+		/// @brief 802.1Q 标签的标签控制信息。没有标签时为 0.
+		///
+		/// @return
+		///
+		uint16_t VlanTci() const
+		{
+			return _vlan_tci;
+		}
+
+		///
+		/// @brief VLAN ID. 没有标签时为 0.
+		///
+		/// @return
+		///
+		uint16_t VlanId() const
+		{
+			return _vlan_tci & 0x0fff;
+		}
+
+		///
+		/// @brief 优先级。没有标签时为 0.
+		///
+		/// @return
+		///
+		uint8_t Priority() const
+		{
+			return static_cast<uint8_t>(_vlan_tci >> 13);
+		}
+
+		///
+		/// @brief 类型或长度。有 VLAN 标签时是标签后面的类型。
+		///
+		/// @return
+		///
+		base::ethernet::LengthOrTypeEnum TypeOrLength() const
+		{
+			return static_cast<base::ethernet::LengthOrTypeEnum>(_type_or_length);
+		}
+
+		///
+		/// @brief 载荷。
+		///
+		/// @return
+		///
+		base::ReadOnlySpan Payload() const
+		{
+			return base::ReadOnlySpan{_frame.Buffer() + _payload_offset, _frame.Size() - _payload_offset};
+		}
+
+		///
+		/// @brief 是否是带有帧 ID 的 PROFINET 帧。
+		///
+		/// @return
+		///
+		bool HasProfinetFrameId() const
+		{
+			return _has_profinet_frame_id;
+		}
+
+		///
+		/// @brief PROFINET 帧 ID. 不是 PROFINET 帧时为 0.
+		///
+		/// @return
+		///
+		uint16_t ProfinetFrameId() const
+		{
+			return _profinet_frame_id;
+		}
+	};
+
+} // namespace base::ethernet
@@ -7,6 +7,8 @@
 #include "base/stream/ReadOnlySpan.h"
 #include "base/stream/Span.h"
 #include "base/string/define.h"
+#include "base/string/encoding/hex.h"
+#include "base/string/IJsonWriter.h"
 #include "base/string/Json.h"
 #include <cstdint>
 #include <stdexcept>
@@ -21,8 +23,21 @@ namespace base::ethernet
 	{
 	private:
 		base::ReadOnlySpan _span;
+
+		///
+		/// @brief 构造时检查一次，各个访问器不再重复解析类型字段。
+		///
+		bool _has_vlan_tag = false;
+
 		base::PayloadReader _payload_reader;
 
+		static bool ReadHasVlanTag(base::ReadOnlySpan const &span)
+		{
+			uint16_t u16_type_or_length = base::big_endian_remote_converter.FromBytes<uint16_t>(span[base::Range{12, 14}]);
+			base::ethernet::LengthOrTypeEnum type_or_length = static_cast<base::ethernet::LengthOrTypeEnum>(u16_type_or_length);
+			return type_or_length == base::ethernet::LengthOrTypeEnum::VlanTag;
+		}
+
 		///
 		/// @brief 载荷数据。
 		///
@@ -51,6 +66,7 @@ namespace base::ethernet
 		///
 		EthernetFrameReader(base::ReadOnlySpan const &span)
 			: _span{span},
+			  _has_vlan_tag{ReadHasVlanTag(span)},
 			  _payload_reader{Payload()}
 		{
 			if (span.Size() < 60)
@@ -96,9 +112,7 @@ namespace base::ethernet
 		///
 		bool HasVlanTag() const
 		{
-			uint16_t u16_type_or_length = base::big_endian_remote_converter.FromBytes<uint16_t>(_span[base::Range{12, 14}]);
-			base::ethernet::LengthOrTypeEnum type_or_length = static_cast<base::ethernet::LengthOrTypeEnum>(u16_type_or_length);
-			return type_or_length == base::ethernet::LengthOrTypeEnum::VlanTag;
+			return _has_vlan_tag;
 		}
 
 		///
@@ -173,15 +187,46 @@ namespace base::ethernet
 		///
 		base::Json ToJson() const override
 		{
+			// 载荷每 16 个字节一行，字节之间用空格分隔。
+			base::string::encoding::hex_encode_options payload_options{};
+			payload_options.separator = ' ';
+			payload_options.bytes_per_line = 16;
+
 			base::Json root{
 				{"目的 MAC 地址", DestinationMac().ToString()},
 				{"源 MAC 地址", SourceMac().ToString()},
 				{"TypeOrLength", base::to_string(TypeOrLength())},
 				{"是否具有 VlangTag", HasVlanTag()},
+				{"载荷", base::string::encoding::hex_encode(Payload(), payload_options)},
 			};
 
 			return root;
 		}
+
+		///
+		/// @brief 不构造 json 对象，直接写入 writer.
+		///
+		/// @note 字段与 ToJson 相同。高频抓包时用它写出 json 或 CBOR 快照。
+		///
+		/// @note 按 base::Json 的键顺序，即 UTF-8 字节序写入，所以写出的 json 与
+		/// ToJson().dump() 逐字节相同。增加字段时要插入到排序后的位置。
+		///
+		/// @param writer
+		///
+		virtual void WriteJson(base::IJsonWriter &writer) const override
+		{
+			base::string::encoding::hex_encode_options payload_options{};
+			payload_options.separator = ' ';
+			payload_options.bytes_per_line = 16;
+
+			writer.StartObject();
+			writer.Property("TypeOrLength", base::to_string(TypeOrLength()));
+			writer.Property("是否具有 VlangTag", HasVlanTag());
+			writer.Property("源 MAC 地址", SourceMac().ToString());
+			writer.Property("目的 MAC 地址", DestinationMac().ToString());
+			writer.Property("载荷", base::string::encoding::hex_encode(Payload(), payload_options));
+			writer.EndObject();
+		}
 	};
 
 } // namespace base::ethernet
@@ -0,0 +1 @@
+#include "PcapFormat.h" // IWYU pragma: keep
@@ -0,0 +1,21 @@
+#pragma once
+
+namespace base::pcap
+{
+	///
+	/// @brief 抓包文件的格式。
+	///
+	enum class PcapFormat
+	{
+		///
+		/// @brief 经典的 libpcap 格式。
+		///
+		Pcap,
+
+		///
+		/// @brief pcapng 格式。
+		///
+		Pcapng,
+	};
+
+} // namespace base::pcap
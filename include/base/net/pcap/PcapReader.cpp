@@ -0,0 +1,360 @@
+#include "PcapReader.h"
+#include "base/bit/AutoBitConverter.h"
+#include "base/string/define.h"
+#include "base/string/ToHexString.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace
+{
+	constexpr uint32_t _pcap_microsecond_magic = 0xa1b2c3d4;
+	constexpr uint32_t _pcap_nanosecond_magic = 0xa1b23c4d;
+	constexpr uint32_t _pcapng_byte_order_magic = 0x1a2b3c4d;
+
+	constexpr uint32_t _section_header_block_type = 0x0a0d0d0a;
+	constexpr uint32_t _interface_description_block_type = 1;
+	constexpr uint32_t _simple_packet_block_type = 3;
+	constexpr uint32_t _enhanced_packet_block_type = 6;
+
+	constexpr uint16_t _end_of_options_code = 0;
+	constexpr uint16_t _if_tsresol_code = 9;
+
+	///
+	/// @brief 单条记录或单个块的最大长度。超过就认为文件损坏了，防止按照损坏的长度分配内存。
+	///
+	constexpr uint32_t _max_block_length = 64 * 1024 * 1024;
+
+} // namespace
+
+base::pcap::PcapReader::PcapReader(std::shared_ptr<base::Stream> const &stream)
+	: _stream(stream)
+{
+	if (_stream == nullptr)
+	{
+		throw std::invalid_argument{CODE_POS_STR + "stream 不能为空指针。"};
+	}
+
+	ReadFileHeader();
+}
+
+void base::pcap::PcapReader::ReadExactly(base::Span const &span)
+{
+	if (_stream->ReadExactly(span) < span.Size())
+	{
+		throw std::runtime_error{CODE_POS_STR + "抓包文件在记录中间截断了。"};
+	}
+}
+
+uint16_t base::pcap::PcapReader::ToUInt16(uint8_t const *buffer) const
+{
+	return base::AutoBitConverter{_file_endian}.FromBytes<uint16_t>(base::ReadOnlySpan{buffer, 2});
+}
+
+uint32_t base::pcap::PcapReader::ToUInt32(uint8_t const *buffer) const
+{
+	return base::AutoBitConverter{_file_endian}.FromBytes<uint32_t>(base::ReadOnlySpan{buffer, 4});
+}
+
+std::chrono::nanoseconds base::pcap::PcapReader::ToNanoseconds(uint64_t timestamp, uint64_t units_per_second)
+{
+	// 分开计算整数秒和小数部分，防止乘以 1e9 后溢出。
+	uint64_t seconds = timestamp / units_per_second;
+	uint64_t fraction = timestamp % units_per_second;
+
+	uint64_t fraction_nanoseconds = 0;
+	if (units_per_second <= 1000000000)
+	{
+		fraction_nanoseconds = fraction * 1000000000 / units_per_second;
+	}
+	else
+	{
+		// 比纳秒更精细的分辨率，只能舍入到纳秒。
+		fraction_nanoseconds = static_cast<uint64_t>(static_cast<double>(fraction) * 1e9 / static_cast<double>(units_per_second));
+	}
+
+	return std::chrono::nanoseconds{static_cast<int64_t>(seconds * 1000000000 + fraction_nanoseconds)};
+}
+
+void base::pcap::PcapReader::ReadFileHeader()
+{
+	uint8_t magic_buffer[4];
+	if (_stream->ReadExactly(base::Span{magic_buffer, 4}) < 4)
+	{
+		throw std::invalid_argument{CODE_POS_STR + "文件太短，不是抓包文件。"};
+	}
+
+	uint32_t little_magic = base::little_endian_remote_converter.FromBytes<uint32_t>(base::ReadOnlySpan{magic_buffer, 4});
+	uint32_t big_magic = base::big_endian_remote_converter.FromBytes<uint32_t>(base::ReadOnlySpan{magic_buffer, 4});
+
+	if (little_magic == _section_header_block_type)
+	{
+		uint8_t raw_block_length[4];
+		ReadExactly(base::Span{raw_block_length, 4});
+		_format = base::pcap::PcapFormat::Pcapng;
+		ParseSectionHeaderBlock(raw_block_length);
+		return;
+	}
+
+	Interface interface{};
+	if (little_magic == _pcap_microsecond_magic || little_magic == _pcap_nanosecond_magic)
+	{
+		_file_endian = std::endian::little;
+		interface._units_per_second = little_magic == _pcap_microsecond_magic ? 1000000 : 1000000000;
+	}
+	else if (big_magic == _pcap_microsecond_magic || big_magic == _pcap_nanosecond_magic)
+	{
+		_file_endian = std::endian::big;
+		interface._units_per_second = big_magic == _pcap_microsecond_magic ? 1000000 : 1000000000;
+	}
+	else
+	{
+		throw std::invalid_argument{CODE_POS_STR + "未知的魔数 " + base::ToHexString(little_magic) + ", 不是抓包文件。"};
+	}
+
+	// 版本号 4 字节，时区 4 字节，时间戳精度 4 字节，快照长度 4 字节，链路层类型 4 字节。
+	uint8_t header[20];
+	ReadExactly(base::Span{header, 20});
+	interface._snapshot_length = ToUInt32(header + 12);
+	interface._link_type = static_cast<base::pcap::PcapLinkType>(ToUInt32(header + 16));
+
+	_format = base::pcap::PcapFormat::Pcap;
+	_interfaces.push_back(interface);
+}
+
+void base::pcap::PcapReader::ParseSectionHeaderBlock(uint8_t const *raw_block_length)
+{
+	// 块长度的字节序要等读到字节序魔数才能确定。
+	uint8_t byte_order_magic[4];
+	ReadExactly(base::Span{byte_order_magic, 4});
+
+	if (base::little_endian_remote_converter.FromBytes<uint32_t>(base::ReadOnlySpan{byte_order_magic, 4}) == _pcapng_byte_order_magic)
+	{
+		_file_endian = std::endian::little;
+	}
+	else if (base::big_endian_remote_converter.FromBytes<uint32_t>(base::ReadOnlySpan{byte_order_magic, 4}) == _pcapng_byte_order_magic)
+	{
+		_file_endian = std::endian::big;
+	}
+	else
+	{
+		throw std::runtime_error{CODE_POS_STR + "节头块的字节序魔数错误。"};
+	}
+
+	uint32_t block_length = ToUInt32(raw_block_length);
+	if (block_length < 28 || block_length % 4 != 0 || block_length > _max_block_length)
+	{
+		throw std::runtime_error{CODE_POS_STR + "节头块的长度错误。"};
+	}
+
+	// 跳过版本号、节长度和选项。
+	_buffer.resize(block_length - 12);
+	ReadExactly(base::Span{_buffer.data(), static_cast<int64_t>(_buffer.size())});
+
+	// 接口编号只在本节内有效。
+	_interfaces.clear();
+}
+
+void base::pcap::PcapReader::ReadPcapngBlockBody(uint32_t block_length)
+{
+	if (block_length < 12 || block_length % 4 != 0 || block_length > _max_block_length)
+	{
+		throw std::runtime_error{CODE_POS_STR + "块长度 " + std::to_string(block_length) + " 错误。"};
+	}
+
+	// 块体加上末尾重复的块长度。
+	_buffer.resize(block_length - 8);
+	ReadExactly(base::Span{_buffer.data(), static_cast<int64_t>(_buffer.size())});
+}
+
+void base::pcap::PcapReader::ParseInterfaceDescriptionBlock()
+{
+	int64_t body_size = static_cast<int64_t>(_buffer.size()) - 4;
+	if (body_size < 8)
+	{
+		throw std::runtime_error{CODE_POS_STR + "接口描述块过短。"};
+	}
+
+	uint8_t const *body = _buffer.data();
+
+	Interface interface{};
+	interface._link_type = static_cast<base::pcap::PcapLinkType>(ToUInt16(body));
+	interface._snapshot_length = ToUInt32(body + 4);
+
+	int64_t position = 8;
+	while (position + 4 <= body_size)
+	{
+		uint16_t code = ToUInt16(body + position);
+		uint16_t length = ToUInt16(body + position + 2);
+		position += 4;
+		if (code == _end_of_options_code || position + length > body_size)
+		{
+			break;
+		}
+
+		if (code == _if_tsresol_code && length >= 1)
+		{
+			uint8_t resolution = body[position];
+			uint32_t exponent = resolution & 0x7f;
+			if (resolution & 0x80)
+			{
+				if (exponent > 63)
+				{
+					throw std::runtime_error{CODE_POS_STR + "时间戳分辨率错误。"};
+				}
+
+				interface._units_per_second = uint64_t{1} << exponent;
+			}
+			else
+			{
+				if (exponent > 19)
+				{
+					throw std::runtime_error{CODE_POS_STR + "时间戳分辨率错误。"};
+				}
+
+				interface._units_per_second = 1;
+				for (uint32_t i = 0; i < exponent; i++)
+				{
+					interface._units_per_second *= 10;
+				}
+			}
+		}
+
+		// 选项值按 4 字节对齐。
+		position += (length + 3) / 4 * 4;
+	}
+
+	_interfaces.push_back(interface);
+}
+
+bool base::pcap::PcapReader::TryReadPcapRecord(base::pcap::PcapRecord &record)
+{
+	uint8_t header[16];
+	int64_t have_read = _stream->ReadExactly(base::Span{header, 16});
+	if (have_read == 0)
+	{
+		return false;
+	}
+
+	if (have_read < 16)
+	{
+		throw std::runtime_error{CODE_POS_STR + "抓包文件在记录头中间截断了。"};
+	}
+
+	Interface const &interface = _interfaces[0];
+	uint32_t captured_length = ToUInt32(header + 8);
+	if (captured_length > _max_block_length)
+	{
+		throw std::runtime_error{CODE_POS_STR + "记录长度 " + std::to_string(captured_length) + " 错误。"};
+	}
+
+	_buffer.resize(captured_length);
+	ReadExactly(base::Span{_buffer.data(), static_cast<int64_t>(captured_length)});
+
+	uint64_t timestamp = static_cast<uint64_t>(ToUInt32(header)) * interface._units_per_second + ToUInt32(header + 4);
+	record._timestamp = ToNanoseconds(timestamp, interface._units_per_second);
+	record._link_type = interface._link_type;
+	record._original_length = ToUInt32(header + 12);
+	record._data = base::ReadOnlySpan{_buffer.data(), static_cast<int64_t>(captured_length)};
+	return true;
+}
+
+bool base::pcap::PcapReader::TryReadPcapngRecord(base::pcap::PcapRecord &record)
+{
+	while (true)
+	{
+		uint8_t header[8];
+		int64_t have_read = _stream->ReadExactly(base::Span{header, 8});
+		if (have_read == 0)
+		{
+			return false;
+		}
+
+		if (have_read < 8)
+		{
+			throw std::runtime_error{CODE_POS_STR + "抓包文件在块头中间截断了。"};
+		}
+
+		// 节头块的类型是回文，与字节序无关。
+		uint32_t block_type = ToUInt32(header);
+		if (block_type == _section_header_block_type)
+		{
+			// 新的一节，字节序可能变化。
+			ParseSectionHeaderBlock(header + 4);
+			continue;
+		}
+
+		ReadPcapngBlockBody(ToUInt32(header + 4));
+		int64_t body_size = static_cast<int64_t>(_buffer.size()) - 4;
+		uint8_t const *body = _buffer.data();
+
+		if (block_type == _interface_description_block_type)
+		{
+			ParseInterfaceDescriptionBlock();
+			continue;
+		}
+
+		if (block_type == _enhanced_packet_block_type)
+		{
+			if (body_size < 20)
+			{
+				throw std::runtime_error{CODE_POS_STR + "增强分组块过短。"};
+			}
+
+			uint32_t interface_id = ToUInt32(body);
+			if (interface_id >= _interfaces.size())
+			{
+				throw std::runtime_error{CODE_POS_STR + "增强分组块引用了不存在的接口 " + std::to_string(interface_id)};
+			}
+
+			uint32_t captured_length = ToUInt32(body + 12);
+			if (20 + static_cast<int64_t>(captured_length) > body_size)
+			{
+				throw std::runtime_error{CODE_POS_STR + "增强分组块的数据长度超出了块。"};
+			}
+
+			Interface const &interface = _interfaces[interface_id];
+			uint64_t timestamp = (static_cast<uint64_t>(ToUInt32(body + 4)) << 32) | ToUInt32(body + 8);
+			record._timestamp = ToNanoseconds(timestamp, interface._units_per_second);
+			record._link_type = interface._link_type;
+			record._original_length = ToUInt32(body + 16);
+			record._data = base::ReadOnlySpan{body + 20, static_cast<int64_t>(captured_length)};
+			_last_timestamp = record._timestamp;
+			return true;
+		}
+
+		if (block_type == _simple_packet_block_type)
+		{
+			if (body_size < 4 || _interfaces.empty())
+			{
+				throw std::runtime_error{CODE_POS_STR + "简单分组块过短或没有接口描述块。"};
+			}
+
+			// 简单分组块没有捕获长度，由原始长度、块长度和快照长度推算。
+			Interface const &interface = _interfaces[0];
+			int64_t original_length = ToUInt32(body);
+			int64_t captured_length = std::min(original_length, body_size - 4);
+			if (interface._snapshot_length > 0)
+			{
+				captured_length = std::min(captured_length, interface._snapshot_length);
+			}
+
+			record._timestamp = _last_timestamp;
+			record._link_type = interface._link_type;
+			record._original_length = original_length;
+			record._data = base::ReadOnlySpan{body + 4, captured_length};
+			return true;
+		}
+
+		// 其他块，例如名称解析块、统计块，跳过。
+	}
+}
+
+bool base::pcap::PcapReader::TryRead(base::pcap::PcapRecord &record)
+{
+	if (_format == base::pcap::PcapFormat::Pcap)
+	{
+		return TryReadPcapRecord(record);
+	}
+
+	return TryReadPcapngRecord(record);
+}
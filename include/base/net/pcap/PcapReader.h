@@ -0,0 +1,115 @@
+#pragma once
+#include "base/net/pcap/PcapFormat.h"
+#include "base/net/pcap/PcapRecord.h"
+#include "base/stream/Stream.h"
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace base::pcap
+{
+	///
+	/// @brief 抓包文件读取器。支持 pcap 和 pcapng 格式，两种字节序都支持。
+	///
+	/// @note 构造时读取文件头判断格式。之后每次 TryRead 读出一条记录，记录的数据放在内部
+	/// 复用的缓冲区中，不会为每条记录分配内存。
+	///
+	/// @note pcapng 中只读取增强分组块和简单分组块，其他块直接跳过。
+	///
+	class PcapReader
+	{
+	private:
+		///
+		/// @brief pcapng 中的接口描述。
+		///
+		struct Interface
+		{
+			base::pcap::PcapLinkType _link_type = base::pcap::PcapLinkType::Ethernet;
+			int64_t _snapshot_length = 0;
+
+			///
+			/// @brief 时间戳的分辨率。每秒多少个单位。
+			///
+			uint64_t _units_per_second = 1000000;
+		};
+
+		std::shared_ptr<base::Stream> _stream;
+		base::pcap::PcapFormat _format = base::pcap::PcapFormat::Pcap;
+		std::endian _file_endian = std::endian::little;
+
+		///
+		/// @brief pcap 格式只有一个接口，pcapng 格式每个接口描述块添加一个。
+		///
+		std::vector<Interface> _interfaces;
+
+		///
+		/// @brief 上一条记录的时间戳。简单分组块没有时间戳，沿用这个。
+		///
+		std::chrono::nanoseconds _last_timestamp{};
+
+		std::vector<uint8_t> _buffer;
+
+		void ReadFileHeader();
+
+		bool TryReadPcapRecord(base::pcap::PcapRecord &record);
+
+		bool TryReadPcapngRecord(base::pcap::PcapRecord &record);
+
+		///
+		/// @brief 读取 pcapng 的块的剩余部分到 _buffer 中。
+		///
+		/// @param block_length 块的总长度，包括块类型和两个块长度字段。
+		///
+		void ReadPcapngBlockBody(uint32_t block_length);
+
+		///
+		/// @brief 解析节头块。块类型和块长度已经读取，块长度还没有按字节序转换。
+		///
+		/// @param raw_block_length 文件中块长度字段的 4 个字节。
+		///
+		void ParseSectionHeaderBlock(uint8_t const *raw_block_length);
+
+		void ParseInterfaceDescriptionBlock();
+
+		void ReadExactly(base::Span const &span);
+
+		uint16_t ToUInt16(uint8_t const *buffer) const;
+
+		uint32_t ToUInt32(uint8_t const *buffer) const;
+
+		static std::chrono::nanoseconds ToNanoseconds(uint64_t timestamp, uint64_t units_per_second);
+
+	public:
+		///
+		/// @brief 构造时读取文件头。
+		///
+		/// @param stream 抓包文件的流。
+		///
+		/// @exception std::invalid_argument 不是 pcap 或 pcapng 文件时抛出。
+		///
+		PcapReader(std::shared_ptr<base::Stream> const &stream);
+
+		///
+		/// @brief 文件的格式。
+		///
+		/// @return
+		///
+		base::pcap::PcapFormat Format() const
+		{
+			return _format;
+		}
+
+		///
+		/// @brief 读取下一条记录。
+		///
+		/// @param record 读取成功时写入此对象。record._data 在下一次读取后失效。
+		///
+		/// @return 读取成功返回 true. 到达文件末尾返回 false.
+		///
+		/// @exception std::runtime_error 文件损坏或在记录中间截断时抛出。
+		///
+		bool TryRead(base::pcap::PcapRecord &record);
+	};
+
+} // namespace base::pcap
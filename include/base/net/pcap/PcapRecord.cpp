@@ -0,0 +1 @@
+#include "PcapRecord.h" // IWYU pragma: keep
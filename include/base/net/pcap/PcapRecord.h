@@ -0,0 +1,44 @@
+#pragma once
+#include "base/stream/ReadOnlySpan.h"
+#include <chrono>
+#include <cstdint>
+
+namespace base::pcap
+{
+	///
+	/// @brief 链路层类型。只列出用到的。
+	///
+	enum class PcapLinkType : uint32_t
+	{
+		Ethernet = 1,
+	};
+
+	///
+	/// @brief 抓包文件中的一条记录。
+	///
+	struct PcapRecord
+	{
+		///
+		/// @brief 抓包时间。自 1970-01-01 UTC 起的时间。
+		///
+		std::chrono::nanoseconds _timestamp{};
+
+		///
+		/// @brief 链路层类型。
+		///
+		base::pcap::PcapLinkType _link_type = base::pcap::PcapLinkType::Ethernet;
+
+		///
+		/// @brief 帧在线路上的原始长度。抓包时截断了的话会大于 _data 的大小。
+		///
+		int64_t _original_length = 0;
+
+		///
+		/// @brief 抓到的数据。
+		///
+		/// @note 引用读取器内部的缓冲区，读取下一条记录后失效。
+		///
+		base::ReadOnlySpan _data{};
+	};
+
+} // namespace base::pcap
@@ -0,0 +1,112 @@
+#include "PcapReplayEthernetPort.h"
+#include "base/string/define.h"
+#include "base/task/delay.h"
+#include <chrono>
+#include <stdexcept>
+
+namespace
+{
+	std::chrono::nanoseconds Now()
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch());
+	}
+
+} // namespace
+
+base::pcap::PcapReplayEthernetPort::PcapReplayEthernetPort(std::shared_ptr<base::Stream> const &capture)
+	: _reader(capture)
+{
+}
+
+void base::pcap::PcapReplayEthernetPort::SetSpeed(double speed)
+{
+	if (speed < 0)
+	{
+		throw std::invalid_argument{CODE_POS_STR + "回放速度不能为负数。"};
+	}
+
+	_speed = speed;
+}
+
+void base::pcap::PcapReplayEthernetPort::SetRecorder(std::shared_ptr<base::pcap::PcapWriter> const &recorder)
+{
+	base::task::MutexGuard g{_send_lock};
+	_recorder = recorder;
+}
+
+int64_t base::pcap::PcapReplayEthernetPort::Replay()
+{
+	if (!_opened)
+	{
+		throw std::runtime_error{CODE_POS_STR + "回放前必须先打开。"};
+	}
+
+	int64_t count = 0;
+	base::pcap::PcapRecord record{};
+	std::chrono::nanoseconds first_timestamp{};
+	std::chrono::steady_clock::time_point start{};
+
+	while (_reader.TryRead(record))
+	{
+		if (record._link_type != base::pcap::PcapLinkType::Ethernet)
+		{
+			continue;
+		}
+
+		if (_speed > 0)
+		{
+			if (count == 0)
+			{
+				first_timestamp = record._timestamp;
+				start = std::chrono::steady_clock::now();
+			}
+
+			// 以第一帧为基准，按抓包时间间隔除以倍速等待。
+			std::chrono::nanoseconds offset{static_cast<int64_t>(static_cast<double>((record._timestamp - first_timestamp).count()) / _speed)};
+			std::chrono::nanoseconds wait = start + offset - std::chrono::steady_clock::now();
+			if (wait.count() > 0)
+			{
+				base::task::Delay(wait);
+			}
+		}
+
+		_receiving_ethernet_frame_event.Invoke(record._data);
+		count++;
+	}
+
+	_disconnected_event.Invoke();
+	return count;
+}
+
+int64_t base::pcap::PcapReplayEthernetPort::SentFrameCount()
+{
+	base::task::MutexGuard g{_send_lock};
+	return _sent_frame_count;
+}
+
+void base::pcap::PcapReplayEthernetPort::Open(base::Mac const &mac)
+{
+	_mac = mac;
+	_opened = true;
+	_connected_event.Invoke();
+}
+
+void base::pcap::PcapReplayEthernetPort::Send(std::vector<base::ReadOnlySpan> const &spans)
+{
+	base::task::MutexGuard g{_send_lock};
+	_sent_frame_count++;
+	if (_recorder != nullptr)
+	{
+		_recorder->Write(Now(), spans);
+	}
+}
+
+void base::pcap::PcapReplayEthernetPort::Send(base::ReadOnlySpan const &span)
+{
+	base::task::MutexGuard g{_send_lock};
+	_sent_frame_count++;
+	if (_recorder != nullptr)
+	{
+		_recorder->Write(Now(), span);
+	}
+}
@@ -0,0 +1,147 @@
+#pragma once
+#include "base/delegate/Delegate.h"
+#include "base/embedded/ethernet/IEthernetPort.h"
+#include "base/net/Mac.h"
+#include "base/net/pcap/PcapReader.h"
+#include "base/net/pcap/PcapWriter.h"
+#include "base/stream/Stream.h"
+#include "base/task/Mutex.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace base::pcap
+{
+	///
+	/// @brief 回放抓包文件的以太网端口。
+	///
+	/// @note 用来在没有硬件的情况下用真实的流量测试和测量以太网、PROFINET 协议栈。
+	/// 	@li 调用 Replay 后，抓包文件中的以太网帧依次通过 ReceivingEhternetFrameEvent 交给订阅者。
+	/// 	可以按抓包时的节奏回放，也可以按倍速回放，或者尽可能快地回放。
+	/// 	@li 发送的帧可以记录到另一个抓包文件中。
+	///
+	/// @note 全部离线进行，不访问任何网络接口。
+	///
+	class PcapReplayEthernetPort final :
+		public base::ethernet::IEthernetPort
+	{
+	private:
+		base::pcap::PcapReader _reader;
+		base::Mac _mac{};
+		bool _opened = false;
+		double _speed = 0;
+
+		base::task::Mutex _send_lock{};
+		std::shared_ptr<base::pcap::PcapWriter> _recorder;
+		int64_t _sent_frame_count = 0;
+
+		base::Delegate<base::ReadOnlySpan> _receiving_ethernet_frame_event;
+		base::Delegate<> _connected_event;
+		base::Delegate<> _disconnected_event;
+
+	public:
+		///
+		/// @brief 构造函数。
+		///
+		/// @param capture 要回放的抓包文件。构造时会读取文件头。
+		///
+		PcapReplayEthernetPort(std::shared_ptr<base::Stream> const &capture);
+
+		///
+		/// @brief 设置回放速度。
+		///
+		/// @param speed 相对于抓包时的倍速。1 表示按抓包时的节奏回放，2 表示两倍速。
+		/// 0 表示不等待，尽可能快地回放。不能为负数。
+		///
+		void SetSpeed(double speed);
+
+		///
+		/// @brief 设置记录发送的帧的写入器。
+		///
+		/// @param recorder 为空指针时不记录。
+		///
+		void SetRecorder(std::shared_ptr<base::pcap::PcapWriter> const &recorder);
+
+		///
+		/// @brief 在调用者的线程中回放整个抓包文件。回放结束后触发断开连接事件。
+		///
+		/// @note 非以太网链路层的记录会被跳过。
+		///
+		/// @return 回放的帧数。
+		///
+		int64_t Replay();
+
+		///
+		/// @brief 已经发送的帧数。
+		///
+		/// @return
+		///
+		int64_t SentFrameCount();
+
+		///
+		/// @brief 打开时设置的 MAC 地址。
+		///
+		/// @return
+		///
+		base::Mac Mac() const
+		{
+			return _mac;
+		}
+
+		/* #region IEthernetPort */
+
+		///
+		/// @brief 打开以太网端口。会触发连接事件。
+		///
+		/// @param mac MAC 地址。
+		///
+		virtual void Open(base::Mac const &mac) override;
+
+		///
+		/// @brief 发送。设置了写入器的话记录下来。
+		///
+		/// @param spans
+		///
+		virtual void Send(std::vector<base::ReadOnlySpan> const &spans) override;
+
+		///
+		/// @brief 发送单个 span.
+		///
+		/// @param span
+		///
+		virtual void Send(base::ReadOnlySpan const &span) override;
+
+		///
+		/// @brief 回放时每个以太网帧会触发此事件。
+		///
+		/// @return
+		///
+		virtual base::IEvent<base::ReadOnlySpan> &ReceivingEhternetFrameEvent() override
+		{
+			return _receiving_ethernet_frame_event;
+		}
+
+		///
+		/// @brief 连接事件。打开时触发。
+		///
+		/// @return
+		///
+		virtual base::IEvent<> &ConnectedEvent() override
+		{
+			return _connected_event;
+		}
+
+		///
+		/// @brief 断开连接事件。回放结束时触发。
+		///
+		/// @return
+		///
+		virtual base::IEvent<> &DisconnectedEvent() override
+		{
+			return _disconnected_event;
+		}
+
+		/* #endregion */
+	};
+
+} // namespace base::pcap
@@ -0,0 +1,177 @@
+#include "PcapWriter.h"
+#include "base/bit/AutoBitConverter.h"
+#include "base/string/define.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace
+{
+	void PutUInt16(std::vector<uint8_t> &buffer, int64_t offset, uint16_t value)
+	{
+		base::little_endian_remote_converter.GetBytes(value, base::Span{buffer.data() + offset, 2});
+	}
+
+	void PutUInt32(std::vector<uint8_t> &buffer, int64_t offset, uint32_t value)
+	{
+		base::little_endian_remote_converter.GetBytes(value, base::Span{buffer.data() + offset, 4});
+	}
+
+	///
+	/// @brief 增强分组块除了数据以外的长度：块头 8 字节，固定字段 20 字节，块尾 4 字节。
+	///
+	constexpr int64_t _enhanced_packet_block_overhead = 32;
+
+	int64_t PadTo4(int64_t length)
+	{
+		return (length + 3) / 4 * 4;
+	}
+
+} // namespace
+
+base::pcap::PcapWriter::PcapWriter(std::shared_ptr<base::Stream> const &stream,
+								   base::pcap::PcapFormat format,
+								   base::pcap::PcapLinkType link_type,
+								   int64_t snapshot_length)
+	: _stream(stream),
+	  _format(format),
+	  _snapshot_length(snapshot_length)
+{
+	if (_stream == nullptr)
+	{
+		throw std::invalid_argument{CODE_POS_STR + "stream 不能为空指针。"};
+	}
+
+	if (_snapshot_length <= 0 || _snapshot_length > UINT32_MAX)
+	{
+		throw std::invalid_argument{CODE_POS_STR + "快照长度必须在 (0, UINT32_MAX] 内。"};
+	}
+
+	WriteFileHeader(link_type);
+}
+
+void base::pcap::PcapWriter::WriteFileHeader(base::pcap::PcapLinkType link_type)
+{
+	if (_format == base::pcap::PcapFormat::Pcap)
+	{
+		// 纳秒分辨率的魔数，版本 2.4.
+		_buffer.assign(24, 0);
+		PutUInt32(_buffer, 0, 0xa1b23c4d);
+		PutUInt16(_buffer, 4, 2);
+		PutUInt16(_buffer, 6, 4);
+		PutUInt32(_buffer, 16, static_cast<uint32_t>(_snapshot_length));
+		PutUInt32(_buffer, 20, static_cast<uint32_t>(link_type));
+		_stream->Write(base::ReadOnlySpan{_buffer.data(), 24});
+		return;
+	}
+
+	// 节头块，28 字节。版本 1.0, 节长度未知，写 -1.
+	_buffer.assign(28 + 32, 0);
+	PutUInt32(_buffer, 0, 0x0a0d0d0a);
+	PutUInt32(_buffer, 4, 28);
+	PutUInt32(_buffer, 8, 0x1a2b3c4d);
+	PutUInt16(_buffer, 12, 1);
+	PutUInt16(_buffer, 14, 0);
+	PutUInt32(_buffer, 16, 0xffffffff);
+	PutUInt32(_buffer, 20, 0xffffffff);
+	PutUInt32(_buffer, 24, 28);
+
+	// 接口描述块，32 字节。带有 if_tsresol = 9 选项，即纳秒分辨率。
+	int64_t offset = 28;
+	PutUInt32(_buffer, offset + 0, 1);
+	PutUInt32(_buffer, offset + 4, 32);
+	PutUInt16(_buffer, offset + 8, static_cast<uint16_t>(link_type));
+	PutUInt32(_buffer, offset + 12, static_cast<uint32_t>(_snapshot_length));
+	PutUInt16(_buffer, offset + 16, 9);
+	PutUInt16(_buffer, offset + 18, 1);
+	_buffer[offset + 20] = 9;
+	PutUInt16(_buffer, offset + 24, 0);
+	PutUInt16(_buffer, offset + 26, 0);
+	PutUInt32(_buffer, offset + 28, 32);
+
+	_stream->Write(base::ReadOnlySpan{_buffer.data(), static_cast<int64_t>(_buffer.size())});
+}
+
+void base::pcap::PcapWriter::WriteHeader(std::chrono::nanoseconds timestamp,
+										 int64_t captured_length,
+										 int64_t original_length)
+{
+	uint64_t nanoseconds = static_cast<uint64_t>(timestamp.count());
+
+	if (_format == base::pcap::PcapFormat::Pcap)
+	{
+		_buffer.resize(16);
+		PutUInt32(_buffer, 0, static_cast<uint32_t>(nanoseconds / 1000000000));
+		PutUInt32(_buffer, 4, static_cast<uint32_t>(nanoseconds % 1000000000));
+		PutUInt32(_buffer, 8, static_cast<uint32_t>(captured_length));
+		PutUInt32(_buffer, 12, static_cast<uint32_t>(original_length));
+		_stream->Write(base::ReadOnlySpan{_buffer.data(), 16});
+		return;
+	}
+
+	_buffer.resize(28);
+	PutUInt32(_buffer, 0, 6);
+	PutUInt32(_buffer, 4, static_cast<uint32_t>(_enhanced_packet_block_overhead + PadTo4(captured_length)));
+	PutUInt32(_buffer, 8, 0);
+	PutUInt32(_buffer, 12, static_cast<uint32_t>(nanoseconds >> 32));
+	PutUInt32(_buffer, 16, static_cast<uint32_t>(nanoseconds));
+	PutUInt32(_buffer, 20, static_cast<uint32_t>(captured_length));
+	PutUInt32(_buffer, 24, static_cast<uint32_t>(original_length));
+	_stream->Write(base::ReadOnlySpan{_buffer.data(), 28});
+}
+
+void base::pcap::PcapWriter::WriteTrailer(int64_t captured_length)
+{
+	if (_format == base::pcap::PcapFormat::Pcap)
+	{
+		return;
+	}
+
+	// 数据填充到 4 字节对齐，然后是重复的块长度。
+	int64_t padding = PadTo4(captured_length) - captured_length;
+	_buffer.assign(padding + 4, 0);
+	PutUInt32(_buffer, padding, static_cast<uint32_t>(_enhanced_packet_block_overhead + PadTo4(captured_length)));
+	_stream->Write(base::ReadOnlySpan{_buffer.data(), static_cast<int64_t>(_buffer.size())});
+}
+
+void base::pcap::PcapWriter::Write(std::chrono::nanoseconds timestamp, base::ReadOnlySpan const &frame)
+{
+	int64_t captured_length = std::min(frame.Size(), _snapshot_length);
+	WriteHeader(timestamp, captured_length, frame.Size());
+	_stream->Write(frame.Slice(0, captured_length));
+	WriteTrailer(captured_length);
+}
+
+void base::pcap::PcapWriter::Write(std::chrono::nanoseconds timestamp, std::vector<base::ReadOnlySpan> const &spans)
+{
+	int64_t original_length = 0;
+	for (base::ReadOnlySpan const &span : spans)
+	{
+		original_length += span.Size();
+	}
+
+	int64_t captured_length = std::min(original_length, _snapshot_length);
+	WriteHeader(timestamp, captured_length, original_length);
+
+	int64_t remain = captured_length;
+	for (base::ReadOnlySpan const &span : spans)
+	{
+		if (remain <= 0)
+		{
+			break;
+		}
+
+		int64_t size = std::min(span.Size(), remain);
+		_stream->Write(span.Slice(0, size));
+		remain -= size;
+	}
+
+	WriteTrailer(captured_length);
+}
+
+void base::pcap::PcapWriter::Write(base::pcap::PcapRecord const &record)
+{
+	int64_t captured_length = std::min(record._data.Size(), _snapshot_length);
+	WriteHeader(record._timestamp, captured_length, std::max(record._original_length, captured_length));
+	_stream->Write(record._data.Slice(0, captured_length));
+	WriteTrailer(captured_length);
+}
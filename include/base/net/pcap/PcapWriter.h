@@ -0,0 +1,97 @@
+#pragma once
+#include "base/net/pcap/PcapFormat.h"
+#include "base/net/pcap/PcapRecord.h"
+#include "base/stream/ReadOnlySpan.h"
+#include "base/stream/Stream.h"
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace base::pcap
+{
+	///
+	/// @brief 抓包文件写入器。
+	///
+	/// @note 以小端序、纳秒分辨率写入。pcapng 格式写入一个节头块和一个接口描述块，
+	/// 每条记录是一个增强分组块。
+	///
+	/// @note 构造时写入文件头。
+	///
+	class PcapWriter
+	{
+	private:
+		std::shared_ptr<base::Stream> _stream;
+		base::pcap::PcapFormat _format = base::pcap::PcapFormat::Pcap;
+		int64_t _snapshot_length = 0;
+
+		///
+		/// @brief 记录头和块尾的缓冲区。复用，不为每条记录分配内存。
+		///
+		std::vector<uint8_t> _buffer;
+
+		void WriteFileHeader(base::pcap::PcapLinkType link_type);
+
+		void WriteHeader(std::chrono::nanoseconds timestamp, int64_t captured_length, int64_t original_length);
+
+		void WriteTrailer(int64_t captured_length);
+
+	public:
+		///
+		/// @brief 构造时写入文件头。
+		///
+		/// @param stream 要写入的流。
+		/// @param format 文件格式。
+		/// @param link_type 链路层类型。
+		/// @param snapshot_length 快照长度。超过此长度的帧会被截断。
+		///
+		PcapWriter(std::shared_ptr<base::Stream> const &stream,
+				   base::pcap::PcapFormat format,
+				   base::pcap::PcapLinkType link_type = base::pcap::PcapLinkType::Ethernet,
+				   int64_t snapshot_length = 65535);
+
+		///
+		/// @brief 文件的格式。
+		///
+		/// @return
+		///
+		base::pcap::PcapFormat Format() const
+		{
+			return _format;
+		}
+
+		///
+		/// @brief 写入一条记录。
+		///
+		/// @param timestamp 自 1970-01-01 UTC 起的时间。
+		/// @param frame 整个帧。
+		///
+		void Write(std::chrono::nanoseconds timestamp, base::ReadOnlySpan const &frame);
+
+		///
+		/// @brief 写入一条由多个片段组成的记录。
+		///
+		/// @note 与 IEthernetPort::Send 的参数相同，发送时可以直接记录，不需要先拼接。
+		///
+		/// @param timestamp 自 1970-01-01 UTC 起的时间。
+		/// @param spans 依次拼接成一个帧。
+		///
+		void Write(std::chrono::nanoseconds timestamp, std::vector<base::ReadOnlySpan> const &spans);
+
+		///
+		/// @brief 写入一条读取到的记录。用来过滤或转换抓包文件。
+		///
+		/// @param record
+		///
+		void Write(base::pcap::PcapRecord const &record);
+
+		///
+		/// @brief 冲洗底层的流。
+		///
+		void Flush()
+		{
+			_stream->Flush();
+		}
+	};
+
+} // namespace base::pcap
@@ -1,4 +1,6 @@
 #include "ApduStatus.h"
+#include "base/bit/AutoBitConverter.h"
+#include "base/container/Range.h"
 
 base::profinet::ApduStatus::ApduStatus(base::Span const &span)
 {
@@ -12,27 +14,30 @@ base::Span const &base::profinet::ApduStatus::Span() const
 
 uint16_t base::profinet::ApduStatus::CycleCounter() const
 {
-	return 0;
+	return base::big_endian_remote_converter.FromBytes<uint16_t>(_span[base::Range{0, 2}]);
 }
 
 void base::profinet::ApduStatus::SetCycleCounter(uint16_t value)
 {
+	base::big_endian_remote_converter.GetBytes(value, _span[base::Range{0, 2}]);
 }
 
 uint8_t base::profinet::ApduStatus::DataStatus() const
 {
-	return 0;
+	return _span[2];
 }
 
 void base::profinet::ApduStatus::SetDataStatus(uint8_t value)
 {
+	_span[2] = value;
 }
 
 uint8_t base::profinet::ApduStatus::TransferStatus() const
 {
-	return 0;
+	return _span[3];
 }
 
 void base::profinet::ApduStatus::SetTransferStatus(uint8_t value)
 {
+	_span[3] = value;
 }
@@ -13,6 +13,9 @@ namespace base
 
 		public:
 			ApduStatus() = default;
+
+			/// @brief 构造函数。
+			/// @param span 4 个字节。依次是大端的循环计数、数据状态、传输状态。
 			ApduStatus(base::Span const &span);
 
 			base::Span const &Span() const;
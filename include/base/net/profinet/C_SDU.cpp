@@ -1,4 +1,5 @@
 #include "C_SDU.h"
+#include "base/exception/NotSupportedException.h"
 
 base::profinet::C_SDU::C_SDU(base::Span const &span)
 {
@@ -12,7 +13,8 @@ base::Span const &base::profinet::C_SDU::Span() const
 
 base::profinet::DataItem base::profinet::C_SDU::DataItem() const
 {
-	return base::profinet::DataItem();
+	// 数据项的位置在 C_SDU 中没有记录，见头文件。
+	throw base::NotSupportedException{};
 }
 
 void base::profinet::C_SDU::SetDataItem(base::profinet::DataItem const &value)
@@ -22,5 +24,6 @@ void base::profinet::C_SDU::SetDataItem(base::profinet::DataItem const &value)
 
 base::Span base::profinet::C_SDU::Padding() const
 {
-	return base::Span();
+	// 有效字节的长度在 C_SDU 中没有记录，见头文件。
+	throw base::NotSupportedException{};
 }
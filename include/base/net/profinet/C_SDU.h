@@ -6,6 +6,11 @@ namespace base
 {
 	namespace profinet
 	{
+		/// @brief 循环帧的 C_SDU.
+		/// @note C_SDU 中各个数据对象、IOxS 的偏移量和长度，以及有效字节的长度，都是建立 AR 时
+		/// 由 IOCR 块约定的，C_SDU 本身不包含这些信息，所以 DataItem 和 Padding 无法实现，
+		/// 调用会抛出 base::NotSupportedException. 按布局读写 C_SDU 用
+		/// base::profinet::CyclicFrameTemplate, 布局由 CyclicFrameDescription 描述。
 		class C_SDU
 		{
 		private:
@@ -18,6 +23,7 @@ namespace base
 			base::Span const &Span() const;
 
 			/// @brief 数据项。
+			/// @exception base::NotSupportedException 总是抛出。见类的说明。
 			/// @return
 			base::profinet::DataItem DataItem() const;
 			void SetDataItem(base::profinet::DataItem const &value);
@@ -26,6 +32,7 @@ namespace base
 			/// @note C_SDU 的有效字节如果不足 40 字节，需要填充字节到 40 字节。填充的字节的值为 0.
 			/// 这是因为带有 VLAN 标签的以太网帧的最小大小为 64 字节。里面塞入 PROFINET 的一些头尾
 			/// 字段后，剩下的空间给 C_SDU，所以只能靠 C_SDU 来填充起来，使以太网的帧大小符合最小要求。
+			/// @exception base::NotSupportedException 总是抛出。见类的说明。
 			/// @return
 			base::Span Padding() const;
 		};
@@ -1,4 +1,5 @@
 #include "DataItem.h"
+#include "base/exception/NotSupportedException.h"
 
 base::profinet::DataItem::DataItem(base::Span const &span)
 {
@@ -12,16 +13,19 @@ base::Span const &base::profinet::DataItem::Span() const
 
 uint8_t base::profinet::DataItem::Iocs() const
 {
-	return 0;
+	// IOCS 的位置由 IOCR 决定，见头文件。
+	throw base::NotSupportedException{};
 }
 
-void base::profinet::DataItem::SetIocs(uint8_t value)
+void base::profinet::DataItem::SetIocs(uint8_t /* value */)
 {
+	throw base::NotSupportedException{};
 }
 
 base::profinet::DataObjectElement base::profinet::DataItem::DataObjectElement() const
 {
-	return base::profinet::DataObjectElement();
+	// 数据对象的长度由 IOCR 决定，见头文件。
+	throw base::NotSupportedException{};
 }
 
 void base::profinet::DataItem::SetDataObjectElement(base::profinet::DataObjectElement const &value)
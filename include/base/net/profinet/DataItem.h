@@ -6,6 +6,10 @@ namespace base
 {
 	namespace profinet
 	{
+		/// @brief C_SDU 中的数据项。
+		/// @note 数据对象的长度和 IOCS 的位置是建立 AR 时由 IOCR 块约定的，数据项本身不包含
+		/// 这些信息，所以 Iocs 和 DataObjectElement 无法实现，调用会抛出
+		/// base::NotSupportedException. 按布局读写用 base::profinet::CyclicFrameTemplate.
 		class DataItem
 		{
 		private:
@@ -1,4 +1,5 @@
 #include "DataObjectElement.h"
+#include "base/container/Range.h"
 
 base::profinet::DataObjectElement::DataObjectElement(base::Span const &span)
 {
@@ -12,7 +13,7 @@ base::Span const &base::profinet::DataObjectElement::Span() const
 
 base::Span base::profinet::DataObjectElement::Data() const
 {
-	return base::Span();
+	return _span[base::Range{0, _span.Size() - 1}];
 }
 
 void base::profinet::DataObjectElement::SetData(base::Span const &value)
@@ -22,9 +23,10 @@ void base::profinet::DataObjectElement::SetData(base::Span const &value)
 
 uint8_t base::profinet::DataObjectElement::Iops() const
 {
-	return 0;
+	return _span[_span.Size() - 1];
 }
 
 void base::profinet::DataObjectElement::SetIops(uint8_t value)
 {
+	_span[_span.Size() - 1] = value;
 }
@@ -12,6 +12,9 @@ namespace base
 
 		public:
 			DataObjectElement() = default;
+
+			/// @brief 构造函数。
+			/// @param span 数据和紧随其后的 1 个字节的 IOPS.
 			DataObjectElement(base::Span const &span);
 
 			base::Span const &Span() const;
@@ -23,6 +26,8 @@ namespace base
 			base::Span Data() const;
 			void SetData(base::Span const &value);
 
+			/// @brief 提供者状态。位于数据之后的 1 个字节。
+			/// @return
 			uint8_t Iops() const;
 			void SetIops(uint8_t value);
 		};
@@ -1,4 +1,5 @@
 #pragma once
+#include "base/container/Range.h"
 #include "base/net/profinet/ApduStatus.h"
 #include "base/net/profinet/C_SDU.h"
 #include "base/stream/Span.h"
@@ -16,6 +17,12 @@ namespace base::profinet
 	public:
 		RtcPdu() = default;
 
+		///
+		/// @brief 构造函数。
+		///
+		/// @param span 从帧 ID 之后开始，到 APDU 状态的最后一个字节结束。即 C_SDU 和紧随其后的
+		/// 4 个字节的 APDU 状态。
+		///
 		RtcPdu(base::Span const &span)
 		{
 			_span = span;
@@ -28,7 +35,7 @@ namespace base::profinet
 
 		base::profinet::C_SDU C_SDU() const
 		{
-			return base::profinet::C_SDU();
+			return base::profinet::C_SDU{_span[base::Range{0, _span.Size() - 4}]};
 		}
 
 		void Set_C_SDU(base::profinet::C_SDU const &value)
@@ -38,7 +45,7 @@ namespace base::profinet
 
 		base::profinet::ApduStatus ApduStatus() const
 		{
-			return base::profinet::ApduStatus();
+			return base::profinet::ApduStatus{_span[base::Range{_span.Size() - 4, _span.Size()}]};
 		}
 
 		void SetApduStatus(base::profinet::ApduStatus const &value)
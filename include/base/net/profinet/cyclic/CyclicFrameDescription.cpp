@@ -0,0 +1 @@
+#include "CyclicFrameDescription.h" // IWYU pragma: keep
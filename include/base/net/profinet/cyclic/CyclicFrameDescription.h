@@ -0,0 +1,95 @@
+#pragma once
+#include "base/net/Mac.h"
+#include <cstdint>
+#include <vector>
+
+namespace base::profinet
+{
+	///
+	/// @brief 循环帧中的一个 IO 数据对象。
+	///
+	/// @note 在帧中，数据之后紧跟 1 个字节的 IOPS.
+	///
+	struct IoDataObjectDescription
+	{
+		///
+		/// @brief 数据在 C_SDU 中的偏移量。即连接时 IOCR 块中的 FrameOffset.
+		///
+		int64_t _frame_offset = 0;
+
+		///
+		/// @brief 数据的字节数。
+		///
+		int64_t _length = 0;
+
+		///
+		/// @brief 数据在过程映像中的偏移量。
+		///
+		int64_t _image_offset = 0;
+
+		///
+		/// @brief IOPS 在过程映像中的偏移量。
+		///
+		int64_t _iops_image_offset = 0;
+	};
+
+	///
+	/// @brief 循环帧中的一个 IOCS, 即对反方向的某个 IO 数据对象的消费者状态。
+	///
+	struct IoConsumerStatusDescription
+	{
+		///
+		/// @brief IOCS 在 C_SDU 中的偏移量。
+		///
+		int64_t _frame_offset = 0;
+
+		///
+		/// @brief IOCS 在过程映像中的偏移量。
+		///
+		int64_t _image_offset = 0;
+	};
+
+	///
+	/// @brief 一个应用关系中一个方向的 RT_CLASS_1 循环帧的布局。
+	///
+	/// @note 过程映像是一段平坦的内存，应用程序按自己的需要安排各个数据和 IOxS 的位置，
+	/// 不必与帧中的顺序相同。
+	///
+	struct CyclicFrameDescription
+	{
+		base::Mac _destination_mac{};
+		base::Mac _source_mac{};
+
+		///
+		/// @brief 是否带 VLAN 标签。
+		///
+		bool _has_vlan_tag = true;
+
+		///
+		/// @brief VLAN 标签的标签控制信息。默认是优先级 6, VLAN ID 为 0.
+		///
+		uint16_t _vlan_tci = 0xc000;
+
+		///
+		/// @brief 帧 ID.
+		///
+		uint16_t _frame_id = 0x8000;
+
+		///
+		/// @brief C_SDU 的字节数。即 IOCR 块中的 DataLength, 在 40 到 1440 之间。
+		///
+		int64_t _c_sdu_length = 40;
+
+		///
+		/// @brief 每发送一帧，循环计数增加的值。
+		///
+		/// @note 循环计数的单位是 31.25us, 所以是 SendClockFactor * ReductionRatio.
+		/// 默认是 1ms.
+		///
+		uint16_t _cycle_counter_increment = 32;
+
+		std::vector<base::profinet::IoDataObjectDescription> _data_objects;
+		std::vector<base::profinet::IoConsumerStatusDescription> _consumer_statuses;
+	};
+
+} // namespace base::profinet
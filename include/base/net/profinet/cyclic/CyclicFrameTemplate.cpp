@@ -0,0 +1,274 @@
+#include "CyclicFrameTemplate.h"
+#include "base/container/Range.h"
+#include "base/net/ethernet/EthernetFrameWriter.h"
+#include "base/net/ethernet/LengthOrTypeEnum.h"
+#include "base/string/define.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+	constexpr int64_t _frame_id_size = 2;
+	constexpr int64_t _apdu_status_size = 4;
+	constexpr int64_t _min_c_sdu_length = 40;
+	constexpr int64_t _max_c_sdu_length = 1440;
+
+	uint16_t ReadUInt16(uint8_t const *p)
+	{
+		return static_cast<uint16_t>((p[0] << 8) | p[1]);
+	}
+
+	///
+	/// @brief 找到收到的 RT 帧中 C_SDU 的位置。
+	///
+	/// @param frame
+	/// @param frame_id
+	/// @param c_sdu_length
+	///
+	/// @return 以太网类型、帧 ID 不符或者帧太短时返回 -1.
+	///
+	int64_t FindCSduOffset(base::ReadOnlySpan const &frame, uint16_t frame_id, int64_t c_sdu_length)
+	{
+		if (frame.Size() < 14)
+		{
+			return -1;
+		}
+
+		uint8_t const *buffer = frame.Buffer();
+		int64_t type_offset = 12;
+		if (ReadUInt16(buffer + type_offset) == static_cast<uint16_t>(base::ethernet::LengthOrTypeEnum::VlanTag))
+		{
+			type_offset = 16;
+		}
+
+		int64_t frame_id_offset = type_offset + 2;
+		int64_t c_sdu_offset = frame_id_offset + _frame_id_size;
+		if (frame.Size() < c_sdu_offset + c_sdu_length + _apdu_status_size)
+		{
+			return -1;
+		}
+
+		if (ReadUInt16(buffer + type_offset) != static_cast<uint16_t>(base::ethernet::LengthOrTypeEnum::Profinet))
+		{
+			return -1;
+		}
+
+		if (ReadUInt16(buffer + frame_id_offset) != frame_id)
+		{
+			return -1;
+		}
+
+		return c_sdu_offset;
+	}
+
+} // namespace
+
+void base::profinet::CyclicFrameTemplate::AddRun(int64_t frame_offset, int64_t image_offset, int64_t length)
+{
+	if (frame_offset < 0 || frame_offset + length > _description._c_sdu_length)
+	{
+		throw std::invalid_argument{CODE_POS_STR + "帧偏移量 " + std::to_string(frame_offset) + " 处的 " +
+									std::to_string(length) + " 个字节超出了 C_SDU."};
+	}
+
+	if (image_offset < 0)
+	{
+		throw std::invalid_argument{CODE_POS_STR + "过程映像中的偏移量不能小于 0."};
+	}
+
+	if (length == 0)
+	{
+		return;
+	}
+
+	_runs.push_back(CopyRun{frame_offset, image_offset, length});
+	_image_size = std::max(_image_size, image_offset + length);
+}
+
+base::profinet::CyclicFrameTemplate::CyclicFrameTemplate(base::profinet::CyclicFrameDescription const &description)
+	: _description(description)
+{
+	if (_description._c_sdu_length < _min_c_sdu_length || _description._c_sdu_length > _max_c_sdu_length)
+	{
+		throw std::invalid_argument{CODE_POS_STR + "C_SDU 的长度必须在 40 到 1440 之间。"};
+	}
+
+	/* #region 整理复制的段 */
+
+	for (base::profinet::IoDataObjectDescription const &data_object : _description._data_objects)
+	{
+		if (data_object._length < 0)
+		{
+			throw std::invalid_argument{CODE_POS_STR + "数据的长度不能小于 0."};
+		}
+
+		AddRun(data_object._frame_offset, data_object._image_offset, data_object._length);
+		AddRun(data_object._frame_offset + data_object._length, data_object._iops_image_offset, 1);
+	}
+
+	for (base::profinet::IoConsumerStatusDescription const &consumer_status : _description._consumer_statuses)
+	{
+		AddRun(consumer_status._frame_offset, consumer_status._image_offset, 1);
+	}
+
+	std::sort(_runs.begin(),
+			  _runs.end(),
+			  [](CopyRun const &left, CopyRun const &right)
+			  {
+				  return left._frame_offset < right._frame_offset;
+			  });
+
+	// 帧中、过程映像中都连续的段合并成一段。
+	std::vector<CopyRun> merged_runs;
+	for (CopyRun const &run : _runs)
+	{
+		if (merged_runs.empty())
+		{
+			merged_runs.push_back(run);
+			continue;
+		}
+
+		CopyRun &last = merged_runs.back();
+		if (run._frame_offset < last._frame_offset + last._length)
+		{
+			throw std::invalid_argument{CODE_POS_STR + "帧偏移量 " + std::to_string(run._frame_offset) +
+										" 处的数据与前面的数据或 IOxS 重叠。"};
+		}
+
+		if (run._frame_offset == last._frame_offset + last._length &&
+			run._image_offset == last._image_offset + last._length)
+		{
+			last._length += run._length;
+			continue;
+		}
+
+		merged_runs.push_back(run);
+	}
+
+	_runs = std::move(merged_runs);
+
+	/* #endregion */
+
+	/* #region 写好模板帧 */
+
+	int64_t header_size = _description._has_vlan_tag ? 18 : 14;
+	_c_sdu_offset = header_size + _frame_id_size;
+	_frame_size = _c_sdu_offset + _description._c_sdu_length + _apdu_status_size;
+	_frame.resize(static_cast<size_t>(_frame_size));
+
+	base::ethernet::EthernetFrameWriter writer{base::Span{_frame.data(), _frame_size}};
+	writer.WriteDestinationMac(_description._destination_mac);
+	writer.WriteSourceMac(_description._source_mac);
+	if (_description._has_vlan_tag)
+	{
+		uint8_t vlan_tag[4] = {
+			0x81,
+			0x00,
+			static_cast<uint8_t>(_description._vlan_tci >> 8),
+			static_cast<uint8_t>(_description._vlan_tci),
+		};
+
+		writer.WriteVlanTag(base::ReadOnlySpan{vlan_tag, 4});
+	}
+
+	writer.WriteTypeOrLength(base::ethernet::LengthOrTypeEnum::Profinet);
+	writer.WritePayload(_description._frame_id, std::endian::big);
+
+	// C_SDU 中没有数据和 IOxS 的字节，包括末尾的填充，始终为 0.
+	ApduStatus().SetCycleCounter(0);
+	ApduStatus().SetDataStatus(0x35);
+	ApduStatus().SetTransferStatus(0);
+
+	/* #endregion */
+}
+
+base::profinet::RtcPdu base::profinet::CyclicFrameTemplate::RtcPdu()
+{
+	return base::profinet::RtcPdu{base::Span{_frame.data() + _c_sdu_offset,
+											 _description._c_sdu_length + _apdu_status_size}};
+}
+
+base::profinet::ApduStatus base::profinet::CyclicFrameTemplate::ApduStatus()
+{
+	return RtcPdu().ApduStatus();
+}
+
+base::ReadOnlySpan base::profinet::CyclicFrameTemplate::Build(base::ReadOnlySpan const &image)
+{
+	_cycle_counter = static_cast<uint16_t>(_cycle_counter + _description._cycle_counter_increment);
+	return Build(image, _cycle_counter);
+}
+
+base::ReadOnlySpan base::profinet::CyclicFrameTemplate::Build(base::ReadOnlySpan const &image, uint16_t cycle_counter)
+{
+	if (image.Size() < _image_size)
+	{
+		throw std::invalid_argument{CODE_POS_STR + "过程映像过小。"};
+	}
+
+	uint8_t *c_sdu = _frame.data() + _c_sdu_offset;
+	uint8_t const *image_buffer = image.Buffer();
+	for (CopyRun const &run : _runs)
+	{
+		std::memcpy(c_sdu + run._frame_offset, image_buffer + run._image_offset, static_cast<size_t>(run._length));
+	}
+
+	uint8_t *apdu_status = c_sdu + _description._c_sdu_length;
+	apdu_status[0] = static_cast<uint8_t>(cycle_counter >> 8);
+	apdu_status[1] = static_cast<uint8_t>(cycle_counter);
+	_cycle_counter = cycle_counter;
+
+	return base::ReadOnlySpan{_frame.data(), _frame_size};
+}
+
+bool base::profinet::CyclicFrameTemplate::Match(base::ReadOnlySpan const &frame) const
+{
+	return FindCSduOffset(frame, _description._frame_id, _description._c_sdu_length) >= 0;
+}
+
+bool base::profinet::CyclicFrameTemplate::Extract(base::ReadOnlySpan const &frame, base::Span const &image) const
+{
+	int64_t c_sdu_offset = FindCSduOffset(frame, _description._frame_id, _description._c_sdu_length);
+	if (c_sdu_offset < 0)
+	{
+		return false;
+	}
+
+	if (image.Size() < _image_size)
+	{
+		throw std::invalid_argument{CODE_POS_STR + "过程映像过小。"};
+	}
+
+	uint8_t const *c_sdu = frame.Buffer() + c_sdu_offset;
+	uint8_t *image_buffer = image.Buffer();
+	for (CopyRun const &run : _runs)
+	{
+		std::memcpy(image_buffer + run._image_offset, c_sdu + run._frame_offset, static_cast<size_t>(run._length));
+	}
+
+	return true;
+}
+
+uint16_t base::profinet::CyclicFrameTemplate::ReceivedCycleCounter(base::ReadOnlySpan const &frame) const
+{
+	int64_t c_sdu_offset = FindCSduOffset(frame, _description._frame_id, _description._c_sdu_length);
+	if (c_sdu_offset < 0)
+	{
+		throw std::invalid_argument{CODE_POS_STR + "不是本模板描述的帧。"};
+	}
+
+	return ReadUInt16(frame.Buffer() + c_sdu_offset + _description._c_sdu_length);
+}
+
+uint8_t base::profinet::CyclicFrameTemplate::ReceivedDataStatus(base::ReadOnlySpan const &frame) const
+{
+	int64_t c_sdu_offset = FindCSduOffset(frame, _description._frame_id, _description._c_sdu_length);
+	if (c_sdu_offset < 0)
+	{
+		throw std::invalid_argument{CODE_POS_STR + "不是本模板描述的帧。"};
+	}
+
+	return frame.Buffer()[c_sdu_offset + _description._c_sdu_length + 2];
+}
@@ -0,0 +1,181 @@
+#pragma once
+#include "base/net/profinet/ApduStatus.h"
+#include "base/net/profinet/cyclic/CyclicFrameDescription.h"
+#include "base/net/profinet/RtcPdu.h"
+#include "base/stream/ReadOnlySpan.h"
+#include "base/stream/Span.h"
+#include <cstdint>
+#include <vector>
+
+namespace base::profinet
+{
+	///
+	/// @brief 预先构造好的 RT_CLASS_1 循环帧。
+	///
+	/// @note 构造时按照 CyclicFrameDescription 写好以太网头、帧 ID、填充和 APDU 状态，
+	/// 并把数据和 IOxS 的位置整理成若干段连续的复制。每个周期只需要把过程映像中的这些段
+	/// 复制到帧中，再写入循环计数。
+	///
+	/// @note 反方向也一样：收到帧后只把这些段从帧中复制到过程映像中。
+	///
+	class CyclicFrameTemplate
+	{
+	private:
+		///
+		/// @brief 一段连续的复制。
+		///
+		struct CopyRun
+		{
+			///
+			/// @brief 在 C_SDU 中的偏移量。
+			///
+			int64_t _frame_offset = 0;
+
+			int64_t _image_offset = 0;
+			int64_t _length = 0;
+		};
+
+		base::profinet::CyclicFrameDescription _description;
+		std::vector<uint8_t> _frame;
+		int64_t _frame_size = 0;
+
+		///
+		/// @brief 本帧中 C_SDU 的偏移量。
+		///
+		int64_t _c_sdu_offset = 0;
+
+		///
+		/// @brief 过程映像至少要有这么多字节。
+		///
+		int64_t _image_size = 0;
+
+		std::vector<CopyRun> _runs;
+		uint16_t _cycle_counter = 0;
+
+		void AddRun(int64_t frame_offset, int64_t image_offset, int64_t length);
+
+	public:
+		///
+		/// @brief 构造函数。
+		///
+		/// @param description 数据、IOxS 在 C_SDU 中的范围不能超出 C_SDU, 相互之间不能重叠。
+		///
+		CyclicFrameTemplate(base::profinet::CyclicFrameDescription const &description);
+
+		///
+		/// @brief 帧的布局。
+		///
+		/// @return
+		///
+		base::profinet::CyclicFrameDescription const &Description() const
+		{
+			return _description;
+		}
+
+		///
+		/// @brief 帧 ID.
+		///
+		/// @return
+		///
+		uint16_t FrameId() const
+		{
+			return _description._frame_id;
+		}
+
+		///
+		/// @brief 过程映像至少要有多少字节。
+		///
+		/// @return
+		///
+		int64_t ImageSize() const
+		{
+			return _image_size;
+		}
+
+		///
+		/// @brief 整理后每个周期要复制的段数。
+		///
+		/// @return
+		///
+		int64_t CopyRunCount() const
+		{
+			return static_cast<int64_t>(_runs.size());
+		}
+
+		///
+		/// @brief 模板帧中的 RTC-PDU.
+		///
+		/// @return
+		///
+		base::profinet::RtcPdu RtcPdu();
+
+		///
+		/// @brief 模板帧中的 APDU 状态。
+		///
+		/// @note 可以用来修改数据状态和传输状态。默认的数据状态是 0x35, 即主站、数据有效、
+		/// 运行、站点正常。
+		///
+		/// @return
+		///
+		base::profinet::ApduStatus ApduStatus();
+
+		///
+		/// @brief 用过程映像填充帧，循环计数增加 CyclicFrameDescription::_cycle_counter_increment.
+		///
+		/// @param image 大小至少为 ImageSize.
+		///
+		/// @return 可以直接发送的以太网帧，不包括校验和。在下一次调用 Build 之前有效。
+		///
+		base::ReadOnlySpan Build(base::ReadOnlySpan const &image);
+
+		///
+		/// @brief 用过程映像填充帧，使用指定的循环计数。
+		///
+		/// @param image 大小至少为 ImageSize.
+		/// @param cycle_counter
+		///
+		/// @return 可以直接发送的以太网帧，不包括校验和。在下一次调用 Build 之前有效。
+		///
+		base::ReadOnlySpan Build(base::ReadOnlySpan const &image, uint16_t cycle_counter);
+
+		///
+		/// @brief 检查收到的帧是否是本模板描述的帧。
+		///
+		/// @note 检查以太网类型、帧 ID 和长度。带不带 VLAN 标签都可以。
+		///
+		/// @param frame 整个以太网帧，可以带有校验和。
+		///
+		/// @return
+		///
+		bool Match(base::ReadOnlySpan const &frame) const;
+
+		///
+		/// @brief 把收到的帧中的数据和 IOxS 复制到过程映像中。
+		///
+		/// @param frame 整个以太网帧，可以带有校验和。
+		/// @param image 大小至少为 ImageSize.
+		///
+		/// @return 帧不是本模板描述的帧时返回 false, 不修改 image.
+		///
+		bool Extract(base::ReadOnlySpan const &frame, base::Span const &image) const;
+
+		///
+		/// @brief 收到的帧中 APDU 状态的循环计数。
+		///
+		/// @param frame 已经 Match 的帧。
+		///
+		/// @return
+		///
+		uint16_t ReceivedCycleCounter(base::ReadOnlySpan const &frame) const;
+
+		///
+		/// @brief 收到的帧中 APDU 状态的数据状态。
+		///
+		/// @param frame 已经 Match 的帧。
+		///
+		/// @return
+		///
+		uint8_t ReceivedDataStatus(base::ReadOnlySpan const &frame) const;
+	};
+
+} // namespace base::profinet
@@ -0,0 +1,59 @@
+#include "CyclicIoEngine.h"
+#include "base/string/define.h"
+#include "base/string/ToHexString.h"
+#include <stdexcept>
+
+base::profinet::CyclicIoEngine::ApplicationRelation &base::profinet::CyclicIoEngine::Relation(int64_t index) const
+{
+	if (index < 0 || index >= static_cast<int64_t>(_relations.size()))
+	{
+		throw std::out_of_range{CODE_POS_STR + "应用关系的索引超出范围。"};
+	}
+
+	return *_relations[index];
+}
+
+int64_t base::profinet::CyclicIoEngine::AddApplicationRelation(base::profinet::CyclicFrameDescription const &output_description,
+															   base::profinet::CyclicFrameDescription const &input_description)
+{
+	for (std::unique_ptr<ApplicationRelation> const &relation : _relations)
+	{
+		if (relation->_input_template.FrameId() == input_description._frame_id)
+		{
+			throw std::invalid_argument{CODE_POS_STR + "接收方向的帧 ID " +
+										base::ToHexString(input_description._frame_id) + " 已经存在。"};
+		}
+	}
+
+	_relations.push_back(std::unique_ptr<ApplicationRelation>{
+		new ApplicationRelation{output_description, input_description},
+	});
+
+	return static_cast<int64_t>(_relations.size()) - 1;
+}
+
+base::ReadOnlySpan base::profinet::CyclicIoEngine::BuildOutputFrame(int64_t index)
+{
+	ApplicationRelation &relation = Relation(index);
+	return relation._output_template.Build(relation._output_image.ReadingSpan());
+}
+
+bool base::profinet::CyclicIoEngine::ReceiveFrame(base::ReadOnlySpan const &frame)
+{
+	// 应用关系一般只有几个，顺序查找比查表快。
+	for (std::unique_ptr<ApplicationRelation> const &relation : _relations)
+	{
+		if (!relation->_input_template.Extract(frame, relation->_input_image.WritingSpan()))
+		{
+			continue;
+		}
+
+		relation->_input_image.Publish();
+		relation->_received_cycle_counter.store(relation->_input_template.ReceivedCycleCounter(frame), std::memory_order_relaxed);
+		relation->_received_data_status.store(relation->_input_template.ReceivedDataStatus(frame), std::memory_order_relaxed);
+		relation->_received_frame_count.fetch_add(1, std::memory_order_relaxed);
+		return true;
+	}
+
+	return false;
+}
@@ -0,0 +1,183 @@
+#pragma once
+#include "base/net/profinet/cyclic/CyclicFrameDescription.h"
+#include "base/net/profinet/cyclic/CyclicFrameTemplate.h"
+#include "base/net/profinet/cyclic/ProcessImage.h"
+#include "base/stream/ReadOnlySpan.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace base::profinet
+{
+	///
+	/// @brief 循环 IO 数据引擎。
+	///
+	/// @note 每个应用关系有一个发送方向和一个接收方向的帧模板，各自带有一个过程映像：
+	/// 	@li 应用程序写输出映像并发布，发送路径每个周期调用 BuildOutputFrame 取最新发布的输出
+	/// 		映像填入帧模板。
+	/// 	@li 接收路径把收到的帧交给 ReceiveFrame, 数据写入输入映像并发布，应用程序读取输入映像。
+	///
+	/// @note 应用程序和发送、接收路径可以在不同的线程中，之间不加锁。添加应用关系要在开始循环之前。
+	///
+	class CyclicIoEngine
+	{
+	private:
+		class ApplicationRelation
+		{
+		public:
+			ApplicationRelation(base::profinet::CyclicFrameDescription const &output_description,
+								base::profinet::CyclicFrameDescription const &input_description)
+				: _output_template(output_description),
+				  _output_image(_output_template.ImageSize()),
+				  _input_template(input_description),
+				  _input_image(_input_template.ImageSize())
+			{
+			}
+
+			base::profinet::CyclicFrameTemplate _output_template;
+			base::profinet::ProcessImage _output_image;
+			base::profinet::CyclicFrameTemplate _input_template;
+			base::profinet::ProcessImage _input_image;
+
+			// 以下由接收路径写，应用程序读。
+
+			///
+			/// @brief 收到的最后一帧的循环计数。
+			///
+			std::atomic<uint16_t> _received_cycle_counter = 0;
+
+			///
+			/// @brief 收到的最后一帧的数据状态。
+			///
+			std::atomic<uint8_t> _received_data_status = 0;
+
+			std::atomic<int64_t> _received_frame_count = 0;
+		};
+
+		std::vector<std::unique_ptr<ApplicationRelation>> _relations;
+
+		ApplicationRelation &Relation(int64_t index) const;
+
+	public:
+		///
+		/// @brief 添加应用关系。
+		///
+		/// @param output_description 发送方向的帧。
+		/// @param input_description 接收方向的帧。帧 ID 不能与其他应用关系的接收方向的帧相同。
+		///
+		/// @return 应用关系的索引。
+		///
+		int64_t AddApplicationRelation(base::profinet::CyclicFrameDescription const &output_description,
+									   base::profinet::CyclicFrameDescription const &input_description);
+
+		///
+		/// @brief 应用关系的个数。
+		///
+		/// @return
+		///
+		int64_t ApplicationRelationCount() const
+		{
+			return static_cast<int64_t>(_relations.size());
+		}
+
+		/* #region 应用程序 */
+
+		///
+		/// @brief 输出映像。应用程序是写者。
+		///
+		/// @param index 应用关系的索引。
+		///
+		/// @return
+		///
+		base::profinet::ProcessImage &OutputImage(int64_t index) const
+		{
+			return Relation(index)._output_image;
+		}
+
+		///
+		/// @brief 输入映像。应用程序是读者。
+		///
+		/// @param index 应用关系的索引。
+		///
+		/// @return
+		///
+		base::profinet::ProcessImage &InputImage(int64_t index) const
+		{
+			return Relation(index)._input_image;
+		}
+
+		/* #endregion */
+
+		/* #region 发送、接收路径 */
+
+		///
+		/// @brief 发送方向的帧模板。可以用来修改数据状态。
+		///
+		/// @param index 应用关系的索引。
+		///
+		/// @return
+		///
+		base::profinet::CyclicFrameTemplate &OutputTemplate(int64_t index) const
+		{
+			return Relation(index)._output_template;
+		}
+
+		///
+		/// @brief 用最新发布的输出映像构造本周期要发送的帧。
+		///
+		/// @param index 应用关系的索引。
+		///
+		/// @return 在下一次对同一个应用关系调用本函数之前有效。
+		///
+		base::ReadOnlySpan BuildOutputFrame(int64_t index);
+
+		///
+		/// @brief 处理收到的帧。
+		///
+		/// @param frame 整个以太网帧。
+		///
+		/// @return 帧属于某个应用关系的接收方向时返回 true, 否则返回 false.
+		///
+		bool ReceiveFrame(base::ReadOnlySpan const &frame);
+
+		///
+		/// @brief 收到的最后一帧的循环计数。
+		///
+		/// @param index 应用关系的索引。
+		///
+		/// @return
+		///
+		uint16_t ReceivedCycleCounter(int64_t index) const
+		{
+			return Relation(index)._received_cycle_counter.load(std::memory_order_relaxed);
+		}
+
+		///
+		/// @brief 收到的最后一帧的数据状态。
+		///
+		/// @param index 应用关系的索引。
+		///
+		/// @return
+		///
+		uint8_t ReceivedDataStatus(int64_t index) const
+		{
+			return Relation(index)._received_data_status.load(std::memory_order_relaxed);
+		}
+
+		///
+		/// @brief 接收方向收到的帧数。
+		///
+		/// @param index 应用关系的索引。
+		///
+		/// @return
+		///
+		int64_t ReceivedFrameCount(int64_t index) const
+		{
+			return Relation(index)._received_frame_count.load(std::memory_order_relaxed);
+		}
+
+		/* #endregion */
+	};
+
+} // namespace base::profinet
@@ -0,0 +1,36 @@
+#include "ProcessImage.h"
+#include "base/string/define.h"
+#include <cstring>
+#include <stdexcept>
+
+base::profinet::ProcessImage::ProcessImage(int64_t size)
+{
+	if (size < 0)
+	{
+		throw std::invalid_argument{CODE_POS_STR + "过程映像的大小不能小于 0."};
+	}
+
+	_size = size;
+	_buffer = std::unique_ptr<uint8_t[]>{new uint8_t[3 * size]{}};
+}
+
+void base::profinet::ProcessImage::Publish()
+{
+	uint8_t published = _writing;
+	uint8_t previous = _latest.exchange(static_cast<uint8_t>(published | _fresh_flag), std::memory_order_acq_rel);
+	_writing = previous & _index_mask;
+
+	// 刚发布的缓冲区在写者再次发布之前不会被写，读者同时读它也没有关系。
+	std::memcpy(Buffer(_writing), Buffer(published), static_cast<size_t>(_size));
+}
+
+base::ReadOnlySpan base::profinet::ProcessImage::ReadingSpan()
+{
+	if (HasNewImage())
+	{
+		uint8_t previous = _latest.exchange(_reading, std::memory_order_acq_rel);
+		_reading = previous & _index_mask;
+	}
+
+	return base::ReadOnlySpan{Buffer(_reading), _size};
+}
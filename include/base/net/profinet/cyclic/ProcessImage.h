@@ -0,0 +1,113 @@
+#pragma once
+#include "base/stream/ReadOnlySpan.h"
+#include "base/stream/Span.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace base::profinet
+{
+	///
+	/// @brief 在一个写者线程和一个读者线程之间无锁地传递过程映像。
+	///
+	/// @note 双缓冲的无锁形式：除了写者正在写的和读者正在读的，还有 1 个保存最新发布的映像的
+	/// 缓冲区。发布和获取都只是一次原子交换，双方都不会等待对方，读者也不会读到写了一半的映像。
+	///
+	/// @note 发布后写者拿到的缓冲区会先复制刚发布的内容，所以写者可以只修改变化的字节。
+	///
+	class ProcessImage
+	{
+	private:
+		static constexpr uint8_t _fresh_flag = 0x4;
+		static constexpr uint8_t _index_mask = 0x3;
+
+		int64_t _size = 0;
+		std::unique_ptr<uint8_t[]> _buffer;
+
+		///
+		/// @brief 最新发布的缓冲区的索引。读者还没有取走时带有 _fresh_flag.
+		///
+		std::atomic<uint8_t> _latest{1};
+
+		///
+		/// @brief 写者正在写的缓冲区的索引。只有写者访问。
+		///
+		uint8_t _writing = 0;
+
+		///
+		/// @brief 读者正在读的缓冲区的索引。只有读者访问。
+		///
+		uint8_t _reading = 2;
+
+		uint8_t *Buffer(uint8_t index) const
+		{
+			return _buffer.get() + index * _size;
+		}
+
+	public:
+		///
+		/// @brief 构造函数。
+		///
+		/// @param size 过程映像的字节数。初始内容全为 0.
+		///
+		ProcessImage(int64_t size);
+
+		ProcessImage(ProcessImage const &other) = delete;
+		ProcessImage &operator=(ProcessImage const &other) = delete;
+
+		///
+		/// @brief 过程映像的字节数。
+		///
+		/// @return
+		///
+		int64_t Size() const
+		{
+			return _size;
+		}
+
+		/* #region 写者 */
+
+		///
+		/// @brief 写者正在写的映像。调用 Publish 之前读者看不到这里的修改。
+		///
+		/// @return
+		///
+		base::Span WritingSpan() const
+		{
+			return base::Span{Buffer(_writing), _size};
+		}
+
+		///
+		/// @brief 发布 WritingSpan 中的映像。
+		///
+		/// @note 之后 WritingSpan 返回另一个缓冲区，内容与刚发布的相同。
+		///
+		void Publish();
+
+		/* #endregion */
+
+		/* #region 读者 */
+
+		///
+		/// @brief 获取最新发布的映像。
+		///
+		/// @note 返回的内存段在下一次调用 ReadingSpan 之前保持不变。
+		///
+		/// @return
+		///
+		base::ReadOnlySpan ReadingSpan();
+
+		///
+		/// @brief 上次调用 ReadingSpan 之后是否有新发布的映像。
+		///
+		/// @return
+		///
+		bool HasNewImage() const
+		{
+			return (_latest.load(std::memory_order_relaxed) & _fresh_flag) != 0;
+		}
+
+		/* #endregion */
+	};
+
+} // namespace base::profinet
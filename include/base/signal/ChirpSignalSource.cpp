@@ -0,0 +1,96 @@
+#include "ChirpSignalSource.h"
+#include "base/math/math.h"
+#include "base/string/define.h"
+#include <stdexcept>
+
+void base::ChirpSignalSource::Advance(double &phase, int64_t &sweep_index) const
+{
+	// 每个采样前进的周期数由索引直接算出，不在扫频过程中累加，避免舍入误差累积。
+	phase += _start_increment + _increment_step * static_cast<double>(sweep_index);
+	phase -= static_cast<double>(static_cast<int32_t>(phase));
+
+	sweep_index++;
+	if (sweep_index == _sweep_sample_count)
+	{
+		sweep_index = 0;
+	}
+}
+
+base::ChirpSignalSource::ChirpSignalSource(base::unit::Hz start_frequency,
+										   base::unit::Hz end_frequency,
+										   base::unit::Second sweep_duration)
+	: _start_frequency(start_frequency),
+	  _end_frequency(end_frequency),
+	  _sweep_duration(sweep_duration)
+{
+	if (_start_frequency.Value() < 0 || _end_frequency.Value() < 0)
+	{
+		throw std::invalid_argument{CODE_POS_STR + "频率不能 < 0."};
+	}
+}
+
+base::unit::Second base::ChirpSignalSource::SampleInterval() const
+{
+	return _sample_interval;
+}
+
+void base::ChirpSignalSource::Open(base::unit::Second const &sample_interval)
+{
+	_sample_interval = sample_interval;
+
+	int64_t sweep_sample_count = static_cast<int64_t>(_sweep_duration.Value() / _sample_interval.Value());
+	if (sweep_sample_count < 1)
+	{
+		throw std::invalid_argument{CODE_POS_STR + "sample_interval 不能大于扫频时长。"};
+	}
+
+	// 频率乘以采样间隔就是每个采样前进的周期数。
+	double start_increment = static_cast<double>(_start_frequency.Value() * _sample_interval.Value());
+	double end_increment = static_cast<double>(_end_frequency.Value() * _sample_interval.Value());
+
+	_sweep_sample_count = sweep_sample_count;
+	_start_increment = start_increment - static_cast<double>(static_cast<int64_t>(start_increment));
+	_increment_step = (end_increment - start_increment) / static_cast<double>(sweep_sample_count);
+	_phase = 0;
+	_sweep_index = 0;
+	_opened = true;
+}
+
+double base::ChirpSignalSource::Sample()
+{
+	if (!_opened)
+	{
+		throw std::runtime_error{CODE_POS_STR + "打开后才能采样。"};
+	}
+
+	double sample_value = base::sin_2pi(_phase);
+	Advance(_phase, _sweep_index);
+	return sample_value;
+}
+
+void base::ChirpSignalSource::Sample(base::ArraySpan<double> const &samples)
+{
+	if (!_opened)
+	{
+		throw std::runtime_error{CODE_POS_STR + "打开后才能采样。"};
+	}
+
+	// 相位和索引放在局部变量中。如果直接累加字段，写 buffer 时编译器认为可能改变了字段，
+	// 每次迭代都要重新读写内存。
+	double *buffer = samples.Buffer();
+	double phase = _phase;
+	int64_t sweep_index = _sweep_index;
+	for (int64_t i = 0; i < samples.Count(); i++)
+	{
+		buffer[i] = phase;
+		Advance(phase, sweep_index);
+	}
+
+	_phase = phase;
+	_sweep_index = sweep_index;
+
+	for (int64_t i = 0; i < samples.Count(); i++)
+	{
+		buffer[i] = base::sin_2pi(buffer[i]);
+	}
+}
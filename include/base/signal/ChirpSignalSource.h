@@ -0,0 +1,95 @@
+#pragma once
+#include "base/signal/ISignalSource.h"
+#include "base/unit/Hz.h"
+#include <cstdint>
+
+namespace base
+{
+	///
+	/// @brief 线性调频（扫频）正弦信号源。
+	///
+	/// @note 频率在 sweep_duration 内从 start_frequency 线性变化到 end_frequency,
+	/// 然后回到 start_frequency 重新扫频。相位始终连续。
+	///
+	/// @note 使用步骤与 base::SinSignalSource 相同：构造，打开，采样。
+	///
+	class ChirpSignalSource final :
+		public base::ISignalSource<double>
+	{
+	private:
+		base::unit::Second _sample_interval{base::Fraction{1, 10}};
+		base::unit::Hz _start_frequency;
+		base::unit::Hz _end_frequency;
+		base::unit::Second _sweep_duration;
+		bool _opened = false;
+
+		// 以下字段在 Open 时计算，单位都是“周期”和“采样”。
+
+		// 一次扫频的采样数。
+		int64_t _sweep_sample_count = 1;
+
+		// 扫频起点每个采样前进的周期数。
+		double _start_increment = 0;
+
+		// 每个采样后，每采样前进的周期数的增量。
+		double _increment_step = 0;
+
+		// 当前相位，范围 [0, 1).
+		double _phase = 0;
+
+		// 当前采样在本次扫频中的索引。
+		int64_t _sweep_index = 0;
+
+		///
+		/// @brief 相位前进一个采样。
+		///
+		/// @param phase 当前相位。
+		/// @param sweep_index 当前采样在本次扫频中的索引。
+		///
+		void Advance(double &phase, int64_t &sweep_index) const;
+
+	public:
+		///
+		/// @brief 构造一个扫频信号源。
+		///
+		/// @param start_frequency 扫频起始频率。
+		/// @param end_frequency 扫频结束频率。
+		/// @param sweep_duration 一次扫频的时长。
+		///
+		ChirpSignalSource(base::unit::Hz start_frequency,
+						  base::unit::Hz end_frequency,
+						  base::unit::Second sweep_duration);
+
+		///
+		/// @brief 采样间隔。
+		///
+		/// @return base::unit::Second
+		///
+		virtual base::unit::Second SampleInterval() const override;
+
+		///
+		/// @brief 打开采样器。
+		///
+		/// @param sample_interval 必须不大于 sweep_duration.
+		///
+		virtual void Open(base::unit::Second const &sample_interval) override;
+
+		///
+		/// @brief 采样一次。
+		///
+		/// @return double 采样值。
+		///
+		virtual double Sample() override;
+
+		///
+		/// @brief 连续采样，填满 samples.
+		///
+		/// @note 先逐个累加出相位，再对整个块计算 base::sin_2pi. 后者没有依赖，可以向量化。
+		/// 结果与逐个调用 Sample() 相同。
+		///
+		/// @param samples
+		///
+		virtual void Sample(base::ArraySpan<double> const &samples) override;
+	};
+
+} // namespace base
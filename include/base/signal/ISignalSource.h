@@ -1,4 +1,5 @@
 #pragma once
+#include "base/container/ArraySpan.h"
 #include "base/unit/Second.h"
 
 namespace base
@@ -34,5 +35,21 @@ namespace base
 		/// @return SignalType 采样值。
 		///
 		virtual SignalType Sample() = 0;
+
+		///
+		/// @brief 连续采样，填满 samples.
+		///
+		/// @note 相当于连续调用 samples.Count() 次 Sample(). 默认实现就是逐个调用 Sample(),
+		/// 派生类可以重写为成块生成。
+		///
+		/// @param samples 接收采样值。
+		///
+		virtual void Sample(base::ArraySpan<SignalType> const &samples)
+		{
+			for (int64_t i = 0; i < samples.Count(); i++)
+			{
+				samples[i] = Sample();
+			}
+		}
 	};
 } // namespace base
@@ -0,0 +1,59 @@
+#include "NoiseSignalSource.h"
+#include "base/string/define.h"
+#include <random>
+#include <stdexcept>
+
+namespace
+{
+	uint64_t CreateSeed()
+	{
+		std::random_device rd{};
+		return (static_cast<uint64_t>(rd()) << 32) | rd();
+	}
+
+} // namespace
+
+base::NoiseSignalSource::NoiseSignalSource()
+	: _generator(CreateSeed())
+{
+}
+
+base::NoiseSignalSource::NoiseSignalSource(uint64_t seed)
+	: _generator(seed)
+{
+}
+
+base::unit::Second base::NoiseSignalSource::SampleInterval() const
+{
+	return _sample_interval;
+}
+
+void base::NoiseSignalSource::Open(base::unit::Second const &sample_interval)
+{
+	_opened = true;
+	_sample_interval = sample_interval;
+}
+
+double base::NoiseSignalSource::Sample()
+{
+	if (!_opened)
+	{
+		throw std::runtime_error{CODE_POS_STR + "打开后才能采样。"};
+	}
+
+	return ToSample(_generator.Next());
+}
+
+void base::NoiseSignalSource::Sample(base::ArraySpan<double> const &samples)
+{
+	if (!_opened)
+	{
+		throw std::runtime_error{CODE_POS_STR + "打开后才能采样。"};
+	}
+
+	double *buffer = samples.Buffer();
+	for (int64_t i = 0; i < samples.Count(); i++)
+	{
+		buffer[i] = ToSample(_generator.Next());
+	}
+}
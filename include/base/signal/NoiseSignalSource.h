@@ -0,0 +1,76 @@
+#pragma once
+#include "base/math/Xoshiro256PlusPlus.h"
+#include "base/signal/ISignalSource.h"
+#include <cstdint>
+
+namespace base
+{
+	///
+	/// @brief 白噪声信号源。采样值均匀分布在 [-1, 1) 内。
+	///
+	/// @note 使用 base::Xoshiro256PlusPlus 生成。用同一个种子构造的信号源产生相同的序列，
+	/// 便于重现测试。
+	///
+	class NoiseSignalSource final :
+		public base::ISignalSource<double>
+	{
+	private:
+		base::unit::Second _sample_interval{base::Fraction{1, 10}};
+		base::Xoshiro256PlusPlus _generator;
+		bool _opened = false;
+
+		///
+		/// @brief 把随机数映射到 [-1, 1).
+		///
+		/// @param random
+		/// @return
+		///
+		static double ToSample(uint64_t random)
+		{
+			// 高 53 位映射到 [0, 1), 再映射到 [-1, 1).
+			return static_cast<double>(random >> 11) * 0x1p-52 - 1;
+		}
+
+	public:
+		///
+		/// @brief 用随机种子构造。
+		///
+		NoiseSignalSource();
+
+		///
+		/// @brief 用指定的种子构造。
+		///
+		/// @param seed
+		///
+		NoiseSignalSource(uint64_t seed);
+
+		///
+		/// @brief 采样间隔。
+		///
+		/// @return base::unit::Second
+		///
+		virtual base::unit::Second SampleInterval() const override;
+
+		///
+		/// @brief 打开采样器。
+		///
+		/// @param sample_interval
+		///
+		virtual void Open(base::unit::Second const &sample_interval) override;
+
+		///
+		/// @brief 采样一次。
+		///
+		/// @return double 采样值。
+		///
+		virtual double Sample() override;
+
+		///
+		/// @brief 连续采样，填满 samples.
+		///
+		/// @param samples
+		///
+		virtual void Sample(base::ArraySpan<double> const &samples) override;
+	};
+
+} // namespace base
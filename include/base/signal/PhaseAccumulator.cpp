@@ -0,0 +1,16 @@
+#include "PhaseAccumulator.h"
+#include "base/string/define.h"
+#include <stdexcept>
+
+void base::PhaseAccumulator::SetIncrement(base::Fraction const &cycles_per_sample)
+{
+	if (cycles_per_sample < 0)
+	{
+		throw std::invalid_argument{CODE_POS_STR + "cycles_per_sample 不能 < 0."};
+	}
+
+	// 去掉整数部分，再乘以 2^64 取整。
+	base::Fraction fractional_part = cycles_per_sample - base::Fraction{cycles_per_sample.Floor()};
+	base::BigInteger increment = (fractional_part * base::Fraction{base::BigInteger{1} << 64}).Div();
+	_increment = static_cast<uint64_t>(increment);
+}
@@ -0,0 +1,131 @@
+#pragma once
+#include "base/container/ArraySpan.h"
+#include "base/math/Fraction.h"
+#include <algorithm>
+#include <cstdint>
+
+namespace base
+{
+	///
+	/// @brief 相位累加器。
+	///
+	/// @note 相位用 uint64_t 表示，2^64 对应一个周期，溢出回绕正好就是减去整数个周期，
+	/// 不需要判断和取模。每次采样只需一次整数加法，不需要 base::Fraction 运算。
+	///
+	/// @note 步进由 base::Fraction 精确计算后截断到 2^-64 个周期，每个采样的相位误差小于
+	/// 2^-64 个周期，累积 10^9 个采样也不到 10^-10 个周期。
+	///
+	class PhaseAccumulator final
+	{
+	private:
+		uint64_t _phase = 0;
+		uint64_t _increment = 0;
+
+	public:
+		///
+		/// @brief 无参构造。相位和步进都为 0.
+		///
+		PhaseAccumulator() = default;
+
+		///
+		/// @brief 设置每个采样前进的周期数。
+		///
+		/// @note 只有小数部分有意义，整数部分会被去掉。
+		///
+		/// @param cycles_per_sample 通常是采样间隔除以信号周期。不能 < 0.
+		///
+		void SetIncrement(base::Fraction const &cycles_per_sample);
+
+		///
+		/// @brief 当前相位。2^64 对应一个周期。
+		///
+		/// @return
+		///
+		uint64_t Phase() const
+		{
+			return _phase;
+		}
+
+		///
+		/// @brief 每个采样前进的相位。2^64 对应一个周期。
+		///
+		/// @return
+		///
+		uint64_t Increment() const
+		{
+			return _increment;
+		}
+
+		///
+		/// @brief 当前相位，单位：周期。范围 [0, 1).
+		///
+		/// @return
+		///
+		double PhaseInCycles() const
+		{
+			// 只取高 53 位，刚好是 double 的精度，转换是精确的。
+			return static_cast<double>(_phase >> 11) * 0x1p-53;
+		}
+
+		///
+		/// @brief 每个采样前进的周期数。范围 [0, 1).
+		///
+		/// @return
+		///
+		double IncrementInCycles() const
+		{
+			return static_cast<double>(_increment >> 11) * 0x1p-53;
+		}
+
+		///
+		/// @brief 前进 count 个采样。
+		///
+		/// @param count
+		///
+		void Advance(int64_t count)
+		{
+			// 无符号乘法和加法溢出回绕，结果就是模 2^64.
+			_phase += _increment * static_cast<uint64_t>(count);
+		}
+
+		///
+		/// @brief 用 func(相位) 填充 samples, 每个采样前进一次。
+		///
+		/// @note 分成 64 个采样的块，块的起点取精确的相位，块内相位用 double 递推，块不能太长，
+		/// 否则 i * increment 的舍入误差会变大。
+		///
+		/// @param samples
+		/// @param func 参数是相位，单位：周期。范围 [0, 65), 块内不去掉整数部分，需要的话由
+		/// func 自己去掉。
+		///
+		template <typename FuncType>
+		void Fill(base::ArraySpan<double> const &samples, FuncType const &func)
+		{
+			constexpr int64_t block_size = 64;
+
+			double *buffer = samples.Buffer();
+			double increment = IncrementInCycles();
+			for (int64_t offset = 0; offset < samples.Count(); offset += block_size)
+			{
+				// 块内用 int32_t 索引，转为 double 有向量指令。
+				int32_t count = static_cast<int32_t>(std::min(block_size, samples.Count() - offset));
+				double start = PhaseInCycles();
+				for (int32_t i = 0; i < count; i++)
+				{
+					buffer[offset + i] = func(start + static_cast<double>(i) * increment);
+				}
+
+				Advance(count);
+			}
+		}
+
+		///
+		/// @brief 相位回到 0.
+		///
+		void Reset()
+		{
+			_phase = 0;
+		}
+	};
+
+} // namespace base
@@ -1,10 +1,10 @@
 #include "SinSignalSource.h"
+#include "base/math/math.h"
 #include "base/string/define.h"
-#include <math.h>
 #include <stdexcept>
 
 base::SinSignalSource::SinSignalSource(base::unit::Second sin_periodic)
-	: _sample_clock(sin_periodic)
+	: _period(sin_periodic)
 {
 }
 
@@ -17,6 +17,12 @@ void base::SinSignalSource::Open(base::unit::Second const &sample_interval)
 {
 	_opened = true;
 	_sample_interval = sample_interval;
+
+	// y = sin(w * t)
+	// w = 2pi / T
+	// y = sin(2pi * t / T)
+	// 每个采样前进 sample_interval / T 个周期。
+	_phase.SetIncrement(_sample_interval.Value() / _period.Value());
 }
 
 double base::SinSignalSource::Sample()
@@ -26,13 +32,21 @@ double base::SinSignalSource::Sample()
 		throw std::runtime_error{CODE_POS_STR + "打开后才能采样。"};
 	}
 
-	// y = sin(w * t)
-	// w = 2pi / T
-	// y = sin(2pi / T * t)
-	double sample_value = sin(2 * M_PI *
-							  static_cast<double>(_sample_clock.CurrentTime()) /
-							  static_cast<double>(_sample_clock.Period()));
-
-	_sample_clock += _sample_interval;
+	double sample_value = base::sin_2pi(_phase.PhaseInCycles());
+	_phase.Advance(1);
 	return sample_value;
 }
+
+void base::SinSignalSource::Sample(base::ArraySpan<double> const &samples)
+{
+	if (!_opened)
+	{
+		throw std::runtime_error{CODE_POS_STR + "打开后才能采样。"};
+	}
+
+	_phase.Fill(samples,
+	            [](double cycles)
+	            {
+		            return base::sin_2pi(cycles);
+	            });
+}
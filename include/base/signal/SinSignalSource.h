@@ -1,6 +1,6 @@
 #pragma once
 #include "base/signal/ISignalSource.h"
-#include "base/signal/PeriodicSamplingClock.h"
+#include "base/signal/PhaseAccumulator.h"
 
 namespace base
 {
@@ -13,12 +13,16 @@ namespace base
 	/// 	@li 打开
 	/// 	@li 开始采样
 	///
+	/// @note 相位由 base::PhaseAccumulator 累加，正弦值由 base::sin_2pi 计算，
+	/// 采样过程中没有 base::Fraction 运算。
+	///
 	class SinSignalSource final :
 		public base::ISignalSource<double>
 	{
 	private:
 		base::unit::Second _sample_interval{base::Fraction{1, 10}};
-		PeriodicSamplingClock _sample_clock;
+		base::unit::Second _period;
+		base::PhaseAccumulator _phase;
 		bool _opened = false;
 
 	public:
@@ -51,5 +55,16 @@ namespace base
 		/// @return double 采样值。
 		///
 		virtual double Sample() override;
+
+		///
+		/// @brief 连续采样，填满 samples.
+		///
+		/// @note 分块计算，每块内各采样的相位由块起点加上步进的整数倍得到，
+		/// 循环体没有依赖，编译器可以向量化。块内相位用 double 计算，与逐个调用 Sample()
+		/// 的结果有 1e-15 量级的舍入差异。
+		///
+		/// @param samples
+		///
+		virtual void Sample(base::ArraySpan<double> const &samples) override;
 	};
 } // namespace base
@@ -0,0 +1,59 @@
+#include "SquareSignalSource.h"
+#include "base/string/define.h"
+#include <stdexcept>
+
+double base::SquareSignalSource::ValueAt(double cycles) const
+{
+	// 比较结果转为 0 或 1 再映射到 -1 或 1, 不用条件表达式，循环中可以向量化。
+	return 2 * static_cast<double>(cycles < _duty_cycle) - 1;
+}
+
+base::SquareSignalSource::SquareSignalSource(base::unit::Second period, double duty_cycle)
+	: _period(period),
+	  _duty_cycle(duty_cycle)
+{
+	if (duty_cycle < 0 || duty_cycle > 1)
+	{
+		throw std::invalid_argument{CODE_POS_STR + "duty_cycle 的范围是 [0, 1]."};
+	}
+}
+
+base::unit::Second base::SquareSignalSource::SampleInterval() const
+{
+	return _sample_interval;
+}
+
+void base::SquareSignalSource::Open(base::unit::Second const &sample_interval)
+{
+	_opened = true;
+	_sample_interval = sample_interval;
+	_phase.SetIncrement(_sample_interval.Value() / _period.Value());
+}
+
+double base::SquareSignalSource::Sample()
+{
+	if (!_opened)
+	{
+		throw std::runtime_error{CODE_POS_STR + "打开后才能采样。"};
+	}
+
+	double sample_value = ValueAt(_phase.PhaseInCycles());
+	_phase.Advance(1);
+	return sample_value;
+}
+
+void base::SquareSignalSource::Sample(base::ArraySpan<double> const &samples)
+{
+	if (!_opened)
+	{
+		throw std::runtime_error{CODE_POS_STR + "打开后才能采样。"};
+	}
+
+	_phase.Fill(samples,
+	            [this](double cycles)
+	            {
+		            // 块内相位不超过 65 个周期，转为 int32_t 去掉整数部分。
+		            cycles -= static_cast<double>(static_cast<int32_t>(cycles));
+		            return ValueAt(cycles);
+	            });
+}
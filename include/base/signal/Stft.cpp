@@ -0,0 +1 @@
+#include "Stft.h" // IWYU pragma: keep
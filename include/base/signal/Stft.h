@@ -0,0 +1,179 @@
+#pragma once
+#include "base/container/ArraySpan.h"
+#include "base/container/CircleDeque.h"
+#include "base/container/ReadOnlyArraySpan.h"
+#include "base/math/RealFft.h"
+#include "base/signal/window.h"
+#include "base/string/define.h"
+#include <complex>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <vector>
+
+namespace base
+{
+	///
+	/// @brief 流式短时傅里叶变换。
+	///
+	/// @note 采样逐个输入，最近的 WindowSize 个采样保存在 base::CircleDeque 中。
+	/// 窗口第一次填满后输出一帧，此后每输入 hop_size 个采样输出一帧。
+	/// 每帧乘以 Hann 窗后做实数 FFT, 得到 WindowSize / 2 + 1 点的频谱。
+	///
+	/// @note FFT 计划、窗函数、帧缓冲区在构造时分配好，输入过程中不再分配内存。
+	///
+	template <int64_t WindowSize>
+		requires(WindowSize >= 2 && WindowSize % 2 == 0)
+	class Stft
+	{
+	private:
+		base::CircleDeque<double, WindowSize> _samples;
+		base::RealFft _fft{WindowSize};
+		std::vector<double> _window = base::hann_window(WindowSize);
+		std::vector<double> _frame = std::vector<double>(WindowSize);
+		std::vector<std::complex<double>> _spectrum = std::vector<std::complex<double>>(WindowSize / 2 + 1);
+		int64_t _hop_size = 1;
+
+		// 窗口满后，再输入几个采样输出下一帧。
+		int64_t _samples_until_frame = 1;
+
+		int64_t _frame_count = 0;
+
+		void ComputeFrame()
+		{
+			for (int64_t i = 0; i < WindowSize; i++)
+			{
+				_frame[i] = _samples[i] * _window[i];
+			}
+
+			_fft.Forward(base::ReadOnlyArraySpan<double>{_frame.data(), WindowSize},
+						 base::ArraySpan<std::complex<double>>{_spectrum.data(), WindowSize / 2 + 1});
+
+			_frame_count++;
+		}
+
+	public:
+		///
+		/// @brief 构造。
+		///
+		/// @param hop_size 相邻两帧的起点相隔的采样数。范围 [1, WindowSize].
+		///
+		Stft(int64_t hop_size)
+		{
+			if (hop_size < 1 || hop_size > WindowSize)
+			{
+				throw std::invalid_argument{CODE_POS_STR + "hop_size 必须在 [1, WindowSize] 范围内。"};
+			}
+
+			_hop_size = hop_size;
+		}
+
+		///
+		/// @brief 窗长。
+		///
+		/// @return
+		///
+		static constexpr int64_t WindowLength()
+		{
+			return WindowSize;
+		}
+
+		///
+		/// @brief 相邻两帧的起点相隔的采样数。
+		///
+		/// @return
+		///
+		int64_t HopSize() const
+		{
+			return _hop_size;
+		}
+
+		///
+		/// @brief 已经输出的帧数。
+		///
+		/// @return
+		///
+		int64_t FrameCount() const
+		{
+			return _frame_count;
+		}
+
+		///
+		/// @brief 输入一个采样。
+		///
+		/// @param sample
+		/// @return 这次输入产生了新的一帧时返回 true, 通过 Spectrum 获取。
+		///
+		bool Input(double sample)
+		{
+			if (_samples.IsFull())
+			{
+				_samples.PopFront();
+			}
+
+			_samples.PushBack(sample);
+			if (!_samples.IsFull())
+			{
+				return false;
+			}
+
+			_samples_until_frame--;
+			if (_samples_until_frame > 0)
+			{
+				return false;
+			}
+
+			_samples_until_frame = _hop_size;
+			ComputeFrame();
+			return true;
+		}
+
+		///
+		/// @brief 输入一段采样，每产生一帧调用一次 on_frame.
+		///
+		/// @param samples
+		/// @param on_frame 参数是这一帧的频谱。
+		/// @return 产生的帧数。
+		///
+		int64_t Input(base::ReadOnlyArraySpan<double> const &samples,
+					  std::function<void(base::ReadOnlyArraySpan<std::complex<double>> const &)> const &on_frame)
+		{
+			int64_t count = 0;
+			for (int64_t i = 0; i < samples.Count(); i++)
+			{
+				if (Input(samples[i]))
+				{
+					count++;
+					if (on_frame)
+					{
+						on_frame(Spectrum());
+					}
+				}
+			}
+
+			return count;
+		}
+
+		///
+		/// @brief 最近一帧的频谱，共 WindowSize / 2 + 1 个点。第 k 个点的频率为
+		/// k / WindowSize 乘以采样率。
+		///
+		/// @return
+		///
+		base::ReadOnlyArraySpan<std::complex<double>> Spectrum() const
+		{
+			return base::ReadOnlyArraySpan<std::complex<double>>{_spectrum.data(), WindowSize / 2 + 1};
+		}
+
+		///
+		/// @brief 清空窗口，从头开始。
+		///
+		void Reset()
+		{
+			_samples.Clear();
+			_samples_until_frame = 1;
+			_frame_count = 0;
+		}
+	};
+
+} // namespace base
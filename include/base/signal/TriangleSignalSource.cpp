@@ -0,0 +1,58 @@
+#include "TriangleSignalSource.h"
+#include "base/string/define.h"
+#include <cmath>
+#include <stdexcept>
+
+double base::TriangleSignalSource::ValueAt(double cycles) const
+{
+	// 峰值在 0.25 + k 处。离最近的峰值的距离为 d 时，值为 1 - 4d.
+	// w >= -0.25, w + 0.5 > 0, 截断就是向下取整，得到离 w 最近的整数。
+	double w = cycles - 0.25;
+	double d = std::abs(w - static_cast<double>(static_cast<int32_t>(w + 0.5)));
+	return 1 - 4 * d;
+}
+
+base::TriangleSignalSource::TriangleSignalSource(base::unit::Second period)
+	: _period(period)
+{
+}
+
+base::unit::Second base::TriangleSignalSource::SampleInterval() const
+{
+	return _sample_interval;
+}
+
+void base::TriangleSignalSource::Open(base::unit::Second const &sample_interval)
+{
+	_opened = true;
+	_sample_interval = sample_interval;
+	_phase.SetIncrement(_sample_interval.Value() / _period.Value());
+}
+
+double base::TriangleSignalSource::Sample()
+{
+	if (!_opened)
+	{
+		throw std::runtime_error{CODE_POS_STR + "打开后才能采样。"};
+	}
+
+	double sample_value = ValueAt(_phase.PhaseInCycles());
+	_phase.Advance(1);
+	return sample_value;
+}
+
+void base::TriangleSignalSource::Sample(base::ArraySpan<double> const &samples)
+{
+	if (!_opened)
+	{
+		throw std::runtime_error{CODE_POS_STR + "打开后才能采样。"};
+	}
+
+	_phase.Fill(samples,
+	            [this](double cycles)
+	            {
+		            // 块内相位不超过 65 个周期，转为 int32_t 去掉整数部分。
+		            cycles -= static_cast<double>(static_cast<int32_t>(cycles));
+		            return ValueAt(cycles);
+	            });
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include "base/signal/ISignalSource.h"
+#include "base/signal/PhaseAccumulator.h"
+
+namespace base
+{
+	///
+	/// @brief 三角波信号源。与 sin 同相位：从 0 开始上升，1/4 周期处为 1, 3/4 周期处为 -1.
+	///
+	/// @note 使用步骤与 base::SinSignalSource 相同：构造，打开，采样。
+	///
+	class TriangleSignalSource final :
+		public base::ISignalSource<double>
+	{
+	private:
+		base::unit::Second _sample_interval{base::Fraction{1, 10}};
+		base::unit::Second _period;
+		base::PhaseAccumulator _phase;
+		bool _opened = false;
+
+		///
+		/// @brief 相位为 cycles 个周期时的信号值。
+		///
+		/// @param cycles 范围 [0, 1).
+		/// @return
+		///
+		double ValueAt(double cycles) const;
+
+	public:
+		///
+		/// @brief 构造一个三角波信号源。
+		///
+		/// @param period 三角波的周期。
+		///
+		TriangleSignalSource(base::unit::Second period);
+
+		///
+		/// @brief 采样间隔。
+		///
+		/// @return base::unit::Second
+		///
+		virtual base::unit::Second SampleInterval() const override;
+
+		///
+		/// @brief 打开采样器。
+		///
+		/// @param sample_interval
+		///
+		virtual void Open(base::unit::Second const &sample_interval) override;
+
+		///
+		/// @brief 采样一次。
+		///
+		/// @return double 采样值。
+		///
+		virtual double Sample() override;
+
+		///
+		/// @brief 连续采样，填满 samples.
+		///
+		/// @param samples
+		///
+		virtual void Sample(base::ArraySpan<double> const &samples) override;
+	};
+
+} // namespace base
@@ -0,0 +1,102 @@
+#include "WelchPsd.h" // IWYU pragma: keep
+#include "base/signal/window.h"
+#include "base/string/define.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace
+{
+	int64_t CheckSegmentSize(int64_t segment_size)
+	{
+		if (segment_size < 2 || segment_size % 2 != 0)
+		{
+			throw std::invalid_argument{CODE_POS_STR + "segment_size 必须是 >= 2 的偶数。"};
+		}
+
+		return segment_size;
+	}
+
+} // namespace
+
+base::WelchPsd::WelchPsd(int64_t segment_size, int64_t overlap, base::unit::Hz const &sample_rate)
+	: _segment_size(CheckSegmentSize(segment_size)),
+	  _fft(segment_size)
+{
+	if (overlap < 0 || overlap >= segment_size)
+	{
+		throw std::invalid_argument{CODE_POS_STR + "overlap 必须在 [0, segment_size) 范围内。"};
+	}
+
+	_sample_rate = static_cast<double>(sample_rate);
+	if (_sample_rate <= 0)
+	{
+		throw std::invalid_argument{CODE_POS_STR + "sample_rate 必须 > 0."};
+	}
+
+	_overlap = overlap;
+	_window = base::hann_window(segment_size);
+	for (double w : _window)
+	{
+		_window_power += w * w;
+	}
+
+	_segment.resize(segment_size);
+	_spectrum.resize(PsdSize());
+}
+
+int64_t base::WelchPsd::Compute(base::ReadOnlyArraySpan<double> const &signal,
+								base::ArraySpan<double> const &psd)
+{
+	if (signal.Count() < _segment_size)
+	{
+		throw std::invalid_argument{CODE_POS_STR + "signal 的采样数不能 < segment_size."};
+	}
+
+	if (psd.Count() != PsdSize())
+	{
+		throw std::invalid_argument{CODE_POS_STR + "psd 的元素个数必须等于 segment_size / 2 + 1."};
+	}
+
+	double *out = psd.Buffer();
+	std::fill(out, out + PsdSize(), 0.0);
+
+	int64_t hop = _segment_size - _overlap;
+	int64_t segment_count = 0;
+	double const *window = _window.data();
+	double *segment = _segment.data();
+	for (int64_t start = 0; start + _segment_size <= signal.Count(); start += hop)
+	{
+		double const *x = signal.Buffer() + start;
+		for (int64_t i = 0; i < _segment_size; i++)
+		{
+			segment[i] = x[i] * window[i];
+		}
+
+		_fft.Forward(base::ReadOnlyArraySpan<double>{segment, _segment_size},
+					 base::ArraySpan<std::complex<double>>{_spectrum.data(), PsdSize()});
+
+		double const *spectrum = reinterpret_cast<double const *>(_spectrum.data());
+		for (int64_t k = 0; k < PsdSize(); k++)
+		{
+			double re = spectrum[2 * k];
+			double im = spectrum[2 * k + 1];
+			out[k] += re * re + im * im;
+		}
+
+		segment_count++;
+	}
+
+	double scale = 1.0 / (_sample_rate * _window_power * static_cast<double>(segment_count));
+	for (int64_t k = 0; k < PsdSize(); k++)
+	{
+		out[k] *= scale;
+	}
+
+	// 单边谱：负频率的能量折算到正频率上。直流和奈奎斯特频率没有对应的负频率点。
+	for (int64_t k = 1; k < PsdSize() - 1; k++)
+	{
+		out[k] *= 2;
+	}
+
+	return segment_count;
+}
@@ -0,0 +1,100 @@
+#pragma once
+#include "base/container/ArraySpan.h"
+#include "base/container/ReadOnlyArraySpan.h"
+#include "base/math/RealFft.h"
+#include "base/unit/Hz.h"
+#include <complex>
+#include <cstdint>
+#include <vector>
+
+namespace base
+{
+	///
+	/// @brief 用 Welch 法估计单边功率谱密度。
+	///
+	/// @note 把信号分成相互重叠的段，每段乘以 Hann 窗后做实数 FFT, 对各段的 |X|^2 取平均，
+	/// 再除以 采样率 * sum(w^2) 得到密度，除直流和奈奎斯特频率外的点乘以 2 折算成单边谱。
+	/// 与 scipy.signal.welch 的 density 缩放相同。
+	///
+	/// @note 在各频点上对结果乘以频率分辨率再求和，约等于信号的均方值。
+	///
+	class WelchPsd
+	{
+	private:
+		int64_t _segment_size = 0;
+		int64_t _overlap = 0;
+		double _sample_rate = 0;
+		base::RealFft _fft;
+		std::vector<double> _window;
+		double _window_power = 0;
+		std::vector<double> _segment;
+		std::vector<std::complex<double>> _spectrum;
+
+	public:
+		///
+		/// @brief 构造。
+		///
+		/// @param segment_size 每段的采样数。必须是 >= 2 的偶数。
+		/// @param overlap 相邻两段重叠的采样数。范围 [0, segment_size).
+		/// @param sample_rate 采样率。必须 > 0.
+		///
+		WelchPsd(int64_t segment_size, int64_t overlap, base::unit::Hz const &sample_rate);
+
+		WelchPsd(WelchPsd const &o) = delete;
+		WelchPsd &operator=(WelchPsd const &o) = delete;
+
+		///
+		/// @brief 每段的采样数。
+		///
+		/// @return
+		///
+		int64_t SegmentSize() const
+		{
+			return _segment_size;
+		}
+
+		///
+		/// @brief 相邻两段重叠的采样数。
+		///
+		/// @return
+		///
+		int64_t Overlap() const
+		{
+			return _overlap;
+		}
+
+		///
+		/// @brief 功率谱密度的点数，即 SegmentSize() / 2 + 1.
+		///
+		/// @return
+		///
+		int64_t PsdSize() const
+		{
+			return _segment_size / 2 + 1;
+		}
+
+		///
+		/// @brief 频率分辨率，即相邻两个频点的间隔，单位：Hz.
+		///
+		/// @return
+		///
+		double FrequencyResolution() const
+		{
+			return _sample_rate / static_cast<double>(_segment_size);
+		}
+
+		///
+		/// @brief 计算功率谱密度。
+		///
+		/// @note 末尾不足一段的采样被丢弃。
+		///
+		/// @param signal 信号。采样数不能 < SegmentSize().
+		/// @param psd 接收结果，第 k 个点的频率为 k * FrequencyResolution().
+		/// 元素个数必须等于 PsdSize(). 单位：信号单位的平方 / Hz.
+		/// @return 参与平均的段数。
+		///
+		int64_t Compute(base::ReadOnlyArraySpan<double> const &signal,
+						base::ArraySpan<double> const &psd);
+	};
+
+} // namespace base
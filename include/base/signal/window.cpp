@@ -0,0 +1,21 @@
+#include "window.h" // IWYU pragma: keep
+#include "base/string/define.h"
+#include <cmath>
+#include <numbers>
+#include <stdexcept>
+
+std::vector<double> base::hann_window(int64_t size)
+{
+	if (size < 1)
+	{
+		throw std::invalid_argument{CODE_POS_STR + "size 不能 < 1."};
+	}
+
+	std::vector<double> ret(size);
+	for (int64_t i = 0; i < size; i++)
+	{
+		ret[i] = 0.5 - 0.5 * std::cos(2 * std::numbers::pi * static_cast<double>(i) / static_cast<double>(size));
+	}
+
+	return ret;
+}
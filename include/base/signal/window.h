@@ -0,0 +1,18 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+namespace base
+{
+	///
+	/// @brief 周期 Hann 窗 w[i] = 0.5 - 0.5 * cos(2 * pi * i / size).
+	///
+	/// @note 用于频谱分析的是周期形式，分母是 size 而不是 size - 1, 窗口以 size
+	/// 为周期首尾相接，帧之间按一半窗长重叠时各点窗函数之和恒为 1.
+	///
+	/// @param size 窗长。不能 < 1.
+	/// @return
+	///
+	std::vector<double> hann_window(int64_t size);
+
+} // namespace base
@@ -1,5 +1,6 @@
 #pragma once
 #include "base/bit/AutoBitConverter.h"
+#include "base/container/ArraySpan.h"
 #include "base/stream/ReadOnlySpan.h"
 #include "base/stream/Span.h"
 #include <cstdint>
@@ -68,6 +69,31 @@ namespace base
 			_position += span_to_read.Size();
 			return ret;
 		}
+
+		///
+		/// @brief 读取一组数值，填满 values.
+		///
+		/// @note 整段一次性转换字节序，比逐个 ReadPayload<ReturnType> 快得多。适合读取 modbus
+		/// 寄存器组、采样数组等。
+		///
+		/// @param values
+		/// @param remote_endian
+		///
+		template <typename ValueType>
+		void ReadPayload(base::ArraySpan<ValueType> const &values, std::endian remote_endian)
+		{
+			base::Range range_to_read{
+				_position,
+				_position + values.Count() * static_cast<int64_t>(sizeof(ValueType)),
+			};
+
+			base::ReadOnlySpan span_to_read = _span[range_to_read];
+
+			base::AutoBitConverter conveter{remote_endian};
+			conveter.FromBytes(span_to_read, values);
+
+			_position += span_to_read.Size();
+		}
 	};
 
 } // namespace base
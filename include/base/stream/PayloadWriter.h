@@ -1,5 +1,7 @@
 #pragma once
 #include "base/bit/AutoBitConverter.h"
+#include "base/container/ArraySpan.h"
+#include "base/container/ReadOnlyArraySpan.h"
 #include "base/stream/Span.h"
 #include <cstdint>
 
@@ -66,6 +68,42 @@ namespace base
 
 			_position += span_to_write.Size();
 		}
+
+		///
+		/// @brief 写入一组数值。
+		///
+		/// @note 整段一次性转换字节序，比逐个写入快得多。
+		///
+		/// @param values
+		/// @param remote_endian
+		///
+		template <typename ValueType>
+		void WritePayload(base::ReadOnlyArraySpan<ValueType> const &values, std::endian remote_endian)
+		{
+			base::Range range{
+				_position,
+				_position + values.Count() * static_cast<int64_t>(sizeof(ValueType)),
+			};
+
+			base::Span span_to_write = _span[range];
+
+			base::AutoBitConverter conveter{remote_endian};
+			conveter.GetBytes(values, span_to_write);
+
+			_position += span_to_write.Size();
+		}
+
+		///
+		/// @brief 写入一组数值。
+		///
+		/// @param values
+		/// @param remote_endian
+		///
+		template <typename ValueType>
+		void WritePayload(base::ArraySpan<ValueType> const &values, std::endian remote_endian)
+		{
+			WritePayload(base::ReadOnlyArraySpan<ValueType>{values.Buffer(), values.Count()}, remote_endian);
+		}
 	};
 
 } // namespace base
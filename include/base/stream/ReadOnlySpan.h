@@ -5,6 +5,7 @@
 #include <cstdint>
 #include <cstring>
 #include <stdexcept>
+#include <string_view>
 
 namespace base
 {
@@ -71,6 +72,18 @@ namespace base
 			_size = white_char_index;
 		}
 
+		///
+		/// @brief 引用字符串的内存段。在本对象的生命周期内，字符串必须始终存活。
+		///
+		/// @note 按 size 引用，字符串中可以有空字符。
+		///
+		/// @param str
+		///
+		explicit ReadOnlySpan(std::string_view const &str)
+			: ReadOnlySpan{reinterpret_cast<uint8_t const *>(str.data()), static_cast<int64_t>(str.size())}
+		{
+		}
+
 		/* #endregion */
 
 		/* #region 索引器 */
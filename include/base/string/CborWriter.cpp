@@ -0,0 +1,251 @@
+#include "CborWriter.h"
+#include "base/string/define.h"
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace
+{
+	/* #region 主类型 */
+
+	constexpr uint8_t _unsigned_integer = 0;
+	constexpr uint8_t _negative_integer = 1;
+	constexpr uint8_t _text_string = 3;
+
+	/* #endregion */
+
+	constexpr uint8_t _indefinite_array = 0x9f;
+	constexpr uint8_t _indefinite_map = 0xbf;
+	constexpr uint8_t _break = 0xff;
+	constexpr uint8_t _false = 0xf4;
+	constexpr uint8_t _true = 0xf5;
+	constexpr uint8_t _null = 0xf6;
+	constexpr uint8_t _half_float = 0xf9;
+	constexpr uint8_t _single_float = 0xfa;
+	constexpr uint8_t _double_float = 0xfb;
+
+	///
+	/// @brief 以大端序追加 value 的低 byte_count 个字节。
+	///
+	/// @param buffer
+	/// @param value
+	/// @param byte_count
+	///
+	inline void AppendBigEndian(std::vector<uint8_t> &buffer, uint64_t value, int byte_count)
+	{
+		for (int i = byte_count - 1; i >= 0; i--)
+		{
+			buffer.push_back(static_cast<uint8_t>(value >> (8 * i)));
+		}
+	}
+
+} // namespace
+
+void base::CborWriter::WriteHead(uint8_t major_type, uint64_t argument)
+{
+	uint8_t major = static_cast<uint8_t>(major_type << 5);
+	if (argument < 24)
+	{
+		_buffer.push_back(static_cast<uint8_t>(major | argument));
+	}
+	else if (argument <= UINT8_MAX)
+	{
+		_buffer.push_back(major | 24);
+		AppendBigEndian(_buffer, argument, 1);
+	}
+	else if (argument <= UINT16_MAX)
+	{
+		_buffer.push_back(major | 25);
+		AppendBigEndian(_buffer, argument, 2);
+	}
+	else if (argument <= UINT32_MAX)
+	{
+		_buffer.push_back(major | 26);
+		AppendBigEndian(_buffer, argument, 4);
+	}
+	else
+	{
+		_buffer.push_back(major | 27);
+		AppendBigEndian(_buffer, argument, 8);
+	}
+}
+
+void base::CborWriter::BeforeValue()
+{
+	if (_scopes.empty() || _scopes.back() == Scope::Array)
+	{
+		return;
+	}
+
+	if (!_after_key)
+	{
+		throw std::runtime_error{CODE_POS_STR + "对象中的值前面必须先写入键。"};
+	}
+
+	_after_key = false;
+}
+
+void base::CborWriter::AfterValue()
+{
+	if (_scopes.empty() || _buffer.size() >= _flush_threshold)
+	{
+		Flush();
+	}
+}
+
+void base::CborWriter::EndScope(Scope scope)
+{
+	if (_scopes.empty() || _scopes.back() != scope)
+	{
+		throw std::runtime_error{CODE_POS_STR + "结束的容器与开始的容器不匹配。"};
+	}
+
+	if (_after_key)
+	{
+		throw std::runtime_error{CODE_POS_STR + "键后面没有值。"};
+	}
+
+	_scopes.pop_back();
+	_buffer.push_back(_break);
+	AfterValue();
+}
+
+base::CborWriter::CborWriter(base::Stream &stream)
+	: _stream(stream)
+{
+	_buffer.reserve(_flush_threshold * 2);
+}
+
+void base::CborWriter::Flush()
+{
+	if (_buffer.empty())
+	{
+		return;
+	}
+
+	_stream.Write(base::ReadOnlySpan{_buffer.data(), static_cast<int64_t>(_buffer.size())});
+	_buffer.clear();
+}
+
+/* #region 容器 */
+
+void base::CborWriter::StartObject()
+{
+	BeforeValue();
+	_buffer.push_back(_indefinite_map);
+	_scopes.push_back(Scope::Object);
+}
+
+void base::CborWriter::EndObject()
+{
+	EndScope(Scope::Object);
+}
+
+void base::CborWriter::StartArray()
+{
+	BeforeValue();
+	_buffer.push_back(_indefinite_array);
+	_scopes.push_back(Scope::Array);
+}
+
+void base::CborWriter::EndArray()
+{
+	EndScope(Scope::Array);
+}
+
+void base::CborWriter::Key(std::string_view const &key)
+{
+	if (_scopes.empty() || _scopes.back() != Scope::Object)
+	{
+		throw std::runtime_error{CODE_POS_STR + "只有对象中才能写入键。"};
+	}
+
+	if (_after_key)
+	{
+		throw std::runtime_error{CODE_POS_STR + "上一个键还没有值。"};
+	}
+
+	WriteHead(_text_string, key.size());
+	_buffer.insert(_buffer.end(), key.begin(), key.end());
+	_after_key = true;
+}
+
+/* #endregion */
+
+/* #region 值 */
+
+void base::CborWriter::Null()
+{
+	BeforeValue();
+	_buffer.push_back(_null);
+	AfterValue();
+}
+
+void base::CborWriter::Value(bool value)
+{
+	BeforeValue();
+	_buffer.push_back(value ? _true : _false);
+	AfterValue();
+}
+
+void base::CborWriter::Value(int64_t value)
+{
+	BeforeValue();
+	if (value >= 0)
+	{
+		WriteHead(_unsigned_integer, static_cast<uint64_t>(value));
+	}
+	else
+	{
+		// 负整数编码为 -1 - value, 按位取反即可，不会溢出。
+		WriteHead(_negative_integer, ~static_cast<uint64_t>(value));
+	}
+
+	AfterValue();
+}
+
+void base::CborWriter::Value(uint64_t value)
+{
+	BeforeValue();
+	WriteHead(_unsigned_integer, value);
+	AfterValue();
+}
+
+void base::CborWriter::Value(double value)
+{
+	BeforeValue();
+	if (std::isnan(value))
+	{
+		_buffer.push_back(_half_float);
+		AppendBigEndian(_buffer, 0x7e00, 2);
+	}
+	else if (std::isinf(value))
+	{
+		_buffer.push_back(_half_float);
+		AppendBigEndian(_buffer, value > 0 ? 0x7c00 : 0xfc00, 2);
+	}
+	else if (std::abs(value) <= std::numeric_limits<float>::max() &&
+			 static_cast<double>(static_cast<float>(value)) == value)
+	{
+		_buffer.push_back(_single_float);
+		AppendBigEndian(_buffer, std::bit_cast<uint32_t>(static_cast<float>(value)), 4);
+	}
+	else
+	{
+		_buffer.push_back(_double_float);
+		AppendBigEndian(_buffer, std::bit_cast<uint64_t>(value), 8);
+	}
+
+	AfterValue();
+}
+
+void base::CborWriter::Value(std::string_view const &value)
+{
+	BeforeValue();
+	WriteHead(_text_string, value.size());
+	_buffer.insert(_buffer.end(), value.begin(), value.end());
+	AfterValue();
+}
+
+/* #endregion */
@@ -0,0 +1,88 @@
+#pragma once
+#include "base/stream/Stream.h"
+#include "base/string/IJsonWriter.h"
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace base
+{
+	///
+	/// @brief 不构造 DOM, 边生成边把 CBOR (RFC 8949) 写入 base::Stream.
+	///
+	/// @note 对象和数组使用不定长编码，所以写出前不需要知道元素个数。
+	/// 读取时可以用 IJsonStreamDeserializable::FromCbor 系列函数，或者 base::Json::from_cbor.
+	///
+	/// @note 浮点数能无损地表示为 float 时写为 4 字节，否则写为 8 字节，与 nlohmann::json::to_cbor 相同。
+	///
+	/// @note 结构不匹配时抛出 std::runtime_error.
+	///
+	class CborWriter :
+		public base::IJsonWriter
+	{
+	private:
+		enum class Scope : uint8_t
+		{
+			Object,
+			Array,
+		};
+
+		base::Stream &_stream;
+		std::vector<uint8_t> _buffer;
+		std::vector<Scope> _scopes;
+		bool _after_key = false;
+
+		static constexpr size_t _flush_threshold = 4096;
+
+		void WriteHead(uint8_t major_type, uint64_t argument);
+		void BeforeValue();
+		void AfterValue();
+		void EndScope(Scope scope);
+
+	public:
+		///
+		/// @brief 构造。
+		///
+		/// @param stream 写入的目标。生命周期要比本对象长。
+		///
+		CborWriter(base::Stream &stream);
+
+		///
+		/// @brief 把缓冲区中的数据写入流。
+		///
+		virtual void Flush() override;
+
+		/* #region 容器 */
+
+		virtual void StartObject() override;
+
+		virtual void EndObject() override;
+
+		virtual void StartArray() override;
+
+		virtual void EndArray() override;
+
+		virtual void Key(std::string_view const &key) override;
+
+		/* #endregion */
+
+		/* #region 值 */
+
+		virtual void Null() override;
+
+		virtual void Value(bool value) override;
+
+		virtual void Value(int64_t value) override;
+
+		virtual void Value(uint64_t value) override;
+
+		virtual void Value(double value) override;
+
+		virtual void Value(std::string_view const &value) override;
+
+		/* #endregion */
+
+		using base::IJsonWriter::Value;
+	};
+
+} // namespace base
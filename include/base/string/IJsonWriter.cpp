@@ -0,0 +1,68 @@
+#include "IJsonWriter.h"
+#include "base/string/define.h"
+#include <stdexcept>
+
+void base::IJsonWriter::Value(base::Json const &json)
+{
+	switch (json.type())
+	{
+	case base::Json::value_t::null:
+	case base::Json::value_t::discarded:
+		{
+			Null();
+			break;
+		}
+	case base::Json::value_t::boolean:
+		{
+			Value(json.get<bool>());
+			break;
+		}
+	case base::Json::value_t::number_integer:
+		{
+			Value(json.get<int64_t>());
+			break;
+		}
+	case base::Json::value_t::number_unsigned:
+		{
+			Value(json.get<uint64_t>());
+			break;
+		}
+	case base::Json::value_t::number_float:
+		{
+			Value(json.get<double>());
+			break;
+		}
+	case base::Json::value_t::string:
+		{
+			Value(std::string_view{json.get_ref<std::string const &>()});
+			break;
+		}
+	case base::Json::value_t::array:
+		{
+			StartArray();
+			for (base::Json const &element : json)
+			{
+				Value(element);
+			}
+
+			EndArray();
+			break;
+		}
+	case base::Json::value_t::object:
+		{
+			StartObject();
+			for (auto const &item : json.items())
+			{
+				Key(item.key());
+				Value(item.value());
+			}
+
+			EndObject();
+			break;
+		}
+	case base::Json::value_t::binary:
+		{
+			throw std::invalid_argument{CODE_POS_STR + "不支持写入二进制值。"};
+		}
+	}
+}
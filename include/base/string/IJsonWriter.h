@@ -0,0 +1,127 @@
+#pragma once
+#include "base/string/Json.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace base
+{
+	///
+	/// @brief 按照 json 的数据模型边生成边写出，不构造 json 对象。
+	///
+	/// @note 派生类决定输出格式，例如 JsonWriter 输出文本，CborWriter 输出 CBOR.
+	/// 对象中的每个值前面要先调用 Key.
+	///
+	class IJsonWriter
+	{
+	public:
+		virtual ~IJsonWriter() = default;
+
+		/* #region 接口 */
+
+		virtual void StartObject() = 0;
+
+		virtual void EndObject() = 0;
+
+		virtual void StartArray() = 0;
+
+		virtual void EndArray() = 0;
+
+		///
+		/// @brief 写入对象的键。下一个写入的值属于这个键。
+		///
+		/// @param key
+		///
+		virtual void Key(std::string_view const &key) = 0;
+
+		virtual void Null() = 0;
+
+		virtual void Value(bool value) = 0;
+
+		virtual void Value(int64_t value) = 0;
+
+		virtual void Value(uint64_t value) = 0;
+
+		virtual void Value(double value) = 0;
+
+		virtual void Value(std::string_view const &value) = 0;
+
+		///
+		/// @brief 把缓冲区中的数据写入目标。
+		///
+		/// @note 最外层的值写完时会自动调用。
+		///
+		virtual void Flush() = 0;
+
+		/* #endregion */
+
+		void Value(std::string const &value)
+		{
+			Value(std::string_view{value});
+		}
+
+		void Value(char const *value)
+		{
+			Value(std::string_view{value});
+		}
+
+		///
+		/// @brief 写入除了 int64_t, uint64_t, bool 的整型。
+		///
+		/// @param value
+		///
+		template <typename T>
+			requires(std::is_integral_v<T> &&
+					 !std::is_same_v<T, bool> &&
+					 !std::is_same_v<T, int64_t> &&
+					 !std::is_same_v<T, uint64_t>)
+		void Value(T value)
+		{
+			if constexpr (std::is_signed_v<T>)
+			{
+				Value(static_cast<int64_t>(value));
+			}
+			else
+			{
+				Value(static_cast<uint64_t>(value));
+			}
+		}
+
+		void Value(float value)
+		{
+			Value(static_cast<double>(value));
+		}
+
+		///
+		/// @brief 写入一棵已经构造好的 json 树。
+		///
+		/// @param json
+		///
+		void Value(base::Json const &json);
+
+		///
+		/// @brief 写入可序列化对象。调用它的 WriteJson 方法。
+		///
+		/// @param value
+		///
+		void Value(base::IJsonSerializable const &value)
+		{
+			value.WriteJson(*this);
+		}
+
+		///
+		/// @brief 写入键值对。
+		///
+		/// @param key
+		/// @param value
+		///
+		template <typename T>
+		void Property(std::string_view const &key, T const &value)
+		{
+			Key(key);
+			Value(value);
+		}
+	};
+
+} // namespace base
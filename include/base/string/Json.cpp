@@ -1,10 +1,16 @@
 #include "Json.h"
+#include "base/string/IJsonWriter.h"
 
 std::string base::IJsonSerializable::ToString() const
 {
 	return ToJson().dump(4);
 }
 
+void base::IJsonSerializable::WriteJson(base::IJsonWriter &writer) const
+{
+	writer.Value(ToJson());
+}
+
 void base::IJsonDeserializable::FromJsonString(std::string const &json_string)
 {
 	FromJson(Json::parse(json_string));
@@ -8,6 +8,8 @@ namespace base
 	using Json = nlohmann::json;
 	using JsonTypeException = Json::type_error;
 
+	class IJsonWriter;
+
 	///
 	/// @brief 继承此接口表示能将对象序列化为 json
 	///
@@ -23,6 +25,16 @@ namespace base
 		///
 		virtual base::Json ToJson() const = 0;
 
+		///
+		/// @brief 不经过 json 对象，直接把本对象写入 IJsonWriter.
+		///
+		/// @note 默认实现先调用 ToJson 再写入。序列化大对象时重写此函数，边遍历边写，
+		/// 避免构造整棵 json 树。
+		///
+		/// @param writer
+		///
+		virtual void WriteJson(base::IJsonWriter &writer) const;
+
 		///
 		/// @brief 利用序列化出的 Json 对象，将本对象转化为 json 字符串。
 		///
@@ -55,12 +67,16 @@ namespace base
 		///
 		virtual void FromJson(Json const &json) = 0;
 
+		virtual ~IJsonDeserializable() = default;
+
 		///
 		/// @brief 从 json 字符串中反序列化。
 		///
+		/// @note 默认实现先解析出 json 对象再调用 FromJson.
+		///
 		/// @param json_string
 		///
-		void FromJsonString(std::string const &json_string);
+		virtual void FromJsonString(std::string const &json_string);
 	};
 
 } // namespace base
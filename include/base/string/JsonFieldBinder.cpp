@@ -0,0 +1,478 @@
+#include "JsonFieldBinder.h"
+#include "base/string/define.h"
+#include <istream>
+#include <memory>
+#include <stdexcept>
+#include <streambuf>
+
+namespace
+{
+	///
+	/// @brief 接收 nlohmann::json 的 SAX 事件，直接写入声明的字段。
+	///
+	/// @note 字段表和容器栈在整个解析过程中复用，嵌套对象声明的字段追加在字段表末尾，
+	/// 对象结束时截断。
+	///
+	class FieldSaxHandler
+	{
+	private:
+		enum class FrameKind
+		{
+			Object,
+			Array,
+		};
+
+		struct Frame
+		{
+			FrameKind _kind = FrameKind::Object;
+
+			///
+			/// @brief 对象：本对象的字段在字段表中的起始位置。
+			///
+			size_t _field_begin = 0;
+
+			///
+			/// @brief 对象：最近的键对应的字段。数组：数组本身。
+			///
+			base::JsonFieldSink _sink{};
+
+			///
+			/// @brief 最近的键。用于错误信息。
+			///
+			std::string_view _key;
+		};
+
+		base::IJsonStreamDeserializable &_root;
+		std::vector<base::JsonField> _fields;
+		std::vector<Frame> _frames;
+
+		///
+		/// @brief 正在跳过的容器的深度。
+		///
+		int64_t _skip_depth = 0;
+
+		///
+		/// @brief 下一个值属于没有声明的键，要跳过。
+		///
+		bool _skip_next = false;
+
+		std::string Path() const
+		{
+			std::string path = "$";
+			for (Frame const &frame : _frames)
+			{
+				if (frame._kind == FrameKind::Object)
+				{
+					path += '.';
+					path += frame._key;
+				}
+				else
+				{
+					path += "[]";
+				}
+			}
+
+			return path;
+		}
+
+		[[noreturn]] void ThrowTypeMismatch(base::JsonFieldSink const &sink, char const *json_type) const
+		{
+			throw std::invalid_argument{CODE_POS_STR + Path() + " 的类型是 " +
+										sink._operations->_type_name + ", 不能用 json " + json_type + " 赋值。"};
+		}
+
+		[[noreturn]] void ThrowOutOfRange(base::JsonFieldSink const &sink) const
+		{
+			throw std::invalid_argument{CODE_POS_STR + Path() + " 超出 " +
+										sink._operations->_type_name + " 字段的范围。"};
+		}
+
+		///
+		/// @brief 取出下一个值要写入的字段。
+		///
+		/// @param sink
+		/// @return 返回 false 表示这个值要跳过。
+		///
+		bool TakeSink(base::JsonFieldSink &sink)
+		{
+			if (_skip_depth > 0)
+			{
+				return false;
+			}
+
+			if (_skip_next)
+			{
+				_skip_next = false;
+				return false;
+			}
+
+			if (_frames.empty())
+			{
+				throw std::invalid_argument{CODE_POS_STR + "json 的根必须是对象。"};
+			}
+
+			Frame &frame = _frames.back();
+			if (frame._kind == FrameKind::Object)
+			{
+				sink = frame._sink;
+				return true;
+			}
+
+			sink = frame._sink._operations->_emplace_element(frame._sink._target);
+			return true;
+		}
+
+		template <typename ValueType>
+		bool SetValue(bool (*base::JsonFieldSinkOperations::*setter)(void *, ValueType),
+					  ValueType value,
+					  char const *json_type)
+		{
+			base::JsonFieldSink sink;
+			if (!TakeSink(sink))
+			{
+				return true;
+			}
+
+			auto set = sink._operations->*setter;
+			if (set == nullptr)
+			{
+				ThrowTypeMismatch(sink, json_type);
+			}
+
+			if (!set(sink._target, value))
+			{
+				ThrowOutOfRange(sink);
+			}
+
+			return true;
+		}
+
+		void PushObject(base::IJsonStreamDeserializable &object)
+		{
+			Frame frame{};
+			frame._kind = FrameKind::Object;
+			frame._field_begin = _fields.size();
+			_frames.push_back(frame);
+
+			base::JsonFieldBinder binder{_fields};
+			object.DeclareJsonFields(binder);
+		}
+
+	public:
+		FieldSaxHandler(base::IJsonStreamDeserializable &root)
+			: _root(root)
+		{
+			_fields.reserve(64);
+			_frames.reserve(16);
+		}
+
+		/* #region SAX 事件 */
+
+		bool null()
+		{
+			base::JsonFieldSink sink;
+			if (!TakeSink(sink))
+			{
+				return true;
+			}
+
+			ThrowTypeMismatch(sink, "null");
+		}
+
+		bool boolean(bool value)
+		{
+			return SetValue<bool>(&base::JsonFieldSinkOperations::_set_bool, value, "boolean");
+		}
+
+		bool number_integer(int64_t value)
+		{
+			return SetValue<int64_t>(&base::JsonFieldSinkOperations::_set_int64, value, "integer");
+		}
+
+		bool number_unsigned(uint64_t value)
+		{
+			return SetValue<uint64_t>(&base::JsonFieldSinkOperations::_set_uint64, value, "integer");
+		}
+
+		bool number_float(double value, std::string const &)
+		{
+			return SetValue<double>(&base::JsonFieldSinkOperations::_set_double, value, "number");
+		}
+
+		bool string(std::string &value)
+		{
+			return SetValue<std::string &>(&base::JsonFieldSinkOperations::_set_string, value, "string");
+		}
+
+		bool binary(base::Json::binary_t &)
+		{
+			base::JsonFieldSink sink;
+			if (!TakeSink(sink))
+			{
+				return true;
+			}
+
+			ThrowTypeMismatch(sink, "binary");
+		}
+
+		bool start_object(size_t)
+		{
+			if (_skip_depth > 0 || _skip_next)
+			{
+				_skip_next = false;
+				_skip_depth++;
+				return true;
+			}
+
+			if (_frames.empty())
+			{
+				PushObject(_root);
+				return true;
+			}
+
+			base::JsonFieldSink sink;
+			TakeSink(sink);
+			if (sink._operations->_as_object == nullptr)
+			{
+				ThrowTypeMismatch(sink, "object");
+			}
+
+			PushObject(*sink._operations->_as_object(sink._target));
+			return true;
+		}
+
+		bool key(std::string &key)
+		{
+			if (_skip_depth > 0)
+			{
+				return true;
+			}
+
+			Frame &frame = _frames.back();
+			for (size_t i = frame._field_begin; i < _fields.size(); i++)
+			{
+				if (_fields[i]._name == key)
+				{
+					frame._sink = _fields[i]._sink;
+					frame._key = _fields[i]._name;
+					return true;
+				}
+			}
+
+			_skip_next = true;
+			return true;
+		}
+
+		bool end_object()
+		{
+			if (_skip_depth > 0)
+			{
+				_skip_depth--;
+				return true;
+			}
+
+			_fields.resize(_frames.back()._field_begin);
+			_frames.pop_back();
+			return true;
+		}
+
+		bool start_array(size_t)
+		{
+			if (_skip_depth > 0 || _skip_next)
+			{
+				_skip_next = false;
+				_skip_depth++;
+				return true;
+			}
+
+			base::JsonFieldSink sink;
+			TakeSink(sink);
+			if (sink._operations->_clear_array == nullptr)
+			{
+				ThrowTypeMismatch(sink, "array");
+			}
+
+			sink._operations->_clear_array(sink._target);
+
+			Frame frame{};
+			frame._kind = FrameKind::Array;
+			frame._sink = sink;
+			_frames.push_back(frame);
+			return true;
+		}
+
+		bool end_array()
+		{
+			if (_skip_depth > 0)
+			{
+				_skip_depth--;
+				return true;
+			}
+
+			_frames.pop_back();
+			return true;
+		}
+
+		bool parse_error(size_t, std::string const &, nlohmann::detail::exception const &e)
+		{
+			throw std::invalid_argument{CODE_POS_STR + e.what()};
+		}
+
+		/* #endregion */
+	};
+
+	///
+	/// @brief 按照解析器的事件顺序遍历 json 对象。
+	///
+	/// @param json
+	/// @param handler
+	///
+	void Replay(base::Json const &json, FieldSaxHandler &handler)
+	{
+		switch (json.type())
+		{
+		case base::Json::value_t::null:
+		case base::Json::value_t::discarded:
+			{
+				handler.null();
+				break;
+			}
+		case base::Json::value_t::boolean:
+			{
+				handler.boolean(json.get<bool>());
+				break;
+			}
+		case base::Json::value_t::number_integer:
+			{
+				handler.number_integer(json.get<int64_t>());
+				break;
+			}
+		case base::Json::value_t::number_unsigned:
+			{
+				handler.number_unsigned(json.get<uint64_t>());
+				break;
+			}
+		case base::Json::value_t::number_float:
+			{
+				handler.number_float(json.get<double>(), std::string{});
+				break;
+			}
+		case base::Json::value_t::string:
+			{
+				std::string value = json.get<std::string>();
+				handler.string(value);
+				break;
+			}
+		case base::Json::value_t::binary:
+			{
+				base::Json::binary_t value = json.get_binary();
+				handler.binary(value);
+				break;
+			}
+		case base::Json::value_t::array:
+			{
+				handler.start_array(json.size());
+				for (base::Json const &element : json)
+				{
+					Replay(element, handler);
+				}
+
+				handler.end_array();
+				break;
+			}
+		case base::Json::value_t::object:
+			{
+				handler.start_object(json.size());
+				for (auto const &item : json.items())
+				{
+					std::string key = item.key();
+					handler.key(key);
+					Replay(item.value(), handler);
+				}
+
+				handler.end_object();
+				break;
+			}
+		}
+	}
+
+	///
+	/// @brief 让 std::istream 从 base::Stream 中成块地读取。
+	///
+	class StreamBuffer :
+		public std::streambuf
+	{
+	private:
+		base::Stream &_stream;
+		std::unique_ptr<char[]> _buffer;
+		static constexpr int64_t _buffer_size = 64 * 1024;
+
+	protected:
+		int_type underflow() override
+		{
+			if (gptr() < egptr())
+			{
+				return traits_type::to_int_type(*gptr());
+			}
+
+			int64_t have_read = _stream.Read(base::Span{
+				reinterpret_cast<uint8_t *>(_buffer.get()),
+				_buffer_size,
+			});
+
+			if (have_read <= 0)
+			{
+				return traits_type::eof();
+			}
+
+			setg(_buffer.get(), _buffer.get(), _buffer.get() + have_read);
+			return traits_type::to_int_type(*gptr());
+		}
+
+	public:
+		StreamBuffer(base::Stream &stream)
+			: _stream(stream),
+			  _buffer(new char[_buffer_size])
+		{
+			setg(_buffer.get(), _buffer.get(), _buffer.get());
+		}
+	};
+
+} // namespace
+
+void base::IJsonStreamDeserializable::FromJson(base::Json const &json)
+{
+	FieldSaxHandler handler{*this};
+	Replay(json, handler);
+}
+
+void base::IJsonStreamDeserializable::FromJsonString(std::string const &json_string)
+{
+	FieldSaxHandler handler{*this};
+	base::Json::sax_parse(json_string, &handler);
+}
+
+void base::IJsonStreamDeserializable::FromJsonStream(base::Stream &stream)
+{
+	StreamBuffer buffer{stream};
+	std::istream input{&buffer};
+	FieldSaxHandler handler{*this};
+	base::Json::sax_parse(input, &handler);
+}
+
+void base::IJsonStreamDeserializable::FromCbor(base::ReadOnlySpan const &span)
+{
+	FieldSaxHandler handler{*this};
+	base::Json::sax_parse(span.Buffer(),
+						  span.Buffer() + span.Size(),
+						  &handler,
+						  base::Json::input_format_t::cbor);
+}
+
+void base::IJsonStreamDeserializable::FromCborStream(base::Stream &stream)
+{
+	StreamBuffer buffer{stream};
+	std::istream input{&buffer};
+	FieldSaxHandler handler{*this};
+	base::Json::sax_parse(input, &handler, base::Json::input_format_t::cbor);
+}
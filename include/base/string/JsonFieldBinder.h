@@ -0,0 +1,297 @@
+#pragma once
+#include "base/stream/Stream.h"
+#include "base/string/Json.h"
+#include "base/string/String.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace base
+{
+	class JsonFieldBinder;
+
+	///
+	/// @brief 继承此接口表示能边解析 json 边把值填入字段，不构造 json 对象。
+	///
+	/// @note 派生类只需要在 DeclareJsonFields 中声明一次有哪些字段。json 中没有出现的字段保持原值，
+	/// 没有声明的键被跳过。值的类型与字段不匹配，或者整数超出字段的范围时抛出 std::invalid_argument.
+	///
+	class IJsonStreamDeserializable :
+		public base::IJsonDeserializable
+	{
+	public:
+		///
+		/// @brief 声明 json 对象中的键与本对象字段的对应关系。
+		///
+		/// @note 每遇到一个 json 对象调用一次，所以不要在这里做耗时的操作。
+		///
+		/// @param binder
+		///
+		virtual void DeclareJsonFields(base::JsonFieldBinder &binder) = 0;
+
+		///
+		/// @brief 从 json 对象中反序列化。
+		///
+		/// @note 遍历 json 对象，按照与流式解析相同的规则填入字段。
+		///
+		/// @param json
+		///
+		virtual void FromJson(base::Json const &json) override;
+
+		///
+		/// @brief 从 json 字符串中反序列化。不构造 json 对象。
+		///
+		/// @param json_string
+		///
+		virtual void FromJsonString(std::string const &json_string) override;
+
+		///
+		/// @brief 从流中读取 json 并反序列化。不构造 json 对象。
+		///
+		/// @note 读取到流结束。json 后面除了空白字符不能有别的内容。
+		///
+		/// @param stream
+		///
+		void FromJsonStream(base::Stream &stream);
+
+		///
+		/// @brief 从 CBOR 中反序列化。不构造 json 对象。
+		///
+		/// @note 按照 json 的数据模型解释 CBOR, 例如由 CborWriter 或 base::Json::to_cbor 生成的数据。
+		/// 字段的匹配规则与 json 相同。
+		///
+		/// @param span
+		///
+		void FromCbor(base::ReadOnlySpan const &span);
+
+		///
+		/// @brief 从流中读取 CBOR 并反序列化。不构造 json 对象。
+		///
+		/// @note 读取到流结束。CBOR 后面不能有别的内容。
+		///
+		/// @param stream
+		///
+		void FromCborStream(base::Stream &stream);
+	};
+
+	class JsonFieldSinkOperations;
+
+	///
+	/// @brief 类型擦除后的字段。
+	///
+	struct JsonFieldSink
+	{
+		void *_target = nullptr;
+		base::JsonFieldSinkOperations const *_operations = nullptr;
+	};
+
+	///
+	/// @brief 把 SAX 事件中的值写入某一种类型的字段的函数表。
+	///
+	/// @note 字段不支持的事件对应的函数指针为空。写入函数返回 false 表示值超出字段的范围。
+	///
+	class JsonFieldSinkOperations
+	{
+	public:
+		char const *_type_name = "";
+		bool (*_set_bool)(void *target, bool value) = nullptr;
+		bool (*_set_int64)(void *target, int64_t value) = nullptr;
+		bool (*_set_uint64)(void *target, uint64_t value) = nullptr;
+		bool (*_set_double)(void *target, double value) = nullptr;
+		bool (*_set_string)(void *target, std::string &value) = nullptr;
+		base::IJsonStreamDeserializable *(*_as_object)(void *target) = nullptr;
+		void (*_clear_array)(void *target) = nullptr;
+		base::JsonFieldSink (*_emplace_element)(void *target) = nullptr;
+	};
+
+	namespace json_field_sink
+	{
+		template <typename T>
+		struct is_vector : std::false_type
+		{
+		};
+
+		template <typename T, typename Allocator>
+		struct is_vector<std::vector<T, Allocator>> : std::true_type
+		{
+		};
+
+		template <typename T>
+		constexpr base::JsonFieldSinkOperations MakeOperations();
+
+		///
+		/// @brief 每种字段类型共用一张函数表。
+		///
+		template <typename T>
+		inline constexpr base::JsonFieldSinkOperations _operations = MakeOperations<T>();
+
+		template <typename T>
+		constexpr base::JsonFieldSinkOperations MakeOperations()
+		{
+			base::JsonFieldSinkOperations operations{};
+
+			if constexpr (std::is_same_v<T, bool>)
+			{
+				operations._type_name = "bool";
+				operations._set_bool = [](void *target, bool value)
+				{
+					*static_cast<bool *>(target) = value;
+					return true;
+				};
+			}
+			else if constexpr (std::is_integral_v<T>)
+			{
+				operations._type_name = "integer";
+				operations._set_int64 = [](void *target, int64_t value)
+				{
+					if (!std::in_range<T>(value))
+					{
+						return false;
+					}
+
+					*static_cast<T *>(target) = static_cast<T>(value);
+					return true;
+				};
+
+				operations._set_uint64 = [](void *target, uint64_t value)
+				{
+					if (!std::in_range<T>(value))
+					{
+						return false;
+					}
+
+					*static_cast<T *>(target) = static_cast<T>(value);
+					return true;
+				};
+			}
+			else if constexpr (std::is_floating_point_v<T>)
+			{
+				operations._type_name = "number";
+				operations._set_int64 = [](void *target, int64_t value)
+				{
+					*static_cast<T *>(target) = static_cast<T>(value);
+					return true;
+				};
+
+				operations._set_uint64 = [](void *target, uint64_t value)
+				{
+					*static_cast<T *>(target) = static_cast<T>(value);
+					return true;
+				};
+
+				operations._set_double = [](void *target, double value)
+				{
+					*static_cast<T *>(target) = static_cast<T>(value);
+					return true;
+				};
+			}
+			else if constexpr (std::is_same_v<T, std::string>)
+			{
+				operations._type_name = "string";
+				operations._set_string = [](void *target, std::string &value)
+				{
+					*static_cast<std::string *>(target) = std::move(value);
+					return true;
+				};
+			}
+			else if constexpr (std::is_same_v<T, base::String>)
+			{
+				operations._type_name = "string";
+				operations._set_string = [](void *target, std::string &value)
+				{
+					*static_cast<base::String *>(target) = base::String{value};
+					return true;
+				};
+			}
+			else if constexpr (std::is_base_of_v<base::IJsonStreamDeserializable, T>)
+			{
+				operations._type_name = "object";
+				operations._as_object = [](void *target)
+				{
+					return static_cast<base::IJsonStreamDeserializable *>(static_cast<T *>(target));
+				};
+			}
+			else if constexpr (is_vector<T>::value)
+			{
+				using element_type = typename T::value_type;
+				static_assert(!std::is_same_v<element_type, bool>, "std::vector<bool> 的元素不能取地址，不支持。");
+
+				operations._type_name = "array";
+				operations._clear_array = [](void *target)
+				{
+					static_cast<T *>(target)->clear();
+				};
+
+				operations._emplace_element = [](void *target)
+				{
+					T &vector = *static_cast<T *>(target);
+					vector.emplace_back();
+					return base::JsonFieldSink{&vector.back(), &_operations<element_type>};
+				};
+			}
+			else
+			{
+				static_assert(std::is_same_v<T, void>, "不支持的字段类型。");
+			}
+
+			return operations;
+		}
+
+	} // namespace json_field_sink
+
+	///
+	/// @brief 声明的字段。
+	///
+	struct JsonField
+	{
+		std::string_view _name;
+		base::JsonFieldSink _sink;
+	};
+
+	///
+	/// @brief 在 IJsonStreamDeserializable::DeclareJsonFields 中声明字段。
+	///
+	/// @note 支持的字段类型：
+	/// 	@li bool
+	/// 	@li 整型。超出范围时抛出异常。
+	/// 	@li 浮点。json 中的整数也接受。
+	/// 	@li std::string, base::String
+	/// 	@li 派生自 IJsonStreamDeserializable 的类型。
+	/// 	@li 元素是以上类型的 std::vector, 可以嵌套。开始填充前先清空。
+	///
+	class JsonFieldBinder
+	{
+	private:
+		std::vector<base::JsonField> &_fields;
+
+	public:
+		///
+		/// @brief 构造。
+		///
+		/// @param fields 声明的字段追加到这里。
+		///
+		JsonFieldBinder(std::vector<base::JsonField> &fields)
+			: _fields(fields)
+		{
+		}
+
+		///
+		/// @brief 声明字段。
+		///
+		/// @param name json 中的键。只保存视图，所以在反序列化完成之前必须有效，一般传入字符串字面量。
+		/// @param field
+		///
+		template <typename T>
+		void Field(std::string_view const &name, T &field)
+		{
+			_fields.push_back(base::JsonField{
+				name,
+				base::JsonFieldSink{&field, &base::json_field_sink::_operations<T>},
+			});
+		}
+	};
+
+} // namespace base
@@ -0,0 +1,301 @@
+#include "JsonWriter.h"
+#include "base/string/define.h"
+#include "base/string/Json.h"
+#include <charconv>
+#include <cmath>
+#include <stdexcept>
+
+void base::JsonWriter::WriteNewLineAndIndent()
+{
+	if (_indent <= 0)
+	{
+		return;
+	}
+
+	_buffer.push_back('\n');
+	_buffer.append(_scopes.size() * static_cast<size_t>(_indent), ' ');
+}
+
+void base::JsonWriter::BeforeValue()
+{
+	if (_scopes.empty())
+	{
+		if (_has_root)
+		{
+			throw std::runtime_error{CODE_POS_STR + "最外层只能有一个值。"};
+		}
+
+		_has_root = true;
+		return;
+	}
+
+	if (_scopes.back() == Scope::Object)
+	{
+		if (!_after_key)
+		{
+			throw std::runtime_error{CODE_POS_STR + "对象中的值前面必须先写入键。"};
+		}
+
+		_after_key = false;
+		return;
+	}
+
+	// 数组中的元素。
+	if (!_is_empty.back())
+	{
+		_buffer.push_back(',');
+	}
+
+	_is_empty.back() = false;
+	WriteNewLineAndIndent();
+}
+
+void base::JsonWriter::AfterValue()
+{
+	if (_scopes.empty())
+	{
+		Flush();
+	}
+	else if (_buffer.size() >= _flush_threshold)
+	{
+		Flush();
+	}
+}
+
+void base::JsonWriter::WriteEscaped(std::string_view const &str)
+{
+	constexpr char hex_chars[] = "0123456789abcdef";
+
+	_buffer.push_back('"');
+
+	// 不需要转义的连续字符一次性追加。
+	size_t run_begin = 0;
+	for (size_t i = 0; i < str.size(); i++)
+	{
+		unsigned char c = static_cast<unsigned char>(str[i]);
+		if (c >= 0x20 && c != '"' && c != '\\')
+		{
+			continue;
+		}
+
+		_buffer.append(str.data() + run_begin, i - run_begin);
+		run_begin = i + 1;
+
+		switch (c)
+		{
+		case '"':
+			{
+				_buffer.append("\\\"");
+				break;
+			}
+		case '\\':
+			{
+				_buffer.append("\\\\");
+				break;
+			}
+		case '\b':
+			{
+				_buffer.append("\\b");
+				break;
+			}
+		case '\f':
+			{
+				_buffer.append("\\f");
+				break;
+			}
+		case '\n':
+			{
+				_buffer.append("\\n");
+				break;
+			}
+		case '\r':
+			{
+				_buffer.append("\\r");
+				break;
+			}
+		case '\t':
+			{
+				_buffer.append("\\t");
+				break;
+			}
+		default:
+			{
+				char escaped[] = {'\\', 'u', '0', '0', hex_chars[c >> 4], hex_chars[c & 0xf]};
+				_buffer.append(escaped, sizeof(escaped));
+				break;
+			}
+		}
+	}
+
+	_buffer.append(str.data() + run_begin, str.size() - run_begin);
+	_buffer.push_back('"');
+}
+
+void base::JsonWriter::StartScope(Scope scope, char c)
+{
+	BeforeValue();
+	_buffer.push_back(c);
+	_scopes.push_back(scope);
+	_is_empty.push_back(true);
+}
+
+void base::JsonWriter::EndScope(Scope scope, char c)
+{
+	if (_scopes.empty() || _scopes.back() != scope)
+	{
+		throw std::runtime_error{CODE_POS_STR + "结束的容器与开始的容器不匹配。"};
+	}
+
+	if (_after_key)
+	{
+		throw std::runtime_error{CODE_POS_STR + "键后面没有值。"};
+	}
+
+	bool is_empty = _is_empty.back();
+	_scopes.pop_back();
+	_is_empty.pop_back();
+
+	// 空容器输出为 {} 或 [].
+	if (!is_empty)
+	{
+		WriteNewLineAndIndent();
+	}
+
+	_buffer.push_back(c);
+	AfterValue();
+}
+
+base::JsonWriter::JsonWriter(base::TextWriter &writer, int indent)
+	: _writer(writer),
+	  _indent(indent)
+{
+	_buffer.reserve(_flush_threshold * 2);
+}
+
+void base::JsonWriter::Flush()
+{
+	if (_buffer.empty())
+	{
+		return;
+	}
+
+	_writer.Write(base::ReadOnlySpan{
+		reinterpret_cast<uint8_t const *>(_buffer.data()),
+		static_cast<int64_t>(_buffer.size()),
+	});
+
+	_buffer.clear();
+}
+
+/* #region 容器 */
+
+void base::JsonWriter::StartObject()
+{
+	StartScope(Scope::Object, '{');
+}
+
+void base::JsonWriter::EndObject()
+{
+	EndScope(Scope::Object, '}');
+}
+
+void base::JsonWriter::StartArray()
+{
+	StartScope(Scope::Array, '[');
+}
+
+void base::JsonWriter::EndArray()
+{
+	EndScope(Scope::Array, ']');
+}
+
+void base::JsonWriter::Key(std::string_view const &key)
+{
+	if (_scopes.empty() || _scopes.back() != Scope::Object)
+	{
+		throw std::runtime_error{CODE_POS_STR + "只有对象中才能写入键。"};
+	}
+
+	if (_after_key)
+	{
+		throw std::runtime_error{CODE_POS_STR + "上一个键还没有值。"};
+	}
+
+	if (!_is_empty.back())
+	{
+		_buffer.push_back(',');
+	}
+
+	_is_empty.back() = false;
+	WriteNewLineAndIndent();
+	WriteEscaped(key);
+	_buffer.push_back(':');
+	if (_indent > 0)
+	{
+		_buffer.push_back(' ');
+	}
+
+	_after_key = true;
+}
+
+/* #endregion */
+
+/* #region 值 */
+
+void base::JsonWriter::Null()
+{
+	BeforeValue();
+	_buffer.append("null");
+	AfterValue();
+}
+
+void base::JsonWriter::Value(bool value)
+{
+	BeforeValue();
+	_buffer.append(value ? "true" : "false");
+	AfterValue();
+}
+
+void base::JsonWriter::Value(int64_t value)
+{
+	BeforeValue();
+	char chars[24];
+	std::to_chars_result result = std::to_chars(chars, chars + sizeof(chars), value);
+	_buffer.append(chars, result.ptr);
+	AfterValue();
+}
+
+void base::JsonWriter::Value(uint64_t value)
+{
+	BeforeValue();
+	char chars[24];
+	std::to_chars_result result = std::to_chars(chars, chars + sizeof(chars), value);
+	_buffer.append(chars, result.ptr);
+	AfterValue();
+}
+
+void base::JsonWriter::Value(double value)
+{
+	if (!std::isfinite(value))
+	{
+		Null();
+		return;
+	}
+
+	BeforeValue();
+
+	// 通过公开的 dump 格式化，保证输出与 dump 逐字节相同，升级 nlohmann::json 也不受影响。
+	// dump 的数字是 Grisu2 的结果，不一定与 std::to_chars 的最短表示相同，所以不能自己用
+	// std::to_chars 按同样的规则拼出来。构造只含一个浮点数的 json 不分配内存。
+	_buffer.append(base::Json(value).dump());
+	AfterValue();
+}
+
+void base::JsonWriter::Value(std::string_view const &value)
+{
+	BeforeValue();
+	WriteEscaped(value);
+	AfterValue();
+}
+
+/* #endregion */
@@ -0,0 +1,105 @@
+#pragma once
+#include "base/string/IJsonWriter.h"
+#include "base/string/TextWriter.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace base
+{
+	///
+	/// @brief 不构造 DOM, 边生成边把 json 文本写入 base::TextWriter.
+	///
+	/// @note 内部有一块缓冲区，积累到一定大小才写入 TextWriter, 避免每个记号都调用一次虚函数。
+	/// 最外层的值写完时自动调用 Flush. 中途需要让数据到达 TextWriter 时手动调用 Flush.
+	///
+	/// @note 结构不匹配，例如在对象中写入没有键的值，或者 EndArray 与 StartObject 配对时，
+	/// 抛出 std::runtime_error.
+	///
+	class JsonWriter :
+		public base::IJsonWriter
+	{
+	private:
+		enum class Scope : uint8_t
+		{
+			Object,
+			Array,
+		};
+
+		base::TextWriter &_writer;
+		std::string _buffer;
+		int _indent = 0;
+
+		// 每一层容器，以及该层是否还没有元素。
+		std::vector<Scope> _scopes;
+		std::vector<bool> _is_empty;
+
+		bool _after_key = false;
+		bool _has_root = false;
+
+		static constexpr size_t _flush_threshold = 4096;
+
+		void WriteNewLineAndIndent();
+		void BeforeValue();
+		void AfterValue();
+		void WriteEscaped(std::string_view const &str);
+		void StartScope(Scope scope, char c);
+		void EndScope(Scope scope, char c);
+
+	public:
+		///
+		/// @brief 构造。
+		///
+		/// @param writer
+		/// @param indent 缩进的空格数。为 0 时输出紧凑格式。
+		///
+		JsonWriter(base::TextWriter &writer, int indent = 0);
+
+		///
+		/// @brief 把缓冲区中的数据写入 TextWriter.
+		///
+		virtual void Flush() override;
+
+		/* #region 容器 */
+
+		virtual void StartObject() override;
+
+		virtual void EndObject() override;
+
+		virtual void StartArray() override;
+
+		virtual void EndArray() override;
+
+		virtual void Key(std::string_view const &key) override;
+
+		/* #endregion */
+
+		/* #region 值 */
+
+		virtual void Null() override;
+
+		virtual void Value(bool value) override;
+
+		virtual void Value(int64_t value) override;
+
+		virtual void Value(uint64_t value) override;
+
+		///
+		/// @brief 写入浮点数。输出能精确还原的表示。
+		///
+		/// @note 与 nlohmann::json 的 dump 逐字节相同：小数点位置在 (-4, 15] 内时用定点表示，
+		/// 整数值带有 .0 后缀，否则用科学计数法，指数至少 2 位。非有限值写为 null.
+		///
+		/// @param value
+		///
+		virtual void Value(double value) override;
+
+		virtual void Value(std::string_view const &value) override;
+
+		/* #endregion */
+
+		using base::IJsonWriter::Value;
+	};
+
+} // namespace base
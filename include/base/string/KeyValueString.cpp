@@ -11,14 +11,22 @@ base::KeyValueString::KeyValueString(base::String const key_value_string)
 		base::StringSplitOptions options;
 		options.remove_empty_substring = false;
 		options.trim_each_substring = true;
-		auto strs = key_value_string.Split('=', options);
-		if (strs.Count() < 2)
+
+		// 在视图上拆分，只为键和值分配内存。
+		base::StringSplitEnumerator enumerator = key_value_string.View().Split('=', options);
+		if (!enumerator.MoveToNext())
+		{
+			throw std::invalid_argument{CODE_POS_STR + "非法键值对字符串。"};
+		}
+
+		base::StringView key = enumerator.CurrentValue();
+		if (!enumerator.MoveToNext())
 		{
 			throw std::invalid_argument{CODE_POS_STR + "非法键值对字符串。"};
 		}
 
-		_key = strs[0];
-		_value = strs[1];
+		_key = base::String{key};
+		_value = base::String{enumerator.CurrentValue()};
 		CheckKeyValue();
 	}
 	catch (std::exception const &e)
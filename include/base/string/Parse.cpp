@@ -1 +1,424 @@
 #include "Parse.h" // IWYU pragma: keep
+#include <bit>
+#include <cstring>
+
+namespace
+{
+	///
+	/// @brief 10 进制的 uint64_t 最多有 19 位数字时一定不会溢出。
+	///
+	constexpr int64_t _max_safe_digit_count = 19;
+
+	constexpr bool IsDigit(char c)
+	{
+		return static_cast<unsigned char>(c - '0') < 10;
+	}
+
+	///
+	/// @brief 读取 8 个字节，第 1 个字符放在最低字节。
+	///
+	/// @param p
+	/// @return
+	///
+	inline uint64_t LoadEightChars(char const *p)
+	{
+		uint64_t value = 0;
+		std::memcpy(&value, p, sizeof(value));
+		if constexpr (std::endian::native == std::endian::big)
+		{
+			// 大端机上反转字节顺序。
+			uint64_t reversed = 0;
+			for (int i = 0; i < 8; i++)
+			{
+				reversed = (reversed << 8) | ((value >> (8 * i)) & 0xFF);
+			}
+
+			value = reversed;
+		}
+
+		return value;
+	}
+
+	///
+	/// @brief 8 个字节是否都是 '0' 到 '9'.
+	///
+	/// @note 每个字节加 0x46 后，大于 '9' 的字节最高位变成 1; 减 0x30 后，小于 '0' 的字节
+	/// 最高位变成 1. 两者都没有置位时 8 个字节都是数字。
+	///
+	/// @param value
+	/// @return
+	///
+	constexpr bool IsEightDigits(uint64_t value)
+	{
+		return (((value + 0x4646464646464646) | (value - 0x3030303030303030)) & 0x8080808080808080) == 0;
+	}
+
+	///
+	/// @brief 把 8 个数字字符转换为整数。
+	///
+	/// @note 先把相邻 2 个数字合并为 0 到 99, 再用 2 次乘法把 4 个 2 位数合并为 8 位数。
+	///
+	/// @param value 由 LoadEightChars 读取，并且 IsEightDigits 为 true.
+	/// @return
+	///
+	constexpr uint32_t ParseEightDigits(uint64_t value)
+	{
+		constexpr uint64_t mask = 0x000000FF000000FF;
+		constexpr uint64_t mul1 = 100 + (1000000ULL << 32);
+		constexpr uint64_t mul2 = 1 + (10000ULL << 32);
+
+		value -= 0x3030303030303030;
+		value = (value * 10) + (value >> 8);
+		value = (((value & mask) * mul1) + (((value >> 16) & mask) * mul2)) >> 32;
+		return static_cast<uint32_t>(value);
+	}
+
+	///
+	/// @brief 从 p 开始读取数字字符累加到 value 中，最多让 digit_count 达到 _max_safe_digit_count.
+	///
+	/// @param p 读完后指向第一个没有被读取的字符。
+	/// @param last
+	/// @param value
+	/// @param digit_count 已经累加的有效数字个数。
+	///
+	inline void AccumulateDigits(char const *&p, char const *last, uint64_t &value, int64_t &digit_count)
+	{
+		while (last - p >= 8 && digit_count + 8 <= _max_safe_digit_count)
+		{
+			uint64_t chars = LoadEightChars(p);
+			if (!IsEightDigits(chars))
+			{
+				break;
+			}
+
+			value = value * 100000000 + ParseEightDigits(chars);
+			digit_count += 8;
+			p += 8;
+		}
+
+		while (p != last && IsDigit(*p) && digit_count < _max_safe_digit_count)
+		{
+			value = value * 10 + static_cast<uint64_t>(*p - '0');
+			digit_count++;
+			p++;
+		}
+	}
+
+	std::from_chars_result ParseDecimalUInt64(char const *first, char const *last, uint64_t &value)
+	{
+		char const *p = first;
+		while (p != last && *p == '0')
+		{
+			p++;
+		}
+
+		uint64_t result = 0;
+		int64_t digit_count = 0;
+		AccumulateDigits(p, last, result, digit_count);
+
+		if (p == first)
+		{
+			return std::from_chars_result{first, std::errc::invalid_argument};
+		}
+
+		// 第 20 位数字可能溢出，逐位检查。
+		bool overflow = false;
+		while (p != last && IsDigit(*p))
+		{
+			uint64_t digit = static_cast<uint64_t>(*p - '0');
+			if (overflow || result > (UINT64_MAX - digit) / 10)
+			{
+				overflow = true;
+			}
+			else
+			{
+				result = result * 10 + digit;
+			}
+
+			p++;
+		}
+
+		if (overflow)
+		{
+			return std::from_chars_result{p, std::errc::result_out_of_range};
+		}
+
+		value = result;
+		return std::from_chars_result{p, std::errc{}};
+	}
+
+	///
+	/// @brief 10 进制浮点数拆成的尾数和 10 的指数。
+	///
+	struct DecimalFloat
+	{
+		bool _is_negative = false;
+		uint64_t _mantissa = 0;
+		int64_t _exponent = 0;
+		char const *_end = nullptr;
+	};
+
+	///
+	/// @brief 按 std::from_chars 的 general 格式拆出尾数和 10 的指数。
+	///
+	/// @param first
+	/// @param last
+	/// @param result
+	/// @return 有效数字超过 19 位，指数过大，或者没有数字（可能是 inf, nan）时返回 false,
+	/// 交给 std::from_chars 处理。
+	///
+	bool ParseDecimalFloat(char const *first, char const *last, DecimalFloat &result)
+	{
+		char const *p = first;
+		if (p != last && *p == '-')
+		{
+			result._is_negative = true;
+			p++;
+		}
+
+		char const *digits_begin = p;
+		while (p != last && *p == '0')
+		{
+			p++;
+		}
+
+		bool has_digit = p != digits_begin;
+		int64_t digit_count = 0;
+
+		char const *integer_begin = p;
+		AccumulateDigits(p, last, result._mantissa, digit_count);
+		if (p != last && IsDigit(*p))
+		{
+			return false;
+		}
+
+		has_digit = has_digit || p != integer_begin;
+
+		if (p != last && *p == '.')
+		{
+			p++;
+			char const *fraction_begin = p;
+			if (result._mantissa == 0)
+			{
+				// 小数点后的前导 0 不是有效数字。
+				while (p != last && *p == '0')
+				{
+					p++;
+				}
+
+				result._exponent -= p - fraction_begin;
+			}
+
+			char const *significant_begin = p;
+			AccumulateDigits(p, last, result._mantissa, digit_count);
+			if (p != last && IsDigit(*p))
+			{
+				return false;
+			}
+
+			result._exponent -= p - significant_begin;
+			has_digit = has_digit || p != fraction_begin;
+		}
+
+		if (!has_digit)
+		{
+			return false;
+		}
+
+		if (p != last && (*p == 'e' || *p == 'E'))
+		{
+			// 指数部分没有数字时，e 不属于这个数。
+			char const *exponent_p = p + 1;
+			bool is_exponent_negative = false;
+			if (exponent_p != last && (*exponent_p == '-' || *exponent_p == '+'))
+			{
+				is_exponent_negative = *exponent_p == '-';
+				exponent_p++;
+			}
+
+			if (exponent_p != last && IsDigit(*exponent_p))
+			{
+				int64_t exponent = 0;
+				while (exponent_p != last && IsDigit(*exponent_p))
+				{
+					if (exponent > 100000)
+					{
+						return false;
+					}
+
+					exponent = exponent * 10 + (*exponent_p - '0');
+					exponent_p++;
+				}
+
+				result._exponent += is_exponent_negative ? -exponent : exponent;
+				p = exponent_p;
+			}
+		}
+
+		result._end = p;
+		return true;
+	}
+
+} // namespace
+
+base::BaseAndNumberSpan base::BaseAndNumberSpan::Parse(base::ReadOnlySpan const &span)
+{
+	char const *p = reinterpret_cast<char const *>(span.Buffer());
+	char const *last = p + span.Size();
+	bool is_negative = false;
+	int32_t base = 10;
+
+	if (p != last && *p == '-')
+	{
+		is_negative = true;
+		p++;
+	}
+
+	if (last - p >= 2 && p[0] == '0' && (p[1] == 'x' || p[1] == 'X'))
+	{
+		base = 16;
+		p += 2;
+	}
+	else if (last - p >= 2 && p[0] == '0' && p[1] != '.' && p[1] != 'e' && p[1] != 'E')
+	{
+		base = 8;
+		p += 1;
+	}
+
+	if (p != last && *p == '-')
+	{
+		// 已经剥离了头部的 0x, 0 前缀了，此时如果出现负号，就是非法字符串。
+		throw std::invalid_argument{CODE_POS_STR + "负号应该放到前缀前面。"};
+	}
+
+	return base::BaseAndNumberSpan{
+		is_negative,
+		base,
+		base::ReadOnlySpan{reinterpret_cast<uint8_t const *>(p), last - p},
+	};
+}
+
+std::from_chars_result base::FromChars(char const *first, char const *last, uint64_t &value, int32_t base)
+{
+	if (base < 2 || base > 36)
+	{
+		return std::from_chars_result{first, std::errc::invalid_argument};
+	}
+
+	if (base != 10)
+	{
+		return std::from_chars(first, last, value, base);
+	}
+
+	return ParseDecimalUInt64(first, last, value);
+}
+
+std::from_chars_result base::FromChars(char const *first, char const *last, int64_t &value, int32_t base)
+{
+	if (base < 2 || base > 36)
+	{
+		return std::from_chars_result{first, std::errc::invalid_argument};
+	}
+
+	if (base != 10)
+	{
+		return std::from_chars(first, last, value, base);
+	}
+
+	bool is_negative = first != last && *first == '-';
+	char const *digits_begin = is_negative ? first + 1 : first;
+
+	uint64_t magnitude = 0;
+	std::from_chars_result result = ParseDecimalUInt64(digits_begin, last, magnitude);
+	if (result.ec == std::errc::invalid_argument)
+	{
+		return std::from_chars_result{first, std::errc::invalid_argument};
+	}
+
+	// 负数的绝对值最大可以比正数多 1.
+	uint64_t max_magnitude = static_cast<uint64_t>(INT64_MAX) + (is_negative ? 1 : 0);
+	if (result.ec == std::errc::result_out_of_range || magnitude > max_magnitude)
+	{
+		return std::from_chars_result{result.ptr, std::errc::result_out_of_range};
+	}
+
+	// 在无符号数中取反，避免绝对值等于 2^63 时有符号数溢出。
+	value = is_negative ? static_cast<int64_t>(0 - magnitude) : static_cast<int64_t>(magnitude);
+	return result;
+}
+
+std::from_chars_result base::FromChars(char const *first, char const *last, double &value)
+{
+	DecimalFloat decimal;
+	if (!ParseDecimalFloat(first, last, decimal))
+	{
+		// 包括 inf, nan 和非法字符串。
+		return std::from_chars(first, last, value);
+	}
+
+	constexpr double powers_of_ten[] = {
+		1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+		1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+	double result = 0;
+	if (decimal._mantissa == 0)
+	{
+		result = 0;
+	}
+	else if (decimal._mantissa <= (1ULL << 53) && decimal._exponent >= -22 && decimal._exponent <= 22)
+	{
+		result = static_cast<double>(decimal._mantissa);
+		if (decimal._exponent < 0)
+		{
+			result /= powers_of_ten[-decimal._exponent];
+		}
+		else
+		{
+			result *= powers_of_ten[decimal._exponent];
+		}
+	}
+	else
+	{
+		return std::from_chars(first, last, value);
+	}
+
+	value = decimal._is_negative ? -result : result;
+	return std::from_chars_result{decimal._end, std::errc{}};
+}
+
+std::from_chars_result base::FromChars(char const *first, char const *last, float &value)
+{
+	DecimalFloat decimal;
+	if (!ParseDecimalFloat(first, last, decimal))
+	{
+		// 包括 inf, nan 和非法字符串。
+		return std::from_chars(first, last, value);
+	}
+
+	constexpr float powers_of_ten[] = {1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+
+	float result = 0;
+	if (decimal._mantissa == 0)
+	{
+		result = 0;
+	}
+	else if (decimal._mantissa <= (1ULL << 24) && decimal._exponent >= -10 && decimal._exponent <= 10)
+	{
+		result = static_cast<float>(decimal._mantissa);
+		if (decimal._exponent < 0)
+		{
+			result /= powers_of_ten[-decimal._exponent];
+		}
+		else
+		{
+			result *= powers_of_ten[decimal._exponent];
+		}
+	}
+	else
+	{
+		return std::from_chars(first, last, value);
+	}
+
+	value = decimal._is_negative ? -result : result;
+	return std::from_chars_result{decimal._end, std::errc{}};
+}
@@ -1,15 +1,21 @@
 #pragma once
+#include "base/container/ArraySpan.h"
 #include "base/container/Range.h"
 #include "base/math/Fraction.h"
 #include "base/math/math.h"
+#include "base/stream/ReadOnlySpan.h"
 #include "base/stream/Span.h"
 #include "base/string/define.h"
 #include "base/string/String.h"
 #include "base/string/StringSplitOptions.h"
+#include <charconv>
 #include <cstdint>
+#include <limits>
 #include <stdexcept>
 #include <string>
+#include <system_error>
 #include <type_traits>
+#include <vector>
 
 namespace base
 {
@@ -104,108 +110,483 @@ namespace base
 		}
 	};
 
+	///
+	/// @brief 数字字符串的符号、进制和数字部分。引用原字符串，不分配内存。
+	///
+	class BaseAndNumberSpan
+	{
+	private:
+		bool _is_negative = false;
+		int32_t _base = 10;
+		base::ReadOnlySpan _number_span;
+
+	public:
+		BaseAndNumberSpan(bool is_negative, int32_t base, base::ReadOnlySpan const &number_span)
+			: _is_negative(is_negative),
+			  _base(base),
+			  _number_span(number_span)
+		{
+		}
+
+		///
+		/// @brief 是否有负号。
+		///
+		/// @return
+		///
+		bool IsNegative() const
+		{
+			return _is_negative;
+		}
+
+		///
+		/// @brief 进制。
+		///
+		/// @return
+		///
+		int32_t Base() const
+		{
+			return _base;
+		}
+
+		///
+		/// @brief 去掉负号和进制前缀后的数字部分。
+		///
+		/// @return
+		///
+		base::ReadOnlySpan NumberSpan() const
+		{
+			return _number_span;
+		}
+
+		///
+		/// @brief 与 BaseAndNumberString::Parse 规则相同：0x 或 0X 开头是 16 进制，
+		/// 0 开头并且后面还有字符是 8 进制，负号要放到前缀前面。
+		///
+		/// @param span
+		/// @return
+		///
+		static BaseAndNumberSpan Parse(base::ReadOnlySpan const &span);
+	};
+
 	/* #endregion */
 
+	/* #region 不分配内存的解析 */
+
 	///
-	/// @brief 从字符串中解析 int64_t.
+	/// @brief 从 [first, last) 的开头解析 uint64_t. 语义与 std::from_chars 相同：
+	/// 	@li 不跳过空白字符，不接受正号。
+	/// 	@li 没有数字时返回 std::errc::invalid_argument, ptr 等于 first.
+	/// 	@li 超出范围时返回 std::errc::result_out_of_range, ptr 指向数字的后面，value 不被修改。
 	///
-	/// @param str 可以是 10 进制，16 进制，8 进制数的字符串，但是不能有 0x 之类的前缀。
-	/// @param base 指定字符串中数字的进制数。
+	/// @note 10 进制时每次用 SWAR 把 8 个数字字符转换为整数，其他进制交给 std::from_chars.
 	///
+	/// @param first
+	/// @param last
+	/// @param value
+	/// @param base 进制。范围是 [2, 36].
+	/// @return
+	///
+	std::from_chars_result FromChars(char const *first, char const *last, uint64_t &value, int32_t base = 10);
+
+	///
+	/// @brief 从 [first, last) 的开头解析 int64_t. 语义与 std::from_chars 相同。
+	///
+	/// @param first
+	/// @param last
+	/// @param value
+	/// @param base 进制。范围是 [2, 36].
+	/// @return
+	///
+	std::from_chars_result FromChars(char const *first, char const *last, int64_t &value, int32_t base = 10);
+
+	///
+	/// @brief 从 [first, last) 的开头解析除了 int64_t, uint64_t 的整型。语义与 std::from_chars 相同。
+	///
+	/// @param first
+	/// @param last
+	/// @param value
+	/// @param base 进制。范围是 [2, 36].
 	/// @return
 	///
 	template <typename T>
-		requires(std::is_same_v<T, int64_t>)
-	inline T Parse(base::String const &str, int32_t base)
+		requires(std::is_integral_v<T> &&
+				 !std::is_same_v<T, bool> &&
+				 !std::is_same_v<T, int64_t> &&
+				 !std::is_same_v<T, uint64_t>)
+	inline std::from_chars_result FromChars(char const *first, char const *last, T &value, int32_t base = 10)
 	{
-		// 解析时使用的子字符串的最后一个字符的下一个字符的索引。
-		// 如果整个字符串都用来被解析，则应该等于字符串长度。
-		size_t parse_end_index = 0;
-		T result = std::stoll(str.StdString(), &parse_end_index, base);
+		using wide_type = std::conditional_t<std::is_signed_v<T>, int64_t, uint64_t>;
 
-		if (static_cast<int32_t>(parse_end_index) != str.Length())
+		wide_type wide_value = 0;
+		std::from_chars_result result = base::FromChars(first, last, wide_value, base);
+		if (result.ec != std::errc{})
 		{
-			// 没有将整个字符串都用来解析。
-			throw std::invalid_argument{CODE_POS_STR + "非法字符串：" + str.StdString()};
+			return result;
 		}
 
+		if (wide_value < static_cast<wide_type>(std::numeric_limits<T>::min()) ||
+			wide_value > static_cast<wide_type>(std::numeric_limits<T>::max()))
+		{
+			result.ec = std::errc::result_out_of_range;
+			return result;
+		}
+
+		value = static_cast<T>(wide_value);
 		return result;
 	}
 
 	///
-	/// @brief 从字符串中解析 uint64_t.
+	/// @brief 从 [first, last) 的开头解析 10 进制的 double. 语义与 std::from_chars 相同，
+	/// 接受小数和指数形式。
 	///
-	/// @param str 可以是 10 进制，16 进制，8 进制数的字符串，但是不能有 0x 之类的前缀。
-	/// @param base 指定字符串中数字的进制数。
+	/// @note 有效数字不超过 19 位，尾数不超过 2^53, 10 的指数在 [-22, 22] 范围内时，尾数和
+	/// 10 的幂都能被 double 精确表示，一次乘法或除法得到的就是正确舍入的结果。
+	/// 常见的测量数据都满足这个条件。不满足时交给 std::from_chars.
 	///
+	/// @param first
+	/// @param last
+	/// @param value
 	/// @return
 	///
+	std::from_chars_result FromChars(char const *first, char const *last, double &value);
+
+	///
+	/// @brief 从 [first, last) 的开头解析 10 进制的 float. 语义与 std::from_chars 相同。
+	///
+	/// @note 快速路径的条件是尾数不超过 2^24, 10 的指数在 [-10, 10] 范围内。
+	///
+	/// @param first
+	/// @param last
+	/// @param value
+	/// @return
+	///
+	std::from_chars_result FromChars(char const *first, char const *last, float &value);
+
+	///
+	/// @brief 尝试把整个 span 解析为整型。
+	///
+	/// @param span 只能包含数字和负号，不能有进制前缀和空白字符。
+	/// @param value 接收结果。失败时不被修改。
+	/// @param base 进制。
+	/// @return 整个 span 都是合法的数字，并且没有超出范围时返回 true.
+	///
 	template <typename T>
-		requires(std::is_same_v<T, uint64_t>)
-	inline T Parse(base::String const &str, int32_t base)
+		requires(std::is_integral_v<T> && !std::is_same_v<T, bool>)
+	inline bool TryParse(base::ReadOnlySpan const &span, T &value, int32_t base = 10)
 	{
-		// 解析时使用的子字符串的最后一个字符的下一个字符的索引。
-		// 如果整个字符串都用来被解析，则应该等于字符串长度。
-		size_t parse_end_index = 0;
-		T result = std::stoull(str.StdString(), &parse_end_index, base);
+		char const *first = reinterpret_cast<char const *>(span.Buffer());
+		char const *last = first + span.Size();
 
-		if (static_cast<int32_t>(parse_end_index) != str.Length())
+		T result{};
+		std::from_chars_result from_chars_result = base::FromChars(first, last, result, base);
+		if (from_chars_result.ec != std::errc{} || from_chars_result.ptr != last)
 		{
-			// 没有将整个字符串都用来解析。
-			throw std::invalid_argument{CODE_POS_STR + "非法字符串：" + str.StdString()};
+			return false;
 		}
 
-		return result;
+		value = result;
+		return true;
 	}
 
 	///
-	/// @brief 从字符串中解析除了 int64_t 的有符号整型。
+	/// @brief 尝试把整个 span 解析为 10 进制的浮点数。
 	///
-	/// @param str 可以是 10 进制，16 进制，8 进制数的字符串，但是不能有 0x 之类的前缀。
-	/// @param base 指定字符串中数字的进制数。
+	/// @param span 不能有空白字符。
+	/// @param value 接收结果。失败时不被修改。
+	/// @return 整个 span 都是合法的数字，并且没有超出范围时返回 true.
+	///
+	template <typename T>
+		requires(std::is_same_v<T, double> ||
+				 std::is_same_v<T, float>)
+	inline bool TryParse(base::ReadOnlySpan const &span, T &value)
+	{
+		char const *first = reinterpret_cast<char const *>(span.Buffer());
+		char const *last = first + span.Size();
+
+		T result{};
+		std::from_chars_result from_chars_result = base::FromChars(first, last, result);
+		if (from_chars_result.ec != std::errc{} || from_chars_result.ptr != last)
+		{
+			return false;
+		}
+
+		value = result;
+		return true;
+	}
+
+	///
+	/// @brief 批量解析分隔的数字。
+	///
+	/// @note 分隔符和换行符都分隔字段。换行符可以是 \n 或 \r\n, 空行被跳过。
+	/// 整数按 10 进制解析。
+	///
+	/// @param text 例如 "1,2,3\n4,5,6\n".
+	/// @param separator 字段分隔符。
+	/// @param out 接收结果。
+	/// @return 解析出的数字个数。
+	///
+	/// @exception std::invalid_argument 某个字段不是合法的数字，或者超出范围，或者 out 容纳不下。
+	///
+	template <typename T>
+		requires(std::is_integral_v<T> ||
+				 std::is_same_v<T, double> ||
+				 std::is_same_v<T, float>)
+	inline int64_t ParseDelimited(base::ReadOnlySpan const &text,
+								  char separator,
+								  base::ArraySpan<T> const &out)
+	{
+		char const *p = reinterpret_cast<char const *>(text.Buffer());
+		char const *last = p + text.Size();
+		int64_t count = 0;
+
+		while (p < last)
+		{
+			if (*p == '\n' || *p == '\r')
+			{
+				p++;
+				continue;
+			}
+
+			if (count >= out.Count())
+			{
+				throw std::invalid_argument{CODE_POS_STR + "out 容纳不下所有数字。"};
+			}
+
+			std::from_chars_result result = base::FromChars(p, last, out.Buffer()[count]);
+			if (result.ec != std::errc{})
+			{
+				throw std::invalid_argument{CODE_POS_STR + "第 " + std::to_string(count) + " 个字段不是合法的数字。"};
+			}
+
+			p = result.ptr;
+			count++;
+
+			if (p == last)
+			{
+				break;
+			}
+
+			if (*p == separator)
+			{
+				p++;
+				if (p == last || *p == '\n' || *p == '\r')
+				{
+					// 分隔符后面没有字段了。
+					throw std::invalid_argument{CODE_POS_STR + "第 " + std::to_string(count) + " 个字段为空。"};
+				}
+			}
+			else if (*p != '\n' && *p != '\r')
+			{
+				throw std::invalid_argument{CODE_POS_STR + "第 " + std::to_string(count - 1) + " 个字段不是合法的数字。"};
+			}
+		}
+
+		return count;
+	}
+
 	///
+	/// @brief 按列批量解析分隔的数字。
+	///
+	/// @note 每行的字段依次追加到 columns 的各个列中。换行符可以是 \n 或 \r\n, 空行被跳过。
+	/// 整数按 10 进制解析。
+	///
+	/// @param text 例如 "1,2,3\n4,5,6\n".
+	/// @param separator 字段分隔符。
+	/// @param columns 列的个数就是每行字段的个数，不能为 0.
+	/// @return 解析出的行数。
+	///
+	/// @exception std::invalid_argument 某个字段不是合法的数字，或者超出范围，或者某行的字段数不等于列数。
+	///
+	template <typename T>
+		requires(std::is_integral_v<T> ||
+				 std::is_same_v<T, double> ||
+				 std::is_same_v<T, float>)
+	inline int64_t ParseColumns(base::ReadOnlySpan const &text,
+								char separator,
+								std::vector<std::vector<T>> &columns)
+	{
+		if (columns.empty())
+		{
+			throw std::invalid_argument{CODE_POS_STR + "columns 的列数不能为 0."};
+		}
+
+		char const *p = reinterpret_cast<char const *>(text.Buffer());
+		char const *last = p + text.Size();
+		int64_t row_count = 0;
+
+		while (p < last)
+		{
+			if (*p == '\n' || *p == '\r')
+			{
+				p++;
+				continue;
+			}
+
+			for (size_t column = 0; column < columns.size(); column++)
+			{
+				T value{};
+				std::from_chars_result result = base::FromChars(p, last, value);
+				if (result.ec != std::errc{})
+				{
+					throw std::invalid_argument{CODE_POS_STR + "第 " + std::to_string(row_count) + " 行第 " +
+												std::to_string(column) + " 列不是合法的数字。"};
+				}
+
+				columns[column].push_back(value);
+				p = result.ptr;
+
+				bool is_last_column = column + 1 == columns.size();
+				bool is_line_end = p == last || *p == '\n' || *p == '\r';
+				if (is_last_column && is_line_end)
+				{
+					break;
+				}
+
+				if (is_last_column || is_line_end || *p != separator)
+				{
+					throw std::invalid_argument{CODE_POS_STR + "第 " + std::to_string(row_count) + " 行的字段数与列数不符。"};
+				}
+
+				p++;
+			}
+
+			row_count++;
+		}
+
+		return row_count;
+	}
+
+	/* #endregion */
+
+	/* #region 整型解析的辅助函数 */
+
+	///
+	/// @brief 跳过开头的空白字符和正号。规则与 std::stoll 相同，正号后面不能再有符号，
+	/// 这种情况下不跳过正号，让后面的解析失败。
+	///
+	/// @param first
+	/// @param last
+	/// @return 跳过后的位置。
+	///
+	inline char const *SkipLeadingSpaceAndPlus(char const *first, char const *last)
+	{
+		while (first != last &&
+			   (*first == ' ' || *first == '\t' || *first == '\n' ||
+				*first == '\v' || *first == '\f' || *first == '\r'))
+		{
+			first++;
+		}
+
+		if (first != last && *first == '+')
+		{
+			if (last - first >= 2 && (first[1] == '+' || first[1] == '-'))
+			{
+				return first;
+			}
+
+			first++;
+		}
+
+		return first;
+	}
+
+	///
+	/// @brief 把解析出的符号和绝对值转换为 T.
+	///
+	/// @note 异常与原来基于 std::stoll, std::stoull 的实现相同：
+	/// 	@li 超出 int64_t 或 uint64_t 的范围时抛出 std::out_of_range.
+	/// 	@li 在 64 位整型的范围内，但是超出 T 的范围时抛出 std::runtime_error.
+	/// 	无符号整型遇到非 0 的负数也属于这种情况。
+	///
+	/// @param str 被解析的字符串，用于异常信息。
+	/// @param is_negative 是否有负号。
+	/// @param magnitude 绝对值。
+	/// @param ec 解析绝对值时 base::FromChars 返回的错误码。
 	/// @return
 	///
 	template <typename T>
-		requires(std::is_signed_v<T> &&
-				 std::is_integral_v<T> &&
-				 !std::is_same_v<T, int64_t>)
-	inline T Parse(base::String const &str, int32_t base)
+		requires(std::is_integral_v<T> && !std::is_same_v<T, bool>)
+	inline T IntegerFromMagnitude(base::String const &str, bool is_negative, uint64_t magnitude, std::errc ec)
 	{
-		int64_t result64 = Parse<int64_t>(str, base);
+		if (ec == std::errc::result_out_of_range)
+		{
+			throw std::out_of_range{CODE_POS_STR + str.StdString() + " 超出范围。"};
+		}
 
-		if (result64 < std::numeric_limits<T>::min() || result64 > std::numeric_limits<T>::max())
+		if constexpr (std::is_signed_v<T>)
 		{
-			throw std::runtime_error{CODE_POS_STR + str.StdString() + " 超出范围。"};
+			// 负数的绝对值最大可以比正数多 1.
+			uint64_t max_magnitude = static_cast<uint64_t>(std::numeric_limits<int64_t>::max());
+			if (is_negative)
+			{
+				max_magnitude += 1;
+			}
+
+			if (magnitude > max_magnitude)
+			{
+				throw std::out_of_range{CODE_POS_STR + str.StdString() + " 超出范围。"};
+			}
+
+			// 在无符号数中取反，避免绝对值等于最小值时有符号数溢出。
+			int64_t value = static_cast<int64_t>(is_negative ? 0 - magnitude : magnitude);
+			if (value < std::numeric_limits<T>::min() || value > std::numeric_limits<T>::max())
+			{
+				throw std::runtime_error{CODE_POS_STR + str.StdString() + " 超出范围。"};
+			}
+
+			return static_cast<T>(value);
 		}
+		else
+		{
+			if ((is_negative && magnitude != 0) || magnitude > std::numeric_limits<T>::max())
+			{
+				throw std::runtime_error{CODE_POS_STR + str.StdString() + " 超出范围。"};
+			}
 
-		T result = static_cast<T>(result64);
-		return result;
+			return static_cast<T>(magnitude);
+		}
 	}
 
+	/* #endregion */
+
 	///
-	/// @brief 从字符串中解析除了 uint64_t 的无符号整型。
+	/// @brief 从字符串中解析整型。
 	///
 	/// @param str 可以是 10 进制，16 进制，8 进制数的字符串，但是不能有 0x 之类的前缀。
+	/// 与 std::stoll 一样，开头可以有空白字符和正号。
+	///
 	/// @param base 指定字符串中数字的进制数。
 	///
 	/// @return
 	///
+	/// @exception std::invalid_argument 字符串不是合法的数字，或者数字后面还有其他字符。
+	/// @exception std::out_of_range 超出 int64_t 或 uint64_t 的范围。
+	/// @exception std::runtime_error 没有超出 64 位整型的范围，但是超出 T 的范围。
+	///
 	template <typename T>
-		requires(std::is_unsigned_v<T> &&
-				 std::is_integral_v<T> &&
-				 !std::is_same_v<T, uint64_t>)
+		requires(std::is_integral_v<T> && !std::is_same_v<T, bool>)
 	inline T Parse(base::String const &str, int32_t base)
 	{
-		uint64_t result64 = Parse<uint64_t>(str, base);
+		char const *first = reinterpret_cast<char const *>(str.Span().Buffer());
+		char const *last = first + str.Length();
+		first = base::SkipLeadingSpaceAndPlus(first, last);
 
-		if (result64 < std::numeric_limits<T>::min() || result64 > std::numeric_limits<T>::max())
+		bool is_negative = false;
+		if (first != last && *first == '-')
 		{
-			throw std::runtime_error{CODE_POS_STR + str.StdString() + " 超出范围。"};
+			is_negative = true;
+			first++;
 		}
 
-		T result = static_cast<T>(result64);
-		return result;
+		uint64_t magnitude = 0;
+		std::from_chars_result from_chars_result = base::FromChars(first, last, magnitude, base);
+		if (from_chars_result.ec == std::errc::invalid_argument || from_chars_result.ptr != last)
+		{
+			// 没有将整个字符串都用来解析。
+			throw std::invalid_argument{CODE_POS_STR + "非法字符串：" + str.StdString()};
+		}
+
+		return base::IntegerFromMagnitude<T>(str, is_negative, magnitude, from_chars_result.ec);
 	}
 
 	///
@@ -214,6 +595,8 @@ namespace base
 	/// @param str 可以是 10 进制，16 进制，8 进制数的字符串，但是不能有 0x 之类的前缀。
 	/// @param base 指定字符串中数字的进制数。
 	///
+	/// @note 10 进制走 base::FromChars, 不分配内存，并且接受指数形式。
+	///
 	/// @return
 	///
 	template <typename T>
@@ -226,6 +609,17 @@ namespace base
 			throw std::invalid_argument{CODE_POS_STR + "不允许传入空字符串。"};
 		}
 
+		if (base == 10)
+		{
+			T result{};
+			if (!base::TryParse(str.Span(), result))
+			{
+				throw std::invalid_argument{CODE_POS_STR + "非法字符串：" + str.StdString()};
+			}
+
+			return result;
+		}
+
 		base::String copy = str;
 		bool is_negative = false;
 
@@ -274,17 +668,67 @@ namespace base
 	/// @brief 从字符串中解析数字.
 	///
 	/// @param str 可以是十进制数字符串，0x 开头的 16 进制数字符串，0 开头的 8 进制数字符串。
+	/// 开头可以有空白字符和正号。
+	///
+	/// @note 整型和 10 进制的浮点数不分配内存。
 	///
 	/// @return
 	///
+	/// @exception std::invalid_argument 字符串不是合法的数字，或者数字后面还有其他字符。
+	/// @exception std::out_of_range 超出 int64_t 或 uint64_t 的范围。
+	/// @exception std::runtime_error 没有超出 64 位整型的范围，但是超出 T 的范围。
+	///
 	template <typename T>
-		requires(std::is_integral_v<T> ||
-				 std::is_same_v<T, double> ||
+		requires(std::is_integral_v<T> && !std::is_same_v<T, bool>)
+	inline T Parse(base::String const &str)
+	{
+		char const *first = reinterpret_cast<char const *>(str.Span().Buffer());
+		char const *last = first + str.Length();
+		first = base::SkipLeadingSpaceAndPlus(first, last);
+
+		base::BaseAndNumberSpan pair = base::BaseAndNumberSpan::Parse(
+			base::ReadOnlySpan{reinterpret_cast<uint8_t const *>(first), last - first});
+
+		first = reinterpret_cast<char const *>(pair.NumberSpan().Buffer());
+		last = first + pair.NumberSpan().Size();
+
+		uint64_t magnitude = 0;
+		std::from_chars_result from_chars_result = base::FromChars(first, last, magnitude, pair.Base());
+		if (from_chars_result.ec == std::errc::invalid_argument || from_chars_result.ptr != last)
+		{
+			throw std::invalid_argument{CODE_POS_STR + "非法字符串：" + str.StdString()};
+		}
+
+		return base::IntegerFromMagnitude<T>(str, pair.IsNegative(), magnitude, from_chars_result.ec);
+	}
+
+	///
+	/// @brief 从字符串中解析数字.
+	///
+	/// @param str 可以是十进制数字符串，0x 开头的 16 进制数字符串，0 开头的 8 进制数字符串。
+	///
+	/// @note 0 后面紧跟小数点或指数时是 10 进制，例如 0.5.
+	///
+	/// @return
+	///
+	template <typename T>
+		requires(std::is_same_v<T, double> ||
 				 std::is_same_v<T, float>)
 	inline T Parse(base::String const &str)
 	{
-		base::BaseAndNumberString pair = base::BaseAndNumberString::Parse(str);
-		return Parse<T>(pair.NumberString(), pair.Base());
+		base::BaseAndNumberSpan pair = base::BaseAndNumberSpan::Parse(str.Span());
+		if (pair.Base() == 10)
+		{
+			return Parse<T>(str, 10);
+		}
+
+		base::String number_str{pair.NumberSpan()};
+		if (pair.IsNegative())
+		{
+			number_str = '-' + number_str;
+		}
+
+		return Parse<T>(number_str, pair.Base());
 	}
 
 } // namespace base
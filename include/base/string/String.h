@@ -7,6 +7,7 @@
 #include "base/stream/Span.h"
 #include "base/string/character.h"
 #include "base/string/StringSplitOptions.h"
+#include "base/string/StringView.h"
 #include <cctype>
 #include <cstddef>
 #include <ostream> // IWYU pragma: keep
@@ -110,6 +111,16 @@ namespace base
 		{
 		}
 
+		///
+		/// @brief 从字符串视图中构造，将其内容拷贝过来。
+		///
+		/// @param view
+		///
+		String(base::StringView const &view)
+		{
+			_string = std::string{view.Buffer(), static_cast<size_t>(view.Length())};
+		}
+
 		/* #endregion */
 
 		///
@@ -158,6 +169,18 @@ namespace base
 			};
 		}
 
+		///
+		/// @brief 获取引用本字符串内容的视图。
+		///
+		/// @note 本字符串被修改或析构后视图失效。
+		///
+		/// @return
+		///
+		base::StringView View() const
+		{
+			return base::StringView{_string};
+		}
+
 		///
 		/// @brief 隐式转换为 base::Span.
 		///
@@ -258,6 +281,9 @@ namespace base
 		///
 		/// @brief 根据分隔符，将字符串拆分成多个子字符串，放到列表中返回。
 		///
+		/// @note 在视图上拆分和裁剪，只为最终放入列表的子字符串分配内存。
+		/// 不需要列表时用 View().Split 惰性拆分，完全不分配内存。
+		///
 		/// @param separator
 		/// @param options
 		///
@@ -267,60 +293,13 @@ namespace base
 									   base::StringSplitOptions const &options = StringSplitOptions{}) const
 		{
 			base::List<base::String> ret;
-
-			/// @brief 在设定的选项下将字符串添加到列表中
-			/// @param o 要被添加的字符串的引用。将会根据 options 对其进行修改后添加到 ret
-			/// 列表中。
-			auto add_to_list_under_options = [&](base::String &o)
+			base::StringSplitEnumerator enumerator = View().Split(separator, options);
+			while (enumerator.MoveToNext())
 			{
-				if (options.trim_each_substring)
-				{
-					o.Trim();
-				}
-
-				if (options.remove_empty_substring && o == "")
-				{
-					return;
-				}
-
-				ret.Add(o);
-			};
-
-			base::ReadOnlySpan span{
-				reinterpret_cast<uint8_t const *>(_string.data()),
-				static_cast<int64_t>(_string.size()),
-			};
-
-			while (true)
-			{
-				int64_t index = span.IndexOf(separator);
-				if (index < 0)
-				{
-					// 找不到分隔符，将剩余的整个 span 作为一个字符串。
-					base::String temp_str{span};
-					add_to_list_under_options(temp_str);
-					return ret;
-				}
-
-				// 找到分隔符
-				base::String temp_str{span[base::Range{0, index}]};
-				add_to_list_under_options(temp_str);
-
-				if (index + 1 >= span.Size())
-				{
-					// 已经到达末尾了，没有剩余字符了
-					if (_string[_string.size() - 1] == separator)
-					{
-						// 如果以分隔符结尾，还需要末尾再添加一个空字符串。
-						base::String temp_str{""};
-						add_to_list_under_options(temp_str);
-					}
-
-					return ret;
-				}
-
-				span = span[base::Range{index + 1, span.Size()}];
+				ret.Add(base::String{enumerator.CurrentValue()});
 			}
+
+			return ret;
 		}
 
 		///
@@ -0,0 +1,163 @@
+#include "StringView.h" // IWYU pragma: keep
+#include <bit>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__)
+	#define BASE_STRING_VIEW_SSE2 1
+	#include <emmintrin.h>
+#else
+	#define BASE_STRING_VIEW_SSE2 0
+#endif
+
+namespace
+{
+	///
+	/// @brief 查找 chars 中任意一个字符第一次出现的位置。
+	///
+	/// @param buffer
+	/// @param size
+	/// @param chars
+	/// @param char_count
+	/// @return 找到了返回索引，没找到返回 -1.
+	///
+	int64_t FindAny(char const *buffer, int64_t size, char const *chars, int64_t char_count)
+	{
+		if (char_count == 0 || size == 0)
+		{
+			return -1;
+		}
+
+		if (char_count == 1)
+		{
+			// 单个字符交给 memchr. 标准库的实现已经按 CPU 选择了向量化版本。
+			void const *found = std::memchr(buffer, chars[0], static_cast<size_t>(size));
+			if (found == nullptr)
+			{
+				return -1;
+			}
+
+			return static_cast<char const *>(found) - buffer;
+		}
+
+		int64_t i = 0;
+
+#if BASE_STRING_VIEW_SSE2
+		if (char_count <= 16)
+		{
+			__m128i needles[16];
+			for (int64_t k = 0; k < char_count; k++)
+			{
+				needles[k] = _mm_set1_epi8(chars[k]);
+			}
+
+			for (; i + 16 <= size; i += 16)
+			{
+				__m128i chunk = _mm_loadu_si128(reinterpret_cast<__m128i const *>(buffer + i));
+				__m128i matched = _mm_cmpeq_epi8(chunk, needles[0]);
+				for (int64_t k = 1; k < char_count; k++)
+				{
+					matched = _mm_or_si128(matched, _mm_cmpeq_epi8(chunk, needles[k]));
+				}
+
+				int mask = _mm_movemask_epi8(matched);
+				if (mask != 0)
+				{
+					return i + std::countr_zero(static_cast<uint32_t>(mask));
+				}
+			}
+		}
+#endif
+
+		if (i >= size)
+		{
+			return -1;
+		}
+
+		// 剩余部分用表查找，每个字符只访问一次表。
+		bool table[256]{};
+		for (int64_t k = 0; k < char_count; k++)
+		{
+			table[static_cast<uint8_t>(chars[k])] = true;
+		}
+
+		for (; i < size; i++)
+		{
+			if (table[static_cast<uint8_t>(buffer[i])])
+			{
+				return i;
+			}
+		}
+
+		return -1;
+	}
+
+} // namespace
+
+int64_t base::StringView::IndexOf(int64_t start, char match) const
+{
+	return IndexOfAny(start, base::StringView{&match, 1});
+}
+
+int64_t base::StringView::IndexOf(int64_t start, base::StringView const &match) const
+{
+	if (start < 0 || start > _length)
+	{
+		throw std::out_of_range{CODE_POS_STR + "start 超出范围。"};
+	}
+
+	if (match._length == 0)
+	{
+		return start;
+	}
+
+	int64_t last_start = _length - match._length;
+	int64_t i = start;
+	while (i <= last_start)
+	{
+		// 只在可能容纳整个 match 的范围内找首字符。
+		int64_t offset = FindAny(_buffer + i, last_start - i + 1, match._buffer, 1);
+		if (offset < 0)
+		{
+			return -1;
+		}
+
+		i += offset;
+		if (std::memcmp(_buffer + i + 1, match._buffer + 1, static_cast<size_t>(match._length - 1)) == 0)
+		{
+			return i;
+		}
+
+		i++;
+	}
+
+	return -1;
+}
+
+int64_t base::StringView::IndexOfAny(int64_t start, base::StringView const &chars) const
+{
+	if (start < 0 || start > _length)
+	{
+		throw std::out_of_range{CODE_POS_STR + "start 超出范围。"};
+	}
+
+	int64_t offset = FindAny(_buffer + start, _length - start, chars._buffer, chars._length);
+	if (offset < 0)
+	{
+		return -1;
+	}
+
+	return start + offset;
+}
+
+base::StringSplitEnumerator base::StringView::Split(char separator,
+													base::StringSplitOptions const &options) const
+{
+	return base::StringSplitEnumerator{*this, base::StringView{&separator, 1}, options};
+}
+
+base::StringSplitEnumerator base::StringView::Tokenize(base::StringView const &delimiters) const
+{
+	base::StringSplitOptions options;
+	options.trim_each_substring = false;
+	options.remove_empty_substring = true;
+	return base::StringSplitEnumerator{*this, delimiters, options};
+}
@@ -0,0 +1,580 @@
+#pragma once
+#include "base/container/iterator/IEnumerator.h"
+#include "base/container/Range.h"
+#include "base/stream/ReadOnlySpan.h"
+#include "base/string/character.h"
+#include "base/string/define.h"
+#include "base/string/StringSplitOptions.h"
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace base
+{
+	class StringSplitEnumerator;
+
+	///
+	/// @brief 不拥有内存的只读字符串视图。
+	///
+	/// @note 只保存指针和长度，复制、切片、裁剪都不分配内存。
+	/// 被引用的字符串必须比视图活得久。
+	///
+	/// @note 查找字符时 x86 上用 SSE2 一次比较 16 个字节。
+	///
+	class StringView
+	{
+	private:
+		friend class base::StringSplitEnumerator;
+
+		char const *_buffer = nullptr;
+		int64_t _length = 0;
+
+	public:
+		/* #region 构造函数 */
+
+		///
+		/// @brief 构造一个空视图。
+		///
+		constexpr StringView() = default;
+
+		///
+		/// @brief 引用一段字符。
+		///
+		/// @param buffer
+		/// @param length
+		///
+		constexpr StringView(char const *buffer, int64_t length)
+			: _buffer(buffer),
+			  _length(length)
+		{
+			if (length < 0)
+			{
+				throw std::invalid_argument{CODE_POS_STR + "length 不能 < 0."};
+			}
+		}
+
+		///
+		/// @brief 引用 C 风格的字符串，不包括结尾的空字符。
+		///
+		/// @param str
+		///
+		constexpr StringView(char const *str)
+			: _buffer(str),
+			  _length(static_cast<int64_t>(std::char_traits<char>::length(str)))
+		{
+		}
+
+		///
+		/// @brief 引用 std::string 的内容。
+		///
+		/// @param str
+		///
+		StringView(std::string const &str)
+			: _buffer(str.data()),
+			  _length(static_cast<int64_t>(str.size()))
+		{
+		}
+
+		///
+		/// @brief 引用 std::string_view 的内容。
+		///
+		/// @param str
+		///
+		constexpr StringView(std::string_view const &str)
+			: _buffer(str.data()),
+			  _length(static_cast<int64_t>(str.size()))
+		{
+		}
+
+		///
+		/// @brief 引用只读内存段。
+		///
+		/// @param span
+		///
+		StringView(base::ReadOnlySpan const &span)
+			: _buffer(reinterpret_cast<char const *>(span.Buffer())),
+			  _length(span.Size())
+		{
+		}
+
+		/* #endregion */
+
+		///
+		/// @brief 字符串长度。
+		///
+		/// @return
+		///
+		constexpr int64_t Length() const
+		{
+			return _length;
+		}
+
+		///
+		/// @brief 被引用的字符。
+		///
+		/// @return
+		///
+		constexpr char const *Buffer() const
+		{
+			return _buffer;
+		}
+
+		///
+		/// @brief 转换为只读内存段。
+		///
+		/// @return
+		///
+		base::ReadOnlySpan Span() const
+		{
+			return base::ReadOnlySpan{reinterpret_cast<uint8_t const *>(_buffer), _length};
+		}
+
+		///
+		/// @brief 隐式转换为 base::ReadOnlySpan.
+		///
+		/// @return
+		///
+		operator base::ReadOnlySpan() const
+		{
+			return Span();
+		}
+
+		///
+		/// @brief 转换为 std::string_view.
+		///
+		/// @return
+		///
+		constexpr std::string_view StdStringView() const
+		{
+			return std::string_view{_buffer, static_cast<size_t>(_length)};
+		}
+
+		///
+		/// @brief 把内容拷贝到一个新的 std::string 中。
+		///
+		/// @return
+		///
+		std::string ToStdString() const
+		{
+			return std::string{_buffer, static_cast<size_t>(_length)};
+		}
+
+		/* #region 索引器 */
+
+		///
+		/// @brief 获取指定索引位置的字符。
+		///
+		/// @param index
+		/// @return
+		///
+		char operator[](int64_t index) const
+		{
+			if (index < 0 || index >= _length)
+			{
+				throw std::out_of_range{CODE_POS_STR + "索引超出范围。"};
+			}
+
+			return _buffer[index];
+		}
+
+		///
+		/// @brief 获取指定范围内的子视图。不拷贝。
+		///
+		/// @param range
+		/// @return
+		///
+		base::StringView operator[](base::Range const &range) const
+		{
+			return Slice(range);
+		}
+
+		///
+		/// @brief 获取指定范围内的子视图。不拷贝。
+		///
+		/// @param range
+		/// @return
+		///
+		base::StringView Slice(base::Range const &range) const
+		{
+			if (range.Begin() < 0 || range.End() > _length)
+			{
+				throw std::out_of_range{CODE_POS_STR + "range 超出范围。"};
+			}
+
+			return base::StringView{_buffer + range.Begin(), range.Size()};
+		}
+
+		/* #endregion */
+
+		/* #region 比较 */
+
+		bool operator==(base::StringView const &o) const
+		{
+			return StdStringView() == o.StdStringView();
+		}
+
+		bool operator<(base::StringView const &o) const
+		{
+			return StdStringView() < o.StdStringView();
+		}
+
+		bool operator>(base::StringView const &o) const
+		{
+			return StdStringView() > o.StdStringView();
+		}
+
+		bool operator<=(base::StringView const &o) const
+		{
+			return StdStringView() <= o.StdStringView();
+		}
+
+		bool operator>=(base::StringView const &o) const
+		{
+			return StdStringView() >= o.StdStringView();
+		}
+
+		/* #endregion */
+
+		/* #region 裁剪 */
+
+		///
+		/// @brief 去掉开头的空白字符后的视图。
+		///
+		/// @note 关于哪些是空白字符，见 is_white_char 函数。
+		///
+		/// @return
+		///
+		base::StringView TrimStart() const
+		{
+			int64_t begin = 0;
+			while (begin < _length && base::character::is_white_char(_buffer[begin]))
+			{
+				begin++;
+			}
+
+			return base::StringView{_buffer + begin, _length - begin};
+		}
+
+		///
+		/// @brief 去掉末尾的空白字符后的视图。
+		///
+		/// @return
+		///
+		base::StringView TrimEnd() const
+		{
+			int64_t end = _length;
+			while (end > 0 && base::character::is_white_char(_buffer[end - 1]))
+			{
+				end--;
+			}
+
+			return base::StringView{_buffer, end};
+		}
+
+		///
+		/// @brief 去掉开头和末尾的空白字符后的视图。
+		///
+		/// @return
+		///
+		base::StringView Trim() const
+		{
+			return TrimStart().TrimEnd();
+		}
+
+		/* #endregion */
+
+		/* #region IndexOf */
+
+		///
+		/// @brief 查找匹配项所在的索引。
+		///
+		/// @param match
+		/// @return 找到了返回匹配位置的索引。没找到返回 -1.
+		///
+		int64_t IndexOf(char match) const
+		{
+			return IndexOf(0, match);
+		}
+
+		///
+		/// @brief 从 start 开始往后查找匹配项所在的索引。
+		///
+		/// @param start
+		/// @param match
+		/// @return 找到了返回匹配位置的索引。没找到返回 -1.
+		///
+		int64_t IndexOf(int64_t start, char match) const;
+
+		///
+		/// @brief 查找子字符串所在的索引。
+		///
+		/// @param match
+		/// @return 找到了返回匹配位置的索引。没找到返回 -1. match 为空时返回 0.
+		///
+		int64_t IndexOf(base::StringView const &match) const
+		{
+			return IndexOf(0, match);
+		}
+
+		///
+		/// @brief 从 start 开始往后查找子字符串所在的索引。
+		///
+		/// @note 用向量化的单字符查找定位 match 的首字符，再比较其余部分。
+		///
+		/// @param start
+		/// @param match
+		/// @return 找到了返回匹配位置的索引。没找到返回 -1.
+		///
+		int64_t IndexOf(int64_t start, base::StringView const &match) const;
+
+		///
+		/// @brief 查找 chars 中任意一个字符第一次出现的索引。
+		///
+		/// @param chars 要查找的字符集合。
+		/// @return 找到了返回匹配位置的索引。没找到返回 -1.
+		///
+		int64_t IndexOfAny(base::StringView const &chars) const
+		{
+			return IndexOfAny(0, chars);
+		}
+
+		///
+		/// @brief 从 start 开始往后查找 chars 中任意一个字符第一次出现的索引。
+		///
+		/// @note chars 不超过 16 个字符时，每 16 个字节与每个字符比较一次后合并结果。
+		///
+		/// @param start
+		/// @param chars 要查找的字符集合。
+		/// @return 找到了返回匹配位置的索引。没找到返回 -1.
+		///
+		int64_t IndexOfAny(int64_t start, base::StringView const &chars) const;
+
+		///
+		/// @brief 从后往前查找最后一个匹配项所在的索引。
+		///
+		/// @param match
+		/// @return 找到了返回匹配位置的索引。没找到返回 -1.
+		///
+		int64_t LastIndexOf(char match) const
+		{
+			for (int64_t i = _length - 1; i >= 0; i--)
+			{
+				if (_buffer[i] == match)
+				{
+					return i;
+				}
+			}
+
+			return -1;
+		}
+
+		/* #endregion */
+
+		bool Contains(char match) const
+		{
+			return IndexOf(match) >= 0;
+		}
+
+		bool Contains(base::StringView const &match) const
+		{
+			return IndexOf(match) >= 0;
+		}
+
+		bool StartWith(char match) const
+		{
+			return _length > 0 && _buffer[0] == match;
+		}
+
+		bool StartWith(base::StringView const &match) const
+		{
+			return match._length <= _length &&
+				   std::memcmp(_buffer, match._buffer, static_cast<size_t>(match._length)) == 0;
+		}
+
+		bool EndWith(char match) const
+		{
+			return _length > 0 && _buffer[_length - 1] == match;
+		}
+
+		bool EndWith(base::StringView const &match) const
+		{
+			return match._length <= _length &&
+				   std::memcmp(_buffer + _length - match._length, match._buffer, static_cast<size_t>(match._length)) == 0;
+		}
+
+		/* #region 拆分 */
+
+		///
+		/// @brief 按分隔符惰性拆分。每次 MoveToNext 才查找下一个分隔符，子字符串是本视图的子视图。
+		///
+		/// @param separator
+		/// @param options
+		/// @return
+		///
+		base::StringSplitEnumerator Split(char separator,
+										  base::StringSplitOptions const &options = base::StringSplitOptions{}) const;
+
+		///
+		/// @brief 把 delimiters 中的任意字符都作为分隔符，惰性拆分出非空的子字符串。
+		///
+		/// @param delimiters
+		/// @return
+		///
+		base::StringSplitEnumerator Tokenize(base::StringView const &delimiters) const;
+
+		/* #endregion */
+
+		/* #region 迭代器 */
+
+		char const *begin() const
+		{
+			return _buffer;
+		}
+
+		char const *end() const
+		{
+			return _buffer + _length;
+		}
+
+		/* #endregion */
+	};
+
+	///
+	/// @brief 惰性拆分字符串的迭代器。由 base::StringView 的 Split 和 Tokenize 方法构造。
+	///
+	/// @note 当前值是原字符串的子视图，迭代过程中不分配内存。
+	///
+	class StringSplitEnumerator final :
+		public base::IEnumerator<base::StringView>
+	{
+	private:
+		base::IEnumerator<base::StringView>::Context_t _context{};
+		base::StringView _remain;
+		base::StringSplitOptions _options;
+		base::StringView _current;
+
+		// 自己保存分隔符，迭代器被复制后也不会引用失效的内存。分隔符只有几个时，短字符串优化不分配内存。
+		std::string _separators;
+
+		// 剩余部分已经没有分隔符了，_remain 是最后一段。
+		bool _is_last_segment = false;
+		bool _is_end = false;
+
+		///
+		/// @brief 取出下一段，不考虑选项。
+		///
+		/// @return 没有下一段了返回 false.
+		///
+		bool NextSegment()
+		{
+			if (_is_last_segment)
+			{
+				return false;
+			}
+
+			int64_t index = -1;
+			if (_separators.size() == 1 && _remain._length > 0)
+			{
+				// 单个分隔符是最常见的情况，直接 memchr, 省去一次函数调用。
+				// 空视图的指针可能是空指针，不能传给 memchr.
+				void const *found = std::memchr(_remain._buffer, _separators[0], static_cast<size_t>(_remain._length));
+				index = found == nullptr ? -1 : static_cast<char const *>(found) - _remain._buffer;
+			}
+			else
+			{
+				index = _remain.IndexOfAny(base::StringView{_separators});
+			}
+
+			if (index < 0)
+			{
+				_current = _remain;
+				_is_last_segment = true;
+				return true;
+			}
+
+			// index 一定在范围内，直接改字段，不经过检查参数的构造函数。
+			_current._buffer = _remain._buffer;
+			_current._length = index;
+			_remain._buffer += index + 1;
+			_remain._length -= index + 1;
+			return true;
+		}
+
+		///
+		/// @brief 按选项取出下一个子字符串。找不到时让迭代器结束。
+		///
+		void MoveToNextValid()
+		{
+			while (NextSegment())
+			{
+				if (_options.trim_each_substring)
+				{
+					_current = _current.Trim();
+				}
+
+				if (_options.remove_empty_substring && _current.Length() == 0)
+				{
+					continue;
+				}
+
+				return;
+			}
+
+			_is_end = true;
+		}
+
+	public:
+		///
+		/// @brief 构造。
+		///
+		/// @param str 要拆分的字符串。
+		/// @param separators 分隔符集合，其中任意一个字符都是分隔符。
+		/// @param options
+		///
+		StringSplitEnumerator(base::StringView const &str,
+							  base::StringView const &separators,
+							  base::StringSplitOptions const &options)
+			: _remain(str),
+			  _options(options),
+			  _separators(separators.Buffer(), static_cast<size_t>(separators.Length()))
+		{
+			MoveToNextValid();
+		}
+
+		///
+		/// @brief 迭代器当前是否指向尾后元素。
+		///
+		/// @return
+		///
+		virtual bool IsEnd() const override
+		{
+			return _is_end;
+		}
+
+		///
+		/// @brief 当前子字符串。
+		///
+		/// @return
+		///
+		virtual base::StringView &CurrentValue() override
+		{
+			return _current;
+		}
+
+		///
+		/// @brief 前往下一个子字符串。
+		///
+		virtual void Add() override
+		{
+			MoveToNextValid();
+		}
+
+		virtual base::IEnumerator<base::StringView>::Context_t &Context() override
+		{
+			return _context;
+		}
+	};
+
+} // namespace base
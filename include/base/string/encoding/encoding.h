@@ -15,7 +15,8 @@ namespace base::string::encoding
 	/// UTF16-LE 字节序列。
 	///
 	/// @note 如果本机是大端序，需要转换，则直接颠倒每个字符的字节序，
-	/// 让缓冲区中的数据变成 UTF16-LE 字节序列。
+	/// 让缓冲区中的数据变成 UTF16-LE 字节序列。用移位交换两个字节，
+	/// 循环体没有函数调用，编译器可以向量化。
 	///
 	/// @warning 如果发生了转换，经过处理后的 str 中的字符的值将不再正确，只能够
 	/// 读取其中的缓冲区进行发送，不能够进行字符处理。
@@ -30,10 +31,10 @@ namespace base::string::encoding
 		}
 
 		// 本机不是小端序，需要转换。
+		char16_t *buffer = str.data();
 		for (size_t i = 0; i < str.size(); i++)
 		{
-			std::reverse(reinterpret_cast<uint8_t *>(&str[i]),
-						 reinterpret_cast<uint8_t *>(&str[i]) + sizeof(char16_t));
+			buffer[i] = static_cast<char16_t>((buffer[i] >> 8) | (buffer[i] << 8));
 		}
 	}
 
@@ -45,12 +46,14 @@ namespace base::string::encoding
 	///
 	inline std::u16string convert_ascii_string_to_utf16_string(base::ReadOnlySpan const &span)
 	{
-		std::u16string ret;
-		ret.reserve(span.Size());
+		std::u16string ret(span.Size(), u'\0');
 
+		// 直接写缓冲区，不经过带越界检查的 operator[] 和 push_back.
+		uint8_t const *input = span.Buffer();
+		char16_t *output = ret.data();
 		for (int64_t i = 0; i < span.Size(); i++)
 		{
-			ret.push_back(static_cast<char16_t>(span[i]));
+			output[i] = static_cast<char16_t>(input[i]);
 		}
 
 		return ret;
@@ -0,0 +1,584 @@
+#include "hex.h" // IWYU pragma: keep
+#include "base/string/define.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__)
+	#if (defined(__GNUC__) || defined(__clang__)) && !defined(_MSC_VER)
+		#define BASE_HEX_SIMD 1
+		#include <immintrin.h>
+	#else
+		#define BASE_HEX_SIMD 0
+	#endif
+#else
+	#define BASE_HEX_SIMD 0
+#endif
+
+namespace
+{
+	constexpr char _lowercase_digits[] = "0123456789abcdef";
+	constexpr char _uppercase_digits[] = "0123456789ABCDEF";
+
+	///
+	/// @brief 每个字节值对应的 2 个字符。
+	///
+	struct HexPairTable
+	{
+		std::array<char, 512> _chars{};
+
+		constexpr HexPairTable(char const *digits)
+		{
+			for (int i = 0; i < 256; i++)
+			{
+				_chars[2 * i] = digits[i >> 4];
+				_chars[2 * i + 1] = digits[i & 0xf];
+			}
+		}
+	};
+
+	constexpr HexPairTable _lowercase_pairs{_lowercase_digits};
+	constexpr HexPairTable _uppercase_pairs{_uppercase_digits};
+
+	///
+	/// @brief 每个字符对应的值。非 16 进制字符是 -1.
+	///
+	constexpr std::array<int8_t, 256> _hex_values = []()
+	{
+		std::array<int8_t, 256> values{};
+		for (int i = 0; i < 256; i++)
+		{
+			values[i] = -1;
+		}
+
+		for (int i = 0; i < 10; i++)
+		{
+			values['0' + i] = static_cast<int8_t>(i);
+		}
+
+		for (int i = 0; i < 6; i++)
+		{
+			values['a' + i] = static_cast<int8_t>(10 + i);
+			values['A' + i] = static_cast<int8_t>(10 + i);
+		}
+
+		return values;
+	}();
+
+	/* #region 编码 */
+
+	///
+	/// @brief 编码一段连续的字节，相邻字节之间插入分隔符，最后一个字节后面没有分隔符。
+	///
+	/// @param input
+	/// @param count
+	/// @param output
+	/// @param uppercase
+	/// @param separator 为 '\0' 时没有分隔符。
+	/// @return 写入的字符数。
+	///
+	using EncodeRunFunction = int64_t (*)(uint8_t const *input,
+										  int64_t count,
+										  char *output,
+										  bool uppercase,
+										  char separator);
+
+	int64_t EncodeRunScalar(uint8_t const *input, int64_t count, char *output, bool uppercase, char separator)
+	{
+		char const *pairs = uppercase ? _uppercase_pairs._chars.data() : _lowercase_pairs._chars.data();
+		char *p = output;
+		if (separator == '\0')
+		{
+			for (int64_t i = 0; i < count; i++)
+			{
+				p[0] = pairs[2 * input[i]];
+				p[1] = pairs[2 * input[i] + 1];
+				p += 2;
+			}
+
+			return p - output;
+		}
+
+		for (int64_t i = 0; i < count; i++)
+		{
+			if (i > 0)
+			{
+				*p++ = separator;
+			}
+
+			p[0] = pairs[2 * input[i]];
+			p[1] = pairs[2 * input[i] + 1];
+			p += 2;
+		}
+
+		return p - output;
+	}
+
+#if BASE_HEX_SIMD
+	///
+	/// @brief 带分隔符编码 16 个字节时，48 个输出字符各取自高半字节字符、低半字节字符还是分隔符。
+	///
+	/// @note 第 j 个输出字符属于第 j / 3 个字节，j % 3 为 0, 1, 2 时分别是高半字节字符、
+	/// 低半字节字符、分隔符。pshufb 的索引最高位为 1 时输出 0.
+	///
+	struct SeparatedShuffleTable
+	{
+		alignas(16) std::array<uint8_t, 48> _high{};
+		alignas(16) std::array<uint8_t, 48> _low{};
+		alignas(16) std::array<uint8_t, 48> _separator{};
+
+		constexpr SeparatedShuffleTable()
+		{
+			for (int j = 0; j < 48; j++)
+			{
+				uint8_t byte_index = static_cast<uint8_t>(j / 3);
+				_high[j] = j % 3 == 0 ? byte_index : 0x80;
+				_low[j] = j % 3 == 1 ? byte_index : 0x80;
+				_separator[j] = j % 3 == 2 ? 0xff : 0;
+			}
+		}
+	};
+
+	constexpr SeparatedShuffleTable _separated_shuffle_table{};
+
+	__attribute__((target("ssse3"))) int64_t EncodeRunSsse3(uint8_t const *input,
+															int64_t count,
+															char *output,
+															bool uppercase,
+															char separator)
+	{
+		__m128i digits = _mm_loadu_si128(reinterpret_cast<__m128i const *>(uppercase ? _uppercase_digits : _lowercase_digits));
+		__m128i nibble_mask = _mm_set1_epi8(0x0f);
+		char *p = output;
+		int64_t i = 0;
+
+		if (separator == '\0')
+		{
+			for (; i + 16 <= count; i += 16)
+			{
+				__m128i bytes = _mm_loadu_si128(reinterpret_cast<__m128i const *>(input + i));
+				__m128i high = _mm_shuffle_epi8(digits, _mm_and_si128(_mm_srli_epi16(bytes, 4), nibble_mask));
+				__m128i low = _mm_shuffle_epi8(digits, _mm_and_si128(bytes, nibble_mask));
+				_mm_storeu_si128(reinterpret_cast<__m128i *>(p), _mm_unpacklo_epi8(high, low));
+				_mm_storeu_si128(reinterpret_cast<__m128i *>(p + 16), _mm_unpackhi_epi8(high, low));
+				p += 32;
+			}
+		}
+		else
+		{
+			__m128i separators = _mm_set1_epi8(separator);
+
+			for (; i + 16 <= count; i += 16)
+			{
+				__m128i bytes = _mm_loadu_si128(reinterpret_cast<__m128i const *>(input + i));
+				__m128i high = _mm_shuffle_epi8(digits, _mm_and_si128(_mm_srli_epi16(bytes, 4), nibble_mask));
+				__m128i low = _mm_shuffle_epi8(digits, _mm_and_si128(bytes, nibble_mask));
+
+				__m128i chars[3];
+				for (int k = 0; k < 3; k++)
+				{
+					__m128i high_index = _mm_load_si128(reinterpret_cast<__m128i const *>(_separated_shuffle_table._high.data() + 16 * k));
+					__m128i low_index = _mm_load_si128(reinterpret_cast<__m128i const *>(_separated_shuffle_table._low.data() + 16 * k));
+					__m128i separator_mask = _mm_load_si128(reinterpret_cast<__m128i const *>(_separated_shuffle_table._separator.data() + 16 * k));
+
+					chars[k] = _mm_or_si128(_mm_shuffle_epi8(high, high_index), _mm_shuffle_epi8(low, low_index));
+					chars[k] = _mm_or_si128(chars[k], _mm_and_si128(separators, separator_mask));
+				}
+
+				_mm_storeu_si128(reinterpret_cast<__m128i *>(p), chars[0]);
+				_mm_storeu_si128(reinterpret_cast<__m128i *>(p + 16), chars[1]);
+				if (i + 16 < count)
+				{
+					_mm_storeu_si128(reinterpret_cast<__m128i *>(p + 32), chars[2]);
+					p += 48;
+					continue;
+				}
+
+				// 最后一个字节后面没有分隔符，只写 47 个字符，不能越过输出缓冲区。
+				alignas(16) char last_chars[16];
+				_mm_store_si128(reinterpret_cast<__m128i *>(last_chars), chars[2]);
+				std::memcpy(p + 32, last_chars, 15);
+				p += 47;
+			}
+		}
+
+		return (p - output) + EncodeRunScalar(input + i, count - i, p, uppercase, separator);
+	}
+
+	__attribute__((target("avx2"))) int64_t EncodeRunAvx2(uint8_t const *input,
+														  int64_t count,
+														  char *output,
+														  bool uppercase,
+														  char separator)
+	{
+		if (separator != '\0')
+		{
+			return EncodeRunSsse3(input, count, output, uppercase, separator);
+		}
+
+		__m256i digits = _mm256_broadcastsi128_si256(
+			_mm_loadu_si128(reinterpret_cast<__m128i const *>(uppercase ? _uppercase_digits : _lowercase_digits)));
+
+		__m256i nibble_mask = _mm256_set1_epi8(0x0f);
+		char *p = output;
+		int64_t i = 0;
+		for (; i + 32 <= count; i += 32)
+		{
+			__m256i bytes = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(input + i));
+			__m256i high = _mm256_shuffle_epi8(digits, _mm256_and_si256(_mm256_srli_epi16(bytes, 4), nibble_mask));
+			__m256i low = _mm256_shuffle_epi8(digits, _mm256_and_si256(bytes, nibble_mask));
+
+			// unpack 在每个 128 位通道内进行，需要重新排列通道。
+			__m256i first = _mm256_unpacklo_epi8(high, low);
+			__m256i second = _mm256_unpackhi_epi8(high, low);
+			_mm256_storeu_si256(reinterpret_cast<__m256i *>(p), _mm256_permute2x128_si256(first, second, 0x20));
+			_mm256_storeu_si256(reinterpret_cast<__m256i *>(p + 32), _mm256_permute2x128_si256(first, second, 0x31));
+			p += 64;
+		}
+
+		return (p - output) + EncodeRunSsse3(input + i, count - i, p, uppercase, separator);
+	}
+#endif // BASE_HEX_SIMD
+
+	///
+	/// @brief 按 options.bytes_per_line 分行编码，行与行之间插入换行符。
+	///
+	/// @note 以模板参数的形式传入 Run, 每行直接调用，不经过函数指针。
+	///
+	template <EncodeRunFunction Run>
+	int64_t EncodeLines(uint8_t const *input,
+						int64_t count,
+						char *output,
+						base::string::encoding::hex_encode_options const &options)
+	{
+		int64_t line_size = options.bytes_per_line > 0 ? options.bytes_per_line : count;
+		int64_t written = 0;
+		for (int64_t i = 0; i < count; i += line_size)
+		{
+			if (i > 0)
+			{
+				output[written++] = '\n';
+			}
+
+			written += Run(input + i, std::min(line_size, count - i), output + written, options.uppercase, options.separator);
+		}
+
+		return written;
+	}
+
+	using EncodeFunction = int64_t (*)(uint8_t const *input,
+									   int64_t count,
+									   char *output,
+									   base::string::encoding::hex_encode_options const &options);
+
+	///
+	/// @brief 按 CPU 支持的指令集选择实现。只选择一次。
+	///
+	/// @return
+	///
+	EncodeFunction SelectEncode()
+	{
+#if BASE_HEX_SIMD
+		if (__builtin_cpu_supports("avx2"))
+		{
+			return EncodeLines<EncodeRunAvx2>;
+		}
+
+		if (__builtin_cpu_supports("ssse3"))
+		{
+			return EncodeLines<EncodeRunSsse3>;
+		}
+#endif
+
+		return EncodeLines<EncodeRunScalar>;
+	}
+
+	int64_t Encode(uint8_t const *input,
+				   int64_t count,
+				   char *output,
+				   base::string::encoding::hex_encode_options const &options)
+	{
+		static EncodeFunction const function = SelectEncode();
+		return function(input, count, output, options);
+	}
+
+	/* #endregion */
+
+	/* #region 解码 */
+
+	///
+	/// @brief 解码成对的 16 进制字符。
+	///
+	/// @param input
+	/// @param pair_count 字符对的个数。
+	/// @param output
+	/// @return 成功解码的字节数。遇到非法字符时停在该字符所在的字符对。
+	///
+	using DecodePairsFunction = int64_t (*)(uint8_t const *input, int64_t pair_count, uint8_t *output);
+
+	int64_t DecodePairsScalar(uint8_t const *input, int64_t pair_count, uint8_t *output)
+	{
+		for (int64_t i = 0; i < pair_count; i++)
+		{
+			int8_t high = _hex_values[input[2 * i]];
+			int8_t low = _hex_values[input[2 * i + 1]];
+			if ((high | low) < 0)
+			{
+				return i;
+			}
+
+			output[i] = static_cast<uint8_t>((high << 4) | low);
+		}
+
+		return pair_count;
+	}
+
+#if BASE_HEX_SIMD
+	///
+	/// @brief 把 16 个字符转换为半字节的值。
+	///
+	/// @param chars
+	/// @param valid 接收合法性。每个字符对应 1 位。
+	/// @return
+	///
+	__attribute__((target("ssse3"))) inline __m128i HexValuesSsse3(__m128i chars, int &valid)
+	{
+		// 有符号比较。>= 0x80 的字节是负数，不会落在任何范围内。
+		__m128i is_digit = _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('0' - 1)),
+										 _mm_cmplt_epi8(chars, _mm_set1_epi8('9' + 1)));
+
+		__m128i lower = _mm_or_si128(chars, _mm_set1_epi8(0x20));
+		__m128i is_letter = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)),
+										  _mm_cmplt_epi8(lower, _mm_set1_epi8('f' + 1)));
+
+		__m128i digit_value = _mm_and_si128(is_digit, _mm_sub_epi8(chars, _mm_set1_epi8('0')));
+		__m128i letter_value = _mm_and_si128(is_letter, _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10)));
+		valid = _mm_movemask_epi8(_mm_or_si128(is_digit, is_letter));
+		return _mm_or_si128(digit_value, letter_value);
+	}
+
+	__attribute__((target("ssse3"))) int64_t DecodePairsSsse3(uint8_t const *input, int64_t pair_count, uint8_t *output)
+	{
+		// 相邻 2 个半字节合并为 1 个字节：高半字节乘 16 加低半字节。
+		__m128i weights = _mm_set1_epi16(0x0110);
+
+		int64_t i = 0;
+		for (; i + 16 <= pair_count; i += 16)
+		{
+			int valid0 = 0;
+			int valid1 = 0;
+			__m128i values0 = HexValuesSsse3(_mm_loadu_si128(reinterpret_cast<__m128i const *>(input + 2 * i)), valid0);
+			__m128i values1 = HexValuesSsse3(_mm_loadu_si128(reinterpret_cast<__m128i const *>(input + 2 * i + 16)), valid1);
+			if ((valid0 & valid1) != 0xffff)
+			{
+				break;
+			}
+
+			__m128i bytes = _mm_packus_epi16(_mm_maddubs_epi16(values0, weights), _mm_maddubs_epi16(values1, weights));
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(output + i), bytes);
+		}
+
+		return i + DecodePairsScalar(input + 2 * i, pair_count - i, output + i);
+	}
+
+	__attribute__((target("avx2"))) inline __m256i HexValuesAvx2(__m256i chars, uint32_t &valid)
+	{
+		__m256i is_digit = _mm256_and_si256(_mm256_cmpgt_epi8(chars, _mm256_set1_epi8('0' - 1)),
+											_mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), chars));
+
+		__m256i lower = _mm256_or_si256(chars, _mm256_set1_epi8(0x20));
+		__m256i is_letter = _mm256_and_si256(_mm256_cmpgt_epi8(lower, _mm256_set1_epi8('a' - 1)),
+											 _mm256_cmpgt_epi8(_mm256_set1_epi8('f' + 1), lower));
+
+		__m256i digit_value = _mm256_and_si256(is_digit, _mm256_sub_epi8(chars, _mm256_set1_epi8('0')));
+		__m256i letter_value = _mm256_and_si256(is_letter, _mm256_sub_epi8(lower, _mm256_set1_epi8('a' - 10)));
+		valid = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_or_si256(is_digit, is_letter)));
+		return _mm256_or_si256(digit_value, letter_value);
+	}
+
+	__attribute__((target("avx2"))) int64_t DecodePairsAvx2(uint8_t const *input, int64_t pair_count, uint8_t *output)
+	{
+		__m256i weights = _mm256_set1_epi16(0x0110);
+
+		int64_t i = 0;
+		for (; i + 32 <= pair_count; i += 32)
+		{
+			uint32_t valid0 = 0;
+			uint32_t valid1 = 0;
+			__m256i values0 = HexValuesAvx2(_mm256_loadu_si256(reinterpret_cast<__m256i const *>(input + 2 * i)), valid0);
+			__m256i values1 = HexValuesAvx2(_mm256_loadu_si256(reinterpret_cast<__m256i const *>(input + 2 * i + 32)), valid1);
+			if ((valid0 & valid1) != 0xffffffff)
+			{
+				break;
+			}
+
+			// packus 在每个 128 位通道内进行，结果的 64 位块顺序是 0, 2, 1, 3.
+			__m256i bytes = _mm256_packus_epi16(_mm256_maddubs_epi16(values0, weights),
+												_mm256_maddubs_epi16(values1, weights));
+
+			bytes = _mm256_permute4x64_epi64(bytes, 0xd8);
+			_mm256_storeu_si256(reinterpret_cast<__m256i *>(output + i), bytes);
+		}
+
+		return i + DecodePairsSsse3(input + 2 * i, pair_count - i, output + i);
+	}
+#endif // BASE_HEX_SIMD
+
+	DecodePairsFunction SelectDecodePairs()
+	{
+#if BASE_HEX_SIMD
+		if (__builtin_cpu_supports("avx2"))
+		{
+			return DecodePairsAvx2;
+		}
+
+		if (__builtin_cpu_supports("ssse3"))
+		{
+			return DecodePairsSsse3;
+		}
+#endif
+
+		return DecodePairsScalar;
+	}
+
+	int64_t DecodePairs(uint8_t const *input, int64_t pair_count, uint8_t *output)
+	{
+		static DecodePairsFunction const function = SelectDecodePairs();
+		return function(input, pair_count, output);
+	}
+
+	[[noreturn]] void ThrowInvalidCharacter(int64_t position)
+	{
+		throw std::invalid_argument{CODE_POS_STR + "第 " + std::to_string(position) + " 个字符不是合法的 16 进制字符。"};
+	}
+
+	/* #endregion */
+
+} // namespace
+
+int64_t base::string::encoding::hex_encoded_size(int64_t byte_count,
+												 base::string::encoding::hex_encode_options const &options)
+{
+	if (byte_count <= 0)
+	{
+		return 0;
+	}
+
+	int64_t line_break_count = 0;
+	if (options.bytes_per_line > 0)
+	{
+		line_break_count = (byte_count - 1) / options.bytes_per_line;
+	}
+
+	// 除了换行的位置，相邻字节之间都有分隔符。
+	int64_t separator_count = 0;
+	if (options.separator != '\0')
+	{
+		separator_count = byte_count - 1 - line_break_count;
+	}
+
+	return 2 * byte_count + separator_count + line_break_count;
+}
+
+int64_t base::string::encoding::hex_encode(base::ReadOnlySpan const &input,
+										   base::Span const &output,
+										   base::string::encoding::hex_encode_options const &options)
+{
+	int64_t size = base::string::encoding::hex_encoded_size(input.Size(), options);
+	if (output.Size() < size)
+	{
+		throw std::invalid_argument{CODE_POS_STR + "output 的大小不足。"};
+	}
+
+	return Encode(input.Buffer(), input.Size(), reinterpret_cast<char *>(output.Buffer()), options);
+}
+
+std::string base::string::encoding::hex_encode(base::ReadOnlySpan const &input,
+											   base::string::encoding::hex_encode_options const &options)
+{
+	std::string ret;
+	ret.resize(base::string::encoding::hex_encoded_size(input.Size(), options));
+	base::string::encoding::hex_encode(input,
+									   base::Span{reinterpret_cast<uint8_t *>(ret.data()), static_cast<int64_t>(ret.size())},
+									   options);
+
+	return ret;
+}
+
+int64_t base::string::encoding::hex_decode(base::ReadOnlySpan const &input,
+										   base::Span const &output,
+										   char separator)
+{
+	uint8_t const *in = input.Buffer();
+	uint8_t *out = output.Buffer();
+
+	if (separator == '\0')
+	{
+		if (input.Size() % 2 != 0)
+		{
+			throw std::invalid_argument{CODE_POS_STR + "16 进制字符的个数必须是偶数。"};
+		}
+
+		int64_t pair_count = input.Size() / 2;
+		if (output.Size() < pair_count)
+		{
+			throw std::invalid_argument{CODE_POS_STR + "output 的大小不足。"};
+		}
+
+		int64_t decoded = DecodePairs(in, pair_count, out);
+		if (decoded != pair_count)
+		{
+			int64_t position = 2 * decoded;
+			if (_hex_values[in[position]] >= 0)
+			{
+				position++;
+			}
+
+			ThrowInvalidCharacter(position);
+		}
+
+		return decoded;
+	}
+
+	int64_t written = 0;
+	int64_t i = 0;
+	while (i < input.Size())
+	{
+		uint8_t c = in[i];
+		if (c == static_cast<uint8_t>(separator) || c == '\r' || c == '\n')
+		{
+			i++;
+			continue;
+		}
+
+		// 找出连续的 16 进制字符，成块解码。
+		int64_t run_end = i;
+		while (run_end < input.Size() && _hex_values[in[run_end]] >= 0)
+		{
+			run_end++;
+		}
+
+		int64_t run_size = run_end - i;
+		if (run_size == 0)
+		{
+			ThrowInvalidCharacter(i);
+		}
+
+		if (run_size % 2 != 0)
+		{
+			throw std::invalid_argument{CODE_POS_STR + "第 " + std::to_string(run_end - 1) + " 个字符没有成对。"};
+		}
+
+		if (output.Size() - written < run_size / 2)
+		{
+			throw std::invalid_argument{CODE_POS_STR + "output 的大小不足。"};
+		}
+
+		written += DecodePairs(in + i, run_size / 2, out + written);
+		i = run_end;
+	}
+
+	return written;
+}
@@ -0,0 +1,90 @@
+#pragma once
+#include "base/stream/ReadOnlySpan.h"
+#include "base/stream/Span.h"
+#include <cstdint>
+#include <string>
+
+namespace base::string::encoding
+{
+	///
+	/// @brief hex_encode 函数的选项。
+	///
+	struct hex_encode_options
+	{
+		///
+		/// @brief 是否使用大写字母。
+		///
+		/// @note 默认值：false.
+		///
+		bool uppercase = false;
+
+		///
+		/// @brief 同一行内相邻字节之间的分隔符。为 '\0' 时没有分隔符。
+		///
+		/// @note 默认值：'\0'.
+		///
+		char separator = '\0';
+
+		///
+		/// @brief 每行的字节数。行与行之间用 '\n' 分隔，行尾没有分隔符。<= 0 时不换行。
+		///
+		/// @note 默认值：0.
+		///
+		int64_t bytes_per_line = 0;
+	};
+
+	///
+	/// @brief 把 byte_count 个字节编码为 16 进制后的字符数。
+	///
+	/// @param byte_count
+	/// @param options
+	/// @return
+	///
+	int64_t hex_encoded_size(int64_t byte_count, base::string::encoding::hex_encode_options const &options = {});
+
+	///
+	/// @brief 把每个字节编码为 2 个 16 进制字符，写入调用者提供的缓冲区。
+	///
+	/// @note 查表的标量路径每次转换 1 个字节。x86 上没有分隔符时用 SSSE3 或 AVX2
+	/// 一次转换 16 或 32 个字节，有分隔符时用 SSSE3 一次转换 16 个字节并插入分隔符。
+	///
+	/// @param input
+	/// @param output 大小不能 < hex_encoded_size(input.Size(), options).
+	/// @param options
+	/// @return 写入的字符数。
+	///
+	int64_t hex_encode(base::ReadOnlySpan const &input,
+					   base::Span const &output,
+					   base::string::encoding::hex_encode_options const &options = {});
+
+	///
+	/// @brief 把每个字节编码为 2 个 16 进制字符。
+	///
+	/// @note 只为结果分配一次内存。
+	///
+	/// @param input
+	/// @param options
+	/// @return
+	///
+	std::string hex_encode(base::ReadOnlySpan const &input,
+						   base::string::encoding::hex_encode_options const &options = {});
+
+	///
+	/// @brief 把 16 进制字符解码为字节，写入调用者提供的缓冲区。
+	///
+	/// @note 大写和小写字母都接受。没有分隔符时 x86 上用 SSSE3 或 AVX2
+	/// 一次转换 32 或 64 个字符。
+	///
+	/// @param input 16 进制字符。
+	/// @param output 大小 >= input.Size() / 2 时一定能容纳全部结果。
+	/// @param separator 为 '\0' 时 input 只能包含 16 进制字符。否则每 2 个 16 进制字符
+	/// 之间可以有任意个 separator, '\r', '\n', 每个字节的 2 个字符不能被隔开。
+	/// @return 写入的字节数。
+	///
+	/// @exception std::invalid_argument 有非法字符，字符不成对，或者 output 容纳不下。
+	///
+	int64_t hex_decode(base::ReadOnlySpan const &input,
+					   base::Span const &output,
+					   char separator = '\0');
+
+} // namespace base::string::encoding
@@ -0,0 +1,696 @@
+#include "utf8.h" // IWYU pragma: keep
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__)
+	#define BASE_UTF8_SSE2 1
+	#include <emmintrin.h>
+
+	#if (defined(__GNUC__) || defined(__clang__)) && !defined(_MSC_VER)
+		#define BASE_UTF8_AVX2 1
+		#include <immintrin.h>
+	#else
+		#define BASE_UTF8_AVX2 0
+	#endif
+#else
+	#define BASE_UTF8_SSE2 0
+	#define BASE_UTF8_AVX2 0
+#endif
+
+namespace
+{
+	constexpr char32_t _replacement_character = 0xfffd;
+
+	/* #region ASCII 前缀 */
+
+	///
+	/// @brief 一次检查 8 个字节的最高位。
+	///
+	/// @param buffer
+	/// @param size
+	/// @return
+	///
+	int64_t AsciiPrefixLengthScalar(uint8_t const *buffer, int64_t size)
+	{
+		int64_t i = 0;
+		for (; i + 8 <= size; i += 8)
+		{
+			uint64_t word;
+			std::memcpy(&word, buffer + i, sizeof(word));
+			uint64_t high_bits = word & 0x8080808080808080ULL;
+			if (high_bits != 0)
+			{
+				if constexpr (std::endian::native == std::endian::little)
+				{
+					return i + std::countr_zero(high_bits) / 8;
+				}
+				else
+				{
+					return i + std::countl_zero(high_bits) / 8;
+				}
+			}
+		}
+
+		while (i < size && buffer[i] < 0x80)
+		{
+			i++;
+		}
+
+		return i;
+	}
+
+#if BASE_UTF8_SSE2
+	int64_t AsciiPrefixLengthSse2(uint8_t const *buffer, int64_t size)
+	{
+		int64_t i = 0;
+		for (; i + 16 <= size; i += 16)
+		{
+			__m128i chunk = _mm_loadu_si128(reinterpret_cast<__m128i const *>(buffer + i));
+			int mask = _mm_movemask_epi8(chunk);
+			if (mask != 0)
+			{
+				return i + std::countr_zero(static_cast<uint32_t>(mask));
+			}
+		}
+
+		return i + AsciiPrefixLengthScalar(buffer + i, size - i);
+	}
+#endif // BASE_UTF8_SSE2
+
+#if BASE_UTF8_AVX2
+	__attribute__((target("avx2"))) int64_t AsciiPrefixLengthAvx2(uint8_t const *buffer, int64_t size)
+	{
+		int64_t i = 0;
+		for (; i + 64 <= size; i += 64)
+		{
+			// 两个 32 字节合并后再检查，减少分支。
+			__m256i chunk0 = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(buffer + i));
+			__m256i chunk1 = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(buffer + i + 32));
+			if (_mm256_movemask_epi8(_mm256_or_si256(chunk0, chunk1)) != 0)
+			{
+				break;
+			}
+		}
+
+		for (; i + 32 <= size; i += 32)
+		{
+			__m256i chunk = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(buffer + i));
+			int mask = _mm256_movemask_epi8(chunk);
+			if (mask != 0)
+			{
+				return i + std::countr_zero(static_cast<uint32_t>(mask));
+			}
+		}
+
+		return i + AsciiPrefixLengthSse2(buffer + i, size - i);
+	}
+#endif // BASE_UTF8_AVX2
+
+	using AsciiPrefixLengthFunction = int64_t (*)(uint8_t const *buffer, int64_t size);
+
+	///
+	/// @brief 按 CPU 支持的指令集选择实现。只选择一次。
+	///
+	/// @return
+	///
+	AsciiPrefixLengthFunction SelectAsciiPrefixLength()
+	{
+#if BASE_UTF8_AVX2
+		if (__builtin_cpu_supports("avx2"))
+		{
+			return AsciiPrefixLengthAvx2;
+		}
+#endif
+
+#if BASE_UTF8_SSE2
+		return AsciiPrefixLengthSse2;
+#else
+		return AsciiPrefixLengthScalar;
+#endif
+	}
+
+	int64_t AsciiPrefixLength(uint8_t const *buffer, int64_t size)
+	{
+		static AsciiPrefixLengthFunction const function = SelectAsciiPrefixLength();
+		return function(buffer, size);
+	}
+
+	/* #endregion */
+
+	/* #region ASCII 扩宽 */
+
+	///
+	/// @brief 把 ASCII 字节扩宽为 UTF-16 或 UTF-32 码元。
+	///
+	/// @param input
+	/// @param output
+	/// @param count
+	///
+	template <typename CharType>
+	void WidenAscii(uint8_t const *input, CharType *output, int64_t count)
+	{
+		int64_t i = 0;
+
+#if BASE_UTF8_SSE2
+		__m128i zero = _mm_setzero_si128();
+		for (; i + 16 <= count; i += 16)
+		{
+			__m128i chunk = _mm_loadu_si128(reinterpret_cast<__m128i const *>(input + i));
+			__m128i low = _mm_unpacklo_epi8(chunk, zero);
+			__m128i high = _mm_unpackhi_epi8(chunk, zero);
+			if constexpr (sizeof(CharType) == 2)
+			{
+				_mm_storeu_si128(reinterpret_cast<__m128i *>(output + i), low);
+				_mm_storeu_si128(reinterpret_cast<__m128i *>(output + i + 8), high);
+			}
+			else
+			{
+				_mm_storeu_si128(reinterpret_cast<__m128i *>(output + i), _mm_unpacklo_epi16(low, zero));
+				_mm_storeu_si128(reinterpret_cast<__m128i *>(output + i + 4), _mm_unpackhi_epi16(low, zero));
+				_mm_storeu_si128(reinterpret_cast<__m128i *>(output + i + 8), _mm_unpacklo_epi16(high, zero));
+				_mm_storeu_si128(reinterpret_cast<__m128i *>(output + i + 12), _mm_unpackhi_epi16(high, zero));
+			}
+		}
+#endif
+
+		for (; i < count; i++)
+		{
+			output[i] = static_cast<CharType>(input[i]);
+		}
+	}
+
+	/* #endregion */
+
+	/* #region 解码 */
+
+	bool IsContinuationByte(uint8_t byte)
+	{
+		return (byte & 0xc0) == 0x80;
+	}
+
+	///
+	/// @brief 根据首字节求序列长度。
+	///
+	/// @param byte 非 ASCII 字节。
+	/// @return 2, 3, 4. 接续字节和 0xf8 以上的字节不能作为序列开头，返回 0.
+	///
+	int SequenceLength(uint8_t byte)
+	{
+		if (byte < 0xc0)
+		{
+			return 0;
+		}
+
+		if (byte < 0xe0)
+		{
+			return 2;
+		}
+
+		if (byte < 0xf0)
+		{
+			return 3;
+		}
+
+		if (byte < 0xf8)
+		{
+			return 4;
+		}
+
+		return 0;
+	}
+
+	///
+	/// @brief 检查解码出的码点与序列长度是否相符，并且不是代理区码点。
+	///
+	/// @param value
+	/// @param length
+	/// @return
+	///
+	bool IsValidCodePoint(char32_t value, int length)
+	{
+		constexpr char32_t min_values[] = {0, 0, 0x80, 0x800, 0x10000};
+		if (value < min_values[length] || value > 0x10ffff)
+		{
+			return false;
+		}
+
+		return value < 0xd800 || value > 0xdfff;
+	}
+
+	template <typename CharType>
+	base::string::encoding::utf8_decode_result DecodeUtf8(uint8_t const *input, int64_t input_size,
+														  CharType *output, int64_t output_size,
+														  bool is_final_block)
+	{
+		int64_t i = 0;
+		int64_t o = 0;
+		while (i < input_size && o < output_size)
+		{
+			uint8_t byte1 = input[i];
+			if (byte1 < 0x80)
+			{
+				int64_t run = std::min(input_size - i, output_size - o);
+				run = AsciiPrefixLength(input + i, run);
+				WidenAscii(input + i, output + o, run);
+				i += run;
+				o += run;
+				continue;
+			}
+
+			int length = SequenceLength(byte1);
+			if (length == 0)
+			{
+				// 不能作为序列开头的字节。跳过其后所有不能作为序列开头的字节。
+				int64_t run_end = i + 1;
+				while (run_end < input_size && input[run_end] >= 0x80 && SequenceLength(input[run_end]) == 0)
+				{
+					run_end++;
+				}
+
+				if (run_end == input_size && !is_final_block)
+				{
+					// 这一串字节可能在下一块中延续。只留下最后一个字节给下一块，它会开始同一串，
+					// 到时候再输出 U+FFFD, 这样结果与块的划分无关，留下的字节也不超过 1 个。
+					i = run_end - 1;
+					break;
+				}
+
+				i = run_end;
+				output[o++] = static_cast<CharType>(_replacement_character);
+				continue;
+			}
+
+			int64_t available = input_size - i;
+
+			// 常见的 2 字节和 3 字节合法序列走快速路径。中文文本几乎全是 3 字节序列。
+			if (available >= 3 && IsContinuationByte(input[i + 1]))
+			{
+				if (length == 2)
+				{
+					char32_t value = ((byte1 & 0x1f) << 6) | (input[i + 1] & 0x3f);
+					if (value >= 0x80)
+					{
+						output[o++] = static_cast<CharType>(value);
+						i += 2;
+						continue;
+					}
+				}
+				else if (length == 3 && IsContinuationByte(input[i + 2]))
+				{
+					char32_t value = ((byte1 & 0x0f) << 12) | ((input[i + 1] & 0x3f) << 6) | (input[i + 2] & 0x3f);
+					if (value >= 0x800 && (value < 0xd800 || value > 0xdfff))
+					{
+						output[o++] = static_cast<CharType>(value);
+						i += 3;
+						continue;
+					}
+				}
+			}
+
+			int k = 1;
+			while (k < length && k < available && IsContinuationByte(input[i + k]))
+			{
+				k++;
+			}
+
+			if (k < length)
+			{
+				if (k == available && !is_final_block)
+				{
+					// 序列被块的末尾截断，等下一块数据。
+					break;
+				}
+
+				// 缺少接续字节。从不是接续字节的那个字节重新开始。
+				output[o++] = static_cast<CharType>(_replacement_character);
+				i += k;
+				continue;
+			}
+
+			char32_t value = byte1 & (0x7f >> length);
+			for (k = 1; k < length; k++)
+			{
+				value = (value << 6) | (input[i + k] & 0x3f);
+			}
+
+			if (!IsValidCodePoint(value, length))
+			{
+				value = _replacement_character;
+			}
+
+			if constexpr (sizeof(CharType) == 2)
+			{
+				if (value >= 0x10000)
+				{
+					if (output_size - o < 2)
+					{
+						break;
+					}
+
+					value -= 0x10000;
+					output[o++] = static_cast<CharType>(0xd800 + (value >> 10));
+					output[o++] = static_cast<CharType>(0xdc00 + (value & 0x3ff));
+					i += length;
+					continue;
+				}
+			}
+
+			output[o++] = static_cast<CharType>(value);
+			i += length;
+		}
+
+		return base::string::encoding::utf8_decode_result{i, o};
+	}
+
+	/* #endregion */
+
+	/* #region 编码 */
+
+	///
+	/// @brief 把码点编码为 UTF-8 写入 output.
+	///
+	/// @param value 合法的码点。
+	/// @param output 至少有 4 字节的空间。
+	/// @return 写入的字节数。
+	///
+	int EncodeCodePoint(char32_t value, uint8_t *output)
+	{
+		if (value < 0x80)
+		{
+			output[0] = static_cast<uint8_t>(value);
+			return 1;
+		}
+
+		if (value < 0x800)
+		{
+			output[0] = static_cast<uint8_t>(0xc0 | (value >> 6));
+			output[1] = static_cast<uint8_t>(0x80 | (value & 0x3f));
+			return 2;
+		}
+
+		if (value < 0x10000)
+		{
+			output[0] = static_cast<uint8_t>(0xe0 | (value >> 12));
+			output[1] = static_cast<uint8_t>(0x80 | ((value >> 6) & 0x3f));
+			output[2] = static_cast<uint8_t>(0x80 | (value & 0x3f));
+			return 3;
+		}
+
+		output[0] = static_cast<uint8_t>(0xf0 | (value >> 18));
+		output[1] = static_cast<uint8_t>(0x80 | ((value >> 12) & 0x3f));
+		output[2] = static_cast<uint8_t>(0x80 | ((value >> 6) & 0x3f));
+		output[3] = static_cast<uint8_t>(0x80 | (value & 0x3f));
+		return 4;
+	}
+
+	int EncodedLength(char32_t value)
+	{
+		if (value < 0x80)
+		{
+			return 1;
+		}
+
+		if (value < 0x800)
+		{
+			return 2;
+		}
+
+		if (value < 0x10000)
+		{
+			return 3;
+		}
+
+		return 4;
+	}
+
+	///
+	/// @brief 把一段 ASCII 码元收窄为字节。
+	///
+	/// @param input
+	/// @param input_size
+	/// @param output
+	/// @param output_size
+	/// @return 收窄的码元个数。遇到非 ASCII 码元或任一方用完时停止。
+	///
+	template <typename CharType>
+	int64_t NarrowAscii(CharType const *input, int64_t input_size, uint8_t *output, int64_t output_size)
+	{
+		int64_t count = std::min(input_size, output_size);
+		int64_t i = 0;
+
+#if BASE_UTF8_SSE2
+		if constexpr (sizeof(CharType) == 2)
+		{
+			__m128i const high_mask = _mm_set1_epi16(static_cast<short>(0xff80));
+			for (; i + 16 <= count; i += 16)
+			{
+				__m128i low = _mm_loadu_si128(reinterpret_cast<__m128i const *>(input + i));
+				__m128i high = _mm_loadu_si128(reinterpret_cast<__m128i const *>(input + i + 8));
+				__m128i non_ascii = _mm_and_si128(_mm_or_si128(low, high), high_mask);
+				if (_mm_movemask_epi8(_mm_cmpeq_epi16(non_ascii, _mm_setzero_si128())) != 0xffff)
+				{
+					break;
+				}
+
+				_mm_storeu_si128(reinterpret_cast<__m128i *>(output + i), _mm_packus_epi16(low, high));
+			}
+		}
+		else
+		{
+			__m128i const high_mask = _mm_set1_epi32(static_cast<int>(0xffffff80));
+			for (; i + 16 <= count; i += 16)
+			{
+				__m128i v0 = _mm_loadu_si128(reinterpret_cast<__m128i const *>(input + i));
+				__m128i v1 = _mm_loadu_si128(reinterpret_cast<__m128i const *>(input + i + 4));
+				__m128i v2 = _mm_loadu_si128(reinterpret_cast<__m128i const *>(input + i + 8));
+				__m128i v3 = _mm_loadu_si128(reinterpret_cast<__m128i const *>(input + i + 12));
+				__m128i any = _mm_or_si128(_mm_or_si128(v0, v1), _mm_or_si128(v2, v3));
+				__m128i non_ascii = _mm_and_si128(any, high_mask);
+				if (_mm_movemask_epi8(_mm_cmpeq_epi32(non_ascii, _mm_setzero_si128())) != 0xffff)
+				{
+					break;
+				}
+
+				// 值都 < 0x80, 有符号饱和打包不会改变它们。
+				__m128i low = _mm_packs_epi32(v0, v1);
+				__m128i high = _mm_packs_epi32(v2, v3);
+				_mm_storeu_si128(reinterpret_cast<__m128i *>(output + i), _mm_packus_epi16(low, high));
+			}
+		}
+#endif
+
+		while (i < count && static_cast<uint32_t>(input[i]) < 0x80)
+		{
+			output[i] = static_cast<uint8_t>(input[i]);
+			i++;
+		}
+
+		return i;
+	}
+
+	template <typename CharType>
+	int64_t EncodeUtf8(CharType const *input, int64_t input_size,
+					   uint8_t *output, int64_t output_size,
+					   int64_t &consumed)
+	{
+		int64_t i = 0;
+		int64_t o = 0;
+		while (i < input_size)
+		{
+			if (static_cast<uint32_t>(input[i]) < 0x80)
+			{
+				int64_t run = NarrowAscii(input + i, input_size - i, output + o, output_size - o);
+				if (run == 0)
+				{
+					// 输出缓冲区满了。
+					break;
+				}
+
+				i += run;
+				o += run;
+				continue;
+			}
+
+			char32_t value = static_cast<char32_t>(input[i]);
+			int unit_count = 1;
+			if constexpr (sizeof(CharType) == 2)
+			{
+				if (value >= 0xd800 && value <= 0xdbff && i + 1 < input_size &&
+					input[i + 1] >= 0xdc00 && input[i + 1] <= 0xdfff)
+				{
+					value = 0x10000 + ((value - 0xd800) << 10) + (input[i + 1] - 0xdc00);
+					unit_count = 2;
+				}
+			}
+
+			if ((value >= 0xd800 && value <= 0xdfff) || value > 0x10ffff)
+			{
+				value = _replacement_character;
+			}
+
+			int length = EncodedLength(value);
+			if (output_size - o < length)
+			{
+				break;
+			}
+
+			EncodeCodePoint(value, output + o);
+			i += unit_count;
+			o += length;
+		}
+
+		consumed = i;
+		return o;
+	}
+
+	/* #endregion */
+
+} // namespace
+
+int64_t base::string::encoding::ascii_prefix_length(base::ReadOnlySpan const &span)
+{
+	return AsciiPrefixLength(span.Buffer(), span.Size());
+}
+
+int64_t base::string::encoding::find_invalid_utf8(base::ReadOnlySpan const &span)
+{
+	uint8_t const *buffer = span.Buffer();
+	int64_t size = span.Size();
+	int64_t i = 0;
+	while (i < size)
+	{
+		if (buffer[i] < 0x80)
+		{
+			i += AsciiPrefixLength(buffer + i, size - i);
+			continue;
+		}
+
+		uint8_t byte1 = buffer[i];
+		int length = SequenceLength(byte1);
+		if (length == 0 || byte1 == 0xc0 || byte1 == 0xc1 || byte1 > 0xf4)
+		{
+			return i;
+		}
+
+		if (size - i < length)
+		{
+			return i;
+		}
+
+		// 第 2 个字节的范围随首字节变化，排除过长编码、代理区和大于 U+10FFFF 的码点。
+		uint8_t byte2 = buffer[i + 1];
+		uint8_t min_byte2 = 0x80;
+		uint8_t max_byte2 = 0xbf;
+		switch (byte1)
+		{
+		case 0xe0:
+			{
+				min_byte2 = 0xa0;
+				break;
+			}
+		case 0xed:
+			{
+				max_byte2 = 0x9f;
+				break;
+			}
+		case 0xf0:
+			{
+				min_byte2 = 0x90;
+				break;
+			}
+		case 0xf4:
+			{
+				max_byte2 = 0x8f;
+				break;
+			}
+		default:
+			{
+				break;
+			}
+		}
+
+		if (byte2 < min_byte2 || byte2 > max_byte2)
+		{
+			return i;
+		}
+
+		for (int k = 2; k < length; k++)
+		{
+			if (!IsContinuationByte(buffer[i + k]))
+			{
+				return i;
+			}
+		}
+
+		i += length;
+	}
+
+	return size;
+}
+
+base::string::encoding::utf8_decode_result base::string::encoding::decode_utf8(base::ReadOnlySpan const &input,
+																			   base::ArraySpan<char32_t> const &output,
+																			   bool is_final_block)
+{
+	return DecodeUtf8(input.Buffer(), input.Size(), output.Buffer(), output.Count(), is_final_block);
+}
+
+base::string::encoding::utf8_decode_result base::string::encoding::decode_utf8(base::ReadOnlySpan const &input,
+																			   base::ArraySpan<char16_t> const &output,
+																			   bool is_final_block)
+{
+	return DecodeUtf8(input.Buffer(), input.Size(), output.Buffer(), output.Count(), is_final_block);
+}
+
+int64_t base::string::encoding::encode_utf8(base::ReadOnlyArraySpan<char32_t> const &input,
+											base::Span const &output,
+											int64_t &consumed)
+{
+	return EncodeUtf8(input.Buffer(), input.Count(), output.Buffer(), output.Size(), consumed);
+}
+
+int64_t base::string::encoding::encode_utf8(base::ReadOnlyArraySpan<char16_t> const &input,
+											base::Span const &output,
+											int64_t &consumed)
+{
+	return EncodeUtf8(input.Buffer(), input.Count(), output.Buffer(), output.Size(), consumed);
+}
+
+std::u32string base::string::encoding::convert_utf8_string_to_utf32_string(base::ReadOnlySpan const &span)
+{
+	// 每个字节最多产生 1 个字符。
+	std::u32string ret(span.Size(), U'\0');
+	utf8_decode_result result = DecodeUtf8(span.Buffer(), span.Size(), ret.data(), span.Size(), true);
+	ret.resize(result._written);
+	return ret;
+}
+
+std::u16string base::string::encoding::convert_utf8_string_to_utf16_string(base::ReadOnlySpan const &span)
+{
+	// 1 到 3 字节的序列产生 1 个码元，4 字节的序列产生 2 个码元，码元数不会超过字节数。
+	std::u16string ret(span.Size(), u'\0');
+	utf8_decode_result result = DecodeUtf8(span.Buffer(), span.Size(), ret.data(), span.Size(), true);
+	ret.resize(result._written);
+	return ret;
+}
+
+std::string base::string::encoding::convert_utf32_string_to_utf8_string(std::u32string_view const &str)
+{
+	int64_t size = static_cast<int64_t>(str.size());
+	std::string ret(4 * size, '\0');
+	int64_t consumed = 0;
+	int64_t written = EncodeUtf8(str.data(), size, reinterpret_cast<uint8_t *>(ret.data()), 4 * size, consumed);
+	ret.resize(written);
+	return ret;
+}
+
+std::string base::string::encoding::convert_utf16_string_to_utf8_string(std::u16string_view const &str)
+{
+	int64_t size = static_cast<int64_t>(str.size());
+	std::string ret(3 * size, '\0');
+	int64_t consumed = 0;
+	int64_t written = EncodeUtf8(str.data(), size, reinterpret_cast<uint8_t *>(ret.data()), 3 * size, consumed);
+	ret.resize(written);
+	return ret;
+}
@@ -0,0 +1,156 @@
+#pragma once
+#include "base/container/ArraySpan.h"
+#include "base/container/ReadOnlyArraySpan.h"
+#include "base/stream/ReadOnlySpan.h"
+#include "base/stream/Span.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace base::string::encoding
+{
+	///
+	/// @brief 成块解码 UTF-8 的结果。
+	///
+	struct utf8_decode_result
+	{
+		///
+		/// @brief 消耗的输入字节数。
+		///
+		int64_t _consumed = 0;
+
+		///
+		/// @brief 写入输出的码元个数。
+		///
+		int64_t _written = 0;
+	};
+
+	///
+	/// @brief 求 span 开头连续的 ASCII 字节的个数。
+	///
+	/// @note x86 上用 SSE2 或 AVX2 一次检查 16 或 32 个字节的最高位，
+	/// 其他平台一次检查 8 个字节。
+	///
+	/// @param span
+	/// @return 第一个非 ASCII 字节的索引。全部是 ASCII 时返回 span.Size().
+	///
+	int64_t ascii_prefix_length(base::ReadOnlySpan const &span);
+
+	///
+	/// @brief 查找第一个非法 UTF-8 序列。
+	///
+	/// @note 按 Unicode 标准严格检查：拒绝过长编码、UTF-16 代理区码点、大于 U+10FFFF 的码点，
+	/// 以及末尾被截断的序列。ASCII 部分走 ascii_prefix_length 的向量化路径。
+	///
+	/// @param span
+	/// @return 第一个非法序列的首字节索引。全部合法时返回 span.Size().
+	///
+	int64_t find_invalid_utf8(base::ReadOnlySpan const &span);
+
+	///
+	/// @brief 检查 span 是否是合法的 UTF-8 字节序列。
+	///
+	/// @param span
+	/// @return
+	///
+	inline bool is_valid_utf8(base::ReadOnlySpan const &span)
+	{
+		return find_invalid_utf8(span) == span.Size();
+	}
+
+	///
+	/// @brief 将 UTF-8 字节序列解码为 UTF-32.
+	///
+	/// @note 非法序列替换为 U+FFFD:
+	/// 	@li 不能作为序列开头的字节：输出 1 个替换字符，并跳过其后所有不能作为序列开头的字节。
+	/// 	@li 缺少接续字节：输出 1 个替换字符，从不是接续字节的那个字节重新开始解码。
+	/// 	@li 接续字节齐全但码点非法：输出 1 个替换字符，跳过整个序列。
+	///
+	/// @param input 输入的 UTF-8 字节。
+	/// @param output 输出缓冲区。元素个数 >= input.Size() 时一定能容纳全部结果。
+	/// @param is_final_block 输入后面是否没有更多数据了。为 false 时末尾不完整的序列
+	/// 不会被消耗，延续到末尾的一串不能作为序列开头的字节会留下最后一个，都留给下一次调用，
+	/// 所以分块解码的结果与一次解码整个输入相同；为 true 时末尾不完整的序列被替换为 U+FFFD.
+	/// @return 消耗的字节数和写入的字符数。输出缓冲区满时提前返回。
+	///
+	base::string::encoding::utf8_decode_result decode_utf8(base::ReadOnlySpan const &input,
+														   base::ArraySpan<char32_t> const &output,
+														   bool is_final_block = true);
+
+	///
+	/// @brief 将 UTF-8 字节序列解码为 UTF-16.
+	///
+	/// @note 非法序列的处理与输出 UTF-32 的重载相同。U+10000 以上的码点输出代理对，
+	/// 输出缓冲区只剩 1 个位置时不会拆开代理对，而是提前返回。
+	///
+	/// @param input 输入的 UTF-8 字节。
+	/// @param output 输出缓冲区。元素个数 >= input.Size() 时一定能容纳全部结果。
+	/// @param is_final_block 输入后面是否没有更多数据了。
+	/// @return 消耗的字节数和写入的码元数。
+	///
+	base::string::encoding::utf8_decode_result decode_utf8(base::ReadOnlySpan const &input,
+														   base::ArraySpan<char16_t> const &output,
+														   bool is_final_block = true);
+
+	///
+	/// @brief 将 UTF-32 字符编码为 UTF-8.
+	///
+	/// @note 代理区码点和大于 U+10FFFF 的值编码为 U+FFFD.
+	///
+	/// @param input
+	/// @param output 输出缓冲区。大小 >= 4 * input.Count() 时一定能容纳全部结果。
+	/// @param consumed 接收消耗的字符数。输出缓冲区不足以容纳下一个字符时提前返回。
+	/// @return 写入的字节数。
+	///
+	int64_t encode_utf8(base::ReadOnlyArraySpan<char32_t> const &input,
+						base::Span const &output,
+						int64_t &consumed);
+
+	///
+	/// @brief 将 UTF-16 码元编码为 UTF-8.
+	///
+	/// @note 不成对的代理编码为 U+FFFD.
+	///
+	/// @param input
+	/// @param output 输出缓冲区。大小 >= 3 * input.Count() 时一定能容纳全部结果。
+	/// @param consumed 接收消耗的码元数。输出缓冲区不足以容纳下一个字符时提前返回。
+	/// 输入末尾是一个高位代理时，它被当作不成对的代理处理。
+	/// @return 写入的字节数。
+	///
+	int64_t encode_utf8(base::ReadOnlyArraySpan<char16_t> const &input,
+						base::Span const &output,
+						int64_t &consumed);
+
+	///
+	/// @brief 将 UTF-8 字符串转换为 UTF-32 字符串。非法序列替换为 U+FFFD.
+	///
+	/// @param span
+	/// @return
+	///
+	std::u32string convert_utf8_string_to_utf32_string(base::ReadOnlySpan const &span);
+
+	///
+	/// @brief 将 UTF-8 字符串转换为 UTF-16 字符串。非法序列替换为 U+FFFD.
+	///
+	/// @param span
+	/// @return
+	///
+	std::u16string convert_utf8_string_to_utf16_string(base::ReadOnlySpan const &span);
+
+	///
+	/// @brief 将 UTF-32 字符串转换为 UTF-8 字符串。
+	///
+	/// @param str
+	/// @return
+	///
+	std::string convert_utf32_string_to_utf8_string(std::u32string_view const &str);
+
+	///
+	/// @brief 将 UTF-16 字符串转换为 UTF-8 字符串。
+	///
+	/// @param str
+	/// @return
+	///
+	std::string convert_utf16_string_to_utf8_string(std::u16string_view const &str);
+
+} // namespace base::string::encoding
@@ -0,0 +1 @@
+#include "StaticUnit.h" // IWYU pragma: keep
@@ -0,0 +1,566 @@
+#pragma once
+#include "base/math/Fraction.h"
+#include "base/unit/IUnit.h"
+#include <compare>
+#include <cstdint>
+#include <ratio>
+#include <type_traits>
+
+namespace base
+{
+	namespace unit
+	{
+		// 前置声明运行时单位，用于与编译期单位互相转换。
+		class Nanosecond;
+		class Second;
+		class Minute;
+		class Hour;
+		class Day;
+		class J;
+		class mWh;
+		class Wh;
+		class kWh;
+		class mW;
+		class W;
+		class kW;
+		class mA;
+		class A;
+		class mAh;
+		class Ah;
+		class Hz;
+		class MHz;
+		class V;
+		class bps;
+		class Mbps;
+		class rps;
+		class rpm;
+		class Nm;
+
+	} // namespace unit
+
+	///
+	/// @brief 编译期单位。
+	///
+	/// @note base::unit 中的单位使用 base::Fraction 在运行时换算，灵活但是慢。
+	/// 这里的单位把比例系数放到模板参数中，换算系数在编译期就确定了，换算只需要
+	/// 一次乘法或除法，可以被常量折叠。
+	///
+	namespace static_unit
+	{
+		///
+		/// @brief 量纲。只有量纲相同的单位才能互相换算。
+		///
+		namespace dimension
+		{
+			struct Time;
+			struct Energy;
+			struct Power;
+			struct Current;
+			struct Charge;
+			struct Frequency;
+			struct Voltage;
+			struct DataRate;
+			struct RotationalSpeed;
+			struct Torque;
+
+		} // namespace dimension
+
+		///
+		/// @brief 编译期单位。
+		///
+		/// @note 值为 value 的本单位等于 value * TRatio 个该量纲的国际单位制基准单位。
+		/// 例如 kWh 的 TRatio 为 3600000, 表示 1 kWh = 3600000 J.
+		///
+		/// @tparam TDimension 量纲。
+		/// @tparam TRatio 相对于国际单位制基准单位的比例，是一个 std::ratio.
+		/// @tparam TRep 储存值的类型。
+		///
+		template <typename TDimension, typename TRatio, typename TRep = int64_t>
+			requires(std::is_arithmetic_v<TRep>)
+		class StaticUnit;
+
+		///
+		/// @brief 概念。检查 T 是不是编译期单位。
+		///
+		template <typename T>
+		concept is_static_unit = requires() {
+			typename T::dimension_type;
+			typename T::ratio_type;
+			typename T::rep_type;
+			requires(std::is_same_v<T,
+									base::static_unit::StaticUnit<typename T::dimension_type,
+																  typename T::ratio_type,
+																  typename T::rep_type>>);
+		};
+
+		///
+		/// @brief 运行时单位的量纲和比例。
+		///
+		/// @note 特化了本模板的运行时单位才能与编译期单位互相转换。
+		///
+		template <typename TRuntimeUnit>
+		struct runtime_unit_traits;
+
+		///
+		/// @brief 概念。检查运行时单位 TRuntimeUnit 能否与量纲为 TDimension 的编译期单位
+		/// 互相转换。
+		///
+		template <typename TRuntimeUnit, typename TDimension>
+		concept is_runtime_unit_of = requires() {
+			typename base::static_unit::runtime_unit_traits<TRuntimeUnit>::dimension_type;
+			typename base::static_unit::runtime_unit_traits<TRuntimeUnit>::ratio_type;
+			requires(std::is_same_v<typename base::static_unit::runtime_unit_traits<TRuntimeUnit>::dimension_type,
+									TDimension>);
+		};
+
+		///
+		/// @brief 编译期单位之间的换算。
+		///
+		/// @note 换算系数在编译期计算。系数分母为 1 时只有一次乘法，分子为 1 时只有一次除法。
+		/// 目标值类型为整型时会截断，所以称为 cast, 类似 std::chrono::duration_cast.
+		///
+		/// @param value
+		///
+		/// @return
+		///
+		template <typename TTo, typename TDimension, typename TRatio, typename TRep>
+			requires(base::static_unit::is_static_unit<TTo> &&
+					 std::is_same_v<typename TTo::dimension_type, TDimension>)
+		constexpr TTo static_unit_cast(base::static_unit::StaticUnit<TDimension, TRatio, TRep> const &value)
+		{
+			using factor = std::ratio_divide<TRatio, typename TTo::ratio_type>;
+			using to_rep = typename TTo::rep_type;
+			using common_rep = std::common_type_t<TRep, to_rep, intmax_t>;
+
+			if constexpr (factor::num == 1 && factor::den == 1)
+			{
+				return TTo{static_cast<to_rep>(value.Value())};
+			}
+			else if constexpr (std::is_floating_point_v<common_rep>)
+			{
+				// 浮点数把系数合并成一个编译期常量，只需要一次乘法。
+				constexpr common_rep scale = static_cast<common_rep>(factor::num) /
+											 static_cast<common_rep>(factor::den);
+
+				return TTo{static_cast<to_rep>(static_cast<common_rep>(value.Value()) * scale)};
+			}
+			else if constexpr (factor::den == 1)
+			{
+				return TTo{static_cast<to_rep>(static_cast<common_rep>(value.Value()) * factor::num)};
+			}
+			else if constexpr (factor::num == 1)
+			{
+				return TTo{static_cast<to_rep>(static_cast<common_rep>(value.Value()) / factor::den)};
+			}
+			else
+			{
+				return TTo{static_cast<to_rep>(static_cast<common_rep>(value.Value()) * factor::num / factor::den)};
+			}
+		}
+
+		template <typename TDimension, typename TRatio, typename TRep>
+			requires(std::is_arithmetic_v<TRep>)
+		class StaticUnit
+		{
+		private:
+			TRep _value{};
+
+			///
+			/// @brief 从 TOtherRatio, TOtherRep 的单位换算到本单位是否不会损失精度。
+			///
+			/// @note 本单位是浮点数，或者双方都是整型且换算系数是整数时不会损失精度。
+			///
+			template <typename TOtherRatio, typename TOtherRep>
+			static constexpr bool IsLosslessFrom()
+			{
+				if constexpr (std::is_floating_point_v<TRep>)
+				{
+					return true;
+				}
+				else
+				{
+					return !std::is_floating_point_v<TOtherRep> &&
+						   std::ratio_divide<TOtherRatio, TRatio>::den == 1;
+				}
+			}
+
+		public:
+			using dimension_type = TDimension;
+			using ratio_type = TRatio;
+			using rep_type = TRep;
+
+			/* #region 构造函数 */
+
+			constexpr StaticUnit() = default;
+
+			constexpr explicit StaticUnit(TRep value)
+				: _value(value)
+			{
+			}
+
+			///
+			/// @brief 从同量纲的其他编译期单位换算。
+			///
+			/// @note 只允许不会损失精度的隐式换算，会损失精度的需要使用
+			/// base::static_unit::static_unit_cast.
+			///
+			/// @param other
+			///
+			template <typename TOtherRatio, typename TOtherRep>
+				requires(IsLosslessFrom<TOtherRatio, TOtherRep>())
+			constexpr StaticUnit(base::static_unit::StaticUnit<TDimension, TOtherRatio, TOtherRep> const &other)
+				: _value(base::static_unit::static_unit_cast<StaticUnit>(other).Value())
+			{
+			}
+
+			///
+			/// @brief 从运行时单位构造。
+			///
+			/// @note 运行时单位的值是 base::Fraction, 换算后截断或舍入到 TRep.
+			///
+			/// @param value
+			///
+			template <typename TRuntimeUnit>
+				requires(base::static_unit::is_runtime_unit_of<TRuntimeUnit, TDimension>)
+			explicit StaticUnit(TRuntimeUnit const &value)
+			{
+				using factor = std::ratio_divide<typename base::static_unit::runtime_unit_traits<TRuntimeUnit>::ratio_type,
+												 TRatio>;
+
+				// Day, Hour 等单位只覆盖了非 const 的 Value, 隐藏了基类的 const 版本，
+				// 所以通过基类读取。
+				base::unit::IUnit<TRuntimeUnit> const &unit = value;
+				base::Fraction fraction = unit.Value() * base::Fraction{factor::num, factor::den};
+				_value = static_cast<TRep>(fraction);
+			}
+
+			/* #endregion */
+
+			///
+			/// @brief 单位的值。
+			///
+			/// @return
+			///
+			constexpr TRep Value() const
+			{
+				return _value;
+			}
+
+			///
+			/// @brief 转换为运行时单位。
+			///
+			/// @return
+			///
+			template <typename TRuntimeUnit>
+				requires(base::static_unit::is_runtime_unit_of<TRuntimeUnit, TDimension>)
+			explicit operator TRuntimeUnit() const
+			{
+				using factor = std::ratio_divide<TRatio,
+												 typename base::static_unit::runtime_unit_traits<TRuntimeUnit>::ratio_type>;
+
+				base::Fraction fraction = base::Fraction{_value} * base::Fraction{factor::num, factor::den};
+				return TRuntimeUnit{fraction};
+			}
+
+			/* #region 算术运算 */
+
+			constexpr StaticUnit operator-() const
+			{
+				return StaticUnit{static_cast<TRep>(-_value)};
+			}
+
+			constexpr StaticUnit operator+(StaticUnit const &value) const
+			{
+				return StaticUnit{static_cast<TRep>(_value + value._value)};
+			}
+
+			constexpr StaticUnit operator-(StaticUnit const &value) const
+			{
+				return StaticUnit{static_cast<TRep>(_value - value._value)};
+			}
+
+			///
+			/// @brief 乘上无量纲的系数。
+			///
+			/// @param value
+			/// @return
+			///
+			constexpr StaticUnit operator*(TRep value) const
+			{
+				return StaticUnit{static_cast<TRep>(_value * value)};
+			}
+
+			///
+			/// @brief 除以无量纲的系数。
+			///
+			/// @param value
+			/// @return
+			///
+			constexpr StaticUnit operator/(TRep value) const
+			{
+				return StaticUnit{static_cast<TRep>(_value / value)};
+			}
+
+			///
+			/// @brief 除以同单位的值，得到无量纲的比值。
+			///
+			/// @param value
+			/// @return
+			///
+			constexpr TRep operator/(StaticUnit const &value) const
+			{
+				return _value / value._value;
+			}
+
+			constexpr StaticUnit &operator+=(StaticUnit const &value)
+			{
+				_value += value._value;
+				return *this;
+			}
+
+			constexpr StaticUnit &operator-=(StaticUnit const &value)
+			{
+				_value -= value._value;
+				return *this;
+			}
+
+			constexpr StaticUnit &operator*=(TRep value)
+			{
+				_value *= value;
+				return *this;
+			}
+
+			constexpr StaticUnit &operator/=(TRep value)
+			{
+				_value /= value;
+				return *this;
+			}
+
+			/* #endregion */
+
+			/* #region 比较 */
+
+			constexpr bool operator==(StaticUnit const &other) const = default;
+
+			constexpr auto operator<=>(StaticUnit const &other) const = default;
+
+			/* #endregion */
+		};
+
+		/* #region 单位 */
+
+		using Nanosecond = base::static_unit::StaticUnit<dimension::Time, std::nano>;
+		using Microsecond = base::static_unit::StaticUnit<dimension::Time, std::micro>;
+		using Millisecond = base::static_unit::StaticUnit<dimension::Time, std::milli>;
+		using Second = base::static_unit::StaticUnit<dimension::Time, std::ratio<1>>;
+		using Minute = base::static_unit::StaticUnit<dimension::Time, std::ratio<60>>;
+		using Hour = base::static_unit::StaticUnit<dimension::Time, std::ratio<60 * 60>>;
+		using Day = base::static_unit::StaticUnit<dimension::Time, std::ratio<60 * 60 * 24>>;
+
+		using J = base::static_unit::StaticUnit<dimension::Energy, std::ratio<1>>;
+
+		// 1 mWh = 3600 J / 1000
+		using mWh = base::static_unit::StaticUnit<dimension::Energy, std::ratio<3600, 1000>>;
+		using Wh = base::static_unit::StaticUnit<dimension::Energy, std::ratio<3600>>;
+		using kWh = base::static_unit::StaticUnit<dimension::Energy, std::ratio<3600 * 1000>>;
+
+		using mW = base::static_unit::StaticUnit<dimension::Power, std::milli>;
+		using W = base::static_unit::StaticUnit<dimension::Power, std::ratio<1>>;
+		using kW = base::static_unit::StaticUnit<dimension::Power, std::kilo>;
+
+		using mA = base::static_unit::StaticUnit<dimension::Current, std::milli>;
+		using A = base::static_unit::StaticUnit<dimension::Current, std::ratio<1>>;
+
+		// 电荷量的基准单位是 A·s, 即库仑。
+		using mAh = base::static_unit::StaticUnit<dimension::Charge, std::ratio<3600, 1000>>;
+		using Ah = base::static_unit::StaticUnit<dimension::Charge, std::ratio<3600>>;
+
+		using Hz = base::static_unit::StaticUnit<dimension::Frequency, std::ratio<1>>;
+		using MHz = base::static_unit::StaticUnit<dimension::Frequency, std::mega>;
+
+		using V = base::static_unit::StaticUnit<dimension::Voltage, std::ratio<1>>;
+
+		// 在通信领域，1 Mbit = 1000 * 1000 bit.
+		using bps = base::static_unit::StaticUnit<dimension::DataRate, std::ratio<1>>;
+		using Mbps = base::static_unit::StaticUnit<dimension::DataRate, std::mega>;
+
+		using rps = base::static_unit::StaticUnit<dimension::RotationalSpeed, std::ratio<1>>;
+		using rpm = base::static_unit::StaticUnit<dimension::RotationalSpeed, std::ratio<1, 60>>;
+
+		using Nm = base::static_unit::StaticUnit<dimension::Torque, std::ratio<1>>;
+
+		/* #endregion */
+
+		/* #region 运行时单位的量纲和比例 */
+
+		template <typename TStaticUnit>
+		struct runtime_unit_traits_base
+		{
+			using dimension_type = typename TStaticUnit::dimension_type;
+			using ratio_type = typename TStaticUnit::ratio_type;
+		};
+
+		template <>
+		struct runtime_unit_traits<base::unit::Nanosecond> :
+			public runtime_unit_traits_base<base::static_unit::Nanosecond>
+		{
+		};
+
+		template <>
+		struct runtime_unit_traits<base::unit::Second> :
+			public runtime_unit_traits_base<base::static_unit::Second>
+		{
+		};
+
+		template <>
+		struct runtime_unit_traits<base::unit::Minute> :
+			public runtime_unit_traits_base<base::static_unit::Minute>
+		{
+		};
+
+		template <>
+		struct runtime_unit_traits<base::unit::Hour> :
+			public runtime_unit_traits_base<base::static_unit::Hour>
+		{
+		};
+
+		template <>
+		struct runtime_unit_traits<base::unit::Day> :
+			public runtime_unit_traits_base<base::static_unit::Day>
+		{
+		};
+
+		template <>
+		struct runtime_unit_traits<base::unit::J> :
+			public runtime_unit_traits_base<base::static_unit::J>
+		{
+		};
+
+		template <>
+		struct runtime_unit_traits<base::unit::mWh> :
+			public runtime_unit_traits_base<base::static_unit::mWh>
+		{
+		};
+
+		template <>
+		struct runtime_unit_traits<base::unit::Wh> :
+			public runtime_unit_traits_base<base::static_unit::Wh>
+		{
+		};
+
+		template <>
+		struct runtime_unit_traits<base::unit::kWh> :
+			public runtime_unit_traits_base<base::static_unit::kWh>
+		{
+		};
+
+		template <>
+		struct runtime_unit_traits<base::unit::mW> :
+			public runtime_unit_traits_base<base::static_unit::mW>
+		{
+		};
+
+		template <>
+		struct runtime_unit_traits<base::unit::W> :
+			public runtime_unit_traits_base<base::static_unit::W>
+		{
+		};
+
+		template <>
+		struct runtime_unit_traits<base::unit::kW> :
+			public runtime_unit_traits_base<base::static_unit::kW>
+		{
+		};
+
+		template <>
+		struct runtime_unit_traits<base::unit::mA> :
+			public runtime_unit_traits_base<base::static_unit::mA>
+		{
+		};
+
+		template <>
+		struct runtime_unit_traits<base::unit::A> :
+			public runtime_unit_traits_base<base::static_unit::A>
+		{
+		};
+
+		template <>
+		struct runtime_unit_traits<base::unit::mAh> :
+			public runtime_unit_traits_base<base::static_unit::mAh>
+		{
+		};
+
+		template <>
+		struct runtime_unit_traits<base::unit::Ah> :
+			public runtime_unit_traits_base<base::static_unit::Ah>
+		{
+		};
+
+		template <>
+		struct runtime_unit_traits<base::unit::Hz> :
+			public runtime_unit_traits_base<base::static_unit::Hz>
+		{
+		};
+
+		template <>
+		struct runtime_unit_traits<base::unit::MHz> :
+			public runtime_unit_traits_base<base::static_unit::MHz>
+		{
+		};
+
+		template <>
+		struct runtime_unit_traits<base::unit::V> :
+			public runtime_unit_traits_base<base::static_unit::V>
+		{
+		};
+
+		template <>
+		struct runtime_unit_traits<base::unit::bps> :
+			public runtime_unit_traits_base<base::static_unit::bps>
+		{
+		};
+
+		template <>
+		struct runtime_unit_traits<base::unit::Mbps> :
+			public runtime_unit_traits_base<base::static_unit::Mbps>
+		{
+		};
+
+		template <>
+		struct runtime_unit_traits<base::unit::rps> :
+			public runtime_unit_traits_base<base::static_unit::rps>
+		{
+		};
+
+		template <>
+		struct runtime_unit_traits<base::unit::rpm> :
+			public runtime_unit_traits_base<base::static_unit::rpm>
+		{
+		};
+
+		template <>
+		struct runtime_unit_traits<base::unit::Nm> :
+			public runtime_unit_traits_base<base::static_unit::Nm>
+		{
+		};
+
+		/* #endregion */
+
+	} // namespace static_unit
+} // namespace base
+
+///
+/// @brief 无量纲的系数乘上单位。
+///
+/// @param left
+/// @param right
+///
+/// @return
+///
+template <typename TDimension, typename TRatio, typename TRep>
+constexpr base::static_unit::StaticUnit<TDimension, TRatio, TRep> operator*(
+	std::type_identity_t<TRep> left,
+	base::static_unit::StaticUnit<TDimension, TRatio, TRep> const &right)
+{
+	return right * left;
+}
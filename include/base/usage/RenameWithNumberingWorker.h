@@ -1,11 +1,13 @@
 #pragma once
 #include "base/container/List.h"
 #include "base/filesystem/filesystem.h"
+#include "base/filesystem/ParallelDirectoryScanner.h"
 #include "base/filesystem/Path.h"
 #include "base/string/String.h"
 #include <cstdint>
 #include <iostream>
 #include <string>
+#include <vector>
 
 namespace base::usage
 {
@@ -25,15 +27,24 @@ namespace base::usage
 		{
 			base::List<base::Path> ret{};
 
-			for (base::filesystem::DirectoryEntry const &entry : base::filesystem::DirectoryEntryEnumerable{_work_path})
+			// 类型来自目录项，只有符号链接才需要 stat 看它指向的是不是文件。
+			std::vector<base::filesystem::ScannedEntry> entries;
+			base::filesystem::ReadDirectory(_work_path, entries);
+			for (base::filesystem::ScannedEntry const &entry : entries)
 			{
-				if (!entry.IsRegularFile())
+				base::Path file_path{entry._path};
+				if (entry._type == base::filesystem::ScannedEntryType::SymbolicLink)
+				{
+					if (!base::filesystem::IsRegularFile(file_path))
+					{
+						continue;
+					}
+				}
+				else if (entry._type != base::filesystem::ScannedEntryType::RegularFile)
 				{
 					continue;
 				}
 
-				base::Path file_path = entry.Path();
-
 				if (file_path.ExtensionName() == "ini")
 				{
 					continue;
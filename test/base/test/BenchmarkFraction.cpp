@@ -0,0 +1,86 @@
+#include "BenchmarkFraction.h" // IWYU pragma: keep
+#include "base/math/Fraction.h"
+#include "base/string/define.h"
+#include "base/unit/Second.h"
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+
+#if HAS_THREAD
+
+namespace
+{
+	constexpr int64_t _loop_count = 1000 * 1000;
+
+	///
+	/// @brief 执行 func _loop_count 次，打印每次的平均耗时。
+	///
+	/// @param name
+	/// @param func
+	///
+	template <typename TFunc>
+	void Run(std::string const &name, TFunc const &func)
+	{
+		// 累加结果，防止被优化掉。
+		int64_t sum = 0;
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for (int64_t i = 0; i < _loop_count; i++)
+		{
+			sum += func(i);
+		}
+
+		std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+		std::chrono::nanoseconds elapsed = end - start;
+
+		std::cout << name << ": "
+				  << static_cast<double>(elapsed.count()) / _loop_count
+				  << " ns/次, 校验和: " << sum
+				  << std::endl;
+	}
+
+} // namespace
+
+void base::test::BenchmarkFraction()
+{
+	std::cout << std::endl
+			  << CODE_POS_STR;
+
+	// SoftWareTimeoutSerial 中的接收超时计算。
+	Run("波特数 / 波特率 -> Second -> nanoseconds",
+		[](int64_t i)
+		{
+			uint32_t frames_baud_count = static_cast<uint32_t>(10 * (i % 8 + 1));
+			uint32_t baud_rate = 115200;
+			base::unit::Second timeout_seconds{base::Fraction{frames_baud_count, baud_rate}};
+			std::chrono::nanoseconds timeout = static_cast<std::chrono::nanoseconds>(timeout_seconds);
+			return timeout.count();
+		});
+
+	Run("milliseconds -> Second -> nanoseconds",
+		[](int64_t i)
+		{
+			base::unit::Second seconds{std::chrono::milliseconds{i % 1000}};
+			return static_cast<std::chrono::nanoseconds>(seconds).count();
+		});
+
+	Run("Fraction 加法与乘法",
+		[](int64_t i)
+		{
+			base::Fraction f{i % 97 + 1, 1000};
+			f = f * base::Fraction{3, 7} + base::Fraction{1, 3};
+			return static_cast<int64_t>(f * 1000);
+		});
+
+	// 分子分母超出 int64_t 范围，走大整型路径，作为对比。
+	// 分子为奇数，分母为 2 的幂，不能约分，所以每一步都停留在大整型表示法。
+	Run("Fraction 大整型路径加法与乘法",
+		[](int64_t i)
+		{
+			base::Fraction f{(base::BigInteger{i % 97 + 1} << 70) + 1, base::BigInteger{1} << 70};
+			f = f * base::Fraction{(base::BigInteger{3} << 70) + 1, base::BigInteger{7}} + base::Fraction{1, 3};
+			return static_cast<int64_t>(f / (base::BigInteger{1} << 70) * 1000);
+		});
+}
+
+#endif // HAS_THREAD
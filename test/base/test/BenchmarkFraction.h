@@ -0,0 +1,20 @@
+#pragma once
+
+#if HAS_THREAD
+
+namespace base
+{
+	namespace test
+	{
+		///
+		/// @brief 测试 base::Fraction 在单位换算中的性能。
+		///
+		/// @note 换算过程与 SoftWareTimeoutSerial 计算接收超时时间相同：由波特数和波特率
+		/// 构造分数，转为 base::unit::Second, 再转为 std::chrono::nanoseconds.
+		///
+		void BenchmarkFraction();
+
+	} // namespace test
+} // namespace base
+
+#endif // HAS_THREAD
@@ -0,0 +1,114 @@
+#include "BenchmarkStaticUnit.h" // IWYU pragma: keep
+#include "base/string/define.h"
+#include "base/unit/kWh.h"
+#include "base/unit/mWh.h"
+#include "base/unit/Nanosecond.h"
+#include "base/unit/Second.h"
+#include "base/unit/StaticUnit.h"
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#if HAS_THREAD
+
+namespace
+{
+	constexpr int64_t _loop_count = 1000 * 1000;
+
+	// 换算系数在编译期确定，换算结果可以在编译期求出。
+	static_assert(base::static_unit::static_unit_cast<base::static_unit::kWh>(base::static_unit::mWh{5 * 1000 * 1000}).Value() == 5);
+	static_assert(base::static_unit::Nanosecond{base::static_unit::Second{3}}.Value() == 3 * 1000 * 1000 * 1000LL);
+	static_assert(base::static_unit::static_unit_cast<base::static_unit::Second>(base::static_unit::Nanosecond{3500 * 1000 * 1000LL}).Value() == 3);
+
+	///
+	/// @brief 对 _loop_count 个输入执行 func, 打印每次的平均耗时。
+	///
+	/// @note 输入放在数组中，避免整个循环被编译器在编译期求出。
+	///
+	/// @param name
+	/// @param func
+	///
+	template <typename TFunc>
+	void Run(std::string const &name, TFunc const &func)
+	{
+		std::vector<int64_t> inputs;
+		inputs.reserve(_loop_count);
+		for (int64_t i = 0; i < _loop_count; i++)
+		{
+			inputs.push_back(i * 7919 % (1000 * 1000 * 1000));
+		}
+
+		// 累加结果，防止被优化掉。
+		int64_t sum = 0;
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for (int64_t input : inputs)
+		{
+			sum += func(input);
+		}
+
+		std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+		std::chrono::nanoseconds elapsed = end - start;
+
+		std::cout << name << ": "
+				  << static_cast<double>(elapsed.count()) / _loop_count
+				  << " ns/次, 校验和: " << sum
+				  << std::endl;
+	}
+
+} // namespace
+
+void base::test::BenchmarkStaticUnit()
+{
+	std::cout << std::endl
+			  << CODE_POS_STR;
+
+	Run("base::unit::mWh -> base::unit::kWh",
+		[](int64_t i)
+		{
+			base::unit::mWh mwh{i};
+			base::unit::kWh kwh{mwh};
+			return static_cast<int64_t>(kwh);
+		});
+
+	Run("base::static_unit::mWh -> base::static_unit::kWh",
+		[](int64_t i)
+		{
+			base::static_unit::mWh mwh{i};
+			base::static_unit::kWh kwh = base::static_unit::static_unit_cast<base::static_unit::kWh>(mwh);
+			return kwh.Value();
+		});
+
+	// 输入小于 1e9, 直接当作纳秒的话换算结果都是 0, 校验和是常数，循环可以被优化掉。
+	// 乘上 1000003 后输入覆盖到 1e15, 换算结果随输入变化。
+	Run("base::unit::Nanosecond -> base::unit::Second",
+		[](int64_t i)
+		{
+			base::unit::Nanosecond ns{i * 1000003};
+			base::unit::Second s{ns};
+			return static_cast<int64_t>(s);
+		});
+
+	Run("base::static_unit::Nanosecond -> base::static_unit::Second",
+		[](int64_t i)
+		{
+			base::static_unit::Nanosecond ns{i * 1000003};
+			base::static_unit::Second s = base::static_unit::static_unit_cast<base::static_unit::Second>(ns);
+			return s.Value();
+		});
+
+	Run("base::static_unit::mWh -> double kWh",
+		[](int64_t i)
+		{
+			using double_kWh = base::static_unit::StaticUnit<base::static_unit::dimension::Energy,
+															   std::ratio<3600 * 1000>,
+															   double>;
+
+			base::static_unit::mWh mwh{i};
+			double_kWh kwh{mwh};
+			return static_cast<int64_t>(kwh.Value());
+		});
+}
+
+#endif // HAS_THREAD
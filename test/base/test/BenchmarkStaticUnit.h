@@ -0,0 +1,17 @@
+#pragma once
+
+#if HAS_THREAD
+
+namespace base
+{
+	namespace test
+	{
+		///
+		/// @brief 对比 base::unit 运行时单位和 base::static_unit 编译期单位的换算性能。
+		///
+		void BenchmarkStaticUnit();
+
+	} // namespace test
+} // namespace base
+
+#endif // HAS_THREAD
@@ -0,0 +1,130 @@
+#include "BenchmarkTinyExpr.h" // IWYU pragma: keep
+#include "base/math/tinyexpr.h"
+#include "base/string/define.h"
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if HAS_THREAD
+
+namespace
+{
+	constexpr int _sample_count = 1000 * 1000;
+
+	///
+	/// @brief 用 te_eval 和 te_bytecode_eval_block 分别对 _sample_count 组变量求值，
+	/// 检查结果一致并打印每个样本的平均耗时。
+	///
+	/// @param expression
+	///
+	void Run(std::string const &expression)
+	{
+		double x = 0;
+		double y = 0;
+		double t = 0;
+
+		te_variable variables[] = {
+			{"x", &x, TE_VARIABLE, nullptr},
+			{"y", &y, TE_VARIABLE, nullptr},
+			{"t", &t, TE_VARIABLE, nullptr},
+		};
+
+		int error = 0;
+		te_expr *expr = te_compile(expression.c_str(), variables, 3, &error);
+		if (expr == nullptr)
+		{
+			throw std::invalid_argument{CODE_POS_STR + "表达式语法错误，位置：" + std::to_string(error)};
+		}
+
+		te_bytecode *bytecode = te_bytecode_compile(expr, variables, 3);
+		if (bytecode == nullptr)
+		{
+			te_free(expr);
+			throw std::runtime_error{CODE_POS_STR + "te_bytecode_compile 失败。"};
+		}
+
+		std::vector<double> x_column(_sample_count);
+		std::vector<double> y_column(_sample_count);
+		std::vector<double> t_column(_sample_count);
+		for (int i = 0; i < _sample_count; i++)
+		{
+			x_column[i] = (i % 1000) * 0.01 - 5;
+			y_column[i] = (i % 777) * 0.02 + 0.5;
+			t_column[i] = i * 1e-6;
+		}
+
+		std::vector<double> tree_result(_sample_count);
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for (int i = 0; i < _sample_count; i++)
+		{
+			x = x_column[i];
+			y = y_column[i];
+			t = t_column[i];
+			tree_result[i] = te_eval(expr);
+		}
+
+		std::chrono::nanoseconds tree_elapsed = std::chrono::steady_clock::now() - start;
+
+		std::vector<double> bytecode_result(_sample_count);
+		double const *columns[] = {x_column.data(), y_column.data(), t_column.data()};
+		start = std::chrono::steady_clock::now();
+		te_bytecode_eval_block(bytecode, columns, bytecode_result.data(), _sample_count);
+		std::chrono::nanoseconds bytecode_elapsed = std::chrono::steady_clock::now() - start;
+
+		for (int i = 0; i < _sample_count; i++)
+		{
+			bool both_nan = std::isnan(tree_result[i]) && std::isnan(bytecode_result[i]);
+			if (!both_nan && tree_result[i] != bytecode_result[i])
+			{
+				te_bytecode_free(bytecode);
+				te_free(expr);
+				throw std::runtime_error{CODE_POS_STR + expression + " 在第 " + std::to_string(i) + " 个样本结果不一致。"};
+			}
+		}
+
+		// 单次求值从绑定的地址读取变量，应与 te_eval 相同。
+		x = 1.5;
+		y = 2.5;
+		t = 0.25;
+		double scalar = te_bytecode_eval(bytecode);
+		double tree_scalar = te_eval(expr);
+		if (scalar != tree_scalar && !(std::isnan(scalar) && std::isnan(tree_scalar)))
+		{
+			te_bytecode_free(bytecode);
+			te_free(expr);
+			throw std::runtime_error{CODE_POS_STR + expression + " 单次求值结果不一致。"};
+		}
+
+		std::cout << expression << std::endl
+				  << "\t" << "te_eval: "
+				  << static_cast<double>(tree_elapsed.count()) / _sample_count
+				  << " ns/样本" << std::endl
+				  << "\t" << "te_bytecode_eval_block: "
+				  << static_cast<double>(bytecode_elapsed.count()) / _sample_count
+				  << " ns/样本" << std::endl;
+
+		te_bytecode_free(bytecode);
+		te_free(expr);
+	}
+
+} // namespace
+
+void base::test::BenchmarkTinyExpr()
+{
+	std::cout << std::endl
+			  << CODE_POS_STR;
+
+	Run("x * 2 + 1");
+	Run("(x - y) * (x + y) / (1 + t * t)");
+	Run("abs(x) + sqrt(y) - -x");
+	Run("sin(x) * cos(y) + exp(-t)");
+	Run("pow(x, 2) + atan2(y, x), x * y");
+	Run("(x, x + 1) + 2 * x");
+	Run("3 * 4 + pi");
+}
+
+#endif // HAS_THREAD
@@ -0,0 +1,17 @@
+#pragma once
+
+#if HAS_THREAD
+
+namespace base
+{
+	namespace test
+	{
+		///
+		/// @brief 比较 te_eval 逐个样本遍历语法树与 te_bytecode_eval_block 分块求值的结果和耗时。
+		///
+		void BenchmarkTinyExpr();
+
+	} // namespace test
+} // namespace base
+
+#endif // HAS_THREAD
@@ -0,0 +1,244 @@
+#include "TestAesCipher.h" // IWYU pragma: keep
+#include "base/math/aes.h"
+#include "base/math/AesCipher.h"
+#include "base/string/define.h"
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if HAS_THREAD
+
+namespace
+{
+	std::vector<uint8_t> FromHex(std::string const &hex)
+	{
+		std::vector<uint8_t> ret;
+		for (size_t i = 0; i + 1 < hex.size(); i += 2)
+		{
+			ret.push_back(static_cast<uint8_t>(std::stoi(hex.substr(i, 2), nullptr, 16)));
+		}
+
+		return ret;
+	}
+
+	std::vector<uint8_t> CreateData(int64_t size)
+	{
+		std::vector<uint8_t> ret(size);
+		uint32_t x = 12345;
+		for (int64_t i = 0; i < size; i++)
+		{
+			x = x * 1103515245 + 12345;
+			ret[i] = static_cast<uint8_t>(x >> 16);
+		}
+
+		return ret;
+	}
+
+	///
+	/// @brief 用 FIPS-197 附录 C 的例子检验 ECB 加密和解密。
+	///
+	/// @param key
+	/// @param cipher_text
+	///
+	void TestFips197(std::string const &key, std::string const &cipher_text, bool allow_hardware)
+	{
+		std::vector<uint8_t> key_bytes = FromHex(key);
+		std::vector<uint8_t> plain = FromHex("00112233445566778899aabbccddeeff");
+		std::vector<uint8_t> expected = FromHex(cipher_text);
+
+		base::AesCipher aes{base::ReadOnlySpan{key_bytes.data(), static_cast<int64_t>(key_bytes.size())}, allow_hardware};
+		std::vector<uint8_t> buffer = plain;
+		aes.EncryptEcb(base::Span{buffer.data(), static_cast<int64_t>(buffer.size())});
+		if (buffer != expected)
+		{
+			throw std::runtime_error{CODE_POS_STR + "AES-" + std::to_string(key_bytes.size() * 8) + " 加密结果错误。"};
+		}
+
+		aes.DecryptEcb(base::Span{buffer.data(), static_cast<int64_t>(buffer.size())});
+		if (buffer != plain)
+		{
+			throw std::runtime_error{CODE_POS_STR + "AES-" + std::to_string(key_bytes.size() * 8) + " 解密结果错误。"};
+		}
+	}
+
+	///
+	/// @brief 与 aes.c 比较 ECB 和 CTR 的结果。
+	///
+	/// @param size 数据大小。CTR 模式下不必是 16 的整数倍。
+	/// @param allow_hardware
+	///
+	void CompareWithTinyAes(int64_t size, bool allow_hardware)
+	{
+		std::vector<uint8_t> key = CreateData(16);
+		std::vector<uint8_t> iv = FromHex("f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff");
+		base::AesCipher aes{base::ReadOnlySpan{key.data(), 16}, allow_hardware};
+
+		// ECB
+		{
+			int64_t ecb_size = size / 16 * 16;
+			std::vector<uint8_t> expected = CreateData(ecb_size);
+			AES_ctx ctx;
+			AES_init_ctx(&ctx, key.data());
+			for (int64_t i = 0; i < ecb_size; i += 16)
+			{
+				AES_ECB_encrypt(&ctx, expected.data() + i);
+			}
+
+			std::vector<uint8_t> buffer = CreateData(ecb_size);
+			aes.EncryptEcb(base::Span{buffer.data(), ecb_size});
+			if (buffer != expected)
+			{
+				throw std::runtime_error{CODE_POS_STR + "ECB 加密结果与 aes.c 不同，大小：" + std::to_string(ecb_size)};
+			}
+
+			aes.DecryptEcb(base::Span{buffer.data(), ecb_size});
+			if (buffer != CreateData(ecb_size))
+			{
+				throw std::runtime_error{CODE_POS_STR + "ECB 解密结果错误，大小：" + std::to_string(ecb_size)};
+			}
+		}
+
+		// CTR. 分两次调用，检验计数器的更新。
+		{
+			std::vector<uint8_t> expected = CreateData(size);
+			AES_ctx ctx;
+			AES_init_ctx_iv(&ctx, key.data(), iv.data());
+			int64_t first = size / 32 * 16;
+			AES_CTR_xcrypt_buffer(&ctx, expected.data(), first);
+			AES_CTR_xcrypt_buffer(&ctx, expected.data() + first, size - first);
+
+			std::vector<uint8_t> buffer = CreateData(size);
+			std::vector<uint8_t> counter = iv;
+			aes.XcryptCtr(base::Span{buffer.data(), first}, base::Span{counter.data(), 16});
+			aes.XcryptCtr(base::Span{buffer.data() + first, size - first}, base::Span{counter.data(), 16});
+			if (buffer != expected)
+			{
+				throw std::runtime_error{CODE_POS_STR + "CTR 结果与 aes.c 不同，大小：" + std::to_string(size)};
+			}
+
+			if (!std::equal(counter.begin(), counter.end(), ctx.Iv))
+			{
+				throw std::runtime_error{CODE_POS_STR + "CTR 计数器与 aes.c 不同，大小：" + std::to_string(size)};
+			}
+		}
+	}
+
+	template <typename TFunc>
+	void Run(std::string const &name, int64_t size, TFunc const &func)
+	{
+		constexpr int repeat = 20;
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for (int i = 0; i < repeat; i++)
+		{
+			func();
+		}
+
+		std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - start;
+		double seconds = static_cast<double>(elapsed.count()) / 1e9;
+		std::cout << name << ": " << static_cast<double>(size) * repeat / seconds / 1024 / 1024 << " MiB/s" << std::endl;
+	}
+
+} // namespace
+
+void base::test::TestAesCipher()
+{
+	{
+		std::cout << std::endl
+				  << CODE_POS_STR;
+
+		std::cout << "AES-NI: " << (base::AesCipher::IsAesNiSupported() ? "支持" : "不支持") << std::endl;
+
+		for (bool allow_hardware : {false, true})
+		{
+			TestFips197("000102030405060708090a0b0c0d0e0f",
+						"69c4e0d86a7b0430d8cdb78070b4c55a",
+						allow_hardware);
+
+			TestFips197("000102030405060708090a0b0c0d0e0f1011121314151617",
+						"dda97ca4864cdfe06eaf70a0ec0d7191",
+						allow_hardware);
+
+			TestFips197("000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f",
+						"8ea2b7ca516745bfeafc49904b496089",
+						allow_hardware);
+
+			// 覆盖不足一个分组、不足一批流水线、多批加上尾部等情况。
+			for (int64_t size : {0, 1, 15, 16, 17, 100, 128, 129, 512, 1000, 4096 + 7})
+			{
+				CompareWithTinyAes(size, allow_hardware);
+			}
+		}
+
+		// 计数器跨越 64 位边界时应向高位进位。
+		{
+			std::vector<uint8_t> key = CreateData(16);
+			std::vector<uint8_t> iv = FromHex("0000000000000000fffffffffffffffe");
+			std::vector<uint8_t> expected = CreateData(64);
+			AES_ctx ctx;
+			AES_init_ctx_iv(&ctx, key.data(), iv.data());
+			AES_CTR_xcrypt_buffer(&ctx, expected.data(), 64);
+
+			base::AesCipher aes{base::ReadOnlySpan{key.data(), 16}};
+			std::vector<uint8_t> buffer = CreateData(64);
+			aes.XcryptCtr(base::Span{buffer.data(), 64}, base::Span{iv.data(), 16});
+			if (buffer != expected)
+			{
+				throw std::runtime_error{CODE_POS_STR + "CTR 计数器进位错误。"};
+			}
+		}
+
+		std::cout << "已知答案测试通过。" << std::endl;
+	}
+
+	{
+		std::cout << std::endl
+				  << CODE_POS_STR;
+
+		constexpr int64_t size = 4 * 1024 * 1024;
+		std::vector<uint8_t> key = CreateData(16);
+		std::vector<uint8_t> buffer = CreateData(size);
+		std::vector<uint8_t> counter(16);
+
+		AES_ctx ctx;
+		AES_init_ctx_iv(&ctx, key.data(), counter.data());
+		Run("aes.c ECB", size,
+			[&]()
+			{
+				for (int64_t i = 0; i < size; i += 16)
+				{
+					AES_ECB_encrypt(&ctx, buffer.data() + i);
+				}
+			});
+
+		Run("aes.c CTR", size,
+			[&]()
+			{
+				AES_CTR_xcrypt_buffer(&ctx, buffer.data(), size);
+			});
+
+		for (bool allow_hardware : {false, true})
+		{
+			base::AesCipher aes{base::ReadOnlySpan{key.data(), 16}, allow_hardware};
+			std::string name = aes.UsesAesNi() ? "AES-NI" : "T 表";
+
+			Run(name + " ECB", size,
+				[&]()
+				{
+					aes.EncryptEcb(base::Span{buffer.data(), size});
+				});
+
+			Run(name + " CTR", size,
+				[&]()
+				{
+					aes.XcryptCtr(base::Span{buffer.data(), size}, base::Span{counter.data(), 16});
+				});
+		}
+
+		std::cout << "校验: " << static_cast<int>(buffer[0]) << std::endl;
+	}
+}
+
+#endif // HAS_THREAD
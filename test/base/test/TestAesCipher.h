@@ -0,0 +1,18 @@
+#pragma once
+
+#if HAS_THREAD
+
+namespace base
+{
+	namespace test
+	{
+		///
+		/// @brief 用 FIPS-197 的已知答案和 aes.c 的结果检验 base::AesCipher,
+		/// 并比较 aes.c, T 表, AES-NI 的吞吐量。
+		///
+		void TestAesCipher();
+
+	} // namespace test
+} // namespace base
+
+#endif // HAS_THREAD
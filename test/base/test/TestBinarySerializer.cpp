@@ -0,0 +1,476 @@
+#include "TestBinarySerializer.h" // IWYU pragma: keep
+#include "base/bit/AutoBitConverter.h"
+#include "base/bit/serialize/BinarySerializer.h"
+#include "base/bit/serialize/BinaryStreamSerializable.h"
+#include "base/bit/serialize/IStreamSerializable.h"
+#include "base/bit/serialize/StdStringStreamSerializer.h"
+#include "base/stream/MemoryStream.h"
+#include "base/stream/ReadOnlySpan.h"
+#include "base/stream/Span.h"
+#include "base/string/define.h"
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if HAS_THREAD
+
+namespace
+{
+	enum class Kind : uint8_t
+	{
+		Data = 1,
+		Alarm = 2,
+	};
+
+	struct Header
+	{
+		uint16_t _id = 0;
+		Kind _kind = Kind::Data;
+		bool _valid = false;
+		int32_t _value = 0;
+		float _gain = 0;
+		double _offset = 0;
+		std::array<uint16_t, 4> _registers{};
+
+		static constexpr auto BinaryFields()
+		{
+			return base::BinaryFieldList<&Header::_id,
+										 &Header::_kind,
+										 &Header::_valid,
+										 &Header::_value,
+										 &Header::_gain,
+										 &Header::_offset,
+										 &Header::_registers>{};
+		}
+
+		bool operator==(Header const &other) const = default;
+	};
+
+	struct Record
+	{
+		Header _header;
+		std::string _name;
+		std::vector<int32_t> _samples;
+		std::vector<Header> _history;
+		std::vector<std::string> _tags;
+
+		static constexpr auto BinaryFields()
+		{
+			return base::BinaryFieldList<&Record::_header,
+										 &Record::_name,
+										 &Record::_samples,
+										 &Record::_history,
+										 &Record::_tags>{};
+		}
+
+		bool operator==(Record const &other) const = default;
+	};
+
+	///
+	/// @brief 与 Record 的格式相同，字符串和样本用视图读取。
+	///
+	struct RecordView
+	{
+		Header _header;
+		std::string_view _name;
+		base::ReadOnlySpan _samples;
+
+		static constexpr auto BinaryFields()
+		{
+			return base::BinaryFieldList<&RecordView::_header,
+										 &RecordView::_name,
+										 &RecordView::_samples>{};
+		}
+	};
+
+	class SerializableHeader :
+		public base::BinaryStreamSerializable<SerializableHeader, std::endian::big>
+	{
+	public:
+		Header _header;
+		std::string _comment;
+
+		static constexpr auto BinaryFields()
+		{
+			return base::BinaryFieldList<&SerializableHeader::_header, &SerializableHeader::_comment>{};
+		}
+	};
+
+	static_assert(base::BinarySerializer<Header>::IsFixedSize);
+	static_assert(base::BinarySerializer<Header>::FixedSize == 2 + 1 + 1 + 4 + 4 + 8 + 2 * 4);
+	static_assert(!base::BinarySerializer<Record>::IsFixedSize);
+
+	Header MakeHeader(int32_t i)
+	{
+		Header header;
+		header._id = static_cast<uint16_t>(0x1234 + i);
+		header._kind = i % 2 == 0 ? Kind::Data : Kind::Alarm;
+		header._valid = i % 3 == 0;
+		header._value = -123456 * (i % 10000);
+		header._gain = 1.5f * static_cast<float>(i);
+		header._offset = -0.25 * i;
+		header._registers = {static_cast<uint16_t>(i), 0xABCD, 0, 0xFFFF};
+		return header;
+	}
+
+	Record MakeRecord()
+	{
+		Record record;
+		record._header = MakeHeader(7);
+		record._name = "通道 1";
+		for (int32_t i = 0; i < 100; i++)
+		{
+			record._samples.push_back(i * 1000 - 50000);
+		}
+
+		record._history = {MakeHeader(1), MakeHeader(2), MakeHeader(3)};
+		record._tags = {"a", "", "long tag"};
+		return record;
+	}
+
+	///
+	/// @brief 原来的做法：每个字段调用一次 AutoBitConverter::GetBytes 写流。
+	///
+	/// @param header
+	/// @param stream
+	///
+	void WriteFieldByField(Header const &header, base::Stream &stream)
+	{
+		base::AutoBitConverter const &converter = base::big_endian_remote_converter;
+		converter.GetBytes(header._id, stream);
+		converter.GetBytes(static_cast<uint8_t>(header._kind), stream);
+		converter.GetBytes(static_cast<uint8_t>(header._valid ? 1 : 0), stream);
+		converter.GetBytes(header._value, stream);
+		converter.GetBytes(header._gain, stream);
+		converter.GetBytes(header._offset, stream);
+		for (uint16_t value : header._registers)
+		{
+			converter.GetBytes(value, stream);
+		}
+	}
+
+	template <std::endian Endian>
+	void CheckRoundTrip()
+	{
+		using serializer = base::BinarySerializer<Record, Endian>;
+
+		Record record = MakeRecord();
+		std::vector<uint8_t> buffer(static_cast<size_t>(serializer::SerializedSize(record)));
+		base::Span span{buffer.data(), static_cast<int64_t>(buffer.size())};
+		if (serializer::Serialize(record, span) != span.Size())
+		{
+			throw std::runtime_error{CODE_POS_STR + "写入的字节数错误。"};
+		}
+
+		Record from_span;
+		if (serializer::Deserialize(span, from_span) != span.Size())
+		{
+			throw std::runtime_error{CODE_POS_STR + "消耗的字节数错误。"};
+		}
+
+		if (from_span != record)
+		{
+			throw std::runtime_error{CODE_POS_STR + "从 span 往返的结果错误。"};
+		}
+
+		base::MemoryStream stream{static_cast<int64_t>(buffer.size())};
+		serializer::Serialize(record, stream);
+		if (stream.Length() != span.Size())
+		{
+			throw std::runtime_error{CODE_POS_STR + "写入流的字节数错误。"};
+		}
+
+		stream.SetPosition(0);
+
+		Record from_stream;
+		serializer::Deserialize(stream, from_stream);
+		if (from_stream != record)
+		{
+			throw std::runtime_error{CODE_POS_STR + "从流往返的结果错误。"};
+		}
+
+		// 零拷贝读取。
+		// RecordView 的样本是字节视图，所以用 uint8_t 的样本写入。
+		struct RecordBytes
+		{
+			Header _header;
+			std::string _name;
+			std::vector<uint8_t> _samples;
+
+			static constexpr auto BinaryFields()
+			{
+				return base::BinaryFieldList<&RecordBytes::_header,
+											 &RecordBytes::_name,
+											 &RecordBytes::_samples>{};
+			}
+		};
+
+		RecordBytes bytes{MakeHeader(3), "view", {1, 2, 3, 4, 5}};
+		std::vector<uint8_t> bytes_buffer(static_cast<size_t>(base::BinarySerializer<RecordBytes, Endian>::SerializedSize(bytes)));
+		base::Span bytes_span{bytes_buffer.data(), static_cast<int64_t>(bytes_buffer.size())};
+		base::BinarySerializer<RecordBytes, Endian>::Serialize(bytes, bytes_span);
+
+		RecordView view;
+		base::BinarySerializer<RecordView, Endian>::Deserialize(bytes_span, view);
+		if (!(view._header == bytes._header && view._name == "view"))
+		{
+			throw std::runtime_error{CODE_POS_STR + "视图读取的结果错误。"};
+		}
+
+		if (!(view._samples.Size() == 5 && view._samples[4] == 5))
+		{
+			throw std::runtime_error{CODE_POS_STR + "字节视图的结果错误。"};
+		}
+
+		uint8_t const *first = bytes_buffer.data();
+		uint8_t const *last = first + bytes_buffer.size();
+		uint8_t const *name = reinterpret_cast<uint8_t const *>(view._name.data());
+		if (!(name >= first && name < last && view._samples.Buffer() > name && view._samples.Buffer() < last))
+		{
+			throw std::runtime_error{CODE_POS_STR + "视图应该指向输入缓冲区。"};
+		}
+	}
+
+} // namespace
+
+void base::test::TestBinarySerializer()
+{
+	std::cout << std::endl
+			  << CODE_POS_STR;
+
+	// 布局与逐字段写入相同。
+	{
+		Header header = MakeHeader(5);
+
+		base::MemoryStream expected{1024};
+		WriteFieldByField(header, expected);
+
+		base::MemoryStream actual{1024};
+		base::BinarySerializer<Header, std::endian::big>::Serialize(header, actual);
+
+		if (expected.Length() != actual.Length())
+		{
+			throw std::runtime_error{CODE_POS_STR + "字节数与逐字段写入不同。"};
+		}
+
+		for (int64_t i = 0; i < expected.Length(); i++)
+		{
+			if (expected.Span()[i] != actual.Span()[i])
+			{
+				throw std::runtime_error{CODE_POS_STR + "字节与逐字段写入不同。"};
+			}
+		}
+
+		// std::string 的格式与 StdStringStreamSerializer 相同。
+		struct Text
+		{
+			std::string _text;
+
+			static constexpr auto BinaryFields()
+			{
+				return base::BinaryFieldList<&Text::_text>{};
+			}
+		};
+
+		std::string text = "hello";
+		base::MemoryStream std_string_stream{1024};
+		base::StdStringStreamSerializer{text}.SerializeIntoStream(std_string_stream);
+
+		base::MemoryStream text_stream{1024};
+		base::BinarySerializer<Text>::Serialize(Text{text}, text_stream);
+		if (std_string_stream.Length() != text_stream.Length())
+		{
+			throw std::runtime_error{CODE_POS_STR + "与 StdStringStreamSerializer 的长度不同。"};
+		}
+
+		for (int64_t i = 0; i < text_stream.Length(); i++)
+		{
+			if (std_string_stream.Span()[i] != text_stream.Span()[i])
+			{
+				throw std::runtime_error{CODE_POS_STR + "与 StdStringStreamSerializer 的字节不同。"};
+			}
+		}
+
+		std::cout << "布局正确。" << std::endl;
+	}
+
+	// 往返。
+	{
+		CheckRoundTrip<std::endian::little>();
+		CheckRoundTrip<std::endian::big>();
+
+		SerializableHeader source;
+		source._header = MakeHeader(9);
+		source._comment = "comment";
+
+		base::MemoryStream stream{1024};
+		base::IStreamSerializable const &serializable = source;
+		serializable.SerializeIntoStream(stream);
+		stream.SetPosition(0);
+
+		SerializableHeader destination;
+		destination.DeserializeFromStream(stream);
+		if (!(destination._header == source._header && destination._comment == source._comment))
+		{
+			throw std::runtime_error{CODE_POS_STR + "BinaryStreamSerializable 往返的结果错误。"};
+		}
+
+		std::cout << "往返和零拷贝读取正确。" << std::endl;
+	}
+
+	// 错误的输入。
+	{
+		Record record = MakeRecord();
+		std::vector<uint8_t> buffer(static_cast<size_t>(base::BinarySerializer<Record>::SerializedSize(record)));
+		base::Span span{buffer.data(), static_cast<int64_t>(buffer.size())};
+		base::BinarySerializer<Record>::Serialize(record, span);
+
+		for (int64_t size : {int64_t{0}, int64_t{10}, span.Size() / 2, span.Size() - 1})
+		{
+			bool thrown = false;
+			try
+			{
+				Record truncated;
+				base::BinarySerializer<Record>::Deserialize(base::ReadOnlySpan{buffer.data(), size}, truncated);
+			}
+			catch (base::StreamDeserializeException const &)
+			{
+				thrown = true;
+			}
+
+			if (!thrown)
+			{
+				throw std::runtime_error{CODE_POS_STR + "截断的输入应该抛出异常。"};
+			}
+		}
+
+		{
+			bool thrown = false;
+			base::MemoryStream stream{span.Size()};
+			stream.Write(base::ReadOnlySpan{buffer.data(), span.Size() / 2});
+			stream.SetPosition(0);
+			try
+			{
+				Record truncated;
+				base::BinarySerializer<Record>::Deserialize(stream, truncated);
+			}
+			catch (base::StreamDeserializeException const &)
+			{
+				thrown = true;
+			}
+
+			if (!thrown)
+			{
+				throw std::runtime_error{CODE_POS_STR + "提前结束的流应该抛出异常。"};
+			}
+		}
+
+		// 把名字的长度改成很大的值。
+		int64_t header_size = base::BinarySerializer<Header>::FixedSize;
+		buffer[static_cast<size_t>(header_size) + 7] = 0x7f;
+		bool thrown = false;
+		try
+		{
+			Record corrupted;
+			base::BinarySerializer<Record>::Deserialize(span, corrupted);
+		}
+		catch (base::StreamDeserializeException const &)
+		{
+			thrown = true;
+		}
+
+		if (!thrown)
+		{
+			throw std::runtime_error{CODE_POS_STR + "长度超出输入时应该抛出异常。"};
+		}
+
+		thrown = false;
+		try
+		{
+			uint8_t small[8];
+			base::BinarySerializer<Record>::Serialize(record, base::Span{small, sizeof(small)});
+		}
+		catch (base::StreamSerializeException const &)
+		{
+			thrown = true;
+		}
+
+		if (!thrown)
+		{
+			throw std::runtime_error{CODE_POS_STR + "span 太小时应该抛出异常。"};
+		}
+
+		std::cout << "错误的输入被拒绝。" << std::endl;
+	}
+
+	// 速度。
+	{
+		constexpr int64_t count = 1000000;
+		std::vector<Header> headers;
+		for (int64_t i = 0; i < count; i++)
+		{
+			headers.push_back(MakeHeader(static_cast<int32_t>(i)));
+		}
+
+		int64_t total_size = count * base::BinarySerializer<Header>::FixedSize;
+		base::MemoryStream stream{total_size};
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for (Header const &header : headers)
+		{
+			WriteFieldByField(header, stream);
+		}
+
+		std::chrono::duration<double> field_elapsed = std::chrono::steady_clock::now() - start;
+
+		stream.SetLength(0);
+		start = std::chrono::steady_clock::now();
+		for (Header const &header : headers)
+		{
+			base::BinarySerializer<Header, std::endian::big>::Serialize(header, stream);
+		}
+
+		std::chrono::duration<double> stream_elapsed = std::chrono::steady_clock::now() - start;
+
+		std::vector<uint8_t> buffer(static_cast<size_t>(total_size));
+		start = std::chrono::steady_clock::now();
+		base::Span remain{buffer.data(), total_size};
+		for (Header const &header : headers)
+		{
+			int64_t size = base::BinarySerializer<Header, std::endian::big>::Serialize(header, remain);
+			remain = base::Span{remain.Buffer() + size, remain.Size() - size};
+		}
+
+		std::chrono::duration<double> span_elapsed = std::chrono::steady_clock::now() - start;
+
+		start = std::chrono::steady_clock::now();
+		base::ReadOnlySpan input{buffer.data(), total_size};
+		int64_t checksum = 0;
+		for (int64_t i = 0; i < count; i++)
+		{
+			Header header;
+			int64_t size = base::BinarySerializer<Header, std::endian::big>::Deserialize(input, header);
+			input = base::ReadOnlySpan{input.Buffer() + size, input.Size() - size};
+			checksum += header._value;
+		}
+
+		std::chrono::duration<double> read_elapsed = std::chrono::steady_clock::now() - start;
+		if (!(checksum != 0 && input.Size() == 0))
+		{
+			throw std::runtime_error{CODE_POS_STR + "读取的结果错误。"};
+		}
+
+		std::cout << "逐字段写流: " << count / field_elapsed.count() / 1e6 << " M/s, "
+				  << "BinarySerializer 写流: " << count / stream_elapsed.count() / 1e6 << " M/s, "
+				  << "写 span: " << count / span_elapsed.count() / 1e6 << " M/s, "
+				  << "读 span: " << count / read_elapsed.count() / 1e6 << " M/s" << std::endl;
+	}
+}
+
+#endif // HAS_THREAD
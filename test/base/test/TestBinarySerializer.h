@@ -0,0 +1,17 @@
+#pragma once
+
+#if HAS_THREAD
+
+namespace base
+{
+	namespace test
+	{
+		///
+		/// @brief 检查字段列表序列化的布局、往返、零拷贝读取和错误处理，与逐字段写流比较速度。
+		///
+		void TestBinarySerializer();
+
+	} // namespace test
+} // namespace base
+
+#endif // HAS_THREAD
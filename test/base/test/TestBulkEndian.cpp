@@ -0,0 +1,310 @@
+#include "TestBulkEndian.h" // IWYU pragma: keep
+#include "base/bit/AutoBitConverter.h"
+#include "base/bit/bit_converte.h"
+#include "base/container/ArraySpan.h"
+#include "base/container/ReadOnlyArraySpan.h"
+#include "base/math/Xoshiro256PlusPlus.h"
+#include "base/stream/PayloadReader.h"
+#include "base/stream/PayloadWriter.h"
+#include "base/stream/ReadOnlySpan.h"
+#include "base/stream/Span.h"
+#include "base/string/define.h"
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if HAS_THREAD
+
+namespace
+{
+	std::vector<uint8_t> RandomBytes(int64_t size, uint64_t seed)
+	{
+		base::Xoshiro256PlusPlus generator{seed};
+		std::vector<uint8_t> bytes(size);
+		for (uint8_t &byte : bytes)
+		{
+			byte = static_cast<uint8_t>(generator());
+		}
+
+		return bytes;
+	}
+
+	///
+	/// @brief 逐个元素翻转，作为对照。
+	///
+	std::vector<uint8_t> NaiveReverse(std::vector<uint8_t> const &bytes, int element_size)
+	{
+		std::vector<uint8_t> result = bytes;
+		for (size_t i = 0; i < result.size(); i += element_size)
+		{
+			std::reverse(result.begin() + i, result.begin() + i + element_size);
+		}
+
+		return result;
+	}
+
+	///
+	/// @brief 批量转换与逐个转换的结果相同。
+	///
+	template <typename ValueType>
+	void CheckConverter(base::AutoBitConverter const &converter, int64_t count)
+	{
+		std::vector<uint8_t> bytes = RandomBytes(count * static_cast<int64_t>(sizeof(ValueType)), count);
+		base::ReadOnlySpan byte_span{bytes.data(), static_cast<int64_t>(bytes.size())};
+
+		std::vector<ValueType> values(count);
+		converter.FromBytes(byte_span, base::ArraySpan<ValueType>{values.data(), count});
+
+		for (int64_t i = 0; i < count; i++)
+		{
+			ValueType expected = converter.FromBytes<ValueType>(
+				byte_span[base::Range{i * static_cast<int64_t>(sizeof(ValueType)), (i + 1) * static_cast<int64_t>(sizeof(ValueType))}]);
+
+			// 浮点数可能是 NaN, 按字节比较。
+			if (std::memcmp(&expected, &values[i], sizeof(ValueType)) != 0)
+			{
+				throw std::runtime_error{CODE_POS_STR + "批量 FromBytes 的结果与逐个转换不同。"};
+			}
+		}
+
+		std::vector<uint8_t> round_trip(bytes.size());
+		converter.GetBytes(base::ReadOnlyArraySpan<ValueType>{values.data(), count},
+						   base::Span{round_trip.data(), static_cast<int64_t>(round_trip.size())});
+
+		if (round_trip != bytes)
+		{
+			throw std::runtime_error{CODE_POS_STR + "批量 GetBytes 没有还原出原来的字节。"};
+		}
+	}
+
+} // namespace
+
+void base::test::TestBulkEndian()
+{
+	std::cout << std::endl
+			  << CODE_POS_STR;
+
+	// 各种元素大小、长度和不对齐的起始位置。
+	{
+		for (int element_size : {1, 2, 4, 8})
+		{
+			for (int64_t count = 0; count <= 80; count++)
+			{
+				for (int64_t offset = 0; offset < 3; offset++)
+				{
+					std::vector<uint8_t> bytes = RandomBytes(count * element_size + offset, count * 31 + offset);
+					std::vector<uint8_t> source{bytes.begin() + offset, bytes.end()};
+					std::vector<uint8_t> expected = NaiveReverse(source, element_size);
+
+					std::vector<uint8_t> destination(bytes.size());
+					base::bit_converte::ReverseEachElement(base::ReadOnlySpan{bytes.data() + offset, count * element_size},
+														   base::Span{destination.data() + offset, count * element_size},
+														   element_size);
+
+					if (std::vector<uint8_t>(destination.begin() + offset, destination.end()) != expected)
+					{
+						throw std::runtime_error{CODE_POS_STR + "ReverseEachElement 的结果错误。"};
+					}
+
+					// 原地翻转。
+					base::bit_converte::ReverseEachElement(base::ReadOnlySpan{bytes.data() + offset, count * element_size},
+														   base::Span{bytes.data() + offset, count * element_size},
+														   element_size);
+
+					if (std::vector<uint8_t>(bytes.begin() + offset, bytes.end()) != expected)
+					{
+						throw std::runtime_error{CODE_POS_STR + "原地 ReverseEachElement 的结果错误。"};
+					}
+				}
+			}
+		}
+
+		std::vector<uint8_t> bytes(12);
+		base::Span span{bytes.data(), static_cast<int64_t>(bytes.size())};
+		for (int element_size : {3, 8})
+		{
+			bool thrown = false;
+			try
+			{
+				base::bit_converte::ReverseEachElement(span, span, element_size);
+			}
+			catch (std::invalid_argument const &)
+			{
+				thrown = true;
+			}
+
+			if (!thrown)
+			{
+				throw std::runtime_error{CODE_POS_STR + "元素大小不合法时应该抛出异常。"};
+			}
+		}
+
+		std::cout << "ReverseEachElement 与逐个翻转的结果相同。" << std::endl;
+	}
+
+	// AutoBitConverter 的批量转换。
+	{
+		for (base::AutoBitConverter const &converter : {base::big_endian_remote_converter,
+														base::little_endian_remote_converter})
+		{
+			for (int64_t count : {0, 1, 7, 33, 125, 1000})
+			{
+				CheckConverter<uint16_t>(converter, count);
+				CheckConverter<int32_t>(converter, count);
+				CheckConverter<uint64_t>(converter, count);
+				CheckConverter<float>(converter, count);
+				CheckConverter<double>(converter, count);
+			}
+		}
+
+		std::vector<uint16_t> values(4);
+		std::vector<uint8_t> bytes(7);
+		bool thrown = false;
+		try
+		{
+			base::big_endian_remote_converter.FromBytes(base::ReadOnlySpan{bytes.data(), 7},
+														base::ArraySpan<uint16_t>{values.data(), 4});
+		}
+		catch (std::invalid_argument const &)
+		{
+			thrown = true;
+		}
+
+		if (!thrown)
+		{
+			throw std::runtime_error{CODE_POS_STR + "span 大小与数组不符时应该抛出异常。"};
+		}
+
+		std::cout << "AutoBitConverter 批量转换与逐个转换的结果相同。" << std::endl;
+	}
+
+	// PayloadReader, PayloadWriter 的数组读写。
+	{
+		std::vector<uint16_t> registers(125);
+		for (size_t i = 0; i < registers.size(); i++)
+		{
+			registers[i] = static_cast<uint16_t>(i * 517 + 3);
+		}
+
+		std::vector<uint8_t> buffer(1 + 125 * 2 + 8);
+		base::PayloadWriter writer{base::Span{buffer.data(), static_cast<int64_t>(buffer.size())}};
+		writer.WritePayload<uint8_t>(250, std::endian::big);
+		writer.WritePayload(base::ArraySpan<uint16_t>{registers.data(), 125}, std::endian::big);
+		writer.WritePayload(1.5, std::endian::big);
+		if (writer.Position() != static_cast<int64_t>(buffer.size()))
+		{
+			throw std::runtime_error{CODE_POS_STR + "PayloadWriter 的位置错误。"};
+		}
+
+		if (!(buffer[1] == 0 && buffer[2] == 3 && buffer[3] == 0x02 && buffer[4] == 0x08))
+		{
+			throw std::runtime_error{CODE_POS_STR + "寄存器没有按大端写入。"};
+		}
+
+		base::PayloadReader reader{base::ReadOnlySpan{buffer.data(), static_cast<int64_t>(buffer.size())}};
+		if (reader.ReadPayload<uint8_t>(std::endian::big) != 250)
+		{
+			throw std::runtime_error{CODE_POS_STR + "读取字节数错误。"};
+		}
+
+		std::vector<uint16_t> read_registers(125);
+		reader.ReadPayload(base::ArraySpan<uint16_t>{read_registers.data(), 125}, std::endian::big);
+		if (read_registers != registers)
+		{
+			throw std::runtime_error{CODE_POS_STR + "批量读取的寄存器错误。"};
+		}
+
+		if (reader.ReadPayload<double>(std::endian::big) != 1.5)
+		{
+			throw std::runtime_error{CODE_POS_STR + "数组后面的数据读取错误。"};
+		}
+
+		bool thrown = false;
+		try
+		{
+			reader.ResetPosition();
+			std::vector<uint16_t> too_many(200);
+			reader.ReadPayload(base::ArraySpan<uint16_t>{too_many.data(), 200}, std::endian::big);
+		}
+		catch (std::exception const &)
+		{
+			thrown = true;
+		}
+
+		if (!thrown)
+		{
+			throw std::runtime_error{CODE_POS_STR + "读取超出载荷的数组应该抛出异常。"};
+		}
+
+		std::cout << "PayloadReader, PayloadWriter 的数组读写正确。" << std::endl;
+	}
+
+	// 速度。
+	{
+		constexpr int64_t register_count = 125;
+		constexpr int64_t repeat = 200000;
+		std::vector<uint8_t> frame = RandomBytes(register_count * 2, 1);
+		base::ReadOnlySpan frame_span{frame.data(), static_cast<int64_t>(frame.size())};
+		std::vector<uint16_t> registers(register_count);
+		uint64_t sum = 0;
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for (int64_t i = 0; i < repeat; i++)
+		{
+			base::PayloadReader reader{frame_span};
+			for (int64_t j = 0; j < register_count; j++)
+			{
+				registers[j] = reader.ReadPayload<uint16_t>(std::endian::big);
+			}
+
+			sum += registers[i % register_count];
+		}
+
+		std::chrono::duration<double> single_elapsed = std::chrono::steady_clock::now() - start;
+
+		start = std::chrono::steady_clock::now();
+		for (int64_t i = 0; i < repeat; i++)
+		{
+			base::PayloadReader reader{frame_span};
+			reader.ReadPayload(base::ArraySpan<uint16_t>{registers.data(), register_count}, std::endian::big);
+			sum += registers[i % register_count];
+		}
+
+		std::chrono::duration<double> bulk_elapsed = std::chrono::steady_clock::now() - start;
+
+		std::cout << "读 125 个寄存器：逐个 " << single_elapsed.count() / repeat * 1e9 << " ns, "
+				  << "批量 " << bulk_elapsed.count() / repeat * 1e9 << " ns" << std::endl;
+
+		constexpr int64_t sample_count = 1024 * 1024;
+		std::vector<uint8_t> samples = RandomBytes(sample_count * 8, 2);
+		base::ReadOnlySpan sample_span{samples.data(), static_cast<int64_t>(samples.size())};
+		std::vector<double> values(sample_count);
+
+		start = std::chrono::steady_clock::now();
+		for (int64_t j = 0; j < sample_count; j++)
+		{
+			values[j] = base::big_endian_remote_converter.FromBytes<double>(sample_span[base::Range{j * 8, j * 8 + 8}]);
+		}
+
+		single_elapsed = std::chrono::steady_clock::now() - start;
+		sum += static_cast<uint64_t>(values[sum % sample_count] != 0);
+
+		start = std::chrono::steady_clock::now();
+		base::big_endian_remote_converter.FromBytes(sample_span, base::ArraySpan<double>{values.data(), sample_count});
+		bulk_elapsed = std::chrono::steady_clock::now() - start;
+		sum += static_cast<uint64_t>(values[sum % sample_count] != 0);
+
+		std::cout << "转换 8 MB 大端 double: 逐个 " << samples.size() / single_elapsed.count() / 1e9 << " GB/s, "
+				  << "批量 " << samples.size() / bulk_elapsed.count() / 1e9 << " GB/s" << std::endl;
+
+		std::cout << "校验和 " << sum << std::endl;
+	}
+}
+
+#endif // HAS_THREAD
@@ -0,0 +1,17 @@
+#pragma once
+
+#if HAS_THREAD
+
+namespace base
+{
+	namespace test
+	{
+		///
+		/// @brief 检查数组的批量字节序转换与逐个转换的结果一致，比较两者的速度。
+		///
+		void TestBulkEndian();
+
+	} // namespace test
+} // namespace base
+
+#endif // HAS_THREAD
@@ -0,0 +1,412 @@
+#include "TestCbor.h" // IWYU pragma: keep
+#include "TestHelper.h"
+#include "base/math/Xoshiro256PlusPlus.h"
+#include "base/net/ethernet/EthernetFrameReader.h"
+#include "base/stream/MemoryStream.h"
+#include "base/stream/ReadOnlySpan.h"
+#include "base/string/CborWriter.h"
+#include "base/string/define.h"
+#include "base/string/IJsonWriter.h"
+#include "base/string/Json.h"
+#include "base/string/JsonFieldBinder.h"
+#include "base/string/JsonWriter.h"
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if HAS_THREAD
+
+namespace
+{
+	class Channel :
+		public base::IJsonSerializable,
+		public base::IJsonStreamDeserializable
+	{
+	public:
+		int32_t _id = 0;
+		bool _enabled = false;
+		double _gain = 0;
+
+		virtual base::Json ToJson() const override
+		{
+			return base::Json{
+				{"id", _id},
+				{"enabled", _enabled},
+				{"gain", _gain},
+			};
+		}
+
+		virtual void WriteJson(base::IJsonWriter &writer) const override
+		{
+			writer.StartObject();
+			writer.Property("id", _id);
+			writer.Property("enabled", _enabled);
+			writer.Property("gain", _gain);
+			writer.EndObject();
+		}
+
+		virtual void DeclareJsonFields(base::JsonFieldBinder &binder) override
+		{
+			binder.Field("id", _id);
+			binder.Field("enabled", _enabled);
+			binder.Field("gain", _gain);
+		}
+
+		bool operator==(Channel const &other) const
+		{
+			return _id == other._id && _enabled == other._enabled && _gain == other._gain;
+		}
+	};
+
+	///
+	/// @brief 诊断快照。
+	///
+	class Snapshot :
+		public base::IJsonSerializable,
+		public base::IJsonStreamDeserializable
+	{
+	public:
+		uint64_t _timestamp = 0;
+		std::string _source;
+		std::vector<int64_t> _counters;
+		std::vector<Channel> _channels;
+
+		virtual base::Json ToJson() const override
+		{
+			base::Json channels = base::Json::array();
+			for (Channel const &channel : _channels)
+			{
+				channels.push_back(channel.ToJson());
+			}
+
+			return base::Json{
+				{"timestamp", _timestamp},
+				{"source", _source},
+				{"counters", _counters},
+				{"channels", channels},
+			};
+		}
+
+		virtual void WriteJson(base::IJsonWriter &writer) const override
+		{
+			writer.StartObject();
+			writer.Property("timestamp", _timestamp);
+			writer.Property("source", _source);
+
+			writer.Key("counters");
+			writer.StartArray();
+			for (int64_t counter : _counters)
+			{
+				writer.Value(counter);
+			}
+
+			writer.EndArray();
+
+			writer.Key("channels");
+			writer.StartArray();
+			for (Channel const &channel : _channels)
+			{
+				writer.Value(channel);
+			}
+
+			writer.EndArray();
+			writer.EndObject();
+		}
+
+		virtual void DeclareJsonFields(base::JsonFieldBinder &binder) override
+		{
+			binder.Field("timestamp", _timestamp);
+			binder.Field("source", _source);
+			binder.Field("counters", _counters);
+			binder.Field("channels", _channels);
+		}
+
+		bool operator==(Snapshot const &other) const
+		{
+			return _timestamp == other._timestamp &&
+				   _source == other._source &&
+				   _counters == other._counters &&
+				   _channels == other._channels;
+		}
+	};
+
+	Snapshot GenerateSnapshot(int64_t channel_count)
+	{
+		base::Xoshiro256PlusPlus generator{1};
+		Snapshot snapshot;
+		snapshot._timestamp = 1700000000123456789ULL;
+		snapshot._source = "eth0 诊断";
+		snapshot._counters = {0, 23, 24, 255, 256, 65535, 65536, -1, -24, -25, -4294967297LL,
+							  INT64_MIN, INT64_MAX};
+
+		for (int64_t i = 0; i < channel_count; i++)
+		{
+			Channel channel;
+			channel._id = static_cast<int32_t>(i);
+			channel._enabled = generator() % 2 == 0;
+			channel._gain = static_cast<double>(generator() % 100000) / 128;
+			snapshot._channels.push_back(channel);
+		}
+
+		return snapshot;
+	}
+
+	base::ReadOnlySpan WrittenSpan(base::MemoryStream const &stream)
+	{
+		return base::ReadOnlySpan{stream.Span().Buffer(), stream.Length()};
+	}
+
+	std::vector<uint8_t> WriteCbor(base::Json const &json)
+	{
+		base::MemoryStream stream{1024 * 1024};
+		base::CborWriter writer{stream};
+		writer.Value(json);
+		base::ReadOnlySpan span = WrittenSpan(stream);
+		return std::vector<uint8_t>(span.Buffer(), span.Buffer() + span.Size());
+	}
+
+} // namespace
+
+void base::test::TestCbor()
+{
+	std::cout << std::endl
+			  << CODE_POS_STR;
+
+	// nlohmann::json 能读回 CborWriter 的输出。
+	{
+		base::Json json = base::Json::parse(R"({
+			"string": "a\"b\\c 中文",
+			"long_string": "0123456789012345678901234567890123456789",
+			"integers": [0, 23, 24, 255, 256, 65535, 65536, 4294967295, 4294967296, -1, -24, -25, -257,
+						 9223372036854775807, -9223372036854775808, 18446744073709551615],
+			"floats": [0.0, 1.0, -2.5, 0.1, 1e300, 5e-324, 3.4028234663852886e38],
+			"empty_object": {},
+			"empty_array": [],
+			"nested": {"a": [true, false, null, {"b": []}]}
+		})");
+
+		std::vector<uint8_t> cbor = WriteCbor(json);
+		if (base::Json::from_cbor(cbor) != json)
+		{
+			throw std::runtime_error{CODE_POS_STR + "from_cbor 读回的结果与原来的不同。"};
+		}
+
+		// 浮点数的编码长度与 to_cbor 相同。
+		if (WriteCbor(base::Json(0.5)) != base::Json::to_cbor(base::Json(0.5)))
+		{
+			throw std::runtime_error{CODE_POS_STR + "0.5 应该编码为 float."};
+		}
+
+		if (WriteCbor(base::Json(0.1)) != base::Json::to_cbor(base::Json(0.1)))
+		{
+			throw std::runtime_error{CODE_POS_STR + "0.1 应该编码为 double."};
+		}
+
+		if (WriteCbor(base::Json(-25)) != base::Json::to_cbor(base::Json(-25)))
+		{
+			throw std::runtime_error{CODE_POS_STR + "负整数编码错误。"};
+		}
+
+		if (WriteCbor(base::Json("abc")) != base::Json::to_cbor(base::Json("abc")))
+		{
+			throw std::runtime_error{CODE_POS_STR + "字符串编码错误。"};
+		}
+
+		base::MemoryStream stream{1024};
+		base::CborWriter writer{stream};
+		writer.StartObject();
+		bool thrown = false;
+		try
+		{
+			writer.Value(1);
+		}
+		catch (std::runtime_error const &)
+		{
+			thrown = true;
+		}
+
+		if (!thrown)
+		{
+			throw std::runtime_error{CODE_POS_STR + "对象中没有键的值应该抛出异常。"};
+		}
+
+		std::cout << "CborWriter 的输出能被 from_cbor 读回。" << std::endl;
+	}
+
+	// 流式反序列化 CBOR.
+	{
+		Snapshot snapshot = GenerateSnapshot(100);
+
+		base::MemoryStream stream{1024 * 1024};
+		base::CborWriter writer{stream};
+		writer.Value(snapshot);
+
+		Snapshot from_span;
+		from_span.FromCbor(WrittenSpan(stream));
+		if (from_span != snapshot)
+		{
+			throw std::runtime_error{CODE_POS_STR + "FromCbor 的结果错误。"};
+		}
+
+		stream.SetPosition(0);
+		Snapshot from_stream;
+		from_stream.FromCborStream(stream);
+		if (from_stream != snapshot)
+		{
+			throw std::runtime_error{CODE_POS_STR + "FromCborStream 的结果错误。"};
+		}
+
+		// 也能读取 to_cbor 生成的定长编码。
+		std::vector<uint8_t> cbor = base::Json::to_cbor(snapshot.ToJson());
+		Snapshot from_to_cbor;
+		from_to_cbor.FromCbor(base::ReadOnlySpan{cbor.data(), static_cast<int64_t>(cbor.size())});
+		if (from_to_cbor != snapshot)
+		{
+			throw std::runtime_error{CODE_POS_STR + "读取 to_cbor 的结果错误。"};
+		}
+
+		bool thrown = false;
+		try
+		{
+			Snapshot truncated;
+			base::ReadOnlySpan span = WrittenSpan(stream);
+			truncated.FromCbor(base::ReadOnlySpan{span.Buffer(), span.Size() - 1});
+		}
+		catch (std::invalid_argument const &)
+		{
+			thrown = true;
+		}
+
+		if (!thrown)
+		{
+			throw std::runtime_error{CODE_POS_STR + "截断的 CBOR 应该抛出异常。"};
+		}
+
+		std::cout << "流式反序列化 CBOR 正确。" << std::endl;
+	}
+
+	// EthernetFrameReader 的 WriteJson 与 ToJson 逐字节相同。键的顺序不同也能读回相等的
+	// json, 所以要比较字节。
+	{
+		// 带 VLAN 标签的 PROFINET 帧，载荷超过 16 字节，会换行。
+		std::vector<uint8_t> frame{
+			0x00, 0x0e, 0xcf, 0x00, 0x00, 0x01,
+			0x00, 0x0e, 0xcf, 0x00, 0x00, 0x02,
+			0x81, 0x00, 0xc0, 0x00,
+			0x88, 0x92,
+		};
+
+		for (int64_t i = 0; i < 46; i++)
+		{
+			frame.push_back(static_cast<uint8_t>(i * 7));
+		}
+
+		base::ethernet::EthernetFrameReader reader{base::ReadOnlySpan{frame.data(), static_cast<int64_t>(frame.size())}};
+		base::IJsonSerializable const &serializable = reader;
+		base::Json json = reader.ToJson();
+
+		for (int indent : {0, 4})
+		{
+			std::string text;
+			base::test::StringTextWriter text_writer{text};
+			base::JsonWriter writer{text_writer, indent};
+			writer.Value(serializable);
+			if (text != (indent == 0 ? json.dump() : json.dump(indent)))
+			{
+				throw std::runtime_error{CODE_POS_STR + "EthernetFrameReader 的 WriteJson 与 ToJson().dump() 不一致。"};
+			}
+		}
+
+		// CborWriter 的对象是不定长编码，to_cbor 是定长的。字段都是标量，所以只有开头的
+		// 类型字节和结尾的 break 不同。
+		base::MemoryStream stream{1024};
+		base::CborWriter writer{stream};
+		writer.Value(serializable);
+		base::ReadOnlySpan cbor = WrittenSpan(stream);
+		std::vector<uint8_t> expected = base::Json::to_cbor(json);
+		if (!(cbor.Size() == static_cast<int64_t>(expected.size()) + 1 &&
+			  cbor[0] == 0xbf &&
+			  expected[0] == 0xa0 + json.size() &&
+			  cbor[cbor.Size() - 1] == 0xff &&
+			  cbor.Slice(1, cbor.Size() - 2) == base::ReadOnlySpan{expected.data() + 1, static_cast<int64_t>(expected.size()) - 1}))
+		{
+			throw std::runtime_error{CODE_POS_STR + "EthernetFrameReader 的 CborWriter 输出与 to_cbor(ToJson()) 不一致。"};
+		}
+
+		std::cout << "EthernetFrameReader 的 WriteJson 与 ToJson 一致。" << std::endl;
+	}
+
+	// 大小和速度。
+	{
+		constexpr int64_t repeat = 20;
+		Snapshot snapshot = GenerateSnapshot(10000);
+
+		std::string text;
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for (int64_t i = 0; i < repeat; i++)
+		{
+			text.clear();
+			base::test::StringTextWriter text_writer{text};
+			base::JsonWriter writer{text_writer};
+			writer.Value(snapshot);
+		}
+
+		std::chrono::duration<double> text_elapsed = std::chrono::steady_clock::now() - start;
+
+		base::MemoryStream stream{16 * 1024 * 1024};
+		start = std::chrono::steady_clock::now();
+		for (int64_t i = 0; i < repeat; i++)
+		{
+			stream.SetLength(0);
+			base::CborWriter writer{stream};
+			writer.Value(snapshot);
+		}
+
+		std::chrono::duration<double> cbor_elapsed = std::chrono::steady_clock::now() - start;
+
+		start = std::chrono::steady_clock::now();
+		std::vector<uint8_t> dom_cbor;
+		for (int64_t i = 0; i < repeat; i++)
+		{
+			dom_cbor = base::Json::to_cbor(snapshot.ToJson());
+		}
+
+		std::chrono::duration<double> dom_elapsed = std::chrono::steady_clock::now() - start;
+
+		start = std::chrono::steady_clock::now();
+		for (int64_t i = 0; i < repeat; i++)
+		{
+			Snapshot parsed;
+			parsed.FromJsonString(text);
+		}
+
+		std::chrono::duration<double> text_parse_elapsed = std::chrono::steady_clock::now() - start;
+
+		start = std::chrono::steady_clock::now();
+		for (int64_t i = 0; i < repeat; i++)
+		{
+			Snapshot parsed;
+			parsed.FromCbor(WrittenSpan(stream));
+			if (parsed != snapshot)
+			{
+				throw std::runtime_error{CODE_POS_STR + "CBOR 往返的结果错误。"};
+			}
+		}
+
+		std::chrono::duration<double> cbor_parse_elapsed = std::chrono::steady_clock::now() - start;
+
+		std::cout << "json 文本 " << text.size() << " 字节，CBOR " << stream.Length() << " 字节。" << std::endl;
+
+		std::cout << "写：JsonWriter " << text_elapsed.count() / repeat * 1e3 << " ms, "
+				  << "CborWriter " << cbor_elapsed.count() / repeat * 1e3 << " ms, "
+				  << "ToJson + to_cbor " << dom_elapsed.count() / repeat * 1e3 << " ms" << std::endl;
+
+		std::cout << "读：FromJsonString " << text_parse_elapsed.count() / repeat * 1e3 << " ms, "
+				  << "FromCbor " << cbor_parse_elapsed.count() / repeat * 1e3 << " ms" << std::endl;
+	}
+}
+
+#endif // HAS_THREAD
@@ -0,0 +1,20 @@
+#pragma once
+
+#if HAS_THREAD
+
+namespace base
+{
+	namespace test
+	{
+		///
+		/// @brief 检查 CborWriter 的输出能被 nlohmann::json 读回，流式反序列化 CBOR 的结果正确，
+		/// 比较 CBOR 与 json 文本的大小和速度。
+		///
+		/// @note 也检查 EthernetFrameReader 的 WriteJson 与 ToJson 写出的 json 文本和 CBOR 逐字节相同。
+		///
+		void TestCbor();
+
+	} // namespace test
+} // namespace base
+
+#endif // HAS_THREAD
@@ -0,0 +1,333 @@
+#include "TestDescriptorRing.h" // IWYU pragma: keep
+#include "base/container/ArraySpan.h"
+#include "base/container/ReadOnlyArraySpan.h"
+#include "base/embedded/ethernet/EthernetFrameBuffer.h"
+#include "base/embedded/ethernet/LoopbackEthernetDescriptorRing.h"
+#include "base/string/define.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if HAS_THREAD
+
+namespace
+{
+	///
+	/// @brief 在缓冲区中构造一个 60 字节的帧，最后 8 字节是序号。
+	///
+	void FillFrame(base::ethernet::EthernetFrameBuffer &frame, uint64_t sequence)
+	{
+		std::memset(frame._buffer.Buffer(), 0xff, 12);
+		frame._buffer[12] = 0x88;
+		frame._buffer[13] = 0x92;
+		std::memcpy(frame._buffer.Buffer() + 52, &sequence, 8);
+		frame._length = 60;
+	}
+
+	uint64_t SequenceOf(base::ReadOnlySpan const &frame)
+	{
+		uint64_t sequence = 0;
+		std::memcpy(&sequence, frame.Buffer() + 52, 8);
+		return sequence;
+	}
+
+	template <typename Callback>
+	bool Throws(Callback callback)
+	{
+		try
+		{
+			callback();
+		}
+		catch (std::invalid_argument const &)
+		{
+			return true;
+		}
+
+		return false;
+	}
+
+} // namespace
+
+void base::test::TestDescriptorRing()
+{
+	std::cout << std::endl
+			  << CODE_POS_STR;
+
+	constexpr int64_t batch_size = 32;
+
+	// 借出和归还。
+	{
+		base::ethernet::LoopbackEthernetDescriptorRing ring{8};
+		std::array<base::ethernet::EthernetFrameBuffer, batch_size> frames{};
+		base::ArraySpan<base::ethernet::EthernetFrameBuffer> frames_span{frames.data(), batch_size};
+
+		if (ring.Receive(frames_span) != 0)
+		{
+			throw std::runtime_error{CODE_POS_STR + "没有发送就不应该收到帧。"};
+		}
+
+		if (ring.AcquireTransmitBuffers(frames_span) != 8)
+		{
+			throw std::runtime_error{CODE_POS_STR + "应该借出全部 8 个发送缓冲区。"};
+		}
+
+		if (ring.AcquireTransmitBuffers(frames_span) != 0)
+		{
+			throw std::runtime_error{CODE_POS_STR + "缓冲区耗尽后不应该再借出。"};
+		}
+
+		for (int64_t i = 0; i < 8; i++)
+		{
+			FillFrame(frames[i], static_cast<uint64_t>(i));
+		}
+
+		ring.Send(base::ReadOnlyArraySpan<base::ethernet::EthernetFrameBuffer>{frames.data(), 8});
+		if (!Throws(
+				[&]()
+				{
+					ring.Send(base::ReadOnlyArraySpan<base::ethernet::EthernetFrameBuffer>{frames.data(), 1});
+				}))
+		{
+			throw std::runtime_error{CODE_POS_STR + "重复发送同一个缓冲区应该抛出异常。"};
+		}
+
+		if (ring.Receive(frames_span.Slice(base::Range{0, 5})) != 5)
+		{
+			throw std::runtime_error{CODE_POS_STR + "应该收到 5 个帧。"};
+		}
+
+		if (ring.Receive(frames_span.Slice(base::Range{5, batch_size})) != 3)
+		{
+			throw std::runtime_error{CODE_POS_STR + "应该收到剩下的 3 个帧。"};
+		}
+
+		for (int64_t i = 0; i < 8; i++)
+		{
+			if (!(frames[i]._length == 60 && SequenceOf(frames[i].Frame()) == static_cast<uint64_t>(i)))
+			{
+				throw std::runtime_error{CODE_POS_STR + "收到的帧顺序或内容错误。"};
+			}
+		}
+
+		ring.ReleaseReceived(base::ReadOnlyArraySpan<base::ethernet::EthernetFrameBuffer>{frames.data(), 8});
+		if (!Throws(
+				[&]()
+				{
+					ring.ReleaseReceived(base::ReadOnlyArraySpan<base::ethernet::EthernetFrameBuffer>{frames.data(), 1});
+				}))
+		{
+			throw std::runtime_error{CODE_POS_STR + "重复归还应该抛出异常。"};
+		}
+
+		if (ring.AcquireTransmitBuffers(frames_span) != 8)
+		{
+			throw std::runtime_error{CODE_POS_STR + "归还后应该可以再次借出。"};
+		}
+
+		std::cout << "描述符环的借出和归还正确。" << std::endl;
+	}
+
+	// 同一批中重复的缓冲区。
+	{
+		base::ethernet::LoopbackEthernetDescriptorRing ring{4};
+		std::array<base::ethernet::EthernetFrameBuffer, 4> frames{};
+		base::ArraySpan<base::ethernet::EthernetFrameBuffer> frames_span{frames.data(), 4};
+
+		if (ring.AcquireTransmitBuffers(frames_span.Slice(base::Range{0, 2})) != 2)
+		{
+			throw std::runtime_error{CODE_POS_STR + "应该借出 2 个发送缓冲区。"};
+		}
+
+		FillFrame(frames[0], 0);
+		FillFrame(frames[1], 1);
+		std::array<base::ethernet::EthernetFrameBuffer, 3> duplicated{frames[0], frames[1], frames[0]};
+		if (!Throws(
+				[&]()
+				{
+					ring.Send(base::ReadOnlyArraySpan<base::ethernet::EthernetFrameBuffer>{duplicated.data(), 3});
+				}))
+		{
+			throw std::runtime_error{CODE_POS_STR + "一批中重复发送同一个缓冲区应该抛出异常。"};
+		}
+
+		// 出错后状态不变，还可以正常发送。
+		ring.Send(base::ReadOnlyArraySpan<base::ethernet::EthernetFrameBuffer>{frames.data(), 2});
+		if (ring.Receive(frames_span) != 2)
+		{
+			throw std::runtime_error{CODE_POS_STR + "应该收到 2 个帧。"};
+		}
+
+		duplicated = {frames[1], frames[0], frames[1]};
+		if (!Throws(
+				[&]()
+				{
+					ring.ReleaseReceived(base::ReadOnlyArraySpan<base::ethernet::EthernetFrameBuffer>{duplicated.data(), 3});
+				}))
+		{
+			throw std::runtime_error{CODE_POS_STR + "一批中重复归还同一个缓冲区应该抛出异常。"};
+		}
+
+		ring.ReleaseReceived(base::ReadOnlyArraySpan<base::ethernet::EthernetFrameBuffer>{frames.data(), 2});
+		if (ring.AcquireTransmitBuffers(frames_span) != 4)
+		{
+			throw std::runtime_error{CODE_POS_STR + "每个缓冲区应该只回到池中一次。"};
+		}
+
+		if (ring.Receive(frames_span) != 0)
+		{
+			throw std::runtime_error{CODE_POS_STR + "不应该收到多余的帧。"};
+		}
+
+		std::cout << "重复的缓冲区被拒绝。" << std::endl;
+	}
+
+	// 一个线程发送，另一个线程接收。
+	{
+		constexpr int64_t frame_count = 200000;
+		base::ethernet::LoopbackEthernetDescriptorRing ring{256};
+		uint64_t received_sum = 0;
+
+		std::thread receiver{
+			[&]()
+			{
+				std::array<base::ethernet::EthernetFrameBuffer, batch_size> frames{};
+				int64_t received = 0;
+				while (received < frame_count)
+				{
+					int64_t count = ring.Receive(base::ArraySpan<base::ethernet::EthernetFrameBuffer>{frames.data(), batch_size});
+					if (count == 0)
+					{
+						std::this_thread::yield();
+						continue;
+					}
+
+					for (int64_t i = 0; i < count; i++)
+					{
+						received_sum += SequenceOf(frames[i].Frame());
+					}
+
+					ring.ReleaseReceived(base::ReadOnlyArraySpan<base::ethernet::EthernetFrameBuffer>{frames.data(), count});
+					received += count;
+				}
+			}};
+
+		std::array<base::ethernet::EthernetFrameBuffer, batch_size> frames{};
+		int64_t sent = 0;
+		while (sent < frame_count)
+		{
+			int64_t want = std::min(batch_size, frame_count - sent);
+			int64_t count = ring.AcquireTransmitBuffers(base::ArraySpan<base::ethernet::EthernetFrameBuffer>{frames.data(), want});
+			if (count == 0)
+			{
+				std::this_thread::yield();
+				continue;
+			}
+
+			for (int64_t i = 0; i < count; i++)
+			{
+				FillFrame(frames[i], static_cast<uint64_t>(sent + i));
+			}
+
+			ring.Send(base::ReadOnlyArraySpan<base::ethernet::EthernetFrameBuffer>{frames.data(), count});
+			sent += count;
+		}
+
+		receiver.join();
+		uint64_t expected_sum = static_cast<uint64_t>(frame_count) * (frame_count - 1) / 2;
+		if (received_sum != expected_sum)
+		{
+			throw std::runtime_error{CODE_POS_STR + "跨线程收到的帧不完整。"};
+		}
+
+		std::cout << "跨线程收发正确。" << std::endl;
+	}
+
+	// 速度。在一个线程中交替发送一批、接收一批，测量每帧的开销。
+	constexpr int64_t frame_count = 8000000;
+
+	std::chrono::duration<double> ring_elapsed{};
+	{
+		base::ethernet::LoopbackEthernetDescriptorRing ring{256};
+		std::array<base::ethernet::EthernetFrameBuffer, batch_size> frames{};
+		base::ArraySpan<base::ethernet::EthernetFrameBuffer> frames_span{frames.data(), batch_size};
+		uint64_t received_sum = 0;
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for (int64_t sent = 0; sent < frame_count; sent += batch_size)
+		{
+			int64_t count = ring.AcquireTransmitBuffers(frames_span);
+			for (int64_t i = 0; i < count; i++)
+			{
+				FillFrame(frames[i], static_cast<uint64_t>(sent + i));
+			}
+
+			ring.Send(base::ReadOnlyArraySpan<base::ethernet::EthernetFrameBuffer>{frames.data(), count});
+
+			count = ring.Receive(frames_span);
+			for (int64_t i = 0; i < count; i++)
+			{
+				received_sum += SequenceOf(frames[i].Frame());
+			}
+
+			ring.ReleaseReceived(base::ReadOnlyArraySpan<base::ethernet::EthernetFrameBuffer>{frames.data(), count});
+		}
+
+		ring_elapsed = std::chrono::steady_clock::now() - start;
+		if (received_sum != static_cast<uint64_t>(frame_count) * (frame_count - 1) / 2)
+		{
+			throw std::runtime_error{CODE_POS_STR + "收到的帧不完整。"};
+		}
+	}
+
+	// 对照：逐帧复制进出一个加锁的队列，相当于 Send(span) 和 Receive() 各复制一次。
+	std::chrono::duration<double> copy_elapsed{};
+	{
+		std::mutex lock;
+		std::deque<std::vector<uint8_t>> queue;
+		uint64_t received_sum = 0;
+
+		std::vector<uint8_t> send_buffer(1536);
+		std::vector<uint8_t> receive_buffer(1536);
+		base::ethernet::EthernetFrameBuffer frame{0, base::Span{send_buffer.data(), static_cast<int64_t>(send_buffer.size())}, 0};
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for (int64_t sent = 0; sent < frame_count; sent += batch_size)
+		{
+			for (int64_t i = 0; i < batch_size; i++)
+			{
+				FillFrame(frame, static_cast<uint64_t>(sent + i));
+				std::lock_guard g{lock};
+				queue.push_back(std::vector<uint8_t>{send_buffer.data(), send_buffer.data() + frame._length});
+			}
+
+			for (int64_t i = 0; i < batch_size; i++)
+			{
+				std::lock_guard g{lock};
+				std::memcpy(receive_buffer.data(), queue.front().data(), queue.front().size());
+				queue.pop_front();
+				received_sum += SequenceOf(base::ReadOnlySpan{receive_buffer.data(), 60});
+			}
+		}
+
+		copy_elapsed = std::chrono::steady_clock::now() - start;
+		if (received_sum != static_cast<uint64_t>(frame_count) * (frame_count - 1) / 2)
+		{
+			throw std::runtime_error{CODE_POS_STR + "收到的帧不完整。"};
+		}
+	}
+
+	double frames = static_cast<double>(frame_count);
+	std::cout << "收发 60 字节的帧：逐帧复制 " << frames / copy_elapsed.count() / 1e6 << " M帧/s, "
+			  << "描述符环每批 " << batch_size << " 帧 " << frames / ring_elapsed.count() / 1e6 << " M帧/s" << std::endl;
+}
+
+#endif // HAS_THREAD
@@ -0,0 +1,17 @@
+#pragma once
+
+#if HAS_THREAD
+
+namespace base
+{
+	namespace test
+	{
+		///
+		/// @brief 检查环回描述符环的借出和归还，与逐帧复制的收发比较速度。
+		///
+		void TestDescriptorRing();
+
+	} // namespace test
+} // namespace base
+
+#endif // HAS_THREAD
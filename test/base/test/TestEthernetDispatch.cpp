@@ -0,0 +1,324 @@
+#include "TestEthernetDispatch.h" // IWYU pragma: keep
+#include "TestHelper.h"
+#include "base/net/ethernet/EthernetFrameDispatcher.h"
+#include "base/net/ethernet/EthernetFrameInfo.h"
+#include "base/net/ethernet/EthernetFrameReader.h"
+#include "base/net/ethernet/EthernetFrameWriter.h"
+#include "base/net/ethernet/LengthOrTypeEnum.h"
+#include "base/net/Mac.h"
+#include "base/stream/ReadOnlySpan.h"
+#include "base/stream/Span.h"
+#include "base/string/define.h"
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if HAS_THREAD
+
+namespace
+{
+	///
+	/// @brief 构造一个最小的以太网帧。
+	///
+	/// @param type
+	/// @param vlan_tci 为 -1 时不带 VLAN 标签。
+	/// @param frame_id 为 -1 时不写帧 ID.
+	///
+	std::vector<uint8_t> MakeFrame(base::ethernet::LengthOrTypeEnum type, int32_t vlan_tci, int32_t frame_id)
+	{
+		std::vector<uint8_t> frame(64);
+		base::ethernet::EthernetFrameWriter writer{base::Span{frame.data(), static_cast<int64_t>(frame.size())}};
+		writer.WriteDestinationMac(base::test::MakeMac(0x01));
+		writer.WriteSourceMac(base::test::MakeMac(0x02));
+		if (vlan_tci >= 0)
+		{
+			uint8_t vlan_tag[4] = {0x81, 0x00, static_cast<uint8_t>(vlan_tci >> 8), static_cast<uint8_t>(vlan_tci)};
+			writer.WriteVlanTag(base::ReadOnlySpan{vlan_tag, 4});
+		}
+
+		writer.WriteTypeOrLength(type);
+		if (frame_id >= 0)
+		{
+			writer.WritePayload(static_cast<uint16_t>(frame_id), std::endian::big);
+		}
+
+		frame.resize(static_cast<size_t>(writer.SpanForSending().Size()));
+		return frame;
+	}
+
+} // namespace
+
+void base::test::TestEthernetDispatch()
+{
+	std::cout << std::endl
+			  << CODE_POS_STR;
+
+	std::vector<std::vector<uint8_t>> frames{
+		MakeFrame(base::ethernet::LengthOrTypeEnum::Profinet, 0xc000, 0x8001), // RT 循环帧
+		MakeFrame(base::ethernet::LengthOrTypeEnum::Profinet, -1, 0xfefe),     // DCP
+		MakeFrame(base::ethernet::LengthOrTypeEnum::Profinet, -1, 0xfc01),     // 报警，没有对应的帧 ID 路由
+		MakeFrame(base::ethernet::LengthOrTypeEnum::IP, -1, -1),
+		MakeFrame(base::ethernet::LengthOrTypeEnum::IP, 0x2005, -1), // VLAN 5
+		MakeFrame(base::ethernet::LengthOrTypeEnum::ARP, -1, -1),
+		MakeFrame(base::ethernet::LengthOrTypeEnum::LLDP, -1, -1), // 没有处理函数
+		std::vector<uint8_t>(10),                                  // 过短
+		std::vector<uint8_t>{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x81, 0x00, 0xc0}, // VLAN 标签不完整
+	};
+
+	std::vector<base::ReadOnlySpan> spans;
+	for (std::vector<uint8_t> const &frame : frames)
+	{
+		spans.push_back(base::ReadOnlySpan{frame.data(), static_cast<int64_t>(frame.size())});
+	}
+
+	// 分类。
+	{
+		base::ethernet::EthernetFrameInfo info = base::ethernet::EthernetFrameInfo::Classify(spans[0]);
+		if (!(info.IsValid() && info.HasVlanTag() && info.Priority() == 6 && info.VlanId() == 0))
+		{
+			throw std::runtime_error{CODE_POS_STR + "VLAN 标签解析错误。"};
+		}
+
+		if (info.TypeOrLength() != base::ethernet::LengthOrTypeEnum::Profinet)
+		{
+			throw std::runtime_error{CODE_POS_STR + "类型解析错误。"};
+		}
+
+		if (!(info.HasProfinetFrameId() && info.ProfinetFrameId() == 0x8001))
+		{
+			throw std::runtime_error{CODE_POS_STR + "帧 ID 解析错误。"};
+		}
+
+		if (!(info.Payload().Size() == static_cast<int64_t>(frames[0].size()) - 18 && info.Payload()[1] == 0x01))
+		{
+			throw std::runtime_error{CODE_POS_STR + "载荷错误。"};
+		}
+
+		if (!(info.DestinationMac().Size() == 6 && info.DestinationMac()[5] == 0x01))
+		{
+			throw std::runtime_error{CODE_POS_STR + "目的 MAC 错误。"};
+		}
+
+		if (!(info.SourceMac().Size() == 6 && info.SourceMac()[5] == 0x02))
+		{
+			throw std::runtime_error{CODE_POS_STR + "源 MAC 错误。"};
+		}
+
+		base::ethernet::EthernetFrameReader reader{spans[0]};
+		if (!(reader.HasVlanTag() && reader.TypeOrLength() == info.TypeOrLength()))
+		{
+			throw std::runtime_error{CODE_POS_STR + "与 EthernetFrameReader 的结果不同。"};
+		}
+
+		info = base::ethernet::EthernetFrameInfo::Classify(spans[3]);
+		if (!(info.IsValid() && !info.HasVlanTag() && !info.HasProfinetFrameId()))
+		{
+			throw std::runtime_error{CODE_POS_STR + "IP 帧解析错误。"};
+		}
+
+		if (base::ethernet::EthernetFrameInfo::Classify(spans[7]).IsValid())
+		{
+			throw std::runtime_error{CODE_POS_STR + "过短的帧应该不合法。"};
+		}
+
+		if (base::ethernet::EthernetFrameInfo::Classify(spans[8]).IsValid())
+		{
+			throw std::runtime_error{CODE_POS_STR + "VLAN 标签不完整的帧应该不合法。"};
+		}
+
+		std::cout << "分类正确。" << std::endl;
+	}
+
+	// 分发。
+	{
+		int64_t rt_count = 0;
+		int64_t dcp_count = 0;
+		int64_t vlan_count = 0;
+		int64_t ip_count = 0;
+		int64_t arp_count = 0;
+		int64_t profinet_count = 0;
+
+		base::ethernet::EthernetFrameDispatcher dispatcher;
+		dispatcher.AddProfinetHandler(0x8000,
+									  0xbfff,
+									  [&](base::ethernet::EthernetFrameInfo const &)
+									  {
+										  rt_count++;
+									  });
+
+		dispatcher.AddProfinetHandler(0xfefc,
+									  0xfeff,
+									  [&](base::ethernet::EthernetFrameInfo const &)
+									  {
+										  dcp_count++;
+									  });
+
+		dispatcher.AddVlanHandler(5,
+								  [&](base::ethernet::EthernetFrameInfo const &)
+								  {
+									  vlan_count++;
+								  });
+
+		dispatcher.AddTypeHandler(base::ethernet::LengthOrTypeEnum::IP,
+								  [&](base::ethernet::EthernetFrameInfo const &)
+								  {
+									  ip_count++;
+								  });
+
+		dispatcher.AddTypeHandler(base::ethernet::LengthOrTypeEnum::ARP,
+								  [&](base::ethernet::EthernetFrameInfo const &)
+								  {
+									  arp_count++;
+								  });
+
+		dispatcher.AddTypeHandler(base::ethernet::LengthOrTypeEnum::Profinet,
+								  [&](base::ethernet::EthernetFrameInfo const &)
+								  {
+									  profinet_count++;
+								  });
+
+		bool thrown = false;
+		try
+		{
+			dispatcher.AddProfinetHandler(0xbff0, 0xc000, nullptr);
+		}
+		catch (std::invalid_argument const &)
+		{
+			thrown = true;
+		}
+
+		if (!thrown)
+		{
+			throw std::runtime_error{CODE_POS_STR + "重叠的帧 ID 范围应该抛出异常。"};
+		}
+
+		dispatcher.Dispatch(spans);
+		if (!(rt_count == 1 && dcp_count == 1 && vlan_count == 1))
+		{
+			throw std::runtime_error{CODE_POS_STR + "按帧 ID 或 VLAN 分发错误。"};
+		}
+
+		if (!(ip_count == 1 && arp_count == 1 && profinet_count == 1))
+		{
+			throw std::runtime_error{CODE_POS_STR + "按类型分发错误。"};
+		}
+
+		if (dispatcher.DispatchedCount() != 6)
+		{
+			throw std::runtime_error{CODE_POS_STR + "分发的帧数错误。"};
+		}
+
+		if (dispatcher.UnhandledCount() != 1)
+		{
+			throw std::runtime_error{CODE_POS_STR + "没有处理函数的帧数错误。"};
+		}
+
+		if (dispatcher.MalformedCount() != 2)
+		{
+			throw std::runtime_error{CODE_POS_STR + "过短的帧数错误。"};
+		}
+
+		int64_t default_count = 0;
+		dispatcher.SetDefaultHandler(
+			[&](base::ethernet::EthernetFrameInfo const &)
+			{
+				default_count++;
+			});
+
+		dispatcher.Dispatch(spans[6]);
+		if (default_count != 1)
+		{
+			throw std::runtime_error{CODE_POS_STR + "没有匹配的帧应该交给默认处理函数。"};
+		}
+
+		std::cout << "分发正确。" << std::endl;
+	}
+
+	// 速度。以 RT 循环帧为主的混合流量，每批 32 帧。
+	{
+		constexpr int64_t batch_size = 32;
+		constexpr int64_t batch_count = 50000;
+
+		std::vector<base::ReadOnlySpan> batch;
+		for (int64_t i = 0; i < batch_size; i++)
+		{
+			int64_t kind = i % 8;
+			if (kind < 6)
+			{
+				batch.push_back(spans[0]);
+			}
+			else if (kind == 6)
+			{
+				batch.push_back(spans[1]);
+			}
+			else
+			{
+				batch.push_back(spans[3]);
+			}
+		}
+
+		int64_t rt_bytes = 0;
+		int64_t other_count = 0;
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for (int64_t i = 0; i < batch_count; i++)
+		{
+			for (base::ReadOnlySpan const &frame : batch)
+			{
+				base::ethernet::EthernetFrameReader reader{frame};
+				base::Mac destination = reader.DestinationMac();
+				if (reader.TypeOrLength() == base::ethernet::LengthOrTypeEnum::Profinet)
+				{
+					uint16_t frame_id = reader.ReadPayload<uint16_t>(std::endian::big);
+					if (frame_id >= 0x8000 && frame_id <= 0xbfff)
+					{
+						rt_bytes += frame.Size() + destination[0];
+						continue;
+					}
+				}
+
+				other_count++;
+			}
+		}
+
+		std::chrono::duration<double> reader_elapsed = std::chrono::steady_clock::now() - start;
+
+		base::ethernet::EthernetFrameDispatcher dispatcher;
+		dispatcher.AddProfinetHandler(0x8000,
+									  0xbfff,
+									  [&](base::ethernet::EthernetFrameInfo const &info)
+									  {
+										  rt_bytes += info.Frame().Size() + info.DestinationMac()[5];
+									  });
+
+		dispatcher.SetDefaultHandler(
+			[&](base::ethernet::EthernetFrameInfo const &)
+			{
+				other_count++;
+			});
+
+		start = std::chrono::steady_clock::now();
+		for (int64_t i = 0; i < batch_count; i++)
+		{
+			dispatcher.Dispatch(batch);
+		}
+
+		std::chrono::duration<double> dispatcher_elapsed = std::chrono::steady_clock::now() - start;
+
+		double frame_count = static_cast<double>(batch_size * batch_count);
+
+		// 100 Mbit/s 下最小帧（加上前导码和帧间隔共 84 字节）的帧率。
+		double line_rate = 100e6 / 8 / 84;
+
+		std::cout << "逐帧 EthernetFrameReader " << frame_count / reader_elapsed.count() / 1e6 << " M帧/s, "
+				  << "批量分发 " << frame_count / dispatcher_elapsed.count() / 1e6 << " M帧/s, "
+				  << "100 Mbit/s 线速 " << line_rate / 1e6 << " M帧/s" << std::endl;
+
+		std::cout << "校验和 " << rt_bytes + other_count << std::endl;
+	}
+}
+
+#endif // HAS_THREAD
@@ -0,0 +1,17 @@
+#pragma once
+
+#if HAS_THREAD
+
+namespace base
+{
+	namespace test
+	{
+		///
+		/// @brief 检查以太网帧的分类和分发，与逐帧使用 EthernetFrameReader 比较速度。
+		///
+		void TestEthernetDispatch();
+
+	} // namespace test
+} // namespace base
+
+#endif // HAS_THREAD
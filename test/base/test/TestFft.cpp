@@ -0,0 +1,356 @@
+#include "TestFft.h" // IWYU pragma: keep
+#include "base/container/ArraySpan.h"
+#include "base/container/ReadOnlyArraySpan.h"
+#include "base/math/Fft.h"
+#include "base/math/RealFft.h"
+#include "base/math/Xoshiro256PlusPlus.h"
+#include "base/signal/Stft.h"
+#include "base/signal/WelchPsd.h"
+#include "base/string/define.h"
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <iostream>
+#include <numbers>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if HAS_THREAD
+
+namespace
+{
+	///
+	/// @brief 生成 [-1, 1) 内的随机数。
+	///
+	/// @param generator
+	/// @return
+	///
+	double NextDouble(base::Xoshiro256PlusPlus &generator)
+	{
+		return static_cast<double>(generator.Next() >> 11) * 0x1.0p-52 - 1;
+	}
+
+	std::vector<std::complex<double>> RandomComplex(base::Xoshiro256PlusPlus &generator, int64_t size)
+	{
+		std::vector<std::complex<double>> ret(size);
+		for (std::complex<double> &value : ret)
+		{
+			value = std::complex<double>{NextDouble(generator), NextDouble(generator)};
+		}
+
+		return ret;
+	}
+
+	///
+	/// @brief 按定义计算 DFT.
+	///
+	/// @param input
+	/// @return
+	///
+	std::vector<std::complex<double>> NaiveDft(std::vector<std::complex<double>> const &input)
+	{
+		int64_t size = static_cast<int64_t>(input.size());
+		std::vector<std::complex<double>> ret(size);
+		for (int64_t k = 0; k < size; k++)
+		{
+			std::complex<long double> sum{};
+			for (int64_t j = 0; j < size; j++)
+			{
+				long double angle = -2 * std::numbers::pi_v<long double> * ((j * k) % size) / size;
+				sum += std::complex<long double>{input[j].real(), input[j].imag()} *
+					   std::complex<long double>{std::cos(angle), std::sin(angle)};
+			}
+
+			ret[k] = std::complex<double>{static_cast<double>(sum.real()), static_cast<double>(sum.imag())};
+		}
+
+		return ret;
+	}
+
+	double MaxDifference(std::complex<double> const *a, std::complex<double> const *b, int64_t count)
+	{
+		double ret = 0;
+		for (int64_t i = 0; i < count; i++)
+		{
+			ret = std::max(ret, std::abs(a[i] - b[i]));
+		}
+
+		return ret;
+	}
+
+	base::ArraySpan<std::complex<double>> ToSpan(std::vector<std::complex<double>> &vector)
+	{
+		return base::ArraySpan<std::complex<double>>{vector.data(), static_cast<int64_t>(vector.size())};
+	}
+
+} // namespace
+
+void base::test::TestFft()
+{
+	base::Xoshiro256PlusPlus generator{2024};
+
+	{
+		std::cout << std::endl
+				  << CODE_POS_STR;
+
+		// 覆盖各个基数、混合基数和需要 Bluestein 算法的长度。
+		int64_t const sizes[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 11, 12, 13, 15, 16, 17, 25,
+								 30, 49, 64, 97, 120, 128, 143, 210, 256, 343, 1000, 1024, 1031};
+
+		double max_error = 0;
+		for (int64_t size : sizes)
+		{
+			std::vector<std::complex<double>> input = RandomComplex(generator, size);
+			std::vector<std::complex<double>> expected = NaiveDft(input);
+
+			base::Fft fft{size};
+			std::vector<std::complex<double>> output(size);
+			fft.Forward(ToSpan(input), ToSpan(output));
+
+			// 误差随长度增长，按 sqrt(n) 归一化后比较。
+			double error = MaxDifference(output.data(), expected.data(), size) / std::sqrt(static_cast<double>(size));
+			max_error = std::max(max_error, error);
+			if (!(error < 1e-12))
+			{
+				throw std::runtime_error{CODE_POS_STR + "长度 " + std::to_string(size) + " 的正变换结果错误。"};
+			}
+
+			// 原地逆变换回到输入。
+			fft.Inverse(ToSpan(output), ToSpan(output));
+			if (!(MaxDifference(output.data(), input.data(), size) < 1e-12))
+			{
+				throw std::runtime_error{CODE_POS_STR + "长度 " + std::to_string(size) + " 的逆变换结果错误。"};
+			}
+
+			// 原地正变换与非原地相同。
+			std::vector<std::complex<double>> in_place = input;
+			fft.Forward(ToSpan(in_place), ToSpan(in_place));
+			if (!(MaxDifference(in_place.data(), expected.data(), size) / std::sqrt(static_cast<double>(size)) < 1e-12))
+			{
+				throw std::runtime_error{CODE_POS_STR + "长度 " + std::to_string(size) + " 的原地正变换结果错误。"};
+			}
+		}
+
+		std::cout << "复数 FFT 与 DFT 的最大归一化误差: " << max_error << std::endl;
+	}
+
+	{
+		std::cout << std::endl
+				  << CODE_POS_STR;
+
+		int64_t const sizes[] = {2, 4, 6, 10, 16, 34, 100, 256, 1000, 4096};
+		for (int64_t size : sizes)
+		{
+			std::vector<double> input(size);
+			std::vector<std::complex<double>> complex_input(size);
+			for (int64_t i = 0; i < size; i++)
+			{
+				input[i] = NextDouble(generator);
+				complex_input[i] = input[i];
+			}
+
+			std::vector<std::complex<double>> expected(size);
+			base::Fft fft{size};
+			fft.Forward(ToSpan(complex_input), ToSpan(expected));
+
+			base::RealFft real_fft{size};
+			std::vector<std::complex<double>> spectrum(real_fft.SpectrumSize());
+			real_fft.Forward(base::ReadOnlyArraySpan<double>{input.data(), size}, ToSpan(spectrum));
+			if (!(MaxDifference(spectrum.data(), expected.data(), real_fft.SpectrumSize()) < 1e-12 * size))
+			{
+				throw std::runtime_error{CODE_POS_STR + "长度 " + std::to_string(size) + " 的实数正变换结果错误。"};
+			}
+
+			std::vector<double> restored(size);
+			real_fft.Inverse(ToSpan(spectrum), base::ArraySpan<double>{restored.data(), size});
+			for (int64_t i = 0; i < size; i++)
+			{
+				if (!(std::abs(restored[i] - input[i]) < 1e-12))
+				{
+					throw std::runtime_error{CODE_POS_STR + "长度 " + std::to_string(size) + " 的实数逆变换结果错误。"};
+				}
+			}
+		}
+
+		std::cout << "实数 FFT 与复数 FFT 一致。" << std::endl;
+	}
+
+	{
+		std::cout << std::endl
+				  << CODE_POS_STR;
+
+		// 256 点窗，频率正好在第 32 个频点上的正弦。
+		base::Stft<256> stft{64};
+		std::vector<double> samples(4096);
+		for (int64_t i = 0; i < static_cast<int64_t>(samples.size()); i++)
+		{
+			samples[i] = std::sin(2 * std::numbers::pi * 32 * static_cast<double>(i) / 256);
+		}
+
+		int64_t frame_count = stft.Input(base::ReadOnlyArraySpan<double>{samples.data(), static_cast<int64_t>(samples.size())},
+										 [&](base::ReadOnlyArraySpan<std::complex<double>> const &spectrum)
+										 {
+											 int64_t peak = 0;
+											 for (int64_t k = 0; k < spectrum.Count(); k++)
+											 {
+												 if (std::abs(spectrum[k]) > std::abs(spectrum[peak]))
+												 {
+													 peak = k;
+												 }
+											 }
+
+											 if (peak != 32)
+											 {
+												 throw std::runtime_error{CODE_POS_STR + "STFT 的峰值不在第 32 个频点上。"};
+											 }
+
+											 // Hann 窗的相干增益是 0.5, 幅度为 1 的正弦在峰值处的幅值是 n / 4.
+											 if (!(std::abs(std::abs(spectrum[32]) - 64) < 1e-9))
+											 {
+												 throw std::runtime_error{CODE_POS_STR + "STFT 的峰值幅度错误。"};
+											 }
+										 });
+
+		// 第 256 个采样产生第一帧，此后每 64 个采样一帧。
+		if (frame_count != (4096 - 256) / 64 + 1)
+		{
+			throw std::runtime_error{CODE_POS_STR + "STFT 的帧数错误。"};
+		}
+
+		if (stft.FrameCount() != frame_count)
+		{
+			throw std::runtime_error{CODE_POS_STR + "STFT 的 FrameCount 错误。"};
+		}
+
+		std::cout << "STFT 输出 " << frame_count << " 帧。" << std::endl;
+	}
+
+	{
+		std::cout << std::endl
+				  << CODE_POS_STR;
+
+		// 采样率 1000 Hz, 幅度 2 的 125 Hz 正弦加上方差 1 / 3 的均匀白噪声。
+		int64_t const count = 1 << 16;
+		std::vector<double> signal(count);
+		for (int64_t i = 0; i < count; i++)
+		{
+			signal[i] = 2 * std::sin(2 * std::numbers::pi * 125 * static_cast<double>(i) / 1000) + NextDouble(generator);
+		}
+
+		base::WelchPsd welch{1024, 512, base::unit::Hz{1000}};
+		std::vector<double> psd(welch.PsdSize());
+		int64_t segment_count = welch.Compute(base::ReadOnlyArraySpan<double>{signal.data(), count},
+											  base::ArraySpan<double>{psd.data(), welch.PsdSize()});
+
+		if (segment_count != (count - 1024) / 512 + 1)
+		{
+			throw std::runtime_error{CODE_POS_STR + "Welch 段数错误。"};
+		}
+
+		// 对功率谱密度积分得到均方值：正弦 2^2 / 2 加上噪声 1 / 3.
+		double power = 0;
+		for (double value : psd)
+		{
+			power += value * welch.FrequencyResolution();
+		}
+
+		std::cout << "功率谱积分: " << power << ", 理论值: " << 2 + 1.0 / 3 << std::endl;
+		if (!(std::abs(power - (2 + 1.0 / 3)) < 0.05))
+		{
+			throw std::runtime_error{CODE_POS_STR + "功率谱积分与均方值不符。"};
+		}
+
+		// 正弦在 125 Hz, 即第 128 个频点。
+		int64_t peak = 0;
+		for (int64_t k = 0; k < welch.PsdSize(); k++)
+		{
+			if (psd[k] > psd[peak])
+			{
+				peak = k;
+			}
+		}
+
+		if (peak != 128)
+		{
+			throw std::runtime_error{CODE_POS_STR + "功率谱的峰值不在 125 Hz."};
+		}
+
+		// 远离正弦的频点上是噪声的单边密度 2 * (1 / 3) / 1000.
+		double noise_density = 0;
+		for (int64_t k = 300; k < 500; k++)
+		{
+			noise_density += psd[k] / 200;
+		}
+
+		std::cout << "噪声密度: " << noise_density << ", 理论值: " << 2.0 / 3 / 1000 << std::endl;
+		if (!(std::abs(noise_density - 2.0 / 3 / 1000) < 0.1 * 2.0 / 3 / 1000))
+		{
+			throw std::runtime_error{CODE_POS_STR + "噪声密度错误。"};
+		}
+	}
+
+	{
+		std::cout << std::endl
+				  << CODE_POS_STR;
+
+		int64_t const size = 1 << 16;
+		int64_t const repeat = 200;
+		std::vector<std::complex<double>> data = RandomComplex(generator, size);
+
+		{
+			base::Fft fft{size};
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			for (int64_t i = 0; i < repeat; i++)
+			{
+				fft.Forward(ToSpan(data), ToSpan(data));
+				fft.Inverse(ToSpan(data), ToSpan(data));
+			}
+
+			std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - start;
+			std::cout << "64K 点复数 FFT: "
+					  << static_cast<double>(elapsed.count()) / (2 * repeat) / 1000 << " us/次" << std::endl;
+		}
+
+		{
+			std::vector<double> real_data(size);
+			for (int64_t i = 0; i < size; i++)
+			{
+				real_data[i] = data[i].real();
+			}
+
+			base::RealFft fft{size};
+			std::vector<std::complex<double>> spectrum(fft.SpectrumSize());
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			for (int64_t i = 0; i < repeat; i++)
+			{
+				fft.Forward(base::ReadOnlyArraySpan<double>{real_data.data(), size}, ToSpan(spectrum));
+				fft.Inverse(ToSpan(spectrum), base::ArraySpan<double>{real_data.data(), size});
+			}
+
+			std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - start;
+			std::cout << "64K 点实数 FFT: "
+					  << static_cast<double>(elapsed.count()) / (2 * repeat) / 1000 << " us/次" << std::endl;
+		}
+
+		{
+			// 质数长度走 Bluestein 算法。
+			base::Fft fft{65537};
+			std::vector<std::complex<double>> prime_data = RandomComplex(generator, 65537);
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			for (int64_t i = 0; i < repeat / 10; i++)
+			{
+				fft.Forward(ToSpan(prime_data), ToSpan(prime_data));
+			}
+
+			std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - start;
+			std::cout << "65537 点复数 FFT: "
+					  << static_cast<double>(elapsed.count()) / (repeat / 10) / 1000 << " us/次" << std::endl;
+		}
+
+		std::cout << "校验: " << data[size - 1] << std::endl;
+	}
+}
+
+#endif // HAS_THREAD
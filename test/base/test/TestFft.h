@@ -0,0 +1,18 @@
+#pragma once
+
+#if HAS_THREAD
+
+namespace base
+{
+	namespace test
+	{
+		///
+		/// @brief 与按定义计算的 DFT 比较 FFT 的结果，检查 STFT 和 Welch 功率谱密度，
+		/// 测量 64K 点变换的耗时。
+		///
+		void TestFft();
+
+	} // namespace test
+} // namespace base
+
+#endif // HAS_THREAD
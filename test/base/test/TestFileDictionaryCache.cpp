@@ -0,0 +1,325 @@
+#include "TestFileDictionaryCache.h" // IWYU pragma: keep
+#include "base/filesystem/file.h"
+#include "base/filesystem/FileDictionary.h"
+#include "base/filesystem/filesystem.h"
+#include "base/filesystem/Path.h"
+#include "base/filesystem/ReadOnlyMemoryMapFileStream.h"
+#include "base/stream/ReadOnlySpan.h"
+#include "base/stream/Span.h"
+#include "base/stream/Stream.h"
+#include "base/string/define.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if HAS_THREAD
+
+namespace
+{
+	constexpr int64_t FileCount = 2000;
+	constexpr int64_t FileSize = 256;
+
+	std::string KeyOf(int64_t index)
+	{
+		return "key" + std::to_string(index);
+	}
+
+	///
+	/// @brief 第 index 个文件的第 i 个字节。
+	///
+	uint8_t ByteOf(int64_t index, int64_t i)
+	{
+		return static_cast<uint8_t>(index * 31 + i);
+	}
+
+	///
+	/// @brief 读完流，检查内容是不是第 index 个文件的。
+	///
+	void CheckContent(base::Stream &stream, int64_t index)
+	{
+		uint8_t buffer[FileSize];
+		if (stream.ReadExactly(base::Span{buffer, FileSize}) != FileSize)
+		{
+			throw std::runtime_error{CODE_POS_STR + "读到的长度错误。"};
+		}
+
+		for (int64_t i = 0; i < FileSize; i++)
+		{
+			if (buffer[i] != ByteOf(index, i))
+			{
+				throw std::runtime_error{CODE_POS_STR + "读到的内容错误。"};
+			}
+		}
+	}
+
+	int64_t IndexOf(std::string const &key)
+	{
+		return std::stoll(key.substr(3));
+	}
+
+} // namespace
+
+void base::test::TestFileDictionaryCache()
+{
+	std::cout << std::endl
+			  << CODE_POS_STR;
+
+	constexpr int64_t max_open_file_count = 16;
+
+	base::Path workspace = base::filesystem::CurrentPath() + base::Path{"TestFileDictionaryCache"};
+	base::filesystem::Remove(workspace);
+	base::filesystem::EnsureDirectory(workspace);
+
+	base::filesystem::FileDictionary dictionary{workspace, max_open_file_count};
+	for (int64_t index = 0; index < FileCount; index++)
+	{
+		uint8_t buffer[FileSize];
+		for (int64_t i = 0; i < FileSize; i++)
+		{
+			buffer[i] = ByteOf(index, i);
+		}
+
+		dictionary.Set(KeyOf(index), nullptr);
+		std::shared_ptr<base::Stream> const *stream = dictionary.Find(KeyOf(index));
+		if (stream == nullptr)
+		{
+			throw std::runtime_error{CODE_POS_STR + "刚设置的元素找不到。"};
+		}
+
+		(*stream)->Write(base::ReadOnlySpan{buffer, FileSize});
+		(*stream)->Flush();
+
+		// Set 创建的文件也放在缓存中。
+		if (!(dictionary.StreamCache().Count() <= max_open_file_count))
+		{
+			throw std::runtime_error{CODE_POS_STR + "打开的文件数超过上限。"};
+		}
+	}
+
+	// 键。
+	{
+		std::vector<std::string> keys = dictionary.Keys();
+		std::vector<std::string> expected;
+		for (int64_t index = 0; index < FileCount; index++)
+		{
+			expected.push_back(KeyOf(index));
+		}
+
+		std::sort(keys.begin(), keys.end());
+		std::sort(expected.begin(), expected.end());
+		if (keys != expected)
+		{
+			throw std::runtime_error{CODE_POS_STR + "Keys 返回的键错误。"};
+		}
+	}
+
+	// 只迭代不读写，不应该打开文件。
+	{
+		int64_t open_count = dictionary.StreamCache().OpenCount();
+		int64_t count = 0;
+		for (auto &pair : dictionary)
+		{
+			if (pair.second == nullptr)
+			{
+				throw std::runtime_error{CODE_POS_STR + "迭代得到空的流。"};
+			}
+
+			count++;
+		}
+
+		if (count != FileCount)
+		{
+			throw std::runtime_error{CODE_POS_STR + "迭代的元素个数错误。"};
+		}
+
+		if (dictionary.StreamCache().OpenCount() != open_count)
+		{
+			throw std::runtime_error{CODE_POS_STR + "只迭代不应该打开文件。"};
+		}
+	}
+
+	// 持有所有流，交错读取，打开的文件数不超过上限。
+	{
+		std::vector<std::pair<int64_t, std::shared_ptr<base::Stream>>> streams;
+		for (auto &pair : dictionary)
+		{
+			streams.emplace_back(IndexOf(pair.first), pair.second);
+		}
+
+		uint8_t buffer[FileSize / 2];
+		for (auto &pair : streams)
+		{
+			if (pair.second->ReadExactly(base::Span{buffer, FileSize / 2}) != FileSize / 2)
+			{
+				throw std::runtime_error{CODE_POS_STR + "读到的长度错误。"};
+			}
+
+			if (!(dictionary.StreamCache().Count() <= max_open_file_count))
+			{
+				throw std::runtime_error{CODE_POS_STR + "打开的文件数超过上限。"};
+			}
+		}
+
+		// 第一个流的文件早就被缓存丢弃了，要重新打开，并且从上次的位置继续读。
+		for (auto &pair : streams)
+		{
+			if (pair.second->ReadExactly(base::Span{buffer, FileSize / 2}) != FileSize / 2)
+			{
+				throw std::runtime_error{CODE_POS_STR + "读到的长度错误。"};
+			}
+
+			for (int64_t i = 0; i < FileSize / 2; i++)
+			{
+				if (buffer[i] != ByteOf(pair.first, FileSize / 2 + i))
+				{
+					throw std::runtime_error{CODE_POS_STR + "被丢弃后重新打开，读到的内容错误。"};
+				}
+			}
+		}
+
+		if (!(dictionary.StreamCache().Count() <= max_open_file_count))
+		{
+			throw std::runtime_error{CODE_POS_STR + "打开的文件数超过上限。"};
+		}
+	}
+
+	// 只读打开。
+	{
+		std::shared_ptr<base::Stream> stream = dictionary.OpenReadOnly(KeyOf(7));
+		std::shared_ptr<base::filesystem::ReadOnlyMemoryMapFileStream> map_stream = std::dynamic_pointer_cast<base::filesystem::ReadOnlyMemoryMapFileStream>(stream);
+		if (map_stream == nullptr)
+		{
+			throw std::runtime_error{CODE_POS_STR + "小文件应该被映射。"};
+		}
+
+		if (map_stream->Span().Size() != FileSize)
+		{
+			throw std::runtime_error{CODE_POS_STR + "映射的长度错误。"};
+		}
+
+		if (map_stream->Span()[FileSize - 1] != ByteOf(7, FileSize - 1))
+		{
+			throw std::runtime_error{CODE_POS_STR + "映射的内容错误。"};
+		}
+
+		CheckContent(*stream, 7);
+
+		stream = dictionary.OpenReadOnly(KeyOf(8), FileSize - 1);
+		if (std::dynamic_pointer_cast<base::filesystem::ReadOnlyMemoryMapFileStream>(stream) != nullptr)
+		{
+			throw std::runtime_error{CODE_POS_STR + "超过上限的文件不应该被映射。"};
+		}
+
+		CheckContent(*stream, 8);
+
+		if (dictionary.OpenReadOnly("no_such_key") != nullptr)
+		{
+			throw std::runtime_error{CODE_POS_STR + "不存在的键应该返回空指针。"};
+		}
+
+		// 大文件真正用 mmap 映射。
+		std::vector<uint8_t> large(100 * 1024);
+		for (size_t i = 0; i < large.size(); i++)
+		{
+			large[i] = static_cast<uint8_t>(i * 7);
+		}
+
+		dictionary.Set("large", nullptr);
+		(*dictionary.Find("large"))->Write(base::ReadOnlySpan{large.data(), static_cast<int64_t>(large.size())});
+		map_stream = std::dynamic_pointer_cast<base::filesystem::ReadOnlyMemoryMapFileStream>(dictionary.OpenReadOnly("large", INT64_MAX));
+		if (map_stream == nullptr)
+		{
+			throw std::runtime_error{CODE_POS_STR + "大文件应该被映射。"};
+		}
+
+		if (map_stream->Span().Size() != static_cast<int64_t>(large.size()))
+		{
+			throw std::runtime_error{CODE_POS_STR + "映射的长度错误。"};
+		}
+
+		if (!std::equal(large.begin(), large.end(), map_stream->Span().Buffer()))
+		{
+			throw std::runtime_error{CODE_POS_STR + "映射的内容错误。"};
+		}
+
+		map_stream->Close();
+		if (!dictionary.Remove("large"))
+		{
+			throw std::runtime_error{CODE_POS_STR + "移除元素失败。"};
+		}
+	}
+
+	// 速度。
+	constexpr int64_t repeat_count = 5;
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (int64_t i = 0; i < repeat_count; i++)
+	{
+		// 旧的做法：迭代时每个元素都打开文件。
+		int64_t count = 0;
+		for (base::filesystem::DirectoryEntry const &entry : base::filesystem::DirectoryEntryEnumerable{workspace})
+		{
+			std::shared_ptr<base::Stream> stream = base::file::OpenExisting(entry.Path());
+			(void)stream;
+			count++;
+		}
+
+		if (count != FileCount)
+		{
+			throw std::runtime_error{CODE_POS_STR + "元素个数错误。"};
+		}
+	}
+
+	std::chrono::duration<double> open_all_elapsed = std::chrono::steady_clock::now() - start;
+
+	start = std::chrono::steady_clock::now();
+	for (int64_t i = 0; i < repeat_count; i++)
+	{
+		if (static_cast<int64_t>(dictionary.Keys().size()) != FileCount)
+		{
+			throw std::runtime_error{CODE_POS_STR + "元素个数错误。"};
+		}
+	}
+
+	std::chrono::duration<double> keys_elapsed = std::chrono::steady_clock::now() - start;
+
+	start = std::chrono::steady_clock::now();
+	for (int64_t i = 0; i < repeat_count; i++)
+	{
+		for (int64_t index = 0; index < FileCount; index++)
+		{
+			std::shared_ptr<base::Stream> const *stream = dictionary.Find(KeyOf(index));
+			(*stream)->SetPosition(0);
+			CheckContent(**stream, index);
+		}
+	}
+
+	std::chrono::duration<double> lazy_read_elapsed = std::chrono::steady_clock::now() - start;
+
+	start = std::chrono::steady_clock::now();
+	for (int64_t i = 0; i < repeat_count; i++)
+	{
+		for (int64_t index = 0; index < FileCount; index++)
+		{
+			CheckContent(*dictionary.OpenReadOnly(KeyOf(index)), index);
+		}
+	}
+
+	std::chrono::duration<double> map_read_elapsed = std::chrono::steady_clock::now() - start;
+
+	dictionary.Clear();
+	base::filesystem::Remove(workspace);
+
+	double files = static_cast<double>(FileCount * repeat_count);
+	std::cout << FileCount << " 个文件，迭代：逐个打开 " << files / open_all_elapsed.count() / 1e3 << " k个/s, "
+			  << "Keys " << files / keys_elapsed.count() / 1e3 << " k个/s; "
+			  << "读取：LazyFileStream " << files / lazy_read_elapsed.count() / 1e3 << " k个/s, "
+			  << "OpenReadOnly " << files / map_read_elapsed.count() / 1e3 << " k个/s" << std::endl;
+}
+
+#endif // HAS_THREAD
@@ -0,0 +1,18 @@
+#pragma once
+
+#if HAS_THREAD
+
+namespace base
+{
+	namespace test
+	{
+		///
+		/// @brief 检查文件字典的惰性打开、打开文件数上限和内存映射读取，与逐个打开文件的
+		/// 旧做法比较速度。
+		///
+		void TestFileDictionaryCache();
+
+	} // namespace test
+} // namespace base
+
+#endif // HAS_THREAD
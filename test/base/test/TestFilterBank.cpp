@@ -0,0 +1,249 @@
+#include "TestFilterBank.h" // IWYU pragma: keep
+#include "base/math/FastInt64Fraction.h"
+#include "base/math/FeedbackInertialElement.h"
+#include "base/math/FeedbackInertialElementBank.h"
+#include "base/math/HysteresisElement.h"
+#include "base/math/HysteresisElementBank.h"
+#include "base/math/InertialElement.h"
+#include "base/math/InertialElementBank.h"
+#include "base/string/define.h"
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if HAS_THREAD
+
+namespace
+{
+	constexpr int64_t _channel_count = 2000;
+	constexpr int64_t _frame_count = 100;
+
+	///
+	/// @brief 按帧交错排列的多通道测试信号。
+	///
+	/// @return
+	///
+	std::vector<double> CreateFrames()
+	{
+		std::vector<double> frames;
+		frames.reserve(_channel_count * _frame_count);
+		for (int64_t frame = 0; frame < _frame_count; frame++)
+		{
+			for (int64_t channel = 0; channel < _channel_count; channel++)
+			{
+				frames.push_back(std::sin(static_cast<double>(frame * 3 + channel) / 20) * 10);
+			}
+		}
+
+		return frames;
+	}
+
+} // namespace
+
+void base::test::TestFilterBank()
+{
+	std::vector<double> frames = CreateFrames();
+
+	{
+		std::cout << std::endl
+				  << CODE_POS_STR;
+
+		// 单通道块处理与逐个输入一致。
+		std::vector<double> samples(_frame_count);
+		for (int64_t i = 0; i < _frame_count; i++)
+		{
+			samples[i] = frames[i * _channel_count];
+		}
+
+		base::FeedbackInertialElement<double> filter1{10, 1000};
+		base::FeedbackInertialElement<double> filter2{10, 1000};
+		std::vector<double> block_output(_frame_count);
+		filter2.Input(base::ReadOnlyArraySpan<double>{samples.data(), _frame_count},
+					  base::ArraySpan<double>{block_output.data(), _frame_count});
+
+		int64_t mismatch_count = 0;
+		for (int64_t i = 0; i < _frame_count; i++)
+		{
+			if (filter1.Input(samples[i]) != block_output[i])
+			{
+				mismatch_count++;
+			}
+		}
+
+		if (mismatch_count != 0)
+		{
+			throw std::runtime_error{CODE_POS_STR + "FeedbackInertialElement 块处理与逐个输入的结果不一致，个数：" + std::to_string(mismatch_count)};
+		}
+
+		std::cout << "FeedbackInertialElement 块处理与逐个输入的结果一致。" << std::endl;
+
+		base::HysteresisElement hys1{
+			base::HysteresisElement_RisingThreshold{3},
+			base::HysteresisElement_FallenThreshold{-3},
+		};
+
+		base::HysteresisElement hys2 = hys1;
+		std::unique_ptr<bool[]> hys_output{new bool[_frame_count]};
+		hys2.Input(base::ReadOnlyArraySpan<double>{samples.data(), _frame_count},
+				   base::ArraySpan<bool>{hys_output.get(), _frame_count});
+
+		mismatch_count = 0;
+		for (int64_t i = 0; i < _frame_count; i++)
+		{
+			if (hys1.Input(samples[i]) != hys_output[i])
+			{
+				mismatch_count++;
+			}
+		}
+
+		if (mismatch_count != 0)
+		{
+			throw std::runtime_error{CODE_POS_STR + "HysteresisElement 块处理与逐个输入的结果不一致，个数：" + std::to_string(mismatch_count)};
+		}
+
+		std::cout << "HysteresisElement 块处理与逐个输入的结果一致。" << std::endl;
+	}
+
+	{
+		std::cout << std::endl
+				  << CODE_POS_STR;
+
+		// 多通道滤波器组与逐通道逐样本处理一致。
+		std::vector<base::FeedbackInertialElement<double>> filters(_channel_count,
+																   base::FeedbackInertialElement<double>{10, 1000});
+
+		base::FeedbackInertialElementBank<double> bank{_channel_count, 10, 1000};
+		std::vector<double> outputs(frames.size());
+		bank.Input(base::ReadOnlyArraySpan<double>{frames.data(), static_cast<int64_t>(frames.size())},
+				   base::ArraySpan<double>{outputs.data(), static_cast<int64_t>(outputs.size())});
+
+		int64_t mismatch_count = 0;
+		for (int64_t frame = 0; frame < _frame_count; frame++)
+		{
+			for (int64_t channel = 0; channel < _channel_count; channel++)
+			{
+				int64_t index = frame * _channel_count + channel;
+				if (filters[channel].Input(frames[index]) != outputs[index])
+				{
+					mismatch_count++;
+				}
+			}
+		}
+
+		if (mismatch_count != 0)
+		{
+			throw std::runtime_error{CODE_POS_STR + "FeedbackInertialElementBank 与逐通道逐个输入的结果不一致，个数：" + std::to_string(mismatch_count)};
+		}
+
+		std::cout << "FeedbackInertialElementBank 与逐通道逐个输入的结果一致。" << std::endl;
+
+		std::vector<base::HysteresisElement> hys_elements(_channel_count,
+														  base::HysteresisElement{
+															  base::HysteresisElement_RisingThreshold{3},
+															  base::HysteresisElement_FallenThreshold{-3},
+														  });
+
+		base::HysteresisElementBank hys_bank{
+			_channel_count,
+			base::HysteresisElement_RisingThreshold{3},
+			base::HysteresisElement_FallenThreshold{-3},
+		};
+
+		std::unique_ptr<bool[]> hys_outputs{new bool[frames.size()]};
+		hys_bank.Input(base::ReadOnlyArraySpan<double>{frames.data(), static_cast<int64_t>(frames.size())},
+					   base::ArraySpan<bool>{hys_outputs.get(), static_cast<int64_t>(frames.size())});
+
+		mismatch_count = 0;
+		for (int64_t frame = 0; frame < _frame_count; frame++)
+		{
+			for (int64_t channel = 0; channel < _channel_count; channel++)
+			{
+				int64_t index = frame * _channel_count + channel;
+				if (hys_elements[channel].Input(frames[index]) != hys_outputs[index])
+				{
+					mismatch_count++;
+				}
+			}
+		}
+
+		if (mismatch_count != 0)
+		{
+			throw std::runtime_error{CODE_POS_STR + "HysteresisElementBank 与逐通道逐个输入的结果不一致，个数：" + std::to_string(mismatch_count)};
+		}
+
+		std::cout << "HysteresisElementBank 与逐通道逐个输入的结果一致。" << std::endl;
+
+		// InertialElementBank 用浮点数代替分数，只比较误差。
+		base::InertialElement element{
+			base::FastInt64Fraction{1, 100},
+			base::FastInt64Fraction{1, 10000},
+		};
+
+		base::InertialElementBank<double> inertial_bank{1};
+		inertial_bank.SetChannel(0, element);
+
+		double max_error = 0;
+		for (int64_t frame = 0; frame < _frame_count; frame++)
+		{
+			double x = frames[frame * _channel_count];
+			inertial_bank.Input(base::ReadOnlyArraySpan<double>{&x, 1});
+			double expected = static_cast<double>(element.Input(base::FastInt64Fraction{static_cast<int64_t>(x * 1000 * 1000), 1000 * 1000}));
+			double error = std::abs(expected - inertial_bank.CurrentOutput(0));
+			if (error > max_error)
+			{
+				max_error = error;
+			}
+		}
+
+		std::cout << "InertialElementBank 与 InertialElement 的最大误差: " << max_error << std::endl;
+
+		// 输入被截断到 1e-6 的分辨率，惯性环节的稳态增益为 1, 所以误差应该在同一量级。
+		if (!(max_error < 1e-5))
+		{
+			throw std::runtime_error{CODE_POS_STR + "InertialElementBank 与 InertialElement 的误差过大：" + std::to_string(max_error)};
+		}
+	}
+
+	{
+		std::cout << std::endl
+				  << CODE_POS_STR;
+
+		// 吞吐量。
+		std::vector<base::FeedbackInertialElement<double>> filters(_channel_count,
+																   base::FeedbackInertialElement<double>{10, 1000});
+
+		std::vector<double> outputs(frames.size());
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for (int64_t frame = 0; frame < _frame_count; frame++)
+		{
+			for (int64_t channel = 0; channel < _channel_count; channel++)
+			{
+				int64_t index = frame * _channel_count + channel;
+				outputs[index] = filters[channel].Input(frames[index]);
+			}
+		}
+
+		std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+		std::chrono::nanoseconds scalar_elapsed = end - start;
+
+		base::FeedbackInertialElementBank<double> bank{_channel_count, 10, 1000};
+		start = std::chrono::steady_clock::now();
+		bank.Input(base::ReadOnlyArraySpan<double>{frames.data(), static_cast<int64_t>(frames.size())},
+				   base::ArraySpan<double>{outputs.data(), static_cast<int64_t>(outputs.size())});
+
+		end = std::chrono::steady_clock::now();
+		std::chrono::nanoseconds bank_elapsed = end - start;
+
+		double sample_count = static_cast<double>(frames.size());
+		std::cout << "FeedbackInertialElement 逐个处理: " << static_cast<double>(scalar_elapsed.count()) / sample_count << " ns/样本" << std::endl;
+		std::cout << "FeedbackInertialElementBank: " << static_cast<double>(bank_elapsed.count()) / sample_count << " ns/样本" << std::endl;
+	}
+}
+
+#endif // HAS_THREAD
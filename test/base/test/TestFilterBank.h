@@ -0,0 +1,17 @@
+#pragma once
+
+#if HAS_THREAD
+
+namespace base
+{
+	namespace test
+	{
+		///
+		/// @brief 检查块处理接口和多通道滤波器组与逐个样本处理的结果是否一致，并测试吞吐量。
+		///
+		void TestFilterBank();
+
+	} // namespace test
+} // namespace base
+
+#endif // HAS_THREAD
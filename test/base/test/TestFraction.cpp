@@ -5,6 +5,7 @@
 #include <iostream>
 #include <limits>
 #include <numbers>
+#include <stdexcept>
 
 #if HAS_THREAD
 
@@ -66,6 +67,108 @@ void base::test::TestFraction()
 		f.ReduceResolution(base::Fraction{1, std::numeric_limits<int64_t>::max()});
 		std::cout << "降低分辨率后的分数: " << f << std::endl;
 	}
+
+	{
+		std::cout << std::endl
+				  << CODE_POS_STR;
+
+		// int64_t 表示法与大整型表示法之间的升级和降级。
+		constexpr int64_t max = std::numeric_limits<int64_t>::max();
+		constexpr int64_t min = std::numeric_limits<int64_t>::min();
+		base::BigInteger big_max{max};
+		base::BigInteger big_min{min};
+
+		// 加减法越过 int64_t 的范围。
+		base::Fraction sum = base::Fraction{max, 1} + base::Fraction{1, 1};
+		if (!sum.IsBig() || sum.Num() != big_max + 1 || sum.Den() != 1)
+		{
+			throw std::runtime_error{CODE_POS_STR + "INT64_MAX + 1 的结果错误。"};
+		}
+
+		sum = sum - base::Fraction{1};
+		if (sum.IsBig() || sum != base::Fraction{max})
+		{
+			throw std::runtime_error{CODE_POS_STR + "INT64_MAX + 1 - 1 应该降级回 int64_t 表示法。"};
+		}
+
+		base::Fraction difference = base::Fraction{-max} - base::Fraction{1};
+		if (!difference.IsBig() || difference.Num() != big_min || difference != base::Fraction{min})
+		{
+			throw std::runtime_error{CODE_POS_STR + "-INT64_MAX - 1 的结果错误。"};
+		}
+
+		// int64_t 的最小值取相反数。
+		base::Fraction negative_min = -base::Fraction{min};
+		if (!negative_min.IsBig() || negative_min.Num() != big_max + 1)
+		{
+			throw std::runtime_error{CODE_POS_STR + "-INT64_MIN 的结果错误。"};
+		}
+
+		if (-negative_min != base::Fraction{min} || base::Fraction{min, -1} != negative_min)
+		{
+			throw std::runtime_error{CODE_POS_STR + "INT64_MIN 取相反数的结果错误。"};
+		}
+
+		// 乘除法越过 int64_t 的范围，然后再缩小回来。
+		base::Fraction product = base::Fraction{max} * base::Fraction{2};
+		if (!product.IsBig() || product.Num() != big_max * 2)
+		{
+			throw std::runtime_error{CODE_POS_STR + "INT64_MAX * 2 的结果错误。"};
+		}
+
+		product = product * base::Fraction{1, 2};
+		if (product.IsBig() || product != base::Fraction{max})
+		{
+			throw std::runtime_error{CODE_POS_STR + "INT64_MAX * 2 / 2 应该降级回 int64_t 表示法。"};
+		}
+
+		base::Fraction quotient = base::Fraction{1, max} / base::Fraction{max};
+		if (!quotient.IsBig() || quotient.Num() != 1 || quotient.Den() != big_max * big_max)
+		{
+			throw std::runtime_error{CODE_POS_STR + "(1 / INT64_MAX) / INT64_MAX 的结果错误。"};
+		}
+
+		quotient = quotient / base::Fraction{1, max};
+		if (quotient.IsBig() || quotient != base::Fraction{1, max})
+		{
+			throw std::runtime_error{CODE_POS_STR + "除法的结果应该降级回 int64_t 表示法。"};
+		}
+
+		quotient = base::Fraction{min, 1} / base::Fraction{-1};
+		if (quotient != negative_min)
+		{
+			throw std::runtime_error{CODE_POS_STR + "INT64_MIN / -1 的结果错误。"};
+		}
+
+		// 两个大整型表示的分数相加，结果能用 int64_t 表示。
+		base::BigInteger big_den = base::BigInteger{1} << 70;
+		base::Fraction shrunk = base::Fraction{big_den + 1, big_den} - base::Fraction{base::BigInteger{1}, big_den};
+		if (shrunk.IsBig() || shrunk != base::Fraction{1})
+		{
+			throw std::runtime_error{CODE_POS_STR + "大整型相减的结果应该降级回 int64_t 表示法。"};
+		}
+
+		// 交叉相乘会溢出 int64_t 的比较。
+		// (max - 1) / max 与 (max - 2) / (max - 1) 交叉相乘的差为 1.
+		base::Fraction left{max - 1, max};
+		base::Fraction right{max - 2, max - 1};
+		if (!(left > right) || !(right < left) || left == right || !(left >= right) || right >= left)
+		{
+			throw std::runtime_error{CODE_POS_STR + "接近 int64_t 范围的比较错误。"};
+		}
+
+		if (!(base::Fraction{min} < base::Fraction{-max}) || !(base::Fraction{max} < negative_min))
+		{
+			throw std::runtime_error{CODE_POS_STR + "int64_t 表示法与大整型表示法之间的比较错误。"};
+		}
+
+		if (!(base::Fraction{1, max} > base::Fraction{1} / negative_min))
+		{
+			throw std::runtime_error{CODE_POS_STR + "分母接近 int64_t 范围的比较错误。"};
+		}
+
+		std::cout << "int64_t 表示法与大整型表示法之间的转换正确。" << std::endl;
+	}
 }
 
 #endif // HAS_THREAD
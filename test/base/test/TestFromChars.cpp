@@ -0,0 +1,407 @@
+#include "TestFromChars.h" // IWYU pragma: keep
+#include "base/container/ArraySpan.h"
+#include "base/math/Xoshiro256PlusPlus.h"
+#include "base/stream/ReadOnlySpan.h"
+#include "base/string/define.h"
+#include "base/string/Parse.h"
+#include "base/string/String.h"
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if HAS_THREAD
+
+namespace
+{
+	///
+	/// @brief 检查 base::FromChars 与 std::from_chars 的结果和 ptr 完全一致。
+	///
+	/// @param str
+	///
+	template <typename T>
+	void CheckSameAsStd(std::string const &str)
+	{
+		char const *first = str.data();
+		char const *last = str.data() + str.size();
+
+		T expected{};
+		std::from_chars_result expected_result = std::from_chars(first, last, expected);
+
+		T actual{};
+		std::from_chars_result actual_result = base::FromChars(first, last, actual);
+
+		if (actual_result.ec != expected_result.ec)
+		{
+			throw std::runtime_error{CODE_POS_STR + "ec 与 std::from_chars 不同：" + str};
+		}
+
+		if (actual_result.ptr != expected_result.ptr)
+		{
+			throw std::runtime_error{CODE_POS_STR + "ptr 与 std::from_chars 不同：" + str};
+		}
+
+		if (expected_result.ec == std::errc{})
+		{
+			if (std::memcmp(&actual, &expected, sizeof(T)) != 0)
+			{
+				throw std::runtime_error{CODE_POS_STR + "结果与 std::from_chars 不同：" + str};
+			}
+		}
+	}
+
+	///
+	/// @brief 生成 count 行、每行 column_count 列的 10 进制小数。
+	///
+	/// @param count
+	/// @param column_count
+	/// @return
+	///
+	std::string GenerateCsv(int64_t count, int64_t column_count)
+	{
+		base::Xoshiro256PlusPlus generator{2024};
+		std::string csv;
+		for (int64_t i = 0; i < count; i++)
+		{
+			for (int64_t column = 0; column < column_count; column++)
+			{
+				if (column > 0)
+				{
+					csv += ',';
+				}
+
+				// 形如 -1234.567 的测量值。
+				int64_t value = static_cast<int64_t>(generator() % 20000000) - 10000000;
+				csv += std::to_string(value / 1000);
+				csv += '.';
+				std::string fraction = std::to_string(std::abs(value % 1000));
+				csv += std::string(3 - fraction.size(), '0') + fraction;
+			}
+
+			csv += '\n';
+		}
+
+		return csv;
+	}
+
+} // namespace
+
+void base::test::TestFromChars()
+{
+	std::cout << std::endl
+			  << CODE_POS_STR;
+
+	{
+		for (char const *str : {"0", "7", "-7", "12345678", "123456789", "-9223372036854775808",
+										"9223372036854775807", "9223372036854775808", "-9223372036854775809",
+										"00000000000000000000000012", "18446744073709551615", "18446744073709551616",
+										"-", "", "x", "12x", "1234567812345678abc", "+5"})
+		{
+			CheckSameAsStd<int64_t>(str);
+			CheckSameAsStd<uint64_t>(str);
+			CheckSameAsStd<int32_t>(str);
+			CheckSameAsStd<uint8_t>(str);
+		}
+
+		int64_t value = 0;
+		if (base::TryParse(base::ReadOnlySpan{"-0x10"}, value) != false)
+		{
+			throw std::runtime_error{CODE_POS_STR + "0x 前缀不属于数字。"};
+		}
+
+		if (!(base::TryParse(base::ReadOnlySpan{"-10"}, value, 16) && value == -16))
+		{
+			throw std::runtime_error{CODE_POS_STR + "16 进制解析错误。"};
+		}
+
+		if (!(base::TryParse(base::ReadOnlySpan{"777"}, value, 8) && value == 511))
+		{
+			throw std::runtime_error{CODE_POS_STR + "8 进制解析错误。"};
+		}
+
+		if (base::TryParse(base::ReadOnlySpan{"12 "}, value) != false)
+		{
+			throw std::runtime_error{CODE_POS_STR + "不接受尾部的空白。"};
+		}
+
+		std::cout << "整数与 std::from_chars 一致。" << std::endl;
+	}
+
+	{
+		for (char const *str : {"0", "-0", "1", "0.1", "-12.5", "3.14159", "1e10", "1E-5", "2.5e+3", "1e",
+										"1e+", ".5", "5.", ".", "-", "inf", "-nan", "0.000000000000000000000001",
+										"123456789012345678901234567890", "9007199254740993", "1e23", "1e-400",
+										"1e400", "4.9406564584124654e-324", "0.30000000000000004", "000123.4500",
+										"1.7976931348623157e308", "12.34abc", "+1"})
+		{
+			CheckSameAsStd<double>(str);
+			CheckSameAsStd<float>(str);
+		}
+
+		// 随机的有限 double 的最短表示要能精确还原。
+		base::Xoshiro256PlusPlus generator{7};
+		for (int64_t i = 0; i < 100000; i++)
+		{
+			uint64_t bits = generator();
+			double value = 0;
+			std::memcpy(&value, &bits, sizeof(value));
+			if (!std::isfinite(value))
+			{
+				continue;
+			}
+
+			char buffer[64];
+			std::to_chars_result to_chars_result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+			CheckSameAsStd<double>(std::string{buffer, to_chars_result.ptr});
+
+			// 常见的几位小数的测量值，走快速路径。
+			std::string short_str = std::to_string(static_cast<int64_t>(bits % 2000000) - 1000000) + "." +
+									std::to_string(bits % 1000);
+			CheckSameAsStd<double>(short_str);
+			CheckSameAsStd<float>(short_str);
+		}
+
+		std::cout << "浮点数与 std::from_chars 一致。" << std::endl;
+	}
+
+	{
+		if (base::Parse<int32_t>(base::String{"0x10"}) != 16)
+		{
+			throw std::runtime_error{CODE_POS_STR + "Parse 16 进制错误。"};
+		}
+
+		if (base::Parse<int32_t>(base::String{"010"}) != 8)
+		{
+			throw std::runtime_error{CODE_POS_STR + "Parse 8 进制错误。"};
+		}
+
+		if (base::Parse<int64_t>(base::String{"-0x10"}) != -16)
+		{
+			throw std::runtime_error{CODE_POS_STR + "Parse 负的 16 进制错误。"};
+		}
+
+		if (base::Parse<int8_t>(base::String{"-0x80"}) != -128)
+		{
+			throw std::runtime_error{CODE_POS_STR + "Parse 最小值错误。"};
+		}
+
+		if (base::Parse<double>(base::String{"-0x10.8"}) != -16.5)
+		{
+			throw std::runtime_error{CODE_POS_STR + "Parse 16 进制小数错误。"};
+		}
+
+		if (base::Parse<double>(base::String{"0.5"}) != 0.5)
+		{
+			throw std::runtime_error{CODE_POS_STR + "Parse 0.5 错误。"};
+		}
+
+		if (base::Parse<double>(base::String{"10.5"}, 8) != 8.625)
+		{
+			throw std::runtime_error{CODE_POS_STR + "Parse 8 进制小数错误。"};
+		}
+
+		// 与 std::stoll 一样跳过开头的空白字符和正号。
+		if (base::Parse<int32_t>(base::String{" +12"}, 10) != 12 ||
+			base::Parse<int32_t>(base::String{"\t-12"}, 10) != -12 ||
+			base::Parse<uint16_t>(base::String{"  ff"}, 16) != 255)
+		{
+			throw std::runtime_error{CODE_POS_STR + "Parse 没有跳过空白字符或正号。"};
+		}
+
+		if (base::Parse<int32_t>(base::String{" +0x10"}) != 16 || base::Parse<int64_t>(base::String{"\n-010"}) != -8)
+		{
+			throw std::runtime_error{CODE_POS_STR + "带前缀的 Parse 没有跳过空白字符或正号。"};
+		}
+
+		bool thrown = false;
+		try
+		{
+			base::Parse<int32_t>(base::String{"+-1"}, 10);
+		}
+		catch (std::invalid_argument const &)
+		{
+			thrown = true;
+		}
+
+		if (!thrown)
+		{
+			throw std::runtime_error{CODE_POS_STR + "正号后面不能再有负号。"};
+		}
+
+		// 超出 64 位整型的范围抛出 std::out_of_range, 与 std::stoll 相同。
+		thrown = false;
+		try
+		{
+			base::Parse<int64_t>(base::String{"9223372036854775808"});
+		}
+		catch (std::out_of_range const &)
+		{
+			thrown = true;
+		}
+
+		if (!thrown)
+		{
+			throw std::runtime_error{CODE_POS_STR + "超出 int64_t 的范围时应该抛出 std::out_of_range."};
+		}
+
+		if (base::Parse<int64_t>(base::String{"-9223372036854775808"}, 10) != std::numeric_limits<int64_t>::min())
+		{
+			throw std::runtime_error{CODE_POS_STR + "Parse int64_t 最小值错误。"};
+		}
+
+		// 在 64 位整型的范围内，但是超出 T 的范围，抛出 std::runtime_error.
+		thrown = false;
+		try
+		{
+			base::Parse<int8_t>(base::String{"128"});
+		}
+		catch (std::runtime_error const &)
+		{
+			thrown = true;
+		}
+
+		if (!thrown)
+		{
+			throw std::runtime_error{CODE_POS_STR + "超出 int8_t 的范围时应该抛出 std::runtime_error."};
+		}
+
+		thrown = false;
+		try
+		{
+			base::Parse<uint32_t>(base::String{"-1"});
+		}
+		catch (std::runtime_error const &)
+		{
+			thrown = true;
+		}
+
+		if (!thrown)
+		{
+			throw std::runtime_error{CODE_POS_STR + "无符号数不能是负数。"};
+		}
+
+		std::cout << "Parse 正确。" << std::endl;
+	}
+
+	{
+		std::string text = "1,2,3\r\n4,5,6\n\n7,8,9";
+		std::vector<int32_t> values(9);
+		int64_t count = base::ParseDelimited(base::ReadOnlySpan{text}, ',', base::ArraySpan<int32_t>{values.data(), 9});
+		if (!(count == 9 && values[8] == 9))
+		{
+			throw std::runtime_error{CODE_POS_STR + "ParseDelimited 结果错误。"};
+		}
+
+		std::vector<std::vector<double>> columns(3);
+		int64_t row_count = base::ParseColumns(base::ReadOnlySpan{"1.5,2,3\n4,5.25,-6\n"}, ',', columns);
+		if (!(row_count == 2 && columns[1][1] == 5.25 && columns[2][1] == -6))
+		{
+			throw std::runtime_error{CODE_POS_STR + "ParseColumns 结果错误。"};
+		}
+
+		for (char const *bad : {"1,,2\n", "1,2,\n", "1;2\n", "1,2,3,4\n", "1,2\n"})
+		{
+			bool thrown = false;
+			std::vector<std::vector<double>> bad_columns(3);
+			try
+			{
+				base::ParseColumns(base::ReadOnlySpan{bad}, ',', bad_columns);
+			}
+			catch (std::invalid_argument const &)
+			{
+				thrown = true;
+			}
+
+			if (!thrown)
+			{
+				throw std::runtime_error{CODE_POS_STR + "ParseColumns 应该拒绝：" + std::string{bad}};
+			}
+		}
+
+		std::cout << "批量解析正确。" << std::endl;
+	}
+
+	// 吞吐量。
+	{
+		constexpr int64_t line_count = 100000;
+		constexpr int64_t column_count = 4;
+		std::string csv = GenerateCsv(line_count, column_count);
+		double megabytes = static_cast<double>(csv.size()) / 1024 / 1024;
+
+		std::vector<std::vector<double>> columns(column_count);
+		for (std::vector<double> &column : columns)
+		{
+			column.reserve(line_count);
+		}
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		base::ParseColumns(base::ReadOnlySpan{csv}, ',', columns);
+		std::chrono::duration<double> columns_elapsed = std::chrono::steady_clock::now() - start;
+
+		// 原来的做法：拆分出 base::String, 再逐个 base::Parse.
+		double checksum = 0;
+		start = std::chrono::steady_clock::now();
+		base::StringSplitOptions options{};
+		options.remove_empty_substring = true;
+		for (base::String const &line : base::String{csv}.Split('\n', options))
+		{
+			for (base::String const &field : line.Split(',', options))
+			{
+				checksum += base::Parse<double>(field);
+			}
+		}
+
+		std::chrono::duration<double> parse_elapsed = std::chrono::steady_clock::now() - start;
+
+		double fast_checksum = 0;
+		for (std::vector<double> const &column : columns)
+		{
+			for (double value : column)
+			{
+				fast_checksum += value;
+			}
+		}
+
+		if (!(std::abs(checksum - fast_checksum) < 1e-6 * std::abs(checksum) + 1e-6))
+		{
+			throw std::runtime_error{CODE_POS_STR + "两种解析方式的结果不同。"};
+		}
+
+		// 整数。
+		std::vector<uint32_t> integers(line_count);
+		std::string integer_text;
+		base::Xoshiro256PlusPlus generator{1};
+		for (int64_t i = 0; i < line_count; i++)
+		{
+			integer_text += std::to_string(static_cast<uint32_t>(generator())) + '\n';
+		}
+
+		start = std::chrono::steady_clock::now();
+		base::ParseDelimited(base::ReadOnlySpan{integer_text}, ',', base::ArraySpan<uint32_t>{integers.data(), line_count});
+		std::chrono::duration<double> integer_elapsed = std::chrono::steady_clock::now() - start;
+
+		int64_t integer_checksum = 0;
+		start = std::chrono::steady_clock::now();
+		for (base::String const &line : base::String{integer_text}.Split('\n', options))
+		{
+			integer_checksum += base::BaseAndNumberString::Parse(line).NumberString().Length();
+		}
+
+		std::chrono::duration<double> prefix_elapsed = std::chrono::steady_clock::now() - start;
+
+		std::cout << "ParseColumns<double>: " << megabytes / columns_elapsed.count() << " MB/s, "
+				  << "Split + Parse<double>: " << megabytes / parse_elapsed.count() << " MB/s" << std::endl;
+
+		std::cout << "ParseDelimited<uint32_t>: " << line_count / integer_elapsed.count() / 1e6 << " M/s, "
+				  << "仅 BaseAndNumberString::Parse: " << line_count / prefix_elapsed.count() / 1e6 << " M/s, "
+				  << "校验和: " << integers[0] + integer_checksum << std::endl;
+	}
+}
+
+#endif // HAS_THREAD
@@ -0,0 +1,18 @@
+#pragma once
+
+#if HAS_THREAD
+
+namespace base
+{
+	namespace test
+	{
+		///
+		/// @brief 检查 base::FromChars, base::TryParse, 批量解析和 base::Parse 的结果，
+		/// 与 std::from_chars 对比，并与原来经过 BaseAndNumberString 的解析比较吞吐量。
+		///
+		void TestFromChars();
+
+	} // namespace test
+} // namespace base
+
+#endif // HAS_THREAD
@@ -0,0 +1,13 @@
+#include "TestHelper.h" // IWYU pragma: keep
+#include "base/stream/ReadOnlySpan.h"
+#include <bit>
+
+#if HAS_THREAD
+
+base::Mac base::test::MakeMac(uint8_t last)
+{
+	uint8_t buffer[6] = {0x00, 0x0e, 0xcf, 0x00, 0x00, last};
+	return base::Mac{std::endian::big, base::ReadOnlySpan{buffer, 6}};
+}
+
+#endif // HAS_THREAD
@@ -0,0 +1,55 @@
+#pragma once
+#include "base/net/Mac.h"
+#include "base/stream/ReadOnlySpan.h"
+#include "base/string/TextWriter.h"
+#include <cstdint>
+#include <string>
+
+#if HAS_THREAD
+
+namespace base
+{
+	namespace test
+	{
+		///
+		/// @brief 把写入的内容追加到字符串中。
+		///
+		/// @note 用来把 JsonWriter 等写出的文本收集起来，与期望的字符串比较。
+		///
+		class StringTextWriter :
+			public base::TextWriter
+		{
+		private:
+			std::string &_str;
+
+		public:
+			StringTextWriter(std::string &str)
+				: _str(str)
+			{
+			}
+
+			virtual void Write(base::ReadOnlySpan const &span) override
+			{
+				_str.append(reinterpret_cast<char const *>(span.Buffer()), span.Size());
+			}
+
+			virtual void Dispose() override
+			{
+			}
+
+			using base::TextWriter::Write;
+		};
+
+		///
+		/// @brief 以太网测试用的 MAC 地址 00:0e:cf:00:00:last.
+		///
+		/// @param last 最后一个字节，用来区分不同的站。
+		///
+		/// @return
+		///
+		base::Mac MakeMac(uint8_t last);
+
+	} // namespace test
+} // namespace base
+
+#endif // HAS_THREAD
@@ -0,0 +1,257 @@
+#include "TestHex.h" // IWYU pragma: keep
+#include "base/math/Xoshiro256PlusPlus.h"
+#include "base/net/Mac.h"
+#include "base/stream/ReadOnlySpan.h"
+#include "base/stream/Span.h"
+#include "base/string/define.h"
+#include "base/string/encoding/hex.h"
+#include "base/string/ToHexString.h"
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if HAS_THREAD
+
+namespace
+{
+	///
+	/// @brief 用 base::ToHexString 逐字节拼接，作为对照。
+	///
+	/// @param bytes
+	/// @param options
+	/// @return
+	///
+	std::string NaiveEncode(std::vector<uint8_t> const &bytes, base::string::encoding::hex_encode_options const &options)
+	{
+		base::ToHexStringOptions hex_options{};
+		hex_options.with_0x_prefix = false;
+		hex_options.width = 2;
+		hex_options.uppercase = options.uppercase;
+
+		std::string ret;
+		for (size_t i = 0; i < bytes.size(); i++)
+		{
+			if (i > 0)
+			{
+				if (options.bytes_per_line > 0 && i % options.bytes_per_line == 0)
+				{
+					ret += '\n';
+				}
+				else if (options.separator != '\0')
+				{
+					ret += options.separator;
+				}
+			}
+
+			ret += base::ToHexString(bytes[i], hex_options);
+		}
+
+		return ret;
+	}
+
+	bool ThrowsInvalidArgument(std::string const &str, char separator)
+	{
+		std::vector<uint8_t> output(str.size());
+		try
+		{
+			base::string::encoding::hex_decode(base::ReadOnlySpan{str},
+											   base::Span{output.data(), static_cast<int64_t>(output.size())},
+											   separator);
+		}
+		catch (std::invalid_argument const &)
+		{
+			return true;
+		}
+
+		return false;
+	}
+
+} // namespace
+
+void base::test::TestHex()
+{
+	std::cout << std::endl
+			  << CODE_POS_STR;
+
+	base::Xoshiro256PlusPlus generator{38};
+
+	{
+		std::vector<base::string::encoding::hex_encode_options> all_options;
+		for (bool uppercase : {false, true})
+		{
+			for (char separator : {'\0', ' ', ','})
+			{
+				for (int64_t bytes_per_line : {0, 1, 7, 16, 33})
+				{
+					base::string::encoding::hex_encode_options options{};
+					options.uppercase = uppercase;
+					options.separator = separator;
+					options.bytes_per_line = bytes_per_line;
+					all_options.push_back(options);
+				}
+			}
+		}
+
+		for (int64_t size = 0; size < 200; size++)
+		{
+			std::vector<uint8_t> bytes(size);
+			for (uint8_t &b : bytes)
+			{
+				b = static_cast<uint8_t>(generator());
+			}
+
+			for (base::string::encoding::hex_encode_options const &options : all_options)
+			{
+				std::string expected = NaiveEncode(bytes, options);
+				std::string actual = base::string::encoding::hex_encode(base::ReadOnlySpan{bytes.data(), size}, options);
+				if (actual != expected)
+				{
+					throw std::runtime_error{CODE_POS_STR + "编码结果错误，字节数：" + std::to_string(size)};
+				}
+
+				if (base::string::encoding::hex_encoded_size(size, options) != static_cast<int64_t>(actual.size()))
+				{
+					throw std::runtime_error{CODE_POS_STR + "hex_encoded_size 错误。"};
+				}
+
+				if (options.bytes_per_line > 0 && options.separator == '\0')
+				{
+					// 换行但没有分隔符时，解码不接受换行符。
+					continue;
+				}
+
+				std::vector<uint8_t> decoded(size);
+				int64_t decoded_size = base::string::encoding::hex_decode(base::ReadOnlySpan{actual},
+																		  base::Span{decoded.data(), size},
+																		  options.separator);
+
+				if (!(decoded_size == size && decoded == bytes))
+				{
+					throw std::runtime_error{CODE_POS_STR + "解码结果错误，字节数：" + std::to_string(size)};
+				}
+			}
+		}
+
+		std::cout << "编码、解码与逐字节实现一致。" << std::endl;
+	}
+
+	{
+		// 非法字符在 SIMD 块的各个位置都要被发现。
+		for (int64_t position = 0; position < 130; position++)
+		{
+			std::string str(130, 'a');
+			str[position] = 'g';
+			if (!ThrowsInvalidArgument(str, '\0'))
+			{
+				throw std::runtime_error{CODE_POS_STR + "没有发现非法字符，位置：" + std::to_string(position)};
+			}
+
+			str[position] = static_cast<char>(0xc1);
+			if (!ThrowsInvalidArgument(str, '\0'))
+			{
+				throw std::runtime_error{CODE_POS_STR + "没有发现非 ASCII 字符，位置：" + std::to_string(position)};
+			}
+		}
+
+		if (!ThrowsInvalidArgument("abc", '\0'))
+		{
+			throw std::runtime_error{CODE_POS_STR + "奇数个字符应该被拒绝。"};
+		}
+
+		if (!ThrowsInvalidArgument("ab c", ' '))
+		{
+			throw std::runtime_error{CODE_POS_STR + "不成对的字符应该被拒绝。"};
+		}
+
+		if (!ThrowsInvalidArgument("ab,cd", ' '))
+		{
+			throw std::runtime_error{CODE_POS_STR + "不是分隔符的字符应该被拒绝。"};
+		}
+
+		if (ThrowsInvalidArgument("AB cd\r\nEf", ' '))
+		{
+			throw std::runtime_error{CODE_POS_STR + "大小写和换行应该被接受。"};
+		}
+
+		uint8_t mac_buffer[6] = {0x06, 0x05, 0x04, 0x03, 0x02, 0xa1};
+		base::Mac mac{std::endian::little, base::ReadOnlySpan{mac_buffer, 6}};
+		if (mac.ToString() != "a1-02-03-04-05-06")
+		{
+			throw std::runtime_error{CODE_POS_STR + "Mac::ToString 错误：" + mac.ToString()};
+		}
+
+		std::cout << "非法输入被拒绝。" << std::endl;
+	}
+
+	// 吞吐量。
+	{
+		constexpr int64_t size = 1024 * 1024;
+		constexpr int64_t repeat = 20;
+		std::vector<uint8_t> bytes(size);
+		for (uint8_t &b : bytes)
+		{
+			b = static_cast<uint8_t>(generator());
+		}
+
+		base::ReadOnlySpan input{bytes.data(), size};
+		base::string::encoding::hex_encode_options plain_options{};
+		base::string::encoding::hex_encode_options dump_options{};
+		dump_options.separator = ' ';
+		dump_options.bytes_per_line = 16;
+
+		std::vector<uint8_t> text(base::string::encoding::hex_encoded_size(size, dump_options));
+		base::Span text_span{text.data(), static_cast<int64_t>(text.size())};
+		std::vector<uint8_t> decoded(size);
+		base::Span decoded_span{decoded.data(), size};
+		double megabytes = static_cast<double>(size) * repeat / 1024 / 1024;
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for (int64_t i = 0; i < repeat; i++)
+		{
+			base::string::encoding::hex_encode(input, text_span, plain_options);
+		}
+
+		std::chrono::duration<double> plain_elapsed = std::chrono::steady_clock::now() - start;
+
+		start = std::chrono::steady_clock::now();
+		for (int64_t i = 0; i < repeat; i++)
+		{
+			base::string::encoding::hex_decode(base::ReadOnlySpan{text.data(), 2 * size}, decoded_span);
+		}
+
+		std::chrono::duration<double> decode_elapsed = std::chrono::steady_clock::now() - start;
+		if (decoded != bytes)
+		{
+			throw std::runtime_error{CODE_POS_STR + "解码结果错误。"};
+		}
+
+		start = std::chrono::steady_clock::now();
+		for (int64_t i = 0; i < repeat; i++)
+		{
+			base::string::encoding::hex_encode(input, text_span, dump_options);
+		}
+
+		std::chrono::duration<double> dump_elapsed = std::chrono::steady_clock::now() - start;
+
+		// 原来的做法：逐字节调用 base::ToHexString.
+		start = std::chrono::steady_clock::now();
+		int64_t checksum = 0;
+		for (int64_t i = 0; i < repeat; i++)
+		{
+			checksum += static_cast<int64_t>(base::ToHexString(input).size());
+		}
+
+		std::chrono::duration<double> naive_elapsed = std::chrono::steady_clock::now() - start;
+
+		std::cout << "编码: " << megabytes / plain_elapsed.count() << " MB/s, "
+				  << "解码: " << megabytes / decode_elapsed.count() << " MB/s, "
+				  << "带分隔符和换行编码: " << megabytes / dump_elapsed.count() << " MB/s, "
+				  << "逐字节 ToHexString: " << megabytes / naive_elapsed.count() << " MB/s, "
+				  << "校验和: " << checksum << std::endl;
+	}
+}
+
+#endif // HAS_THREAD
@@ -0,0 +1,17 @@
+#pragma once
+
+#if HAS_THREAD
+
+namespace base
+{
+	namespace test
+	{
+		///
+		/// @brief 检查 16 进制编码、解码在各种长度和选项下与逐字节实现一致，测量吞吐量。
+		///
+		void TestHex();
+
+	} // namespace test
+} // namespace base
+
+#endif // HAS_THREAD
@@ -0,0 +1,418 @@
+#include "TestIPAddressParse.h" // IWYU pragma: keep
+#include "base/math/Xoshiro256PlusPlus.h"
+#include "base/net/IPAddress.h"
+#include "base/net/IPEndPoint.h"
+#include "base/net/IPPrefixTable.h"
+#include "base/net/Mac.h"
+#include "base/string/define.h"
+#include "base/string/String.h"
+#include "base/string/StringView.h"
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#if HAS_THREAD
+
+namespace
+{
+	base::IPAddress MakeIPV4(uint32_t value)
+	{
+		uint8_t bytes[4] = {
+			static_cast<uint8_t>(value >> 24),
+			static_cast<uint8_t>(value >> 16),
+			static_cast<uint8_t>(value >> 8),
+			static_cast<uint8_t>(value),
+		};
+
+		return base::IPAddress{std::endian::big, base::ReadOnlySpan{bytes, 4}};
+	}
+
+	///
+	/// @brief 以前 IPAddress 构造函数解析 IPV4 的方法，作为速度的对照。
+	///
+	base::IPAddress ParseBySplit(base::String const &ip_str)
+	{
+		base::StringSplitOptions split_options;
+		split_options.trim_each_substring = true;
+		split_options.remove_empty_substring = false;
+
+		base::List<base::String> sub_string_list = ip_str.Split('.', split_options);
+		uint8_t bytes[4];
+		for (int32_t i = 0; i < 4; i++)
+		{
+			bytes[i] = static_cast<uint8_t>(std::stoi(sub_string_list[i].StdString()));
+		}
+
+		return base::IPAddress{std::endian::big, base::ReadOnlySpan{bytes, 4}};
+	}
+
+} // namespace
+
+void base::test::TestIPAddressParse()
+{
+	std::cout << std::endl
+			  << CODE_POS_STR;
+
+	// 解析和格式化。左边是输入，右边是 RFC 5952 的规范格式。
+	{
+		std::vector<std::pair<std::string, std::string>> cases{
+			{"192.168.1.1", "192.168.1.1"},
+			{"0.0.0.0", "0.0.0.0"},
+			{"255.255.255.255", "255.255.255.255"},
+			{"2001:0db8:85a3:0000:0000:8a2e:0370:7334", "2001:db8:85a3::8a2e:370:7334"},
+			{"2001:DB8::1", "2001:db8::1"},
+			{"::", "::"},
+			{"::1", "::1"},
+			{"fe80::", "fe80::"},
+			{"2001:db8:0:0:1:0:0:1", "2001:db8::1:0:0:1"},
+			{"2001:db8:0:1:1:1:1:1", "2001:db8:0:1:1:1:1:1"},
+			{"::ffff:192.168.1.1", "::ffff:192.168.1.1"},
+			{"::FFFF:c0a8:101", "::ffff:192.168.1.1"},
+			{"::ffff:0.0.0.0", "::ffff:0.0.0.0"},
+			{"::fffe:192.168.1.1", "::fffe:c0a8:101"},
+			{"64:ff9b::10.0.0.1", "64:ff9b::a00:1"},
+			{"1:2:3:4:5:6:1.2.3.4", "1:2:3:4:5:6:102:304"},
+			{"1:2:3:4:5:6:7::", "1:2:3:4:5:6:7:0"},
+		};
+
+		for (auto const &[input, expected] : cases)
+		{
+			base::IPAddress ip{};
+			if (!base::IPAddress::TryParse(base::StringView{input}, ip))
+			{
+				throw std::runtime_error{CODE_POS_STR + "解析失败：" + input};
+			}
+
+			if (ip.ToString() != expected)
+			{
+				throw std::runtime_error{CODE_POS_STR + "格式化错误：" + input + " -> " + ip.ToString()};
+			}
+
+			if (base::IPAddress::Parse(base::StringView{expected}) != ip)
+			{
+				throw std::runtime_error{CODE_POS_STR + "格式化后再解析不相等：" + expected};
+			}
+		}
+
+		base::IPAddress ip{std::endian::big, {192, 168, 1, 1}};
+		if (base::IPAddress{" 192.168.1.1 "} != ip)
+		{
+			throw std::runtime_error{CODE_POS_STR + "构造函数应该忽略首尾空白。"};
+		}
+
+		if (!(ip[3] == 192 && ip[0] == 1))
+		{
+			throw std::runtime_error{CODE_POS_STR + "应该按小端序存放。"};
+		}
+
+		std::vector<std::string> invalid_cases{
+			"",
+			"1.2.3",
+			"1.2.3.4.5",
+			"256.1.1.1",
+			"1..2.3",
+			"1.2.3.4 ",
+			":::",
+			"1:2:3:4:5:6:7:8:9",
+			"1:2:3:4:5:6:7",
+			"1::2::3",
+			"12345::",
+			"1:",
+			":1",
+			"g::1",
+			"::1.2.3",
+			"1.2.3.4::",
+			"1:2:3:4:5:6:7:1.2.3.4",
+			"01.2.3.4",
+			"1.2.3.04",
+			"1.00.3.4",
+			"::ffff:1.2.03.4",
+		};
+
+		for (std::string const &input : invalid_cases)
+		{
+			base::IPAddress ip{};
+			if (base::IPAddress::TryParse(base::StringView{input}, ip))
+			{
+				throw std::runtime_error{CODE_POS_STR + "应该解析失败：" + input};
+			}
+		}
+
+		std::cout << "解析和格式化正确。" << std::endl;
+	}
+
+	// 哈希。
+	{
+		std::unordered_map<base::IPAddress, int> ip_map;
+		std::unordered_set<base::IPEndPoint> end_point_set;
+		std::unordered_set<base::Mac> mac_set;
+		for (uint32_t i = 0; i < 1000; i++)
+		{
+			ip_map[MakeIPV4(0x0a000000 + i)] = static_cast<int>(i);
+			end_point_set.insert(base::IPEndPoint{MakeIPV4(0x0a000000), static_cast<uint16_t>(i)});
+
+			uint8_t mac_bytes[6] = {0x00, 0x0e, 0xcf, 0x00, static_cast<uint8_t>(i >> 8), static_cast<uint8_t>(i)};
+			mac_set.insert(base::Mac{std::endian::big, base::ReadOnlySpan{mac_bytes, 6}});
+		}
+
+		if (!(ip_map.size() == 1000 && ip_map.at(MakeIPV4(0x0a000000 + 123)) == 123))
+		{
+			throw std::runtime_error{CODE_POS_STR + "IPAddress 作为键错误。"};
+		}
+
+		if (end_point_set.size() != 1000)
+		{
+			throw std::runtime_error{CODE_POS_STR + "IPEndPoint 作为键错误。"};
+		}
+
+		if (end_point_set.count(base::IPEndPoint{MakeIPV4(0x0a000000), 999}) != 1)
+		{
+			throw std::runtime_error{CODE_POS_STR + "IPEndPoint 查找错误。"};
+		}
+
+		if (mac_set.size() != 1000)
+		{
+			throw std::runtime_error{CODE_POS_STR + "Mac 作为键错误。"};
+		}
+
+		// IPV4 的 0.0.0.0 和 IPV6 的 :: 类型不同，不相等。
+		if (base::IPAddress{base::IPAddressType::IPV4} == base::IPAddress{base::IPAddressType::IPV6})
+		{
+			throw std::runtime_error{CODE_POS_STR + "不同类型的地址不应该相等。"};
+		}
+
+		std::cout << "哈希正确。" << std::endl;
+	}
+
+	// 前缀表。
+	{
+		base::IPPrefixTable<std::string> table;
+		table.Add("0.0.0.0/0", "默认");
+		table.Add("10.0.0.0/8", "10/8");
+		table.Add("10.1.0.0/16", "10.1/16");
+		table.Add("10.1.2.0/24", "10.1.2/24");
+		table.Add("10.1.2.3/32", "主机");
+		table.Add("192.168.0.0/16", "192.168/16");
+		table.Add("2001:db8::/32", "文档");
+		table.Add("2001:db8:1::/48", "文档 1");
+		table.Add("::1/128", "环回");
+
+		if (*table.Match(base::IPAddress::Parse("10.1.2.3")) != "主机")
+		{
+			throw std::runtime_error{CODE_POS_STR + "最长前缀匹配错误。"};
+		}
+
+		if (*table.Match(base::IPAddress::Parse("10.1.2.4")) != "10.1.2/24")
+		{
+			throw std::runtime_error{CODE_POS_STR + "最长前缀匹配错误。"};
+		}
+
+		if (*table.Match(base::IPAddress::Parse("10.1.3.4")) != "10.1/16")
+		{
+			throw std::runtime_error{CODE_POS_STR + "最长前缀匹配错误。"};
+		}
+
+		if (*table.Match(base::IPAddress::Parse("10.2.3.4")) != "10/8")
+		{
+			throw std::runtime_error{CODE_POS_STR + "最长前缀匹配错误。"};
+		}
+
+		if (*table.Match(base::IPAddress::Parse("11.0.0.1")) != "默认")
+		{
+			throw std::runtime_error{CODE_POS_STR + "默认路由错误。"};
+		}
+
+		if (*table.Match(base::IPAddress::Parse("2001:db8:1::5")) != "文档 1")
+		{
+			throw std::runtime_error{CODE_POS_STR + "IPV6 最长前缀匹配错误。"};
+		}
+
+		if (*table.Match(base::IPAddress::Parse("2001:db8:2::5")) != "文档")
+		{
+			throw std::runtime_error{CODE_POS_STR + "IPV6 最长前缀匹配错误。"};
+		}
+
+		if (*table.Match(base::IPAddress::Parse("::1")) != "环回")
+		{
+			throw std::runtime_error{CODE_POS_STR + "IPV6 主机路由错误。"};
+		}
+
+		if (table.Match(base::IPAddress::Parse("::2")) != nullptr)
+		{
+			throw std::runtime_error{CODE_POS_STR + "IPV6 不应该匹配 IPV4 的默认路由。"};
+		}
+
+		bool thrown = false;
+		try
+		{
+			table.Add("10.1.0.0/16", "重复");
+		}
+		catch (std::invalid_argument const &)
+		{
+			thrown = true;
+		}
+
+		if (!thrown)
+		{
+			throw std::runtime_error{CODE_POS_STR + "重复的网段应该抛出异常。"};
+		}
+
+		// 与逐个比较的结果对照。
+		base::Xoshiro256PlusPlus random{42};
+		base::IPPrefixTable<int> random_table;
+		std::vector<std::pair<uint32_t, int32_t>> prefixes;
+		while (prefixes.size() < 2000)
+		{
+			int32_t length = static_cast<int32_t>(random.Next() % 25) + 8;
+			uint32_t value = static_cast<uint32_t>(random.Next()) & (~uint32_t{0} << (32 - length));
+			bool exists = false;
+			for (auto const &[other_value, other_length] : prefixes)
+			{
+				exists = exists || (other_value == value && other_length == length);
+			}
+
+			if (exists)
+			{
+				continue;
+			}
+
+			random_table.Add(MakeIPV4(value), length, static_cast<int>(prefixes.size()));
+			prefixes.push_back({value, length});
+		}
+
+		for (int32_t i = 0; i < 20000; i++)
+		{
+			// 一半的地址取自网段内，保证有足够多的命中。
+			uint32_t address = static_cast<uint32_t>(random.Next());
+			if (i % 2 == 0)
+			{
+				auto const &[value, length] = prefixes[random.Next() % prefixes.size()];
+				address = value | (address & ~(~uint32_t{0} << (32 - length)));
+			}
+
+			int expected = -1;
+			int32_t expected_length = -1;
+			for (size_t j = 0; j < prefixes.size(); j++)
+			{
+				auto const &[value, length] = prefixes[j];
+				if ((address & (~uint32_t{0} << (32 - length))) == value && length > expected_length)
+				{
+					expected = static_cast<int>(j);
+					expected_length = length;
+				}
+			}
+
+			int const *actual = random_table.Match(MakeIPV4(address));
+			if (!((actual == nullptr && expected < 0) || (actual != nullptr && *actual == expected)))
+			{
+				throw std::runtime_error{CODE_POS_STR + "与逐个比较的结果不同。"};
+			}
+		}
+
+		std::cout << "前缀表正确。" << std::endl;
+	}
+
+	// 速度。
+	{
+		constexpr int64_t count = 1000000;
+		std::vector<std::string> texts;
+		for (int64_t i = 0; i < 1000; i++)
+		{
+			texts.push_back(MakeIPV4(0xc0a80000 + static_cast<uint32_t>(i * 7919)).ToString());
+		}
+
+		uint64_t checksum = 0;
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for (int64_t i = 0; i < count; i++)
+		{
+			checksum += ParseBySplit(base::String{texts[i % 1000]})[0];
+		}
+
+		std::chrono::duration<double> split_elapsed = std::chrono::steady_clock::now() - start;
+
+		start = std::chrono::steady_clock::now();
+		for (int64_t i = 0; i < count; i++)
+		{
+			base::IPAddress ip{};
+			base::IPAddress::TryParse(base::StringView{texts[i % 1000]}, ip);
+			checksum += ip[0];
+		}
+
+		std::chrono::duration<double> parse_elapsed = std::chrono::steady_clock::now() - start;
+
+		base::IPAddress ipv6 = base::IPAddress::Parse("2001:db8:85a3::8a2e:370:7334");
+		char buffer[base::IPAddress::MaxStringLength];
+		start = std::chrono::steady_clock::now();
+		for (int64_t i = 0; i < count; i++)
+		{
+			ipv6[0] = static_cast<uint8_t>(i);
+			checksum += static_cast<uint64_t>(ipv6.Format(base::Span{reinterpret_cast<uint8_t *>(buffer), sizeof(buffer)}));
+		}
+
+		std::chrono::duration<double> format_elapsed = std::chrono::steady_clock::now() - start;
+
+		// 前缀表中有 2000 个网段，与逐个比较对照。
+		base::Xoshiro256PlusPlus random{7};
+		base::IPPrefixTable<int> table;
+		std::vector<std::pair<uint32_t, uint32_t>> masks;
+		while (table.Count() < 2000)
+		{
+			int32_t length = static_cast<int32_t>(random.Next() % 17) + 16;
+			uint32_t mask = ~uint32_t{0} << (32 - length);
+			uint32_t value = static_cast<uint32_t>(random.Next()) & mask;
+			try
+			{
+				table.Add(MakeIPV4(value), length, static_cast<int>(table.Count()));
+				masks.push_back({value, mask});
+			}
+			catch (std::invalid_argument const &)
+			{
+			}
+		}
+
+		std::vector<base::IPAddress> addresses;
+		std::vector<uint32_t> address_values;
+		for (int64_t i = 0; i < 1024; i++)
+		{
+			uint32_t value = static_cast<uint32_t>(random.Next());
+			addresses.push_back(MakeIPV4(value));
+			address_values.push_back(value);
+		}
+
+		constexpr int64_t lookup_count = 10000;
+		start = std::chrono::steady_clock::now();
+		for (int64_t i = 0; i < lookup_count; i++)
+		{
+			uint32_t address = address_values[i % 1024];
+			for (auto const &[value, mask] : masks)
+			{
+				checksum += (address & mask) == value;
+			}
+		}
+
+		std::chrono::duration<double> linear_elapsed = std::chrono::steady_clock::now() - start;
+
+		start = std::chrono::steady_clock::now();
+		for (int64_t i = 0; i < count; i++)
+		{
+			int const *value = table.Match(addresses[i % 1024]);
+			checksum += value != nullptr ? static_cast<uint64_t>(*value) : 0;
+		}
+
+		std::chrono::duration<double> table_elapsed = std::chrono::steady_clock::now() - start;
+
+		std::cout << "解析 IPV4: base::String::Split " << count / split_elapsed.count() / 1e6 << " M/s, "
+				  << "TryParse " << count / parse_elapsed.count() / 1e6 << " M/s" << std::endl;
+		std::cout << "格式化 IPV6: Format " << count / format_elapsed.count() / 1e6 << " M/s" << std::endl;
+		std::cout << "2000 个网段中查找：逐个比较 " << lookup_count / linear_elapsed.count() / 1e6 << " M/s, "
+				  << "IPPrefixTable " << count / table_elapsed.count() / 1e6 << " M/s" << std::endl;
+		std::cout << "校验和 " << checksum << std::endl;
+	}
+}
+
+#endif // HAS_THREAD
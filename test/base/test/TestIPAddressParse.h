@@ -0,0 +1,17 @@
+#pragma once
+
+#if HAS_THREAD
+
+namespace base
+{
+	namespace test
+	{
+		///
+		/// @brief 检查 IP 地址的解析、格式化、哈希和前缀表，测量速度。
+		///
+		void TestIPAddressParse();
+
+	} // namespace test
+} // namespace base
+
+#endif // HAS_THREAD
@@ -0,0 +1,439 @@
+#include "TestJsonStream.h" // IWYU pragma: keep
+#include "TestHelper.h"
+#include "base/math/Xoshiro256PlusPlus.h"
+#include "base/stream/MemoryStream.h"
+#include "base/stream/ReadOnlySpan.h"
+#include "base/stream/Span.h"
+#include "base/string/define.h"
+#include "base/string/IJsonWriter.h"
+#include "base/string/Json.h"
+#include "base/string/JsonFieldBinder.h"
+#include "base/string/JsonWriter.h"
+#include "base/string/String.h"
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if HAS_THREAD
+
+namespace
+{
+	class Point :
+		public base::IJsonSerializable,
+		public base::IJsonStreamDeserializable
+	{
+	public:
+		int32_t _x = 0;
+		int32_t _y = 0;
+
+		virtual base::Json ToJson() const override
+		{
+			return base::Json{
+				{"x", _x},
+				{"y", _y},
+			};
+		}
+
+		virtual void WriteJson(base::IJsonWriter &writer) const override
+		{
+			writer.StartObject();
+			writer.Property("x", _x);
+			writer.Property("y", _y);
+			writer.EndObject();
+		}
+
+		virtual void DeclareJsonFields(base::JsonFieldBinder &binder) override
+		{
+			binder.Field("x", _x);
+			binder.Field("y", _y);
+		}
+
+		bool operator==(Point const &other) const
+		{
+			return _x == other._x && _y == other._y;
+		}
+	};
+
+	class Shape :
+		public base::IJsonSerializable,
+		public base::IJsonStreamDeserializable
+	{
+	public:
+		std::string _name;
+		base::String _tag;
+		bool _closed = false;
+		uint8_t _color = 0;
+		double _scale = 1;
+		std::vector<Point> _points;
+		std::vector<std::vector<double>> _matrix;
+
+		virtual base::Json ToJson() const override
+		{
+			base::Json points = base::Json::array();
+			for (Point const &point : _points)
+			{
+				points.push_back(point.ToJson());
+			}
+
+			return base::Json{
+				{"name", _name},
+				{"tag", _tag.StdString()},
+				{"closed", _closed},
+				{"color", _color},
+				{"scale", _scale},
+				{"points", points},
+				{"matrix", _matrix},
+			};
+		}
+
+		virtual void WriteJson(base::IJsonWriter &writer) const override
+		{
+			writer.StartObject();
+			writer.Property("name", _name);
+			writer.Property("tag", _tag.StdString());
+			writer.Property("closed", _closed);
+			writer.Property("color", _color);
+			writer.Property("scale", _scale);
+
+			writer.Key("points");
+			writer.StartArray();
+			for (Point const &point : _points)
+			{
+				writer.Value(point);
+			}
+
+			writer.EndArray();
+
+			writer.Key("matrix");
+			writer.StartArray();
+			for (std::vector<double> const &row : _matrix)
+			{
+				writer.StartArray();
+				for (double value : row)
+				{
+					writer.Value(value);
+				}
+
+				writer.EndArray();
+			}
+
+			writer.EndArray();
+			writer.EndObject();
+		}
+
+		virtual void DeclareJsonFields(base::JsonFieldBinder &binder) override
+		{
+			binder.Field("name", _name);
+			binder.Field("tag", _tag);
+			binder.Field("closed", _closed);
+			binder.Field("color", _color);
+			binder.Field("scale", _scale);
+			binder.Field("points", _points);
+			binder.Field("matrix", _matrix);
+		}
+
+		bool operator==(Shape const &other) const
+		{
+			return _name == other._name &&
+				   _tag == other._tag &&
+				   _closed == other._closed &&
+				   _color == other._color &&
+				   _scale == other._scale &&
+				   _points == other._points &&
+				   _matrix == other._matrix;
+		}
+	};
+
+	std::string WriteToString(base::IJsonSerializable const &value, int indent)
+	{
+		std::string str;
+		base::test::StringTextWriter text_writer{str};
+		base::JsonWriter writer{text_writer, indent};
+		writer.Value(value);
+		return str;
+	}
+
+	std::string WriteToString(base::Json const &json, int indent)
+	{
+		std::string str;
+		base::test::StringTextWriter text_writer{str};
+		base::JsonWriter writer{text_writer, indent};
+		writer.Value(json);
+		return str;
+	}
+
+	Shape GenerateShape(int64_t point_count)
+	{
+		base::Xoshiro256PlusPlus generator{1};
+		Shape shape;
+		shape._name = "多边形 \"A\"\n";
+		shape._tag = base::String{"tag\t1"};
+		shape._closed = true;
+		shape._color = 200;
+		shape._scale = 0.1;
+		for (int64_t i = 0; i < point_count; i++)
+		{
+			Point point;
+			point._x = static_cast<int32_t>(generator());
+			point._y = static_cast<int32_t>(generator() % 1000);
+			shape._points.push_back(point);
+		}
+
+		shape._matrix = {{1.0, 0.5, -2.5e-10}, {}, {1e300, 123456.789}};
+		return shape;
+	}
+
+	template <typename ExceptionType>
+	bool Throws(std::string const &json_string)
+	{
+		try
+		{
+			Shape shape;
+			shape.FromJsonString(json_string);
+		}
+		catch (ExceptionType const &)
+		{
+			return true;
+		}
+
+		return false;
+	}
+
+	///
+	/// @brief 原来的做法：先解析出 json 对象，再逐个字段取值。
+	///
+	/// @param json_string
+	/// @return
+	///
+	Shape ParseByDom(std::string const &json_string)
+	{
+		base::Json json = base::Json::parse(json_string);
+		Shape shape;
+		shape._name = json["name"].get<std::string>();
+		shape._tag = base::String{json["tag"].get<std::string>()};
+		shape._closed = json["closed"].get<bool>();
+		shape._color = json["color"].get<uint8_t>();
+		shape._scale = json["scale"].get<double>();
+		for (base::Json const &point_json : json["points"])
+		{
+			Point point;
+			point._x = point_json["x"].get<int32_t>();
+			point._y = point_json["y"].get<int32_t>();
+			shape._points.push_back(point);
+		}
+
+		shape._matrix = json["matrix"].get<std::vector<std::vector<double>>>();
+		return shape;
+	}
+
+} // namespace
+
+void base::test::TestJsonStream()
+{
+	std::cout << std::endl
+			  << CODE_POS_STR;
+
+	// JsonWriter 与 dump 一致。
+	{
+		base::Json json = base::Json::parse(R"({
+			"escape": "a\"b\\c\/d\b\f\n\r\t\u0001\u001f 中文",
+			"integers": [0, -1, 9223372036854775807, -9223372036854775808, 18446744073709551615],
+			"floats": [0.0, 1.0, -2.5, 0.1, 1e300, 5e-324, 123456.789, 1e21, -0.0, 1e5, 1e-4, 1e15, 1e-5, 1.5e-5, 123456789012345.6, 1e14, 0.00012345, -1.7976931348623157e308, 0.21545791625976562, 4.695175448432565e-07],
+			"empty_object": {},
+			"empty_array": [],
+			"nested": {"a": [true, false, null, {"b": []}]}
+		})");
+
+		if (WriteToString(json, 0) != json.dump())
+		{
+			throw std::runtime_error{CODE_POS_STR + "紧凑格式与 dump 不一致。"};
+		}
+
+		if (WriteToString(json, 4) != json.dump(4))
+		{
+			throw std::runtime_error{CODE_POS_STR + "缩进格式与 dump(4) 不一致。"};
+		}
+
+		Shape shape = GenerateShape(3);
+		// nlohmann::json 的对象按键排序，WriteJson 按写入顺序，所以解析后再比较。
+		if (base::Json::parse(WriteToString(shape, 0)) != shape.ToJson())
+		{
+			throw std::runtime_error{CODE_POS_STR + "WriteJson 与 ToJson 不一致。"};
+		}
+
+		if (WriteToString(static_cast<base::IJsonSerializable const &>(Point{}), 2) != Point{}.ToJson().dump(2))
+		{
+			throw std::runtime_error{CODE_POS_STR + "缩进格式的 WriteJson 与 ToJson 不一致。"};
+		}
+
+		std::string str;
+		base::test::StringTextWriter text_writer{str};
+		base::JsonWriter writer{text_writer};
+		writer.StartObject();
+		bool thrown = false;
+		try
+		{
+			writer.Value(1);
+		}
+		catch (std::runtime_error const &)
+		{
+			thrown = true;
+		}
+
+		if (!thrown)
+		{
+			throw std::runtime_error{CODE_POS_STR + "对象中没有键的值应该抛出异常。"};
+		}
+
+		thrown = false;
+		try
+		{
+			writer.EndArray();
+		}
+		catch (std::runtime_error const &)
+		{
+			thrown = true;
+		}
+
+		if (!thrown)
+		{
+			throw std::runtime_error{CODE_POS_STR + "容器不匹配应该抛出异常。"};
+		}
+
+		std::cout << "JsonWriter 与 dump 一致。" << std::endl;
+	}
+
+	// 流式反序列化。
+	{
+		Shape shape = GenerateShape(100);
+		std::string json_string = WriteToString(shape, 4);
+
+		Shape from_string;
+		from_string.FromJsonString(json_string);
+		if (from_string != shape)
+		{
+			throw std::runtime_error{CODE_POS_STR + "FromJsonString 的结果错误。"};
+		}
+
+		Shape from_json;
+		from_json.FromJson(base::Json::parse(json_string));
+		if (from_json != shape)
+		{
+			throw std::runtime_error{CODE_POS_STR + "FromJson 的结果错误。"};
+		}
+
+		base::MemoryStream stream{base::Span{reinterpret_cast<uint8_t *>(json_string.data()),
+											 static_cast<int64_t>(json_string.size())}};
+		stream.SetLength(static_cast<int64_t>(json_string.size()));
+		Shape from_stream;
+		from_stream.FromJsonStream(stream);
+		if (from_stream != shape)
+		{
+			throw std::runtime_error{CODE_POS_STR + "FromJsonStream 的结果错误。"};
+		}
+
+		// 没有声明的键被跳过，没有出现的字段保持原值，整数可以赋给浮点。
+		Shape partial;
+		partial._name = "unchanged";
+		partial.FromJsonString(R"({"unknown": {"a": [1, {"b": 2}], "c": null}, "scale": 3,
+								  "points": [{"x": 1, "extra": [[]], "y": -2}], "other": [1, 2]})");
+		if (!(partial._name == "unchanged" && partial._scale == 3))
+		{
+			throw std::runtime_error{CODE_POS_STR + "跳过未知键后的结果错误。"};
+		}
+
+		if (!(partial._points.size() == 1 && partial._points[0]._x == 1 && partial._points[0]._y == -2))
+		{
+			throw std::runtime_error{CODE_POS_STR + "嵌套对象的结果错误。"};
+		}
+
+		if (!Throws<std::invalid_argument>(R"({"color": 256})"))
+		{
+			throw std::runtime_error{CODE_POS_STR + "超出 uint8_t 范围应该抛出异常。"};
+		}
+
+		if (!Throws<std::invalid_argument>(R"({"color": -1})"))
+		{
+			throw std::runtime_error{CODE_POS_STR + "负数不能赋给 uint8_t."};
+		}
+
+		if (!Throws<std::invalid_argument>(R"({"color": 1.5})"))
+		{
+			throw std::runtime_error{CODE_POS_STR + "浮点不能赋给整型。"};
+		}
+
+		if (!Throws<std::invalid_argument>(R"({"name": 5})"))
+		{
+			throw std::runtime_error{CODE_POS_STR + "整数不能赋给字符串。"};
+		}
+
+		if (!Throws<std::invalid_argument>(R"({"points": {}})"))
+		{
+			throw std::runtime_error{CODE_POS_STR + "对象不能赋给数组。"};
+		}
+
+		if (!Throws<std::invalid_argument>(R"({"points": [1]})"))
+		{
+			throw std::runtime_error{CODE_POS_STR + "整数不能赋给对象。"};
+		}
+
+		if (!Throws<std::invalid_argument>(R"({"closed": null})"))
+		{
+			throw std::runtime_error{CODE_POS_STR + "null 不能赋给 bool."};
+		}
+
+		if (!Throws<std::invalid_argument>(R"([1, 2])"))
+		{
+			throw std::runtime_error{CODE_POS_STR + "根不是对象应该抛出异常。"};
+		}
+
+		if (!Throws<std::invalid_argument>(R"({"name": "a",})"))
+		{
+			throw std::runtime_error{CODE_POS_STR + "语法错误应该抛出异常。"};
+		}
+
+		std::cout << "流式反序列化正确。" << std::endl;
+	}
+
+	// 速度。
+	{
+		Shape shape = GenerateShape(200000);
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		std::string dom_string = shape.ToJson().dump();
+		std::chrono::duration<double> dump_elapsed = std::chrono::steady_clock::now() - start;
+
+		start = std::chrono::steady_clock::now();
+		std::string stream_string = WriteToString(shape, 0);
+		std::chrono::duration<double> writer_elapsed = std::chrono::steady_clock::now() - start;
+		if (dom_string.size() != stream_string.size())
+		{
+			throw std::runtime_error{CODE_POS_STR + "两种序列化方式的结果不同。"};
+		}
+
+		start = std::chrono::steady_clock::now();
+		Shape dom_shape = ParseByDom(stream_string);
+		std::chrono::duration<double> dom_elapsed = std::chrono::steady_clock::now() - start;
+
+		start = std::chrono::steady_clock::now();
+		Shape sax_shape;
+		sax_shape.FromJsonString(stream_string);
+		std::chrono::duration<double> sax_elapsed = std::chrono::steady_clock::now() - start;
+		if (!(dom_shape == sax_shape && sax_shape == shape))
+		{
+			throw std::runtime_error{CODE_POS_STR + "两种反序列化方式的结果不同。"};
+		}
+
+		double megabytes = static_cast<double>(stream_string.size()) / 1024 / 1024;
+		std::cout << "ToJson + dump: " << megabytes / dump_elapsed.count() << " MB/s, "
+				  << "JsonWriter: " << megabytes / writer_elapsed.count() << " MB/s" << std::endl;
+
+		std::cout << "parse + get: " << megabytes / dom_elapsed.count() << " MB/s, "
+				  << "FromJsonString: " << megabytes / sax_elapsed.count() << " MB/s" << std::endl;
+	}
+}
+
+#endif // HAS_THREAD
@@ -0,0 +1,18 @@
+#pragma once
+
+#if HAS_THREAD
+
+namespace base
+{
+	namespace test
+	{
+		///
+		/// @brief 检查 JsonWriter 的输出与 nlohmann::json 一致，流式反序列化的结果与 json 对象一致，
+		/// 测量两种方式的速度。
+		///
+		void TestJsonStream();
+
+	} // namespace test
+} // namespace base
+
+#endif // HAS_THREAD
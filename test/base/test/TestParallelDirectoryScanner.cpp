@@ -0,0 +1,179 @@
+#include "TestParallelDirectoryScanner.h" // IWYU pragma: keep
+#include "base/filesystem/file.h"
+#include "base/filesystem/filesystem.h"
+#include "base/filesystem/ParallelDirectoryScanner.h"
+#include "base/filesystem/Path.h"
+#include "base/string/define.h"
+#include "base/task/CancellationTokenSource.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if HAS_THREAD
+
+namespace
+{
+	///
+	/// @brief 排序后的 (路径, 是否是目录)。
+	///
+	std::vector<std::pair<std::string, bool>> Normalize(std::vector<base::filesystem::ScannedEntry> const &entries)
+	{
+		std::vector<std::pair<std::string, bool>> ret;
+		for (base::filesystem::ScannedEntry const &entry : entries)
+		{
+			ret.emplace_back(entry._path, entry._type == base::filesystem::ScannedEntryType::Directory);
+		}
+
+		std::sort(ret.begin(), ret.end());
+		return ret;
+	}
+
+	///
+	/// @brief 对照：递归遍历，每个条目都 stat 一次判断类型。
+	///
+	std::vector<std::pair<std::string, bool>> WalkAndStat(base::Path const &path)
+	{
+		std::vector<std::pair<std::string, bool>> ret;
+		for (base::filesystem::DirectoryEntry const &entry : base::filesystem::RecursiveDirectoryEntryEnumerable{path})
+		{
+			bool is_directory = entry.IsDirectory();
+			if (!is_directory && !entry.IsRegularFile())
+			{
+				continue;
+			}
+
+			ret.emplace_back(entry.Path().ToString(), is_directory);
+		}
+
+		std::sort(ret.begin(), ret.end());
+		return ret;
+	}
+
+} // namespace
+
+void base::test::TestParallelDirectoryScanner()
+{
+	std::cout << std::endl
+			  << CODE_POS_STR;
+
+	// 20 个一级目录，每个下面 10 个二级目录，每个二级目录 150 个文件。
+	base::Path base_path = base::filesystem::CurrentPath() + base::Path{"TestParallelDirectoryScanner"};
+	base::filesystem::Remove(base_path);
+	for (int32_t i = 0; i < 20; i++)
+	{
+		for (int32_t j = 0; j < 10; j++)
+		{
+			base::Path directory_path = base_path + base::Path{"a" + std::to_string(i) + "/b" + std::to_string(j)};
+			base::filesystem::CreateDirectoryRecursively(directory_path);
+			for (int32_t k = 0; k < 150; k++)
+			{
+				base::file::CreateNewAnyway(directory_path + base::Path{"file" + std::to_string(k) + ".bin"});
+			}
+		}
+	}
+
+	constexpr int64_t expected_count = 20 + 20 * 10 + 20 * 10 * 150;
+
+	std::vector<base::filesystem::ScannedEntry> top_entries;
+	base::filesystem::ReadDirectory(base_path, top_entries);
+	if (top_entries.size() != 20)
+	{
+		throw std::runtime_error{CODE_POS_STR + "一级目录的个数错误。"};
+	}
+
+	{
+		std::vector<std::string> names;
+		base::filesystem::ReadDirectoryNames(base_path, names);
+		std::vector<std::string> expected_names;
+		for (base::filesystem::ScannedEntry const &entry : top_entries)
+		{
+			expected_names.push_back(entry._path.substr(entry._path.rfind('/') + 1));
+		}
+
+		std::sort(names.begin(), names.end());
+		std::sort(expected_names.begin(), expected_names.end());
+		if (names != expected_names)
+		{
+			throw std::runtime_error{CODE_POS_STR + "ReadDirectoryNames 得到的名称与 ReadDirectory 不同。"};
+		}
+	}
+
+	std::vector<std::pair<std::string, bool>> expected = WalkAndStat(base_path);
+	if (static_cast<int64_t>(expected.size()) != expected_count)
+	{
+		throw std::runtime_error{CODE_POS_STR + "对照的递归遍历得到的条目数错误。"};
+	}
+
+	{
+		base::filesystem::ParallelDirectoryScanner scanner{4};
+		std::vector<base::filesystem::ScannedEntry> entries = scanner.Scan(base_path);
+		if (Normalize(entries) != expected)
+		{
+			throw std::runtime_error{CODE_POS_STR + "并行扫描得到的条目与递归遍历不同。"};
+		}
+
+		if (scanner.SkippedDirectoryCount() != 0)
+		{
+			throw std::runtime_error{CODE_POS_STR + "不应该跳过目录。"};
+		}
+
+		base::CancellationTokenSource cancellation_token_source;
+		cancellation_token_source.Cancel();
+		entries = scanner.Scan(base_path, cancellation_token_source.Token());
+		if (!(static_cast<int64_t>(entries.size()) < expected_count))
+		{
+			throw std::runtime_error{CODE_POS_STR + "取消后不应该扫描完整。"};
+		}
+	}
+
+	std::cout << "并行扫描得到的条目与递归遍历相同。" << std::endl;
+
+	// 速度。
+	constexpr int64_t repeat_count = 5;
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (int64_t i = 0; i < repeat_count; i++)
+	{
+		if (static_cast<int64_t>(WalkAndStat(base_path).size()) != expected_count)
+		{
+			throw std::runtime_error{CODE_POS_STR + "条目数错误。"};
+		}
+	}
+
+	std::chrono::duration<double> walk_elapsed = std::chrono::steady_clock::now() - start;
+
+	std::vector<std::pair<int32_t, double>> scan_results;
+	for (int32_t thread_count : {1, 4})
+	{
+		base::filesystem::ParallelDirectoryScanner scanner{thread_count};
+		start = std::chrono::steady_clock::now();
+		for (int64_t i = 0; i < repeat_count; i++)
+		{
+			if (static_cast<int64_t>(scanner.Scan(base_path).size()) != expected_count)
+			{
+				throw std::runtime_error{CODE_POS_STR + "条目数错误。"};
+			}
+		}
+
+		std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+		scan_results.emplace_back(thread_count, elapsed.count());
+	}
+
+	base::filesystem::Remove(base_path);
+
+	double entries = static_cast<double>(expected_count * repeat_count);
+	std::cout << "扫描 " << expected_count << " 个条目：逐个 stat " << entries / walk_elapsed.count() / 1e6 << " M条/s";
+	for (std::pair<int32_t, double> const &result : scan_results)
+	{
+		std::cout << ", 并行扫描 " << result.first << " 线程 " << entries / result.second / 1e6 << " M条/s";
+	}
+
+	std::cout << std::endl;
+}
+
+#endif // HAS_THREAD
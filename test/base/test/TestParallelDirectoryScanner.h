@@ -0,0 +1,17 @@
+#pragma once
+
+#if HAS_THREAD
+
+namespace base
+{
+	namespace test
+	{
+		///
+		/// @brief 检查并行扫描的结果与逐个条目 stat 的递归遍历相同，比较两者的速度。
+		///
+		void TestParallelDirectoryScanner();
+
+	} // namespace test
+} // namespace base
+
+#endif // HAS_THREAD
@@ -0,0 +1,405 @@
+#include "TestPcapReplay.h" // IWYU pragma: keep
+#include "TestHelper.h"
+#include "base/net/ethernet/EthernetFrameDispatcher.h"
+#include "base/net/ethernet/EthernetFrameInfo.h"
+#include "base/net/ethernet/EthernetFrameWriter.h"
+#include "base/net/ethernet/LengthOrTypeEnum.h"
+#include "base/net/Mac.h"
+#include "base/net/pcap/PcapReader.h"
+#include "base/net/pcap/PcapReplayEthernetPort.h"
+#include "base/net/pcap/PcapWriter.h"
+#include "base/net/profinet/fid-pdu/FidApduReader.h"
+#include "base/stream/MemoryStream.h"
+#include "base/stream/ReadOnlySpan.h"
+#include "base/stream/Span.h"
+#include "base/string/define.h"
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if HAS_THREAD
+
+namespace
+{
+	///
+	/// @brief 构造一个最小的以太网帧。
+	///
+	/// @param type
+	/// @param frame_id 为 -1 时不写帧 ID.
+	/// @param sequence 写在帧 ID 后面，用来区分不同的帧。
+	///
+	std::vector<uint8_t> MakeFrame(base::ethernet::LengthOrTypeEnum type, int32_t frame_id, uint32_t sequence)
+	{
+		base::Mac mac = base::test::MakeMac(0x01);
+
+		std::vector<uint8_t> frame(64);
+		base::ethernet::EthernetFrameWriter writer{base::Span{frame.data(), static_cast<int64_t>(frame.size())}};
+		writer.WriteDestinationMac(mac);
+		writer.WriteSourceMac(mac);
+		writer.WriteTypeOrLength(type);
+		if (frame_id >= 0)
+		{
+			writer.WritePayload(static_cast<uint16_t>(frame_id), std::endian::big);
+		}
+
+		writer.WritePayload(sequence, std::endian::big);
+		frame.resize(static_cast<size_t>(writer.SpanForSending().Size()));
+		return frame;
+	}
+
+	base::ReadOnlySpan ToSpan(std::vector<uint8_t> const &frame)
+	{
+		return base::ReadOnlySpan{frame.data(), static_cast<int64_t>(frame.size())};
+	}
+
+	///
+	/// @brief 写入再读取，检查时间戳、长度和数据不变。
+	///
+	void CheckRoundTrip(base::pcap::PcapFormat format)
+	{
+		std::shared_ptr<base::MemoryStream> stream{new base::MemoryStream{1024 * 1024}};
+		std::vector<std::vector<uint8_t>> frames;
+		for (uint32_t i = 0; i < 10; i++)
+		{
+			frames.push_back(MakeFrame(base::ethernet::LengthOrTypeEnum::Profinet, 0x8000, i));
+		}
+
+		// 奇数长度，检查 pcapng 的填充。
+		frames.push_back(std::vector<uint8_t>(61, 0xab));
+
+		{
+			base::pcap::PcapWriter writer{stream, format};
+			for (size_t i = 0; i < frames.size(); i++)
+			{
+				writer.Write(std::chrono::nanoseconds{1700000000123456789 + static_cast<int64_t>(i) * 1000}, ToSpan(frames[i]));
+			}
+
+			// 分成两段写入，并且超过快照长度会被截断。
+			std::vector<uint8_t> big(70000, 0x5a);
+			writer.Write(std::chrono::nanoseconds{1700000001000000000},
+						 std::vector<base::ReadOnlySpan>{ToSpan(big).Slice(0, 100), ToSpan(big).Slice(100, 69900)});
+		}
+
+		stream->SetPosition(0);
+		base::pcap::PcapReader reader{stream};
+		if (reader.Format() != format)
+		{
+			throw std::runtime_error{CODE_POS_STR + "格式错误。"};
+		}
+
+		base::pcap::PcapRecord record{};
+		for (size_t i = 0; i < frames.size(); i++)
+		{
+			if (!reader.TryRead(record))
+			{
+				throw std::runtime_error{CODE_POS_STR + "记录数不足。"};
+			}
+
+			if (record._timestamp.count() != 1700000000123456789 + static_cast<int64_t>(i) * 1000)
+			{
+				throw std::runtime_error{CODE_POS_STR + "时间戳错误。"};
+			}
+
+			if (record._link_type != base::pcap::PcapLinkType::Ethernet)
+			{
+				throw std::runtime_error{CODE_POS_STR + "链路层类型错误。"};
+			}
+
+			if (record._original_length != static_cast<int64_t>(frames[i].size()))
+			{
+				throw std::runtime_error{CODE_POS_STR + "原始长度错误。"};
+			}
+
+			if (record._data != ToSpan(frames[i]))
+			{
+				throw std::runtime_error{CODE_POS_STR + "数据错误。"};
+			}
+		}
+
+		if (!reader.TryRead(record))
+		{
+			throw std::runtime_error{CODE_POS_STR + "记录数不足。"};
+		}
+
+		if (!(record._original_length == 70000 && record._data.Size() == 65535))
+		{
+			throw std::runtime_error{CODE_POS_STR + "没有按快照长度截断。"};
+		}
+
+		if (record._data[65534] != 0x5a)
+		{
+			throw std::runtime_error{CODE_POS_STR + "截断的数据错误。"};
+		}
+
+		if (reader.TryRead(record))
+		{
+			throw std::runtime_error{CODE_POS_STR + "应该到达文件末尾。"};
+		}
+	}
+
+	///
+	/// @brief 大端序、微秒分辨率的经典 pcap 文件。
+	///
+	void CheckBigEndianPcap()
+	{
+		std::vector<uint8_t> file{
+			0xa1, 0xb2, 0xc3, 0xd4, // 魔数
+			0x00, 0x02, 0x00, 0x04, // 版本
+			0x00, 0x00, 0x00, 0x00, // 时区
+			0x00, 0x00, 0x00, 0x00, // 精度
+			0x00, 0x00, 0xff, 0xff, // 快照长度
+			0x00, 0x00, 0x00, 0x01, // 以太网
+			0x00, 0x00, 0x00, 0x02, // 2 秒
+			0x00, 0x00, 0x00, 0x03, // 3 微秒
+			0x00, 0x00, 0x00, 0x04, // 捕获长度
+			0x00, 0x00, 0x00, 0x40, // 原始长度
+			0x01, 0x02, 0x03, 0x04,
+		};
+
+		std::shared_ptr<base::MemoryStream> stream{new base::MemoryStream{base::Span{file.data(), static_cast<int64_t>(file.size())}}};
+		stream->SetLength(static_cast<int64_t>(file.size()));
+
+		base::pcap::PcapReader reader{stream};
+		base::pcap::PcapRecord record{};
+		if (!reader.TryRead(record))
+		{
+			throw std::runtime_error{CODE_POS_STR + "没有读到记录。"};
+		}
+
+		if (record._timestamp.count() != 2000003000)
+		{
+			throw std::runtime_error{CODE_POS_STR + "大端序时间戳错误。"};
+		}
+
+		if (!(record._original_length == 64 && record._data.Size() == 4 && record._data[3] == 0x04))
+		{
+			throw std::runtime_error{CODE_POS_STR + "大端序记录错误。"};
+		}
+
+		if (reader.TryRead(record))
+		{
+			throw std::runtime_error{CODE_POS_STR + "应该到达文件末尾。"};
+		}
+
+		// 截断的记录。
+		stream->SetPosition(0);
+		stream->SetLength(static_cast<int64_t>(file.size()) - 1);
+		base::pcap::PcapReader truncated_reader{stream};
+		bool thrown = false;
+		try
+		{
+			truncated_reader.TryRead(record);
+		}
+		catch (std::runtime_error const &)
+		{
+			thrown = true;
+		}
+
+		if (!thrown)
+		{
+			throw std::runtime_error{CODE_POS_STR + "截断的记录应该抛出异常。"};
+		}
+	}
+
+	std::shared_ptr<base::MemoryStream> MakeCapture(int64_t frame_count, std::chrono::nanoseconds interval)
+	{
+		std::vector<uint8_t> rt_frame = MakeFrame(base::ethernet::LengthOrTypeEnum::Profinet, 0x8001, 0);
+		std::vector<uint8_t> dcp_frame = MakeFrame(base::ethernet::LengthOrTypeEnum::Profinet, 0xfefe, 0);
+		std::vector<uint8_t> ip_frame = MakeFrame(base::ethernet::LengthOrTypeEnum::IP, -1, 0);
+
+		std::shared_ptr<base::MemoryStream> stream{new base::MemoryStream{frame_count * 128 + 1024}};
+		base::pcap::PcapWriter writer{stream, base::pcap::PcapFormat::Pcapng};
+		for (int64_t i = 0; i < frame_count; i++)
+		{
+			// 以 RT 循环帧为主，夹杂 DCP 和 IP 帧。
+			int64_t kind = i % 8;
+			std::vector<uint8_t> const &frame = kind < 6 ? rt_frame : (kind == 6 ? dcp_frame : ip_frame);
+			writer.Write(std::chrono::nanoseconds{1700000000000000000} + interval * i, ToSpan(frame));
+		}
+
+		stream->SetPosition(0);
+		return stream;
+	}
+
+} // namespace
+
+void base::test::TestPcapReplay()
+{
+	std::cout << std::endl
+			  << CODE_POS_STR;
+
+	CheckRoundTrip(base::pcap::PcapFormat::Pcap);
+	CheckRoundTrip(base::pcap::PcapFormat::Pcapng);
+	CheckBigEndianPcap();
+	std::cout << "pcap 和 pcapng 读写正确。" << std::endl;
+
+	// 回放端口。按 1 倍速回放间隔 10 ms 的 4 个帧，并把每个收到的帧原样发送回去。
+	{
+		std::shared_ptr<base::MemoryStream> capture = MakeCapture(4, std::chrono::milliseconds{10});
+		base::pcap::PcapReplayEthernetPort port{capture};
+
+		std::shared_ptr<base::MemoryStream> sent_stream{new base::MemoryStream{1024 * 1024}};
+		port.SetRecorder(std::shared_ptr<base::pcap::PcapWriter>{new base::pcap::PcapWriter{sent_stream, base::pcap::PcapFormat::Pcap}});
+		port.SetSpeed(1);
+
+		int64_t connected_count = 0;
+		int64_t disconnected_count = 0;
+		int64_t received_count = 0;
+		port.ConnectedEvent().Subscribe(
+			[&]()
+			{
+				connected_count++;
+			});
+
+		port.DisconnectedEvent().Subscribe(
+			[&]()
+			{
+				disconnected_count++;
+			});
+
+		port.ReceivingEhternetFrameEvent().Subscribe(
+			[&](base::ReadOnlySpan const &frame)
+			{
+				received_count++;
+				port.Send(std::vector<base::ReadOnlySpan>{frame.Slice(0, 14), frame.Slice(14, frame.Size() - 14)});
+			});
+
+		port.Open(base::Mac{});
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		if (port.Replay() != 4)
+		{
+			throw std::runtime_error{CODE_POS_STR + "回放的帧数错误。"};
+		}
+
+		std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+		if (!(connected_count == 1 && disconnected_count == 1))
+		{
+			throw std::runtime_error{CODE_POS_STR + "连接和断开事件错误。"};
+		}
+
+		if (!(received_count == 4 && port.SentFrameCount() == 4))
+		{
+			throw std::runtime_error{CODE_POS_STR + "收发帧数错误。"};
+		}
+
+		if (!(elapsed.count() >= 0.029))
+		{
+			throw std::runtime_error{CODE_POS_STR + "没有按抓包时的节奏回放。"};
+		}
+
+		sent_stream->SetPosition(0);
+		base::pcap::PcapReader reader{sent_stream};
+		base::pcap::PcapRecord record{};
+		int64_t recorded_count = 0;
+		while (reader.TryRead(record))
+		{
+			if (base::ethernet::EthernetFrameInfo::Classify(record._data).ProfinetFrameId() != 0x8001)
+			{
+				throw std::runtime_error{CODE_POS_STR + "记录的帧错误。"};
+			}
+
+			recorded_count++;
+		}
+
+		if (recorded_count != 4)
+		{
+			throw std::runtime_error{CODE_POS_STR + "记录的帧数错误。"};
+		}
+
+		std::cout << "回放端口按 1 倍速回放 30 ms 的抓包用时 " << elapsed.count() * 1000 << " ms, 发送的帧已记录。" << std::endl;
+	}
+
+	BenchmarkPcapReplay(MakeCapture(1000000, std::chrono::microseconds{250}));
+}
+
+void base::test::BenchmarkPcapReplay(std::shared_ptr<base::Stream> const &capture)
+{
+	int64_t start_position = capture->Position();
+
+	// 逐帧使用 FidApduReader.
+	int64_t rt_count = 0;
+	int64_t other_count = 0;
+	int64_t frame_count = 0;
+	std::chrono::duration<double> reader_elapsed{};
+	{
+		base::pcap::PcapReplayEthernetPort port{capture};
+		port.ReceivingEhternetFrameEvent().Subscribe(
+			[&](base::ReadOnlySpan const &frame)
+			{
+				if (frame.Size() < 60)
+				{
+					// EthernetFrameReader 要求至少 60 字节。
+					other_count++;
+					return;
+				}
+
+				base::profinet::FidApduReader reader{frame};
+				uint16_t frame_id = static_cast<uint16_t>(reader.FrameId());
+				if (frame_id >= 0x8000 && frame_id <= 0xbfff)
+				{
+					rt_count++;
+				}
+				else
+				{
+					other_count++;
+				}
+			});
+
+		port.Open(base::Mac{});
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		frame_count = port.Replay();
+		reader_elapsed = std::chrono::steady_clock::now() - start;
+	}
+
+	int64_t reader_rt_count = rt_count;
+	rt_count = 0;
+	other_count = 0;
+
+	// EthernetFrameDispatcher.
+	capture->SetPosition(start_position);
+	std::chrono::duration<double> dispatcher_elapsed{};
+	{
+		base::ethernet::EthernetFrameDispatcher dispatcher;
+		dispatcher.AddProfinetHandler(0x8000,
+									  0xbfff,
+									  [&](base::ethernet::EthernetFrameInfo const &)
+									  {
+										  rt_count++;
+									  });
+
+		dispatcher.SetDefaultHandler(
+			[&](base::ethernet::EthernetFrameInfo const &)
+			{
+				other_count++;
+			});
+
+		base::pcap::PcapReplayEthernetPort port{capture};
+		port.ReceivingEhternetFrameEvent().Subscribe(
+			[&](base::ReadOnlySpan const &frame)
+			{
+				dispatcher.Dispatch(frame);
+			});
+
+		port.Open(base::Mac{});
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		port.Replay();
+		dispatcher_elapsed = std::chrono::steady_clock::now() - start;
+	}
+
+	if (rt_count != reader_rt_count)
+	{
+		throw std::runtime_error{CODE_POS_STR + "两种方式得到的 RT 帧数不同。"};
+	}
+
+	double frames = static_cast<double>(frame_count);
+	std::cout << "回放 " << frame_count << " 帧，其中 RT 帧 " << rt_count << " 个。"
+			  << "读取并用 FidApduReader 解析 " << frames / reader_elapsed.count() / 1e6 << " M帧/s, "
+			  << "读取并用 EthernetFrameDispatcher 分发 " << frames / dispatcher_elapsed.count() / 1e6 << " M帧/s" << std::endl;
+}
+
+#endif // HAS_THREAD
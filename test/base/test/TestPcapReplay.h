@@ -0,0 +1,30 @@
+#pragma once
+#include "base/stream/Stream.h"
+#include <memory>
+
+#if HAS_THREAD
+
+namespace base
+{
+	namespace test
+	{
+		///
+		/// @brief 检查抓包文件的读写和回放端口，并用生成的抓包文件测量解析和分发的速度。
+		///
+		void TestPcapReplay();
+
+		///
+		/// @brief 尽可能快地回放抓包文件，测量 EthernetFrameDispatcher 和逐帧 FidApduReader
+		/// 解析、分发的速度。
+		///
+		/// @note 可以传入 base::file::OpenReadOnly 打开的真实抓包文件。流必须能定位，
+		/// 因为要回放两遍。
+		///
+		/// @param capture
+		///
+		void BenchmarkPcapReplay(std::shared_ptr<base::Stream> const &capture);
+
+	} // namespace test
+} // namespace base
+
+#endif // HAS_THREAD
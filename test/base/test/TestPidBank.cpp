@@ -0,0 +1,186 @@
+#include "TestPidBank.h" // IWYU pragma: keep
+#include "base/math/FastInt64Fraction.h"
+#include "base/math/PID.h"
+#include "base/math/PidBank.h"
+#include "base/string/define.h"
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if HAS_THREAD
+
+namespace
+{
+	constexpr int64_t _channel_count = 1024;
+	constexpr int64_t _cycle_count = 1000;
+
+	///
+	/// @brief 第 channel 个通道在第 cycle 个周期的输入。
+	///
+	/// @param channel
+	/// @param cycle
+	/// @return
+	///
+	double InputOf(int64_t channel, int64_t cycle)
+	{
+		// 每个通道的设定值偏差不同，输出会在限幅内外来回变化。
+		return std::sin(static_cast<double>(cycle + channel) / 50) * 100 + static_cast<double>(channel % 7);
+	}
+
+	std::vector<base::PID> CreatePids()
+	{
+		std::vector<base::PID> pids;
+		for (int64_t i = 0; i < _channel_count; i++)
+		{
+			pids.push_back(base::PID{
+				base::FastInt64Fraction{1 + i % 5, 10},
+				base::FastInt64Fraction{1, 100 + i % 13},
+				base::FastInt64Fraction{1, 1000},
+				base::FastInt64Fraction{500},
+				base::FastInt64Fraction{-500},
+			});
+		}
+
+		return pids;
+	}
+
+	///
+	/// @brief PidBank 与 base::PID 之间允许的相对误差。
+	///
+	/// @note base::PID 的分数运算在溢出时会截断分子分母，double 也有舍入误差，
+	/// 两者都远小于这个值。
+	///
+	constexpr double _max_relative_error = 1e-9;
+
+	///
+	/// @brief 相对误差。输出接近 0 时按绝对误差计算。
+	///
+	/// @param expected
+	/// @param actual
+	/// @return
+	///
+	double RelativeError(double expected, double actual)
+	{
+		double scale = std::abs(expected);
+		if (scale < 1)
+		{
+			scale = 1;
+		}
+
+		return std::abs(expected - actual) / scale;
+	}
+
+	///
+	/// @brief 检查 bank 的每个通道的输出与对应的 base::PID 的输出是否一致。
+	///
+	/// @param pids
+	/// @param bank
+	///
+	void CheckOutputs(std::vector<base::PID> const &pids, base::PidBank<double> const &bank)
+	{
+		for (int64_t i = 0; i < _channel_count; i++)
+		{
+			double error = RelativeError(static_cast<double>(pids[i].Output()), bank.Output(i));
+			if (!(error < _max_relative_error))
+			{
+				throw std::runtime_error{CODE_POS_STR + "PidBank 与 PID 的输出不一致，通道：" + std::to_string(i)};
+			}
+		}
+	}
+
+} // namespace
+
+void base::test::TestPidBank()
+{
+	std::vector<base::PID> pids = CreatePids();
+	base::PidBank<double> bank{_channel_count};
+	for (int64_t i = 0; i < _channel_count; i++)
+	{
+		bank.SetChannel(i, pids[i]);
+	}
+
+	{
+		std::cout << std::endl
+				  << CODE_POS_STR;
+
+		// 误差比较。base::PID 的分数运算会降低分辨率，所以与 double 之间会有微小误差，
+		// 用相对误差比较。
+		double max_error = 0;
+		std::vector<double> inputs(_channel_count);
+		for (int64_t cycle = 0; cycle < _cycle_count; cycle++)
+		{
+			// 输入先量化到分数能精确表示的值，两边使用相同的输入。
+			std::vector<base::FastInt64Fraction> fraction_inputs;
+			for (int64_t i = 0; i < _channel_count; i++)
+			{
+				base::FastInt64Fraction x{static_cast<int64_t>(InputOf(i, cycle) * 1000 * 1000), 1000 * 1000};
+				fraction_inputs.push_back(x);
+				inputs[i] = static_cast<double>(x);
+			}
+
+			bank.Input(base::ReadOnlyArraySpan<double>{inputs.data(), _channel_count});
+
+			for (int64_t i = 0; i < _channel_count; i++)
+			{
+				double pid_output = static_cast<double>(pids[i].Input(fraction_inputs[i]));
+				double error = RelativeError(pid_output, bank.Output(i));
+				if (error > max_error)
+				{
+					max_error = error;
+				}
+			}
+		}
+
+		std::cout << "PidBank 与 PID 的最大相对误差: " << max_error << std::endl;
+		if (!(max_error < _max_relative_error))
+		{
+			throw std::runtime_error{CODE_POS_STR + "PidBank 与 PID 的误差过大：" + std::to_string(max_error)};
+		}
+	}
+
+	{
+		std::cout << std::endl
+				  << CODE_POS_STR;
+
+		// 吞吐量比较。两边使用相同的输入，最后再比较一次输出。
+		std::vector<base::FastInt64Fraction> fraction_inputs;
+		std::vector<double> inputs(_channel_count);
+		for (int64_t i = 0; i < _channel_count; i++)
+		{
+			fraction_inputs.push_back(base::FastInt64Fraction{static_cast<int64_t>(InputOf(i, 0) * 1000), 1000});
+			inputs[i] = static_cast<double>(fraction_inputs[i]);
+		}
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for (int64_t cycle = 0; cycle < _cycle_count; cycle++)
+		{
+			for (int64_t i = 0; i < _channel_count; i++)
+			{
+				pids[i].Input(fraction_inputs[i]);
+			}
+		}
+
+		std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+		std::chrono::nanoseconds pid_elapsed = end - start;
+
+		start = std::chrono::steady_clock::now();
+		for (int64_t cycle = 0; cycle < _cycle_count; cycle++)
+		{
+			bank.Input(base::ReadOnlyArraySpan<double>{inputs.data(), _channel_count});
+		}
+
+		end = std::chrono::steady_clock::now();
+		std::chrono::nanoseconds bank_elapsed = end - start;
+
+		double update_count = static_cast<double>(_channel_count * _cycle_count);
+		std::cout << "PID: " << static_cast<double>(pid_elapsed.count()) / update_count << " ns/通道" << std::endl;
+		std::cout << "PidBank<double>: " << static_cast<double>(bank_elapsed.count()) / update_count << " ns/通道" << std::endl;
+		CheckOutputs(pids, bank);
+	}
+}
+
+#endif // HAS_THREAD
@@ -0,0 +1,17 @@
+#pragma once
+
+#if HAS_THREAD
+
+namespace base
+{
+	namespace test
+	{
+		///
+		/// @brief 对比 base::PidBank 与 base::PID 的输出误差，并测试吞吐量。
+		///
+		void TestPidBank();
+
+	} // namespace test
+} // namespace base
+
+#endif // HAS_THREAD
@@ -0,0 +1,17 @@
+#pragma once
+
+#if HAS_THREAD
+
+namespace base
+{
+	namespace test
+	{
+		///
+		/// @brief 检查循环 IO 数据引擎构造、解析的帧和过程映像的无锁传递，测量每秒构造的帧数。
+		///
+		void TestProfinetCyclic();
+
+	} // namespace test
+} // namespace base
+
+#endif // HAS_THREAD
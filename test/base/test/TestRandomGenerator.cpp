@@ -0,0 +1,179 @@
+#include "TestRandomGenerator.h" // IWYU pragma: keep
+#include "base/container/ArraySpan.h"
+#include "base/math/random.h"
+#include "base/stream/Span.h"
+#include "base/string/define.h"
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if HAS_THREAD
+
+namespace
+{
+	constexpr int64_t _count = 10 * 1000 * 1000;
+
+	double NanosecondsPerValue(std::chrono::steady_clock::time_point start)
+	{
+		std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - start;
+		return static_cast<double>(elapsed.count()) / _count;
+	}
+
+} // namespace
+
+void base::test::TestRandomGenerator()
+{
+	std::shared_ptr<base::IRandomGenerator> generator = base::CreateRandomGenerator();
+
+	{
+		std::cout << std::endl
+				  << CODE_POS_STR;
+
+		// 范围检查，包括只有一个值的范围和整个 int64_t 范围。
+		for (int64_t i = 0; i < 100000; i++)
+		{
+			int64_t value = generator->GenerateInt64Random(-3, 5);
+			if (!(value >= -3 && value <= 5))
+			{
+				throw std::runtime_error{CODE_POS_STR + "GenerateInt64Random 超出范围。"};
+			}
+
+			if (generator->GenerateInt64Random(7, 7) != 7)
+			{
+				throw std::runtime_error{CODE_POS_STR + "只有一个值的范围结果错误。"};
+			}
+
+			uint64_t u = generator->GenerateUInt64Random(UINT64_MAX - 10, UINT64_MAX);
+			if (!(u >= UINT64_MAX - 10))
+			{
+				throw std::runtime_error{CODE_POS_STR + "GenerateUInt64Random 超出范围。"};
+			}
+
+			uint32_t u32 = generator->GenerateUInt32Random(5, 31);
+			if (!(u32 >= 5 && u32 <= 31))
+			{
+				throw std::runtime_error{CODE_POS_STR + "GenerateUInt32Random 超出范围。"};
+			}
+		}
+
+		generator->GenerateInt64Random();
+
+		// 分布检查。每个桶的期望是 _count / bucket_count, 卡方统计量应接近自由度 bucket_count - 1.
+		constexpr int64_t bucket_count = 10;
+		std::vector<int64_t> values(_count);
+		generator->Generate(base::ArraySpan<int64_t>{values.data(), _count}, 0, bucket_count - 1);
+
+		std::vector<int64_t> buckets(bucket_count);
+		for (int64_t value : values)
+		{
+			if (!(value >= 0 && value < bucket_count))
+			{
+				throw std::runtime_error{CODE_POS_STR + "Generate 超出范围。"};
+			}
+
+			buckets[value]++;
+		}
+
+		double expected = static_cast<double>(_count) / bucket_count;
+		double chi_square = 0;
+		for (int64_t bucket : buckets)
+		{
+			chi_square += (bucket - expected) * (bucket - expected) / expected;
+		}
+
+		std::cout << "卡方统计量: " << chi_square << ", 自由度: " << bucket_count - 1 << std::endl;
+		if (!(chi_square < 50))
+		{
+			throw std::runtime_error{CODE_POS_STR + "分布明显不均匀。"};
+		}
+
+		// Fill 应该填满所有字节，包括不足 8 字节的尾部。
+		std::vector<uint8_t> bytes(1024 + 3);
+		generator->Fill(base::Span{bytes.data(), static_cast<int64_t>(bytes.size())});
+		int64_t zero_count = 0;
+		for (uint8_t b : bytes)
+		{
+			zero_count += b == 0 ? 1 : 0;
+		}
+
+		if (!(zero_count < 30))
+		{
+			throw std::runtime_error{CODE_POS_STR + "Fill 的结果中 0 过多。"};
+		}
+	}
+
+	{
+		std::cout << std::endl
+				  << CODE_POS_STR;
+
+		// 多个线程同时使用同一个生成器对象。
+		std::vector<std::thread> threads;
+		std::vector<int64_t> sums(4);
+		for (size_t t = 0; t < sums.size(); t++)
+		{
+			threads.emplace_back(
+				[&, t]()
+				{
+					for (int64_t i = 0; i < _count / 10; i++)
+					{
+						sums[t] += generator->GenerateInt64Random(0, 99);
+					}
+				});
+		}
+
+		for (std::thread &thread : threads)
+		{
+			thread.join();
+		}
+
+		for (int64_t sum : sums)
+		{
+			// 期望是 49.5 * _count / 10.
+			std::cout << "线程平均值: " << static_cast<double>(sum) / (_count / 10) << std::endl;
+		}
+	}
+
+	{
+		std::cout << std::endl
+				  << CODE_POS_STR;
+
+		std::vector<int64_t> values(_count);
+
+		// 原来的实现：std::mt19937_64 加上每次构造的 uniform_int_distribution.
+		std::mt19937_64 mt{std::random_device{}()};
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for (int64_t i = 0; i < _count; i++)
+		{
+			std::uniform_int_distribution<int64_t> distribution{0, 999};
+			values[i] = distribution(mt);
+		}
+
+		std::cout << "mt19937_64: " << NanosecondsPerValue(start) << " ns/个" << std::endl;
+
+		start = std::chrono::steady_clock::now();
+		for (int64_t i = 0; i < _count; i++)
+		{
+			values[i] = generator->GenerateInt64Random(0, 999);
+		}
+
+		std::cout << "GenerateInt64Random: " << NanosecondsPerValue(start) << " ns/个" << std::endl;
+
+		start = std::chrono::steady_clock::now();
+		generator->Generate(base::ArraySpan<int64_t>{values.data(), _count}, 0, 999);
+		std::cout << "Generate: " << NanosecondsPerValue(start) << " ns/个" << std::endl;
+
+		start = std::chrono::steady_clock::now();
+		generator->Fill(base::Span{reinterpret_cast<uint8_t *>(values.data()), _count * 8});
+		std::cout << "Fill: " << NanosecondsPerValue(start) << " ns/8 字节" << std::endl;
+
+		std::cout << "校验: " << values[0] << std::endl;
+	}
+}
+
+#endif // HAS_THREAD
@@ -0,0 +1,18 @@
+#pragma once
+
+#if HAS_THREAD
+
+namespace base
+{
+	namespace test
+	{
+		///
+		/// @brief 检查 base::CreateRandomGenerator 生成的随机数的范围和分布，
+		/// 在多个线程中同时使用，并比较与 std::mt19937_64 的吞吐量。
+		///
+		void TestRandomGenerator();
+
+	} // namespace test
+} // namespace base
+
+#endif // HAS_THREAD
@@ -0,0 +1,206 @@
+#include "TestSignalSource.h" // IWYU pragma: keep
+#include "base/container/ArraySpan.h"
+#include "base/signal/ChirpSignalSource.h"
+#include "base/signal/ISignalSource.h"
+#include "base/signal/NoiseSignalSource.h"
+#include "base/signal/PeriodicSamplingClock.h"
+#include "base/signal/SinSignalSource.h"
+#include "base/signal/SquareSignalSource.h"
+#include "base/signal/TriangleSignalSource.h"
+#include "base/string/define.h"
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <numbers>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if HAS_THREAD
+
+namespace
+{
+	constexpr int64_t _sample_count = 1000 * 1000;
+
+	///
+	/// @brief 逐个采样与成块采样的最大差值。
+	///
+	/// @param scalar_source
+	/// @param block_source 与 scalar_source 参数相同的另一个信号源。
+	/// @return
+	///
+	double MaxDifference(base::ISignalSource<double> &scalar_source, base::ISignalSource<double> &block_source)
+	{
+		base::unit::Second interval{base::Fraction{1, 10000}};
+		scalar_source.Open(interval);
+		block_source.Open(interval);
+
+		// 块大小不是 64 的整数倍，检查跨块的相位衔接。
+		std::vector<double> block(1000);
+		double max_difference = 0;
+		for (int64_t i = 0; i < 100; i++)
+		{
+			block_source.Sample(base::ArraySpan<double>{block.data(), static_cast<int64_t>(block.size())});
+			for (double value : block)
+			{
+				max_difference = std::max(max_difference, std::abs(value - scalar_source.Sample()));
+			}
+		}
+
+		return max_difference;
+	}
+
+} // namespace
+
+void base::test::TestSignalSource()
+{
+	base::unit::Second period{base::Fraction{1, 50}};
+
+	{
+		std::cout << std::endl
+				  << CODE_POS_STR;
+
+		// 正弦与 std::sin 比较。
+		base::SinSignalSource source{period};
+		source.Open(base::unit::Second{base::Fraction{1, 10000}});
+
+		std::vector<double> samples(_sample_count);
+		source.Sample(base::ArraySpan<double>{samples.data(), _sample_count});
+
+		double max_error = 0;
+		for (int64_t i = 0; i < _sample_count; i++)
+		{
+			// 周期是 200 个采样。
+			double expected = std::sin(2 * std::numbers::pi * static_cast<double>(i % 200) / 200);
+			max_error = std::max(max_error, std::abs(samples[i] - expected));
+		}
+
+		std::cout << "正弦与 std::sin 的最大误差: " << max_error << std::endl;
+		if (!(max_error < 1e-12))
+		{
+			throw std::runtime_error{CODE_POS_STR + "正弦误差过大。"};
+		}
+	}
+
+	{
+		std::cout << std::endl
+				  << CODE_POS_STR;
+
+		base::SinSignalSource sin1{period};
+		base::SinSignalSource sin2{period};
+		double sin_difference = MaxDifference(sin1, sin2);
+		std::cout << "正弦逐个与成块采样的最大差值: " << sin_difference << std::endl;
+		if (!(sin_difference < 1e-12))
+		{
+			throw std::runtime_error{CODE_POS_STR + "正弦逐个与成块采样的结果不同。"};
+		}
+
+		// 方波和三角波的周期不是采样间隔的整数倍，避免相位恰好落在跳变点上。
+		base::unit::Second odd_period{base::Fraction{1, 47}};
+		base::SquareSignalSource square1{odd_period, 0.3};
+		base::SquareSignalSource square2{odd_period, 0.3};
+		if (MaxDifference(square1, square2) != 0)
+		{
+			throw std::runtime_error{CODE_POS_STR + "方波逐个与成块采样的结果不同。"};
+		}
+
+		base::TriangleSignalSource triangle1{odd_period};
+		base::TriangleSignalSource triangle2{odd_period};
+		if (!(MaxDifference(triangle1, triangle2) < 1e-12))
+		{
+			throw std::runtime_error{CODE_POS_STR + "三角波逐个与成块采样的结果不同。"};
+		}
+
+		base::ChirpSignalSource chirp1{base::unit::Hz{10}, base::unit::Hz{2000}, base::unit::Second{base::Fraction{1, 2}}};
+		base::ChirpSignalSource chirp2{base::unit::Hz{10}, base::unit::Hz{2000}, base::unit::Second{base::Fraction{1, 2}}};
+		if (MaxDifference(chirp1, chirp2) != 0)
+		{
+			throw std::runtime_error{CODE_POS_STR + "扫频逐个与成块采样的结果不同。"};
+		}
+
+		base::NoiseSignalSource noise1{123};
+		base::NoiseSignalSource noise2{123};
+		if (MaxDifference(noise1, noise2) != 0)
+		{
+			throw std::runtime_error{CODE_POS_STR + "噪声逐个与成块采样的结果不同。"};
+		}
+
+		// 三角波的几个特征点。周期 4 个采样。
+		base::TriangleSignalSource triangle{base::unit::Second{base::Fraction{4, 10000}}};
+		triangle.Open(base::unit::Second{base::Fraction{1, 10000}});
+		if (!(triangle.Sample() == 0 && triangle.Sample() == 1 && triangle.Sample() == 0 && triangle.Sample() == -1))
+		{
+			throw std::runtime_error{CODE_POS_STR + "三角波特征点错误。"};
+		}
+
+		std::cout << "逐个与成块采样一致。" << std::endl;
+	}
+
+	{
+		std::cout << std::endl
+				  << CODE_POS_STR;
+
+		std::vector<double> samples(_sample_count);
+
+		// 原来的做法：每个采样都做 base::Fraction 运算。
+		{
+			base::PeriodicSamplingClock clock{period};
+			base::unit::Second interval{base::Fraction{1, 10000}};
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			for (int64_t i = 0; i < _sample_count; i++)
+			{
+				samples[i] = std::sin(2 * std::numbers::pi *
+									  static_cast<double>(clock.CurrentTime()) /
+									  static_cast<double>(clock.Period()));
+
+				clock += interval;
+			}
+
+			std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - start;
+			std::cout << "PeriodicSamplingClock + std::sin: "
+					  << static_cast<double>(elapsed.count()) / _sample_count << " ns/采样" << std::endl;
+		}
+
+		base::SinSignalSource sin_source{period};
+		base::SquareSignalSource square_source{period};
+		base::TriangleSignalSource triangle_source{period};
+		base::ChirpSignalSource chirp_source{base::unit::Hz{10}, base::unit::Hz{2000}, base::unit::Second{1}};
+		base::NoiseSignalSource noise_source{};
+
+		std::vector<std::pair<std::string, base::ISignalSource<double> *>> sources{
+			{"正弦", &sin_source},
+			{"方波", &square_source},
+			{"三角波", &triangle_source},
+			{"扫频", &chirp_source},
+			{"噪声", &noise_source},
+		};
+
+		for (auto &pair : sources)
+		{
+			base::ISignalSource<double> &source = *pair.second;
+			source.Open(base::unit::Second{base::Fraction{1, 10000}});
+
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			for (int64_t i = 0; i < _sample_count; i++)
+			{
+				samples[i] = source.Sample();
+			}
+
+			std::chrono::nanoseconds scalar_elapsed = std::chrono::steady_clock::now() - start;
+
+			start = std::chrono::steady_clock::now();
+			source.Sample(base::ArraySpan<double>{samples.data(), _sample_count});
+			std::chrono::nanoseconds block_elapsed = std::chrono::steady_clock::now() - start;
+
+			std::cout << pair.first << " Sample(): "
+					  << static_cast<double>(scalar_elapsed.count()) / _sample_count << " ns/采样, "
+					  << "Sample(span): "
+					  << static_cast<double>(block_elapsed.count()) / _sample_count << " ns/采样" << std::endl;
+		}
+
+		std::cout << "校验: " << samples[_sample_count - 1] << std::endl;
+	}
+}
+
+#endif // HAS_THREAD
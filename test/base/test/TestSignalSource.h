@@ -0,0 +1,17 @@
+#pragma once
+
+#if HAS_THREAD
+
+namespace base
+{
+	namespace test
+	{
+		///
+		/// @brief 检查各信号源的采样值，比较逐个采样与成块采样的结果和吞吐量。
+		///
+		void TestSignalSource();
+
+	} // namespace test
+} // namespace base
+
+#endif // HAS_THREAD
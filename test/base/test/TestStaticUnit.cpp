@@ -0,0 +1,153 @@
+#include "TestStaticUnit.h" // IWYU pragma: keep
+#include "base/math/Fraction.h"
+#include "base/string/define.h"
+#include "base/unit/Day.h"
+#include "base/unit/Nanosecond.h"
+#include "base/unit/Second.h"
+#include "base/unit/StaticUnit.h"
+#include <cstdint>
+#include <iostream>
+#include <ratio>
+#include <stdexcept>
+
+#if HAS_THREAD
+
+namespace
+{
+	///
+	/// @brief 用 double 储存值的秒，换算不截断。
+	///
+	using DoubleSecond = base::static_unit::StaticUnit<base::static_unit::dimension::Time, std::ratio<1>, double>;
+
+	///
+	/// @brief 1 个单位是 7/3 秒，与运行时单位之间的换算系数都不是整数。
+	///
+	using SevenThirdsSecond = base::static_unit::StaticUnit<base::static_unit::dimension::Time, std::ratio<7, 3>>;
+
+} // namespace
+
+void base::test::TestStaticUnit()
+{
+	std::cout << std::endl
+			  << CODE_POS_STR;
+
+	// 纳秒。
+	{
+		base::static_unit::Nanosecond ns{base::unit::Nanosecond{123456789}};
+		if (ns.Value() != 123456789)
+		{
+			throw std::runtime_error{CODE_POS_STR + "运行时纳秒转为编译期纳秒错误。"};
+		}
+
+		if (static_cast<base::unit::Nanosecond>(ns).Value() != base::Fraction{123456789})
+		{
+			throw std::runtime_error{CODE_POS_STR + "编译期纳秒转回运行时纳秒错误。"};
+		}
+
+		// 系数是 1/10^9, 整型截断，double 不截断。
+		base::static_unit::Second second{base::unit::Nanosecond{1500 * 1000 * 1000LL}};
+		if (second.Value() != 1)
+		{
+			throw std::runtime_error{CODE_POS_STR + "运行时纳秒转为编译期秒应该截断。"};
+		}
+
+		if (DoubleSecond{base::unit::Nanosecond{1500 * 1000 * 1000LL}}.Value() != 1.5)
+		{
+			throw std::runtime_error{CODE_POS_STR + "运行时纳秒转为 double 的编译期秒错误。"};
+		}
+
+		if (static_cast<base::unit::Nanosecond>(second).Value() != base::Fraction{1000 * 1000 * 1000LL})
+		{
+			throw std::runtime_error{CODE_POS_STR + "编译期秒转为运行时纳秒错误。"};
+		}
+	}
+
+	// 秒。
+	{
+		base::static_unit::Nanosecond ns{base::unit::Second{base::Fraction{1, 3}}};
+		if (ns.Value() != 333333333)
+		{
+			throw std::runtime_error{CODE_POS_STR + "1/3 秒转为编译期纳秒应该截断为 333333333."};
+		}
+
+		if (static_cast<base::unit::Second>(ns).Value() != base::Fraction{333333333, 1000 * 1000 * 1000LL})
+		{
+			throw std::runtime_error{CODE_POS_STR + "编译期纳秒转回运行时秒应该是精确的。"};
+		}
+
+		// 与 int64_t 的除法相同，向 0 截断。
+		if (base::static_unit::Second{base::unit::Second{base::Fraction{-3, 2}}}.Value() != -1)
+		{
+			throw std::runtime_error{CODE_POS_STR + "负数应该向 0 截断。"};
+		}
+
+		// 系数是 1/60.
+		if (base::static_unit::Minute{base::unit::Second{150}}.Value() != 2)
+		{
+			throw std::runtime_error{CODE_POS_STR + "150 秒转为编译期分钟应该截断为 2."};
+		}
+
+		if (static_cast<base::unit::Second>(base::static_unit::Minute{3}).Value() != base::Fraction{180})
+		{
+			throw std::runtime_error{CODE_POS_STR + "编译期分钟转为运行时秒错误。"};
+		}
+	}
+
+	// 天。
+	{
+		base::static_unit::Hour hour{base::unit::Day{base::Fraction{3, 2}}};
+		if (hour.Value() != 36)
+		{
+			throw std::runtime_error{CODE_POS_STR + "1.5 天转为编译期小时错误。"};
+		}
+
+		if (static_cast<base::unit::Day>(hour).Value() != base::Fraction{3, 2})
+		{
+			throw std::runtime_error{CODE_POS_STR + "编译期小时转回运行时天错误。"};
+		}
+
+		base::static_unit::Day day{base::unit::Second{129600}};
+		if (day.Value() != 1)
+		{
+			throw std::runtime_error{CODE_POS_STR + "1.5 天的秒数转为编译期天应该截断为 1."};
+		}
+
+		if (static_cast<base::unit::Second>(base::static_unit::Day{2}).Value() != base::Fraction{172800})
+		{
+			throw std::runtime_error{CODE_POS_STR + "编译期天转为运行时秒错误。"};
+		}
+
+		if (static_cast<base::unit::Nanosecond>(base::static_unit::Day{1}).Value() != base::Fraction{86400LL * 1000 * 1000 * 1000})
+		{
+			throw std::runtime_error{CODE_POS_STR + "编译期天转为运行时纳秒错误。"};
+		}
+	}
+
+	// 换算系数的分子分母都不是 1.
+	{
+		// 86400 / (7/3) = 37028.57...
+		if (SevenThirdsSecond{base::unit::Day{1}}.Value() != 37028)
+		{
+			throw std::runtime_error{CODE_POS_STR + "运行时天转为 7/3 秒的单位应该截断为 37028."};
+		}
+
+		if (static_cast<base::unit::Second>(SevenThirdsSecond{3}).Value() != base::Fraction{7})
+		{
+			throw std::runtime_error{CODE_POS_STR + "7/3 秒的单位转为运行时秒错误。"};
+		}
+
+		if (static_cast<base::unit::Day>(SevenThirdsSecond{37028}).Value() != base::Fraction{37028 * 7, 3 * 86400})
+		{
+			throw std::runtime_error{CODE_POS_STR + "7/3 秒的单位转为运行时天错误。"};
+		}
+
+		if (static_cast<base::unit::Nanosecond>(SevenThirdsSecond{1}).Value() != base::Fraction{7 * 1000 * 1000 * 1000LL, 3})
+		{
+			throw std::runtime_error{CODE_POS_STR + "7/3 秒的单位转为运行时纳秒错误。"};
+		}
+	}
+
+	std::cout << "编译期单位与运行时单位互相转换正确。" << std::endl;
+}
+
+#endif // HAS_THREAD
@@ -0,0 +1,18 @@
+#pragma once
+
+#if HAS_THREAD
+
+namespace base
+{
+	namespace test
+	{
+		///
+		/// @brief 检查 base::static_unit 编译期单位与 base::unit 运行时单位互相转换的结果，
+		/// 包括换算系数不是整数的情况。
+		///
+		void TestStaticUnit();
+
+	} // namespace test
+} // namespace base
+
+#endif // HAS_THREAD
@@ -0,0 +1,224 @@
+#include "TestStringView.h" // IWYU pragma: keep
+#include "base/string/define.h"
+#include "base/string/KeyValueString.h"
+#include "base/string/String.h"
+#include "base/string/StringView.h"
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if HAS_THREAD
+
+namespace
+{
+	std::vector<std::string> Collect(base::StringSplitEnumerator enumerator)
+	{
+		std::vector<std::string> ret;
+		while (enumerator.MoveToNext())
+		{
+			ret.push_back(enumerator.CurrentValue().ToStdString());
+		}
+
+		return ret;
+	}
+
+} // namespace
+
+void base::test::TestStringView()
+{
+	{
+		std::cout << std::endl
+				  << CODE_POS_STR;
+
+		std::string text = "  key = value ; 0123456789abcdef0123456789abcdef,end\t";
+		base::StringView view{text};
+
+		if (view.Trim() != "key = value ; 0123456789abcdef0123456789abcdef,end")
+		{
+			throw std::runtime_error{CODE_POS_STR + "Trim 错误。"};
+		}
+
+		if (!view.TrimStart().StartWith("key"))
+		{
+			throw std::runtime_error{CODE_POS_STR + "TrimStart 或 StartWith 错误。"};
+		}
+
+		if (!view.TrimEnd().EndWith(",end"))
+		{
+			throw std::runtime_error{CODE_POS_STR + "TrimEnd 或 EndWith 错误。"};
+		}
+
+		if (view.IndexOf('=') != 6)
+		{
+			throw std::runtime_error{CODE_POS_STR + "IndexOf(char) 错误。"};
+		}
+
+		if (view.IndexOf(',') != static_cast<int64_t>(text.find(',')))
+		{
+			throw std::runtime_error{CODE_POS_STR + "跨 16 字节的 IndexOf(char) 错误。"};
+		}
+
+		if (view.IndexOf('#') != -1)
+		{
+			throw std::runtime_error{CODE_POS_STR + "IndexOf(char) 找到了不存在的字符。"};
+		}
+
+		if (view.IndexOf("abcdef,") != static_cast<int64_t>(text.find("abcdef,")))
+		{
+			throw std::runtime_error{CODE_POS_STR + "IndexOf(StringView) 错误。"};
+		}
+
+		if (view.IndexOf(30, "0123") != static_cast<int64_t>(text.find("0123", 30)))
+		{
+			throw std::runtime_error{CODE_POS_STR + "从 start 开始的 IndexOf 错误。"};
+		}
+
+		if (view.IndexOfAny(",;") != static_cast<int64_t>(text.find_first_of(",;")))
+		{
+			throw std::runtime_error{CODE_POS_STR + "IndexOfAny 错误。"};
+		}
+
+		if (view.IndexOfAny(20, ",;") != static_cast<int64_t>(text.find_first_of(",;", 20)))
+		{
+			throw std::runtime_error{CODE_POS_STR + "从 start 开始的 IndexOfAny 错误。"};
+		}
+
+		if (view.LastIndexOf('e') != static_cast<int64_t>(text.rfind('e')))
+		{
+			throw std::runtime_error{CODE_POS_STR + "LastIndexOf 错误。"};
+		}
+
+		if (view[base::Range{2, 5}] != "key")
+		{
+			throw std::runtime_error{CODE_POS_STR + "切片错误。"};
+		}
+
+		std::cout << "查找和裁剪正确。" << std::endl;
+	}
+
+	{
+		std::cout << std::endl
+				  << CODE_POS_STR;
+
+		base::StringSplitOptions keep_empty;
+		keep_empty.remove_empty_substring = false;
+
+		base::StringSplitOptions trim_and_remove;
+		trim_and_remove.trim_each_substring = true;
+
+		if (Collect(base::StringView{"a,,b,"}.Split(',', keep_empty)) != std::vector<std::string>{"a", "", "b", ""})
+		{
+			throw std::runtime_error{CODE_POS_STR + "保留空字符串的拆分错误。"};
+		}
+
+		if (Collect(base::StringView{"a,,b,"}.Split(',')) != std::vector<std::string>{"a", "b"})
+		{
+			throw std::runtime_error{CODE_POS_STR + "默认选项的拆分错误。"};
+		}
+
+		if (Collect(base::StringView{" a , , b "}.Split(',', trim_and_remove)) != std::vector<std::string>{"a", "b"})
+		{
+			throw std::runtime_error{CODE_POS_STR + "裁剪后移除空字符串的拆分错误。"};
+		}
+
+		if (Collect(base::StringView{"  x\ty  z\n"}.Tokenize(" \t\n")) != std::vector<std::string>{"x", "y", "z"})
+		{
+			throw std::runtime_error{CODE_POS_STR + "Tokenize 错误。"};
+		}
+
+		if (Collect(base::StringView{""}.Split(',', keep_empty)) != std::vector<std::string>{""})
+		{
+			throw std::runtime_error{CODE_POS_STR + "空字符串的拆分错误。"};
+		}
+
+		// String::Split 现在由惰性拆分实现，检查与之一致。
+		base::List<base::String> list = base::String{"1, 2,,3 ,"}.Split(',', keep_empty);
+		if (!(list.Count() == 5 && list[0] == "1" && list[1] == " 2" && list[2] == "" && list[3] == "3 " && list[4] == ""))
+		{
+			throw std::runtime_error{CODE_POS_STR + "String::Split 错误。"};
+		}
+
+		base::KeyValueString key_value{" name = base "};
+		if (!(key_value.Key() == "name" && key_value.Value() == "base"))
+		{
+			throw std::runtime_error{CODE_POS_STR + "KeyValueString 错误。"};
+		}
+
+		bool thrown = false;
+		try
+		{
+			base::KeyValueString invalid{"no separator"};
+		}
+		catch (std::exception const &)
+		{
+			thrown = true;
+		}
+
+		if (!thrown)
+		{
+			throw std::runtime_error{CODE_POS_STR + "没有 '=' 的键值对字符串应该抛出异常。"};
+		}
+
+		std::cout << "拆分正确。" << std::endl;
+	}
+
+	{
+		std::cout << std::endl
+				  << CODE_POS_STR;
+
+		// 10 万行 CSV, 每行 8 个字段。
+		std::string csv;
+		for (int64_t i = 0; i < 100000; i++)
+		{
+			csv += "1700000000," + std::to_string(i) + ",sensor_" + std::to_string(i % 17) + ",12.5,-3.25,ok,,0.001\n";
+		}
+
+		base::String csv_string{csv};
+		int64_t const repeat = 5;
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		int64_t list_fields = 0;
+		for (int64_t r = 0; r < repeat; r++)
+		{
+			base::List<base::String> lines = csv_string.Split('\n');
+			for (base::String const &line : lines)
+			{
+				list_fields += line.Split(',').Count();
+			}
+		}
+
+		std::chrono::duration<double> list_elapsed = std::chrono::steady_clock::now() - start;
+
+		start = std::chrono::steady_clock::now();
+		int64_t view_fields = 0;
+		for (int64_t r = 0; r < repeat; r++)
+		{
+			base::StringSplitEnumerator lines = csv_string.View().Split('\n');
+			while (lines.MoveToNext())
+			{
+				base::StringSplitEnumerator fields = lines.CurrentValue().Split(',');
+				while (fields.MoveToNext())
+				{
+					view_fields++;
+				}
+			}
+		}
+
+		std::chrono::duration<double> view_elapsed = std::chrono::steady_clock::now() - start;
+
+		if (list_fields != view_fields)
+		{
+			throw std::runtime_error{CODE_POS_STR + "两种拆分得到的字段数不同。"};
+		}
+
+		double megabytes = static_cast<double>(csv.size()) * repeat / 1024 / 1024;
+		std::cout << "String::Split: " << megabytes / list_elapsed.count() << " MB/s, "
+				  << "StringView::Split: " << megabytes / view_elapsed.count() << " MB/s, "
+				  << "字段数: " << view_fields << std::endl;
+	}
+}
+
+#endif // HAS_THREAD
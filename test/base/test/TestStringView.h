@@ -0,0 +1,17 @@
+#pragma once
+
+#if HAS_THREAD
+
+namespace base
+{
+	namespace test
+	{
+		///
+		/// @brief 检查 StringView 的查找、裁剪和惰性拆分，与 String::Split 比较吞吐量。
+		///
+		void TestStringView();
+
+	} // namespace test
+} // namespace base
+
+#endif // HAS_THREAD
@@ -0,0 +1,385 @@
+#include "TestUtf8.h" // IWYU pragma: keep
+#include "base/container/ArraySpan.h"
+#include "base/container/ReadOnlyArraySpan.h"
+#include "base/math/Xoshiro256PlusPlus.h"
+#include "base/stream/MemoryStream.h"
+#include "base/stream/ReadOnlySpan.h"
+#include "base/stream/Span.h"
+#include "base/string/define.h"
+#include "base/string/encoding/Utf8Reader.h"
+#include "base/string/encoding/utf8.h"
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if HAS_THREAD
+
+namespace
+{
+	///
+	/// @brief 随机生成码点，ASCII 占一半，其余在各长度之间分布，不含代理区。
+	///
+	/// @param generator
+	/// @param count
+	/// @return
+	///
+	std::u32string RandomText(base::Xoshiro256PlusPlus &generator, int64_t count)
+	{
+		std::u32string ret;
+		for (int64_t i = 0; i < count; i++)
+		{
+			switch (generator.Next(8))
+			{
+			case 4:
+				{
+					ret.push_back(static_cast<char32_t>(generator.Next(0x80, 0x7ff)));
+					break;
+				}
+			case 5:
+				{
+					ret.push_back(static_cast<char32_t>(generator.Next(0x800, 0xd7ff)));
+					break;
+				}
+			case 6:
+				{
+					ret.push_back(static_cast<char32_t>(generator.Next(0xe000, 0xffff)));
+					break;
+				}
+			case 7:
+				{
+					ret.push_back(static_cast<char32_t>(generator.Next(0x10000, 0x10ffff)));
+					break;
+				}
+			default:
+				{
+					ret.push_back(static_cast<char32_t>(generator.Next(0, 0x7f)));
+					break;
+				}
+			}
+		}
+
+		return ret;
+	}
+
+	///
+	/// @brief 逐字节解码，作为比较的基准。输入必须合法。
+	///
+	/// @param str
+	/// @return
+	///
+	std::u32string NaiveDecode(std::string const &str)
+	{
+		std::u32string ret;
+		for (size_t i = 0; i < str.size();)
+		{
+			uint8_t byte = static_cast<uint8_t>(str[i]);
+			int length = byte < 0x80 ? 1 : byte < 0xe0 ? 2 : byte < 0xf0 ? 3 : 4;
+			char32_t value = length == 1 ? byte : byte & (0x7f >> length);
+			for (int k = 1; k < length; k++)
+			{
+				value = (value << 6) | (static_cast<uint8_t>(str[i + k]) & 0x3f);
+			}
+
+			ret.push_back(value);
+			i += length;
+		}
+
+		return ret;
+	}
+
+	///
+	/// @brief 每次向 decode_utf8 追加 chunk_size 个新字节，没消耗的字节留到下一次。
+	///
+	/// @param str
+	/// @param chunk_size
+	/// @return
+	///
+	std::u32string DecodeChunked(std::string const &str, int64_t chunk_size)
+	{
+		std::u32string ret;
+		std::vector<char32_t> output(str.size() + 1);
+		std::string pending;
+		for (size_t begin = 0; begin < str.size(); begin += chunk_size)
+		{
+			pending += str.substr(begin, chunk_size);
+			bool is_final_block = begin + chunk_size >= str.size();
+			base::string::encoding::utf8_decode_result result = base::string::encoding::decode_utf8(
+				base::ReadOnlySpan{pending},
+				base::ArraySpan<char32_t>{output.data(), static_cast<int64_t>(output.size())},
+				is_final_block);
+
+			ret.append(output.data(), result._written);
+			pending.erase(0, result._consumed);
+		}
+
+		return ret;
+	}
+
+	///
+	/// @brief 用 Utf8Reader 解码。
+	///
+	/// @param str
+	/// @param buffer_size
+	/// @return
+	///
+	std::u32string ReadAll(std::string str, int64_t buffer_size)
+	{
+		base::MemoryStream stream{base::Span{reinterpret_cast<uint8_t *>(str.data()), static_cast<int64_t>(str.size())}};
+		stream.SetLength(static_cast<int64_t>(str.size()));
+		base::string::encoding::Utf8Reader reader{stream, buffer_size};
+
+		std::u32string ret;
+		char32_t buffer[16];
+		while (true)
+		{
+			int64_t have_read = reader.Read(base::ArraySpan<char32_t>{buffer, 16});
+			if (have_read == 0)
+			{
+				break;
+			}
+
+			ret.append(buffer, have_read);
+		}
+
+		return ret;
+	}
+
+} // namespace
+
+void base::test::TestUtf8()
+{
+	using namespace base::string::encoding;
+
+	base::Xoshiro256PlusPlus generator{35};
+
+	{
+		std::cout << std::endl
+				  << CODE_POS_STR;
+
+		if (!is_valid_utf8(base::ReadOnlySpan{""}))
+		{
+			throw std::runtime_error{CODE_POS_STR + "空字符串应该合法。"};
+		}
+
+		if (!is_valid_utf8(base::ReadOnlySpan{"hello, 你好，世界！😀"}))
+		{
+			throw std::runtime_error{CODE_POS_STR + "合法字符串被判为非法。"};
+		}
+
+		// 各类非法序列及其位置。
+		std::vector<std::pair<std::string, int64_t>> invalid_cases{
+			{"ab\x80", 2},
+			{"ab\xc0\xaf", 2},
+			{"\xc2", 0},
+			{"\xe0\x80\xaf", 0},
+			{"x\xed\xa0\x80", 1},
+			{"\xf4\x90\x80\x80", 0},
+			{"\xf5\x80\x80\x80", 0},
+			{"\xe4\xbd", 0},
+			{"0123456789abcdef0123456789abcdef0123456789abcdef\xff", 48},
+		};
+
+		for (auto &pair : invalid_cases)
+		{
+			if (find_invalid_utf8(base::ReadOnlySpan{pair.first}) != pair.second)
+			{
+				throw std::runtime_error{CODE_POS_STR + "非法序列的位置错误。"};
+			}
+		}
+
+		std::cout << "校验正确。" << std::endl;
+	}
+
+	{
+		std::cout << std::endl
+				  << CODE_POS_STR;
+
+		std::u32string text = RandomText(generator, 100000);
+		std::string utf8 = convert_utf32_string_to_utf8_string(text);
+		if (!is_valid_utf8(base::ReadOnlySpan{utf8}))
+		{
+			throw std::runtime_error{CODE_POS_STR + "编码结果不合法。"};
+		}
+
+		if (NaiveDecode(utf8) != text)
+		{
+			throw std::runtime_error{CODE_POS_STR + "编码结果错误。"};
+		}
+
+		if (convert_utf8_string_to_utf32_string(base::ReadOnlySpan{utf8}) != text)
+		{
+			throw std::runtime_error{CODE_POS_STR + "解码为 UTF-32 的结果错误。"};
+		}
+
+		std::u16string utf16 = convert_utf8_string_to_utf16_string(base::ReadOnlySpan{utf8});
+		if (convert_utf16_string_to_utf8_string(utf16) != utf8)
+		{
+			throw std::runtime_error{CODE_POS_STR + "UTF-16 往返转换结果错误。"};
+		}
+
+		// 替换字符。
+		if (convert_utf8_string_to_utf32_string(base::ReadOnlySpan{"a\x80\x80\x80" "b"}) != U"a�b")
+		{
+			throw std::runtime_error{CODE_POS_STR + "非法首字节的替换错误。"};
+		}
+
+		if (convert_utf8_string_to_utf32_string(base::ReadOnlySpan{"\xe4\xbd" "a"}) != U"�a")
+		{
+			throw std::runtime_error{CODE_POS_STR + "缺少接续字节的替换错误。"};
+		}
+
+		if (convert_utf8_string_to_utf32_string(base::ReadOnlySpan{"\xc0\xaf" "a\xe4\xbd"}) != U"�a�")
+		{
+			throw std::runtime_error{CODE_POS_STR + "过长编码和末尾截断的替换错误。"};
+		}
+
+		if (convert_utf16_string_to_utf8_string(u"a\xd800" "b") != "a\xef\xbf\xbd" "b")
+		{
+			throw std::runtime_error{CODE_POS_STR + "不成对代理的替换错误。"};
+		}
+
+		std::cout << "转换正确。" << std::endl;
+	}
+
+	{
+		std::cout << std::endl
+				  << CODE_POS_STR;
+
+		// 各种缓冲区大小和输出大小，检查跨块拼接。
+		std::string utf8 = convert_utf32_string_to_utf8_string(RandomText(generator, 20000));
+		std::u32string expected = NaiveDecode(utf8);
+
+		for (int64_t buffer_size : {4, 5, 7, 64, 4096})
+		{
+			for (int64_t read_size : {1, 3, 1000})
+			{
+				base::MemoryStream stream{base::Span{reinterpret_cast<uint8_t *>(utf8.data()), static_cast<int64_t>(utf8.size())}};
+				stream.SetLength(static_cast<int64_t>(utf8.size()));
+				Utf8Reader reader{stream, buffer_size};
+
+				std::u32string result;
+				std::vector<char32_t> buffer(read_size);
+				while (true)
+				{
+					int64_t have_read = reader.Read(base::ArraySpan<char32_t>{buffer.data(), read_size});
+					if (have_read == 0)
+					{
+						break;
+					}
+
+					result.append(buffer.data(), have_read);
+				}
+
+				if (result != expected)
+				{
+					throw std::runtime_error{CODE_POS_STR + "Utf8Reader 的结果错误。"};
+				}
+			}
+		}
+
+		std::cout << "Utf8Reader 成块读取正确。" << std::endl;
+	}
+
+	{
+		std::cout << std::endl
+				  << CODE_POS_STR;
+
+		// 非法输入分块解码的结果要与一次解码整个输入相同。
+		std::string example = "\x80\xf0\xff\xa0\x9f\xbf";
+		if (convert_utf8_string_to_utf32_string(base::ReadOnlySpan{example}) != U"���")
+		{
+			throw std::runtime_error{CODE_POS_STR + "非法输入的替换错误。"};
+		}
+
+		if (ReadAll(example, 4) != U"���")
+		{
+			throw std::runtime_error{CODE_POS_STR + "非法输入分块读取的替换错误。"};
+		}
+
+		// 字节集中在容易出错的范围。
+		uint8_t const bytes[] = {'a', 0x80, 0x9f, 0xa0, 0xbf, 0xc0, 0xc2, 0xdf, 0xe0, 0xe4, 0xed, 0xef, 0xf0, 0xf4, 0xf5, 0xf8, 0xff};
+		for (int64_t n = 0; n < 20000; n++)
+		{
+			std::string input;
+			int64_t length = static_cast<int64_t>(generator.Next(1, 16));
+			for (int64_t i = 0; i < length; i++)
+			{
+				input.push_back(static_cast<char>(bytes[generator.Next(sizeof(bytes))]));
+			}
+
+			std::u32string expected = convert_utf8_string_to_utf32_string(base::ReadOnlySpan{input});
+			for (int64_t chunk_size : {1, 2, 3, 5})
+			{
+				if (DecodeChunked(input, chunk_size) != expected)
+				{
+					throw std::runtime_error{CODE_POS_STR + "非法输入分块解码的结果与整体解码不同。"};
+				}
+			}
+
+			if (ReadAll(input, 4) != expected)
+			{
+				throw std::runtime_error{CODE_POS_STR + "非法输入用 Utf8Reader 读取的结果与整体解码不同。"};
+			}
+		}
+
+		std::cout << "非法输入分块解码与整体解码相同。" << std::endl;
+	}
+
+	{
+		std::cout << std::endl
+				  << CODE_POS_STR;
+
+		int64_t const repeat = 20;
+		std::string ascii(8 * 1024 * 1024, 'a');
+		for (size_t i = 0; i < ascii.size(); i++)
+		{
+			ascii[i] = static_cast<char>('a' + i % 26);
+		}
+
+		std::string cjk = convert_utf32_string_to_utf8_string(std::u32string(ascii.size() / 3, U'汉'));
+
+		for (auto &pair : std::vector<std::pair<std::string, std::string *>>{{"ASCII", &ascii}, {"中文", &cjk}})
+		{
+			std::string &text = *pair.second;
+			double megabytes = static_cast<double>(text.size()) * repeat / 1024 / 1024;
+
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			int64_t checksum = 0;
+			for (int64_t i = 0; i < repeat; i++)
+			{
+				checksum += find_invalid_utf8(base::ReadOnlySpan{text});
+			}
+
+			std::chrono::duration<double> validate_elapsed = std::chrono::steady_clock::now() - start;
+
+			std::vector<char32_t> output(text.size());
+			start = std::chrono::steady_clock::now();
+			for (int64_t i = 0; i < repeat; i++)
+			{
+				checksum += decode_utf8(base::ReadOnlySpan{text},
+										base::ArraySpan<char32_t>{output.data(), static_cast<int64_t>(output.size())})
+								._written;
+			}
+
+			std::chrono::duration<double> decode_elapsed = std::chrono::steady_clock::now() - start;
+
+			start = std::chrono::steady_clock::now();
+			for (int64_t i = 0; i < repeat; i++)
+			{
+				checksum += static_cast<int64_t>(NaiveDecode(text).size());
+			}
+
+			std::chrono::duration<double> naive_elapsed = std::chrono::steady_clock::now() - start;
+
+			std::cout << pair.first << " 校验: " << megabytes / validate_elapsed.count() << " MB/s, "
+					  << "解码: " << megabytes / decode_elapsed.count() << " MB/s, "
+					  << "逐字节解码: " << megabytes / naive_elapsed.count() << " MB/s, "
+					  << "校验和: " << checksum << std::endl;
+		}
+	}
+}
+
+#endif // HAS_THREAD
@@ -0,0 +1,17 @@
+#pragma once
+
+#if HAS_THREAD
+
+namespace base
+{
+	namespace test
+	{
+		///
+		/// @brief 检查 UTF-8 校验、解码、编码和 Utf8Reader 的成块读取，测量吞吐量。
+		///
+		void TestUtf8();
+
+	} // namespace test
+} // namespace base
+
+#endif // HAS_THREAD
@@ -0,0 +1,216 @@
+#include "TestYearMonthDayDirectoryIndex.h" // IWYU pragma: keep
+#include "base/filesystem/file.h"
+#include "base/filesystem/filesystem.h"
+#include "base/filesystem/Path.h"
+#include "base/filesystem/YearMonthDayDirectoryEntryEnumerator.h"
+#include "base/filesystem/YearMonthDayDirectoryIndex.h"
+#include "base/math/interval/Interval.h"
+#include "base/string/define.h"
+#include "base/time/DateTime.h"
+#include "base/time/UtcHourOffset.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if HAS_THREAD
+
+namespace
+{
+	std::string TwoDigits(int64_t value)
+	{
+		std::string ret = std::to_string(value);
+		if (ret.size() < 2)
+		{
+			ret.insert(ret.begin(), '0');
+		}
+
+		return ret;
+	}
+
+	std::vector<std::string> Collect(base::filesystem::YearMonthDayDirectoryEntryEnumerator &enumerator)
+	{
+		std::vector<std::string> ret;
+		while (enumerator.MoveToNext())
+		{
+			ret.push_back(enumerator.CurrentValue().Path().ToString());
+		}
+
+		return ret;
+	}
+
+	std::vector<std::string> Sorted(std::vector<std::string> value)
+	{
+		std::sort(value.begin(), value.end());
+		return value;
+	}
+
+	///
+	/// @brief 日目录的名称都补了 0, 所以按日期排序就是日目录的路径不减。
+	///
+	bool IsSortedByDate(std::vector<std::string> const &files)
+	{
+		for (size_t i = 1; i < files.size(); i++)
+		{
+			if (base::Path{files[i]}.ParentPath().ToString() < base::Path{files[i - 1]}.ParentPath().ToString())
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+} // namespace
+
+void base::test::TestYearMonthDayDirectoryIndex()
+{
+	std::cout << std::endl
+			  << CODE_POS_STR;
+
+	base::UtcHourOffset utc_hour_offset{8};
+	base::Path base_path = base::filesystem::CurrentPath() + base::Path{"TestYearMonthDayDirectoryIndex"};
+	base::filesystem::Remove(base_path);
+
+	// 2021 到 2024 年，每 3 天有一个日目录，每个日目录 2 个文件。
+	for (base::DateTime date{2021, 1, 1, 0, 0, 0, 0}; date.Year() <= 2024; date.AddDays(3))
+	{
+		base::Path day_path = base_path +
+							  base::Path{std::to_string(date.Year()) + '/' + TwoDigits(date.Month()) + '/' + TwoDigits(date.Day())};
+
+		base::filesystem::CreateDirectoryRecursively(day_path);
+		base::file::CreateNewAnyway(day_path + base::Path{"a.bin"});
+		base::file::CreateNewAnyway(day_path + base::Path{"b.bin"});
+	}
+
+	base::filesystem::YearMonthDayDirectoryIndex index = base::filesystem::YearMonthDayDirectoryIndex::Build(base_path);
+	if (index.FileCount() != index.Count() * 2)
+	{
+		throw std::runtime_error{CODE_POS_STR + "索引中的文件数错误。"};
+	}
+
+	base::Path index_file_path = base::filesystem::CurrentPath() + base::Path{"TestYearMonthDayDirectoryIndex.index"};
+	index.Save(index_file_path);
+	base::filesystem::YearMonthDayDirectoryIndex loaded_index = base::filesystem::YearMonthDayDirectoryIndex::Load(index_file_path);
+	if (!(loaded_index.Count() == index.Count() && loaded_index.FileCount() == index.FileCount()))
+	{
+		throw std::runtime_error{CODE_POS_STR + "加载的索引与保存的不同。"};
+	}
+
+	if (!(loaded_index.Find(2021, 1, 4) != nullptr && loaded_index.Find(2021, 1, 4)->_relative_path == "2021/01/04"))
+	{
+		throw std::runtime_error{CODE_POS_STR + "加载的索引中的路径错误。"};
+	}
+
+	if (loaded_index.Find(2021, 1, 5) != nullptr)
+	{
+		throw std::runtime_error{CODE_POS_STR + "不存在的日目录不应该在索引中。"};
+	}
+
+	base::filesystem::Remove(index_file_path);
+
+	std::vector<base::Interval<base::DateTime>> ranges{
+		base::ClosedInterval<base::DateTime>{
+			base::DateTime{utc_hour_offset, 2023, 2, 26, 10, 0, 0, 0},
+			base::DateTime{utc_hour_offset, 2023, 3, 4, 3, 0, 0, 0},
+		},
+		base::OpenInterval<base::DateTime>{
+			base::DateTime{utc_hour_offset, 2022, 12, 30, 0, 0, 0, 0},
+			base::DateTime{utc_hour_offset, 2023, 1, 2, 0, 0, 0, 0},
+		},
+		base::LeftInfiniteRightClosedInterval<base::DateTime>{
+			base::DateTime{utc_hour_offset, 2021, 2, 1, 0, 0, 0, 0},
+		},
+		base::LeftClosedRightInfiniteInterval<base::DateTime>{
+			base::DateTime{utc_hour_offset, 2024, 12, 1, 0, 0, 0, 0},
+		},
+	};
+
+	for (base::Interval<base::DateTime> const &range : ranges)
+	{
+		base::filesystem::YearMonthDayDirectoryEntryEnumerator walk_enumerator{base_path, true, range, utc_hour_offset, nullptr};
+		base::filesystem::YearMonthDayDirectoryEntryEnumerator exact_enumerator{base_path, range, utc_hour_offset, nullptr};
+		base::filesystem::YearMonthDayDirectoryEntryEnumerator indexed_enumerator{base_path, loaded_index, range, utc_hour_offset, nullptr};
+
+		std::vector<std::string> walk_files = Collect(walk_enumerator);
+		std::vector<std::string> exact_files = Collect(exact_enumerator);
+		std::vector<std::string> indexed_files = Collect(indexed_enumerator);
+
+		if (walk_files.empty())
+		{
+			throw std::runtime_error{CODE_POS_STR + "时间范围内应该有文件。"};
+		}
+
+		if (Sorted(walk_files) != Sorted(exact_files))
+		{
+			throw std::runtime_error{CODE_POS_STR + "精确探测模式得到的文件与遍历模式不同。"};
+		}
+
+		if (Sorted(walk_files) != Sorted(indexed_files))
+		{
+			throw std::runtime_error{CODE_POS_STR + "索引模式得到的文件与遍历模式不同。"};
+		}
+
+		if (!(IsSortedByDate(exact_files) && IsSortedByDate(indexed_files)))
+		{
+			throw std::runtime_error{CODE_POS_STR + "没有按日期排序。"};
+		}
+	}
+
+	std::cout << "精确探测模式和索引模式得到的文件与遍历模式相同。" << std::endl;
+
+	// 速度。查询 4 年数据中的 3 天。
+	base::Interval<base::DateTime> range = base::ClosedInterval<base::DateTime>{
+		base::DateTime{utc_hour_offset, 2023, 6, 10, 0, 0, 0, 0},
+		base::DateTime{utc_hour_offset, 2023, 6, 12, 23, 0, 0, 0},
+	};
+
+	constexpr int64_t query_count = 200;
+	int64_t walk_file_count = 0;
+	int64_t exact_file_count = 0;
+	int64_t indexed_file_count = 0;
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (int64_t i = 0; i < query_count; i++)
+	{
+		base::filesystem::YearMonthDayDirectoryEntryEnumerator enumerator{base_path, true, range, utc_hour_offset, nullptr};
+		walk_file_count += static_cast<int64_t>(Collect(enumerator).size());
+	}
+
+	std::chrono::duration<double> walk_elapsed = std::chrono::steady_clock::now() - start;
+
+	start = std::chrono::steady_clock::now();
+	for (int64_t i = 0; i < query_count; i++)
+	{
+		base::filesystem::YearMonthDayDirectoryEntryEnumerator enumerator{base_path, range, utc_hour_offset, nullptr};
+		exact_file_count += static_cast<int64_t>(Collect(enumerator).size());
+	}
+
+	std::chrono::duration<double> exact_elapsed = std::chrono::steady_clock::now() - start;
+
+	start = std::chrono::steady_clock::now();
+	for (int64_t i = 0; i < query_count; i++)
+	{
+		base::filesystem::YearMonthDayDirectoryEntryEnumerator enumerator{base_path, loaded_index, range, utc_hour_offset, nullptr};
+		indexed_file_count += static_cast<int64_t>(Collect(enumerator).size());
+	}
+
+	std::chrono::duration<double> indexed_elapsed = std::chrono::steady_clock::now() - start;
+
+	if (!(walk_file_count == exact_file_count && walk_file_count == indexed_file_count))
+	{
+		throw std::runtime_error{CODE_POS_STR + "三种模式得到的文件数不同。"};
+	}
+
+	base::filesystem::Remove(base_path);
+
+	double queries = static_cast<double>(query_count);
+	std::cout << "查询 4 年中的 3 天：遍历 " << queries / walk_elapsed.count() << " 次/s, "
+			  << "精确探测 " << queries / exact_elapsed.count() << " 次/s, "
+			  << "索引 " << queries / indexed_elapsed.count() << " 次/s" << std::endl;
+}
+
+#endif // HAS_THREAD
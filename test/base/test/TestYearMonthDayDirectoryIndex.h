@@ -0,0 +1,17 @@
+#pragma once
+
+#if HAS_THREAD
+
+namespace base
+{
+	namespace test
+	{
+		///
+		/// @brief 检查精确探测模式和索引模式与遍历模式得到的文件相同，比较按时间范围查询的速度。
+		///
+		void TestYearMonthDayDirectoryIndex();
+
+	} // namespace test
+} // namespace base
+
+#endif // HAS_THREAD